@@ -22,6 +22,9 @@
 #include "hls_math.h"
 #include "hls_stream.h"
 #include "xf_fintech/rng.hpp"
+#ifndef __SYNTHESIS__
+#include <assert.h>
+#endif
 
 namespace xf {
 
@@ -41,7 +44,7 @@ class BrownianBridge {
     static const int W = 10;
 
     // loop body of transform
-    inline void trans_body(ap_uint<W> idx, double inputVal, double* result, double* result_dup) {
+    inline void trans_body(ap_uint<W> idx, DT inputVal, DT* result, DT* result_dup) {
 #pragma HLS inline
         ap_uint<W> j = left_index[idx];
         ap_uint<W> k = right_index[idx];
@@ -207,7 +210,7 @@ class BrownianBridge {
 
         left_weight[0] = 0.0;
 
-        stdDev[0] = hls::sqrt(size);
+        stdDev[0] = hls::sqrt((DT)size);
 
         // calculate the weight for left, right,
         for (int i = 1; i < size; ++i) {
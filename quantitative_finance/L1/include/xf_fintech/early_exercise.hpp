@@ -974,6 +974,155 @@ BACKTRACE_LOOP:
         }
     }
 }
+///@brief read the prices of the paths of one chunk at one time step from DDR to UN streams.
+// The price data is laid out as written by MCIteration: blocks of SN paths, each holding all the time steps.
+template <typename DT, int UN, int SN>
+void read_step_prices(int step,
+                      int steps,
+                      int firstBlock,
+                      int paths,
+                      ap_uint<8 * sizeof(DT) * UN>* priceIn,
+                      hls::stream<DT> outStrm[UN]) {
+    const int SZ = 8 * sizeof(DT);
+    for (int p = 0; p < paths; ++p) {
+#pragma HLS loop_tripcount min = 4096 max = 4096
+#pragma HLS pipeline II = 1
+        int block = firstBlock + p / SN;
+        ap_uint<SZ* UN> in = priceIn[block * steps * SN + step * SN + p % SN];
+        for (int k = 0; k < UN; ++k) {
+            int64_t i_i = in((k + 1) * SZ - 1, k * SZ);
+            outStrm[k].write(bitsToDouble(i_i));
+        }
+    }
+}
+
+///@brief accumulate A^T*y of one chunk of paths, reading the prices at this step from DDR
+template <typename DT, int COEFNM, int SamplesNm, int UN, int SN>
+void ChunkGenAty(int step,
+                 int steps,
+                 int firstBlock,
+                 int paths,
+                 ap_uint<8 * sizeof(DT) * UN>* priceIn,
+                 DT dF,
+                 DT y[UN][SamplesNm],
+                 DT pBuff[UN][SamplesNm],
+                 DT coef[UN][COEFNM],
+                 DT outAty[COEFNM],
+                 bool optionType,
+                 DT strike,
+                 DT invStk) {
+#pragma HLS dataflow
+    hls::stream<DT> pStrm[UN];
+#pragma HLS stream variable = pStrm depth = 8
+#pragma HLS array_partition variable = pStrm dim = 0
+    read_step_prices<DT, UN, SN>(step, steps, firstBlock, paths, priceIn, pStrm);
+    MultGenAty<DT, COEFNM, SamplesNm, UN>(pStrm, paths, dF, y, pBuff, coef, outAty, optionType, strike, invStk);
+}
+
+/// @brief calculate the coefficients with the calibration paths read from DDR in chunks of SamplesNm paths per
+/// unroll. The discounted cash flow of each path is kept in flowBuff between the time steps, so the number of paths
+/// is only limited by the size of the external memory. With a single chunk the result is the same as CalCoef.
+template <typename DT, int COEFNM, int SamplesNm, int UN, int SN>
+void CalCoefChunked(int steps,
+                    int blocks,
+                    bool optionType,
+                    DT dF,
+                    DT strike,
+                    DT invStk,
+                    hls::stream<DT>& Ustrm,
+                    hls::stream<DT>& Vstrm,
+                    hls::stream<DT>& Sstrm,
+                    ap_uint<8 * sizeof(DT) * UN>* priceIn,
+                    ap_uint<8 * sizeof(DT) * UN>* flowBuff,
+                    hls::stream<DT> coefStrm[COEFNM]) {
+    const int SZ = 8 * sizeof(DT);
+    // number of blocks of SN paths in one chunk
+    const int CHUNK = SamplesNm / SN;
+    DT y[UN][SamplesNm];
+#pragma HLS array_partition variable = y dim = 1
+    DT pBuff[UN][SamplesNm];
+#pragma HLS array_partition variable = pBuff dim = 1
+    DT coef[UN][COEFNM];
+#pragma HLS array_partition variable = coef dim = 0
+    DT Aty[COEFNM];
+#pragma HLS array_partition variable = Aty dim = 0
+    DT sumAty[COEFNM];
+#pragma HLS array_partition variable = sumAty dim = 0
+
+    for (int j = 0; j < blocks * SN; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 4096 max = 4096
+        flowBuff[j] = 0;
+    }
+    for (int i = 0; i < COEFNM; ++i) {
+#pragma HLS unroll
+        for (int k = 0; k < UN; ++k) {
+            coef[k][i] = 0;
+        }
+    }
+    // Delete the last steps
+    for (int i = 0; i < COEFNM; ++i) {
+        for (int j = 0; j < COEFNM; ++j) {
+#pragma HLS pipeline II = 1
+            DT u = Ustrm.read();
+            DT v = Vstrm.read();
+            DT s = Sstrm.read();
+        }
+    }
+BACKTRACE_LOOP:
+    for (int i = steps - 2; i >= 0; --i) {
+#pragma HLS loop_tripcount min = 7 max = 7
+        for (int k = 0; k < COEFNM; ++k) {
+#pragma HLS unroll
+            sumAty[k] = 0;
+        }
+    CHUNK_LOOP:
+        for (int c = 0; c < blocks; c += CHUNK) {
+#pragma HLS loop_tripcount min = 1 max = 1
+            int paths = ((blocks - c < CHUNK) ? (blocks - c) : CHUNK) * SN;
+            // load the cash flows of the chunk and its prices at the previous (later) step
+            for (int p = 0; p < paths; ++p) {
+#pragma HLS loop_tripcount min = 4096 max = 4096
+#pragma HLS pipeline II = 1
+                ap_uint<SZ* UN> f = flowBuff[c * SN + p];
+                ap_uint<SZ* UN> in = priceIn[(c + p / SN) * steps * SN + (i + 1) * SN + p % SN];
+                for (int k = 0; k < UN; ++k) {
+                    int64_t f_i = f((k + 1) * SZ - 1, k * SZ);
+                    int64_t i_i = in((k + 1) * SZ - 1, k * SZ);
+                    y[k][p] = bitsToDouble(f_i);
+                    pBuff[k][p] = bitsToDouble(i_i);
+                }
+            }
+            ChunkGenAty<DT, COEFNM, SamplesNm, UN, SN>(i, steps, c, paths, priceIn, dF, y, pBuff, coef, Aty,
+                                                       optionType, strike, invStk);
+            for (int k = 0; k < COEFNM; ++k) {
+#pragma HLS pipeline II = 10
+                sumAty[k] = FPTwoAdd(sumAty[k], Aty[k]);
+            }
+            // store the updated cash flows
+            for (int p = 0; p < paths; ++p) {
+#pragma HLS loop_tripcount min = 4096 max = 4096
+#pragma HLS pipeline II = 1
+                ap_uint<SZ* UN> f;
+                for (int k = 0; k < UN; ++k) {
+                    f((k + 1) * SZ - 1, k * SZ) = doubleToBits(y[k][p]);
+                }
+                flowBuff[c * SN + p] = f;
+            }
+        }
+        CalcLinear<DT, COEFNM>(Ustrm, Vstrm, Sstrm, sumAty, coef[0]);
+        for (int j = 0; j < COEFNM; ++j) {
+#pragma HLS loop_tripcount min = 4 max = 4
+#pragma HLS pipeline
+            for (int k = 1; k < UN; ++k) {
+#pragma HLS loop_tripcount min = UN max = UN
+                coef[k][j] = coef[0][j];
+            }
+            coefStrm[j].write(coef[0][j]);
+        }
+    }
+}
+
 ///@brief write the coeff data to DDR, the data width is COEFNM*double
 template <typename DT, int UN, int Size>
 void write_ddr(int depth, hls::stream<DT> in_strm[UN], ap_uint<UN * Size>* Out) {
@@ -107,7 +107,9 @@ enum OptionStyle {
     Asian_AP,
     Asian_AS,
     Asian_GP,
-    EuropeanBypass
+    EuropeanBypass,
+    EuropeanControlVariate,
+    EuropeanGreeks
 };
 /**
  * @brief Barrier Option type
@@ -37,21 +37,20 @@ void subMax(dataType m[N], dataType& n) {
 template <typename dataType, int M, int N>
 void maxMatrix(dataType m[M][N], dataType& maxValue) {
 #pragma HLS inline off
-    dataType max1[4]; // need dataflow for the seconde for and third for
+    dataType max1[M]; // need dataflow for the seconde for and third for
 Max_Loop2:
-    for (int i = 0; i < 4; ++i) {
+    for (int i = 0; i < M; ++i) {
 #pragma HLS unroll
-        dataType m1 = hls::abs(m[i][0]);
-        dataType m2 = hls::abs(m[i][1]);
-        dataType m3 = hls::abs(m[i][2]);
-        dataType m4 = hls::abs(m[i][3]);
-        dataType m11 = (m1 > m2) ? m1 : m2;
-        dataType m22 = (m3 > m4) ? m3 : m4;
-        max1[i] = (m11 > m22) ? m11 : m22;
+        max1[i] = 0;
+        for (int j = 0; j < N; ++j) {
+            dataType m1 = hls::abs(m[i][j]);
+            max1[i] = (max1[i] > m1) ? max1[i] : m1;
+        }
+    }
+    maxValue = 0;
+    for (int i = 0; i < M; ++i) {
+        maxValue = (maxValue > max1[i]) ? maxValue : max1[i];
     }
-    dataType m11 = (max1[0] > max1[1]) ? max1[0] : max1[1];
-    dataType m22 = (max1[2] > max1[3]) ? max1[2] : max1[3];
-    maxValue = (m11 > m22) ? m11 : m22;
 }
 
 template <typename dataType>
@@ -509,6 +508,35 @@ void jacobi_rotation_2_sided_2x2(dataType dataA[diagSize][diagSize],
     m_s_right *= tmpSqrt;
 }
 
+// apply one 2x2 rotation on rows and columns p, q of A and on columns p, q of U
+template <typename dataType, int diagSize>
+void applyRotation(dataType dataA[diagSize][diagSize],
+                   dataType dataU[diagSize][diagSize],
+                   int p,
+                   int q,
+                   dataType m_c,
+                   dataType m_s) {
+    for (int k = 0; k < diagSize; ++k) {
+#pragma HLS pipeline
+        dataType akp = dataA[k][p];
+        dataType akq = dataA[k][q];
+        applyJacobi2x2KJL(akp, akq, dataA[k][p], dataA[k][q], m_c, m_s);
+    }
+    for (int k = 0; k < diagSize; ++k) {
+#pragma HLS pipeline
+        dataType apk = dataA[p][k];
+        dataType aqk = dataA[q][k];
+        applyJacobi2x2KJL(apk, aqk, dataA[p][k], dataA[q][k], m_c, m_s);
+    }
+    for (int k = 0; k < diagSize; ++k) {
+#pragma HLS pipeline
+        dataType ukp = dataU[k][p];
+        dataType ukq = dataU[k][q];
+        applyJacobi2x2KJL(ukp, ukq, dataU[k][p], dataU[k][q], m_c, m_s);
+    }
+}
+
+// cyclic Jacobi for symmetric matrix of any size, one pair (p, q) at a time
 template <typename dataType, int m_diagSize>
 void Jacobi_svd(dataType dataA[m_diagSize][m_diagSize],
                 dataType sigma[m_diagSize][m_diagSize],
@@ -516,7 +544,32 @@ void Jacobi_svd(dataType dataA[m_diagSize][m_diagSize],
                 dataType dataV[m_diagSize][m_diagSize],
                 dataType dataU_out[m_diagSize][m_diagSize],
                 dataType dataV_out[m_diagSize][m_diagSize],
-                dataType maxValue) {}
+                dataType maxValue) {
+    const int maxSweeps = 32;
+    dataType precisionValue = 2.22045e-16 * maxValue;
+    dataType considerAsZero = 2.2250738585072014e-308;
+    dataType threshold = (considerAsZero > precisionValue) ? considerAsZero : precisionValue;
+    bool finished = false;
+Sweep_Loop:
+    for (int sweep = 0; sweep < maxSweeps && !finished; ++sweep) {
+#pragma HLS loop_tripcount min = 3 max = 8
+        finished = true;
+    Loop_p:
+        for (int p = 0; p < m_diagSize - 1; ++p) {
+        Loop_q:
+            for (int q = p + 1; q < m_diagSize; ++q) {
+                if (hls::abs(dataA[p][q]) > threshold || hls::abs(dataA[q][p]) > threshold) {
+                    finished = false;
+                    dataType m_c_left, m_s_left, m_c_right, m_s_right;
+                    jacobi_rotation_2x2<dataType, m_diagSize>(dataA, considerAsZero, p, q, m_c_left, m_s_left,
+                                                              m_c_right, m_s_right);
+                    applyRotation<dataType, m_diagSize>(dataA, dataU_out, p, q, m_c_right, m_s_right);
+                }
+            }
+        }
+    }
+    copyMatrix<dataType, m_diagSize>(dataA, sigma);
+}
 
 template <>
 inline void Jacobi_svd<double, 4>(double dataA[4][4],
@@ -602,6 +655,9 @@ While_Loop:
 /**
  * @brief Jacobi Singular Value Decomposition (SVD).
  *
+ * The input matrix is symmetric, so the right matrix is the left one. A 4 x 4 matrix is decomposed with two
+ * disjoint rotations in parallel, any other size with cyclic rotations of one pair of rows and columns at a time.
+ *
  * @tparam dataType data type.
  * @tparam diagSize matrix size.
  * @param dataA diagSize x diagSize matrix
@@ -674,7 +730,7 @@ Loop_postcal:
         }
     }
 
-    internal::copyMatrix<double, 4>(dataU_out2, dataV_out2); // copy Matrix U to Matrix V
+    internal::copyMatrix<dataType, diagSize>(dataU_out2, dataV_out2); // copy Matrix U to Matrix V
 }
 } // namespace fintech
 } // namespace xf
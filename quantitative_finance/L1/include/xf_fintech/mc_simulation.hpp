@@ -176,6 +176,234 @@ void MultipleMonteCarloModel(ap_uint<16> steps,
     }
 }
 
+template <typename DT, int N>
+void accumulatorMulti(ap_uint<16> paths,
+                      hls::stream<DT> priceStrmIn[N],
+                      hls::stream<DT> sumStrm[N],
+                      hls::stream<DT> squareSumStrm[N]) {
+#pragma HLS inline off
+    const unsigned int DEP = 16;
+    DT sumBuffer[N][DEP]; // because the latency of ACC_LOOP is 14
+#pragma HLS array_partition variable = sumBuffer dim = 1
+    DT squareSumBuffer[N][DEP];
+#pragma HLS array_partition variable = squareSumBuffer dim = 1
+BUFF_INIT_LOOP:
+    for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 1
+        for (int k = 0; k < N; ++k) {
+#pragma HLS unroll
+            sumBuffer[k][i] = 0;
+            squareSumBuffer[k][i] = 0;
+        }
+    }
+    ap_uint<4> cnt = 0;
+ACC_LOOP:
+    for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        for (int k = 0; k < N; ++k) {
+#pragma HLS unroll
+            DT temp = priceStrmIn[k].read();
+            DT mulTemp = FPTwoMul(temp, temp);
+            sumBuffer[k][cnt] = FPTwoAdd(sumBuffer[k][cnt], temp);
+            squareSumBuffer[k][cnt] = FPTwoAdd(squareSumBuffer[k][cnt], mulTemp);
+        }
+        cnt++;
+    }
+POST_ACC_LOOP:
+    for (int k = 0; k < N; ++k) {
+        DT sum = 0;
+        DT squareSum = 0;
+        for (int i = 0; i < DEP; ++i) {
+#pragma HLS pipeline II = 8
+            sum += sumBuffer[k][i];
+            squareSum += squareSumBuffer[k][i];
+        }
+        sumStrm[k].write(sum);
+        squareSumStrm[k].write(squareSum);
+    }
+}
+
+/**
+ * @brief Monte Carlo module whose path pricer produces PathPricerT::OutN
+ * estimators per path. Each estimator is accumulated independently, antithetic
+ * paths (if any) are expected to be combined inside the path pricer.
+ */
+template <typename DT, typename RNG, typename PathGeneratorT, typename PathPricerT, typename RNGSeqT, int VariateNum>
+void monteCarloModelMulti(ap_uint<16> steps,
+                          ap_uint<16> paths,
+                          RNG rngInst[VariateNum],
+                          PathGeneratorT pathGenInst[1],
+                          PathPricerT pathPriInst[1],
+                          RNGSeqT rngSeqInst[1],
+                          hls::stream<DT> sumStrm[PathPricerT::OutN],
+                          hls::stream<DT> squareSumStrm[PathPricerT::OutN]) {
+#pragma HLS inline off
+#pragma HLS DATAFLOW
+    const static unsigned int RN = RNGSeqT::OutN;
+    const static unsigned int IN = PathPricerT::InN;
+    const static unsigned int PN = PathPricerT::OutN;
+
+    hls::stream<DT> rdNmStrm[RN];
+#pragma HLS stream variable = rdNmStrm depth = 8
+    hls::stream<DT> pathStrm[IN];
+#pragma HLS stream variable = pathStrm depth = 8
+    hls::stream<DT> priceStrm[PN];
+#pragma HLS stream variable = priceStrm depth = 8
+    // Generate random number
+    rngSeqInst[0].NextSeq(steps, paths, rngInst, rdNmStrm);
+    pathGenInst[0].NextPath(steps, paths, rdNmStrm, pathStrm);
+    pathPriInst[0].Pricing(steps, paths, pathStrm, priceStrm);
+    accumulatorMulti<DT, PN>(paths, priceStrm, sumStrm, squareSumStrm);
+}
+
+template <typename DT,
+          typename RNG,
+          int UnrollNm,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int VariateNum>
+void MultipleMonteCarloModelMulti(ap_uint<16> steps,
+                                  ap_uint<16> paths,
+                                  RNG rngInst[UnrollNm][VariateNum],
+                                  PathGeneratorT pathGenInst[UnrollNm][1],
+                                  PathPricerT pathPriInst[UnrollNm][1],
+                                  RNGSeqT rngSeqInst[UnrollNm][1],
+                                  DT sum[PathPricerT::OutN],
+                                  DT squareSum[PathPricerT::OutN]) {
+    const static unsigned int PN = PathPricerT::OutN;
+    hls::stream<DT> sumStrm[UnrollNm][PN];
+#pragma HLS stream variable = sumStrm depth = PN
+#pragma HLS array_partition variable = sumStrm dim = 0
+    hls::stream<DT> squareSumStrm[UnrollNm][PN];
+#pragma HLS stream variable = squareSumStrm depth = PN
+#pragma HLS array_partition variable = squareSumStrm dim = 0
+
+    for (int i = 0; i < UnrollNm; ++i) {
+#pragma HLS unroll
+        monteCarloModelMulti<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            steps, paths, rngInst[i], pathGenInst[i], pathPriInst[i], rngSeqInst[i], sumStrm[i], squareSumStrm[i]);
+    }
+    for (int i = 0; i < UnrollNm; ++i) {
+        for (int k = 0; k < PN; ++k) {
+#pragma HLS pipeline
+            DT sumTemp = sumStrm[i][k].read();
+            DT squareTemp = squareSumStrm[i][k].read();
+            sum[k] = FPTwoAdd(sum[k], sumTemp);
+            squareSum[k] = FPTwoAdd(squareSum[k], squareTemp);
+        }
+    }
+}
+
+template <typename DT, int MaxOptions>
+void batchAccumulator(ap_uint<16> paths,
+                      ap_uint<16> optNum,
+                      hls::stream<DT>& payoffStrmIn,
+                      hls::stream<DT>& sumStrm) {
+#pragma HLS inline off
+    DT sumBuffer[MaxOptions];
+BUFF_INIT_LOOP:
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        sumBuffer[k] = 0;
+    }
+ACC_LOOP:
+    for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+// the same entry is updated once every optNum cycles, optNum is padded to a
+// multiple of 16 which covers the latency of the adder
+#pragma HLS dependence variable = sumBuffer inter false
+            DT temp = payoffStrmIn.read();
+            sumBuffer[k] = FPTwoAdd(sumBuffer[k], temp);
+        }
+    }
+OUT_LOOP:
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        sumStrm.write(sumBuffer[k]);
+    }
+}
+
+/**
+ * @brief Monte Carlo module whose paths are shared by a batch of options, the
+ * batch path pricer produces optNum payoffs per path.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int VariateNum,
+          int MaxOptions>
+void monteCarloModelBatch(ap_uint<16> steps,
+                          ap_uint<16> paths,
+                          ap_uint<16> optNum,
+                          RNG rngInst[VariateNum],
+                          PathGeneratorT pathGenInst[1],
+                          PathPricerT pathPriInst[1],
+                          RNGSeqT rngSeqInst[1],
+                          hls::stream<DT>& sumStrm) {
+#pragma HLS inline off
+#pragma HLS DATAFLOW
+    const static unsigned int RN = RNGSeqT::OutN;
+    const static unsigned int IN = PathPricerT::InN;
+
+    hls::stream<DT> rdNmStrm[RN];
+#pragma HLS stream variable = rdNmStrm depth = 8
+    hls::stream<DT> pathStrm[IN];
+#pragma HLS stream variable = pathStrm depth = 8
+    hls::stream<DT> payoffStrm;
+#pragma HLS stream variable = payoffStrm depth = 8
+    // Generate random number
+    rngSeqInst[0].NextSeq(steps, paths, rngInst, rdNmStrm);
+    pathGenInst[0].NextPath(steps, paths, rdNmStrm, pathStrm);
+    pathPriInst[0].Pricing(steps, paths, pathStrm, payoffStrm);
+    batchAccumulator<DT, MaxOptions>(paths, optNum, payoffStrm, sumStrm);
+}
+
+template <typename DT,
+          typename RNG,
+          int UnrollNm,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int VariateNum,
+          int MaxOptions>
+void MultipleMonteCarloModelBatch(ap_uint<16> steps,
+                                  ap_uint<16> paths,
+                                  ap_uint<16> optNum,
+                                  RNG rngInst[UnrollNm][VariateNum],
+                                  PathGeneratorT pathGenInst[UnrollNm][1],
+                                  PathPricerT pathPriInst[UnrollNm][1],
+                                  RNGSeqT rngSeqInst[UnrollNm][1],
+                                  DT sum[MaxOptions]) {
+    // each module writes all of its optNum sums before they are reduced
+    hls::stream<DT> sumStrm[UnrollNm];
+#pragma HLS stream variable = sumStrm depth = MaxOptions
+#pragma HLS array_partition variable = sumStrm dim = 0
+
+    for (int i = 0; i < UnrollNm; ++i) {
+#pragma HLS unroll
+        monteCarloModelBatch<DT, RNG, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum, MaxOptions>(
+            steps, paths, optNum, rngInst[i], pathGenInst[i], pathPriInst[i], rngSeqInst[i], sumStrm[i]);
+    }
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        DT sumTemp = sum[k];
+        for (int i = 0; i < UnrollNm; ++i) {
+#pragma HLS pipeline
+            sumTemp = FPTwoAdd(sumTemp, sumStrm[i].read());
+        }
+        sum[k] = sumTemp;
+    }
+}
+
 template <typename DT>
 inline DT SampleMean(DT sum, ap_uint<27> weightSum) {
     return sum / weightSum;
@@ -197,6 +425,51 @@ void InitWrap(RNG rngInst[UnrollNm][VariateNum], RNGSeqT rngSeqInst[UnrollNm][1]
         rngSeqInst[i][0].Init(rngInst[i]);
     }
 }
+
+/**
+ * @brief Computes the number of extra samples of each level of a multilevel
+ * Monte Carlo, so that the variance of the estimator is half of the square of
+ * the required RMSE at the minimal cost. The cost of a sample of level l is
+ * taken as the number of its fine steps.
+ *
+ * @return true if any level needs extra samples.
+ */
+template <typename DT, int MaxLevels>
+bool multiLevelExtraSamples(int levels,
+                            ap_uint<16> baseSteps,
+                            DT requiredRMSE,
+                            ap_uint<27> maxSamples,
+                            ap_uint<16> batch,
+                            DT var[MaxLevels],
+                            ap_uint<27> samples[MaxLevels],
+                            ap_uint<27> extra[MaxLevels]) {
+    DT sumVC = 0;
+    for (int l = 0; l < levels; ++l) {
+#pragma HLS loop_tripcount min = 4 max = 4
+        DT cost = baseSteps << l;
+        sumVC += hls::sqrt(var[l] * cost);
+    }
+    DT factor = 2 * sumVC / (requiredRMSE * requiredRMSE);
+    bool more = false;
+    for (int l = 0; l < levels; ++l) {
+#pragma HLS loop_tripcount min = 4 max = 4
+        DT cost = baseSteps << l;
+        DT n = factor * hls::sqrt(var[l] / cost);
+        // rounded up to a multiple of the batch, within the whole batches of maxSamples
+        ap_uint<27> maxBatches = (maxSamples / batch) * batch;
+        ap_uint<27> nOpt = maxBatches;
+        if (n < (DT)maxBatches) {
+            nOpt = ((ap_uint<27>)n / batch + 1) * batch;
+        }
+        if (nOpt > samples[l]) {
+            extra[l] = nOpt - samples[l];
+            more = true;
+        } else {
+            extra[l] = 0;
+        }
+    }
+    return more;
+}
 } // namespace internal
 /**
  * @brief Monte Carlo Framework implementation
@@ -310,6 +583,339 @@ Req_Samples_Loop:
 #endif
     return mean; // SampleMean(sum, totalSamples);
 }
+/**
+ * @brief Monte Carlo Framework for path pricers with several outputs per path,
+ * e.g. the price together with its pathwise sensitivities, or the payoffs of a
+ * batch of options sharing the same simulated paths. All outputs are estimated
+ * from the same paths in one simulation pass.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type which simulates the dynamics of
+ * the asset price.
+ * @tparam PathPricerT path pricer type which calculates PathPricerT::OutN
+ * estimators per path.
+ * @tparam RNGSeqT random number sequence generator type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the total samples are divided into several steps, SampNum is
+ * the number for each step.
+ * @param timeSteps number of the steps for each path.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop.
+ * @param requiredTolerance the tolerance required. If requiredSamples is not
+ * set, when reaching the required tolearance on the first output, simulation
+ * will stop.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ * @param output the sample mean of each of the PathPricerT::OutN outputs.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum>
+void mcSimulationMulti(ap_uint<16> timeSteps,
+                       ap_uint<27> maxSamples,
+                       ap_uint<27> requiredSamples,
+                       DT requiredTolerance,
+                       PathGeneratorT pathGenInst[UN][1],
+                       PathPricerT pathPriInst[UN][1],
+                       RNGSeqT rngSeqInst[UN][1],
+                       DT output[PathPricerT::OutN]) {
+    const static unsigned int PN = PathPricerT::OutN;
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // RNG Instance
+    RNG rngInst[UN][VariateNum];
+#pragma HLS array_partition variable = rngInst dim = 0
+
+    // Initialize RNG
+    internal::InitWrap<RNG, RNGSeqT, UN, VariateNum>(rngInst, rngSeqInst);
+
+    // record the total number of samples
+    ap_uint<27> totalSamples = 0;
+
+    // sum and square sum of all samples for each output
+    DT sum[PN];
+#pragma HLS array_partition variable = sum dim = 0
+    DT squareSum[PN];
+#pragma HLS array_partition variable = squareSum dim = 0
+    for (int k = 0; k < PN; ++k) {
+#pragma HLS unroll
+        sum[k] = 0;
+        squareSum[k] = 0;
+    }
+
+    // simulation times
+    ap_uint<17> loopNum = 0;
+
+    if (requiredSamples > 0) {
+        loopNum = (requiredSamples + Batch - 1) / Batch;
+        totalSamples = loopNum * Batch;
+    } else {
+        loopNum = 1;
+        totalSamples = Batch;
+    }
+
+Req_Samples_Loop:
+    for (int i = 0; i < loopNum; ++i) {
+#pragma HLS loop_tripcount min = 1 max = 1
+        internal::MultipleMonteCarloModelMulti<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+            timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum);
+    }
+    DT mean = internal::SampleMean(sum[0], totalSamples);
+    DT error = internal::SampleErrorEstimate(mean, sum[0], squareSum[0], totalSamples);
+    if (requiredSamples == 0) {
+    Req_Tolerance_Loop:
+        while ((requiredTolerance < error) && ((maxSamples > 0 && totalSamples < maxSamples) || maxSamples == 0)) {
+#pragma HLS loop_tripcount min = 5 max = 5
+            totalSamples += Batch;
+            // Monte Carlo Module
+            internal::MultipleMonteCarloModelMulti<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+                timeSteps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum, squareSum);
+            mean = internal::SampleMean(sum[0], totalSamples);
+            error = internal::SampleErrorEstimate(mean, sum[0], squareSum[0], totalSamples);
+        }
+    }
+    for (int k = 0; k < PN; ++k) {
+#pragma HLS pipeline
+        output[k] = internal::SampleMean(sum[k], totalSamples);
+    }
+}
+/**
+ * @brief Monte Carlo Framework for a batch of options sharing the same
+ * simulated paths. Each path is generated once and fanned out to the optNum
+ * payoffs of the batch path pricer, so the cost of path generation is paid once
+ * for the whole batch.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type which simulates the dynamics of
+ * the asset price.
+ * @tparam PathPricerT batch path pricer type which writes optNum payoffs per
+ * path.
+ * @tparam RNGSeqT random number sequence generator type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the total samples are divided into several steps, SampNum is
+ * the number for each step.
+ * @tparam MaxOptions the maximum number of options in the batch, a multiple of
+ * 16.
+ * @param timeSteps number of the steps for each path.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop.
+ * @param optNum the number of options in the batch, a multiple of 16.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of batch path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ * @param output the price of each option in the batch.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum,
+          int MaxOptions>
+void mcSimulationBatch(ap_uint<16> timeSteps,
+                       ap_uint<27> requiredSamples,
+                       ap_uint<16> optNum,
+                       PathGeneratorT pathGenInst[UN][1],
+                       PathPricerT pathPriInst[UN][1],
+                       RNGSeqT rngSeqInst[UN][1],
+                       DT output[MaxOptions]) {
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // RNG Instance
+    RNG rngInst[UN][VariateNum];
+#pragma HLS array_partition variable = rngInst dim = 0
+
+    // Initialize RNG
+    internal::InitWrap<RNG, RNGSeqT, UN, VariateNum>(rngInst, rngSeqInst);
+
+    // sum of all samples for each option, the number of samples is fixed so
+    // no square sum is kept for an error estimate
+    DT sum[MaxOptions];
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        sum[k] = 0;
+    }
+
+    ap_uint<17> loopNum = (requiredSamples > 0) ? (ap_uint<17>)((requiredSamples + Batch - 1) / Batch) : (ap_uint<17>)1;
+    ap_uint<27> totalSamples = loopNum * Batch;
+
+Req_Samples_Loop:
+    for (int i = 0; i < loopNum; ++i) {
+#pragma HLS loop_tripcount min = 1 max = 1
+        internal::MultipleMonteCarloModelBatch<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum,
+                                               MaxOptions>(timeSteps, SampNum, optNum, rngInst, pathGenInst,
+                                                           pathPriInst, rngSeqInst, sum);
+    }
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        output[k] = internal::SampleMean(sum[k], totalSamples);
+    }
+}
+/**
+ * @brief Multilevel Monte Carlo Framework for the Black-Scholes path generator.
+ *
+ * Level l simulates paths of baseSteps * 2^l steps. Except for level 0, the path
+ * pricer prices each path on its fine grid and on the coarse grid of every
+ * second point, and writes the difference, so that the sum of the level means
+ * telescopes to the price on the finest grid. The number of samples of each
+ * level follows the observed variances (Giles, 2008), and a level is added as
+ * long as the bias estimated from the last two levels, assuming first order
+ * weak convergence, is above requiredRMSE / sqrt(2).
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam RNG random number generator type.
+ * @tparam PathGeneratorT path generator type, it must hold a BSModel BSInst
+ * whose time interval is updated for each level.
+ * @tparam PathPricerT multilevel path pricer type, whose member coarse is set
+ * for the levels above 0.
+ * @tparam RNGSeqT random number sequence generator type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam VariateNum number of variate.
+ * @tparam SampNum the number of samples per call of a Monte Carlo Module.
+ * @tparam MaxLevels the maximum number of levels.
+ * @param baseSteps number of the steps of the paths of level 0.
+ * @param timeLength time length of the paths.
+ * @param maxSamples the maximum sample number of each level.
+ * @param requiredRMSE the root mean square error required, including the
+ * discretization bias.
+ * @param pathGenInst instance of path generator.
+ * @param pathPriInst instance of path pricer.
+ * @param rngSeqInst instance of random number sequence.
+ */
+template <typename DT,
+          typename RNG,
+          typename PathGeneratorT,
+          typename PathPricerT,
+          typename RNGSeqT,
+          int UN,
+          int VariateNum,
+          int SampNum,
+          int MaxLevels>
+DT mcMultiLevelSimulation(ap_uint<16> baseSteps,
+                          DT timeLength,
+                          ap_uint<27> maxSamples,
+                          DT requiredRMSE,
+                          PathGeneratorT pathGenInst[UN][1],
+                          PathPricerT pathPriInst[UN][1],
+                          RNGSeqT rngSeqInst[UN][1]) {
+#ifndef __SYNTHESIS__
+    assert((baseSteps << (MaxLevels - 1)) <= 65535 && "The steps of the finest level exceed 65535");
+#endif
+    // total number of samples per simulation
+    const static ap_uint<16> Batch = UN * SampNum;
+
+    // RNG Instance
+    RNG rngInst[UN][VariateNum];
+#pragma HLS array_partition variable = rngInst dim = 0
+
+    // Initialize RNG
+    internal::InitWrap<RNG, RNGSeqT, UN, VariateNum>(rngInst, rngSeqInst);
+
+    // sum and square sum of the samples of each level
+    DT sum[MaxLevels];
+    DT squareSum[MaxLevels];
+    DT mean[MaxLevels];
+    DT var[MaxLevels];
+    ap_uint<27> samples[MaxLevels];
+    ap_uint<27> extra[MaxLevels];
+    for (int l = 0; l < MaxLevels; ++l) {
+#pragma HLS pipeline II = 1
+        sum[l] = 0;
+        squareSum[l] = 0;
+        mean[l] = 0;
+        var[l] = 0;
+        samples[l] = 0;
+        extra[l] = Batch;
+    }
+
+    // start with 3 levels and a batch of pilot samples each
+    int levels = MaxLevels < 3 ? MaxLevels : 3;
+    bool converged = false;
+Levels_Loop:
+    while (!converged) {
+#pragma HLS loop_tripcount min = 5 max = 5
+        for (int l = 0; l < levels; ++l) {
+#pragma HLS loop_tripcount min = 4 max = 4
+            if (extra[l] > 0) {
+                ap_uint<16> steps = baseSteps << l;
+                DT dt = timeLength / steps;
+                for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+                    pathGenInst[i][0].BSInst.variance(dt);
+                    pathGenInst[i][0].BSInst.stdDeviation();
+                    pathGenInst[i][0].BSInst.updateDrift(dt);
+                    pathPriInst[i][0].coarse = (l > 0);
+                }
+                ap_uint<27> loopNum = extra[l] / Batch;
+            Level_Samples_Loop:
+                for (int i = 0; i < loopNum; ++i) {
+#pragma HLS loop_tripcount min = 1 max = 1
+                    internal::MultipleMonteCarloModel<DT, RNG, UN, PathGeneratorT, PathPricerT, RNGSeqT, VariateNum>(
+                        steps, SampNum, rngInst, pathGenInst, pathPriInst, rngSeqInst, sum[l], squareSum[l]);
+                }
+                samples[l] += loopNum * Batch;
+                mean[l] = internal::SampleMean(sum[l], samples[l]);
+                DT v = internal::FPTwoSub(squareSum[l] / samples[l], internal::FPTwoMul(mean[l], mean[l]));
+                var[l] = MAX(v, 0);
+            }
+        }
+        bool more = internal::multiLevelExtraSamples<DT, MaxLevels>(levels, baseSteps, requiredRMSE, maxSamples,
+                                                                    Batch, var, samples, extra);
+        if (!more) {
+            DT last = hls::abs(mean[levels - 1]);
+            DT prev = internal::FPTwoMul((DT)0.5, hls::abs(mean[levels - 2]));
+            DT bias = MAX(last, prev);
+            if (bias * hls::sqrt((DT)2.0) <= requiredRMSE || levels == MaxLevels) {
+                converged = true;
+            } else {
+                // the variance of the new level is extrapolated from the last one
+                var[levels] = internal::FPTwoMul((DT)0.5, var[levels - 1]);
+                levels++;
+                internal::multiLevelExtraSamples<DT, MaxLevels>(levels, baseSteps, requiredRMSE, maxSamples, Batch,
+                                                                var, samples, extra);
+            }
+        }
+#ifndef __SYNTHESIS__
+#ifdef HLS_DEBUG
+        for (int l = 0; l < levels; ++l) {
+            std::cout << "level " << l << ": samples=" << samples[l] << ", mean=" << mean[l] << ", var=" << var[l]
+                      << std::endl;
+        }
+#endif
+#endif
+    }
+
+    DT price = 0;
+    for (int l = 0; l < levels; ++l) {
+#pragma HLS loop_tripcount min = 4 max = 4
+        price = internal::FPTwoAdd(price, mean[l]);
+    }
+    return price;
+}
 } // namespace fintech
 } // namespace xf
 #endif
@@ -121,6 +121,115 @@ class MultiAssetPathPricer<European, DT, ASSETS, SampleNum> {
     }
 };
 
+template <OptionStyle style, typename DT, int SampNum, bool WithAntithetic, int MaxSteps, int MaxOptions>
+class BatchPathPricer {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+    BatchPathPricer() {}
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT>& payoffStrmOut) {
+#ifndef __SYNTHESIS__
+        printf("Option Style is not supported now!\n");
+#endif
+    }
+};
+
+/**
+ * @brief Batch path pricer which fans every simulated path out to a batch of
+ * European options on the same underlying, so that a whole strike / maturity
+ * grid is priced from one set of paths.
+ *
+ * The log-price of each path is recorded at every time step, then the
+ * discounted payoff of each option in the batch is evaluated from the step
+ * nearest to its maturity and written to the output stream, optNum values per
+ * path. The log-price at that step is mapped to the maturity T of the option
+ * as logS(T) = volScale * logS(step) + logShift, which rescales the Brownian
+ * part to the variance of T and replaces the drift by the one of T, so each
+ * option sees the exact Black-Scholes distribution at its own maturity.
+ *
+ * @tparam DT supported data type including double and float data type.
+ * @tparam SampNum the number of paths per call of Pricing.
+ * @tparam WithAntithetic the antithetic path is averaged into each payoff.
+ * @tparam MaxSteps the maximum number of time steps of a path.
+ * @tparam MaxOptions the maximum number of options in the batch.
+ */
+template <typename DT, int SampNum, bool WithAntithetic, int MaxSteps, int MaxOptions>
+class BatchPathPricer<European, DT, SampNum, WithAntithetic, MaxSteps, MaxOptions> {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+
+    const static bool byPassGen = false;
+
+    // configuration of the path pricer
+    DT underlying;
+    // number of options in the batch
+    ap_uint<16> optNum;
+    DT strike[MaxOptions];
+    DT discount[MaxOptions];
+    // time step nearest to the maturity of each option, in range [1, steps]
+    ap_uint<16> maturityStep[MaxOptions];
+    // map from the log-price at maturityStep to the one at the maturity
+    DT volScale[MaxOptions];
+    DT logShift[MaxOptions];
+    bool optionType[MaxOptions];
+
+    BatchPathPricer() {
+#pragma HLS inline
+    }
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT>& payoffStrmOut) {
+#pragma HLS inline off
+        DT logS[InN][MaxSteps + 1];
+#pragma HLS array_partition variable = logS dim = 1
+    PATH_LOOP:
+        for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+            DT acc[InN];
+#pragma HLS array_partition variable = acc dim = 0
+            for (int j = 0; j < InN; ++j) {
+#pragma HLS unroll
+                acc[j] = 0;
+                logS[j][0] = 0;
+            }
+        STEP_LOOP:
+            for (int t = 1; t <= steps; ++t) {
+#pragma HLS pipeline
+#pragma HLS loop_tripcount min = 8 max = 8
+                for (int j = 0; j < InN; ++j) {
+#pragma HLS unroll
+                    DT dLogS = pathStrmIn[j].read();
+                    acc[j] = FPTwoAdd(acc[j], dLogS);
+                    logS[j][t] = acc[j];
+                }
+            }
+        OPTION_LOOP:
+            for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+                DT payoff[InN];
+#pragma HLS array_partition variable = payoff dim = 0
+                for (int j = 0; j < InN; ++j) {
+#pragma HLS unroll
+                    DT s1 = FPExp(FPTwoAdd(FPTwoMul(volScale[k], logS[j][maturityStep[k]]), logShift[k]));
+                    DT s = FPTwoMul(underlying, s1);
+                    DT p1 = optionType[k] ? FPTwoSub(strike[k], s) : FPTwoSub(s, strike[k]);
+                    payoff[j] = MAX(p1, 0);
+                }
+                DT p = payoff[0];
+                if (WithAntithetic) {
+                    p = FPTwoMul((DT)0.5, FPTwoAdd(payoff[0], payoff[InN - 1]));
+                }
+                payoffStrmOut.write(FPTwoMul(discount[k], p));
+            }
+        }
+    }
+};
+
 template <typename DT, bool StepFirst, int SampNum, bool WithAntithetic>
 class PathPricer<European, DT, StepFirst, SampNum, WithAntithetic> {
    public:
@@ -227,6 +336,183 @@ class PathPricer<EuropeanBypass, DT, StepFirst, SampNum, WithAntithetic> {
     }
 };
 
+/**
+ * @brief European path pricer with the discounted terminal asset price as
+ * control variate.
+ *
+ * Each sample is Y = discount * payoff(S_T) - cvBeta * (discount * S_T - cvMean),
+ * where cvMean = E[discount * S_T] = S_0 * exp(-q * T) is known analytically,
+ * so E[Y] is the option price and Var[Y] is reduced by the correlation between
+ * the payoff and the terminal price.
+ */
+template <typename DT, bool StepFirst, int SampNum, bool WithAntithetic>
+class PathPricer<EuropeanControlVariate, DT, StepFirst, SampNum, WithAntithetic> {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+    const static unsigned int OutN = InN;
+
+    const static bool byPassGen = false;
+
+    // configuration of the path pricer
+    DT strike;
+    DT underlying;
+    DT discount;
+    // coefficient of the control variate, Black-Scholes delta divided by exp(-q * T)
+    DT cvBeta;
+    // expectation of the discounted terminal price
+    DT cvMean;
+
+    bool optionType;
+
+    PathPricer() {}
+
+    void PE(ap_uint<16> steps, ap_uint<16> paths, hls::stream<DT>& pathStrmIn, hls::stream<DT>& priceStrmOut) {
+#pragma HLS inline off
+        for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+            DT logS = pathStrmIn.read();
+            DT s1 = FPExp(logS);
+            DT s = FPTwoMul(underlying, s1);
+            DT op1 = 0;
+            DT op2 = 0;
+            if (optionType) {
+                op1 = strike;
+                op2 = s;
+            } else {
+                op1 = s;
+                op2 = strike;
+            }
+            DT p1 = FPTwoSub(op1, op2);
+            DT payoff = MAX(p1, 0);
+            DT price = FPTwoMul(discount, payoff);
+            DT ds = FPTwoMul(discount, s);
+            DT cv = FPTwoSub(ds, cvMean);
+            DT adj = FPTwoMul(cvBeta, cv);
+            DT out = FPTwoSub(price, adj);
+            priceStrmOut.write(out);
+        }
+    } // PE()
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT> priceStrmOut[OutN]) {
+        for (int i = 0; i < InN; ++i) {
+#pragma HLS unroll
+            PE(steps, paths, pathStrmIn[i], priceStrmOut[i]);
+        }
+    }
+};
+
+// configure the control variate of a path pricer, no-op for the pricers without one.
+template <typename PathPricerT, typename DT>
+inline void setControlVariate(PathPricerT& pricer, DT cvBeta, DT cvMean) {}
+
+template <typename DT, bool StepFirst, int SampNum, bool WithAntithetic>
+inline void setControlVariate(PathPricer<EuropeanControlVariate, DT, StepFirst, SampNum, WithAntithetic>& pricer,
+                              DT cvBeta,
+                              DT cvMean) {
+    pricer.cvBeta = cvBeta;
+    pricer.cvMean = cvMean;
+}
+
+/**
+ * @brief European path pricer which estimates the price together with its
+ * sensitivities from the same terminal price, so that all of them come out of a
+ * single simulation pass.
+ *
+ * Given w = ln(S_T / S_0) - (r - q - sigma^2 / 2) * T = sigma * sqrt(T) * Z and
+ * the in-the-money indicator I, the per-path estimators of a call are
+ *   delta: pathwise, discount * I * S_T / S_0
+ *   gamma: likelihood ratio applied to the pathwise delta,
+ *          discount * I * S_T / S_0^2 * (w / (sigma^2 * T) - 1)
+ *   vega:  pathwise, discount * I * S_T * (w - sigma^2 * T) / sigma
+ *   rho:   pathwise, discount * I * S_T * T - T * price
+ * and the put estimators follow with the opposite sign of the derivative of the
+ * payoff. The outputs are written in the order price, delta, gamma, vega, rho.
+ * The path generator is expected to produce the terminal log-price in a single
+ * time step.
+ */
+template <typename DT, bool StepFirst, int SampNum, bool WithAntithetic>
+class PathPricer<EuropeanGreeks, DT, StepFirst, SampNum, WithAntithetic> {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+    const static unsigned int OutN = 5;
+
+    const static bool byPassGen = false;
+
+    // configuration of the path pricer
+    DT strike;
+    DT underlying;
+    DT discount;
+    DT volatility;
+    DT timeLength;
+    // (r - q - sigma^2 / 2) * T, drift of the terminal log-price
+    DT logDrift;
+
+    bool optionType;
+
+    PathPricer() {}
+
+    void PE(DT logS, DT greeks[OutN]) {
+#pragma HLS inline
+        DT s1 = FPExp(logS);
+        DT s = FPTwoMul(underlying, s1);
+        DT varT = FPTwoMul(FPTwoMul(volatility, volatility), timeLength);
+        DT w = FPTwoSub(logS, logDrift);
+        DT op1 = 0;
+        DT op2 = 0;
+        if (optionType) {
+            op1 = strike;
+            op2 = s;
+        } else {
+            op1 = s;
+            op2 = strike;
+        }
+        DT p1 = FPTwoSub(op1, op2);
+        DT payoff = MAX(p1, 0);
+        DT price = FPTwoMul(discount, payoff);
+        // discount * dPayoff/dS_T * S_T, zero out of the money
+        DT dS = (p1 > 0) ? FPTwoMul(discount, s) : (DT)0;
+        dS = optionType ? -dS : dS;
+        DT delta = dS / underlying;
+        DT gamma = FPTwoMul(delta / underlying, FPTwoSub(w / varT, (DT)1.0));
+        DT vega = FPTwoMul(dS, FPTwoSub(w, varT)) / volatility;
+        DT rho = FPTwoMul(FPTwoSub(dS, price), timeLength);
+        greeks[0] = price;
+        greeks[1] = delta;
+        greeks[2] = gamma;
+        greeks[3] = vega;
+        greeks[4] = rho;
+    }
+
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT> priceStrmOut[OutN]) {
+#pragma HLS inline off
+        for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+            DT greeks[InN][OutN];
+#pragma HLS array_partition variable = greeks dim = 0
+            for (int j = 0; j < InN; ++j) {
+#pragma HLS unroll
+                DT logS = pathStrmIn[j].read();
+                PE(logS, greeks[j]);
+            }
+            for (int k = 0; k < OutN; ++k) {
+#pragma HLS unroll
+                DT out = greeks[0][k];
+                if (WithAntithetic) {
+                    out = FPTwoMul((DT)0.5, FPTwoAdd(greeks[0][k], greeks[InN - 1][k]));
+                }
+                priceStrmOut[k].write(out);
+            }
+        }
+    }
+};
+
 template <typename DT, bool StepFirst, int SampNum, bool WithAntithetic>
 class PathPricer<Asian_AP, DT, StepFirst, SampNum, WithAntithetic> {
    public:
@@ -246,6 +532,60 @@ class PathPricer<Asian_AP, DT, StepFirst, SampNum, WithAntithetic> {
 
     PathPricer() {}
 
+    // accumulates step i of path j and sends out the price at the last step
+    void accumulate(int i,
+                    int j,
+                    ap_uint<16> steps,
+                    DT dlogS,
+                    DT prelogS[SampNum],
+                    DT sumlogS[SampNum],
+                    DT sumS[SampNum],
+                    hls::stream<DT>& priceStrmOut) {
+#pragma HLS inline
+        DT tmplogS, tmpprelogS, tmpsumlogS, tmpsumS;
+        if (i == 0) {
+            tmpprelogS = 0;
+            tmpsumlogS = 0;
+            tmpsumS = 1;
+        } else {
+            tmpprelogS = prelogS[j];
+            tmpsumlogS = sumlogS[j];
+            tmpsumS = sumS[j];
+        }
+
+        tmplogS = tmpprelogS + dlogS;
+        prelogS[j] = tmplogS;
+        sumlogS[j] = tmpsumlogS + tmplogS;
+        sumS[j] = tmpsumS + FPExp(tmplogS);
+
+        if (i == steps - 1) {
+            DT sAP = sumS[j] / (steps + 1) * underlying;
+            DT sGP = FPExp(sumlogS[j] / (steps + 1)) * underlying;
+
+            DT op1, op2, op3, op4;
+            if (optionType) {
+                op1 = strike;
+                op2 = sAP;
+                op3 = strike;
+                op4 = sGP;
+            } else {
+                op1 = sAP;
+                op2 = strike;
+                op3 = sGP;
+                op4 = strike;
+            }
+            DT s1 = FPTwoSub(op1, op2);
+            DT s2 = FPTwoSub(op3, op4);
+            DT payoff = MAX(s1, 0);
+            DT payoff2 = MAX(s2, 0);
+            DT price1 = FPTwoMul(payoff, discount);
+            DT price2 = FPTwoMul(payoff2, discount);
+            DT price3 = price1 - price2;
+
+            priceStrmOut.write(price3);
+        }
+    }
+
     void PE(ap_uint<16> steps, ap_uint<16> paths, hls::stream<DT>& pathStrmIn, hls::stream<DT>& priceStrmOut) {
 #pragma HLS inline off
 
@@ -254,9 +594,22 @@ class PathPricer<Asian_AP, DT, StepFirst, SampNum, WithAntithetic> {
         DT sumS[SampNum];
 
         if (StepFirst) {
-#ifndef __SYNTHESIS__
-            printf("Only Samples First is supported now!\n");
-#endif
+            // Path by path, the state of the current path is kept in registers. Each step still adds to the log price
+            // and to the sums of the step before, so the loop runs at an II of the latency of a floating point add,
+            // not 1. The engines set StepFirst only for the LowDiscrepancy sequence, which is built path by path.
+            DT curLogS[1], curSumLogS[1], curSumS[1];
+#pragma HLS array_partition variable = curLogS complete
+#pragma HLS array_partition variable = curSumLogS complete
+#pragma HLS array_partition variable = curSumS complete
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+                for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+#pragma HLS pipeline
+                    DT dlogS = pathStrmIn.read();
+                    accumulate(i, 0, steps, dlogS, curLogS, curSumLogS, curSumS, priceStrmOut);
+                }
+            }
         } else {
             for (int i = 0; i < steps; ++i) {
 #pragma HLS loop_tripcount min = 8 max = 8
@@ -264,49 +617,7 @@ class PathPricer<Asian_AP, DT, StepFirst, SampNum, WithAntithetic> {
 #pragma HLS loop_tripcount min = SampNum max = SampNum
 #pragma HLS pipeline II = 1
                     DT dlogS = pathStrmIn.read();
-
-                    DT tmplogS, tmpprelogS, tmpsumlogS, tmpsumS;
-                    if (i == 0) {
-                        tmpprelogS = 0;
-                        tmpsumlogS = 0;
-                        tmpsumS = 1;
-                    } else {
-                        tmpprelogS = prelogS[j];
-                        tmpsumlogS = sumlogS[j];
-                        tmpsumS = sumS[j];
-                    }
-
-                    tmplogS = tmpprelogS + dlogS;
-                    prelogS[j] = tmplogS;
-                    sumlogS[j] = tmpsumlogS + tmplogS;
-                    sumS[j] = tmpsumS + FPExp(tmplogS);
-
-                    if (i == steps - 1) {
-                        DT sAP = sumS[j] / (steps + 1) * underlying;
-                        DT sGP = FPExp(sumlogS[j] / (steps + 1)) * underlying;
-
-                        DT op1, op2, op3, op4;
-                        if (optionType) {
-                            op1 = strike;
-                            op2 = sAP;
-                            op3 = strike;
-                            op4 = sGP;
-                        } else {
-                            op1 = sAP;
-                            op2 = strike;
-                            op3 = sGP;
-                            op4 = strike;
-                        }
-                        DT s1 = FPTwoSub(op1, op2);
-                        DT s2 = FPTwoSub(op3, op4);
-                        DT payoff = MAX(s1, 0);
-                        DT payoff2 = MAX(s2, 0);
-                        DT price1 = FPTwoMul(payoff, discount);
-                        DT price2 = FPTwoMul(payoff2, discount);
-                        DT price3 = price1 - price2;
-
-                        priceStrmOut.write(price3);
-                    }
+                    accumulate(i, j, steps, dlogS, prelogS, sumlogS, sumS, priceStrmOut);
                 }
             }
         }
@@ -339,6 +650,49 @@ class PathPricer<Asian_AS, DT, StepFirst, SampNum, WithAntithetic> {
 
     PathPricer() {}
 
+    // accumulates step i of path j and sends out the price at the last step
+    void accumulate(int i,
+                    int j,
+                    ap_uint<16> steps,
+                    DT dlogS,
+                    DT prelogS[SampNum],
+                    DT sumlogS[SampNum],
+                    DT sumS[SampNum],
+                    hls::stream<DT>& priceStrmOut) {
+#pragma HLS inline
+        DT tmplogS, tmpprelogS, tmpsumlogS, tmpsumS;
+        if (i == 0) {
+            tmpprelogS = 0;
+            tmpsumS = 1;
+        } else {
+            tmpprelogS = prelogS[j];
+            tmpsumS = sumS[j];
+        }
+
+        tmplogS = tmpprelogS + dlogS;
+        prelogS[j] = tmplogS;
+        DT tmpPrice = FPExp(tmplogS);
+        sumS[j] = tmpsumS + tmpPrice;
+
+        if (i == steps - 1) {
+            DT sAP = sumS[j] / (steps + 1) * underlying;
+            DT price = tmpPrice * underlying;
+
+            DT op1, op2;
+            if (optionType) {
+                op1 = sAP;
+                op2 = price;
+            } else {
+                op1 = price;
+                op2 = sAP;
+            }
+            DT s1 = FPTwoSub(op1, op2);
+            DT payoff = MAX(s1, 0);
+            DT price1 = FPTwoMul(payoff, discount);
+            priceStrmOut.write(price1);
+        }
+    }
+
     void PE(ap_uint<16> steps, ap_uint<16> paths, hls::stream<DT>& pathStrmIn, hls::stream<DT>& priceStrmOut) {
 #pragma HLS inline off
 
@@ -347,9 +701,20 @@ class PathPricer<Asian_AS, DT, StepFirst, SampNum, WithAntithetic> {
         DT sumS[SampNum];
 
         if (StepFirst) {
-#ifndef __SYNTHESIS__
-            printf("Only Samples First is supported now!\n");
-#endif
+            // path state in registers, at an II of the floating point add latency, see Asian_AP
+            DT curLogS[1], curSumLogS[1], curSumS[1];
+#pragma HLS array_partition variable = curLogS complete
+#pragma HLS array_partition variable = curSumLogS complete
+#pragma HLS array_partition variable = curSumS complete
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+                for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+#pragma HLS pipeline
+                    DT dlogS = pathStrmIn.read();
+                    accumulate(i, 0, steps, dlogS, curLogS, curSumLogS, curSumS, priceStrmOut);
+                }
+            }
         } else {
             for (int i = 0; i < steps; ++i) {
 #pragma HLS loop_tripcount min = 8 max = 8
@@ -357,38 +722,7 @@ class PathPricer<Asian_AS, DT, StepFirst, SampNum, WithAntithetic> {
 #pragma HLS loop_tripcount min = SampNum max = SampNum
 #pragma HLS pipeline II = 1
                     DT dlogS = pathStrmIn.read();
-
-                    DT tmplogS, tmpprelogS, tmpsumlogS, tmpsumS;
-                    if (i == 0) {
-                        tmpprelogS = 0;
-                        tmpsumS = 1;
-                    } else {
-                        tmpprelogS = prelogS[j];
-                        tmpsumS = sumS[j];
-                    }
-
-                    tmplogS = tmpprelogS + dlogS;
-                    prelogS[j] = tmplogS;
-                    DT tmpPrice = FPExp(tmplogS);
-                    sumS[j] = tmpsumS + tmpPrice;
-
-                    if (i == steps - 1) {
-                        DT sAP = sumS[j] / (steps + 1) * underlying;
-                        DT price = tmpPrice * underlying;
-
-                        DT op1, op2;
-                        if (optionType) {
-                            op1 = sAP;
-                            op2 = price;
-                        } else {
-                            op1 = price;
-                            op2 = sAP;
-                        }
-                        DT s1 = FPTwoSub(op1, op2);
-                        DT payoff = MAX(s1, 0);
-                        DT price1 = FPTwoMul(payoff, discount);
-                        priceStrmOut.write(price1);
-                    }
+                    accumulate(i, j, steps, dlogS, prelogS, sumlogS, sumS, priceStrmOut);
                 }
             }
         }
@@ -424,6 +758,49 @@ class PathPricer<Asian_GP, DT, StepFirst, SampNum, WithAntithetic> {
 
     PathPricer() {}
 
+    // accumulates step i of path j and sends out the price at the last step
+    void accumulate(int i,
+                    int j,
+                    ap_uint<16> steps,
+                    DT dlogS,
+                    DT prelogS[SampNum],
+                    DT sumlogS[SampNum],
+                    hls::stream<DT>& priceStrmOut) {
+#pragma HLS inline
+        DT tmplogS, tmpprelogS, tmpsumlogS, tmpsumS;
+        if (i == 0) {
+            tmpprelogS = 0;
+            tmpsumlogS = 0;
+        } else {
+            tmpprelogS = prelogS[j];
+            tmpsumlogS = sumlogS[j];
+        }
+
+        tmplogS = tmpprelogS + dlogS;
+        prelogS[j] = tmplogS;
+        sumlogS[j] = tmpsumlogS + tmplogS;
+
+        if (i == steps - 1) {
+            DT sGP = FPExp(sumlogS[j] / (steps + 1)) * underlying;
+
+            // printf("GP value = %lf \n", sGP);
+
+            DT op1, op2, op3, op4;
+            if (optionType) {
+                op3 = strike;
+                op4 = sGP;
+            } else {
+                op3 = sGP;
+                op4 = strike;
+            }
+            DT s2 = FPTwoSub(op3, op4);
+            DT payoff2 = MAX(s2, 0);
+            DT price2 = FPTwoMul(payoff2, discount);
+
+            priceStrmOut.write(price2);
+        }
+    }
+
     void PE(ap_uint<16> steps, ap_uint<16> paths, hls::stream<DT>& pathStrmIn, hls::stream<DT>& priceStrmOut) {
 #pragma HLS inline off
 
@@ -431,9 +808,19 @@ class PathPricer<Asian_GP, DT, StepFirst, SampNum, WithAntithetic> {
         DT sumlogS[SampNum];
 
         if (StepFirst) {
-#ifndef __SYNTHESIS__
-            printf("Only Samples First is supported now!\n");
-#endif
+            // path state in registers, at an II of the floating point add latency, see Asian_AP
+            DT curLogS[1], curSumLogS[1];
+#pragma HLS array_partition variable = curLogS complete
+#pragma HLS array_partition variable = curSumLogS complete
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+                for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+#pragma HLS pipeline
+                    DT dlogS = pathStrmIn.read();
+                    accumulate(i, 0, steps, dlogS, curLogS, curSumLogS, priceStrmOut);
+                }
+            }
         } else {
             for (int i = 0; i < steps; ++i) {
 #pragma HLS loop_tripcount min = 8 max = 8
@@ -441,39 +828,117 @@ class PathPricer<Asian_GP, DT, StepFirst, SampNum, WithAntithetic> {
 #pragma HLS loop_tripcount min = SampNum max = SampNum
 #pragma HLS pipeline II = 1
                     DT dlogS = pathStrmIn.read();
+                    accumulate(i, j, steps, dlogS, prelogS, sumlogS, priceStrmOut);
+                }
+            }
+        }
+    }
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT> priceStrmOut[OutN]) {
+        for (int i = 0; i < InN; ++i) {
+#pragma HLS unroll
+            PE(steps, paths, pathStrmIn[i], priceStrmOut[i]);
+        }
+    }
+};
 
-                    DT tmplogS, tmpprelogS, tmpsumlogS, tmpsumS;
-                    if (i == 0) {
-                        tmpprelogS = 0;
-                        tmpsumlogS = 0;
-                    } else {
-                        tmpprelogS = prelogS[j];
-                        tmpsumlogS = sumlogS[j];
-                    }
+template <OptionStyle style, typename DT, int SampNum, bool WithAntithetic>
+class MultiLevelPathPricer {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+    const static unsigned int OutN = InN;
+    const static bool byPassGen = false;
+    bool coarse;
+    MultiLevelPathPricer() {}
+    void Pricing(ap_uint<16> steps,
+                 ap_uint<16> paths,
+                 hls::stream<DT> pathStrmIn[InN],
+                 hls::stream<DT> priceStrmOut[OutN]) {
+#ifndef __SYNTHESIS__
+        printf("Option Style is not supported now!\n");
+#endif
+    }
+};
 
-                    tmplogS = tmpprelogS + dlogS;
-                    prelogS[j] = tmplogS;
-                    sumlogS[j] = tmpsumlogS + tmplogS;
+/**
+ * @brief Level path pricer of the multilevel Monte Carlo for the continuously
+ * averaged arithmetic average price option.
+ *
+ * The average is the trapezoidal rule over the time grid of the fine path. When
+ * coarse is set, the coarse path is made of every second point of the same
+ * path, so both are driven by the same Brownian motion, and the pricer sends out
+ * the difference of the fine and the coarse discounted payoffs.
+ *
+ * @tparam DT supported data type including double and float data type.
+ * @tparam SampNum the number of paths per call of Pricing.
+ * @tparam WithAntithetic the antithetic path is priced as well.
+ */
+template <typename DT, int SampNum, bool WithAntithetic>
+class MultiLevelPathPricer<Asian_AP, DT, SampNum, WithAntithetic> {
+   public:
+    const static unsigned int InN = WithAntithetic ? 2 : 1;
+    const static unsigned int OutN = InN;
+    const static bool byPassGen = false;
 
-                    if (i == steps - 1) {
-                        DT sGP = FPExp(sumlogS[j] / (steps + 1)) * underlying;
+    DT strike;
+
+    DT underlying;
 
-                        // printf("GP value = %lf \n", sGP);
+    bool optionType;
 
-                        DT op1, op2, op3, op4;
-                        if (optionType) {
-                            op3 = strike;
-                            op4 = sGP;
-                        } else {
-                            op3 = sGP;
-                            op4 = strike;
-                        }
-                        DT s2 = FPTwoSub(op3, op4);
-                        DT payoff2 = MAX(s2, 0);
-                        DT price2 = FPTwoMul(payoff2, discount);
+    DT discount;
+
+    // level above 0, the fine steps is even
+    bool coarse;
+
+    MultiLevelPathPricer() {}
+
+    DT payoff(DT avg) {
+#pragma HLS inline
+        DT s1 = optionType ? FPTwoSub(strike, avg) : FPTwoSub(avg, strike);
+        return FPTwoMul(MAX(s1, 0), discount);
+    }
 
-                        priceStrmOut.write(price2);
+    void PE(ap_uint<16> steps, ap_uint<16> paths, hls::stream<DT>& pathStrmIn, hls::stream<DT>& priceStrmOut) {
+#pragma HLS inline off
+        DT prelogS[SampNum];
+        // sum of the inner points of the fine and the coarse grid
+        DT sumF[SampNum];
+        DT sumC[SampNum];
+        for (int i = 0; i < steps; ++i) {
+#pragma HLS loop_tripcount min = 8 max = 8
+            for (int j = 0; j < paths; ++j) {
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS pipeline II = 1
+                DT dlogS = pathStrmIn.read();
+                DT tmpprelogS, tmpsumF, tmpsumC;
+                if (i == 0) {
+                    tmpprelogS = 0;
+                    tmpsumF = 0;
+                    tmpsumC = 0;
+                } else {
+                    tmpprelogS = prelogS[j];
+                    tmpsumF = sumF[j];
+                    tmpsumC = sumC[j];
+                }
+                DT logS = FPTwoAdd(tmpprelogS, dlogS);
+                DT s = FPExp(logS);
+                prelogS[j] = logS;
+                sumF[j] = FPTwoAdd(tmpsumF, s);
+                // point i + 1 of the fine grid is on the coarse grid when i is odd
+                sumC[j] = (i & 1) ? FPTwoAdd(tmpsumC, s) : tmpsumC;
+                if (i == steps - 1) {
+                    // trapezoidal rule, the end points are weighted by 1/2
+                    DT ends = FPTwoMul((DT)0.5, FPTwoAdd((DT)1.0, s));
+                    DT avgF = FPTwoAdd(tmpsumF, ends) / steps * underlying;
+                    DT price = payoff(avgF);
+                    if (coarse) {
+                        DT avgC = FPTwoAdd(tmpsumC, ends) / (steps >> 1) * underlying;
+                        price = FPTwoSub(price, payoff(avgC));
                     }
+                    priceStrmOut.write(price);
                 }
             }
         }
@@ -21,8 +21,13 @@
 #ifndef XF_FINTECH_RNG_SEQ_H
 #define XF_FINTECH_RNG_SEQ_H
 #include "ap_int.h"
+#include "hls_math.h"
 #include "hls_stream.h"
+#include "xf_fintech/brownian_bridge.hpp"
 #include "xf_fintech/corrand.hpp"
+#include "xf_fintech/enums.hpp"
+#include "xf_fintech/sobol_rsg.hpp"
+#include "xf_fintech/utils.hpp"
 #ifndef __SYNTHESIS__
 #include <assert.h>
 #endif
@@ -60,6 +65,173 @@ class RNGSequence {
     }
 };
 
+/**
+ * @brief Random sequence with moment matching.
+ *
+ * The normals are produced in blocks of paths numbers. Each block is shifted
+ * and scaled so that its sample mean is exactly 0 and its sample variance is
+ * exactly 1 before it is sent out. Two ping-pong buffers are used so that
+ * generating one block overlaps with matching the previous one, at the cost of
+ * one block of latency.
+ *
+ * @tparam DT supported data type including double and float.
+ * @tparam RNG normal random number generator type.
+ * @tparam SampNum maximum number of paths in one block.
+ */
+template <typename DT, typename RNG, int SampNum>
+class RNGSequenceMomentMatching {
+   public:
+    const static unsigned int OutN = 1;
+    ap_uint<32> seed[1];
+    // Constructor
+    RNGSequenceMomentMatching(){};
+
+    void Init(RNG rngInst[1]) { rngInst[0].seedInitialization(seed[0]); }
+
+    void NextSeq(ap_uint<16> steps, ap_uint<16> paths, RNG rngInst[1], hls::stream<DT> randNumberStrmOut[1]) {
+#pragma HLS inline off
+        // because the latency of accumulation is 14
+        const static int DEP = 16;
+        DT buff[2][SampNum];
+#pragma HLS array_partition variable = buff dim = 1
+        DT sumBuff[DEP];
+        DT squareSumBuff[DEP];
+        DT mean = 0;
+        DT scale = 1;
+    BLOCK_LOOP:
+        for (int b = 0; b <= steps; ++b) {
+#pragma HLS loop_tripcount min = 9 max = 9
+            for (int k = 0; k < DEP; ++k) {
+#pragma HLS pipeline II = 1
+                sumBuff[k] = 0;
+                squareSumBuff[k] = 0;
+            }
+            ap_uint<4> cnt = 0;
+        MATCH_LOOP:
+            for (int i = 0; i < paths; ++i) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = SampNum max = SampNum
+#pragma HLS dependence variable = buff inter false
+                if (b < steps) {
+                    DT d = rngInst[0].next();
+                    buff[b % 2][i] = d;
+                    sumBuff[cnt] = FPTwoAdd(sumBuff[cnt], d);
+                    squareSumBuff[cnt] = FPTwoAdd(squareSumBuff[cnt], FPTwoMul(d, d));
+                    cnt++;
+                }
+                if (b > 0) {
+                    DT d = buff[(b + 1) % 2][i];
+                    DT o = FPTwoMul(FPTwoSub(d, mean), scale);
+                    randNumberStrmOut[0].write(o);
+                }
+            }
+            DT sum = 0;
+            DT squareSum = 0;
+            for (int k = 0; k < DEP; ++k) {
+#pragma HLS pipeline II = 8
+                sum += sumBuff[k];
+                squareSum += squareSumBuff[k];
+            }
+            mean = sum / paths;
+            DT var = FPTwoSub(squareSum / paths, FPTwoMul(mean, mean));
+            scale = (var > 0) ? (DT)(1.0 / hls::sqrt(var)) : (DT)1.0;
+        }
+    }
+};
+
+/**
+ * @brief Randomized quasi-random sequence with Brownian bridge construction.
+ *
+ * For each path, one point of a SobolDim dimensional Sobol sequence is drawn
+ * and randomized by a digital shift, i.e. each dimension is XORed with a
+ * random word drawn from the RNG at initialization. Every unit seeded
+ * differently therefore produces an independent randomization of the same
+ * point set. The uniforms are mapped to normals and fed into a Brownian bridge,
+ * so that the first, best distributed Sobol dimension decides the terminal
+ * value of the path, the second one its mid point and so on. When a path has
+ * more steps than SobolDim, the remaining finest levels of the bridge are
+ * filled with pseudo-random normals from the RNG.
+ *
+ * The output keeps the interface of RNGSequence: steps normals per path, each
+ * with unit variance, in time order.
+ *
+ * @tparam DT supported data type including double and float.
+ * @tparam RNG normal random number generator type, used for the digital shift
+ * and the pseudo-random padding.
+ * @tparam MaxSteps maximum number of time steps, maximum is 1023.
+ * @tparam SobolDim number of Sobol dimensions, maximum is 128.
+ */
+template <typename DT, typename RNG, int MaxSteps = 1023, int SobolDim = 16>
+class RNGSequenceSobolBrownianBridge {
+   public:
+    const static unsigned int OutN = 1;
+    ap_uint<32> seed[1];
+    // Constructor
+    RNGSequenceSobolBrownianBridge(){};
+
+    void Init(RNG rngInst[1]) {
+        rngInst[0].seedInitialization(seed[0]);
+        sobolInst.initialization();
+        for (int i = 0; i < SobolDim; ++i) {
+#pragma HLS pipeline II = 1
+            DT u;
+            rngInst[0].next(u);
+            shift[i] = (ap_uint<32>)(u * (DT)4294967296.0);
+        }
+    }
+
+    void NextSeq(ap_uint<16> steps, ap_uint<16> paths, RNG rngInst[1], hls::stream<DT> randNumberStrmOut[1]) {
+#pragma HLS inline off
+#ifndef __SYNTHESIS__
+        assert(steps <= MaxSteps);
+#endif
+        bridgeInst.initialize(steps);
+        hls::stream<DT> normalStrm;
+#pragma HLS stream variable = normalStrm depth = MaxSteps
+    PATH_LOOP:
+        for (int i = 0; i < paths; ++i) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+            ap_ufixed<32, 0> point[SobolDim];
+            sobolInst.next(point);
+        STEP_LOOP:
+            for (int j = 0; j < steps; ++j) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 8 max = 8
+                DT d;
+                if (j < SobolDim) {
+                    ap_uint<32> x = point[j](31, 0) ^ shift[j];
+                    // mid point of the cell to keep the uniform inside (0, 1)
+                    DT u = ((DT)x + (DT)0.5) / (DT)4294967296.0;
+                    d = inverseCumulativeNormalAcklam<DT>(u);
+                } else {
+                    d = rngInst[0].next();
+                }
+                normalStrm.write(d);
+            }
+            bridgeInst.transform(normalStrm, randNumberStrmOut[0]);
+        }
+    }
+
+   private:
+    SobolRsg<SobolDim> sobolInst;
+    BrownianBridge<DT, MaxSteps> bridgeInst;
+    ap_uint<32> shift[SobolDim];
+};
+
+/**
+ * @brief Selects the single variate random sequence of a RNGType, the pseudo
+ * random RNGSequence or the quasi-random RNGSequenceSobolBrownianBridge.
+ */
+template <RNGType RT, typename DT, typename RNG>
+struct RNGSequenceSelector {
+    typedef RNGSequence<DT, RNG> Type;
+};
+
+template <typename DT, typename RNG>
+struct RNGSequenceSelector<LowDiscrepancy, DT, RNG> {
+    typedef RNGSequenceSobolBrownianBridge<DT, RNG> Type;
+};
+
 template <typename DT, typename RNG>
 class RNGSequence_2 {
    public:
@@ -191,6 +191,40 @@ class TimeGrid {
         floatingEndCnt = floating_reset_cnt_tmp - 1;
     }
 
+    // as above, but returns the timepoint counter of every time in init_time in steps, so that the counts of
+    // several instruments sharing the grid can be mapped onto it. The union of the timepoints of several instruments
+    // may have points closer than dtMax / 2, such a point is merged into the previous timepoint of the grid rather
+    // than given a step much shorter than the others, which would widen the tree beyond its node count.
+    void calcuGrid(int size, DT* init_time, DT dtMax, DT* time, DT* dtime, int* steps, int& endCnt) {
+#pragma HLS inline
+        time[0] = 0.0;
+        int i;
+        int j;
+        steps[0] = 0;
+        endCnt = 0;
+    loop_timegrid_1:
+        for (i = 0; i < size - 1; i++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+            // from the grid timepoint of init_time[i], which is earlier if init_time[i] was merged
+            DT tmp_dt = init_time[i + 1] - time[steps[i]];
+            int step = hls::round(tmp_dt / dtMax);
+            if (step > 0) {
+                DT dt = tmp_dt / step;
+                dtime[steps[i]] = dt;
+            loop_timegrid_2:
+                for (j = 1; j < step; j++) {
+#pragma HLS pipeline
+#pragma HLS loop_tripcount min = 5 max = 5
+                    time[steps[i] + j] = time[steps[i]] + dt * j;
+                    dtime[steps[i] + j] = dt;
+                }
+                time[steps[i] + j] = init_time[i + 1];
+            }
+            steps[i + 1] = steps[i] + step;
+            endCnt = steps[i + 1];
+        }
+    }
+
 }; // class
 
 }; // internal
@@ -611,7 +611,7 @@ class TreeInstrument<DT, 2, LEN2> { // capfloor
         type = typeIn;
         lastTime = lastTimeIn;
         nominal = nominalIn;
-        cfRateIn = cfRateIn;
+        cfRate = cfRateIn;
 
         floating_cnt = floatingEndCnt;
 
@@ -0,0 +1,343 @@
+#!/usr/bin/env python3
+#
+# Copyright 2019 Xilinx, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+"""Runs the L2 engine tests as one benchmark suite.
+
+Every engine of suite.json is run from its directory under L2/tests, either
+in C simulation through its hls/run_hls.tcl or with 'make run' for the
+sw_emu, hw_emu and hw targets. The log of each run is parsed for the kernel
+time and for the results and reference values it prints, and one JSON
+record per engine is written with options/sec, paths/sec, accuracy and the
+split between host and kernel time.
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+SUITE_DIR = os.path.dirname(os.path.abspath(__file__))
+L2_DIR = os.path.abspath(os.path.join(SUITE_DIR, "..", ".."))
+PROJ_ROOT = os.path.abspath(os.path.join(L2_DIR, ".."))
+TESTS_DIR = os.path.join(L2_DIR, "tests")
+
+MODES = ["csim", "sw_emu", "hw_emu", "hw"]
+
+NUM = r"[-+]?(?:\d+\.?\d*|\.\d+)(?:[eE][-+]?\d+)?"
+
+# Kernel time as printed by the test hosts, the 'time' group is in 'unit'
+TIME_FORMATS = {
+    "execution_time": (r"Execution time\s+(?P<time>" + NUM + r")\s*(?P<unit>us|ms|s)?\b", "us"),
+    "fpga_execution_time": (r"FPGA execution time:\s*(?P<time>" + NUM + r")\s*(?P<unit>us|ms|s)?\b", "s"),
+    "fpga_profile_time": (r"FPGA time returned by profile API\s*=\s*(?P<time>" + NUM + r")\s*(?P<unit>us|ms|s)?\b",
+                          "ms"),
+    "binomial_duration": (r"\(FPGA\).*?Duration:(?P<time>" + NUM + r")(?P<unit>us|ms|s)?", "us"),
+    "profile_duration": (r"Duration returned by profile API is\s*(?P<time>" + NUM + r")\s*(?P<unit>us|ms|s)?\b", "ms"),
+}
+
+# Results printed by the test hosts. Named groups: 'value' and 'expected' for a
+# result and its reference, 'abs_err' or 'rel_err' for an error the host
+# computed, 'fails' for a count of failed checks.
+RESULT_FORMATS = {
+    "actual_expected": r"Acutal value:\s*(?P<value>" + NUM + r"),\s*Expected value:\s*(?P<expected>" + NUM + r")",
+    "output_golden": r"output\[\d+\]\s*=\s*(?P<value>" + NUM + r"),\s*golden\[\d+\]\s*=\s*(?P<expected>" + NUM + r")",
+    "expected_fpga_result": r"Expected value:\s*(?P<expected>" + NUM + r")\s*\n\s*FPGA result:\s*(?P<value>" + NUM +
+    r")",
+    "npv_rel_diff": r"NPV(?:\[\d+\])?\s*=\s*(?P<value>" + NUM + r")\s*,\s*diff/NPV\s*=\s*(?P<rel_err>" + NUM + r")",
+    "npv_diff": r"NPV\s*=\s*(?P<value>" + NUM + r")\s*,\s*diff\s*=\s*(?P<abs_err>" + NUM + r")",
+    "host_kernel_diff": r"Largest host-kernel (?:price|volatility) difference\s*=\s*(?P<abs_err>" + NUM + r")",
+    "fpga_cpu": r"FPGA Call price\s*=\s*(?P<value>" + NUM + r")\s*\(CPU = (?P<expected>" + NUM + r")\)",
+    "difference_list": r"^\s+\d+:\s*(?P<abs_err>" + NUM + r")\s*$",
+    "maximum_difference": r"Maximum difference is\s*(?P<abs_err>" + NUM + r")",
+    "rms_max": r"\(FPGA\) RMS:\s*" + NUM + r"\s*Max:\s*(?P<abs_err>" + NUM + r")",
+    "total_fails": r"Total fails\s*=\s*(?P<fails>\d+)",
+    "out_price": r"out_price\s*=\s*(?P<value>" + NUM + r")",
+    "forward_value": r"forward:\s*(?P<expected>" + NUM + r")\s*\n\s*--\s*\n\s*option value:\s*(?P<value>" + NUM + r")",
+    "sample_mean_err": r"Max error of the sample mean\s*(?P<abs_err>" + NUM + r")",
+    "sample_cov_err": r"of the sample covariance\s*(?P<abs_err>" + NUM + r")",
+}
+
+UNIT_TO_US = {"us": 1.0, "ms": 1.0e3, "s": 1.0e6}
+
+
+def per_mode(value, mode):
+    """Manifest values may be given once or per mode."""
+    if isinstance(value, dict):
+        return value.get(mode, value.get("default"))
+    return value
+
+
+def parse_kernel_time(log, engine):
+    """Sums the kernel times printed in the log, in microseconds."""
+    fmt = engine.get("time", "execution_time")
+    if fmt is None:
+        return None
+    pattern, default_unit = TIME_FORMATS[fmt] if fmt in TIME_FORMATS else (fmt, "us")
+    default_unit = engine.get("time_unit", default_unit)
+    total = None
+    for m in re.finditer(pattern, log, re.MULTILINE):
+        unit = m.groupdict().get("unit") or default_unit
+        # some hosts label a millisecond value as us, the manifest unit then wins
+        if "time_unit" in engine:
+            unit = engine["time_unit"]
+        total = (total or 0.0) + float(m.group("time")) * UNIT_TO_US[unit]
+    return total
+
+
+def parse_profile_summary(run_dir):
+    """Total kernel time in microseconds from an XRT profile_summary.csv."""
+    path = os.path.join(run_dir, "profile_summary.csv")
+    if not os.path.isfile(path):
+        return None
+    total = None
+    with open(path) as f:
+        rows = list(csv.reader(f))
+    for i, row in enumerate(rows):
+        if row and row[0].strip() == "Kernel Execution" and i + 1 < len(rows):
+            header = [h.strip() for h in rows[i + 1]]
+            if "Total Time (ms)" not in header:
+                continue
+            col = header.index("Total Time (ms)")
+            for r in rows[i + 2:]:
+                if not r or not r[0].strip():
+                    break
+                try:
+                    total = (total or 0.0) + float(r[col]) * 1.0e3
+                except (ValueError, IndexError):
+                    break
+            break
+    return total
+
+
+def parse_results(log, engine):
+    """Returns the list of results, absolute and relative errors and fail count."""
+    values = []
+    abs_errs = []
+    rel_errs = []
+    fails = None
+    references = engine.get("reference")
+    formats = engine.get("results", [])
+    if isinstance(formats, str):
+        formats = [formats]
+    for fmt in formats:
+        pattern = RESULT_FORMATS.get(fmt, fmt)
+        for m in re.finditer(pattern, log, re.MULTILINE):
+            g = m.groupdict()
+            if g.get("fails") is not None:
+                fails = (fails or 0) + int(g["fails"])
+                continue
+            if g.get("value") is not None:
+                value = float(g["value"])
+                values.append(value)
+                expected = g.get("expected")
+                if expected is None and references is not None and len(values) <= len(references):
+                    expected = references[len(values) - 1]
+                if expected is not None:
+                    expected = float(expected)
+                    abs_errs.append(abs(value - expected))
+                    if expected != 0.0:
+                        rel_errs.append(abs(value - expected) / abs(expected))
+            if g.get("abs_err") is not None:
+                abs_errs.append(abs(float(g["abs_err"])))
+            if g.get("rel_err") is not None:
+                rel_errs.append(abs(float(g["rel_err"])))
+    return values, abs_errs, rel_errs, fails
+
+
+def write_settings_tcl(hls_dir, part):
+    """run_hls.tcl sources settings.tcl; returns True if one was written."""
+    path = os.path.join(hls_dir, "settings.tcl")
+    if os.path.isfile(path):
+        return False
+    with open(path, "w") as f:
+        f.write("set XPART %s\nset CSIM 1\nset CSYNTH 0\nset COSIM 0\n" % part)
+        f.write("set VIVADO_SYN 0\nset VIVADO_IMPL 0\nset QOR_CHECK 0\n")
+    return True
+
+
+def run_command(cmd, cwd, env, log_path, timeout):
+    start = time.time()
+    with open(log_path, "w") as log_file:
+        try:
+            proc = subprocess.run(cmd, cwd=cwd, env=env, stdout=log_file, stderr=subprocess.STDOUT,
+                                  timeout=timeout)
+            code = proc.returncode
+        except subprocess.TimeoutExpired:
+            code = "timeout"
+        except OSError as e:
+            log_file.write("ERROR: %s\n" % e)
+            code = "error"
+    return code, time.time() - start
+
+
+def run_engine(engine, args, env, log_dir):
+    name = engine["name"]
+    test_dir = os.path.join(TESTS_DIR, engine.get("test", name))
+    record = {"engine": name, "mode": args.mode, "device": args.device if args.mode != "csim" else args.part}
+
+    csim = engine.get("csim", "hls")
+    if args.mode == "csim":
+        if not csim:
+            record["status"] = "skipped"
+            return record
+        run_dir = os.path.join(test_dir, csim)
+        if not os.path.isfile(os.path.join(run_dir, "run_hls.tcl")):
+            record["status"] = "skipped"
+            return record
+        cmd = [args.vivado_hls, "-f", "run_hls.tcl"]
+    else:
+        if not engine.get("make", True) or not os.path.isfile(os.path.join(test_dir, "Makefile")):
+            record["status"] = "skipped"
+            return record
+        run_dir = test_dir
+        make_vars = ["TARGET=" + args.mode, "DEVICE=" + args.device]
+        for k, v in sorted(engine.get("make_vars", {}).items()):
+            make_vars.append("%s=%s" % (k, v))
+        if not args.no_build:
+            # build outside the timed run
+            code, _ = run_command(["make", "host", "xclbin"] + make_vars, run_dir, env,
+                                  os.path.join(log_dir, name + "_" + args.mode + "_build.log"), args.timeout)
+            if code != 0:
+                record["status"] = "build_failed"
+                record["exit_code"] = code
+                return record
+        cmd = ["make", "run"] + make_vars
+        # XRT writes profile_summary.csv next to the run when profiling is on
+        if os.path.isfile(os.path.join(run_dir, "profile_summary.csv")):
+            os.remove(os.path.join(run_dir, "profile_summary.csv"))
+        wrote_ini = not os.path.isfile(os.path.join(run_dir, "xrt.ini"))
+        if wrote_ini:
+            with open(os.path.join(run_dir, "xrt.ini"), "w") as f:
+                f.write("[Debug]\nprofile=true\n")
+
+    env = dict(env)
+    env["PWD"] = run_dir
+    log_path = os.path.join(log_dir, name + "_" + args.mode + ".log")
+    wrote_settings = args.mode == "csim" and write_settings_tcl(run_dir, args.part)
+    code, wall = run_command(cmd, run_dir, env, log_path, args.timeout)
+    if wrote_settings:
+        os.remove(os.path.join(run_dir, "settings.tcl"))
+    if args.mode != "csim" and wrote_ini:
+        os.remove(os.path.join(run_dir, "xrt.ini"))
+
+    with open(log_path, errors="replace") as f:
+        log = f.read()
+
+    kernel_us = None
+    timing = "wall"
+    if args.mode != "csim":
+        kernel_us = parse_profile_summary(run_dir)
+        if kernel_us is not None:
+            timing = "profile"
+    if kernel_us is None:
+        kernel_us = parse_kernel_time(log, engine)
+        if kernel_us is not None:
+            timing = "host_timer"
+    if args.mode == "csim":
+        # C simulation has no kernel time, the host timers measure the C model
+        timing = "csim"
+
+    values, abs_errs, rel_errs, fails = parse_results(log, engine)
+
+    options = per_mode(engine.get("options", "results"), args.mode)
+    if options == "results":
+        options = len(values) if values else None
+    paths = per_mode(engine.get("paths"), args.mode)
+
+    time_s = (kernel_us / 1.0e6) if kernel_us else wall
+    record.update({
+        "status": "pass" if code == 0 and not fails else "fail",
+        "exit_code": code,
+        "timing": timing,
+        "wall_time_s": round(wall, 6),
+        "kernel_time_us": kernel_us,
+        "host_time_s": round(wall - kernel_us / 1.0e6, 6) if kernel_us is not None else None,
+        "options": options,
+        "paths_per_option": paths,
+        "options_per_sec": (options / time_s) if options and time_s > 0 else None,
+        "paths_per_sec": (options * paths / time_s) if options and paths and time_s > 0 else None,
+        "results": len(values),
+        "max_abs_err": max(abs_errs) if abs_errs else None,
+        "max_rel_err": max(rel_errs) if rel_errs else None,
+        "failed_checks": fails,
+        "log": log_path,
+    })
+    return record
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--mode", choices=MODES, default="csim", help="csim, sw_emu, hw_emu or hw")
+    parser.add_argument("--device", default="xilinx_u250_xdma_201830_2", help="platform for make runs")
+    parser.add_argument("--part", default="xcu250-figd2104-2L-e", help="part for C simulation")
+    parser.add_argument("--suite", default=os.path.join(SUITE_DIR, "suite.json"), help="engine list")
+    parser.add_argument("--engines", nargs="*", help="run only these engines")
+    parser.add_argument("--output", default="results.json", help="JSON records, one line per engine")
+    parser.add_argument("--csv", help="also write the records as CSV")
+    parser.add_argument("--logs", default="logs", help="directory for the run logs")
+    parser.add_argument("--timeout", type=int, default=4 * 3600, help="seconds per run")
+    parser.add_argument("--no-build", action="store_true", help="make runs reuse existing host and xclbin")
+    parser.add_argument("--vivado-hls", dest="vivado_hls", default="vivado_hls", help="HLS executable")
+    parser.add_argument("--list", action="store_true", help="list the engines and exit")
+    args = parser.parse_args()
+
+    with open(args.suite) as f:
+        suite = json.load(f)
+    engines = suite["engines"]
+    if args.engines:
+        engines = [e for e in engines if e["name"] in args.engines]
+    if args.list:
+        for e in engines:
+            print(e["name"])
+        return 0
+
+    log_dir = os.path.abspath(args.logs)
+    if not os.path.isdir(log_dir):
+        os.makedirs(log_dir)
+    env = dict(os.environ)
+    env["XF_PROJ_ROOT"] = PROJ_ROOT
+
+    records = []
+    with open(args.output, "w") as out:
+        for engine in engines:
+            print("[%s] %s ..." % (args.mode, engine["name"]))
+            sys.stdout.flush()
+            record = run_engine(engine, args, env, log_dir)
+            records.append(record)
+            out.write(json.dumps(record, sort_keys=True) + "\n")
+            out.flush()
+            print("    %s" % record["status"])
+
+    if args.csv:
+        keys = sorted(set(k for r in records for k in r))
+        with open(args.csv, "w") as f:
+            writer = csv.DictWriter(f, fieldnames=keys)
+            writer.writeheader()
+            for r in records:
+                writer.writerow(r)
+
+    failed = [r["engine"] for r in records if r["status"] not in ("pass", "skipped")]
+    print("%d engines, %d failed %s" % (len(records), len(failed), " ".join(failed)))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -161,6 +161,72 @@ void cfBSMEngine(DT s,
     *gamma = gamma_temp;
     *vega = vega_temp;
 }
+
+/// @brief Single option implied volatility
+///
+/// Inverts cfBSMEngine for the volatility which reproduces the given option
+/// premium.  The initial guess is the Corrado-Miller rational approximation,
+/// which is then refined by a fixed number of Halley steps using the price
+/// and vega returned by cfBSMEngine.  The iteration count is a compile time
+/// constant so that the whole solver can be unrolled and pipelined with II=1
+/// when it is called from a loop over many quotes.
+///
+/// @tparam DT     Data Type used for this function
+/// @tparam N_ITER Number of Halley iterations, default 4
+/// @param[in]  s     underlying
+/// @param[in]  p     call/put premium observed in the market
+/// @param[in]  r     risk-free rate (decimal form)
+/// @param[in]  t     time to maturity
+/// @param[in]  k     strike price
+/// @param[in]  q     continuous dividend yield rate
+/// @param[in]  call  control whether the premium is a call or a put
+/// @param[out] iv    implied volatility (decimal form), clamped to [IV_MIN, IV_MAX]
+template <typename DT, int N_ITER = 4>
+void cfBSMImpliedVolatilityEngine(DT s, DT p, DT r, DT t, DT k, DT q, unsigned int call, DT* iv) {
+    const DT IV_MIN = 0.0001f;
+    const DT IV_MAX = 5.0f;
+    const DT VEGA_MIN = 1e-8f;
+
+    DT sqrt_t = hls::sqrtf(t);
+    DT fwd_s = s * hls::expf(-q * t);
+    DT disc_k = k * hls::expf(-r * t);
+
+    // Corrado-Miller works on call premia, puts are mapped by put-call parity
+    DT c = call ? p : (DT)(p + fwd_s - disc_k);
+    DT half_diff = 0.5f * (fwd_s - disc_k);
+    DT c_adj = c - half_diff;
+    DT disc = c_adj * c_adj - (fwd_s - disc_k) * (fwd_s - disc_k) * (1.0f / PI);
+    disc = (disc > 0.0f) ? disc : (DT)0.0f;
+    DT sigma = SQRT_2PI / (fwd_s + disc_k) * (c_adj + hls::sqrtf(disc)) / sqrt_t;
+    sigma = (sigma > IV_MIN) ? sigma : IV_MIN;
+    sigma = (sigma < IV_MAX) ? sigma : IV_MAX;
+
+halley_loop:
+    for (int i = 0; i < N_ITER; ++i) {
+#pragma HLS UNROLL
+        DT price, delta, gamma, vega, theta, rho;
+        cfBSMEngine<DT>(s, sigma, r, t, k, q, call, &price, &delta, &gamma, &vega, &theta, &rho);
+
+        // cfBSMEngine reports vega per percentage point
+        DT dp_dsigma = vega * (1.0f / PERCENTAGE_SCALE);
+        DT v_sqrt_t = sigma * sqrt_t;
+        DT d1 = (hls::logf(s / k) + (r - q + 0.5f * sigma * sigma) * t) / v_sqrt_t;
+        DT d2 = d1 - v_sqrt_t;
+        DT d2p_dsigma2 = dp_dsigma * d1 * d2 / sigma;
+
+        DT diff = price - p;
+        DT newton = diff / dp_dsigma;
+        DT denom = 1.0f - 0.5f * newton * d2p_dsigma2 / dp_dsigma;
+        // fall back to the Newton step when the Halley correction is unstable
+        DT step = (denom > 0.5f) ? (DT)(newton / denom) : newton;
+        DT next = sigma - step;
+        next = (next > IV_MIN) ? next : (DT)(0.5f * sigma);
+        next = (next < IV_MAX) ? next : IV_MAX;
+        sigma = (dp_dsigma > VEGA_MIN) ? next : sigma;
+    }
+
+    *iv = sigma;
+}
 }
 } // xf::fintech
 
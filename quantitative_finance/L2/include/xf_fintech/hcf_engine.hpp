@@ -193,6 +193,56 @@ pi2_loop:
     }
     return sum;
 }
+
+/// @brief integration function pi 1 and pi 2 for a strip of strikes
+/// @param[in] in A structure containing the kerenl model parameters, K is ignored
+/// @param[in] strikes the strike prices
+/// @param[in] num_strikes the number of strikes
+/// @param[out] sum1 the pi 1 integral of each strike
+/// @param[out] sum2 the pi 2 integral of each strike
+template <typename DT, int MAX_STRIKES>
+void integrateStrip(struct hcfEngineInputDataType<DT>* in, DT* strikes, int num_strikes, DT* sum1, DT* sum2) {
+#pragma HLS INLINE OFF
+    DT log_k[MAX_STRIKES];
+    DT f1_n[MAX_STRIKES];
+    DT f2_n[MAX_STRIKES];
+    DT max = in->w_max / in->dw;
+    int n;
+
+    // charFunc(-i) is the same for every node and strike
+    struct complex_num<DT> cf2 = charFunc(in, cn_init((DT)0, (DT)-1));
+
+strip_node_loop:
+    for (n = 0; n <= (int)max; n++) {
+#pragma HLS LOOP_TRIPCOUNT min = 401 max = 401 avg = 401
+        DT w = (n == 0) ? (DT)1e-10 : n * in->dw;
+
+        // the strike independent factors of the two integrands
+        struct complex_num<DT> tmp = cn_scalar_mul(cn_init((DT)0, (DT)1), w);
+        struct complex_num<DT> a1 = cn_div(charFunc(in, cn_init(w, (DT)-1)), cn_mul(tmp, cf2));
+        struct complex_num<DT> a2 = cn_div(charFunc(in, cn_init(w, (DT)0)), tmp);
+
+    strip_strike_loop:
+        for (int k = 0; k < num_strikes; k++) {
+#pragma HLS LOOP_TRIPCOUNT min = 512 max = 512 avg = 512
+#pragma HLS PIPELINE
+            if (n == 0) {
+                log_k[k] = LOG(strikes[k]);
+            }
+            DT f1 = cn_real(cn_mul(cn_exp(cn_scalar_mul(tmp, -log_k[k])), a1));
+            DT f2 = cn_real(cn_mul(cn_exp(cn_scalar_mul(cn_init((DT)0, (DT)-1), w * log_k[k])), a2));
+            if (n == 0) {
+                sum1[k] = 0;
+                sum2[k] = 0;
+            } else {
+                sum1[k] += in->dw * (f1 + f1_n[k]) / 2;
+                sum2[k] += in->dw * (f2 + f2_n[k]) / 2;
+            }
+            f1_n[k] = f1;
+            f2_n[k] = f2;
+        }
+    }
+}
 } // internal
 
 #define PI (3.14159265359f)
@@ -206,6 +256,36 @@ DT hcfEngine(struct hcfEngineInputDataType<DT>* input_data) {
     return (input_data->s0 * pi1) - (internal::EXP(-(input_data->r * input_data->T)) * input_data->K * pi2);
 }
 
+/// @brief Engine for Hestion Closed Form Solution over a strip of strikes
+///
+/// The characteristic function does not depend on the strike, so it is
+/// evaluated once per integration node and shared by all the strikes, which
+/// only add the strike dependent phase term. The integration is the same as
+/// hcfEngine, so each call value matches hcfEngine for that strike.
+///
+/// @tparam DT supported data type including double and float data type
+/// @tparam MAX_STRIKES the maximum number of strikes of a strip
+/// @param[in] input_data A structure containing the kerenl model parameters, K is ignored
+/// @param[in] strikes the strike prices
+/// @param[in] num_strikes the number of strikes, up to MAX_STRIKES
+/// @param[out] call_values the calculated call values, one per strike
+template <typename DT, int MAX_STRIKES>
+void hcfEngineStrip(struct hcfEngineInputDataType<DT>* input_data, DT* strikes, int num_strikes, DT* call_values) {
+    DT sum1[MAX_STRIKES];
+    DT sum2[MAX_STRIKES];
+
+    internal::integrateStrip<DT, MAX_STRIKES>(input_data, strikes, num_strikes, sum1, sum2);
+
+strip_price_loop:
+    for (int k = 0; k < num_strikes; k++) {
+#pragma HLS LOOP_TRIPCOUNT min = 512 max = 512 avg = 512
+#pragma HLS PIPELINE
+        DT pi1 = 0.5 + ((1 / PI) * sum1[k]);
+        DT pi2 = 0.5 + ((1 / PI) * sum2[k]);
+        call_values[k] = (input_data->s0 * pi1) - (internal::EXP(-(input_data->r * input_data->T)) * strikes[k] * pi2);
+    }
+}
+
 #undef PI
 
 } // namespace fintech
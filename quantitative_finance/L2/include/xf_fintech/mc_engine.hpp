@@ -41,6 +41,15 @@ using namespace internal;
  * latency and resources utilization, default 10.
  * @tparam Antithetic anthithetic is used  for variance reduction, default this
  * feature is disabled.
+ * @tparam ControlVariate the discounted terminal asset price is used as control
+ * variate with the Black-Scholes delta as coefficient, default this feature is
+ * disabled.
+ * @tparam MomentMatching each block of normal random numbers is matched to zero
+ * mean and unit variance before path generation, default this feature is
+ * disabled. Moment matching is not applied to a LowDiscrepancy sequence.
+ * @tparam RngType random sequence of the paths. PseudoRandom uses MT19937
+ * normals, LowDiscrepancy uses digitally shifted Sobol points with Brownian
+ * bridge construction, default PseudoRandom.
  * @param underlying intial value of underlying asset at time 0.
  * @param volatility fixed volatility of underlying asset.
  * @param dividendYield the constant dividend rate for continuous dividends.
@@ -61,7 +70,12 @@ using namespace internal;
  * @param maxSamples the maximum sample number. When reaching it, the simulation
  * will stop, default 2,147,483,648.
  */
-template <typename DT = double, int UN = 10, bool Antithetic = false>
+template <typename DT = double,
+          int UN = 10,
+          bool Antithetic = false,
+          bool ControlVariate = false,
+          bool MomentMatching = false,
+          RNGType RngType = PseudoRandom>
 void MCEuropeanEngine(DT underlying,
                       DT volatility,
                       DT dividendYield,
@@ -85,7 +99,7 @@ void MCEuropeanEngine(DT underlying,
     const static bool SF = true;
 
     // option style
-    const OptionStyle sty = European;
+    const OptionStyle sty = ControlVariate ? EuropeanControlVariate : European;
 
     // antithetic enable or not
     // const static bool Antithetic = false;
@@ -103,10 +117,6 @@ void MCEuropeanEngine(DT underlying,
     PathPricer<sty, DT, SF, SN, Antithetic> pathPriInst[UN][1];
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
-    // RNG sequence instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
-#pragma HLS array_partition variable = rngSeqInst dim = 1
-
     // pre-process for "cold" logic.
     DT dt = timeLength / timeSteps;
     DT f_1 = internal::FPTwoMul(riskFreeRate, timeLength);
@@ -120,6 +130,17 @@ void MCEuropeanEngine(DT underlying,
     BSInst.stdDeviation();
     BSInst.updateDrift(dt);
 
+    // control variate coefficient: the Black-Scholes delta of the option
+    // divided by the delta of the discounted terminal price exp(-q * T).
+    DT sqrtT = hls::sqrt(timeLength);
+    DT volSqrtT = internal::FPTwoMul(volatility, sqrtT);
+    DT halfVar = internal::FPTwoMul((DT)0.5, internal::FPTwoMul(volatility, volatility));
+    DT mu = internal::FPTwoAdd(internal::FPTwoSub(riskFreeRate, dividendYield), halfVar);
+    DT d1 = internal::FPTwoAdd(hls::log(underlying / strike), internal::FPTwoMul(mu, timeLength)) / volSqrtT;
+    DT cumD1 = CumulativeNormal<DT>(d1);
+    DT cvBeta = optionType ? internal::FPTwoSub(cumD1, (DT)1.0) : cumD1;
+    DT cvMean = internal::FPTwoMul(underlying, internal::FPExp(-internal::FPTwoMul(dividendYield, timeLength)));
+
     // configure the path generator and path pricer
     for (int i = 0; i < UN; ++i) {
 #pragma HLS unroll
@@ -128,20 +149,325 @@ void MCEuropeanEngine(DT underlying,
         pathPriInst[i][0].strike = strike;
         pathPriInst[i][0].underlying = underlying;
         pathPriInst[i][0].discount = discount;
+        internal::setControlVariate(pathPriInst[i][0], cvBeta, cvMean);
         // Path pricer
         pathGenInst[i][0].BSInst = BSInst;
-        // RNGSequnce
-        rngSeqInst[i][0].seed[0] = seed[i];
     }
 
     // call monter carlo simulation
-    DT price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
-                            RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
-                                                              pathGenInst, pathPriInst, rngSeqInst);
+    DT price;
+    if (MomentMatching && RngType == PseudoRandom) {
+        RNGSequenceMomentMatching<DT, RNG, SN> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+        for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+            rngSeqInst[i][0].seed[0] = seed[i];
+        }
+        price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
+                             RNGSequenceMomentMatching<DT, RNG, SN>, UN, VN, SN>(
+            timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst, pathPriInst, rngSeqInst);
+    } else {
+        typedef typename RNGSequenceSelector<RngType, DT, RNG>::Type RNGSeqT;
+        RNGSeqT rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+        for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+            rngSeqInst[i][0].seed[0] = seed[i];
+        }
+        price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
+                             RNGSeqT, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                  pathGenInst, pathPriInst, rngSeqInst);
+    }
 
     // output the price of option
     output[0] = price;
 }
+/**
+ * @brief European Option Greeks Calculating Engine using Monte Carlo Method
+ * based on Black-Scholes valuation model. The price and the sensitivities are
+ * estimated from the same paths in one simulation pass: delta, vega and rho by
+ * pathwise derivatives, gamma by the likelihood ratio method applied to the
+ * pathwise delta, and theta through the Black-Scholes equation.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 10.
+ * @tparam Antithetic anthithetic is used  for variance reduction, default this
+ * feature is disabled.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param timeLength the time length of constract from start to end.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param output output array of price, delta, gamma, vega, theta and rho.
+ * Vega and rho are per unit change of volatility and rate, theta is per year.
+ * @param requiredTolerance the tolerance required on the price. If
+ * requiredSamples is not set, when reaching the required tolearance, simulation
+ * will stop, default 0.02.
+ * @param requiredSamples the samples number required. When reaching the
+ * required number, simulation will stop, default 1024.
+ * @param maxSamples the maximum sample number. When reaching it, the simulation
+ * will stop, default 2,147,483,648.
+ */
+template <typename DT = double, int UN = 10, bool Antithetic = false>
+void MCEuropeanGreeksEngine(DT underlying,
+                            DT volatility,
+                            DT dividendYield,
+                            DT riskFreeRate, // model parameter
+                            DT timeLength,
+                            DT strike,
+                            bool optionType, // option parameter
+                            ap_uint<32>* seed,
+                            DT* output,
+                            DT requiredTolerance = 0.02,
+                            unsigned int requiredSamples = 1024,
+                            unsigned int maxSamples = MAX_SAMPLE) {
+    // number of samples per simulation
+    const static int SN = 1024;
+
+    // number of variate
+    const static int VN = 1;
+
+    // Step first or sample first for each simulation
+    const static bool SF = true;
+
+    // option style
+    const static OptionStyle sty = EuropeanGreeks;
+
+    // number of estimators per path: price, delta, gamma, vega, rho
+    const static int GN = PathPricer<sty, DT, SF, SN, Antithetic>::OutN;
+
+    // RNG alias name
+    typedef MT19937IcnRng<DT> RNG;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    PathPricer<sty, DT, SF, SN, Antithetic> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // pre-process for "cold" logic, the terminal price is simulated in one step
+    DT f_1 = internal::FPTwoMul(riskFreeRate, timeLength);
+    DT discount = internal::FPExp(-f_1);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(timeLength);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(timeLength);
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path pricer
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].discount = discount;
+        pathPriInst[i][0].volatility = volatility;
+        pathPriInst[i][0].timeLength = timeLength;
+        pathPriInst[i][0].logDrift = BSInst.drift;
+        // Path generator
+        pathGenInst[i][0].BSInst = BSInst;
+        // RNGSequnce
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+
+    // call monter carlo simulation
+    DT estimates[GN];
+#pragma HLS array_partition variable = estimates dim = 0
+    mcSimulationMulti<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
+                      RNGSequence<DT, RNG>, UN, VN, SN>(1, maxSamples, requiredSamples, requiredTolerance, pathGenInst,
+                                                        pathPriInst, rngSeqInst, estimates);
+
+    // theta from the Black-Scholes equation,
+    // theta = r * V - (r - q) * S * delta - 0.5 * sigma^2 * S^2 * gamma
+    DT price = estimates[0];
+    DT delta = estimates[1];
+    DT gamma = estimates[2];
+    DT carry = internal::FPTwoSub(riskFreeRate, dividendYield);
+    DT halfVarS2 = internal::FPTwoMul(internal::FPTwoMul((DT)0.5, BSInst.var / timeLength),
+                                      internal::FPTwoMul(underlying, underlying));
+    DT theta = internal::FPTwoSub(internal::FPTwoMul(riskFreeRate, price),
+                                  internal::FPTwoAdd(internal::FPTwoMul(internal::FPTwoMul(carry, underlying), delta),
+                                                     internal::FPTwoMul(halfVarS2, gamma)));
+
+    // output the price and greeks of option
+    output[0] = price;
+    output[1] = delta;
+    output[2] = gamma;
+    output[3] = estimates[3];
+    output[4] = theta;
+    output[5] = estimates[4];
+}
+/**
+ * @brief Batch European Option Pricing Engine using Monte Carlo Method. A batch
+ * of options with different strikes, maturities and types on the same
+ * underlying is priced from one set of simulated paths, so a whole strike /
+ * maturity surface costs one simulation. This implementation uses
+ * Black-Scholes valuation model.
+ *
+ * The paths are simulated on a uniform time grid of timeSteps steps up to the
+ * longest maturity of the batch. Each option is evaluated from the grid point
+ * nearest to its maturity, whose log-price is rescaled to the variance and
+ * drift of the true maturity, so that maturities off the grid are priced
+ * without bias too. Only the correlation between options of different
+ * maturities depends on the grid.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization, default 2.
+ * @tparam MaxOptions the maximum number of options in one batch, a multiple of
+ * 16, default 1024.
+ * @tparam MaxSteps the maximum number of time steps, default 64.
+ * @tparam Antithetic anthithetic is used  for variance reduction, default this
+ * feature is disabled.
+ * @param underlying intial value of underlying asset at time 0.
+ * @param volatility fixed volatility of underlying asset.
+ * @param dividendYield the constant dividend rate for continuous dividends.
+ * @param riskFreeRate risk-free interest rate.
+ * @param optNum the number of options in the batch, at least 1.
+ * @param strike the strike price of each option.
+ * @param timeLength the time to maturity of each option.
+ * @param optionType option type of each option. 1: put option, 0: call option.
+ * @param seed array to store the inital seed for each RNG.
+ * @param output the price of each option.
+ * @param requiredSamples the samples number required, default 1024.
+ * @param timeSteps the number of discrete steps from 0 to the longest maturity,
+ * in range [1, MaxSteps], default 1.
+ */
+template <typename DT = double, int UN = 2, int MaxOptions = 1024, int MaxSteps = 64, bool Antithetic = false>
+void MCEuropeanBatchEngine(DT underlying,
+                           DT volatility,
+                           DT dividendYield,
+                           DT riskFreeRate, // model parameter
+                           unsigned int optNum,
+                           DT* strike,
+                           DT* timeLength,
+                           bool* optionType, // option parameter
+                           ap_uint<32>* seed,
+                           DT* output,
+                           unsigned int requiredSamples = 1024,
+                           unsigned int timeSteps = 1) {
+    // number of samples per simulation
+    const static int SN = 1024;
+
+    // number of variate
+    const static int VN = 1;
+
+    // Step first is needed to record each path along the time grid
+    const static bool SF = true;
+
+    // RNG alias name
+    typedef MT19937IcnRng<DT> RNG;
+
+    typedef BatchPathPricer<European, DT, SN, Antithetic, MaxSteps, MaxOptions> PathPricerT;
+
+    BSModel<DT> BSInst;
+
+    // path generator instance
+    BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // path pricer instance
+    PathPricerT pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+#if __cplusplus >= 201103L
+    static_assert(MaxOptions % 16 == 0, "MaxOptions should be a multiple of 16");
+#endif
+
+    // the batch is padded to a multiple of 16 for the accumulator
+    unsigned int optNumPad = (optNum + 15) / 16 * 16;
+
+    // the padded batch must fit the per-option arrays, and the path pricer
+    // records at most MaxSteps steps per path
+    if (optNum == 0 || optNumPad > MaxOptions || timeSteps == 0 || timeSteps > MaxSteps) {
+        return;
+    }
+
+    // uniform time grid up to the longest maturity
+    DT maxT = 0;
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        maxT = MAX(maxT, timeLength[k]);
+    }
+    DT dt = maxT / timeSteps;
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+    //
+    BSInst.variance(dt);
+    BSInst.stdDeviation();
+    BSInst.updateDrift(dt);
+
+    // configure the path generator and path pricer
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].optNum = optNumPad;
+        pathGenInst[i][0].BSInst = BSInst;
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+    for (int k = 0; k < optNumPad; ++k) {
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        // padded options reuse the last option of the batch
+        int idx = (k < optNum) ? k : (int)(optNum - 1);
+        DT t = timeLength[idx];
+        ap_uint<16> step = (ap_uint<16>)(t / dt + (DT)0.5);
+        step = (step < 1) ? (ap_uint<16>)1 : step;
+        step = (step > timeSteps) ? (ap_uint<16>)timeSteps : step;
+        DT discount = internal::FPExp(-internal::FPTwoMul(riskFreeRate, t));
+        // logS(t) = sqrt(ratio) * logS(step * dt) + drift * step * (ratio - sqrt(ratio))
+        DT ratio = t / internal::FPTwoMul((DT)step, dt);
+        DT volScale = hls::sqrt(ratio);
+        DT logShift =
+            internal::FPTwoMul(internal::FPTwoMul(BSInst.drift, (DT)step), internal::FPTwoSub(ratio, volScale));
+        for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+            pathPriInst[i][0].strike[k] = strike[idx];
+            pathPriInst[i][0].discount[k] = discount;
+            pathPriInst[i][0].maturityStep[k] = step;
+            pathPriInst[i][0].volScale[k] = volScale;
+            pathPriInst[i][0].logShift[k] = logShift;
+            pathPriInst[i][0].optionType[k] = optionType[idx];
+        }
+    }
+
+    // call monter carlo simulation
+    DT prices[MaxOptions];
+    mcSimulationBatch<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricerT, RNGSequence<DT, RNG>, UN, VN, SN,
+                      MaxOptions>(timeSteps, requiredSamples, optNumPad, pathGenInst, pathPriInst, rngSeqInst, prices);
+
+    // output the price of options
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        output[k] = prices[k];
+    }
+}
 /**
  * @brief path pricer bypass variant (interface compatible with standard MCEuropeanEngine)
  *
@@ -771,6 +1097,108 @@ void MCAmericanEngineCalibrate(DT timeLength,
     write_ddr<DT, COEFNM, 8 * sizeof(DT)>(timeSteps - 1, coefStrm, coefOut);
 }
 
+/**
+ * @brief American Option Pricing Engine using Monte Carlo Method.
+ * Calibrate kernel with streamed paths: same as MCAmericanEngineCalibrate, but
+ * the price data of the calibration paths is read from external memory one
+ * chunk of CHUNK_SAMPLES paths per unroll at a time and the discounted cash
+ * flows of the paths are kept in external memory between time steps. The number of
+ * calibration paths is therefore not limited by on-chip buffers. When all paths
+ * fit in one chunk, the coefficients are the same as MCAmericanEngineCalibrate.
+ *
+ * @tparam DT supported data type including double and float data type, which
+ * decides the precision of result, default double-precision data type.
+ * @tparam UN number of Monte Carlo Module in parallel (in path dimension),
+ * which affects the latency and resources utilization, default 2. [this unroll
+ * number should be equal to UN in MCAmericanEnginePresample]
+ * @tparam UN_STEP number of Monte Carlo Module in parallel (in time steps
+ * dimension), which affects the latency and resources utilization, default 2.
+ * @tparam CHUNK_SAMPLES number of paths per unroll kept on chip at one time, a
+ * multiple of 1024, default 4096.
+ * @param timeLength the time length of constract from start to end.
+ * @param riskFreeRate risk-free interest rate.
+ * @param strike the strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType option type. 1: put option, 0: call option.
+ * @param priceIn the price data, read in from DDR or HBM
+ * @param matIn the matrix data, read in from DDR or HBM
+ * @param flowBuff storage of the cash flows, calibSamples / UN elements in DDR
+ * or HBM
+ * @param coefOut the coef data that calculated by this kernel, the data can be
+ * stored to DDR or HBM
+ * @param calibSamples sample numbers that used in calibration, a multiple of
+ * 1024 * UN, default 4096.
+ * @param timeSteps the number of discrete steps from 0 to T, T is the expiry
+ * time, default 100.
+ */
+template <typename DT = double, int UN = 2, int UN_STEP = 2, int CHUNK_SAMPLES = 4096>
+void MCAmericanEngineCalibrateStream(DT timeLength,
+                                     DT riskFreeRate,
+                                     DT strike,
+                                     bool optionType,
+                                     ap_uint<8 * sizeof(DT) * UN>* priceIn,
+                                     ap_uint<8 * sizeof(DT)>* matIn,
+                                     ap_uint<8 * sizeof(DT) * UN>* flowBuff,
+                                     ap_uint<8 * sizeof(DT) * 4>* coefOut,
+                                     unsigned int calibSamples = 4096,
+                                     unsigned int timeSteps = 100) {
+#pragma HLS inline off
+
+    // number of samples per simulation
+    const static int SN = 1024;
+
+    // order of polynomial for LongStaffShwartz
+    const static int COEFNM = 4;
+
+    // pre-process of "cold" logic
+    DT dt = timeLength / timeSteps;
+    DT invStk = 1 / strike;
+    DT discount = internal::FPExp(-1.0 * riskFreeRate * dt);
+
+#pragma HLS dataflow
+    // intermediate streams used to buffer data between dataflow functions
+    hls::stream<DT> xStrm;
+#pragma HLS stream variable = &xStrm depth = 9
+    hls::stream<DT> xStrm_un[UN_STEP];
+#pragma HLS stream variable = xStrm_un depth = 9
+#pragma HLS array_partition variable = xStrm_un dim = 0
+    hls::stream<DT> mUstrm[UN_STEP];
+#pragma HLS stream variable = mUstrm depth = 16
+#pragma HLS array_partition variable = mUstrm dim = 0
+    hls::stream<DT> mVstrm[UN_STEP];
+#pragma HLS stream variable = mVstrm depth = 16
+#pragma HLS array_partition variable = mVstrm dim = 0
+    hls::stream<DT> mSstrm[UN_STEP];
+#pragma HLS stream variable = mSstrm depth = 16
+#pragma HLS array_partition variable = mSstrm dim = 0
+    hls::stream<DT> Ustrm;
+#pragma HLS stream variable = &Ustrm depth = 16
+    hls::stream<DT> Vstrm;
+#pragma HLS stream variable = &Vstrm depth = 16
+    hls::stream<DT> Sstrm;
+#pragma HLS stream variable = &Sstrm depth = 16
+    hls::stream<DT> coefStrm[COEFNM];
+#pragma HLS stream variable = coefStrm depth = 16
+#pragma HLS array_partition variable = coefStrm dim = 0
+
+    // read m mat data from DDR
+    read_AtA<DT, UN_STEP, COEFNM>(timeSteps, matIn, xStrm);
+
+    SplitStrm<DT, COEFNM, UN_STEP>(timeSteps / UN_STEP, xStrm, xStrm_un);
+
+    // calc SVD
+    MultiSVD<DT, COEFNM, UN_STEP>(timeSteps / UN_STEP, xStrm_un, mUstrm, mVstrm, mSstrm);
+
+    MergeStrm<DT, COEFNM, UN_STEP>(timeSteps / UN_STEP, mUstrm, mVstrm, mSstrm, Ustrm, Vstrm, Sstrm);
+
+    // calculate the coeff, reading the price data chunk by chunk
+    CalCoefChunked<DT, COEFNM, CHUNK_SAMPLES, UN, SN>(timeSteps, calibSamples / UN / SN, optionType, discount, strike,
+                                                      invStk, Ustrm, Vstrm, Sstrm, priceIn, flowBuff, coefStrm);
+
+    // write the coeff data to DDR, the data width is COEFNM* double
+    write_ddr<DT, COEFNM, 8 * sizeof(DT)>(timeSteps - 1, coefStrm, coefOut);
+}
+
 /**
  * @brief American Option Pricing Engine using Monte Carlo Method.
  * Pricing kernel
@@ -1122,6 +1550,9 @@ void MCAmericanEngine(DT underlying,
  * precision of output.
  * @tparam UN The number of Monte Carlo Module in parallel, which affects the
  * latency and resources utilization.
+ * @tparam RngType random sequence of the paths. PseudoRandom uses MT19937
+ * normals, LowDiscrepancy uses digitally shifted Sobol points with Brownian
+ * bridge construction, default PseudoRandom.
  * @param underlying The initial price of underlying asset.
  * @param volatility The market's price volatility.
  * @param dividendYield The dividend yield is the company's total annual
@@ -1146,7 +1577,7 @@ void MCAmericanEngine(DT underlying,
  * simulation will stop, default 2147483648.
  *
  */
-template <typename DT = double, int UN = 16>
+template <typename DT = double, int UN = 16, RNGType RngType = PseudoRandom>
 void MCAsianGeometricAPEngine(DT underlying,
                               DT volatility,
                               DT dividendYield,
@@ -1167,7 +1598,8 @@ void MCAsianGeometricAPEngine(DT underlying,
     const static int VN = 1; // VariateNum
 
     // Step first or Sample first
-    const static bool SF = false; // StepFirst
+    // the quasi-random sequence is generated path by path
+    const static bool SF = (RngType == LowDiscrepancy); // StepFirst
 
     // RNG alias
     typedef MT19937IcnRng<DT> RNG;
@@ -1191,7 +1623,8 @@ void MCAsianGeometricAPEngine(DT underlying,
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
     // RNG sequence Instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+    typedef typename RNGSequenceSelector<RngType, DT, RNG>::Type RNGSeqT;
+    RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
 
     // Pre-process of "cold" logic
@@ -1222,8 +1655,8 @@ void MCAsianGeometricAPEngine(DT underlying,
         rngSeqInst[i][0].seed[0] = seed[i];
     }
     DT price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
-                            RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
-                                                              pathGenInst, pathPriInst, rngSeqInst);
+                            RNGSeqT, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst,
+                                                 pathPriInst, rngSeqInst);
 
     output[0] = price;
 }
@@ -1237,6 +1670,13 @@ void MCAsianGeometricAPEngine(DT underlying,
  * precision of output.
  * @tparam UN The number of Monte Carlo Module in parallel, which affects the
  * latency and resources utilization.
+ * @tparam MomentMatching each block of normal random numbers is matched to zero
+ * mean and unit variance before path generation, default this feature is
+ * disabled. The geometric average price option is always used as control
+ * variate. Moment matching is not applied to a LowDiscrepancy sequence.
+ * @tparam RngType random sequence of the paths. PseudoRandom uses MT19937
+ * normals, LowDiscrepancy uses digitally shifted Sobol points with Brownian
+ * bridge construction, default PseudoRandom.
  * @param underlying The initial price of underlying asset.
  * @param volatility The market's price volatility.
  * @param dividendYield The dividend yield is the company's total annual
@@ -1262,7 +1702,7 @@ void MCAsianGeometricAPEngine(DT underlying,
  *
  */
 
-template <typename DT = double, int UN = 16>
+template <typename DT = double, int UN = 16, bool MomentMatching = false, RNGType RngType = PseudoRandom>
 void MCAsianArithmeticAPEngine(DT underlying,
                                DT volatility,
                                DT dividendYield,
@@ -1283,7 +1723,8 @@ void MCAsianArithmeticAPEngine(DT underlying,
     const static int VN = 1; // VariateNum
 
     // Step first or Sample first
-    const static bool SF = false; // StepFirst
+    // the quasi-random sequence is generated path by path
+    const static bool SF = (RngType == LowDiscrepancy); // StepFirst
 
     // RNG alias
     typedef MT19937IcnRng<DT> RNG;
@@ -1305,10 +1746,6 @@ void MCAsianArithmeticAPEngine(DT underlying,
     PathPricer<sty, DT, SF, SN, Antithetic> pathPriInst[UN][1];
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
-    // RNG sequence Instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
-#pragma HLS array_partition variable = rngSeqInst dim = 1
-
     // Pre-process of "cold" logic
     // DT dt           = ((int)((360.0*timeLength/(timeSteps+1))+0.5))/360.0;
     DT dt = timeLength / ((DT)timeSteps);
@@ -1338,15 +1775,33 @@ void MCAsianArithmeticAPEngine(DT underlying,
 
         // Path Generator
         pathGenInst[i][0].BSInst = BSInst;
-
-        // RNG Sequence
-        rngSeqInst[i][0].seed[0] = seed[i];
     }
 
-    DT price = mcSimulation<DT, xf::fintech::MT19937IcnRng<DT>, BSPathGenerator<DT, SF, SN, Antithetic>,
-                            PathPricer<sty, DT, SF, SN, Antithetic>, RNGSequence<DT, xf::fintech::MT19937IcnRng<DT> >,
-                            UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst,
-                                        pathPriInst, rngSeqInst);
+    DT price;
+    if (MomentMatching && RngType == PseudoRandom) {
+        // RNG sequence Instance
+        RNGSequenceMomentMatching<DT, RNG, SN> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+        for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+            rngSeqInst[i][0].seed[0] = seed[i];
+        }
+        price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
+                             RNGSequenceMomentMatching<DT, RNG, SN>, UN, VN, SN>(
+            timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst, pathPriInst, rngSeqInst);
+    } else {
+        // RNG sequence Instance
+        typedef typename RNGSequenceSelector<RngType, DT, RNG>::Type RNGSeqT;
+        RNGSeqT rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+        for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+            rngSeqInst[i][0].seed[0] = seed[i];
+        }
+        price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
+                             RNGSeqT, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
+                                                  pathGenInst, pathPriInst, rngSeqInst);
+    }
 
     // Control variate price ref
     DT fixings = timeSteps + 1;
@@ -1379,6 +1834,125 @@ void MCAsianArithmeticAPEngine(DT underlying,
     output[0] = price + priceRef;
 }
 
+/**
+ * @brief Asian Arithmetic Average Price Engine with continuous averaging using
+ * multilevel Monte Carlo Method based on Black-Scholes Model.
+ *
+ * The average of the asset price over the option lifetime is approximated by the
+ * trapezoidal rule on a time grid. Instead of simulating all the paths on a fine
+ * grid, the price on the finest grid is written as the price on a coarse grid of
+ * baseSteps steps plus a sum of corrections between successive grids, each grid
+ * having twice the steps of the previous one. A correction is estimated from the
+ * fine and coarse prices of the same paths, so its variance is small and only a
+ * few fine paths are needed. The number of grids and the number of paths on each
+ * grid are chosen on the fly to reach requiredRMSE.
+ *
+ * @tparam DT Supported data type including double and float, which decides the
+ * precision of output.
+ * @tparam UN The number of Monte Carlo Module in parallel, which affects the
+ * latency and resources utilization.
+ * @tparam MaxLevels The maximum number of grids, the finest grid has baseSteps *
+ * 2^(MaxLevels-1) steps.
+ * @param underlying The initial price of underlying asset.
+ * @param volatility The market's price volatility.
+ * @param dividendYield The dividend yield is the company's total annual
+ * dividend payments divided by its market capitalization, or the dividend per
+ * share, divided by the price per share.
+ * @param riskFreeRate The risk-free interest rate is the rate of return of a
+ * hypothetical investment with no risk of financial loss, over a given period
+ * of time.
+ * @param timeLength The given period of time.
+ * @param strike The strike price also known as exericse price, which is settled
+ * in the contract.
+ * @param optionType Option type. 1: put option, 0: call option.
+ * @param seed array of seed to initialize RNG.
+ * @param output Output array.
+ * @param requiredRMSE The root mean square error required, which includes the
+ * bias of the time discretization, default 0.02.
+ * @param baseSteps Number of interval of the coarsest grid, default 4.
+ * @param maxSamples The maximum sample number of each grid, default 134217727.
+ *
+ */
+template <typename DT = double, int UN = 16, int MaxLevels = 8>
+void MCAsianArithmeticAPMultiLevelEngine(DT underlying,
+                                         DT volatility,
+                                         DT dividendYield,
+                                         DT riskFreeRate, // process
+                                         DT timeLength,
+                                         DT strike,
+                                         bool optionType, // option
+                                         ap_uint<32>* seed,
+                                         DT* output,
+                                         DT requiredRMSE = 0.02,
+                                         unsigned int baseSteps = 4,
+                                         unsigned int maxSamples = MAX_SAMPLE) {
+    // Number of Samples per simulation
+    const static int SN = 1024; // SampNum
+
+    // Number of Variate
+    const static int VN = 1; // VariateNum
+
+    // Step first or Sample first
+    const static bool SF = false; // StepFirst
+
+    // RNG alias
+    typedef MT19937IcnRng<DT> RNG;
+
+    // Enable Antithetic or not
+    const static bool Antithetic = false;
+
+    // Define Asian Average Price option type
+    const OptionStyle sty = Asian_AP;
+
+    // B-S model instance
+    BSModel<DT> BSInst;
+
+    // Path generator instance
+    BSPathGenerator<DT, SF, SN, Antithetic> pathGenInst[UN][1];
+#pragma HLS array_partition variable = pathGenInst dim = 1
+
+    // Path pricer instance
+    MultiLevelPathPricer<sty, DT, SN, Antithetic> pathPriInst[UN][1];
+#pragma HLS array_partition variable = pathPriInst dim = 1
+
+    // RNG sequence instance
+    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+#pragma HLS array_partition variable = rngSeqInst dim = 1
+
+    // Pre-process of "cold" logic, the time interval is set for each level
+    DT tmpExp = internal::FPTwoMul(riskFreeRate, timeLength);
+    DT discount = hls::exp(-tmpExp);
+
+    BSInst.riskFreeRate = riskFreeRate;
+    BSInst.dividendYield = dividendYield;
+    BSInst.volatility = volatility;
+
+    // Configure path generator,path pricer and RNG sequence.
+    for (int i = 0; i < UN; ++i) {
+#pragma HLS unroll
+        // Path Pricer
+        pathPriInst[i][0].optionType = optionType;
+        pathPriInst[i][0].underlying = underlying;
+        pathPriInst[i][0].strike = strike;
+        pathPriInst[i][0].discount = discount;
+
+        // Path Generator
+        pathGenInst[i][0].BSInst = BSInst;
+
+        // RNGSequnce
+        rngSeqInst[i][0].seed[0] = seed[i];
+    }
+
+    // call multilevel Monte Carlo Simulation
+    DT price = mcMultiLevelSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>,
+                                      MultiLevelPathPricer<sty, DT, SN, Antithetic>, RNGSequence<DT, RNG>, UN, VN, SN,
+                                      MaxLevels>(baseSteps, timeLength, maxSamples, requiredRMSE, pathGenInst,
+                                                 pathPriInst, rngSeqInst);
+
+    // output the price of option
+    output[0] = price;
+}
+
 /**
  * @brief Asian Arithmetic Average Strike Engine using Monte Carlo Method Based
  * on Black-Scholes Model.
@@ -1389,6 +1963,9 @@ void MCAsianArithmeticAPEngine(DT underlying,
  * precision of output.
  * @tparam UN The number of Monte Carlo Module in parallel, which affects the
  * latency and resources utilization.
+ * @tparam RngType random sequence of the paths. PseudoRandom uses MT19937
+ * normals, LowDiscrepancy uses digitally shifted Sobol points with Brownian
+ * bridge construction, default PseudoRandom.
  * @param underlying The initial price of underlying asset.
  * @param volatility The market's price volatility.
  * @param dividendYield The dividend yield is the company's total annual
@@ -1414,7 +1991,7 @@ void MCAsianArithmeticAPEngine(DT underlying,
  * simulation will stop, default 2,147,483,648.
  *
  */
-template <typename DT = double, int UN = 16>
+template <typename DT = double, int UN = 16, RNGType RngType = PseudoRandom>
 void MCAsianArithmeticASEngine(DT underlying,
                                DT volatility,
                                DT dividendYield,
@@ -1435,7 +2012,8 @@ void MCAsianArithmeticASEngine(DT underlying,
     const static int VN = 1; // VariateNum
 
     // Step first or Sample first
-    const static bool SF = false; // StepFirst
+    // the quasi-random sequence is generated path by path
+    const static bool SF = (RngType == LowDiscrepancy); // StepFirst
 
     // RNG alias
     typedef MT19937IcnRng<DT> RNG;
@@ -1458,7 +2036,8 @@ void MCAsianArithmeticASEngine(DT underlying,
 #pragma HLS array_partition variable = pathPriInst dim = 1
 
     // RNG sequence Instance
-    RNGSequence<DT, RNG> rngSeqInst[UN][1];
+    typedef typename RNGSequenceSelector<RngType, DT, RNG>::Type RNGSeqT;
+    RNGSeqT rngSeqInst[UN][1];
 #pragma HLS array_partition variable = rngSeqInst dim = 1
 
     // Pre-process of "cold" logic
@@ -1491,8 +2070,8 @@ void MCAsianArithmeticASEngine(DT underlying,
     }
 
     DT price = mcSimulation<DT, RNG, BSPathGenerator<DT, SF, SN, Antithetic>, PathPricer<sty, DT, SF, SN, Antithetic>,
-                            RNGSequence<DT, RNG>, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance,
-                                                              pathGenInst, pathPriInst, rngSeqInst);
+                            RNGSeqT, UN, VN, SN>(timeSteps, maxSamples, requiredSamples, requiredTolerance, pathGenInst,
+                                                 pathPriInst, rngSeqInst);
 
     // Output the option price
     output[0] = price;
@@ -43,7 +43,8 @@
  * **********/
 /**
  *  @file pop_mcmc.hpp
- *  @brief  Implementation of Population Markov Chain Monte Carlo (MCMC)
+ *  @brief  Implementation of Population Markov Chain Monte Carlo (MCMC), for a one dimensional target and for
+ *  user defined multi-dimensional targets
  *
  *  $DateTime: 2019/07/24 12:00:00 $
  */
@@ -289,6 +290,377 @@ SAMPLES_LOOP:
     } // end for sample loop
 }
 
+/**
+* @brief Offsets of the fields of the state of McmcCoreMultiDim, which is kept in global memory between calls. \n
+* All fields are zero at the start of a run, except the chain positions which hold the initial point. \n
+*
+*@tparam NCHAINS - Number of chains
+*@tparam NDIM    - Maximum number of dimensions
+*/
+template <unsigned int NCHAINS, unsigned int NDIM>
+struct McmcMultiDimState {
+    /// Position of each chain, NDIM values per chain
+    static const unsigned int CHAIN = 0;
+    /// Running mean of the samples of the coldest chain
+    static const unsigned int MEAN = CHAIN + NCHAINS * NDIM;
+    /// Running sum of the outer products of the deviations from the mean, NDIM x NDIM
+    static const unsigned int M2 = MEAN + NDIM;
+    /// Number of samples in the running moments
+    static const unsigned int COUNT = M2 + NDIM * NDIM;
+    /// Logarithm of the scale of the proposal of each chain
+    static const unsigned int LOG_SCALE = COUNT + 1;
+    /// Total size of the state
+    static const unsigned int SIZE = LOG_SCALE + NCHAINS;
+};
+
+/**
+* @brief Log density of a multivariate normal distribution, up to a constant. \n
+* Example of the target interface of McmcCoreMultiDim: init() reads the parameters of the target from global
+* memory and logDensity() returns the logarithm of the unnormalised density. \n
+*
+*@tparam DT   - Data type used in whole function (double by default)
+*@tparam NDIM - Maximum number of dimensions
+*/
+template <typename DT, unsigned int NDIM>
+class GaussianLogDensity {
+   public:
+    /**
+    * @brief Loads the parameters.
+    *
+    *@param[in] params - Mean followed by the precision matrix (inverse covariance), row by row \n
+    *@param[in] nDim   - Number of dimensions \n
+    */
+    void init(DT* params, unsigned int nDim) {
+    LOAD_MEAN_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            mu[i] = params[i];
+        }
+    LOAD_PRECISION_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+            for (int j = 0; j < nDim; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+                prec[i][j] = params[nDim + i * nDim + j];
+            }
+        }
+    }
+
+    /**
+    * @brief Calculates the log density.
+    *
+    *@param[in] x    - Sample to evaluate \n
+    *@param[in] nDim - Number of dimensions \n
+    *@return         - Log density of the sample
+    */
+    DT logDensity(DT x[NDIM], unsigned int nDim) {
+        DT d[NDIM];
+        DT result = 0;
+    DEVIATION_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            d[i] = x[i] - mu[i];
+        }
+    QUADRATIC_FORM_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+            DT acc = 0;
+            for (int j = 0; j < nDim; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+                acc += prec[i][j] * d[j];
+            }
+            result += d[i] * acc;
+        }
+        return -0.5 * result;
+    }
+
+   private:
+    DT mu[NDIM];
+    DT prec[NDIM][NDIM];
+};
+
+namespace internal {
+/**
+* @brief Cholesky factorisation of the proposal covariance, which is the running covariance scaled by scaleDim. \n
+* The factor is left unchanged if the covariance is not positive definite. \n
+*
+*@tparam DT   - Data type used in whole function (double by default)
+*@tparam NDIM - Maximum number of dimensions
+*@param[in]  m2       - Running sum of the outer products of the deviations from the mean \n
+*@param[in]  count    - Number of samples in m2 \n
+*@param[in]  scaleDim - Scale of the covariance \n
+*@param[out] chol     - Lower triangular factor \n
+*@param[in]  nDim     - Number of dimensions \n
+*/
+template <typename DT, unsigned int NDIM>
+void CholeskyUpdate(DT m2[NDIM][NDIM], DT count, DT scaleDim, DT chol[NDIM][NDIM], unsigned int nDim) {
+    DT l[NDIM][NDIM];
+    DT cov_scale = scaleDim / count;
+    bool ok = true;
+CHOLESKY_COL_LOOP:
+    for (int j = 0; j < nDim; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+        DT diag = m2[j][j] * cov_scale;
+        for (int k = 0; k < j; k++) {
+#pragma HLS LOOP_TRIPCOUNT min = 5 max = 25
+#pragma HLS pipeline
+            diag -= l[j][k] * l[j][k];
+        }
+        if (diag <= 0) {
+            ok = false;
+            diag = 1;
+        }
+        DT ljj = hls::sqrt(diag);
+        l[j][j] = ljj;
+    CHOLESKY_ROW_LOOP:
+        for (int i = j + 1; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 5 max = 25
+            DT v = m2[i][j] * cov_scale;
+            for (int k = 0; k < j; k++) {
+#pragma HLS LOOP_TRIPCOUNT min = 5 max = 25
+#pragma HLS pipeline
+                v -= l[i][k] * l[j][k];
+            }
+            l[i][j] = v / ljj;
+        }
+    }
+    if (ok) {
+    CHOLESKY_COPY_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+            for (int j = 0; j < nDim; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+                chol[i][j] = (j <= i) ? l[i][j] : 0;
+            }
+        }
+    }
+}
+
+/**
+* @brief Metropolis step of one chain with proposal x + scale * chol * z, z standard normal. \n
+*
+*@tparam DT     - Data type used in whole function (double by default)
+*@tparam Target - Target distribution, see GaussianLogDensity
+*@tparam NDIM   - Maximum number of dimensions
+*@param[in]     target     - Target distribution \n
+*@param[in,out] x          - Position of the chain \n
+*@param[in,out] logDens    - Log density of the position of the chain \n
+*@param[in]     chol       - Cholesky factor of the proposal covariance \n
+*@param[in]     scale      - Scale of the proposal \n
+*@param[in]     temp_inv   - Inverted temperature of the chain (1/Temp) \n
+*@param[in]     nDim       - Number of dimensions \n
+*@param[in]     uniformRNG - Uniform RNG for the proposal and Accept/Reject \n
+*@return                   - Whether the proposal was accepted
+*/
+template <typename DT, typename Target, unsigned int NDIM>
+bool MetropolisStep(Target& target,
+                    DT x[NDIM],
+                    DT& logDens,
+                    DT chol[NDIM][NDIM],
+                    DT scale,
+                    DT temp_inv,
+                    unsigned int nDim,
+                    xf::fintech::MT19937& uniformRNG) {
+    DT z[NDIM];
+    DT xStar[NDIM];
+GAUSS_LOOP:
+    for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+        DT in = uniformRNG.next();
+        z[i] = xf::fintech::inverseCumulativeNormalAcklam<DT>(in);
+    }
+PROPOSAL_LOOP:
+    for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+        DT acc = 0;
+        for (int j = 0; j <= i; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 5 max = 25
+#pragma HLS pipeline
+            acc += chol[i][j] * z[j];
+        }
+        xStar[i] = x[i] + scale * acc;
+    }
+    DT logDensStar = target.logDensity(xStar, nDim);
+    DT alpha = (logDensStar - logDens) * temp_inv;
+    DT u = uniformRNG.next();
+    bool accept = hls::log(u) < alpha;
+    if (accept) {
+    ACCEPT_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            x[i] = xStar[i];
+        }
+        logDens = logDensStar;
+    }
+    return accept;
+}
+} // internal
+
+/**
+* @brief Multi-dimensional population MCMC. Consists of INIT_LOOP and main sample loop: SAMPLES_LOOP \n
+* \n
+* Generates samples from a user defined target distribution of up to NDIM dimensions, using parallel tempering over
+* NCHAINS chains. \n
+* The proposal of each chain is a Gaussian whose covariance is the running covariance of the samples of the coldest
+* chain, scaled by 2.38^2/nDim (adaptive Metropolis), and recomputed every adaptInterval samples. Before enough samples
+* are available the proposal is isotropic with standard deviation sigma. The scale of the proposal of each chain is
+* adapted towards an acceptance rate of 0.234 with a diminishing step. \n
+* The state of the chains and of the adaptation is read from and written back to global memory, so that a long run
+* can be split into calls of at most NSAMPLES_MAX samples and the samples streamed to the host between calls. \n
+*
+*@tparam DT             - Data type used in whole function (double by default)
+*@tparam Target         - Target distribution, a class with the interface of GaussianLogDensity
+*@tparam NCHAINS        - Number of chains
+*@tparam NDIM           - Maximum number of dimensions
+*@tparam NSAMPLES_MAX   - Maximum number of samples per call
+*@param[in] target        - Target distribution, already initialised \n
+*@param[in] temp_inv      - Array of Inverted temperatures of the chains, the first one being 1 (1/Temp) \n
+*@param[in,out] state     - State of the chains, laid out as in McmcMultiDimState \n
+*@param[out] x            - Samples of the coldest chain, nDim values per sample \n
+*@param[in] nDim          - Number of dimensions \n
+*@param[in] nSamples      - Number of samples to generate \n
+*@param[in] sigma         - Standard deviation of the proposal before adaptation \n
+*@param[in] adaptInterval - Number of samples between updates of the proposal covariance \n
+*@param[in] seed          - Seed of the RNG, which should differ between calls of the same run \n
+*/
+template <typename DT, typename Target, unsigned int NCHAINS, unsigned int NDIM, unsigned int NSAMPLES_MAX>
+void McmcCoreMultiDim(Target& target,
+                      DT temp_inv[NCHAINS],
+                      DT state[McmcMultiDimState<NCHAINS, NDIM>::SIZE],
+                      DT x[NSAMPLES_MAX * NDIM],
+                      unsigned int nDim,
+                      unsigned int nSamples,
+                      DT sigma,
+                      unsigned int adaptInterval,
+                      unsigned int seed) {
+    typedef McmcMultiDimState<NCHAINS, NDIM> State;
+    DT chain[NCHAINS][NDIM];
+    DT logDens[NCHAINS];
+    DT logScale[NCHAINS];
+    DT temp_inv_buff[NCHAINS];
+    DT mean[NDIM];
+    DT m2[NDIM][NDIM];
+    DT chol[NDIM][NDIM];
+    DT count = state[State::COUNT];
+    DT scaleDim = 2.38 * 2.38 / nDim;
+    // odd and even pairs alternate, carried over calls by the parity of count
+    bool even = ((unsigned int)count) & 1;
+    xf::fintech::MT19937 uniformRNG(seed);
+
+INIT_LOOP:
+    for (int n = 0; n < NCHAINS; n++) {
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            chain[n][i] = state[State::CHAIN + n * NDIM + i];
+        }
+        logDens[n] = target.logDensity(chain[n], nDim);
+        logScale[n] = state[State::LOG_SCALE + n];
+        temp_inv_buff[n] = temp_inv[n];
+    }
+INIT_MOMENTS_LOOP:
+    for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+        mean[i] = state[State::MEAN + i];
+        for (int j = 0; j < nDim; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            m2[i][j] = state[State::M2 + i * NDIM + j];
+            chol[i][j] = (i == j) ? sigma : 0;
+        }
+    }
+    if (count > nDim) {
+        internal::CholeskyUpdate<DT, NDIM>(m2, count, scaleDim, chol, nDim);
+    }
+
+SAMPLES_LOOP:
+    for (int t = 0; t < nSamples; t++) {
+#pragma HLS LOOP_TRIPCOUNT min = 500 max = 5000
+        DT gain = 1.0 / hls::sqrt(count + 1);
+    CHAINS_LOOP:
+        for (int n = 0; n < NCHAINS; n++) {
+            bool accept = internal::MetropolisStep<DT, Target, NDIM>(
+                target, chain[n], logDens[n], chol, hls::exp(logScale[n]), temp_inv_buff[n], nDim, uniformRNG);
+            logScale[n] += gain * ((accept ? 1.0 : 0.0) - 0.234);
+            if (logScale[n] > 10) logScale[n] = 10;
+            if (logScale[n] < -10) logScale[n] = -10;
+        }
+
+    // Exchanging odd or even pairs of chains
+    EXCHANGE_LOOP:
+        for (int n = 1 + even; n < NCHAINS; n = n + 2) {
+#pragma HLS LOOP_TRIPCOUNT min = 4 max = 5
+            DT alpha_ex = (temp_inv_buff[n - 1] - temp_inv_buff[n]) * (logDens[n] - logDens[n - 1]);
+            DT u = uniformRNG.next();
+            if (hls::log(u) < alpha_ex) {
+                for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+                    DT tmp = chain[n][i];
+                    chain[n][i] = chain[n - 1][i];
+                    chain[n - 1][i] = tmp;
+                }
+                DT tmp = logDens[n];
+                logDens[n] = logDens[n - 1];
+                logDens[n - 1] = tmp;
+            }
+        }
+        even = !even;
+
+        // Output is only first chain with temp=1, which also feeds the running moments
+        count += 1;
+        DT delta[NDIM];
+    OUTPUT_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            x[t * nDim + i] = chain[0][i];
+            delta[i] = chain[0][i] - mean[i];
+            mean[i] += delta[i] / count;
+        }
+    MOMENTS_LOOP:
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+            for (int j = 0; j < nDim; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+                m2[i][j] += delta[i] * (chain[0][j] - mean[j]);
+            }
+        }
+        if (count > nDim && ((unsigned int)count % adaptInterval) == 0) {
+            internal::CholeskyUpdate<DT, NDIM>(m2, count, scaleDim, chol, nDim);
+        }
+    } // end for sample loop
+
+SAVE_LOOP:
+    for (int n = 0; n < NCHAINS; n++) {
+        for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            state[State::CHAIN + n * NDIM + i] = chain[n][i];
+        }
+        state[State::LOG_SCALE + n] = logScale[n];
+    }
+SAVE_MOMENTS_LOOP:
+    for (int i = 0; i < nDim; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+        state[State::MEAN + i] = mean[i];
+        for (int j = 0; j < nDim; j++) {
+#pragma HLS LOOP_TRIPCOUNT min = 10 max = 50
+#pragma HLS pipeline
+            state[State::M2 + i * NDIM + j] = m2[i][j];
+        }
+    }
+    state[State::COUNT] = count;
+}
+
 } // namespace solver
 } // namespace xf
 
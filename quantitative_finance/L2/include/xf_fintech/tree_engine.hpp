@@ -18,7 +18,7 @@
  * @file tree_engine.hpp
  *
  * @brief the file include 4 function that are treeSwaptionEngine, treeSwapEngine, treeCapFloorEngine,
- * treeCallableEngine.
+ * treeCallableEngine, and their batch versions which price many instruments through one lattice.
  */
 #ifndef _XF_FINTECH_TREE_ENGINE_HPP_
 #define _XF_FINTECH_TREE_ENGINE_HPP_
@@ -646,6 +646,793 @@ void treeCallableEngine(Model& model,
     lattice.rollback(model, engine, endCnt, time, dtime, NPV);
 }
 
+namespace internal {
+
+// maps the counts in initTime of one instrument of a batch onto the timepoint counters of the shared grid, and
+// returns the index of the last one
+inline int treeBatchCnt(int* steps, int* cnt, int size, int* gridCnt) {
+#pragma HLS inline
+loop_batch_cnt:
+    for (int k = 0; k < size; k++) {
+#pragma HLS pipeline
+#pragma HLS loop_tripcount min = 10 max = 10
+        gridCnt[k] = steps[cnt[k] + 1];
+    }
+    return size - 1;
+}
+
+} // internal
+
+/**
+ * @brief Tree Swaption Pricing Engine using Trinomial Tree based 1D Lattice method, for a batch of swaptions on the
+ * same model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each swaption is
+ * rolled back through the lattice from its own end timepoint. The timepoints of the other swaptions refine the grid of
+ * a swaption, so its NPV may differ slightly from the one of treeSwaptionEngine.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process stochastic process that has been initialized
+ * @param numInstruments the number of swaptions of the batch.
+ * @param type 0: Payer, 1: Receiver, per swaption
+ * @param fixedRate fixed annual interest rate, per swaption
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param exerciseCnt exercise timepoints count in initTime, of all swaptions one after the other.
+ * @param exerciseSize the number of exercise timepoints of each swaption.
+ * @param floatingCnt floating coupon timepoints count in initTime, of all swaptions one after the other.
+ * @param floatingSize the number of floating coupon timepoints of each swaption.
+ * @param fixedCnt fixed coupon timepoints count in initTime, of all swaptions one after the other.
+ * @param fixedSize the number of fixed coupon timepoints of each swaption.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param NPV is pricing result array of this engine, one per swaption
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeSwaptionBatchEngine(Model& model,
+                             Process& process,
+                             int numInstruments,
+                             int* type,
+                             DT* fixedRate,
+                             int timestep,
+                             DT initTime[LEN],
+                             int initSize,
+                             int* endIndex,
+                             int* exerciseCnt,
+                             int* exerciseSize,
+                             int* floatingCnt,
+                             int* floatingSize,
+                             int* fixedCnt,
+                             int* fixedSize,
+                             DT flatRate,
+                             DT nominal,
+                             DT x0,
+                             DT spread,
+                             DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int exercise_cnt[LEN];
+    int floating_cnt[LEN];
+    int fixed_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 0, LEN2> Engine;
+    DT accruedSpread = 0.0; // nominal * T * spread;
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process, endCnt + 1, flatRate, x0, time, dtime);
+
+    int exerciseOffset = 0, floatingOffset = 0, fixedOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int exerciseEndCnt = internal::treeBatchCnt(steps, exerciseCnt + exerciseOffset, exerciseSize[n], exercise_cnt);
+        int floatingEndCnt = internal::treeBatchCnt(steps, floatingCnt + floatingOffset, floatingSize[n], floating_cnt);
+        int fixedEndCnt = internal::treeBatchCnt(steps, fixedCnt + fixedOffset, fixedSize[n], fixed_cnt);
+        exerciseOffset += exerciseSize[n];
+        floatingOffset += floatingSize[n];
+        fixedOffset += fixedSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], nominal, accruedSpread, nominal * fixedRate[n], floatingEndCnt, fixedEndCnt,
+                          exerciseEndCnt, floating_cnt, fixed_cnt, exercise_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
+/**
+ * @brief Tree Swaption Pricing Engine using Trinomial Tree based 2D Lattice method, for a batch of swaptions on the
+ * same model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each swaption is
+ * rolled back through the lattice from its own end timepoint. The timepoints of the other swaptions refine the grid of
+ * a swaption, so its NPV may differ slightly from the one of treeSwaptionEngine.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process1 1st dimensional stochastic process that has been initialized
+ * @param process2 2nd dimensional stochastic process that has been initialized
+ * @param numInstruments the number of swaptions of the batch.
+ * @param type 0: Payer, 1: Receiver, per swaption
+ * @param fixedRate fixed annual interest rate, per swaption
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param exerciseCnt exercise timepoints count in initTime, of all swaptions one after the other.
+ * @param exerciseSize the number of exercise timepoints of each swaption.
+ * @param floatingCnt floating coupon timepoints count in initTime, of all swaptions one after the other.
+ * @param floatingSize the number of floating coupon timepoints of each swaption.
+ * @param fixedCnt fixed coupon timepoints count in initTime, of all swaptions one after the other.
+ * @param fixedSize the number of fixed coupon timepoints of each swaption.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param rho the correlation coefficient between price and variance.
+ * @param NPV is pricing result array of this engine, one per swaption
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeSwaptionBatchEngine(Model& model,
+                             Process& process1,
+                             Process& process2,
+                             int numInstruments,
+                             int* type,
+                             DT* fixedRate,
+                             int timestep,
+                             DT initTime[LEN],
+                             int initSize,
+                             int* endIndex,
+                             int* exerciseCnt,
+                             int* exerciseSize,
+                             int* floatingCnt,
+                             int* floatingSize,
+                             int* fixedCnt,
+                             int* fixedSize,
+                             DT flatRate,
+                             DT nominal,
+                             DT x0,
+                             DT spread,
+                             DT rho,
+                             DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int exercise_cnt[LEN];
+    int floating_cnt[LEN];
+    int fixed_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 0, LEN2> Engine;
+    DT accruedSpread = 0.0; // nominal * T * spread;
+
+#ifndef __SYNTHESIS__
+    DT corr = std::abs(rho);
+#else
+    DT corr = hls::abs(rho);
+#endif
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process1, process2, endCnt + 1, flatRate, x0, time, dtime);
+
+    int exerciseOffset = 0, floatingOffset = 0, fixedOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int exerciseEndCnt = internal::treeBatchCnt(steps, exerciseCnt + exerciseOffset, exerciseSize[n], exercise_cnt);
+        int floatingEndCnt = internal::treeBatchCnt(steps, floatingCnt + floatingOffset, floatingSize[n], floating_cnt);
+        int fixedEndCnt = internal::treeBatchCnt(steps, fixedCnt + fixedOffset, fixedSize[n], fixed_cnt);
+        exerciseOffset += exerciseSize[n];
+        floatingOffset += floatingSize[n];
+        fixedOffset += fixedSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], corr, nominal, accruedSpread, nominal * fixedRate[n], floatingEndCnt, fixedEndCnt,
+                          exerciseEndCnt, floating_cnt, fixed_cnt, exercise_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
+/**
+ * @brief Tree Swap Pricing Engine using Trinomial Tree based 1D Lattice method, for a batch of swaps on the same
+ * model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each swap is rolled
+ * back through the lattice from its own end timepoint.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process stochastic process that has been initialized
+ * @param numInstruments the number of swaps of the batch.
+ * @param type 0: Payer, 1: Receiver, per swap
+ * @param fixedRate fixed annual interest rate, per swap
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param floatingCnt floating coupon timepoints count in initTime, of all swaps one after the other.
+ * @param floatingSize the number of floating coupon timepoints of each swap.
+ * @param fixedCnt fixed coupon timepoints count in initTime, of all swaps one after the other.
+ * @param fixedSize the number of fixed coupon timepoints of each swap.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param NPV is pricing result array of this engine, one per swap
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeSwapBatchEngine(Model& model,
+                         Process& process,
+                         int numInstruments,
+                         int* type,
+                         DT* fixedRate,
+                         int timestep,
+                         DT initTime[LEN],
+                         int initSize,
+                         int* endIndex,
+                         int* floatingCnt,
+                         int* floatingSize,
+                         int* fixedCnt,
+                         int* fixedSize,
+                         DT flatRate,
+                         DT nominal,
+                         DT x0,
+                         DT spread,
+                         DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int floating_cnt[LEN];
+    int fixed_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 1, LEN2> Engine;
+    DT accruedSpread = 0.0; // nominal * T * spread;
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process, endCnt + 1, flatRate, x0, time, dtime);
+
+    int floatingOffset = 0, fixedOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int floatingEndCnt = internal::treeBatchCnt(steps, floatingCnt + floatingOffset, floatingSize[n], floating_cnt);
+        int fixedEndCnt = internal::treeBatchCnt(steps, fixedCnt + fixedOffset, fixedSize[n], fixed_cnt);
+        floatingOffset += floatingSize[n];
+        fixedOffset += fixedSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], nominal, accruedSpread, nominal * fixedRate[n], floatingEndCnt, fixedEndCnt,
+                          floating_cnt, fixed_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
+/**
+ * @brief Tree Swap Pricing Engine using Trinomial Tree based 2D Lattice method, for a batch of swaps on the same
+ * model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each swap is rolled
+ * back through the lattice from its own end timepoint.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process1 1st dimensional stochastic process that has been initialized
+ * @param process2 2nd dimensional stochastic process that has been initialized
+ * @param numInstruments the number of swaps of the batch.
+ * @param type 0: Payer, 1: Receiver, per swap
+ * @param fixedRate fixed annual interest rate, per swap
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param floatingCnt floating coupon timepoints count in initTime, of all swaps one after the other.
+ * @param floatingSize the number of floating coupon timepoints of each swap.
+ * @param fixedCnt fixed coupon timepoints count in initTime, of all swaps one after the other.
+ * @param fixedSize the number of fixed coupon timepoints of each swap.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param rho the correlation coefficient between price and variance.
+ * @param NPV is pricing result array of this engine, one per swap
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeSwapBatchEngine(Model& model,
+                         Process& process1,
+                         Process& process2,
+                         int numInstruments,
+                         int* type,
+                         DT* fixedRate,
+                         int timestep,
+                         DT initTime[LEN],
+                         int initSize,
+                         int* endIndex,
+                         int* floatingCnt,
+                         int* floatingSize,
+                         int* fixedCnt,
+                         int* fixedSize,
+                         DT flatRate,
+                         DT nominal,
+                         DT x0,
+                         DT spread,
+                         DT rho,
+                         DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int floating_cnt[LEN];
+    int fixed_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 1, LEN2> Engine;
+    DT accruedSpread = 0.0; // nominal * T * spread;
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process1, process2, endCnt + 1, flatRate, x0, time, dtime);
+
+    int floatingOffset = 0, fixedOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int floatingEndCnt = internal::treeBatchCnt(steps, floatingCnt + floatingOffset, floatingSize[n], floating_cnt);
+        int fixedEndCnt = internal::treeBatchCnt(steps, fixedCnt + fixedOffset, fixedSize[n], fixed_cnt);
+        floatingOffset += floatingSize[n];
+        fixedOffset += fixedSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], rho, nominal, accruedSpread, nominal * fixedRate[n], floatingEndCnt, fixedEndCnt,
+                          floating_cnt, fixed_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
+/**
+ * @brief Tree CapFloor Pricing Engine using Trinomial Tree based 1D Lattice method, for a batch of caps and floors
+ * on the same model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each instrument is
+ * rolled back through the lattice from its own end timepoint.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process stochastic process that has been initialized
+ * @param numInstruments the number of instruments of the batch.
+ * @param type 0: Cap, 1: Collar, 2: Floor, per instrument
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param floatingCnt floating coupon timepoints count in initTime, of all instruments one after the other.
+ * @param floatingSize the number of floating coupon timepoints of each instrument.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param cfRate cap rate and floor rate, two per instrument
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param NPV is pricing result array of this engine, one per instrument
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeCapFloorBatchEngine(Model& model,
+                             Process& process,
+                             int numInstruments,
+                             int* type,
+                             int timestep,
+                             DT initTime[LEN],
+                             int initSize,
+                             int* endIndex,
+                             int* floatingCnt,
+                             int* floatingSize,
+                             DT flatRate,
+                             DT nominal,
+                             DT* cfRate,
+                             DT x0,
+                             DT spread,
+                             DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int floating_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 2, LEN2> Engine;
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process, endCnt + 1, flatRate, x0, time, dtime);
+
+    int floatingOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int floatingEndCnt = internal::treeBatchCnt(steps, floatingCnt + floatingOffset, floatingSize[n], floating_cnt);
+        floatingOffset += floatingSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], initTime[endIndex[n]], nominal, cfRate + 2 * n, floatingEndCnt, floating_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
+/**
+ * @brief Tree CapFloor Pricing Engine using Trinomial Tree based 2D Lattice method, for a batch of caps and floors
+ * on the same model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each instrument is
+ * rolled back through the lattice from its own end timepoint.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process1 1st dimensional stochastic process that has been initialized
+ * @param process2 2nd dimensional stochastic process that has been initialized
+ * @param numInstruments the number of instruments of the batch.
+ * @param type 0: Cap, 1: Collar, 2: Floor, per instrument
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param floatingCnt floating coupon timepoints count in initTime, of all instruments one after the other.
+ * @param floatingSize the number of floating coupon timepoints of each instrument.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param cfRate cap rate and floor rate, two per instrument
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param rho the correlation coefficient between price and variance.
+ * @param NPV is pricing result array of this engine, one per instrument
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeCapFloorBatchEngine(Model& model,
+                             Process& process1,
+                             Process& process2,
+                             int numInstruments,
+                             int* type,
+                             int timestep,
+                             DT initTime[LEN],
+                             int initSize,
+                             int* endIndex,
+                             int* floatingCnt,
+                             int* floatingSize,
+                             DT flatRate,
+                             DT nominal,
+                             DT* cfRate,
+                             DT x0,
+                             DT spread,
+                             DT rho,
+                             DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int floating_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 2, LEN2> Engine;
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process1, process2, endCnt + 1, flatRate, x0, time, dtime);
+
+    int floatingOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int floatingEndCnt = internal::treeBatchCnt(steps, floatingCnt + floatingOffset, floatingSize[n], floating_cnt);
+        floatingOffset += floatingSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], rho, initTime[endIndex[n]], nominal, cfRate + 2 * n, floatingEndCnt, floating_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
+/**
+ * @brief Tree Callable Fixed Rate Bond Pricing Engine using Trinomial Tree based 1D Lattice method, for a batch of
+ * bonds on the same model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each bond is rolled
+ * back through the lattice from its own end timepoint.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process stochastic process that has been initialized
+ * @param numInstruments the number of bonds of the batch.
+ * @param type type of the callability, 0: Call, 1: Put, per bond
+ * @param fixedRate fixed annual interest rate, per bond
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param callableCnt callable timepoints count in initTime, of all bonds one after the other.
+ * @param callableSize the number of callable timepoints of each bond.
+ * @param paymentCnt payment timepoints count in initTime, of all bonds one after the other.
+ * @param paymentSize the number of payment timepoints of each bond.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param NPV is pricing result array of this engine, one per bond
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeCallableBatchEngine(Model& model,
+                             Process& process,
+                             int numInstruments,
+                             int* type,
+                             DT* fixedRate,
+                             int timestep,
+                             DT initTime[LEN],
+                             int initSize,
+                             int* endIndex,
+                             int* callableCnt,
+                             int* callableSize,
+                             int* paymentCnt,
+                             int* paymentSize,
+                             DT flatRate,
+                             DT nominal,
+                             DT x0,
+                             DT spread,
+                             DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int callable_cnt[LEN];
+    int payment_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 3, LEN2> Engine;
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process, endCnt + 1, flatRate, x0, time, dtime);
+
+    int callableOffset = 0, paymentOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int callableEndCnt = internal::treeBatchCnt(steps, callableCnt + callableOffset, callableSize[n], callable_cnt);
+        int paymentEndCnt = internal::treeBatchCnt(steps, paymentCnt + paymentOffset, paymentSize[n], payment_cnt);
+        callableOffset += callableSize[n];
+        paymentOffset += paymentSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], nominal, nominal * fixedRate[n], callableEndCnt, paymentEndCnt, callable_cnt,
+                          payment_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
+/**
+ * @brief Tree Callable Fixed Rate Bond Pricing Engine using Trinomial Tree based 2D Lattice method, for a batch of
+ * bonds on the same model.
+ *
+ * The time grid and the lattice are built once over the union of the timepoints of the batch, then each bond is rolled
+ * back through the lattice from its own end timepoint.
+ *
+ * @tparam DT supported data type including double and float data type, which decides the precision of result.
+ * @tparam Model short-rate model class
+ * @tparam Process stochastic process class
+ * @tparam DIM 1D or 2D short-rate model
+ * @tparam LEN maximum length of timestep, which affects the latency and resources utilization.
+ * @tparam LEN2 maximum length of node of tree, which affects the latency and resources utilization.
+ *
+ * @param model short-rate model that has been initialized
+ * @param process1 1st dimensional stochastic process that has been initialized
+ * @param process2 2nd dimensional stochastic process that has been initialized
+ * @param numInstruments the number of bonds of the batch.
+ * @param type type of the callability, 0: Call, 1: Put, per bond
+ * @param fixedRate fixed annual interest rate, per bond
+ * @param timestep estimate the number of discrete steps from 0 to T, T is the last timepoint of initTime.
+ * @param initTime the union of the timepoints of all instruments of the batch, arranged from small to large and
+ * beginning with 0. The timepoints are relative values based on the reference date the unit is year.
+ * @param initSize the length of array initTime.
+ * @param endIndex index in initTime of the end timepoint of each instrument.
+ * @param callableCnt callable timepoints count in initTime, of all bonds one after the other.
+ * @param callableSize the number of callable timepoints of each bond.
+ * @param paymentCnt payment timepoints count in initTime, of all bonds one after the other.
+ * @param paymentSize the number of payment timepoints of each bond.
+ * @param flatRate floating benchmark annual interest rate
+ * @param nominal nominal principal
+ * @param x0 initial underlying
+ * @param spread spreads on interest rates
+ * @param rho the correlation coefficient between price and variance.
+ * @param NPV is pricing result array of this engine, one per bond
+ */
+template <typename DT, typename Model, typename Process, int DIM, int LEN, int LEN2>
+void treeCallableBatchEngine(Model& model,
+                             Process& process1,
+                             Process& process2,
+                             int numInstruments,
+                             int* type,
+                             DT* fixedRate,
+                             int timestep,
+                             DT initTime[LEN],
+                             int initSize,
+                             int* endIndex,
+                             int* callableCnt,
+                             int* callableSize,
+                             int* paymentCnt,
+                             int* paymentSize,
+                             DT flatRate,
+                             DT nominal,
+                             DT x0,
+                             DT spread,
+                             DT rho,
+                             DT* NPV) {
+    DT time[LEN];
+    DT dtime[LEN];
+    int steps[LEN];
+    int endCnt;
+    int callable_cnt[LEN];
+    int payment_cnt[LEN];
+
+    internal::TimeGrid<DT, LEN> grid;
+
+    DT dtMax = initTime[initSize - 1] / timestep;
+    grid.calcuGrid(initSize, initTime, dtMax, time, dtime, steps, endCnt);
+
+#ifndef __SYNTHESIS__
+    cout << "set timesteps=" << timestep << ",actual timesteps=" << endCnt + 1 << ",instruments=" << numInstruments
+         << endl;
+#endif
+
+    typedef internal::TreeInstrument<DT, 3, LEN2> Engine;
+
+    // the lattice is built once and shared by all instruments
+    xf::fintech::TreeLattice<DT, Model, Process, Engine, DIM, LEN, LEN2> lattice;
+    lattice.setup(model, process1, process2, endCnt + 1, flatRate, x0, time, dtime);
+
+    int callableOffset = 0, paymentOffset = 0;
+loop_batch:
+    for (int n = 0; n < numInstruments; n++) {
+#pragma HLS loop_tripcount min = 10 max = 10
+        int callableEndCnt = internal::treeBatchCnt(steps, callableCnt + callableOffset, callableSize[n], callable_cnt);
+        int paymentEndCnt = internal::treeBatchCnt(steps, paymentCnt + paymentOffset, paymentSize[n], payment_cnt);
+        callableOffset += callableSize[n];
+        paymentOffset += paymentSize[n];
+
+        Engine engine;
+        engine.initialize(type[n], rho, nominal, nominal * fixedRate[n], callableEndCnt, paymentEndCnt, callable_cnt,
+                          payment_cnt);
+
+        lattice.rollback(model, engine, steps[endIndex[n]], time, dtime, NPV + n);
+    }
+}
+
 } // fintech
 } // xf
 
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file bs_iv_wrapper.cpp
+ * @brief HLS wrapper for the implied volatility engine which parallelizes the
+ * single quote solver
+ */
+
+#include <cmath>
+#include <iostream>
+#include "ap_fixed.h"
+#include "hls_math.h"
+#include "bs_iv_wrapper.hpp"
+#include "xf_fintech/cf_bsm.hpp"
+
+#define NUM_PARALLEL 4
+#define NUM_ITERATIONS 4
+
+extern "C" {
+
+/// @brief Wraps the implied volatility solver to allow parallel processing of
+/// NUM_PARALLEL quotes per cycle.
+///
+/// @param[in]  s_in   Underlying prices
+/// @param[in]  p_in   Option premia
+/// @param[in]  r_in   Risk-free rates (decimal form)
+/// @param[in]  t_in   Times to maturity
+/// @param[in]  k_in   Strike prices
+/// @param[in]  call   Controls whether the premia are calls or puts
+/// @param[in]  num    Total number of quotes to process
+/// @param[out] iv_out Implied volatilities (decimal form)
+void bs_iv_wrapper(float* s_in,
+                   float* p_in,
+                   float* r_in,
+                   float* t_in,
+                   float* k_in,
+                   unsigned int call,
+                   unsigned int num,
+                   float* iv_out) {
+#pragma HLS INTERFACE m_axi port = s_in offset = slave bundle = d0_port
+#pragma HLS INTERFACE m_axi port = p_in offset = slave bundle = d1_port
+#pragma HLS INTERFACE m_axi port = r_in offset = slave bundle = d2_port
+#pragma HLS INTERFACE m_axi port = t_in offset = slave bundle = d3_port
+#pragma HLS INTERFACE m_axi port = k_in offset = slave bundle = d4_port
+#pragma HLS INTERFACE m_axi port = iv_out offset = slave bundle = d5_port
+
+#pragma HLS INTERFACE s_axilite port = s_in bundle = control
+#pragma HLS INTERFACE s_axilite port = p_in bundle = control
+#pragma HLS INTERFACE s_axilite port = r_in bundle = control
+#pragma HLS INTERFACE s_axilite port = t_in bundle = control
+#pragma HLS INTERFACE s_axilite port = k_in bundle = control
+#pragma HLS INTERFACE s_axilite port = iv_out bundle = control
+
+#pragma HLS INTERFACE s_axilite port = call bundle = control
+#pragma HLS INTERFACE s_axilite port = num bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+quote_loop:
+    for (unsigned int n = 0; n < num; n += NUM_PARALLEL) {
+#pragma HLS PIPELINE II = 1
+        for (unsigned int j = 0; j < NUM_PARALLEL; ++j) {
+#pragma HLS UNROLL
+            // Engine used with fixed q=0 as per original BS model
+            xf::fintech::cfBSMImpliedVolatilityEngine<float, NUM_ITERATIONS>(
+                s_in[n + j], p_in[n + j], r_in[n + j], t_in[n + j], k_in[n + j], 0, call, &iv_out[n + j]);
+        }
+    }
+}
+
+} // extern "C"
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file bs_iv_wrapper.hpp
+ * @brief Declaration of wrapper for testbench
+ */
+
+#ifndef XF_FINTECH_BS_IV_WRAPPER_H
+#define XF_FINTECH_BS_IV_WRAPPER_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void bs_iv_wrapper(float* s_in,
+                   float* p_in,
+                   float* r_in,
+                   float* t_in,
+                   float* k_in,
+                   unsigned int call,
+                   unsigned int num,
+                   float* iv_out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
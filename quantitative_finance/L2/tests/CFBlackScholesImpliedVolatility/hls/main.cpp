@@ -0,0 +1,110 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file main.cpp
+ * @brief HLS unit test of wrapped implied volatility solver
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "bs_iv_wrapper.hpp"
+
+/// @brief Standard calculation of Normal CDF
+///
+/// @param[in] x variable
+/// @returns   Normal CDF of input variable
+double normalCDF(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+/// @brief Reference Black-Scholes premium with q=0
+///
+/// @param[in] s    underlying
+/// @param[in] v    volatility (decimal form)
+/// @param[in] r    risk-free rate (decimal form)
+/// @param[in] t    time to maturity
+/// @param[in] k    strike price
+/// @param[in] call control whether call or put is calculated
+/// @returns   call/put premium
+double bsRef(double s, double v, double r, double t, double k, unsigned int call) {
+    double d1 = (std::log(s / k) + (r + v * v / 2.0) * t) / (v * std::sqrt(t));
+    double d2 = d1 - v * std::sqrt(t);
+    if (call) {
+        return s * normalCDF(d1) - k * normalCDF(d2) * std::exp(-r * t);
+    } else {
+        return k * normalCDF(-d2) * std::exp(-r * t) - s * normalCDF(-d1);
+    }
+}
+
+/// @brief     Simple helper to return a float within a range
+/// @param[in] range_min Lower bound of random value
+/// @param[in] range_max Upper bound of random value
+/// @returns   Random double in range range_min to range_max
+double random_range(double range_min, double range_max) {
+    return range_min + (rand() / (RAND_MAX / (range_max - range_min)));
+}
+
+/// @brief Main entry point to test
+///
+/// This is a command-line application to test the kernel.  This should not be
+/// run manually, instead it is used as part of the HLS unit test.
+///
+int main(int argc, char** argv) {
+    const unsigned int num = 128;
+    const double tolerance = 1e-3;
+    // Premia below this carry too little time value to identify the volatility
+    // in single precision
+    const double min_premium = 0.01;
+
+    float s[num], p[num], r[num], t[num], k[num], v[num], iv[num];
+
+    int nerr = 0;
+    for (unsigned int call = 0; call < 2; call++) {
+        // Generate quotes from known volatilities
+        for (unsigned int i = 0; i < num; i++) {
+            s[i] = random_range(50, 150);
+            v[i] = random_range(0.1, 1.0);
+            r[i] = random_range(0.001, 0.2);
+            t[i] = random_range(0.5, 3);
+            // Keep strikes near the money so the premia carry enough time value
+            k[i] = s[i] * random_range(0.7, 1.3);
+            p[i] = bsRef(s[i], v[i], r[i], t[i], k[i], call);
+        }
+
+        bs_iv_wrapper(s, p, r, t, k, call, num, iv);
+
+        // Compare recovered volatilities to those used for pricing
+        double max_diff = 0.0;
+        unsigned int skipped = 0;
+        for (unsigned int i = 0; i < num; i++) {
+            if (p[i] < min_premium) {
+                skipped++;
+                continue;
+            }
+            double diff = iv[i] - v[i];
+            if (std::abs(diff) > std::abs(max_diff)) max_diff = diff;
+            if (std::abs(diff) > tolerance) nerr++;
+        }
+        std::cout << "Tested " << num << (call ? " call" : " put")
+                  << " quotes (" << skipped << " skipped), worst case volatility difference is " << max_diff
+                  << std::endl;
+    }
+
+    return nerr;
+}
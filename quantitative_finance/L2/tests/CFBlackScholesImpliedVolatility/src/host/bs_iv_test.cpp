@@ -0,0 +1,206 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+* @file bs_iv_test.cpp
+* @brief Testbench to generate randomized premia and launch the implied
+* volatility kernel. Recovered volatilities are compared to those used to
+* generate the premia with a full precision model.
+*/
+
+#include <stdio.h>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "bsm_model.hpp"
+#include "xcl2.hpp"
+
+/// @def Controls the data type used in the kernel
+#define KERNEL_DT float
+
+// Temporary copy of this macro definition until new xcl2.hpp is used
+#define OCL_CHECK(error, call)                                                                   \
+    call;                                                                                        \
+    if (error != CL_SUCCESS) {                                                                   \
+        printf("%s:%d Error calling " #call ", error code is: %d\n", __FILE__, __LINE__, error); \
+        exit(EXIT_FAILURE);                                                                      \
+    }
+
+/// @brief Main entry point to test
+///
+/// This is a command-line application to test the kernel.  It supports software
+/// and hardware emulation as well as
+/// running on an Alveo target.
+///
+/// Usage: ./bs_iv_test ./xclbin/<kernel_name> <number of quotes>
+///
+/// @param[in] argc Standard C++ argument count
+/// @param[in] argv Standard C++ input arguments
+int main(int argc, char* argv[]) {
+    std::cout << std::endl << std::endl;
+    std::cout << "***************" << std::endl;
+    std::cout << "BS IV Demo v1.0" << std::endl;
+    std::cout << "***************" << std::endl;
+    std::cout << std::endl;
+
+    // Test parameters
+    static const unsigned int call = 1;
+    static const double tolerance = 1e-3;
+    // Premia below this carry too little time value to identify the volatility
+    // in single precision
+    static const double min_premium = 0.01;
+
+    unsigned int argIdx = 1;
+    std::string xclbin_file(argv[argIdx++]);
+    unsigned int num = std::atoi(argv[argIdx++]);
+
+    // Vectors for parameter storage.  These use an aligned allocator in order
+    // to avoid an additional copy of the host memory into the device
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > s(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > p(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > r(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > t(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > k(num);
+    std::vector<KERNEL_DT, aligned_allocator<KERNEL_DT> > iv(num);
+
+    // Host reference volatilities (always double precision)
+    double* host_v = new double[num];
+
+    // Generate randomized data and reference premia
+    std::cout << "Generating randomized data and reference premia..." << std::endl;
+    for (unsigned int i = 0; i < num; i++) {
+        double s_temp = random_range(50, 150);
+        double v_temp = random_range(0.1, 1.0);
+        double r_temp = random_range(0.001, 0.2);
+        double t_temp = random_range(0.5, 3);
+        // Keep strikes near the money so the premia carry enough time value
+        double k_temp = s_temp * random_range(0.7, 1.3);
+        double price, delta, gamma, vega, theta, rho;
+
+        // Use full Black-Scholes-Merton model with fixed q=0
+        bsm_model(s_temp, v_temp, r_temp, t_temp, k_temp, 0, call, price, delta, gamma, vega, theta, rho);
+
+        s[i] = s_temp;
+        p[i] = price;
+        r[i] = r_temp;
+        t[i] = t_temp;
+        k[i] = k_temp;
+        host_v[i] = v_temp;
+    }
+
+    // OPENCL HOST CODE AREA START
+    // get_xil_devices() is a utility API which will find the xilinx
+    // platforms and will return list of devices connected to Xilinx platform
+    std::cout << "Connecting to device and loading kernel..." << std::endl;
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+    cl_int err;
+
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+
+    // Load the binary file (using function from xcl2.cpp)
+    cl::Program::Binaries bins = xcl::import_binary_file(xclbin_file);
+
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+    OCL_CHECK(err, cl::Kernel krnl_cfBSIVEngine(program, "bs_iv_kernel", &err));
+
+    // Allocate Buffer in Global Memory
+    // Buffers are allocated using CL_MEM_USE_HOST_PTR for efficient memory and
+    // Device-to-host communication
+    std::cout << "Allocating buffers..." << std::endl;
+    OCL_CHECK(err, cl::Buffer buffer_s(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       s.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_p(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       p.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_r(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       r.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_t(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       t.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_k(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, num * sizeof(KERNEL_DT),
+                                       k.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_iv(context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, num * sizeof(KERNEL_DT),
+                                        iv.data(), &err));
+
+    // Set the arguments
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(0, buffer_s));
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(1, buffer_p));
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(2, buffer_r));
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(3, buffer_t));
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(4, buffer_k));
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(5, call));
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(6, num));
+    OCL_CHECK(err, err = krnl_cfBSIVEngine.setArg(7, buffer_iv));
+
+    // Copy input data to device global memory
+    OCL_CHECK(err, err = q.enqueueMigrateMemObjects({buffer_s, buffer_p, buffer_r, buffer_t, buffer_k}, 0));
+
+    // Launch the Kernel
+    std::cout << "Launching kernel..." << std::endl;
+    uint64_t nstimestart, nstimeend;
+    cl::Event event;
+    OCL_CHECK(err, err = q.enqueueTask(krnl_cfBSIVEngine, NULL, &event));
+    OCL_CHECK(err, err = q.finish());
+    OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_START, &nstimestart));
+    OCL_CHECK(err, err = event.getProfilingInfo<uint64_t>(CL_PROFILING_COMMAND_END, &nstimeend));
+    auto duration_nanosec = nstimeend - nstimestart;
+    std::cout << "  Duration returned by profile API is " << (duration_nanosec * (1.0e-6)) << " ms **** " << std::endl;
+
+    // Copy Result from Device Global Memory to Host Local Memory
+    OCL_CHECK(err, err = q.enqueueMigrateMemObjects({buffer_iv}, CL_MIGRATE_MEM_OBJECT_HOST));
+    q.finish();
+    // OPENCL HOST CODE AREA END
+
+    // Check results
+    double max_iv_diff = 0.0f;
+    unsigned int num_fail = 0;
+    unsigned int num_skip = 0;
+
+    for (unsigned int i = 0; i < num; i++) {
+        if (p[i] < min_premium) {
+            num_skip++;
+            continue;
+        }
+        double temp = iv[i] - host_v[i];
+        if (std::abs(temp) > std::abs(max_iv_diff)) max_iv_diff = temp;
+        if (std::abs(temp) > tolerance) num_fail++;
+    }
+
+    std::cout << "Kernel done!" << std::endl;
+    std::cout << "Comparing results..." << std::endl;
+    std::cout << "Processed " << num;
+    if (call) {
+        std::cout << " call quotes:" << std::endl;
+    } else {
+        std::cout << " put quotes:" << std::endl;
+    }
+    std::cout << "Throughput = " << (1.0 * num) / (duration_nanosec * 1.0e-9) / 1.0e6 << " Mega quotes/sec"
+              << std::endl;
+
+    std::cout << std::endl;
+    std::cout << "  Largest host-kernel volatility difference = " << max_iv_diff << std::endl;
+    std::cout << "  Quotes skipped with premium below " << min_premium << " = " << num_skip << std::endl;
+    std::cout << "  Quotes outside tolerance " << tolerance << " = " << num_fail << std::endl;
+
+    delete[] host_v;
+
+    return (num_fail == 0) ? 0 : 1;
+}
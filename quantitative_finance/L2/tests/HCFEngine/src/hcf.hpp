@@ -20,5 +20,6 @@
 #include "xf_fintech/hcf_engine.hpp"
 
 #define MAX_NUMBER_TESTS (1024)
+#define MAX_NUMBER_STRIKES (1024)
 
 #endif
@@ -42,6 +42,7 @@ static int run_cpu = 0;
 static int gen_csv = 0;
 static int display_results = 0;
 static int check_expected_values = 0;
+static int num_strikes = 0;
 static std::string binaryFile = "";
 
 int check_value(TEST_DT act, TEST_DT exp, TEST_DT tolerance, TEST_DT* diff) {
@@ -53,13 +54,14 @@ int check_value(TEST_DT act, TEST_DT exp, TEST_DT tolerance, TEST_DT* diff) {
 }
 
 void usage(char* name) {
-    std::cout << name << " [-f<test file> -d<dw> -w<w_max> -t<tolerance> -c -v -o -e -h]" << std::endl;
+    std::cout << name << " [-f<test file> -d<dw> -w<w_max> -t<tolerance> -s<strikes> -c -v -o -e -h]" << std::endl;
     std::cout << "dw is the integral increment (default 0.5)" << std::endl;
     std::cout << "w_max is the integration limit (default 200)" << std::endl;
     std::cout << "-c run the CPU calculation" << std::endl;
     std::cout << "-o produce csv output file" << std::endl;
     std::cout << "-v display the results" << std::endl;
     std::cout << "-e check expected values" << std::endl;
+    std::cout << "-s price a strip of that many strikes on the model of the first test" << std::endl;
 }
 
 void generate_csv(std::string file,
@@ -103,7 +105,7 @@ int deal_with_cmd_line_args(int argc, char** argv) {
     int opt = 0;
     int b_set = 0;
     try {
-        while ((opt = getopt(argc, argv, "f:d:w:t:b:cvhoe")) != -1) {
+        while ((opt = getopt(argc, argv, "f:d:w:t:b:s:cvhoe")) != -1) {
             switch (opt) {
                 case 'f':
                     file = std::string(optarg);
@@ -121,6 +123,9 @@ int deal_with_cmd_line_args(int argc, char** argv) {
                     binaryFile = std::string(optarg);
                     b_set = 1;
                     break;
+                case 's':
+                    num_strikes = atoi(optarg);
+                    break;
                 case 'c':
                     run_cpu = 1;
                     break;
@@ -335,5 +340,66 @@ int main(int argc, char** argv) {
         generate_csv(file, input_data.data(), output_data.data(), num_tests);
     }
 
+    //------------------------------ STRIP ---------------------------------
+    if (num_strikes > 0) {
+        if (num_strikes > MAX_NUMBER_STRIKES) {
+            std::cout << "ERROR: too many strikes, max=: " << MAX_NUMBER_STRIKES << std::endl;
+            return 1;
+        }
+
+        // strikes from 50% to 150% of the strike of the first test, all on its model
+        std::vector<struct xf::fintech::hcfEngineInputDataType<TEST_DT>,
+                    aligned_allocator<struct xf::fintech::hcfEngineInputDataType<TEST_DT> > >
+            strip_in(num_strikes, input_data[0]);
+        std::vector<TEST_DT, aligned_allocator<TEST_DT> > strikes(num_strikes);
+        std::vector<TEST_DT, aligned_allocator<TEST_DT> > strip_out(num_strikes);
+        for (int i = 0; i < num_strikes; i++) {
+            strikes[i] = input_data[0].K * (0.5 + (TEST_DT)i / num_strikes);
+            strip_in[i].K = strikes[i];
+        }
+
+        cl::Kernel strip_krnl(program, "hcf_strip_kernel");
+        cl::Buffer dev_strip_in(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                sizeof(struct xf::fintech::hcfEngineInputDataType<TEST_DT>), strip_in.data());
+        cl::Buffer dev_strikes(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, sizeof(TEST_DT) * num_strikes,
+                               strikes.data());
+        cl::Buffer dev_strip_out(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, sizeof(TEST_DT) * num_strikes,
+                                 strip_out.data());
+        cq.enqueueMigrateMemObjects({dev_strip_in, dev_strikes}, 0);
+        cq.finish();
+
+        strip_krnl.setArg(0, dev_strip_in);
+        strip_krnl.setArg(1, dev_strikes);
+        strip_krnl.setArg(2, dev_strip_out);
+        strip_krnl.setArg(3, num_strikes);
+
+        t_start = std::chrono::high_resolution_clock::now();
+        cq.enqueueTask(strip_krnl, NULL, NULL);
+        cq.finish();
+        duration =
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - t_start)
+                .count();
+        std::cout << std::setw(40) << std::left << "FPGA strip time"
+                  << "= " << duration << "us (" << num_strikes << " strikes)" << std::endl;
+
+        cq.enqueueMigrateMemObjects({dev_strip_out}, CL_MIGRATE_MEM_OBJECT_HOST);
+        cq.finish();
+
+        // the strip integrates exactly as one option per strike does
+        std::vector<TEST_DT> strip_cpu(num_strikes);
+        call_price(strip_in, num_strikes, strip_cpu.data());
+        int strip_fails = 0;
+        for (int i = 0; i < num_strikes; i++) {
+            TEST_DT diff;
+            if (!check_value(strip_out[i], strip_cpu[i], tol, &diff)) {
+                strip_fails++;
+                display_test_parameters(&strip_in[i]);
+                std::cout << "    ERROR: FPGA Strip Price = " << strip_out[i] << std::endl;
+                std::cout << "    ERROR: CPU Price        = " << strip_cpu[i] << std::endl;
+            }
+        }
+        std::cout << "Total Strip Fails = " << strip_fails << std::endl;
+    }
+
     return 0;
 }
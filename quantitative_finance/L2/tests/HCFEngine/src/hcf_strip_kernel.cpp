@@ -0,0 +1,54 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "hcf.hpp"
+
+extern "C" {
+
+void hcf_strip_kernel(struct xf::fintech::hcfEngineInputDataType<TEST_DT>* in,
+                      TEST_DT* strikes,
+                      TEST_DT* out,
+                      int num_strikes) {
+#pragma HLS INTERFACE m_axi port = in offset = slave bundle = gmem_0
+#pragma HLS INTERFACE m_axi port = strikes offset = slave bundle = gmem_0
+#pragma HLS INTERFACE m_axi port = out offset = slave bundle = gmem_1
+#pragma HLS INTERFACE s_axilite port = in bundle = control
+#pragma HLS INTERFACE s_axilite port = strikes bundle = control
+#pragma HLS INTERFACE s_axilite port = out bundle = control
+#pragma HLS INTERFACE s_axilite port = num_strikes bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+#pragma HLS DATA_PACK variable = in
+
+    /* copy the model and the strikes from global memory to local memory */
+    struct xf::fintech::hcfEngineInputDataType<TEST_DT> local_in = in[0];
+    TEST_DT local_strikes[MAX_NUMBER_STRIKES];
+    TEST_DT local_out[MAX_NUMBER_STRIKES];
+    for (int i = 0; i < num_strikes; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 512 max = 512 avg = 512
+        local_strikes[i] = strikes[i];
+    }
+
+    /* calculate the call values of the whole strip */
+    xf::fintech::hcfEngineStrip<TEST_DT, MAX_NUMBER_STRIKES>(&local_in, local_strikes, num_strikes, local_out);
+
+    /* copy the results from local mem to global mem */
+    for (int i = 0; i < num_strikes; i++) {
+#pragma HLS LOOP_TRIPCOUNT min = 512 max = 512 avg = 512
+        out[i] = local_out[i];
+    }
+}
+
+} // extern C
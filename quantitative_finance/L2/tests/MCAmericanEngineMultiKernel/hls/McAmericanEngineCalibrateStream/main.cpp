@@ -0,0 +1,136 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <iostream>
+#include "kernel_4_top.hpp"
+
+typedef ap_uint<sizeof(TEST_DT) * 8 * COEFNM> coef_t;
+
+// largest relative difference between two sets of coefficients
+TEST_DT coefDiff(coef_t* a, coef_t* b, unsigned int timeSteps) {
+    TEST_DT maxDiff = 0;
+    for (unsigned int i = 0; i < timeSteps - 1; ++i) {
+        for (int k = 0; k < COEFNM; ++k) {
+            int64_t ia = a[i].range((k + 1) * 64 - 1, k * 64);
+            int64_t ib = b[i].range((k + 1) * 64 - 1, k * 64);
+            TEST_DT da = xf::fintech::internal::bitsToDouble(ia);
+            TEST_DT db = xf::fintech::internal::bitsToDouble(ib);
+            TEST_DT diff = std::fabs(da - db) / std::fmax(std::fabs(db), 1e-300);
+            if (diff > maxDiff) maxDiff = diff;
+        }
+    }
+    return maxDiff;
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    unsigned int timeSteps = 100;
+    // readin_ddr in MCAmericanEngineCalibrate indexes the blocks of paths with 16 bits, so the on-chip
+    // reference only reads several blocks correctly for up to 63 steps
+    unsigned int cmpSteps = 50;
+    // note the number the seed used here should be equal to the unroll number UN
+    ap_uint<32> seed0[2] = {1234, 3456};
+    ap_uint<32> seed2[4] = {1234, 3456, 5678, 7890};
+    TEST_DT requiredTolerance = 0.02;
+    TEST_DT underlying = 36;
+    TEST_DT riskFreeRate = 0.06;
+    TEST_DT volatility = 0.20;
+    TEST_DT dividendYield = 0.0;
+    TEST_DT strike = 40;
+    bool optionType = 1;
+    TEST_DT timeLength = 1;
+
+    unsigned int requiredSamples = 24576;
+    // 3 blocks of 1024 paths per unroll: fits on chip, and takes 3 chunks in kernel_4_top
+    unsigned int calibSamples = 3 * 1024 * UN;
+    // more paths than MCAmericanEngineCalibrate can hold on chip
+    unsigned int bigCalibSamples = iteration * 1024 * UN;
+    if (!run_csim) {
+        timeSteps = 10;
+        cmpSteps = 10;
+        requiredSamples = UN * 1024;
+    }
+
+    ap_uint<UN * sizeof(double) * 8>* pOut = new ap_uint<UN * sizeof(double) * 8>[depthP];
+    ap_uint<UN * sizeof(double) * 8>* flowBuff = new ap_uint<UN * sizeof(double) * 8>[depthF];
+    ap_uint<sizeof(double) * 8> mOut[depthM];
+    coef_t coefRef[COEF_DEPTH];
+    coef_t coefOne[COEF_DEPTH];
+    coef_t coefTwo[COEF_DEPTH];
+    coef_t coefOut[COEF_DEPTH];
+    TEST_DT outputs[1];
+    int nerr = 0;
+
+    xf::fintech::MCAmericanEnginePreSamples<TEST_DT, UN>(underlying, volatility, riskFreeRate, dividendYield,
+                                                         timeLength, strike, optionType, seed0, pOut, mOut,
+                                                         calibSamples, cmpSteps);
+
+    // reference: all the calibration paths on chip
+    xf::fintech::MCAmericanEngineCalibrate<TEST_DT, UN, 2>(timeLength, riskFreeRate, strike, optionType, pOut, mOut,
+                                                          coefRef, calibSamples, cmpSteps);
+    // one chunk holds all the paths, the coefficients are the same as on chip
+    xf::fintech::MCAmericanEngineCalibrateStream<TEST_DT, UN, 2>(timeLength, riskFreeRate, strike, optionType, pOut,
+                                                                mOut, flowBuff, coefOne, calibSamples, cmpSteps);
+    // a full chunk of 2 blocks and a partial chunk of 1 block
+    xf::fintech::MCAmericanEngineCalibrateStream<TEST_DT, UN, 2, 2048>(
+        timeLength, riskFreeRate, strike, optionType, pOut, mOut, flowBuff, coefTwo, calibSamples, cmpSteps);
+    // one chunk per block
+    kernel_4_top(timeLength, riskFreeRate, strike, optionType, pOut, mOut, flowBuff, coefOut, calibSamples, cmpSteps);
+
+    // the chunks only change the order of the A^T*y sums
+    TEST_DT diffOne = coefDiff(coefOne, coefRef, cmpSteps);
+    TEST_DT diffTwo = coefDiff(coefTwo, coefRef, cmpSteps);
+    TEST_DT diffOut = coefDiff(coefOut, coefRef, cmpSteps);
+    std::cout << "coef diff, 1 chunk: " << diffOne << ", 2 chunks: " << diffTwo << ", 3 chunks: " << diffOut
+              << std::endl;
+    if (diffOne != 0) {
+        std::cout << "FAILURE!!! one chunk differs from on-chip calibration!" << std::endl;
+        nerr++;
+    }
+    if (diffTwo > 1e-9 || diffOut > 1e-9) {
+        std::cout << "FAILURE!!! chunked calibration differs from on-chip calibration!" << std::endl;
+        nerr++;
+    }
+
+    if (run_csim) {
+        // calibrate with more paths than fit on chip and price with the coefficients
+        xf::fintech::MCAmericanEnginePreSamples<TEST_DT, UN>(underlying, volatility, riskFreeRate, dividendYield,
+                                                             timeLength, strike, optionType, seed0, pOut, mOut,
+                                                             bigCalibSamples, timeSteps);
+        kernel_4_top(timeLength, riskFreeRate, strike, optionType, pOut, mOut, flowBuff, coefOut, bigCalibSamples,
+                     timeSteps);
+        xf::fintech::MCAmericanEnginePricing(underlying, volatility, dividendYield, riskFreeRate, timeLength, strike,
+                                             optionType, seed2, coefOut, outputs, requiredTolerance, requiredSamples,
+                                             timeSteps);
+        std::cout << "output =" << outputs[0] << std::endl;
+
+        // reference value: 4.478, the finite difference price of Longstaff & Schwartz (2001), table 1
+        double golden_output = 4.478;
+        double diff = std::fabs(outputs[0] - golden_output);
+        if (diff > 0.05) {
+            std::cout << "FAILURE!!! incorrect ouput value calculated!" << std::endl;
+            nerr++;
+        }
+    }
+    delete[] pOut;
+    delete[] flowBuff;
+    return nerr ? -1 : 0;
+}
@@ -29,6 +29,7 @@ typedef double TEST_DT;
 #define iteration 4
 #define depthP 1024 * TIMESTEPS* iteration
 #define depthM 9 * TIMESTEPS
+#define depthF 1024 * iteration
 #define SZ 8 * sizeof(TEST_DT)
 #define COEF_DEPTH 1024
 
@@ -79,4 +80,15 @@ extern "C" void MCAE_k3(TEST_DT underlying,
                         TEST_DT requiredTolerance,
                         unsigned int requiredSamples,
                         unsigned int timeSteps);
+
+extern "C" void MCAE_k4(TEST_DT timeLength,
+                        TEST_DT riskFreeRate,
+                        TEST_DT strike,
+                        int optionType,
+                        ap_uint<8 * sizeof(TEST_DT) * UN_K2_PATH> priceIn[depthP],
+                        ap_uint<8 * sizeof(TEST_DT)> matIn[depthM],
+                        ap_uint<8 * sizeof(TEST_DT) * UN_K2_PATH> flowBuff[depthF],
+                        ap_uint<8 * sizeof(TEST_DT) * COEF> coefOut[COEF_DEPTH],
+                        unsigned int calibSamples,
+                        unsigned int timeSteps);
 #endif
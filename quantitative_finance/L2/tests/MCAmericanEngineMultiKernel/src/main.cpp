@@ -224,6 +224,11 @@ int main(int argc, const char* argv[]) {
             timeSteps);
     MCAE_k2(underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, optionType, coef_b, output_b,
             requiredTolerance, requiredSamples, timeSteps);
+    std::cout << "out_price = " << output_b[0] << std::endl;
+    if (std::fabs(output_b[0] - golden_output) > requiredTolerance) {
+        std::cout << "Output is wrong!" << std::endl;
+        return -1;
+    }
 #else
     struct timeval start_time, end_time;
     // platform related operations
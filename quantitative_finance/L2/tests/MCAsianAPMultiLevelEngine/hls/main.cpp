@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <cmath>
+#include <iostream>
+#include "mc_asian_ml_k.hpp"
+
+int main(int argc, char* argv[]) {
+    // model parameter
+    TEST_DT underlying = 100;
+    TEST_DT volatility = 0.20;
+    TEST_DT dividendYield = 0.0;
+    TEST_DT riskFreeRate = 0.05;
+    // option parameter
+    TEST_DT timeLength = 1.0;
+    TEST_DT strike = 100;
+    unsigned int optionType = 0;
+    // continuously averaged price, from a multilevel run with RMSE 0.0025
+    TEST_DT golden = 5.761;
+
+    TEST_DT requiredRMSE = 0.02;
+    unsigned int baseSteps = 4;
+    unsigned int maxSamples = 134217727;
+    ap_uint<32> seed[2] = {1, 10001};
+    TEST_DT output[1];
+
+    mc_asian_ml_k(underlying, volatility, dividendYield,
+                  riskFreeRate, // model parameter
+                  timeLength, strike,
+                  optionType, // option parameter
+                  seed, output, requiredRMSE, baseSteps, maxSamples);
+
+    TEST_DT diff = std::fabs(output[0] - golden);
+    std::cout << "price " << output[0] << ", golden " << golden << std::endl;
+    if (diff > 3 * requiredRMSE) {
+        std::cout << "Output is wrong! error: " << diff << ", tolerance: " << 3 * requiredRMSE << std::endl;
+        return 1;
+    }
+
+    // a cap on the samples which is not a whole number of batches, the levels stop at the last whole batch
+    unsigned int cappedSamples = 10000;
+    TEST_DT cappedTolerance = 0.3;
+    mc_asian_ml_k(underlying, volatility, dividendYield,
+                  riskFreeRate, // model parameter
+                  timeLength, strike,
+                  optionType, // option parameter
+                  seed, output, requiredRMSE, baseSteps, cappedSamples);
+
+    diff = std::fabs(output[0] - golden);
+    std::cout << "capped price " << output[0] << ", golden " << golden << std::endl;
+    if (diff > cappedTolerance) {
+        std::cout << "Capped output is wrong! error: " << diff << ", tolerance: " << cappedTolerance << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xcl2.hpp"
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "mc_asian_ml_k.hpp"
+
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+int main(int argc, const char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string xclbin_path;
+    std::string mode_emu = "hw";
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    if (std::getenv("XCL_EMULATION_MODE") != nullptr) {
+        mode_emu = std::getenv("XCL_EMULATION_MODE");
+    }
+    std::cout << "[INFO]Running in " << mode_emu << " mode" << std::endl;
+
+    // model parameter
+    TEST_DT underlying = 100;
+    TEST_DT volatility = 0.20;
+    TEST_DT dividendYield = 0.0;
+    TEST_DT riskFreeRate = 0.05;
+    // option parameter
+    TEST_DT timeLength = 1.0;
+    TEST_DT strike = 100;
+    unsigned int optionType = 0;
+    // continuously averaged price, from a multilevel run with RMSE 0.0025
+    TEST_DT golden = 5.761;
+
+    TEST_DT requiredRMSE = 0.02;
+    unsigned int baseSteps = 4;
+    unsigned int maxSamples = 134217727;
+    if (mode_emu.compare("hw_emu") == 0) {
+        requiredRMSE = 0.5;
+        maxSamples = 2048;
+    }
+
+    // Allocate Memory in Host Memory
+    TEST_DT* outputs = aligned_alloc<TEST_DT>(1);
+    unsigned int* seed = aligned_alloc<unsigned int>(2);
+    seed[0] = 1;
+    seed[1] = 10001;
+
+    struct timeval start_time, end_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_Engine(program, "mc_asian_ml_k");
+    std::cout << "kernel has been created" << std::endl;
+
+#ifndef USE_HBM
+    unsigned int bank = XCL_MEM_DDR_BANK0;
+#else
+    unsigned int bank = XCL_BANK0;
+#endif
+    cl_mem_ext_ptr_t mext_o[2];
+    mext_o[0] = {bank, outputs, 0};
+    mext_o[1] = {bank, seed, 0};
+
+    // create device buffer and map dev buf to host buf
+    cl::Buffer output_buf(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, sizeof(TEST_DT),
+                          &mext_o[0]);
+    cl::Buffer seed_buf(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                        sizeof(unsigned int) * 2, &mext_o[1]);
+
+    std::vector<cl::Memory> ob_in;
+    ob_in.push_back(seed_buf);
+    std::vector<cl::Memory> ob_out;
+    ob_out.push_back(output_buf);
+
+    int j = 0;
+    kernel_Engine.setArg(j++, underlying);
+    kernel_Engine.setArg(j++, volatility);
+    kernel_Engine.setArg(j++, dividendYield);
+    kernel_Engine.setArg(j++, riskFreeRate);
+    kernel_Engine.setArg(j++, timeLength);
+    kernel_Engine.setArg(j++, strike);
+    kernel_Engine.setArg(j++, optionType);
+    kernel_Engine.setArg(j++, seed_buf);
+    kernel_Engine.setArg(j++, output_buf);
+    kernel_Engine.setArg(j++, requiredRMSE);
+    kernel_Engine.setArg(j++, baseSteps);
+    kernel_Engine.setArg(j++, maxSamples);
+
+    q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+    q.finish();
+
+    // launch kernel and calculate kernel execution time
+    std::cout << "kernel start------" << std::endl;
+    gettimeofday(&start_time, 0);
+    q.enqueueTask(kernel_Engine, nullptr, nullptr);
+    q.finish();
+    gettimeofday(&end_time, 0);
+    std::cout << "kernel end------" << std::endl;
+    std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us" << std::endl;
+
+    q.enqueueMigrateMemObjects(ob_out, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+    q.finish();
+
+    // compare with golden result, within 3 times of the required RMSE
+    TEST_DT diff = std::fabs(outputs[0] - golden);
+    std::cout << "Acutal value: " << outputs[0] << ", Expected value: " << golden << std::endl;
+    if (diff > 3 * requiredRMSE) {
+        std::cout << "Output is wrong!" << std::endl;
+        std::cout << "error: " << diff << ", tolerance: " << 3 * requiredRMSE << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -32,3 +32,20 @@ void MCAsian_Geometric_AV_Price_Engine_top(unsigned int timeSteps,
                                                       strike, optionType, seed, outputs, requiredTolerance,
                                                       requiredSamples, timeSteps, maxSamples);
 }
+void MCAsian_Geometric_AV_Price_Engine_LD_top(unsigned int timeSteps,
+                                              TEST_DT timeLength,
+                                              TEST_DT strike,
+                                              TEST_DT volatility,
+                                              TEST_DT underlying,
+                                              TEST_DT riskFreeRate,
+                                              TEST_DT dividendYield,
+                                              unsigned int requiredSamples,
+                                              unsigned int maxSamples,
+                                              TEST_DT requiredTolerance,
+                                              bool optionType,
+                                              ap_uint<32> seed[4],
+                                              TEST_DT outputs[1]) {
+    xf::fintech::MCAsianGeometricAPEngine<TEST_DT, 4, xf::fintech::LowDiscrepancy>(
+        underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, optionType, seed, outputs,
+        requiredTolerance, requiredSamples, timeSteps, maxSamples);
+}
@@ -33,5 +33,19 @@ void MCAsian_Geometric_AV_Price_Engine_top(unsigned int timeSteps,
                                            bool optionType,
                                            ap_uint<32> seed[4],
                                            TEST_DT outputs[1]);
+// as above with the Sobol and Brownian bridge sequence, C simulation only
+void MCAsian_Geometric_AV_Price_Engine_LD_top(unsigned int timeSteps,
+                                              TEST_DT timeLength,
+                                              TEST_DT strike,
+                                              TEST_DT volatility,
+                                              TEST_DT underlying,
+                                              TEST_DT riskFreeRate,
+                                              TEST_DT dividendYield,
+                                              unsigned int requiredSamples,
+                                              unsigned int maxSamples,
+                                              TEST_DT requiredTolerance,
+                                              bool optionType,
+                                              ap_uint<32> seed[4],
+                                              TEST_DT outputs[1]);
 
 #endif
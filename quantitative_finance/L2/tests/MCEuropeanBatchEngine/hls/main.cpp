@@ -0,0 +1,91 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <iostream>
+#include "mc_euro_batch_k.hpp"
+
+// closed form Black-Scholes price used as golden reference
+static double cndf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+static double bsPrice(double s, double k, double v, double r, double q, double t, bool put) {
+    double d1 = (std::log(s / k) + (r - q + 0.5 * v * v) * t) / (v * std::sqrt(t));
+    double d2 = d1 - v * std::sqrt(t);
+    if (put) {
+        return k * std::exp(-r * t) * cndf(-d2) - s * std::exp(-q * t) * cndf(-d1);
+    } else {
+        return s * std::exp(-q * t) * cndf(d1) - k * std::exp(-r * t) * cndf(d2);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // model parameter
+    TEST_DT underlying = 100;
+    TEST_DT volatility = 0.20;
+    TEST_DT dividendYield = 0.01;
+    TEST_DT riskFreeRate = 0.03;
+
+    // strike / maturity surface, first with maturities on a 4 step time grid,
+    // then off the grid with a single step up to the longest maturity
+    TEST_DT strikes[] = {80, 90, 100, 110, 120};
+    TEST_DT maturities[2][4] = {{0.25, 0.5, 0.75, 1.0}, {0.1, 0.3, 0.6, 1.0}};
+    unsigned int timeSteps[2] = {4, 1};
+    unsigned int requiredSamples = 32768;
+    TEST_DT relative_err = 0.01;
+
+    TEST_DT strike[MAX_OPTIONS];
+    TEST_DT timeLength[MAX_OPTIONS];
+    unsigned int optionType[MAX_OPTIONS];
+    TEST_DT outputs[MAX_OPTIONS];
+    ap_uint<32> seed[2] = {1, 10001};
+
+    int err = 0;
+    for (int m = 0; m < 2; ++m) {
+        unsigned int optNum = 0;
+        for (int i = 0; i < 2; ++i) {
+            for (int j = 0; j < 4; ++j) {
+                for (int k = 0; k < 5; ++k) {
+                    strike[optNum] = strikes[k];
+                    timeLength[optNum] = maturities[m][j];
+                    optionType[optNum] = i;
+                    optNum++;
+                }
+            }
+        }
+
+        mc_euro_batch_k(underlying, volatility, dividendYield,
+                        riskFreeRate, // model parameter
+                        optNum, strike, timeLength,
+                        optionType, // option parameter
+                        seed, outputs, requiredSamples, timeSteps[m]);
+
+        std::cout << "time steps " << timeSteps[m] << std::endl;
+        for (unsigned int i = 0; i < optNum; ++i) {
+            double golden =
+                bsPrice(underlying, strike[i], volatility, riskFreeRate, dividendYield, timeLength[i], optionType[i]);
+            double diff = std::fabs(outputs[i] - golden) / underlying;
+            std::cout << (optionType[i] ? "put " : "call") << " strike " << strike[i] << " maturity "
+                      << timeLength[i] << ": " << outputs[i] << ", golden " << golden << std::endl;
+            if (diff > relative_err) {
+                std::cout << "Output is wrong! error: " << diff << ", tolerance: " << relative_err << std::endl;
+                err++;
+            }
+        }
+    }
+    return err;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xcl2.hpp"
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "mc_euro_batch_k.hpp"
+
+#define LENGTH(a) (sizeof(a) / sizeof(a[0]))
+
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+// closed form Black-Scholes price used as golden reference
+static double cndf(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+static double bsPrice(double s, double k, double v, double r, double q, double t, bool put) {
+    double d1 = (std::log(s / k) + (r - q + 0.5 * v * v) * t) / (v * std::sqrt(t));
+    double d2 = d1 - v * std::sqrt(t);
+    if (put) {
+        return k * std::exp(-r * t) * cndf(-d2) - s * std::exp(-q * t) * cndf(-d1);
+    } else {
+        return s * std::exp(-q * t) * cndf(d1) - k * std::exp(-r * t) * cndf(d2);
+    }
+}
+
+int main(int argc, const char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string xclbin_path;
+    std::string mode_emu = "hw";
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    if (std::getenv("XCL_EMULATION_MODE") != nullptr) {
+        mode_emu = std::getenv("XCL_EMULATION_MODE");
+    }
+    std::cout << "[INFO]Running in " << mode_emu << " mode" << std::endl;
+
+    // model parameter
+    TEST_DT underlying = 100;
+    TEST_DT volatility = 0.20;
+    TEST_DT dividendYield = 0.01;
+    TEST_DT riskFreeRate = 0.03;
+
+    // strike / maturity surface, maturities lie on the time grid
+    TEST_DT strikes[] = {70, 80, 90, 95, 100, 105, 110, 120, 130};
+    TEST_DT maturities[] = {0.25, 0.5, 0.75, 1.0};
+    bool optionTypes[] = {false, true};
+
+    unsigned int timeSteps = 4;
+    unsigned int requiredSamples = 65536;
+    TEST_DT relative_err = 0.01;
+    if (mode_emu.compare("hw_emu") == 0) {
+        requiredSamples = 1024;
+        relative_err = 0.05;
+    }
+
+    unsigned int optNum = LENGTH(strikes) * LENGTH(maturities) * LENGTH(optionTypes);
+
+    // Allocate Memory in Host Memory
+    TEST_DT* strike = aligned_alloc<TEST_DT>(MAX_OPTIONS);
+    TEST_DT* timeLength = aligned_alloc<TEST_DT>(MAX_OPTIONS);
+    unsigned int* optionType = aligned_alloc<unsigned int>(MAX_OPTIONS);
+    TEST_DT* outputs = aligned_alloc<TEST_DT>(MAX_OPTIONS);
+    unsigned int* seed = aligned_alloc<unsigned int>(2);
+
+    int idx = 0;
+    for (int i = 0; i < LENGTH(optionTypes); ++i) {
+        for (int j = 0; j < LENGTH(maturities); ++j) {
+            for (int k = 0; k < LENGTH(strikes); ++k) {
+                strike[idx] = strikes[k];
+                timeLength[idx] = maturities[j];
+                optionType[idx] = optionTypes[i];
+                idx++;
+            }
+        }
+    }
+    seed[0] = 1;
+    seed[1] = 10001;
+
+    struct timeval start_time, end_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_Engine(program, "mc_euro_batch_k");
+    std::cout << "kernel has been created" << std::endl;
+
+#ifndef USE_HBM
+    unsigned int bank = XCL_MEM_DDR_BANK0;
+#else
+    unsigned int bank = XCL_BANK0;
+#endif
+    cl_mem_ext_ptr_t mext_o[5];
+    mext_o[0] = {bank, strike, 0};
+    mext_o[1] = {bank, timeLength, 0};
+    mext_o[2] = {bank, optionType, 0};
+    mext_o[3] = {bank, outputs, 0};
+    mext_o[4] = {bank, seed, 0};
+
+    // create device buffer and map dev buf to host buf
+    cl::Buffer strike_buf(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                          sizeof(TEST_DT) * MAX_OPTIONS, &mext_o[0]);
+    cl::Buffer time_buf(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                        sizeof(TEST_DT) * MAX_OPTIONS, &mext_o[1]);
+    cl::Buffer type_buf(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                        sizeof(unsigned int) * MAX_OPTIONS, &mext_o[2]);
+    cl::Buffer output_buf(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                          sizeof(TEST_DT) * MAX_OPTIONS, &mext_o[3]);
+    cl::Buffer seed_buf(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                        sizeof(unsigned int) * 2, &mext_o[4]);
+
+    std::vector<cl::Memory> ob_in;
+    ob_in.push_back(strike_buf);
+    ob_in.push_back(time_buf);
+    ob_in.push_back(type_buf);
+    ob_in.push_back(seed_buf);
+    std::vector<cl::Memory> ob_out;
+    ob_out.push_back(output_buf);
+
+    int j = 0;
+    kernel_Engine.setArg(j++, underlying);
+    kernel_Engine.setArg(j++, volatility);
+    kernel_Engine.setArg(j++, dividendYield);
+    kernel_Engine.setArg(j++, riskFreeRate);
+    kernel_Engine.setArg(j++, optNum);
+    kernel_Engine.setArg(j++, strike_buf);
+    kernel_Engine.setArg(j++, time_buf);
+    kernel_Engine.setArg(j++, type_buf);
+    kernel_Engine.setArg(j++, seed_buf);
+    kernel_Engine.setArg(j++, output_buf);
+    kernel_Engine.setArg(j++, requiredSamples);
+    kernel_Engine.setArg(j++, timeSteps);
+
+    q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+    q.finish();
+
+    // launch kernel and calculate kernel execution time
+    std::cout << "kernel start------" << std::endl;
+    gettimeofday(&start_time, 0);
+    q.enqueueTask(kernel_Engine, nullptr, nullptr);
+    q.finish();
+    gettimeofday(&end_time, 0);
+    std::cout << "kernel end------" << std::endl;
+    std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us for " << optNum << " options"
+              << std::endl;
+
+    q.enqueueMigrateMemObjects(ob_out, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+    q.finish();
+
+    // compare with golden result
+    int err = 0;
+    for (unsigned int i = 0; i < optNum; ++i) {
+        TEST_DT golden = bsPrice(underlying, strike[i], volatility, riskFreeRate, dividendYield, timeLength[i],
+                                 optionType[i]);
+        TEST_DT diff = std::fabs(outputs[i] - golden) / underlying;
+        if (diff > relative_err) {
+            std::cout << "Output is wrong!" << std::endl;
+            if (optionType[i])
+                std::cout << "Put option:\n";
+            else
+                std::cout << "Call option:\n";
+            std::cout << "   strike:              " << strike[i] << "\n"
+                      << "   maturity:            " << timeLength[i] << "\n"
+                      << "   golden:              " << golden << "\n";
+            std::cout << "Acutal value: " << outputs[i] << ", Expected value: " << golden << std::endl;
+            std::cout << "error: " << diff << ", tolerance: " << relative_err << std::endl;
+            err++;
+        }
+    }
+    if (err == 0) {
+        std::cout << "All " << optNum << " options match the closed form result" << std::endl;
+    }
+    return err;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mc_euro_batch_k.hpp"
+#ifndef __SYNTHESIS__
+#include <iostream>
+#endif
+
+extern "C" void mc_euro_batch_k(TEST_DT underlying,
+                                TEST_DT volatility,
+                                TEST_DT dividendYield,
+                                TEST_DT riskFreeRate, // model parameter
+                                unsigned int optNum,
+                                TEST_DT strike[MAX_OPTIONS],
+                                TEST_DT timeLength[MAX_OPTIONS],
+                                unsigned int optionType[MAX_OPTIONS], // option parameter
+                                ap_uint<32> seed[2],
+                                TEST_DT output[MAX_OPTIONS],
+                                unsigned int requiredSamples,
+                                unsigned int timeSteps) {
+#pragma HLS INTERFACE m_axi port = strike bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = timeLength bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = optionType bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = output bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = seed bundle = gmem1 offset = slave
+
+#pragma HLS INTERFACE s_axilite port = underlying bundle = control
+#pragma HLS INTERFACE s_axilite port = volatility bundle = control
+#pragma HLS INTERFACE s_axilite port = dividendYield bundle = control
+#pragma HLS INTERFACE s_axilite port = riskFreeRate bundle = control
+#pragma HLS INTERFACE s_axilite port = optNum bundle = control
+#pragma HLS INTERFACE s_axilite port = strike bundle = control
+#pragma HLS INTERFACE s_axilite port = timeLength bundle = control
+#pragma HLS INTERFACE s_axilite port = optionType bundle = control
+#pragma HLS INTERFACE s_axilite port = seed bundle = control
+#pragma HLS INTERFACE s_axilite port = output bundle = control
+#pragma HLS INTERFACE s_axilite port = requiredSamples bundle = control
+#pragma HLS INTERFACE s_axilite port = timeSteps bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    // load the batch into on-chip memory
+    TEST_DT strikeBuf[MAX_OPTIONS];
+    TEST_DT timeLengthBuf[MAX_OPTIONS];
+    bool optionTypeBuf[MAX_OPTIONS];
+    ap_uint<32> seedBuf[2];
+    TEST_DT outputBuf[MAX_OPTIONS];
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        strikeBuf[k] = strike[k];
+        timeLengthBuf[k] = timeLength[k];
+        optionTypeBuf[k] = optionType[k];
+    }
+    seedBuf[0] = seed[0];
+    seedBuf[1] = seed[1];
+
+    xf::fintech::MCEuropeanBatchEngine<TEST_DT, 2, MAX_OPTIONS, MAX_STEPS>(
+        underlying, volatility, dividendYield,
+        riskFreeRate, // model parameter
+        optNum, strikeBuf, timeLengthBuf,
+        optionTypeBuf, // option parameter
+        seedBuf, outputBuf, requiredSamples, timeSteps);
+
+    for (int k = 0; k < optNum; ++k) {
+#pragma HLS pipeline II = 1
+#pragma HLS loop_tripcount min = 1024 max = 1024
+        output[k] = outputBuf[k];
+    }
+}
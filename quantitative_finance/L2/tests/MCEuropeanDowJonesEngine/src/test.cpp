@@ -219,12 +219,15 @@ int main(int argc, const char* argv[]) {
 
         optionValue[i] = out0[0];
         optionValueSum += optionValue[i];
+        // the pricer is bypassed, so the engine estimates the forward of the asset
+        DtUsed forward = underlying[i] * std::exp((riskFreeRate - dividendYield) * timeLength);
 
         std::cout << "ASSET[" << i << "]:" << std::endl
                   << "  underlying:     " << underlying[i] << std::endl
                   << "  risk-free rate: " << riskFreeRate << std::endl
                   << "  volatility:     " << volatility << std::endl
                   << "  dividend yield: " << dividendYield << std::endl
+                  << "  forward:        " << forward << std::endl
                   << "  --              " << std::endl
                   << "  option value:   " << optionValue[i] << std::endl
                   << std::endl;
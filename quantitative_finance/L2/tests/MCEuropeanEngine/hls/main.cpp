@@ -127,5 +127,37 @@ int main(int argc, char* argv[]) {
             }
         }
     }
+
+    // The Sobol and Brownian bridge sequence against MT19937, at the same number of paths: RMS error over several
+    // seeds against the Black-Scholes price of an ATM call
+    if (run_csim) {
+        TEST_DT underlying = 100, strike = 100, riskFreeRate = 0.05, volatility = 0.2, dividendYield = 0.0;
+        double d1 = (std::log(underlying / strike) + (riskFreeRate - dividendYield + 0.5 * volatility * volatility) *
+                                                         timeLength) /
+                    (volatility * std::sqrt(timeLength));
+        double d2 = d1 - volatility * std::sqrt(timeLength);
+        double bs = underlying * std::exp(-dividendYield * timeLength) * 0.5 * std::erfc(-d1 / std::sqrt(2.0)) -
+                    strike * std::exp(-riskFreeRate * timeLength) * 0.5 * std::erfc(-d2 / std::sqrt(2.0));
+        unsigned int paths = 4096;
+        int runs = 8;
+        double msePR = 0, mseLD = 0;
+        for (int r = 0; r < runs; ++r) {
+            ap_uint<32> runSeeds[2] = {7 * (r + 1), 7 * (r + 1) + 10000};
+            MCEuropeanEngine_top(underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, false,
+                                 runSeeds, outputs, requiredTolerance, paths, timeSteps);
+            msePR += (outputs[0] - bs) * (outputs[0] - bs);
+            MCEuropeanEngineLD_top(underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, false,
+                                   runSeeds, outputs, requiredTolerance, paths, timeSteps);
+            mseLD += (outputs[0] - bs) * (outputs[0] - bs);
+        }
+        double rmsPR = std::sqrt(msePR / runs);
+        double rmsLD = std::sqrt(mseLD / runs);
+        std::cout << "Black-Scholes " << bs << ", RMS error with " << paths << " paths: PseudoRandom " << rmsPR
+                  << ", LowDiscrepancy " << rmsLD << std::endl;
+        if (!(rmsLD < 0.5 * rmsPR)) {
+            std::cout << "LowDiscrepancy does not lower the error!" << std::endl;
+            return -1;
+        }
+    }
     return 0;
 }
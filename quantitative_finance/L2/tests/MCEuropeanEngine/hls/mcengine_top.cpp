@@ -33,3 +33,22 @@ void MCEuropeanEngine_top(TEST_DT underlying,
                                               optionType, // option parameter
                                               seed, output, requiredTolerance, requiredSamples, timeSteps);
 }
+void MCEuropeanEngineLD_top(TEST_DT underlying,
+                            TEST_DT volatility,
+                            TEST_DT dividendYield,
+                            TEST_DT riskFreeRate, // model parameter
+                            TEST_DT timeLength,
+                            TEST_DT strike,
+                            bool optionType, // option parameter
+                            ap_uint<32> seed[2],
+                            TEST_DT output[1],
+                            TEST_DT requiredTolerance,
+                            unsigned int requiredSamples,
+                            unsigned int timeSteps) {
+    xf::fintech::MCEuropeanEngine<TEST_DT, 2, false, false, false, xf::fintech::LowDiscrepancy>(
+        underlying, volatility, dividendYield,
+        riskFreeRate, // model parameter
+        timeLength, strike,
+        optionType, // option parameter
+        seed, output, requiredTolerance, requiredSamples, timeSteps);
+}
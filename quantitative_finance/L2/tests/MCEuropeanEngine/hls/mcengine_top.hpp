@@ -30,5 +30,18 @@ void MCEuropeanEngine_top(TEST_DT underlying,
                           TEST_DT requiredTolerance,
                           unsigned int requiredSamples,
                           unsigned int timeSteps);
+// as above with the Sobol and Brownian bridge sequence, C simulation only
+void MCEuropeanEngineLD_top(TEST_DT underlying,
+                            TEST_DT volatility,
+                            TEST_DT dividendYield,
+                            TEST_DT riskFreeRate, // model parameter
+                            TEST_DT timeLength,
+                            TEST_DT strike,
+                            bool optionType, // option parameter
+                            ap_uint<32>* seed,
+                            TEST_DT* output,
+                            TEST_DT requiredTolerance,
+                            unsigned int requiredSamples,
+                            unsigned int timeSteps);
 
 #endif
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mcengine_cv_top.hpp"
+void MCEuropeanCVEngine_top(TEST_DT underlying,
+                            TEST_DT volatility,
+                            TEST_DT dividendYield,
+                            TEST_DT riskFreeRate, // model parameter
+                            TEST_DT timeLength,
+                            TEST_DT strike,
+                            bool optionType, // option parameter
+                            ap_uint<32> seed[2],
+                            TEST_DT output[1],
+                            TEST_DT requiredTolerance,
+                            unsigned int requiredSamples,
+                            unsigned int timeSteps) {
+    xf::fintech::MCEuropeanEngine<TEST_DT, 2, false, true, true>(underlying, volatility, dividendYield,
+                                                                 riskFreeRate, // model parameter
+                                                                 timeLength, strike,
+                                                                 optionType, // option parameter
+                                                                 seed, output, requiredTolerance, requiredSamples,
+                                                                 timeSteps);
+}
+void MCEuropeanCVOnlyEngine_top(TEST_DT underlying,
+                                TEST_DT volatility,
+                                TEST_DT dividendYield,
+                                TEST_DT riskFreeRate, // model parameter
+                                TEST_DT timeLength,
+                                TEST_DT strike,
+                                bool optionType, // option parameter
+                                ap_uint<32> seed[2],
+                                TEST_DT output[1],
+                                TEST_DT requiredTolerance,
+                                unsigned int requiredSamples,
+                                unsigned int timeSteps) {
+    xf::fintech::MCEuropeanEngine<TEST_DT, 2, false, true, false>(underlying, volatility, dividendYield,
+                                                                  riskFreeRate, // model parameter
+                                                                  timeLength, strike,
+                                                                  optionType, // option parameter
+                                                                  seed, output, requiredTolerance, requiredSamples,
+                                                                  timeSteps);
+}
+void MCEuropeanPlainEngine_top(TEST_DT underlying,
+                               TEST_DT volatility,
+                               TEST_DT dividendYield,
+                               TEST_DT riskFreeRate, // model parameter
+                               TEST_DT timeLength,
+                               TEST_DT strike,
+                               bool optionType, // option parameter
+                               ap_uint<32> seed[2],
+                               TEST_DT output[1],
+                               TEST_DT requiredTolerance,
+                               unsigned int requiredSamples,
+                               unsigned int timeSteps) {
+    xf::fintech::MCEuropeanEngine<TEST_DT, 2>(underlying, volatility, dividendYield,
+                                              riskFreeRate, // model parameter
+                                              timeLength, strike,
+                                              optionType, // option parameter
+                                              seed, output, requiredTolerance, requiredSamples, timeSteps);
+}
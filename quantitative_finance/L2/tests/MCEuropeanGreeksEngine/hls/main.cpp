@@ -0,0 +1,131 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <iostream>
+#include "mcengine_greeks_top.hpp"
+
+#define LENGTH(a) (sizeof(a) / sizeof(a[0]))
+
+static double normalCDF(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+// closed-form Black-Scholes price, delta, gamma, vega, theta and rho
+static void bsGreeks(double s, double v, double q, double r, double t, double k, bool put, double greeks[6]) {
+    double d1 = (std::log(s / k) + (r - q + 0.5 * v * v) * t) / (v * std::sqrt(t));
+    double d2 = d1 - v * std::sqrt(t);
+    double pdf = std::exp(-0.5 * d1 * d1) / std::sqrt(2 * M_PI);
+    double dq = std::exp(-q * t);
+    double dr = std::exp(-r * t);
+    if (put) {
+        greeks[0] = k * dr * normalCDF(-d2) - s * dq * normalCDF(-d1);
+        greeks[1] = dq * (normalCDF(d1) - 1);
+        greeks[5] = -k * t * dr * normalCDF(-d2);
+    } else {
+        greeks[0] = s * dq * normalCDF(d1) - k * dr * normalCDF(d2);
+        greeks[1] = dq * normalCDF(d1);
+        greeks[5] = k * t * dr * normalCDF(d2);
+    }
+    greeks[2] = dq * pdf / (s * v * std::sqrt(t));
+    greeks[3] = s * dq * pdf * std::sqrt(t);
+    greeks[4] = r * greeks[0] - (r - q) * s * greeks[1] - 0.5 * v * v * s * s * greeks[2];
+}
+
+int main(int argc, char* argv[]) {
+    bool run_csim = true;
+    if (argc >= 2) {
+        run_csim = std::stoi(argv[1]);
+        if (run_csim) std::cout << "run csim for function verify\n";
+    }
+
+    bool optionTypes[] = {false, true};
+    TEST_DT strikes[] = {80.0, 100.0, 120.0};
+    TEST_DT riskFreeRates[] = {0.01, 0.05};
+    TEST_DT volatilitys[] = {0.15, 0.40};
+    TEST_DT dividendYields[] = {0.00, 0.03};
+    const char* names[] = {"price", "delta", "gamma", "vega", "theta", "rho"};
+
+    TEST_DT underlying = 100;
+    TEST_DT timeLength = 1;
+    TEST_DT requiredTolerance = 0.02;
+    unsigned int requiredSamples = 65536;
+    // all the outputs are compared in units of the underlying
+    TEST_DT scales[] = {1.0 / underlying, 1.0, underlying, 1.0 / underlying, 1.0 / underlying, 1.0 / underlying};
+    TEST_DT err = 0.02;
+
+    TEST_DT outputs[6];
+    double goldens[6];
+    ap_uint<32> seeds[2];
+    seeds[0] = 1;
+    seeds[1] = 10001;
+
+    int idx = 0;
+    TEST_DT maxDiff = 0;
+    int opt_len = run_csim ? LENGTH(optionTypes) : 1;
+    int st_len = run_csim ? LENGTH(strikes) : 1;
+    int r_len = run_csim ? LENGTH(riskFreeRates) : 1;
+    int vol_len = run_csim ? LENGTH(volatilitys) : 1;
+    int d_len = run_csim ? LENGTH(dividendYields) : 1;
+    for (int i = 0; i < opt_len; ++i) {
+        for (int j = 0; j < st_len; ++j) {
+            for (int m = 0; m < d_len; ++m) {
+                for (int n = 0; n < r_len; ++n) {
+                    for (int p = 0; p < vol_len; ++p) {
+                        bool optionType = optionTypes[i];
+                        TEST_DT strike = strikes[j];
+                        TEST_DT dividendYield = dividendYields[m];
+                        TEST_DT riskFreeRate = riskFreeRates[n];
+                        TEST_DT volatility = volatilitys[p];
+
+                        MCEuropeanGreeksEngine_top(underlying, volatility, dividendYield,
+                                                   riskFreeRate, // model parameter
+                                                   timeLength, strike,
+                                                   optionType, // option parameter
+                                                   seeds, outputs, requiredTolerance, requiredSamples);
+                        bsGreeks(underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, optionType,
+                                 goldens);
+
+                        std::cout << "output[" << idx << "] = " << outputs[0] << ",   "
+                                  << "golden[" << idx << "] = " << goldens[0] << std::endl;
+                        idx++;
+
+                        // comapre with closed-form result
+                        for (int g = 0; g < 6; ++g) {
+                            TEST_DT diff = std::fabs(outputs[g] - goldens[g]) * scales[g];
+                            if (diff > maxDiff) maxDiff = diff;
+                            if (diff > err) {
+                                std::cout << "Output is wrong!" << std::endl;
+                                std::cout << (optionType ? "Put option:\n" : "Call option:\n");
+                                std::cout << "   strike:              " << strike << "\n"
+                                          << "   risk-free rate:      " << riskFreeRate << "\n"
+                                          << "   volatility:          " << volatility << "\n"
+                                          << "   dividend yield:      " << dividendYield << "\n";
+                                std::cout << "Acutal " << names[g] << ": " << outputs[g]
+                                          << ", Expected value: " << goldens[g] << std::endl;
+                                std::cout << "error: " << diff << ", tolerance: " << err << std::endl;
+                                return -1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::cout << "Maximum difference is " << maxDiff << " in units of the underlying" << std::endl;
+    std::cout << "All greeks match the closed-form solution" << std::endl;
+    return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HLS_TEST
+#include "xcl2.hpp"
+#endif
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "mc_euro_greeks_k.hpp"
+
+#define LENGTH(a) (sizeof(a) / sizeof(a[0]))
+
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+#define XCL_BANK1 XCL_BANK(1)
+#define XCL_BANK2 XCL_BANK(2)
+#define XCL_BANK3 XCL_BANK(3)
+#define XCL_BANK4 XCL_BANK(4)
+#define XCL_BANK5 XCL_BANK(5)
+#define XCL_BANK6 XCL_BANK(6)
+#define XCL_BANK7 XCL_BANK(7)
+#define XCL_BANK8 XCL_BANK(8)
+#define XCL_BANK9 XCL_BANK(9)
+#define XCL_BANK10 XCL_BANK(10)
+#define XCL_BANK11 XCL_BANK(11)
+#define XCL_BANK12 XCL_BANK(12)
+#define XCL_BANK13 XCL_BANK(13)
+#define XCL_BANK14 XCL_BANK(14)
+#define XCL_BANK15 XCL_BANK(15)
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+static double normalCDF(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+// closed-form Black-Scholes price, delta, gamma, vega, theta and rho
+static void bsGreeks(double s, double v, double q, double r, double t, double k, bool put, double greeks[6]) {
+    double d1 = (std::log(s / k) + (r - q + 0.5 * v * v) * t) / (v * std::sqrt(t));
+    double d2 = d1 - v * std::sqrt(t);
+    double pdf = std::exp(-0.5 * d1 * d1) / std::sqrt(2 * M_PI);
+    double dq = std::exp(-q * t);
+    double dr = std::exp(-r * t);
+    if (put) {
+        greeks[0] = k * dr * normalCDF(-d2) - s * dq * normalCDF(-d1);
+        greeks[1] = dq * (normalCDF(d1) - 1);
+        greeks[5] = -k * t * dr * normalCDF(-d2);
+    } else {
+        greeks[0] = s * dq * normalCDF(d1) - k * dr * normalCDF(d2);
+        greeks[1] = dq * normalCDF(d1);
+        greeks[5] = k * t * dr * normalCDF(d2);
+    }
+    greeks[2] = dq * pdf / (s * v * std::sqrt(t));
+    greeks[3] = s * dq * pdf * std::sqrt(t);
+    greeks[4] = r * greeks[0] - (r - q) * s * greeks[1] - 0.5 * v * v * s * s * greeks[2];
+}
+
+int main(int argc, const char* argv[]) {
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string xclbin_path;
+    std::string mode_emu = "hw";
+#ifndef HLS_TEST
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+
+    if (std::getenv("XCL_EMULATION_MODE") != nullptr) {
+        mode_emu = std::getenv("XCL_EMULATION_MODE");
+    }
+    std::cout << "[INFO]Running in " << mode_emu << " mode" << std::endl;
+#endif
+    // Allocate Memory in Host Memory
+    TEST_DT* outputs = aligned_alloc<TEST_DT>(6);
+    ap_uint<32>* seed = aligned_alloc<ap_uint<32> >(2);
+
+    // -------------setup k0 params---------------
+
+    bool optionTypes[] = {false, true};
+    TEST_DT strikes[] = {80.0, 100.0, 120.0};
+    TEST_DT riskFreeRates[] = {0.01, 0.05};
+    TEST_DT volatilitys[] = {0.15, 0.40};
+    TEST_DT dividendYields[] = {0.00, 0.03};
+    const char* names[] = {"price", "delta", "gamma", "vega", "theta", "rho"};
+
+    TEST_DT underlying = 100;
+    TEST_DT timeLength = 1;
+    TEST_DT requiredTolerance = 0.02;
+    unsigned int requiredSamples = 65536;
+    // all the outputs are compared in units of the underlying
+    TEST_DT scales[] = {1.0 / underlying, 1.0, underlying, 1.0 / underlying, 1.0 / underlying, 1.0 / underlying};
+    TEST_DT err = 0.02;
+
+    double goldens[6];
+    seed[0] = 1;
+    seed[1] = 10001;
+
+    int opt_len, st_len, r_len, vol_len, d_len;
+    if (mode_emu.compare("hw_emu") == 0) {
+        opt_len = 1;
+        st_len = 1;
+        r_len = 1;
+        vol_len = 1;
+        d_len = 1;
+    } else {
+        opt_len = LENGTH(optionTypes);
+        st_len = LENGTH(strikes);
+        r_len = LENGTH(riskFreeRates);
+        vol_len = LENGTH(volatilitys);
+        d_len = LENGTH(dividendYields);
+    }
+#ifndef HLS_TEST
+    struct timeval start_time, end_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_Engine(program, "mc_euro_greeks_k");
+    std::cout << "kernel has been created" << std::endl;
+
+    cl_mem_ext_ptr_t mext_o[2];
+    mext_o[0].obj = outputs;
+    mext_o[0].param = 0;
+
+    mext_o[1].obj = seed;
+    mext_o[1].param = 0;
+#ifndef USE_HBM
+    mext_o[0].flags = XCL_MEM_DDR_BANK0;
+    mext_o[1].flags = XCL_MEM_DDR_BANK0;
+#else
+    mext_o[0].flags = XCL_BANK0;
+    mext_o[1].flags = XCL_BANK0;
+#endif
+
+    // create device buffer and map dev buf to host buf
+    cl::Buffer output_buf = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                       6 * sizeof(TEST_DT), &mext_o[0]);
+    cl::Buffer seed_buf = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                     2 * sizeof(ap_uint<32>), &mext_o[1]);
+    std::vector<cl::Memory> ob_in;
+    ob_in.push_back(seed_buf);
+    q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+#endif
+
+    int idx = 0;
+    TEST_DT maxDiff = 0;
+    for (int i = 0; i < opt_len; ++i) {
+        for (int j = 0; j < st_len; ++j) {
+            for (int m = 0; m < d_len; ++m) {
+                for (int n = 0; n < r_len; ++n) {
+                    for (int p = 0; p < vol_len; ++p) {
+                        unsigned int optionType = optionTypes[i];
+                        TEST_DT strike = strikes[j];
+                        TEST_DT dividendYield = dividendYields[m];
+                        TEST_DT riskFreeRate = riskFreeRates[n];
+                        TEST_DT volatility = volatilitys[p];
+#ifndef HLS_TEST
+                        std::vector<cl::Memory> ob_out;
+                        ob_out.push_back(output_buf);
+
+                        q.finish();
+                        // launch kernel and calculate kernel execution time
+                        gettimeofday(&start_time, 0);
+                        int a = 0;
+                        kernel_Engine.setArg(a++, underlying);
+                        kernel_Engine.setArg(a++, volatility);
+                        kernel_Engine.setArg(a++, dividendYield);
+                        kernel_Engine.setArg(a++, riskFreeRate);
+                        kernel_Engine.setArg(a++, timeLength);
+                        kernel_Engine.setArg(a++, strike);
+                        kernel_Engine.setArg(a++, optionType);
+                        kernel_Engine.setArg(a++, seed_buf);
+                        kernel_Engine.setArg(a++, output_buf);
+                        kernel_Engine.setArg(a++, requiredTolerance);
+                        kernel_Engine.setArg(a++, requiredSamples);
+
+                        q.enqueueTask(kernel_Engine, nullptr, nullptr);
+                        q.finish();
+                        gettimeofday(&end_time, 0);
+                        std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us" << std::endl;
+                        q.enqueueMigrateMemObjects(ob_out, 1, nullptr, nullptr);
+                        q.finish();
+#else
+                        mc_euro_greeks_k(underlying, volatility, dividendYield,
+                                         riskFreeRate, // model parameter
+                                         timeLength, strike,
+                                         optionType, // option parameter
+                                         seed, outputs, requiredTolerance, requiredSamples);
+#endif
+                        bsGreeks(underlying, volatility, dividendYield, riskFreeRate, timeLength, strike, optionType,
+                                 goldens);
+                        std::cout << "output[" << idx << "] = " << outputs[0] << ",   "
+                                  << "golden[" << idx << "] = " << goldens[0] << std::endl;
+                        idx++;
+
+                        // comapre with closed-form result
+                        for (int g = 0; g < 6; ++g) {
+                            TEST_DT diff = std::fabs(outputs[g] - goldens[g]) * scales[g];
+                            if (diff > maxDiff) maxDiff = diff;
+                            if (diff > err) {
+                                std::cout << "Output is wrong!" << std::endl;
+                                std::cout << (optionType ? "Put option:\n" : "Call option:\n");
+                                std::cout << "   strike:              " << strike << "\n"
+                                          << "   risk-free rate:      " << riskFreeRate << "\n"
+                                          << "   volatility:          " << volatility << "\n"
+                                          << "   dividend yield:      " << dividendYield << "\n";
+                                std::cout << "Acutal " << names[g] << ": " << outputs[g]
+                                          << ", Expected value: " << goldens[g] << std::endl;
+                                std::cout << "error: " << diff << ", tolerance: " << err << std::endl;
+                                return -1;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    std::cout << "Maximum difference is " << maxDiff << " in units of the underlying" << std::endl;
+    return 0;
+}
@@ -22,14 +22,17 @@
 #include <stdio.h>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 #include <cmath>
 #include <vector>
 #include <string>
 #include <sstream>
 #include "xcl2.hpp"
 //#include "mcmc_kernel.hpp"
+#include "mcmc_md_kernel.hpp"
 #define NUM_CHAINS 10
 #define KERNEL_DT double
+#define MD_NUM_DIMS 10
 
 // Temporary copy of this macro definition until new xcl2.hpp is used
 #define OCL_CHECK(error, call)                                                                   \
@@ -142,5 +145,102 @@ int main(int argc, char* argv[]) {
     };
     fclose(fp);
     std::cout << std::endl;
+
+    // Multi-dimensional target: correlated normal distribution, sampled in blocks of at most MD_NSAMPLES_MAX samples
+    // with the state of the chains carried between blocks
+    std::cout << "Multi-dimensional target with " << MD_NUM_DIMS << " dimensions" << std::endl;
+    const unsigned int nDim = MD_NUM_DIMS;
+    std::vector<double> cov(nDim * nDim);
+    std::vector<MD_DT, aligned_allocator<MD_DT> > target_params(MD_NPARAMS_MAX, 0.0);
+    std::vector<MD_DT, aligned_allocator<MD_DT> > state(MD_STATE_SIZE, 0.0);
+    std::vector<MD_DT, aligned_allocator<MD_DT> > md_sample(MD_NSAMPLES_MAX * MD_NDIM_MAX);
+    for (unsigned int i = 0; i < nDim; i++) {
+        target_params[i] = 0.1 * i;
+        for (unsigned int j = 0; j < nDim; j++) {
+            cov[i * nDim + j] = pow(0.7, std::abs((int)i - (int)j));
+        }
+    }
+    // precision matrix by Gauss-Jordan elimination
+    std::vector<double> work(cov);
+    double* prec = &target_params[nDim];
+    for (unsigned int i = 0; i < nDim * nDim; i++) prec[i] = (i % (nDim + 1) == 0) ? 1.0 : 0.0;
+    for (unsigned int c = 0; c < nDim; c++) {
+        double p = work[c * nDim + c];
+        for (unsigned int j = 0; j < nDim; j++) {
+            work[c * nDim + j] /= p;
+            prec[c * nDim + j] /= p;
+        }
+        for (unsigned int r = 0; r < nDim; r++) {
+            if (r != c) {
+                double f = work[r * nDim + c];
+                for (unsigned int j = 0; j < nDim; j++) {
+                    work[r * nDim + j] -= f * work[c * nDim + j];
+                    prec[r * nDim + j] -= f * prec[c * nDim + j];
+                }
+            }
+        }
+    }
+
+    OCL_CHECK(err, cl::Kernel krnl_md_mcmc(program, "mcmc_md_kernel", &err));
+    OCL_CHECK(err, cl::Buffer buffer_params(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                            MD_NPARAMS_MAX * sizeof(MD_DT), target_params.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_state(context, CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE,
+                                           MD_STATE_SIZE * sizeof(MD_DT), state.data(), &err));
+    OCL_CHECK(err, cl::Buffer buffer_md_sample(context, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                                               MD_NSAMPLES_MAX * MD_NDIM_MAX * sizeof(MD_DT), md_sample.data(),
+                                               &err));
+    OCL_CHECK(err, err = q.enqueueMigrateMemObjects({buffer_params, buffer_state}, 0));
+
+    std::vector<double> mean(nDim, 0.0), moment(nDim * nDim, 0.0);
+    unsigned int count = 0;
+    fp = fopen("vitis_md_samples_out.csv", "wb");
+    for (unsigned int done = 0, block = 0; done < num_samples; block++) {
+        unsigned int n = std::min((unsigned int)MD_NSAMPLES_MAX, num_samples - done);
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(0, buffer_temp_inv));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(1, buffer_params));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(2, buffer_state));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(3, buffer_md_sample));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(4, nDim));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(5, n));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(6, 0.1));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(7, MD_ADAPT_INTERVAL));
+        OCL_CHECK(err, err = krnl_md_mcmc.setArg(8, MD_SEED + block));
+        OCL_CHECK(err, err = q.enqueueTask(krnl_md_mcmc));
+        OCL_CHECK(err, err = q.enqueueMigrateMemObjects({buffer_md_sample}, CL_MIGRATE_MEM_OBJECT_HOST));
+        OCL_CHECK(err, err = q.finish());
+        for (unsigned int t = 0; t < n; t++) {
+            if (done + t < num_burn) continue;
+            count++;
+            for (unsigned int i = 0; i < nDim; i++) {
+                fprintf(fp, (i + 1 < nDim) ? "%lf," : "%lf\n", md_sample[t * nDim + i]);
+                mean[i] += md_sample[t * nDim + i];
+                for (unsigned int j = 0; j < nDim; j++) {
+                    moment[i * nDim + j] += md_sample[t * nDim + i] * md_sample[t * nDim + j];
+                }
+            }
+        }
+        done += n;
+    }
+    fclose(fp);
+
+    double meanErr = 0, covErr = 0;
+    for (unsigned int i = 0; i < nDim; i++) mean[i] /= count;
+    for (unsigned int i = 0; i < nDim; i++) {
+        meanErr = std::max(meanErr, std::abs(mean[i] - target_params[i]));
+        for (unsigned int j = 0; j < nDim; j++) {
+            covErr = std::max(covErr, std::abs(moment[i * nDim + j] / count - mean[i] * mean[j] - cov[i * nDim + j]));
+        }
+    }
+    // the chains are correlated, so allow several times the standard error of independent samples
+    double tolerance = 12.0 / std::sqrt((double)count);
+    std::cout << "Max error of the sample mean " << meanErr << ", of the sample covariance " << covErr
+              << ", tolerance " << tolerance << std::endl;
+    std::cout << "Samples saved to vitis_md_samples_out.csv" << std::endl;
+    std::cout << std::endl;
+    if (count == 0 || !(meanErr < tolerance) || !(covErr < tolerance)) {
+        std::cout << "Multi-dimensional test FAILED" << std::endl;
+        return 1;
+    }
+    std::cout << "Multi-dimensional test PASSED" << std::endl;
     return 0;
 }
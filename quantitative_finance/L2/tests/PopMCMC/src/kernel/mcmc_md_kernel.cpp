@@ -0,0 +1,50 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mcmc_md_kernel.hpp"
+
+extern "C" void mcmc_md_kernel(MD_DT temp_inv[MD_NCHAINS],
+                               MD_DT target_params[MD_NPARAMS_MAX],
+                               MD_DT state[MD_STATE_SIZE],
+                               MD_DT sample_output[MD_NSAMPLES_MAX * MD_NDIM_MAX],
+                               unsigned int nDim,
+                               unsigned int nSamples,
+                               MD_DT sigma,
+                               unsigned int adaptInterval,
+                               unsigned int seed) {
+#pragma HLS INTERFACE m_axi port = sample_output bundle = gmem offset = slave
+#pragma HLS INTERFACE m_axi port = state offset = slave bundle = gmem
+#pragma HLS INTERFACE m_axi port = target_params offset = slave bundle = gmem
+#pragma HLS INTERFACE m_axi port = temp_inv offset = slave bundle = gmem
+
+#pragma HLS INTERFACE s_axilite port = temp_inv bundle = control
+#pragma HLS INTERFACE s_axilite port = target_params bundle = control
+#pragma HLS INTERFACE s_axilite port = state bundle = control
+#pragma HLS INTERFACE s_axilite port = sample_output bundle = control
+#pragma HLS INTERFACE s_axilite port = nDim bundle = control
+#pragma HLS INTERFACE s_axilite port = nSamples bundle = control
+#pragma HLS INTERFACE s_axilite port = sigma bundle = control
+#pragma HLS INTERFACE s_axilite port = adaptInterval bundle = control
+#pragma HLS INTERFACE s_axilite port = seed bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+
+    // Replace the target to sample another density, the host side is unchanged
+    xf::fintech::GaussianLogDensity<MD_DT, MD_NDIM_MAX> target;
+    target.init(target_params, nDim);
+
+    xf::fintech::McmcCoreMultiDim<MD_DT, xf::fintech::GaussianLogDensity<MD_DT, MD_NDIM_MAX>, MD_NCHAINS, MD_NDIM_MAX,
+                                  MD_NSAMPLES_MAX>(target, temp_inv, state, sample_output, nDim, nSamples, sigma,
+                                                   adaptInterval, seed);
+}
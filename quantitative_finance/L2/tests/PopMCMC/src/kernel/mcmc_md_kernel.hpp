@@ -0,0 +1,60 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+/**
+ *  @file mcmc_md_kernel.hpp
+ *  @brief  Header file for the multi-dimensional kernel wrapper
+ */
+
+#ifndef _MCMC_MD_KERNEL_H_
+#define _MCMC_MD_KERNEL_H_
+
+#include "xf_fintech/pop_mcmc.hpp"
+
+/// @brief Specific implementation of this kernel
+#define MD_NCHAINS 10
+#define MD_NDIM_MAX 64
+#define MD_NSAMPLES_MAX 1024
+#define MD_NPARAMS_MAX (MD_NDIM_MAX + MD_NDIM_MAX * MD_NDIM_MAX)
+#define MD_STATE_SIZE (xf::fintech::McmcMultiDimState<MD_NCHAINS, MD_NDIM_MAX>::SIZE)
+#define MD_DT double
+/// @brief Host settings of the kernel calls
+#define MD_ADAPT_INTERVAL 100
+#define MD_SEED 42
+
+/**
+* @brief Top level Kernel function, sampling a multivariate normal target.  \n
+*
+*@param[in] temp_inv        - Array of Inverted temperatures of the chains (1/Temp)
+*@param[in] target_params   - Parameters of the target, mean followed by the precision matrix
+*@param[in,out] state       - State of the chains, carried from one call to the next
+*@param[out] sample_output  - Samples of the coldest chain, nDim values per sample
+*@param[in] nDim            - Number of dimensions
+*@param[in] nSamples        - Number of samples to generate
+*@param[in] sigma           - Standard deviation of the proposal before adaptation
+*@param[in] adaptInterval   - Number of samples between updates of the proposal covariance
+*@param[in] seed            - Seed of the RNG
+*/
+extern "C" void mcmc_md_kernel(MD_DT temp_inv[MD_NCHAINS],
+                               MD_DT target_params[MD_NPARAMS_MAX],
+                               MD_DT state[MD_STATE_SIZE],
+                               MD_DT sample_output[MD_NSAMPLES_MAX * MD_NDIM_MAX],
+                               unsigned int nDim,
+                               unsigned int nSamples,
+                               MD_DT sigma,
+                               unsigned int adaptInterval,
+                               unsigned int seed);
+
+#endif
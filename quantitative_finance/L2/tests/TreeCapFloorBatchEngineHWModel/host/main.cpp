@@ -0,0 +1,222 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HLS_TEST
+#include "xcl2.hpp"
+#endif
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "tree_engine_kernel.hpp"
+
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+#define XCL_BANK1 XCL_BANK(1)
+#define XCL_BANK2 XCL_BANK(2)
+#define XCL_BANK3 XCL_BANK(3)
+#define XCL_BANK4 XCL_BANK(4)
+#define XCL_BANK5 XCL_BANK(5)
+#define XCL_BANK6 XCL_BANK(6)
+#define XCL_BANK7 XCL_BANK(7)
+#define XCL_BANK8 XCL_BANK(8)
+#define XCL_BANK9 XCL_BANK(9)
+#define XCL_BANK10 XCL_BANK(10)
+#define XCL_BANK11 XCL_BANK(11)
+#define XCL_BANK12 XCL_BANK(12)
+#define XCL_BANK13 XCL_BANK(13)
+#define XCL_BANK14 XCL_BANK(14)
+#define XCL_BANK15 XCL_BANK(15)
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+int main(int argc, const char* argv[]) {
+    std::cout << "\n----------------------Tree CapFloor (HullWhite) Batch Engine-----------------\n";
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string xclbin_path;
+#ifndef HLS_TEST
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+#endif
+    // Allocate Memory in Host Memory
+    int* type_alloc = aligned_alloc<int>(N);
+    DT* initTime_alloc = aligned_alloc<DT>(InitLen);
+    int* endIndex_alloc = aligned_alloc<int>(N);
+    int* floatingCnt_alloc = aligned_alloc<int>(N * FloatingLen);
+    int* floatingSize_alloc = aligned_alloc<int>(N);
+    DT* cfRate_alloc = aligned_alloc<DT>(N * 2);
+    DT* output = aligned_alloc<DT>(N);
+
+    // -------------setup k0 params---------------
+    int err = 0;
+    DT minErr = 10e-10;
+    int timestep = 10;
+    cout << "timestep=" << timestep << endl;
+
+    // The cap of TreeCapFloorEngineHWModel, and two shorter caps ending at 4.0027 and at 4.0227, with the same resets.
+    // 4.0227 is closer than half a step to 4.0027 and is merged into it, so the grid, and the NPV of the first cap,
+    // are the ones of the single engine.
+    double golden[N] = {164.38820137859625, 103.43363752035101, 103.26910334949601};
+    // the shorter caps differ only by the accrual of their last period, 20 days on 0.5 year
+    DT nearErr = 0.01;
+    int endIndex[N] = {12, 7, 8};
+    double initTime[13] = {0,
+                           1,
+                           1.4958904109589042,
+                           2,
+                           2.4986301369863013,
+                           3.0027397260273974,
+                           3.4986301369863013,
+                           4.0027397260273974,
+                           4.0227397260273974,
+                           4.4986301369863018,
+                           5.0027397260273974,
+                           5.4986301369863018,
+                           6.0027397260273974};
+
+    int initSize = 13;
+    // resets at every timepoint but the merged one and the last one
+    int floatingCnt[10] = {0, 1, 2, 3, 4, 5, 6, 8, 9, 10};
+    int floatingSize[N] = {10, 6, 6};
+
+    for (int i = 0; i < initSize; i++) {
+        initTime_alloc[i] = initTime[i];
+    }
+
+    int floatingOffset = 0;
+    for (int n = 0; n < N; n++) {
+        type_alloc[n] = 0;
+        endIndex_alloc[n] = endIndex[n];
+        floatingSize_alloc[n] = floatingSize[n];
+        cfRate_alloc[2 * n] = 0.01;
+        cfRate_alloc[2 * n + 1] = 0.0;
+        for (int i = 0; i < floatingSize[n]; i++) floatingCnt_alloc[floatingOffset++] = floatingCnt[i];
+    }
+    for (int i = floatingOffset; i < N * FloatingLen; i++) floatingCnt_alloc[i] = 0;
+
+#ifndef HLS_TEST
+    // do pre-process on CPU
+    struct timeval start_time, end_time, test_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_TreeCapFloorEngine(program, "TREE_k0");
+    std::cout << "kernel has been created" << std::endl;
+
+    cl_mem_ext_ptr_t mext_o[7];
+    mext_o[0].obj = output;
+    mext_o[1].obj = initTime_alloc;
+    mext_o[2].obj = cfRate_alloc;
+    mext_o[3].obj = type_alloc;
+    mext_o[4].obj = endIndex_alloc;
+    mext_o[5].obj = floatingCnt_alloc;
+    mext_o[6].obj = floatingSize_alloc;
+    for (int i = 0; i < 7; ++i) {
+        mext_o[i].param = 0;
+#ifndef USE_HBM
+        mext_o[i].flags = XCL_MEM_DDR_BANK0;
+#else
+        mext_o[i].flags = XCL_BANK0;
+#endif
+    }
+
+    // create device buffer and map dev buf to host buf
+    size_t bufSize[7] = {sizeof(DT) * N,       sizeof(DT) * InitLen,          sizeof(DT) * N * 2, sizeof(int) * N,
+                         sizeof(int) * N, sizeof(int) * N * FloatingLen, sizeof(int) * N};
+    cl::Buffer buf[7];
+    for (int i = 0; i < 7; ++i) {
+        buf[i] = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, bufSize[i],
+                            &mext_o[i]);
+    }
+
+    std::vector<cl::Memory> ob_in;
+    for (int i = 1; i < 7; ++i) ob_in.push_back(buf[i]);
+    std::vector<cl::Memory> ob_out;
+    ob_out.push_back(buf[0]);
+
+    q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+    q.finish();
+    // launch kernel and calculate kernel execution time
+    std::cout << "kernel start------" << std::endl;
+    gettimeofday(&start_time, 0);
+    kernel_TreeCapFloorEngine.setArg(0, N);
+    kernel_TreeCapFloorEngine.setArg(1, buf[3]);
+    kernel_TreeCapFloorEngine.setArg(2, timestep);
+    kernel_TreeCapFloorEngine.setArg(3, buf[1]);
+    kernel_TreeCapFloorEngine.setArg(4, initSize);
+    kernel_TreeCapFloorEngine.setArg(5, buf[4]);
+    kernel_TreeCapFloorEngine.setArg(6, buf[5]);
+    kernel_TreeCapFloorEngine.setArg(7, buf[6]);
+    kernel_TreeCapFloorEngine.setArg(8, buf[2]);
+    kernel_TreeCapFloorEngine.setArg(9, buf[0]);
+
+    q.enqueueTask(kernel_TreeCapFloorEngine, nullptr, nullptr);
+
+    q.finish();
+    gettimeofday(&end_time, 0);
+    std::cout << "kernel end------" << std::endl;
+    std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us" << std::endl;
+    q.enqueueMigrateMemObjects(ob_out, 1, nullptr, nullptr);
+    q.finish();
+#else
+    TREE_k0(N, type_alloc, timestep, initTime_alloc, initSize, endIndex_alloc, floatingCnt_alloc, floatingSize_alloc,
+            cfRate_alloc, output);
+#endif
+    for (int n = 0; n < N; n++) {
+        DT out = output[n];
+        if (std::fabs(out - golden[n]) > minErr) err++;
+        std::cout << "NPV[" << n << "]= " << std::setprecision(15) << out
+                  << " ,diff/NPV= " << (out - golden[n]) / golden[n] << std::endl;
+    }
+    if (!(std::fabs(output[2] - output[1]) <= nearErr * output[1])) err++;
+    std::cout << "merged end: NPV[2]/NPV[1]-1= " << output[2] / output[1] - 1 << std::endl;
+    return err;
+}
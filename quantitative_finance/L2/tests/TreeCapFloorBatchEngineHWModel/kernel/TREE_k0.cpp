@@ -0,0 +1,93 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tree_engine_kernel.hpp"
+#ifndef __SYNTHESIS__
+#include <iostream>
+using namespace std;
+#endif
+
+extern "C" void TREE_k0(int numInstruments,
+                        int type[N],
+                        int timestep,
+                        DT initTime[InitLen],
+                        int initSize,
+                        int endIndex[N],
+                        int floatingCnt[N * FloatingLen],
+                        int floatingSize[N],
+                        DT cfRate[N * 2],
+                        DT NPV[N]) {
+#ifndef HLS_TEST
+#pragma HLS INTERFACE m_axi port = NPV bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = initTime bundle = gmem1 offset = slave
+#pragma HLS INTERFACE m_axi port = cfRate bundle = gmem1 offset = slave
+#pragma HLS INTERFACE m_axi port = type bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = endIndex bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = floatingCnt bundle = gmem3 offset = slave
+#pragma HLS INTERFACE m_axi port = floatingSize bundle = gmem3 offset = slave
+
+#pragma HLS INTERFACE s_axilite port = numInstruments bundle = control
+#pragma HLS INTERFACE s_axilite port = type bundle = control
+#pragma HLS INTERFACE s_axilite port = timestep bundle = control
+#pragma HLS INTERFACE s_axilite port = initTime bundle = control
+#pragma HLS INTERFACE s_axilite port = initSize bundle = control
+#pragma HLS INTERFACE s_axilite port = endIndex bundle = control
+#pragma HLS INTERFACE s_axilite port = floatingCnt bundle = control
+#pragma HLS INTERFACE s_axilite port = floatingSize bundle = control
+#pragma HLS INTERFACE s_axilite port = cfRate bundle = control
+#pragma HLS INTERFACE s_axilite port = NPV bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+#endif
+
+    DT a = 0.055228873373796609;
+    DT sigma = 0.0061062754654949824;
+    DT flatRate = 0.04875825;
+    DT x0 = 0.0;
+    DT nominal = 1000.0;
+    DT spread = 0.0;
+    int type_in[N];
+    DT init_time[LEN];
+    int end_index[N];
+    int floating_cnt[N * FloatingLen];
+    int floating_size[N];
+    DT cf_rate[N * 2];
+    DT npv[N];
+
+    for (int i = 0; i < initSize; i++) init_time[i] = initTime[i];
+    for (int i = 0; i < numInstruments; i++) {
+        type_in[i] = type[i];
+        end_index[i] = endIndex[i];
+        floating_size[i] = floatingSize[i];
+        cf_rate[2 * i] = cfRate[2 * i];
+        cf_rate[2 * i + 1] = cfRate[2 * i + 1];
+    }
+    for (int i = 0; i < N * FloatingLen; i++) floating_cnt[i] = floatingCnt[i];
+#ifndef __SYNTHESIS__
+    cout << "numInstruments=" << numInstruments << ",timestep=" << timestep << ",initSize=" << initSize << endl;
+#endif
+
+    Model model;
+    model.initialization(flatRate, spread, a, sigma);
+    Process process;
+    process.init(a, sigma, 0.0, 0.0);
+
+    treeCapFloorBatchEngine<DT, Model, Process, DIM, LEN, LEN2>(model, process, numInstruments, type_in, timestep,
+                                                                init_time, initSize, end_index, floating_cnt,
+                                                                floating_size, flatRate, nominal, cf_rate, x0, spread,
+                                                                npv);
+
+    for (int i = 0; i < numInstruments; i++) NPV[i] = npv[i];
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HLS_TEST
+#include "xcl2.hpp"
+#endif
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <sys/time.h>
+#include "ap_int.h"
+#include "utils.hpp"
+#include "tree_engine_kernel.hpp"
+
+#define XCL_BANK(n) (((unsigned int)(n)) | XCL_MEM_TOPOLOGY)
+
+#define XCL_BANK0 XCL_BANK(0)
+#define XCL_BANK1 XCL_BANK(1)
+#define XCL_BANK2 XCL_BANK(2)
+#define XCL_BANK3 XCL_BANK(3)
+#define XCL_BANK4 XCL_BANK(4)
+#define XCL_BANK5 XCL_BANK(5)
+#define XCL_BANK6 XCL_BANK(6)
+#define XCL_BANK7 XCL_BANK(7)
+#define XCL_BANK8 XCL_BANK(8)
+#define XCL_BANK9 XCL_BANK(9)
+#define XCL_BANK10 XCL_BANK(10)
+#define XCL_BANK11 XCL_BANK(11)
+#define XCL_BANK12 XCL_BANK(12)
+#define XCL_BANK13 XCL_BANK(13)
+#define XCL_BANK14 XCL_BANK(14)
+#define XCL_BANK15 XCL_BANK(15)
+
+class ArgParser {
+   public:
+    ArgParser(int& argc, const char** argv) {
+        for (int i = 1; i < argc; ++i) mTokens.push_back(std::string(argv[i]));
+    }
+    bool getCmdOption(const std::string option, std::string& value) const {
+        std::vector<std::string>::const_iterator itr;
+        itr = std::find(this->mTokens.begin(), this->mTokens.end(), option);
+        if (itr != this->mTokens.end() && ++itr != this->mTokens.end()) {
+            value = *itr;
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    std::vector<std::string> mTokens;
+};
+
+int main(int argc, const char* argv[]) {
+    std::cout << "\n----------------------Tree Bermudan (HullWhite) Batch Engine-----------------\n";
+    // cmd parser
+    ArgParser parser(argc, argv);
+    std::string xclbin_path;
+#ifndef HLS_TEST
+    if (!parser.getCmdOption("-xclbin", xclbin_path)) {
+        std::cout << "ERROR:xclbin path is not set!\n";
+        return 1;
+    }
+#endif
+    // Allocate Memory in Host Memory
+    int* type_alloc = aligned_alloc<int>(N);
+    DT* fixedRate_alloc = aligned_alloc<DT>(N);
+    DT* initTime_alloc = aligned_alloc<DT>(InitLen);
+    int* endIndex_alloc = aligned_alloc<int>(N);
+    int* exerciseCnt_alloc = aligned_alloc<int>(N * ExerciseLen);
+    int* exerciseSize_alloc = aligned_alloc<int>(N);
+    int* floatingCnt_alloc = aligned_alloc<int>(N * FloatingLen);
+    int* floatingSize_alloc = aligned_alloc<int>(N);
+    int* fixedCnt_alloc = aligned_alloc<int>(N * FixedLen);
+    int* fixedSize_alloc = aligned_alloc<int>(N);
+    DT* output = aligned_alloc<DT>(N);
+
+    // -------------setup k0 params---------------
+    int err = 0;
+    DT minErr = 10e-10;
+    int timestep = 50;
+    cout << "timestep=" << timestep << endl;
+
+    // ATM, OTM and ITM Bermudan swaptions on the same schedule, and a shorter one ending at the 8th timepoint
+    double golden[N] = {13.19031464334458, 2.6408964976379234, 42.372676709470298, 7.5601498828626967};
+    double fixedATMRate = 0.049995924285639641;
+    double fixedRate[N] = {fixedATMRate, fixedATMRate * 1.2, fixedATMRate * 0.8, fixedATMRate};
+    int endIndex[N] = {11, 11, 11, 7};
+    double initTime[12] = {0,
+                           1,
+                           1.4958904109589042,
+                           2,
+                           2.4986301369863013,
+                           3.0027397260273974,
+                           3.4986301369863013,
+                           4.0027397260273974,
+                           4.4986301369863018,
+                           5.0027397260273974,
+                           5.4986301369863018,
+                           6.0027397260273974};
+
+    int initSize = 12;
+    int exerciseCnt[5] = {0, 2, 4, 6, 8};
+    int fixedCnt[5] = {0, 2, 4, 6, 8};
+    int floatingCnt[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    // the shorter swaption has the first counts of the others
+    int exerciseSize[N] = {5, 5, 5, 3};
+    int fixedSize[N] = {5, 5, 5, 3};
+    int floatingSize[N] = {10, 10, 10, 6};
+
+    for (int i = 0; i < initSize; i++) {
+        initTime_alloc[i] = initTime[i];
+    }
+
+    for (int n = 0; n < N; n++) {
+        type_alloc[n] = 0;
+        fixedRate_alloc[n] = fixedRate[n];
+        endIndex_alloc[n] = endIndex[n];
+        exerciseSize_alloc[n] = exerciseSize[n];
+        fixedSize_alloc[n] = fixedSize[n];
+        floatingSize_alloc[n] = floatingSize[n];
+    }
+
+    int exerciseOffset = 0, fixedOffset = 0, floatingOffset = 0;
+    for (int n = 0; n < N; n++) {
+        for (int i = 0; i < exerciseSize[n]; i++) exerciseCnt_alloc[exerciseOffset++] = exerciseCnt[i];
+        for (int i = 0; i < fixedSize[n]; i++) fixedCnt_alloc[fixedOffset++] = fixedCnt[i];
+        for (int i = 0; i < floatingSize[n]; i++) floatingCnt_alloc[floatingOffset++] = floatingCnt[i];
+    }
+    for (int i = exerciseOffset; i < N * ExerciseLen; i++) exerciseCnt_alloc[i] = 0;
+    for (int i = fixedOffset; i < N * FixedLen; i++) fixedCnt_alloc[i] = 0;
+    for (int i = floatingOffset; i < N * FloatingLen; i++) floatingCnt_alloc[i] = 0;
+
+#ifndef HLS_TEST
+    // do pre-process on CPU
+    struct timeval start_time, end_time, test_time;
+    // platform related operations
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Creating Context and Command Queue for selected Device
+    cl::Context context(device);
+    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
+    std::string devName = device.getInfo<CL_DEVICE_NAME>();
+    printf("Found Device=%s\n", devName.c_str());
+
+    cl::Program::Binaries xclBins = xcl::import_binary_file(xclbin_path);
+    devices.resize(1);
+    cl::Program program(context, devices, xclBins);
+    cl::Kernel kernel_TreeBermudanEngine(program, "TREE_k0");
+    std::cout << "kernel has been created" << std::endl;
+
+    cl_mem_ext_ptr_t mext_o[11];
+    mext_o[0].obj = output;
+    mext_o[1].obj = initTime_alloc;
+    mext_o[2].obj = fixedRate_alloc;
+    mext_o[3].obj = type_alloc;
+    mext_o[4].obj = endIndex_alloc;
+    mext_o[5].obj = exerciseCnt_alloc;
+    mext_o[6].obj = exerciseSize_alloc;
+    mext_o[7].obj = floatingCnt_alloc;
+    mext_o[8].obj = floatingSize_alloc;
+    mext_o[9].obj = fixedCnt_alloc;
+    mext_o[10].obj = fixedSize_alloc;
+    for (int i = 0; i < 11; ++i) {
+        mext_o[i].param = 0;
+#ifndef USE_HBM
+        mext_o[i].flags = XCL_MEM_DDR_BANK0;
+#else
+        mext_o[i].flags = XCL_BANK0;
+#endif
+    }
+
+    // create device buffer and map dev buf to host buf
+    size_t bufSize[11] = {sizeof(DT) * N,
+                          sizeof(DT) * InitLen,
+                          sizeof(DT) * N,
+                          sizeof(int) * N,
+                          sizeof(int) * N,
+                          sizeof(int) * N * ExerciseLen,
+                          sizeof(int) * N,
+                          sizeof(int) * N * FloatingLen,
+                          sizeof(int) * N,
+                          sizeof(int) * N * FixedLen,
+                          sizeof(int) * N};
+    cl::Buffer buf[11];
+    for (int i = 0; i < 11; ++i) {
+        buf[i] = cl::Buffer(context, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE, bufSize[i],
+                            &mext_o[i]);
+    }
+
+    std::vector<cl::Memory> ob_in;
+    for (int i = 1; i < 11; ++i) ob_in.push_back(buf[i]);
+    std::vector<cl::Memory> ob_out;
+    ob_out.push_back(buf[0]);
+
+    q.enqueueMigrateMemObjects(ob_in, 0, nullptr, nullptr);
+    q.finish();
+    // launch kernel and calculate kernel execution time
+    std::cout << "kernel start------" << std::endl;
+    gettimeofday(&start_time, 0);
+    kernel_TreeBermudanEngine.setArg(0, N);
+    kernel_TreeBermudanEngine.setArg(1, buf[3]);
+    kernel_TreeBermudanEngine.setArg(2, buf[2]);
+    kernel_TreeBermudanEngine.setArg(3, timestep);
+    kernel_TreeBermudanEngine.setArg(4, buf[1]);
+    kernel_TreeBermudanEngine.setArg(5, initSize);
+    kernel_TreeBermudanEngine.setArg(6, buf[4]);
+    kernel_TreeBermudanEngine.setArg(7, buf[5]);
+    kernel_TreeBermudanEngine.setArg(8, buf[6]);
+    kernel_TreeBermudanEngine.setArg(9, buf[7]);
+    kernel_TreeBermudanEngine.setArg(10, buf[8]);
+    kernel_TreeBermudanEngine.setArg(11, buf[9]);
+    kernel_TreeBermudanEngine.setArg(12, buf[10]);
+    kernel_TreeBermudanEngine.setArg(13, buf[0]);
+
+    q.enqueueTask(kernel_TreeBermudanEngine, nullptr, nullptr);
+
+    q.finish();
+    gettimeofday(&end_time, 0);
+    std::cout << "kernel end------" << std::endl;
+    std::cout << "Execution time " << tvdiff(&start_time, &end_time) << "us" << std::endl;
+    q.enqueueMigrateMemObjects(ob_out, 1, nullptr, nullptr);
+    q.finish();
+#else
+    TREE_k0(N, type_alloc, fixedRate_alloc, timestep, initTime_alloc, initSize, endIndex_alloc, exerciseCnt_alloc,
+            exerciseSize_alloc, floatingCnt_alloc, floatingSize_alloc, fixedCnt_alloc, fixedSize_alloc, output);
+#endif
+    for (int n = 0; n < N; n++) {
+        DT out = output[n];
+        if (std::fabs(out - golden[n]) > minErr) err++;
+        std::cout << "NPV[" << n << "]= " << std::setprecision(15) << out
+                  << " ,diff/NPV= " << (out - golden[n]) / golden[n] << std::endl;
+    }
+    return err;
+}
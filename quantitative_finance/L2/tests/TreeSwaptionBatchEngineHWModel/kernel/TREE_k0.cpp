@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tree_engine_kernel.hpp"
+#ifndef __SYNTHESIS__
+#include <iostream>
+using namespace std;
+#endif
+
+extern "C" void TREE_k0(int numInstruments,
+                        int type[N],
+                        DT fixedRate[N],
+                        int timestep,
+                        DT initTime[InitLen],
+                        int initSize,
+                        int endIndex[N],
+                        int exerciseCnt[N * ExerciseLen],
+                        int exerciseSize[N],
+                        int floatingCnt[N * FloatingLen],
+                        int floatingSize[N],
+                        int fixedCnt[N * FixedLen],
+                        int fixedSize[N],
+                        DT NPV[N]) {
+#ifndef HLS_TEST
+#pragma HLS INTERFACE m_axi port = NPV bundle = gmem0 offset = slave
+#pragma HLS INTERFACE m_axi port = initTime bundle = gmem1 offset = slave
+#pragma HLS INTERFACE m_axi port = fixedRate bundle = gmem1 offset = slave
+#pragma HLS INTERFACE m_axi port = type bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = endIndex bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = exerciseCnt bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = exerciseSize bundle = gmem2 offset = slave
+#pragma HLS INTERFACE m_axi port = floatingCnt bundle = gmem3 offset = slave
+#pragma HLS INTERFACE m_axi port = floatingSize bundle = gmem3 offset = slave
+#pragma HLS INTERFACE m_axi port = fixedCnt bundle = gmem4 offset = slave
+#pragma HLS INTERFACE m_axi port = fixedSize bundle = gmem4 offset = slave
+
+#pragma HLS INTERFACE s_axilite port = numInstruments bundle = control
+#pragma HLS INTERFACE s_axilite port = type bundle = control
+#pragma HLS INTERFACE s_axilite port = fixedRate bundle = control
+#pragma HLS INTERFACE s_axilite port = timestep bundle = control
+#pragma HLS INTERFACE s_axilite port = initTime bundle = control
+#pragma HLS INTERFACE s_axilite port = initSize bundle = control
+#pragma HLS INTERFACE s_axilite port = endIndex bundle = control
+#pragma HLS INTERFACE s_axilite port = exerciseCnt bundle = control
+#pragma HLS INTERFACE s_axilite port = exerciseSize bundle = control
+#pragma HLS INTERFACE s_axilite port = floatingCnt bundle = control
+#pragma HLS INTERFACE s_axilite port = floatingSize bundle = control
+#pragma HLS INTERFACE s_axilite port = fixedCnt bundle = control
+#pragma HLS INTERFACE s_axilite port = fixedSize bundle = control
+#pragma HLS INTERFACE s_axilite port = NPV bundle = control
+#pragma HLS INTERFACE s_axilite port = return bundle = control
+#endif
+
+    DT a = 0.055228873373796609;
+    DT sigma = 0.0061062754654949824;
+    DT flatRate = 0.04875825;
+    DT x0 = 0.0;
+    DT nominal = 1000.0;
+    DT spread = 0.0;
+    int type_in[N];
+    DT fixed_rate[N];
+    DT init_time[LEN];
+    int end_index[N];
+    int exercise_cnt[N * ExerciseLen];
+    int exercise_size[N];
+    int floating_cnt[N * FloatingLen];
+    int floating_size[N];
+    int fixed_cnt[N * FixedLen];
+    int fixed_size[N];
+    DT npv[N];
+
+    for (int i = 0; i < initSize; i++) init_time[i] = initTime[i];
+    for (int i = 0; i < numInstruments; i++) {
+        type_in[i] = type[i];
+        fixed_rate[i] = fixedRate[i];
+        end_index[i] = endIndex[i];
+        exercise_size[i] = exerciseSize[i];
+        floating_size[i] = floatingSize[i];
+        fixed_size[i] = fixedSize[i];
+    }
+    for (int i = 0; i < N * ExerciseLen; i++) exercise_cnt[i] = exerciseCnt[i];
+    for (int i = 0; i < N * FloatingLen; i++) floating_cnt[i] = floatingCnt[i];
+    for (int i = 0; i < N * FixedLen; i++) fixed_cnt[i] = fixedCnt[i];
+#ifndef __SYNTHESIS__
+    cout << "numInstruments=" << numInstruments << ",timestep=" << timestep << ",initSize=" << initSize << endl;
+#endif
+
+    Model model;
+    model.initialization(flatRate, spread, a, sigma);
+    Process process;
+    process.init(a, sigma, 0.0, 0.0);
+
+    treeSwaptionBatchEngine<DT, Model, Process, DIM, LEN, LEN2>(
+        model, process, numInstruments, type_in, fixed_rate, timestep, init_time, initSize, end_index, exercise_cnt,
+        exercise_size, floating_cnt, floating_size, fixed_cnt, fixed_size, flatRate, nominal, x0, spread, npv);
+
+    for (int i = 0; i < numInstruments; i++) NPV[i] = npv[i];
+}
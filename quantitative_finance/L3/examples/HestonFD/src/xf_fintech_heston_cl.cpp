@@ -124,6 +124,26 @@ int main(int argc, char* argv[]) {
             std::cout << "ERROR: failed to calculate the NPV!!" << std::endl;
         }
 
+        if (retval == XLNX_OK) {
+            // price a strip of strikes and maturities around the option above in one batch, the options share the
+            // grid and the assembled system and the shorter maturities are continued to the longer ones
+            const unsigned int numOptions = 6;
+            double strikes[numOptions] = {K * 0.9, K, K * 1.1, K * 0.9, K, K * 1.1};
+            double maturities[numOptions] = {T / 2, T / 2, T / 2, T, T, T};
+            double prices[numOptions];
+
+            retval = fdHeston.run(S, strikes, rd, V, maturities, kappa, sigma, rho, eta, N, numOptions, prices);
+
+            if (retval == XLNX_OK) {
+                std::cout << std::endl << "Batch Duration: " << fdHeston.getLastRunTime() << " us" << std::endl;
+                for (unsigned int i = 0; i < numOptions; i++) {
+                    std::cout << "K: " << strikes[i] << " T: " << maturities[i] << " NPV: " << prices[i] << std::endl;
+                }
+            } else {
+                std::cout << "ERROR: failed to calculate the batch NPVs!!" << std::endl;
+            }
+        }
+
         if (retval == XLNX_OK) {
             // release the device...
             retval = fdHeston.releaseDevice();
@@ -176,6 +176,74 @@ class FDHeston : public OCLController {
             double* pVolga,
             double* pVanna);
 
+    /**
+     * Calculate the prices of a batch of call options on the same underlying with the default number of steps.
+     *
+     * The options share one grid and one assembled ADI system, only the payoff differs between strikes. Options
+     * with the same strike are solved in order of maturity, each one continuing from the price grid of the previous
+     * one. With the same time step this gives the same grid as solving the option on its own from the payoff. The
+     * grid is concentrated around the mean strike, so the strikes of a batch should lie reasonably close to each
+     * other.
+     *
+     * @param stockPrice the stock price
+     * @param strikePrice the strike prices of the options
+     * @param riskFreeRateDomestic the risk free domestic interest rate
+     * @param volatility the volatility
+     * @param timeToMaturity the times to maturity of the options
+     * @param meanReversionRate the mean reversion rate (kappa)
+     * @param volatilityOfVolatility the volatility of volatility (sigma)
+     * @param correlationCoefficient the correlation coefficient (rho)
+     * @param longRunAveragePrice the returned option price (eta)
+     * @param numOptions the number of options
+     * @param pOptionPrice the returned option prices
+     *
+     */
+    int run(double stockPrice,
+            double* strikePrice,
+            double riskFreeRateDomestic,
+            double volatility,
+            double* timeToMaturity,
+            double meanReversionRate,
+            double volatilityOfVolatility,
+            double correlationCoefficient,
+            double longRunAveragePrice,
+            unsigned int numOptions,
+            double* pOptionPrice);
+
+    /**
+     * Calculate the prices of a batch of call options on the same underlying with a configurable number of steps.
+     *
+     * As above, the number of steps applies to the longest maturity and sets the time step of the whole batch. A
+     * maturity between two steps is interpolated linearly in time between the price grids of those steps. That
+     * error is of order dt^2, against order dt for a maturity rounded to the nearest step.
+     *
+     * @param stockPrice the stock price
+     * @param strikePrice the strike prices of the options
+     * @param riskFreeRateDomestic the risk free domestic interest rate
+     * @param volatility the volatility
+     * @param timeToMaturity the times to maturity of the options
+     * @param meanReversionRate the mean reversion rate (kappa)
+     * @param volatilityOfVolatility the volatility of volatility (sigma)
+     * @param correlationCoefficient the correlation coefficient (rho)
+     * @param longRunAveragePrice the returned option price (eta)
+     * @param numSteps the number of steps to the longest maturity
+     * @param numOptions the number of options
+     * @param pOptionPrice the returned option prices
+     *
+     */
+    int run(double stockPrice,
+            double* strikePrice,
+            double riskFreeRateDomestic,
+            double volatility,
+            double* timeToMaturity,
+            double meanReversionRate,
+            double volatilityOfVolatility,
+            double correlationCoefficient,
+            double longRunAveragePrice,
+            int numSteps,
+            unsigned int numOptions,
+            double* pOptionPrice);
+
     // The following interface is intended for Xilinx internal use only.
     int run(double stockPrice,
             double strikePrice,
@@ -17,6 +17,7 @@
 #ifndef _XF_FINTECH_HCF_H_
 #define _XF_FINTECH_HCF_H_
 
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -66,6 +67,18 @@ class hcf : public OCLController {
      */
     int run(struct hcf_input_data* inputData, float* outputData, int numOptions);
 
+    /**
+     * Calculate the options of a strip of strikes sharing one model. The characteristic
+     * function is evaluated once for the whole strip, so this is much faster than run()
+     * with one option per strike. Needs the strip kernel in the xclbin.
+     *
+     * @param inputData the model, K is ignored
+     * @param strikes the strike prices
+     * @param outputData the calculated option values, one per strike
+     * @param numStrikes number of strikes, up to 1024
+     */
+    int runStrip(struct hcf_input_data* inputData, float* strikes, float* outputData, int numStrikes);
+
     /**
      * Set the intergation interval width delta w.
      */
@@ -86,8 +99,17 @@ class hcf : public OCLController {
      */
     float get_w_max();
 
+    /**
+     * This method returns the time the execution of the last call to run() or
+     * runStrip() took
+     *
+     * @returns Execution time in microseconds
+     */
+    long long int getLastRunTime(void);
+
    private:
     static const int MAX_OPTION_CALCULATIONS = 1024;
+    static const int MAX_STRIP_STRIKES = 1024;
 
     // OCLController interface
     int createOCLObjects(Device* device);
@@ -98,19 +120,27 @@ class hcf : public OCLController {
     cl::Program::Binaries m_binaries;
     cl::Program* m_pProgram;
     cl::Kernel* m_pHcfKernel;
+    cl::Kernel* m_pHcfStripKernel;
 
     cl::Buffer* m_pHwInputBuffer;
     cl::Buffer* m_pHwOutputBuffer;
+    cl::Buffer* m_pHwStrikeBuffer;
+    cl::Buffer* m_pHwStripOutputBuffer;
 
     std::vector<struct xf::fintech::hcfEngineInputDataType<float>,
                 aligned_allocator<struct xf::fintech::hcfEngineInputDataType<float> > >
         m_hostInputBuffer;
     std::vector<float, aligned_allocator<float> > m_hostOutputBuffer;
+    std::vector<float, aligned_allocator<float> > m_hostStrikeBuffer;
+    std::vector<float, aligned_allocator<float> > m_hostStripOutputBuffer;
 
     int m_w_max; // the upper limit for the integration
     float m_dw;  // the delta w for the integration
 
     std::string getXCLBINName(Device* device);
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
 };
 
 } // end namespace fintech
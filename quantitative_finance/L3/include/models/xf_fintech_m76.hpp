@@ -17,6 +17,7 @@
 #ifndef _XF_FINTECH_M76_H_
 #define _XF_FINTECH_M76_H_
 
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
@@ -63,6 +64,13 @@ class m76 : public OCLController {
      */
     int run(struct m76_input_data* inputData, float* outputData, int numOptions);
 
+    /**
+     * This method returns the time the execution of the last call to run() took
+     *
+     * @returns Execution time in microseconds
+     */
+    long long int getLastRunTime(void);
+
    private:
     static const int MAX_OPTION_CALCULATIONS = 2048;
 
@@ -84,6 +92,9 @@ class m76 : public OCLController {
     std::vector<float, aligned_allocator<float> > m_hostOutputBuffer;
 
     std::string getXCLBINName(Device* device);
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
 };
 
 } // end namespace fintech
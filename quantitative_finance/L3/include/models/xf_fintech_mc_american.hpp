@@ -21,6 +21,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "xf_fintech_device.hpp"
 #include "xf_fintech_ocl_controller.hpp"
@@ -34,6 +35,12 @@ namespace fintech {
  *
  * @brief This class implements the Monte-Carlo American model.
  *
+ * The exercise boundary is given by Longstaff-Schwartz regression coefficients,
+ * calibrated on the card from a set of pre-sampled paths. The coefficients are
+ * kept on the card and a run whose option has the same type, strike and
+ * maturity, and whose market parameters are within the reuse tolerance of the
+ * calibrated ones, prices with them instead of calibrating again. They can also
+ * be exported with getCoefficients() and loaded back with setCoefficients().
  */
 class MCAmerican : public OCLController {
    public:
@@ -89,6 +96,75 @@ class MCAmerican : public OCLController {
             unsigned int requiredSamples,
             double* pOptionPrice);
 
+    /**
+     * Calibrate the regression coefficients for an option, whether or not
+     * cached coefficients could be reused.
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     */
+    int calibrate(OptionType optionType,
+                  double stockPrice,
+                  double strikePrice,
+                  double riskFreeRate,
+                  double dividendYield,
+                  double volatility,
+                  double timeToMaturity);
+
+    /**
+     * Copy the cached regression coefficients to the host, COEF values per
+     * exercise time step.
+     *
+     * @param coefficients the returned coefficients
+     */
+    int getCoefficients(std::vector<double>& coefficients);
+
+    /**
+     * Load regression coefficients, e.g. exported by getCoefficients(), along
+     * with the parameters they were calibrated for.
+     *
+     * @param optionType either American/European Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice the strike price
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity the time to maturity
+     * @param coefficients the coefficients
+     */
+    int setCoefficients(OptionType optionType,
+                        double stockPrice,
+                        double strikePrice,
+                        double riskFreeRate,
+                        double dividendYield,
+                        double volatility,
+                        double timeToMaturity,
+                        std::vector<double>& coefficients);
+
+    /**
+     * Set how far the stock price, risk free rate, dividend yield and
+     * volatility may move, relative to the calibrated values, for the cached
+     * coefficients to be reused. The default 0.0 reuses them for identical
+     * parameters only and a negative value calibrates on every run.
+     *
+     * @param tolerance the relative tolerance
+     */
+    void setCoefficientReuseTolerance(double tolerance);
+
+    /**
+     * Set the number of paths used for calibration, a multiple of 2048 up to
+     * 65536. The default is 4096. The paths are streamed through the memory of
+     * the card, so the count is not bounded by the on-chip buffers.
+     *
+     * @param calibrationSamples the number of calibration paths
+     */
+    int setCalibrationSamples(unsigned int calibrationSamples);
+
    public:
     /**
      * This method returns the time the execution of the last call to run() took
@@ -114,6 +190,22 @@ class MCAmerican : public OCLController {
                     unsigned int requiredSamples,
                     double* pOptionPrice);
 
+    bool coefficientsMatch(OptionType optionType,
+                           double stockPrice,
+                           double strikePrice,
+                           double riskFreeRate,
+                           double dividendYield,
+                           double volatility,
+                           double timeToMaturity);
+
+    void setCalibrationPoint(OptionType optionType,
+                             double stockPrice,
+                             double strikePrice,
+                             double riskFreeRate,
+                             double dividendYield,
+                             double volatility,
+                             double timeToMaturity);
+
    private:
     std::string getXCLBINName(Device* device);
 
@@ -128,6 +220,7 @@ class MCAmerican : public OCLController {
     uint8_t* m_hostOutputPricesBuffer;
     uint8_t* m_hostOutputMatrixBuffer;
     uint8_t* m_hostCoeffBuffer;
+    uint8_t* m_hostFlowBuffer;
     void* m_hostOutputBuffer1;
     void* m_hostOutputBuffer2;
 
@@ -139,15 +232,31 @@ class MCAmerican : public OCLController {
     cl_mem_ext_ptr_t m_outputPriceBufferOptions;
     cl_mem_ext_ptr_t m_outputMatrixBufferOptions;
     cl_mem_ext_ptr_t m_coeffBufferOptions;
+    cl_mem_ext_ptr_t m_flowBufferOptions;
     cl_mem_ext_ptr_t m_outputBufferOptions1;
     cl_mem_ext_ptr_t m_outputBufferOptions2;
 
     cl::Buffer* m_pHWOutputPriceBuffer;
     cl::Buffer* m_pHWOutputMatrixBuffer;
     cl::Buffer* m_pHWCoeffBuffer;
+    cl::Buffer* m_pHWFlowBuffer;
     cl::Buffer* m_pHWOutputBuffer1;
     cl::Buffer* m_pHWOutputBuffer2;
 
+   private:
+    unsigned int m_calibrationSamples;
+    double m_coefficientReuseTolerance;
+
+    // parameters the cached coefficients were calibrated for
+    bool m_bCoefficientsValid;
+    OptionType m_calibOptionType;
+    double m_calibStockPrice;
+    double m_calibStrikePrice;
+    double m_calibRiskFreeRate;
+    double m_calibDividendYield;
+    double m_calibVolatility;
+    double m_calibTimeToMaturity;
+
    private:
     std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
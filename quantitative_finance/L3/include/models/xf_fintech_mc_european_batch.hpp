@@ -0,0 +1,125 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_FINTECH_MC_EUROPEAN_BATCH_H_
+#define _XF_FINTECH_MC_EUROPEAN_BATCH_H_
+
+#include <chrono>
+#include <string>
+
+#include "xf_fintech_ocl_controller.hpp"
+#include "xf_fintech_types.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class MCEuropeanBatch
+ *
+ * @brief This class implements the batch mode of the Monte-Carlo European
+ * model.
+ *
+ * @details All options of a batch share the same underlying and model
+ * parameters and are priced from ONE set of simulated paths, so a whole
+ * strike / maturity surface costs a single simulation. The paths are simulated
+ * on a uniform grid of timeSteps steps up to the longest maturity of the batch.
+ * Each option is evaluated from the grid point nearest to its maturity, rescaled
+ * to its exact maturity, so maturities need not lie on the grid.
+ *
+ * Batches larger than the kernel capacity are split into several kernel runs,
+ * each with its own set of paths.
+ */
+class MCEuropeanBatch : public OCLController {
+   public:
+    MCEuropeanBatch();
+    virtual ~MCEuropeanBatch();
+
+   public:
+    /**
+     * Prices a batch of options on the same underlying for the REQUIRED NUMBER
+     * OF SAMPLES
+     *
+     * @param optionType array of option types, either Call or Put
+     * @param stockPrice the stock price
+     * @param strikePrice array of strike prices
+     * @param riskFreeRate the risk free interest rate
+     * @param dividendYield the dividend yield
+     * @param volatility the volatility
+     * @param timeToMaturity array of times to maturity
+     * @param requiredSamples the number of samples
+     * @param timeSteps the number of steps of the shared time grid, from 1 to 64
+     * @param outputOptionPrice array of returned option prices
+     * @param numOptions the number of options in the batch, at least 1
+     *
+     * @returns XLNX_ERROR_NOT_SUPPORTED if timeSteps or numOptions is out of range
+     */
+    int run(OptionType* optionType,
+            double stockPrice,
+            double* strikePrice,
+            double riskFreeRate,
+            double dividendYield,
+            double volatility,
+            double* timeToMaturity,
+            unsigned int requiredSamples,
+            unsigned int timeSteps,
+            double* outputOptionPrice,
+            unsigned int numOptions);
+
+   public:
+    /**
+     * This method returns the time the execution of the last call to run() took
+     *
+     * @returns Execution time in microseconds
+     */
+    long long int getLastRunTime(void);
+
+   private:
+    // OCLController interface
+    int createOCLObjects(Device* device);
+    int releaseOCLObjects(void);
+
+   private:
+    std::string getXCLBINName(Device* device);
+
+   private:
+    cl::Context* m_pContext;
+    cl::CommandQueue* m_pCommandQueue;
+    cl::Program::Binaries m_binaries;
+    cl::Program* m_pProgram;
+    cl::Kernel* m_pKernel;
+
+    void* m_hostStrike;
+    void* m_hostTimeLength;
+    unsigned int* m_hostOptionType;
+    void* m_hostOutput;
+    unsigned int* m_hostSeed;
+
+    cl::Buffer* m_pStrikeBuf;
+    cl::Buffer* m_pTimeLengthBuf;
+    cl::Buffer* m_pOptionTypeBuf;
+    cl::Buffer* m_pOutputBuf;
+    cl::Buffer* m_pSeedBuf;
+
+   private:
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif //_XF_FINTECH_MC_EUROPEAN_BATCH_H_
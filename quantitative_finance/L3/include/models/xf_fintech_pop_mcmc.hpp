@@ -20,6 +20,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 #include "xf_fintech_device.hpp"
@@ -37,10 +38,22 @@ namespace fintech {
  * The user calls the run() method passing in the number of samples to be
  * generated, the number to be discarded and a sigma value, the method then
  * returns the generated values.
+ *
+ * The runMultiDim() method samples a multi-dimensional target with an
+ * adaptive proposal covariance. The samples are generated in blocks and each
+ * block is handed to a callback while the next one is generated on the card,
+ * so the number of samples is not bounded by the memory of the card.
  */
 
 class PopMCMC : public OCLController {
    public:
+    /**
+     * Receives a block of samples from runMultiDim(). The samples are stored
+     * one after the other, numDims values each. A return value other than
+     * XLNX_OK stops the run, which then returns this value.
+     */
+    typedef std::function<int(const double* samples, int numSamples)> SampleCallback;
+
     PopMCMC();
     virtual ~PopMCMC();
 
@@ -54,6 +67,38 @@ class PopMCMC : public OCLController {
      */
     int run(int numSamples, int numBurnInSamples, double sigma, double* outputData);
 
+    /**
+     * Generate samples of a multi-dimensional target and stream them to a
+     * callback. The target compiled into the kernel is a multivariate normal
+     * distribution, its parameters are the mean followed by the precision
+     * matrix in row-major order.
+     *
+     * @param numDims the number of dimensions, at most getMaxDims().
+     * @param targetParameters the parameters of the target, numDims + numDims * numDims values.
+     * @param initialPoint the starting point of all chains, numDims values.
+     * @param numSamples the number of samples to generate.
+     * @param numBurnInSamples the number samples to discard at the start.
+     * @param sigma the standard deviation of the proposal before it adapts.
+     * @param callback receives the samples, in blocks of at most getBlockSize().
+     */
+    int runMultiDim(int numDims,
+                    std::vector<double>& targetParameters,
+                    double* initialPoint,
+                    int numSamples,
+                    int numBurnInSamples,
+                    double sigma,
+                    SampleCallback callback);
+
+    /**
+     * Maximum number of dimensions of runMultiDim().
+     */
+    int getMaxDims(void);
+
+    /**
+     * Maximum number of samples passed to the callback of runMultiDim() at once.
+     */
+    int getBlockSize(void);
+
     /**
      * This method returns the time the execution of the last call to run() took.
      */
@@ -72,14 +117,21 @@ class PopMCMC : public OCLController {
     cl::Program::Binaries m_binaries;
     cl::Program* m_pProgram;
     cl::Kernel* m_pPopMCMCKernel;
+    cl::Kernel* m_pPopMCMCMultiDimKernel;
 
     cl::Buffer* mBufferInputInv;
     cl::Buffer* mBufferInputSigma;
     cl::Buffer* mBufferOutputSamples;
+    cl::Buffer* mBufferInputParams;
+    cl::Buffer* mBufferState;
+    cl::Buffer* mBufferOutputBlock[2];
 
     std::vector<double, aligned_allocator<double> > m_hostInputBufferInv;
     std::vector<double, aligned_allocator<double> > m_hostInputBufferSigma;
     std::vector<double, aligned_allocator<double> > m_hostOutputBufferSamples;
+    std::vector<double, aligned_allocator<double> > m_hostInputBufferParams;
+    std::vector<double, aligned_allocator<double> > m_hostBufferState;
+    std::vector<double, aligned_allocator<double> > m_hostOutputBufferBlock[2];
 
     std::string getKernelTypeSubString(void);
     std::string getXCLBINName(Device* device);
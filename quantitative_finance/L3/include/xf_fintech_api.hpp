@@ -23,17 +23,20 @@
 
 #include "xf_fintech_device_manager.hpp"
 #include "xf_fintech_device.hpp"
+#include "xf_fintech_engine_pool.hpp"
 #include "xf_fintech_error_codes.hpp"
 #include "xf_fintech_timestamp.hpp"
 #include "xf_fintech_trace.hpp"
 #include "xf_fintech_types.hpp"
 
 #include "models/xf_fintech_cf_black_scholes.hpp"
+#include "models/xf_fintech_cf_black_scholes_iv.hpp"
 #include "models/xf_fintech_cf_black_scholes_merton.hpp"
 #include "models/xf_fintech_cf_garman_kohlhagen.hpp"
 #include "models/xf_fintech_quanto.hpp"
 #include "models/xf_fintech_fd_heston.hpp"
 #include "models/xf_fintech_mc_european.hpp"
+#include "models/xf_fintech_mc_european_batch.hpp"
 #include "models/xf_fintech_mc_european_dje.hpp"
 #include "models/xf_fintech_mc_american.hpp"
 #include "models/xf_fintech_binomialtree.hpp"
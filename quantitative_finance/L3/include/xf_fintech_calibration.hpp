@@ -0,0 +1,399 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_FINTECH_CALIBRATION_H_
+#define _XF_FINTECH_CALIBRATION_H_
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "xf_fintech_error_codes.hpp"
+
+// L1 Jacobi SVD, used on the host to solve the damped normal equations
+#include "xf_fintech/jacobi_svd.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class Calibrator
+ *
+ * @brief Calibrates the parameters of a model to market prices with the Levenberg-Marquardt method.
+ *
+ * The model is priced through a batch pricer, a callable which prices the whole instrument set for several
+ * parameter sets in one call, typically one run() of a model on the device. Each iteration makes exactly one call,
+ * pricing the trial parameters together with one forward bump of each parameter, so the Jacobian is available as
+ * soon as a trial is accepted. The damped normal equations are solved with the Jacobi SVD of the L1 library, with
+ * singular values that are negligible compared to the largest one treated as zero, so parameters the instruments
+ * are not sensitive to are left unchanged.
+ *
+ * Parameters are kept within the bounds; a bump that would leave them is taken downwards, or when the bounds are
+ * closer together than the bump, to the bound furthest from the parameter.
+ *
+ * @tparam NumParams the number of model parameters.
+ */
+template <int NumParams>
+class Calibrator {
+   public:
+    /**
+     * Prices every instrument for each parameter set. parameterSets holds one vector of NumParams parameters per
+     * set and prices receives the prices of the instruments, one set after the other. Returns XLNX_OK or the error
+     * code of the model.
+     */
+    typedef std::function<int(std::vector<std::vector<double> >& parameterSets, std::vector<double>& prices)>
+        BatchPricer;
+
+    /**
+     * Creates the calibrator.
+     *
+     * @param pricer the batch pricer of the model
+     */
+    Calibrator(BatchPricer pricer)
+        : m_pricer(pricer),
+          m_maxIterations(DEFAULT_MAX_ITERATIONS),
+          m_tolerance(DEFAULT_TOLERANCE),
+          m_bumpSize(DEFAULT_BUMP_SIZE),
+          m_lastRMSE(0.0),
+          m_lastNumIterations(0),
+          m_lastNumPricerCalls(0),
+          m_bConverged(false) {
+        for (int i = 0; i < NumParams; i++) {
+            m_lowerBound[i] = -HUGE_VAL;
+            m_upperBound[i] = HUGE_VAL;
+        }
+    }
+
+    virtual ~Calibrator() {}
+
+    /**
+     * Sets the bounds of the parameters.
+     *
+     * @param pLowerBound NumParams lower bounds
+     * @param pUpperBound NumParams upper bounds
+     */
+    void setBounds(double* pLowerBound, double* pUpperBound) {
+        for (int i = 0; i < NumParams; i++) {
+            m_lowerBound[i] = pLowerBound[i];
+            m_upperBound[i] = pUpperBound[i];
+        }
+    }
+
+    /**
+     * Sets the weight of each instrument in the sum of squared errors, e.g. the inverse of its vega. By default
+     * every instrument has a weight of one.
+     */
+    void setWeights(std::vector<double>& weights) { m_weights = weights; }
+
+    /**
+     * Sets the maximum number of iterations.
+     */
+    void setMaxIterations(unsigned int maxIterations) { m_maxIterations = maxIterations; }
+
+    /**
+     * Sets the relative tolerance on the change of the parameters and of the sum of squared errors.
+     */
+    void setTolerance(double tolerance) { m_tolerance = tolerance; }
+
+    /**
+     * Sets the size of the bumps, relative to the parameter, or absolute for parameters smaller than one.
+     */
+    void setBumpSize(double bumpSize) { m_bumpSize = bumpSize; }
+
+    /**
+     * Calibrates the parameters.
+     *
+     * @param marketPrices the market prices of the instruments
+     * @param pParameters NumParams parameters, the initial guess on input and the calibrated parameters on output
+     */
+    int calibrate(std::vector<double>& marketPrices, double* pParameters) {
+        int retval = XLNX_OK;
+        unsigned int numInstruments = marketPrices.size();
+
+        m_runStartTime = std::chrono::high_resolution_clock::now();
+
+        m_lastNumIterations = 0;
+        m_lastNumPricerCalls = 0;
+        m_bConverged = false;
+
+        if (numInstruments == 0 || (m_weights.size() != 0 && m_weights.size() != numInstruments)) {
+            retval = XLNX_ERROR_NOT_SUPPORTED;
+        }
+
+        std::vector<double> weights(numInstruments, 1.0);
+        if (m_weights.size() == numInstruments) {
+            weights = m_weights;
+        }
+
+        double x[NumParams];
+        for (int i = 0; i < NumParams; i++) {
+            x[i] = clamp(pParameters[i], i);
+        }
+
+        // residuals r = market - model and Jacobian of the model prices at x
+        std::vector<double> r(numInstruments);
+        std::vector<double> J(numInstruments * NumParams);
+        double cost = 0.0;
+
+        if (retval == XLNX_OK) {
+            retval = evaluate(x, marketPrices, weights, r, J, cost);
+        }
+
+        double lambda = INITIAL_DAMPING;
+        double nu = 2.0;
+
+        while (retval == XLNX_OK && !m_bConverged && m_lastNumIterations < m_maxIterations) {
+            m_lastNumIterations++;
+
+            // normal equations A = J^T W J, g = J^T W r
+            double A[NumParams][NumParams];
+            double g[NumParams];
+            double maxA = 0.0;
+            for (int i = 0; i < NumParams; i++) {
+                g[i] = 0.0;
+                for (unsigned int k = 0; k < numInstruments; k++) {
+                    g[i] += J[k * NumParams + i] * weights[k] * r[k];
+                }
+                for (int j = 0; j < NumParams; j++) {
+                    A[i][j] = 0.0;
+                    for (unsigned int k = 0; k < numInstruments; k++) {
+                        A[i][j] += J[k * NumParams + i] * weights[k] * J[k * NumParams + j];
+                    }
+                    maxA = std::fmax(maxA, std::fabs(A[i][j]));
+                }
+            }
+
+            if (maxA == 0.0) {
+                // the prices do not depend on any of the parameters
+                m_bConverged = true;
+                break;
+            }
+
+            double delta[NumParams];
+            solveDamped(A, g, lambda, delta);
+
+            double xTrial[NumParams];
+            double stepNorm = 0.0;
+            double xNorm = 0.0;
+            for (int i = 0; i < NumParams; i++) {
+                xTrial[i] = clamp(x[i] + delta[i], i);
+                delta[i] = xTrial[i] - x[i];
+                stepNorm += delta[i] * delta[i];
+                xNorm += x[i] * x[i];
+            }
+
+            if (std::sqrt(stepNorm) <= m_tolerance * (std::sqrt(xNorm) + m_tolerance)) {
+                m_bConverged = true;
+                break;
+            }
+
+            std::vector<double> rTrial(numInstruments);
+            std::vector<double> JTrial(numInstruments * NumParams);
+            double costTrial = 0.0;
+            retval = evaluate(xTrial, marketPrices, weights, rTrial, JTrial, costTrial);
+            if (retval != XLNX_OK) {
+                break;
+            }
+
+            // reduction predicted by the linear model, delta^T (lambda D delta + g)
+            double predicted = 0.0;
+            for (int i = 0; i < NumParams; i++) {
+                predicted += delta[i] * (lambda * dampingDiagonal(A, i) * delta[i] + g[i]);
+            }
+            double rho = (predicted > 0.0) ? (cost - costTrial) / predicted : -1.0;
+
+            if (costTrial < cost && rho > 0.0) {
+                bool bSmallReduction = (cost - costTrial) <= m_tolerance * cost;
+                for (int i = 0; i < NumParams; i++) {
+                    x[i] = xTrial[i];
+                }
+                r.swap(rTrial);
+                J.swap(JTrial);
+                cost = costTrial;
+                double factor = 1.0 - std::pow(2.0 * rho - 1.0, 3);
+                lambda *= (factor > 1.0 / 3.0) ? factor : 1.0 / 3.0;
+                nu = 2.0;
+                m_bConverged = bSmallReduction;
+            } else {
+                lambda *= nu;
+                nu *= 2.0;
+            }
+        }
+
+        if (retval == XLNX_OK) {
+            for (int i = 0; i < NumParams; i++) {
+                pParameters[i] = x[i];
+            }
+            m_lastRMSE = std::sqrt(cost / numInstruments);
+        }
+
+        m_runEndTime = std::chrono::high_resolution_clock::now();
+
+        return retval;
+    }
+
+    /**
+     * Returns the root mean square of the weighted errors at the calibrated parameters.
+     */
+    double getLastRMSE(void) { return m_lastRMSE; }
+
+    /**
+     * Returns the number of iterations of the last calibration.
+     */
+    unsigned int getLastNumIterations(void) { return m_lastNumIterations; }
+
+    /**
+     * Returns the number of calls to the batch pricer of the last calibration.
+     */
+    unsigned int getLastNumPricerCalls(void) { return m_lastNumPricerCalls; }
+
+    /**
+     * Returns true if the last calibration met the tolerance before the maximum number of iterations.
+     */
+    bool hasConverged(void) { return m_bConverged; }
+
+    /**
+     * This method returns the time the execution of the last call to calibrate() took.
+     */
+    long long int getLastRunTime(void) {
+        return (long long int)std::chrono::duration_cast<std::chrono::microseconds>(m_runEndTime - m_runStartTime)
+            .count();
+    }
+
+   private:
+    static const unsigned int DEFAULT_MAX_ITERATIONS = 100;
+    static constexpr double DEFAULT_TOLERANCE = 1e-8;
+    static constexpr double DEFAULT_BUMP_SIZE = 1e-4;
+    static constexpr double INITIAL_DAMPING = 1e-3;
+    static constexpr double SINGULAR_VALUE_CUTOFF = 1e-12;
+
+    double clamp(double value, int i) {
+        return (value < m_lowerBound[i]) ? m_lowerBound[i] : ((value > m_upperBound[i]) ? m_upperBound[i] : value);
+    }
+
+    double dampingDiagonal(double A[NumParams][NumParams], int i) { return (A[i][i] > 0.0) ? A[i][i] : 1.0; }
+
+    // prices x and its bumps in one call, returns the residuals, the Jacobian and the weighted sum of squares
+    int evaluate(double* x,
+                 std::vector<double>& marketPrices,
+                 std::vector<double>& weights,
+                 std::vector<double>& r,
+                 std::vector<double>& J,
+                 double& cost) {
+        int retval = XLNX_OK;
+        unsigned int numInstruments = marketPrices.size();
+        double bump[NumParams];
+
+        std::vector<std::vector<double> > parameterSets(NumParams + 1, std::vector<double>(x, x + NumParams));
+        for (int i = 0; i < NumParams; i++) {
+            double scale = std::fabs(x[i]);
+            bump[i] = m_bumpSize * ((scale > 1.0) ? scale : 1.0);
+            if (x[i] + bump[i] > m_upperBound[i]) {
+                if (x[i] - bump[i] >= m_lowerBound[i]) {
+                    bump[i] = -bump[i];
+                } else if (m_upperBound[i] - x[i] >= x[i] - m_lowerBound[i]) {
+                    // the bounds are closer than the bump, so bump to the further one
+                    bump[i] = m_upperBound[i] - x[i];
+                } else {
+                    bump[i] = m_lowerBound[i] - x[i];
+                }
+            }
+            parameterSets[i + 1][i] += bump[i];
+        }
+
+        std::vector<double> prices;
+        retval = m_pricer(parameterSets, prices);
+        m_lastNumPricerCalls++;
+
+        if (retval == XLNX_OK && prices.size() != (NumParams + 1) * numInstruments) {
+            retval = XLNX_ERROR_MODEL_INTERNAL_ERROR;
+        }
+
+        if (retval == XLNX_OK) {
+            cost = 0.0;
+            for (unsigned int k = 0; k < numInstruments; k++) {
+                r[k] = marketPrices[k] - prices[k];
+                cost += weights[k] * r[k] * r[k];
+                for (int i = 0; i < NumParams; i++) {
+                    // a parameter fixed by equal bounds has no bump and is left unchanged
+                    J[k * NumParams + i] =
+                        (bump[i] != 0.0) ? (prices[(i + 1) * numInstruments + k] - prices[k]) / bump[i] : 0.0;
+                }
+            }
+        }
+
+        return retval;
+    }
+
+    // solves (A + lambda D) delta = g with D the diagonal of A, through the SVD of the symmetric matrix
+    void solveDamped(double A[NumParams][NumParams], double* g, double lambda, double* delta) {
+        double M[NumParams][NumParams];
+        double sigma[NumParams][NumParams];
+        double U[NumParams][NumParams];
+        double V[NumParams][NumParams];
+
+        for (int i = 0; i < NumParams; i++) {
+            for (int j = 0; j < NumParams; j++) {
+                M[i][j] = A[i][j];
+            }
+            M[i][i] += lambda * dampingDiagonal(A, i);
+        }
+
+        svd<double, NumParams>(M, sigma, U, V);
+
+        double maxSigma = 0.0;
+        for (int i = 0; i < NumParams; i++) {
+            maxSigma = std::fmax(maxSigma, sigma[i][i]);
+            delta[i] = 0.0;
+        }
+        for (int i = 0; i < NumParams; i++) {
+            if (sigma[i][i] > SINGULAR_VALUE_CUTOFF * maxSigma) {
+                double u = 0.0;
+                for (int k = 0; k < NumParams; k++) {
+                    u += U[k][i] * g[k];
+                }
+                u /= sigma[i][i];
+                for (int j = 0; j < NumParams; j++) {
+                    delta[j] += u * V[j][i];
+                }
+            }
+        }
+    }
+
+    BatchPricer m_pricer;
+
+    double m_lowerBound[NumParams];
+    double m_upperBound[NumParams];
+    std::vector<double> m_weights;
+    unsigned int m_maxIterations;
+    double m_tolerance;
+    double m_bumpSize;
+
+    double m_lastRMSE;
+    unsigned int m_lastNumIterations;
+    unsigned int m_lastNumPricerCalls;
+    bool m_bConverged;
+
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runStartTime;
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_runEndTime;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif //_XF_FINTECH_CALIBRATION_H_
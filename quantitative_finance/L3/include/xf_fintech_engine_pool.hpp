@@ -0,0 +1,322 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_FINTECH_ENGINE_POOL_H_
+#define _XF_FINTECH_ENGINE_POOL_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "xf_fintech_device.hpp"
+#include "xf_fintech_error_codes.hpp"
+
+namespace xf {
+namespace fintech {
+
+/**
+ * @class EnginePool
+ *
+ * @brief Runs requests to a model asynchronously on a pool of devices.
+ *
+ * One model object of type ControllerT is created per device and claims it
+ * for the lifetime of the pool, so the kernel stays resident between requests.
+ * Each device has its own work queue served by a worker thread. A request is
+ * a callable taking the model object, which typically calls one of its run()
+ * methods. It is queued on the device with the fewest outstanding requests and
+ * a future is returned, which becomes ready when the request has run. If the
+ * request throws, the exception is stored in the future and the worker carries
+ * on with the next request.
+ *
+ * @tparam ControllerT the model class, derived from OCLController.
+ */
+template <typename ControllerT>
+class EnginePool {
+   public:
+    /**
+     * Outcome of a request.
+     */
+    struct Result {
+        /**
+         * Return value of the request, or XLNX_ERROR_ENGINE_POOL_NOT_RUNNING if
+         * it was not run.
+         */
+        int retval;
+        /**
+         * Index of the device the request ran on.
+         */
+        unsigned int deviceIndex;
+        /**
+         * Time the request waited in the queue of the device, in microseconds.
+         */
+        long long int queueTime;
+        /**
+         * Time the engine took to run, in microseconds. This is the
+         * getLastRunTime() of the model object after the request, or the time
+         * the request took if the model has no getLastRunTime().
+         */
+        long long int runTime;
+    };
+
+    /**
+     * A request runs against the model object owned by a device.
+     */
+    typedef std::function<int(ControllerT&)> Request;
+
+    /**
+     * Creates the pool.
+     *
+     * @param args arguments of the constructor of the model objects.
+     */
+    template <typename... Args>
+    explicit EnginePool(Args... args)
+        : m_factory(std::bind(&EnginePool::create<Args...>, args...)), m_bRunning(false) {}
+
+    virtual ~EnginePool() { stop(); }
+
+    EnginePool(const EnginePool&) = delete;
+    EnginePool& operator=(const EnginePool&) = delete;
+
+    /**
+     * Claims the devices and starts one worker per device. If any device can
+     * not be claimed, the ones already claimed are released. A running pool
+     * must be stopped before it is started again.
+     *
+     * @param devices the devices to run on, e.g. DeviceManager::getDeviceList()
+     */
+    int start(std::vector<Device*> devices) {
+        int retval = XLNX_OK;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_bRunning) {
+            // the workers and their threads belong to the running pool
+            return XLNX_ERROR_ENGINE_POOL_ALREADY_RUNNING;
+        }
+
+        if (devices.size() == 0) {
+            retval = XLNX_ERROR_ENGINE_POOL_NOT_RUNNING;
+        }
+
+        for (unsigned int i = 0; retval == XLNX_OK && i < devices.size(); i++) {
+            Worker* pWorker = new Worker();
+            pWorker->pController = m_factory();
+            pWorker->outstanding = 0;
+            pWorker->bStop = false;
+            retval = pWorker->pController->claimDevice(devices[i]);
+            if (retval == XLNX_OK) {
+                m_workers.push_back(pWorker);
+            } else {
+                delete pWorker->pController;
+                delete pWorker;
+            }
+        }
+
+        if (retval == XLNX_OK) {
+            for (unsigned int i = 0; i < m_workers.size(); i++) {
+                m_workers[i]->thread = std::thread(&EnginePool::serve, this, i);
+            }
+            m_bRunning = true;
+        } else {
+            for (unsigned int i = 0; i < m_workers.size(); i++) {
+                m_workers[i]->pController->releaseDevice();
+                delete m_workers[i]->pController;
+                delete m_workers[i];
+            }
+            m_workers.clear();
+        }
+
+        return retval;
+    }
+
+    /**
+     * Runs the requests already queued, then stops the workers and releases the
+     * devices.
+     */
+    int stop(void) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_bRunning) {
+            return XLNX_ERROR_ENGINE_POOL_NOT_RUNNING;
+        }
+        m_bRunning = false;
+
+        for (unsigned int i = 0; i < m_workers.size(); i++) {
+            {
+                std::lock_guard<std::mutex> queueLock(m_workers[i]->mutex);
+                m_workers[i]->bStop = true;
+            }
+            m_workers[i]->condition.notify_one();
+        }
+        for (unsigned int i = 0; i < m_workers.size(); i++) {
+            m_workers[i]->thread.join();
+            m_workers[i]->pController->releaseDevice();
+            delete m_workers[i]->pController;
+            delete m_workers[i];
+        }
+        m_workers.clear();
+
+        return XLNX_OK;
+    }
+
+    /**
+     * Queues a request on the least loaded device.
+     *
+     * @param request the request to run
+     * @returns a future holding the outcome of the request
+     */
+    std::future<Result> submit(Request request) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (!m_bRunning) {
+            lock.unlock();
+            std::promise<Result> promise;
+            Result result = {XLNX_ERROR_ENGINE_POOL_NOT_RUNNING, 0, 0, 0};
+            promise.set_value(result);
+            return promise.get_future();
+        }
+
+        unsigned int chosen = 0;
+        for (unsigned int i = 1; i < m_workers.size(); i++) {
+            if (m_workers[i]->outstanding < m_workers[chosen]->outstanding) {
+                chosen = i;
+            }
+        }
+
+        Worker* pWorker = m_workers[chosen];
+        Job job;
+        job.request = request;
+        job.submitTime = std::chrono::high_resolution_clock::now();
+        std::future<Result> future = job.promise.get_future();
+        pWorker->outstanding++;
+        {
+            std::lock_guard<std::mutex> queueLock(pWorker->mutex);
+            pWorker->queue.push_back(std::move(job));
+        }
+        pWorker->condition.notify_one();
+
+        return future;
+    }
+
+    /**
+     * Returns the number of devices of the pool.
+     */
+    unsigned int getNumDevices(void) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_workers.size();
+    }
+
+    /**
+     * Returns the number of requests queued or running on a device.
+     */
+    unsigned int getOutstandingRequests(unsigned int deviceIndex) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (deviceIndex < m_workers.size()) ? m_workers[deviceIndex]->outstanding.load() : 0;
+    }
+
+   private:
+    struct Job {
+        Request request;
+        std::promise<Result> promise;
+        std::chrono::time_point<std::chrono::high_resolution_clock> submitTime;
+    };
+
+    struct Worker {
+        ControllerT* pController;
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<Job> queue;
+        std::atomic<unsigned int> outstanding;
+        bool bStop;
+    };
+
+    template <typename... Args>
+    static ControllerT* create(Args... args) {
+        return new ControllerT(args...);
+    }
+
+    // run time reported by the model itself, which covers only its engine
+    template <typename T>
+    static auto engineRunTime(T& controller, long long int, int)
+        -> decltype((long long int)controller.getLastRunTime()) {
+        return controller.getLastRunTime();
+    }
+
+    template <typename T>
+    static long long int engineRunTime(T&, long long int requestTime, long) {
+        return requestTime;
+    }
+
+    void serve(unsigned int index) {
+        Worker* pWorker = m_workers[index];
+
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> queueLock(pWorker->mutex);
+                pWorker->condition.wait(queueLock, [pWorker] { return pWorker->bStop || !pWorker->queue.empty(); });
+                if (pWorker->queue.empty()) {
+                    // stopped and drained
+                    break;
+                }
+                job = std::move(pWorker->queue.front());
+                pWorker->queue.pop_front();
+            }
+
+            std::chrono::time_point<std::chrono::high_resolution_clock> startTime =
+                std::chrono::high_resolution_clock::now();
+            Result result;
+            try {
+                result.retval = job.request(*pWorker->pController);
+            } catch (...) {
+                pWorker->outstanding--;
+                job.promise.set_exception(std::current_exception());
+                continue;
+            }
+            std::chrono::time_point<std::chrono::high_resolution_clock> endTime =
+                std::chrono::high_resolution_clock::now();
+
+            result.deviceIndex = index;
+            result.queueTime =
+                std::chrono::duration_cast<std::chrono::microseconds>(startTime - job.submitTime).count();
+            result.runTime = engineRunTime(
+                *pWorker->pController,
+                std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count(), 0);
+            pWorker->outstanding--;
+            job.promise.set_value(result);
+        }
+    }
+
+    std::function<ControllerT*()> m_factory;
+
+    std::mutex m_mutex;
+    bool m_bRunning;
+
+    std::vector<Worker*> m_workers;
+};
+
+} // end namespace fintech
+} // end namespace xf
+
+#endif //_XF_FINTECH_ENGINE_POOL_H_
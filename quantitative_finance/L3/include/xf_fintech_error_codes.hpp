@@ -37,4 +37,7 @@
 
 #define XLNX_ERROR_LINEAR_INTERPOLATION_FAILED (0x0000000B)
 
+#define XLNX_ERROR_ENGINE_POOL_NOT_RUNNING (0x0000000C)
+#define XLNX_ERROR_ENGINE_POOL_ALREADY_RUNNING (0x0000000D)
+
 #endif //_XF_FINTECH_ERROR_CODES_H_
\ No newline at end of file
@@ -166,7 +166,20 @@ PYBIND11_MODULE(xf_fintech_python, m) {
                                    timeToMaturity, requiredNumSamples, &optionPrice);
 
                  return std::make_tuple(retval, optionPrice);
-        });
+        })
+
+        .def("calibrate", &MCAmerican::calibrate, py::call_guard<py::scoped_ostream_redirect>())
+        .def("setCoefficientReuseTolerance", &MCAmerican::setCoefficientReuseTolerance)
+        .def("setCalibrationSamples", &MCAmerican::setCalibrationSamples)
+
+        .def("getCoefficients",
+             [](MCAmerican& self) {
+                 std::vector<double> coefficients;
+                 int retval = self.getCoefficients(coefficients);
+                 return std::make_tuple(retval, coefficients);
+             })
+
+        .def("setCoefficients", &MCAmerican::setCoefficients);
 
         //.def("run",
         //     [](MCAmerican& self, std::vector<OptionType> optionTypeList, std::vector<double> stockPriceList,
@@ -213,6 +226,33 @@ PYBIND11_MODULE(xf_fintech_python, m) {
 
 
 
+    py::class_<MCEuropeanBatch>(m, "MCEuropeanBatch")
+        .def(py::init())
+        .def("claimDevice", &MCEuropeanBatch::claimDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("releaseDevice", &MCEuropeanBatch::releaseDevice, py::call_guard<py::scoped_ostream_redirect>())
+        .def("deviceIsPrepared", &MCEuropeanBatch::deviceIsPrepared, py::call_guard<py::scoped_ostream_redirect>())
+        .def("lastruntime", &MCEuropeanBatch::getLastRunTime)
+
+        .def("run", [](MCEuropeanBatch& self, std::vector<OptionType> optionTypeList, double stockPrice,
+                       std::vector<double> strikePriceList, double riskFreeRate, double dividendYield,
+                       double volatility, std::vector<double> timeToMaturityList, unsigned int requiredNumSamples,
+                       unsigned int timeSteps, py::list outputResults) {
+            int retval;
+            unsigned int numOptions = strikePriceList.size(); // use the length of the strike price list to determine
+                                                              // how many options we are dealing with...
+            std::vector<double> optionPriceVector(numOptions);
+
+            py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+
+            retval = self.run(optionTypeList.data(), stockPrice, strikePriceList.data(), riskFreeRate, dividendYield,
+                              volatility, timeToMaturityList.data(), requiredNumSamples, timeSteps,
+                              optionPriceVector.data(), numOptions);
+
+            for (auto i : optionPriceVector) outputResults.append(i);
+
+            return retval;
+        });
+
     py::class_<MCEuropeanDJE>(m, "MCEuropeanDJE")
         .def(py::init())
         .def("claimDevice", &MCEuropeanDJE::claimDevice, py::call_guard<py::scoped_ostream_redirect>())
@@ -390,6 +430,26 @@ PYBIND11_MODULE(xf_fintech_python, m) {
             retval = self.run(samples, burninSamples, sigma, outputVector.data());
             for (auto i : outputVector) output.append(i);
 
+            return retval;
+        })
+
+        .def("runMultiDim", [](PopMCMC& self, int dims, std::vector<double> targetParameters,
+                               std::vector<double> initialPoint, int samples, int burninSamples, double sigma,
+                               py::list output) {
+            int retval;
+            py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+
+            // each sample is returned as a list of dims values
+            retval = self.runMultiDim(dims, targetParameters, initialPoint.data(), samples, burninSamples, sigma,
+                                      [&](const double* block, int count) {
+                                          for (int k = 0; k < count; k++) {
+                                              py::list sample;
+                                              for (int i = 0; i < dims; i++) sample.append(block[k * dims + i]);
+                                              output.append(sample);
+                                          }
+                                          return XLNX_OK;
+                                      });
+
             return retval;
         });
 
@@ -436,6 +496,46 @@ PYBIND11_MODULE(xf_fintech_python, m) {
                  return retval;
              });
 
+    py::class_<CFBlackScholesImpliedVolatility>(m, "CFBlackScholesImpliedVolatility")
+        .def(py::init<unsigned int>())
+
+        .def("claimDevice", &CFBlackScholesImpliedVolatility::claimDevice,
+             py::call_guard<py::scoped_ostream_redirect>())
+        .def("releaseDevice", &CFBlackScholesImpliedVolatility::releaseDevice,
+             py::call_guard<py::scoped_ostream_redirect>())
+        .def("deviceIsPrepared", &CFBlackScholesImpliedVolatility::deviceIsPrepared,
+             py::call_guard<py::scoped_ostream_redirect>())
+        .def("lastruntime", &CFBlackScholesImpliedVolatility::getLastRunTime)
+
+        .def("run", [](CFBlackScholesImpliedVolatility& self, std::vector<float> stockPriceList,
+                       std::vector<float> strikePriceList, std::vector<float> optionPriceList,
+                       std::vector<float> riskFreeRateList, std::vector<float> timeToMaturityList,
+                       // Above are Input Buffers   - Below are Output Buffers
+                       py::list impliedVolatilityList,
+                       // Underneath is just the format chosen, as using the C++ example
+                       OptionType optionType, unsigned int numQuotes)
+
+             {
+                 int retval;
+
+                 py::scoped_ostream_redirect outStream(std::cout, py::module::import("sys").attr("stdout"));
+                 for (unsigned int i = 0; i < numQuotes; i++) {
+                     self.stockPrice[i] = stockPriceList[i];
+                     self.strikePrice[i] = strikePriceList[i];
+                     self.optionPrice[i] = optionPriceList[i];
+                     self.riskFreeRate[i] = riskFreeRateList[i];
+                     self.timeToMaturity[i] = timeToMaturityList[i];
+                 }
+                 retval = self.run(optionType, numQuotes);
+
+                 // so after the execution these should be filled with results -> transfer to python lists
+                 for (unsigned int i = 0; i < numQuotes; i++) {
+                     impliedVolatilityList.append(self.impliedVolatility[i]);
+                 }
+
+                 return retval;
+             });
+
     py::class_<CFBlackScholesMerton>(m, "CFBlackScholesMerton")
         .def(py::init<unsigned int>())
 
@@ -28,6 +28,7 @@ FINTECH_DIR="$(dirname $L3_DIR)"
 
 export XILINX_FINTECH_L3_INC="$FINTECH_DIR/L3/include"
 export XILINX_FINTECH_L2_INC="$FINTECH_DIR/L2/include"
+export XILINX_FINTECH_L1_INC="$FINTECH_DIR/L1/include"
 export XILINX_FINTECH_LIB_DIR="$L3_DIR/src/output"
 export XILINX_XCL2_DIR="$FINTECH_DIR/ext/xcl2"
 export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$XILINX_FINTECH_LIB_DIR"
@@ -37,6 +38,7 @@ export LD_LIBRARY_PATH="$LD_LIBRARY_PATH:$XILINX_FINTECH_LIB_DIR"
 
 echo "XILINX_FINTECH_L3_INC   : $XILINX_FINTECH_L3_INC"
 echo "XILINX_FINTECH_L2_INC   : $XILINX_FINTECH_L2_INC"
+echo "XILINX_FINTECH_L1_INC   : $XILINX_FINTECH_L1_INC"
 echo "XILINX_FINTECH_LIB_DIR  : $XILINX_FINTECH_LIB_DIR"
 echo "XILINX_XCL2_DIR         : $XILINX_XCL2_DIR"
 echo "LD_LIBRARY_PATH         : $LD_LIBRARY_PATH"
@@ -0,0 +1,409 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <limits.h>
+
+#include "xf_fintech_error_codes.hpp"
+#include "xf_fintech_trace.hpp"
+
+#include "models/xf_fintech_cf_black_scholes_iv.hpp"
+
+using namespace xf::fintech;
+
+const char* BS_IV_KERNEL_NAME = "bs_iv_kernel";
+
+typedef struct _XCLBINLookupElement {
+    Device::DeviceType deviceType;
+    std::string xclbinName;
+} XCLBINLookupElement;
+
+static XCLBINLookupElement XCLBIN_LOOKUP_TABLE[] = {{Device::DeviceType::U50, "bs_iv_kernel.xclbin"},
+                                                    {Device::DeviceType::U200, "bs_iv_kernel.xclbin"},
+                                                    {Device::DeviceType::U250, "bs_iv_kernel.xclbin"},
+                                                    {Device::DeviceType::U280, "bs_iv_kernel.xclbin"}};
+
+static const unsigned int NUM_XCLBIN_LOOKUP_TABLE_ENTRIES =
+    sizeof(XCLBIN_LOOKUP_TABLE) / sizeof(XCLBIN_LOOKUP_TABLE[0]);
+
+const char* CFBlackScholesImpliedVolatility::getKernelName() {
+    return BS_IV_KERNEL_NAME;
+}
+
+// The HW kernel reads and writes KERNEL_PARAMETER_BITWIDTH (512 at time of
+// writing) bit wide words, so the buffers are allocated in whole chunks of
+// KERNEL_PARAMETER_BITWIDTH / (8 * sizeof(KDataType)) elements.
+
+const unsigned int CFBlackScholesImpliedVolatility::NUM_ELEMENTS_PER_BUFFER_CHUNK =
+    CFBlackScholesImpliedVolatility::KERNEL_PARAMETER_BITWIDTH /
+    (8 * sizeof(CFBlackScholesImpliedVolatility::KDataType));
+
+CFBlackScholesImpliedVolatility::CFBlackScholesImpliedVolatility(unsigned int maxNumQuotes) {
+    m_pContext = nullptr;
+    m_pCommandQueue = nullptr;
+    m_pProgram = nullptr;
+    m_pKernel = nullptr;
+
+    m_pStockPriceHWBuffer = nullptr;
+    m_pStrikePriceHWBuffer = nullptr;
+    m_pOptionPriceHWBuffer = nullptr;
+    m_pRiskFreeRateHWBuffer = nullptr;
+    m_pTimeToMaturityHWBuffer = nullptr;
+    m_pImpliedVolatilityHWBuffer = nullptr;
+
+    this->allocateBuffers(maxNumQuotes);
+}
+
+CFBlackScholesImpliedVolatility::~CFBlackScholesImpliedVolatility() {
+    this->deallocateBuffers();
+
+    if (deviceIsPrepared()) {
+        releaseDevice();
+    }
+}
+
+std::string CFBlackScholesImpliedVolatility::getXCLBINName(Device* device) {
+    std::string xclbinName = "UNSUPPORTED_DEVICE";
+    Device::DeviceType deviceType;
+    unsigned int i;
+    XCLBINLookupElement* pElement;
+
+    deviceType = device->getDeviceType();
+
+    for (i = 0; i < NUM_XCLBIN_LOOKUP_TABLE_ENTRIES; i++) {
+        pElement = &XCLBIN_LOOKUP_TABLE[i];
+
+        if (pElement->deviceType == deviceType) {
+            xclbinName = pElement->xclbinName;
+            break; // out of loop
+        }
+    }
+
+    return xclbinName;
+}
+
+int CFBlackScholesImpliedVolatility::createOCLObjects(Device* device) {
+    int retval = XLNX_OK;
+    cl_int cl_retval = CL_SUCCESS;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    std::chrono::time_point<std::chrono::high_resolution_clock> end;
+    std::string xclbinName;
+
+    cl::Device clDevice;
+
+    clDevice = device->getCLDevice();
+
+    m_pContext = new cl::Context(clDevice, nullptr, nullptr, nullptr, &cl_retval);
+
+    ///////////////////////////////
+    // Create COMMAND QUEUE Object
+    ///////////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pCommandQueue = new cl::CommandQueue(*m_pContext, clDevice, CL_QUEUE_PROFILING_ENABLE, &cl_retval);
+    }
+
+    /////////////////
+    // Import XCLBIN
+    /////////////////
+    if (cl_retval == CL_SUCCESS) {
+        start = std::chrono::high_resolution_clock::now();
+
+        xclbinName = getXCLBINName(device);
+
+        m_binaries.clear();
+        m_binaries = xcl::import_binary_file(xclbinName);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Binary Import Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create PROGRAM Object
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        std::vector<cl::Device> devicesToProgram;
+        devicesToProgram.push_back(clDevice);
+
+        start = std::chrono::high_resolution_clock::now();
+
+        m_pProgram = new cl::Program(*m_pContext, devicesToProgram, m_binaries, nullptr, &cl_retval);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Device Programming Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create KERNEL Objects
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pKernel = new cl::Kernel(*m_pProgram, getKernelName(), &cl_retval);
+    }
+
+    /////////////////////////
+    // Create BUFFER Objects
+    /////////////////////////
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pStockPriceHWBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                           m_numPaddedBufferElements * sizeof(KDataType), this->stockPrice, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pStrikePriceHWBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                           m_numPaddedBufferElements * sizeof(KDataType), this->strikePrice, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pOptionPriceHWBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                           m_numPaddedBufferElements * sizeof(KDataType), this->optionPrice, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pRiskFreeRateHWBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                           m_numPaddedBufferElements * sizeof(KDataType), this->riskFreeRate, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pTimeToMaturityHWBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                           m_numPaddedBufferElements * sizeof(KDataType), this->timeToMaturity, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pImpliedVolatilityHWBuffer =
+            new cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                           m_numPaddedBufferElements * sizeof(KDataType), this->impliedVolatility, &cl_retval);
+    }
+
+    if (cl_retval != CL_SUCCESS) {
+        setCLError(cl_retval);
+        Trace::printCLError(cl_retval);
+        retval = XLNX_ERROR_OPENCL_CALL_ERROR;
+    }
+
+    return retval;
+}
+
+int CFBlackScholesImpliedVolatility::releaseOCLObjects(void) {
+    int retval = XLNX_OK;
+    unsigned int i;
+
+    if (m_pStockPriceHWBuffer != nullptr) {
+        delete (m_pStockPriceHWBuffer);
+        m_pStockPriceHWBuffer = nullptr;
+    }
+
+    if (m_pStrikePriceHWBuffer != nullptr) {
+        delete (m_pStrikePriceHWBuffer);
+        m_pStrikePriceHWBuffer = nullptr;
+    }
+
+    if (m_pOptionPriceHWBuffer != nullptr) {
+        delete (m_pOptionPriceHWBuffer);
+        m_pOptionPriceHWBuffer = nullptr;
+    }
+
+    if (m_pRiskFreeRateHWBuffer != nullptr) {
+        delete (m_pRiskFreeRateHWBuffer);
+        m_pRiskFreeRateHWBuffer = nullptr;
+    }
+
+    if (m_pTimeToMaturityHWBuffer != nullptr) {
+        delete (m_pTimeToMaturityHWBuffer);
+        m_pTimeToMaturityHWBuffer = nullptr;
+    }
+
+    if (m_pImpliedVolatilityHWBuffer != nullptr) {
+        delete (m_pImpliedVolatilityHWBuffer);
+        m_pImpliedVolatilityHWBuffer = nullptr;
+    }
+
+    if (m_pKernel != nullptr) {
+        delete (m_pKernel);
+        m_pKernel = nullptr;
+    }
+
+    if (m_pProgram != nullptr) {
+        delete (m_pProgram);
+        m_pProgram = nullptr;
+    }
+
+    for (i = 0; i < m_binaries.size(); i++) {
+        std::pair<const void*, cl::size_type> binaryPair = m_binaries[i];
+        delete[](char*)(binaryPair.first);
+    }
+
+    if (m_pCommandQueue != nullptr) {
+        delete (m_pCommandQueue);
+        m_pCommandQueue = nullptr;
+    }
+
+    if (m_pContext != nullptr) {
+        delete (m_pContext);
+        m_pContext = nullptr;
+    }
+
+    return retval;
+}
+
+void CFBlackScholesImpliedVolatility::allocateBuffers(unsigned int numRequestedElements) {
+    aligned_allocator<KDataType> allocator;
+
+    m_numPaddedBufferElements = calculatePaddedNumElements(numRequestedElements);
+
+    this->stockPrice = allocator.allocate(m_numPaddedBufferElements);
+    this->strikePrice = allocator.allocate(m_numPaddedBufferElements);
+    this->optionPrice = allocator.allocate(m_numPaddedBufferElements);
+    this->riskFreeRate = allocator.allocate(m_numPaddedBufferElements);
+    this->timeToMaturity = allocator.allocate(m_numPaddedBufferElements);
+
+    this->impliedVolatility = allocator.allocate(m_numPaddedBufferElements);
+}
+
+void CFBlackScholesImpliedVolatility::deallocateBuffers(void) {
+    aligned_allocator<KDataType> allocator;
+
+    if (this->stockPrice != nullptr) {
+        allocator.deallocate(this->stockPrice, m_numPaddedBufferElements);
+        this->stockPrice = nullptr;
+    }
+
+    if (this->strikePrice != nullptr) {
+        allocator.deallocate(this->strikePrice, m_numPaddedBufferElements);
+        this->strikePrice = nullptr;
+    }
+
+    if (this->optionPrice != nullptr) {
+        allocator.deallocate(this->optionPrice, m_numPaddedBufferElements);
+        this->optionPrice = nullptr;
+    }
+
+    if (this->riskFreeRate != nullptr) {
+        allocator.deallocate(this->riskFreeRate, m_numPaddedBufferElements);
+        this->riskFreeRate = nullptr;
+    }
+
+    if (this->timeToMaturity != nullptr) {
+        allocator.deallocate(this->timeToMaturity, m_numPaddedBufferElements);
+        this->timeToMaturity = nullptr;
+    }
+
+    if (this->impliedVolatility != nullptr) {
+        allocator.deallocate(this->impliedVolatility, m_numPaddedBufferElements);
+        this->impliedVolatility = nullptr;
+    }
+
+    m_numPaddedBufferElements = 0;
+}
+
+unsigned int CFBlackScholesImpliedVolatility::calculatePaddedNumElements(unsigned int numRequestedElements) {
+    unsigned int numChunks;
+    unsigned int numPaddedElements;
+
+    // due to the way the HW processes data, the number of elements in a buffer
+    // needs to be multiples of NUM_ELEMENTS_PER_BUFFER_CHUNK.
+    // so we need to round up the amount to the next nearest whole number of
+    // chunks
+
+    numChunks = (numRequestedElements + (NUM_ELEMENTS_PER_BUFFER_CHUNK - 1)) / NUM_ELEMENTS_PER_BUFFER_CHUNK;
+
+    numPaddedElements = numChunks * NUM_ELEMENTS_PER_BUFFER_CHUNK;
+
+    return numPaddedElements;
+}
+
+int CFBlackScholesImpliedVolatility::run(OptionType optionType, unsigned int numQuotes) {
+    int retval = XLNX_OK;
+    unsigned int optionFlag;
+    unsigned int i;
+    std::vector<cl::Memory> inputVector;
+    std::vector<cl::Memory> outputVector;
+
+    unsigned int numPaddedQuotes;
+
+    if (numQuotes > m_numPaddedBufferElements) {
+        return XLNX_ERROR_MODEL_INTERNAL_ERROR;
+    }
+
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
+    if (optionType == OptionType::Call) {
+        optionFlag = 1;
+    } else {
+        optionFlag = 0;
+    }
+
+    numPaddedQuotes = calculatePaddedNumElements(numQuotes);
+
+    // fill the padding with a well-conditioned at-the-money quote so that the
+    // solver does not operate on uninitialised data
+    for (i = numQuotes; i < numPaddedQuotes; i++) {
+        this->stockPrice[i] = 100.0f;
+        this->strikePrice[i] = 100.0f;
+        this->optionPrice[i] = 10.0f;
+        this->riskFreeRate[i] = 0.0f;
+        this->timeToMaturity[i] = 1.0f;
+    }
+
+    m_pKernel->setArg(0, (*m_pStockPriceHWBuffer));
+    m_pKernel->setArg(1, (*m_pOptionPriceHWBuffer));
+    m_pKernel->setArg(2, (*m_pRiskFreeRateHWBuffer));
+    m_pKernel->setArg(3, (*m_pTimeToMaturityHWBuffer));
+    m_pKernel->setArg(4, (*m_pStrikePriceHWBuffer));
+    m_pKernel->setArg(5, optionFlag);
+    m_pKernel->setArg(6, numPaddedQuotes);
+    m_pKernel->setArg(7, (*m_pImpliedVolatilityHWBuffer));
+
+    inputVector.push_back((*m_pStockPriceHWBuffer));
+    inputVector.push_back((*m_pOptionPriceHWBuffer));
+    inputVector.push_back((*m_pRiskFreeRateHWBuffer));
+    inputVector.push_back((*m_pTimeToMaturityHWBuffer));
+    inputVector.push_back((*m_pStrikePriceHWBuffer));
+
+    m_pCommandQueue->enqueueMigrateMemObjects(inputVector, 0, nullptr, nullptr);
+
+    m_pCommandQueue->enqueueTask(*m_pKernel);
+
+    outputVector.push_back((*m_pImpliedVolatilityHWBuffer));
+
+    // the queue is in-order so the read back can be enqueued behind the kernel
+    // without an intermediate host synchronisation
+    m_pCommandQueue->enqueueMigrateMemObjects(outputVector, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+
+    m_pCommandQueue->flush();
+    m_pCommandQueue->finish();
+
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
+    return retval;
+}
+
+long long int CFBlackScholesImpliedVolatility::getLastRunTime(void) {
+    long long int duration = 0;
+
+    duration =
+        (long long int)std::chrono::duration_cast<std::chrono::microseconds>(m_runEndTime - m_runStartTime).count();
+
+    return duration;
+}
@@ -30,12 +30,17 @@ hcf::hcf() {
     m_pCommandQueue = nullptr;
     m_pProgram = nullptr;
     m_pHcfKernel = nullptr;
+    m_pHcfStripKernel = nullptr;
 
     m_hostInputBuffer.clear();
     m_hostOutputBuffer.clear();
+    m_hostStrikeBuffer.clear();
+    m_hostStripOutputBuffer.clear();
 
     m_pHwInputBuffer = nullptr;
     m_pHwOutputBuffer = nullptr;
+    m_pHwStrikeBuffer = nullptr;
+    m_pHwStripOutputBuffer = nullptr;
 
     m_dw = 0.5;
     m_w_max = 200;
@@ -111,11 +116,24 @@ int hcf::createOCLObjects(Device* device) {
         m_pHcfKernel = new cl::Kernel(*m_pProgram, "hcf_kernel", &cl_retval);
     }
 
+    // The strip kernel is optional, runStrip() is not supported without it
+    if (cl_retval == CL_SUCCESS) {
+        cl_int cl_strip_retval = CL_SUCCESS;
+        m_pHcfStripKernel = new cl::Kernel(*m_pProgram, "hcf_strip_kernel", &cl_strip_retval);
+        if (cl_strip_retval != CL_SUCCESS) {
+            delete (m_pHcfStripKernel);
+            m_pHcfStripKernel = nullptr;
+            Trace::printInfo("[XLNX] Strip kernel not found in the xclbin\n");
+        }
+    }
+
     //////////////////////////
     // Allocate HOST BUFFERS
     //////////////////////////
     m_hostInputBuffer.resize(MAX_OPTION_CALCULATIONS);
     m_hostOutputBuffer.resize(MAX_OPTION_CALCULATIONS);
+    m_hostStrikeBuffer.resize(MAX_STRIP_STRIKES);
+    m_hostStripOutputBuffer.resize(MAX_STRIP_STRIKES);
 
     ////////////////////////////////
     // Allocate HW BUFFER Objects
@@ -134,6 +152,17 @@ int hcf::createOCLObjects(Device* device) {
                                            m_hostOutputBuffer.data(), &cl_retval);
     }
 
+    if (cl_retval == CL_SUCCESS) {
+        m_pHwStrikeBuffer = new cl::Buffer(*m_pContext, (CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
+                                           sizeof(TEST_DT) * MAX_STRIP_STRIKES, m_hostStrikeBuffer.data(), &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_pHwStripOutputBuffer =
+            new cl::Buffer(*m_pContext, (CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE), sizeof(TEST_DT) * MAX_STRIP_STRIKES,
+                           m_hostStripOutputBuffer.data(), &cl_retval);
+    }
+
     if (cl_retval != CL_SUCCESS) {
         setCLError(cl_retval);
         Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
@@ -156,11 +185,26 @@ int hcf::releaseOCLObjects(void) {
         m_pHwOutputBuffer = nullptr;
     }
 
+    if (m_pHwStrikeBuffer != nullptr) {
+        delete (m_pHwStrikeBuffer);
+        m_pHwStrikeBuffer = nullptr;
+    }
+
+    if (m_pHwStripOutputBuffer != nullptr) {
+        delete (m_pHwStripOutputBuffer);
+        m_pHwStripOutputBuffer = nullptr;
+    }
+
     if (m_pHcfKernel != nullptr) {
         delete (m_pHcfKernel);
         m_pHcfKernel = nullptr;
     }
 
+    if (m_pHcfStripKernel != nullptr) {
+        delete (m_pHcfStripKernel);
+        m_pHcfStripKernel = nullptr;
+    }
+
     if (m_pProgram != nullptr) {
         delete (m_pProgram);
         m_pProgram = nullptr;
@@ -187,6 +231,8 @@ int hcf::releaseOCLObjects(void) {
 int hcf::run(struct hcf_input_data* inputData, float* outputData, int numOptions) {
     int retval = XLNX_OK;
 
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
     if (retval == XLNX_OK) {
         if (deviceIsPrepared()) {
             int num_options = numOptions;
@@ -234,6 +280,64 @@ int hcf::run(struct hcf_input_data* inputData, float* outputData, int numOptions
         }
     }
 
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
+    return retval;
+}
+
+int hcf::runStrip(struct hcf_input_data* inputData, float* strikes, float* outputData, int numStrikes) {
+    int retval = XLNX_OK;
+
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
+    if (!deviceIsPrepared()) {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    } else if (m_pHcfStripKernel == nullptr || numStrikes < 1 || numStrikes > MAX_STRIP_STRIKES) {
+        retval = XLNX_ERROR_NOT_SUPPORTED;
+    }
+
+    if (retval == XLNX_OK) {
+        // prepare the data, the model goes in the first input slot
+        m_hostInputBuffer[0].s0 = inputData->s0;
+        m_hostInputBuffer[0].v0 = inputData->v0;
+        m_hostInputBuffer[0].K = inputData->K;
+        m_hostInputBuffer[0].rho = inputData->rho;
+        m_hostInputBuffer[0].T = inputData->T;
+        m_hostInputBuffer[0].r = inputData->r;
+        m_hostInputBuffer[0].kappa = inputData->kappa;
+        m_hostInputBuffer[0].vvol = inputData->vvol;
+        m_hostInputBuffer[0].vbar = inputData->vbar;
+        m_hostInputBuffer[0].dw = m_dw;
+        m_hostInputBuffer[0].w_max = m_w_max;
+        for (int i = 0; i < numStrikes; i++) {
+            m_hostStrikeBuffer[i] = strikes[i];
+        }
+
+        // Set the arguments
+        m_pHcfStripKernel->setArg(0, *m_pHwInputBuffer);
+        m_pHcfStripKernel->setArg(1, *m_pHwStrikeBuffer);
+        m_pHcfStripKernel->setArg(2, *m_pHwStripOutputBuffer);
+        m_pHcfStripKernel->setArg(3, numStrikes);
+
+        // Copy input data to device global memory
+        m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwInputBuffer, *m_pHwStrikeBuffer}, 0);
+        m_pCommandQueue->finish();
+
+        // Launch the Kernel
+        m_pCommandQueue->enqueueTask(*m_pHcfStripKernel);
+        m_pCommandQueue->finish();
+
+        // Copy Result from Device Global Memory to Host Local Memory
+        m_pCommandQueue->enqueueMigrateMemObjects({*m_pHwStripOutputBuffer}, CL_MIGRATE_MEM_OBJECT_HOST);
+        m_pCommandQueue->finish();
+
+        for (int i = 0; i < numStrikes; i++) {
+            outputData[i] = m_hostStripOutputBuffer[i];
+        }
+    }
+
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
     return retval;
 }
 
@@ -252,3 +356,12 @@ int hcf::get_dw() {
 float hcf::get_w_max() {
     return m_w_max;
 }
+
+long long int hcf::getLastRunTime(void) {
+    long long int duration = 0;
+
+    duration =
+        (long long int)std::chrono::duration_cast<std::chrono::microseconds>(m_runEndTime - m_runStartTime).count();
+
+    return duration;
+}
@@ -25,6 +25,7 @@
 #include "xf_fintech_heston_ocl_objects.hpp"
 #include "xf_fintech_heston_price_ram.hpp"
 #include "xf_fintech_heston_solver_parameters.hpp"
+#include "xf_fintech_heston_types.hpp"
 
 using namespace std;
 
@@ -56,11 +57,23 @@ class HestonFD {
      */
     HestonFDReturnVal Solve(HestonFDPriceRam& AnyPriceRam, std::vector<double>& S, std::vector<double>& V);
 
+    /** @brief Solve Heston FD for several strikes and maturities on one grid, returns a full price grid per option,
+     * vector of the stock price and vector of variance values. The grid is built around the strike of the model
+     * parameters and the time step is the one of the solver parameters. Requires the OpenCL objects.
+     */
+    HestonFDReturnVal SolveBatch(std::vector<double>& Strikes,
+                                 std::vector<double>& Maturities,
+                                 std::vector<std::vector<double> >& PriceGrids,
+                                 std::vector<double>& S,
+                                 std::vector<double>& V);
+
     /** @brief Return the time taken to solve Heston FD
      */
     HestonFDReturnVal Meta(std::chrono::milliseconds& AnyExecutionTime);
 
    private:
+    void GetParameters(hestonfd::model_parameters_t& modelParams, hestonfd::solver_parameters_t& solverParams);
+
     HestonFDModelParameters& _ModelParameters;
     HestonFDSolverParameters& _SolverParameters;
     HestonFDOCLObjects _OCLObjects;
@@ -33,6 +33,14 @@ class AdiSolver {
     model_parameters_t AdiModelParams;
     solver_parameters_t AdiSolverParams;
 
+    void assemble(std::map<std::pair<int, int>, double>& sparse_map_A,
+                  std::vector<std::vector<double> >& A1_vec,
+                  std::vector<std::vector<double> >& A2_vec,
+                  std::vector<std::vector<double> >& X1,
+                  std::vector<std::vector<double> >& X2,
+                  std::vector<double>& b);
+    void createPayoff(double K, std::vector<double>& u0);
+
    public:
     std::vector<double> sGrid;
     std::vector<double> vGrid;
@@ -44,6 +52,15 @@ class AdiSolver {
     void solve(double* u);
     void solve(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl::Kernel* pKernel, double* u);
 
+    // Solves several call options on the current grid, all with the same model parameters apart from the strike
+    // and the maturity. A maturity that is not a whole number of steps of dt is interpolated between two steps.
+    void solveBatch(cl::Context* pContext,
+                    cl::CommandQueue* pCommandQueue,
+                    cl::Kernel* pKernel,
+                    std::vector<double>& strikes,
+                    std::vector<double>& maturities,
+                    std::vector<std::vector<double> >& priceGrids);
+
     double createUniformGrid();
 
     // This function to be done once in software.
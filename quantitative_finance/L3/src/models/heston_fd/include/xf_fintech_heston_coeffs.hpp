@@ -47,10 +47,10 @@ class Coeffs {
     double vGamma(int i, int pos);
     double sDelta(int i, int pos);
     double vDelta(int i, int pos);
-    double alpha(std::vector<double> dx, int i, int pos);
-    double beta(std::vector<double> dx, int i, int pos);
-    double gamma(std::vector<double> dx, int i, int pos);
-    double delta(std::vector<double> dx, int i, int pos);
+    double alpha(const std::vector<double>& dx, int i, int pos);
+    double beta(const std::vector<double>& dx, int i, int pos);
+    double gamma(const std::vector<double>& dx, int i, int pos);
+    double delta(const std::vector<double>& dx, int i, int pos);
 };
 
 } // namespace hestonfd
@@ -17,6 +17,13 @@
 #ifndef _XF_FINTECH_HESTON_KERNEL_INERFACE_H_
 #define _XF_FINTECH_HESTON_KERNEL_INERFACE_H_
 
+#include <map>
+#include <vector>
+
+#include "xcl2.hpp"
+
+#include "xf_fintech_heston_kernel_constants.hpp"
+
 namespace xf {
 namespace fintech {
 namespace hestonfd {
@@ -48,6 +55,64 @@ void kernel_call(cl::Context* pContext,
                  int N,
                  double* price_grid);
 
+/**
+ * @brief Keeps the ADI system of one solve resident in device memory.
+ *
+ * The matrices and the boundary vector are packed and migrated once by load(). Each run() then only migrates the
+ * initial condition and reads back the price grid, so several payoffs, or a solve continued from an earlier price
+ * grid, reuse the same system.
+ */
+class KernelSystem {
+   public:
+    KernelSystem(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl::Kernel* pKernel);
+
+    void load(std::map<std::pair<int, int>, double>& sparse_map_A,
+              std::vector<std::vector<double> >& A1_vec,
+              std::vector<std::vector<double> >& A2_vec,
+              std::vector<std::vector<double> >& X1_vec,
+              std::vector<std::vector<double> >& X2_vec,
+              std::vector<double>& b_vec,
+              int M1,
+              int M2);
+
+    void run(std::vector<double>& u0_vec, int N, double* price_grid);
+
+   private:
+    cl::Context* m_pContext;
+    cl::CommandQueue* m_pCommandQueue;
+    cl::Kernel* m_pKernel;
+
+    // Vectors for parameter storage.  These use an aligned allocator in order
+    // to avoid an additional copy of the host memory into the device
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_A;
+    std::vector<unsigned int, aligned_allocator<unsigned int> > m_Ar;
+    std::vector<unsigned int, aligned_allocator<unsigned int> > m_Ac;
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_A1;
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_X1;
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_A2;
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_X2;
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_b;
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_u0;
+    std::vector<FD_dataType, aligned_allocator<FD_dataType> > m_price;
+
+    cl::Buffer m_buffer_A;
+    cl::Buffer m_buffer_A_row;
+    cl::Buffer m_buffer_A_col;
+    cl::Buffer m_buffer_A1;
+    cl::Buffer m_buffer_A2;
+    cl::Buffer m_buffer_X1;
+    cl::Buffer m_buffer_X2;
+    cl::Buffer m_buffer_b;
+    cl::Buffer m_buffer_u0;
+    cl::Buffer m_buffer_price;
+
+    // Sparse array non-zero count
+    unsigned int m_A_nnz;
+    int m_M1;
+    int m_M2;
+    bool m_bLoaded;
+};
+
 } // namespace hestonfd
 } // namespace fintech
 } // namespace xf
@@ -35,6 +35,11 @@ class Matrices {
     solver_parameters_t solverParams;
 
     void insertOrUpdate(std::map<std::pair<int, int>, double>& sparse_map_A, int row, int col, double val);
+    void createARows(std::map<std::pair<int, int>, double>& sparse_map_A,
+                     std::vector<std::vector<double> >& vec_A1,
+                     std::vector<std::vector<double> >& vec_A2,
+                     int jStart,
+                     int jEnd);
 
    public:
     Matrices(std::vector<double> sGrid,
@@ -52,7 +57,8 @@ class Matrices {
     void coeffsInit(void);
     void createA(std::map<std::pair<int, int>, double>& sparse_map_A,
                  std::vector<std::vector<double> >& vec_A1,
-                 std::vector<std::vector<double> >& vec_A2);
+                 std::vector<std::vector<double> >& vec_A2,
+                 unsigned int numThreads = 1);
     void createB(std::vector<double>& vec_b);
 };
 
@@ -48,7 +48,7 @@ class HestonFDSolverParameters {
     /** @brief get the delta timestep */
     double Get_dt() { return _dt; }
     /** @brief set the delta timestep */
-    void Set_dt(int dt) { _dt = dt; }
+    void Set_dt(double dt) { _dt = dt; }
 
     /** @brief get the m1 grid size for the S direction */
     int Get_m1() { return _m1; }
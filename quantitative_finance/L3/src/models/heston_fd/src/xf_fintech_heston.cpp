@@ -37,30 +37,45 @@ HestonFD::HestonFDReturnVal HestonFD::Solve(HestonFDPriceRam& AnyPriceRam,
     model_parameters_t modelParams;
     solver_parameters_t solverParams;
 
-    if (HestonFD::_SolverParameters.Get_Scheme() == "Douglas") {
-        solverParams.scheme = 1;
+    GetParameters(modelParams, solverParams);
+
+    AdiSolver solver(modelParams, solverParams);
+    solver.createGrid();
+    solver.solve(_OCLObjects.GetContext(), _OCLObjects.GetCommandQueue(), _OCLObjects.GetKernel(), results_u);
+
+    S = solver.sGrid;
+    V = solver.vGrid;
+
+    _Solved = true;
+
+    _ExecutionTime.Stop();
+
+    return Result;
+}
+
+HestonFD::HestonFDReturnVal HestonFD::SolveBatch(std::vector<double>& Strikes,
+                                                 std::vector<double>& Maturities,
+                                                 std::vector<std::vector<double> >& PriceGrids,
+                                                 std::vector<double>& S,
+                                                 std::vector<double>& V) {
+    HestonFDReturnVal Result = XLNXOK;
+
+    if ((_OCLObjects.GetContext() == nullptr) || (_OCLObjects.GetCommandQueue() == nullptr) ||
+        (_OCLObjects.GetKernel() == nullptr)) {
+        return XLNXAlgorithmNotExecuted;
     }
-    solverParams.theta = HestonFD::_SolverParameters.Get_Theta();
-    solverParams.N = HestonFD::_SolverParameters.Get_N();   // Number of timesteps
-    solverParams.dt = HestonFD::_SolverParameters.Get_dt(); // Delta(timestep) modelParams->T / solverParams.N
-    solverParams.m1 = HestonFD::_SolverParameters.Get_m1(); // Number of grid steps in S direction
-    solverParams.m2 = HestonFD::_SolverParameters.Get_m2(); // Number of grid steps in V direction
-    solverParams.gridType = HestonFD::_SolverParameters.Get_GridType(); // 0 = uniform, 1 = sinh grid
 
-    modelParams.K = HestonFD::_ModelParameters.Get_K();
-    modelParams.kappa = HestonFD::_ModelParameters.Get_kappa();
-    modelParams.rd = HestonFD::_ModelParameters.Get_rd();
-    modelParams.rf = HestonFD::_ModelParameters.Get_rf();
-    modelParams.rho = HestonFD::_ModelParameters.Get_rho();
-    modelParams.S = HestonFD::_ModelParameters.Get_S();
-    modelParams.sig = HestonFD::_ModelParameters.Get_sig();
-    modelParams.T = HestonFD::_ModelParameters.Get_T();
-    modelParams.eta = HestonFD::_ModelParameters.Get_eta();
-    modelParams.V = HestonFD::_ModelParameters.Get_V();
+    _ExecutionTime.Start();
+
+    model_parameters_t modelParams;
+    solver_parameters_t solverParams;
+
+    GetParameters(modelParams, solverParams);
 
     AdiSolver solver(modelParams, solverParams);
     solver.createGrid();
-    solver.solve(_OCLObjects.GetContext(), _OCLObjects.GetCommandQueue(), _OCLObjects.GetKernel(), results_u);
+    solver.solveBatch(_OCLObjects.GetContext(), _OCLObjects.GetCommandQueue(), _OCLObjects.GetKernel(), Strikes,
+                      Maturities, PriceGrids);
 
     S = solver.sGrid;
     V = solver.vGrid;
@@ -85,5 +100,28 @@ HestonFD::HestonFDReturnVal HestonFD::Meta(std::chrono::milliseconds& AnyExecuti
     return Result;
 }
 
+void HestonFD::GetParameters(model_parameters_t& modelParams, solver_parameters_t& solverParams) {
+    if (HestonFD::_SolverParameters.Get_Scheme() == "Douglas") {
+        solverParams.scheme = 1;
+    }
+    solverParams.theta = HestonFD::_SolverParameters.Get_Theta();
+    solverParams.N = HestonFD::_SolverParameters.Get_N();   // Number of timesteps
+    solverParams.dt = HestonFD::_SolverParameters.Get_dt(); // Delta(timestep) modelParams->T / solverParams.N
+    solverParams.m1 = HestonFD::_SolverParameters.Get_m1(); // Number of grid steps in S direction
+    solverParams.m2 = HestonFD::_SolverParameters.Get_m2(); // Number of grid steps in V direction
+    solverParams.gridType = HestonFD::_SolverParameters.Get_GridType(); // 0 = uniform, 1 = sinh grid
+
+    modelParams.K = HestonFD::_ModelParameters.Get_K();
+    modelParams.kappa = HestonFD::_ModelParameters.Get_kappa();
+    modelParams.rd = HestonFD::_ModelParameters.Get_rd();
+    modelParams.rf = HestonFD::_ModelParameters.Get_rf();
+    modelParams.rho = HestonFD::_ModelParameters.Get_rho();
+    modelParams.S = HestonFD::_ModelParameters.Get_S();
+    modelParams.sig = HestonFD::_ModelParameters.Get_sig();
+    modelParams.T = HestonFD::_ModelParameters.Get_T();
+    modelParams.eta = HestonFD::_ModelParameters.Get_eta();
+    modelParams.V = HestonFD::_ModelParameters.Get_V();
+}
+
 } // namespace fintech
 } // namespace xf
@@ -14,12 +14,14 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <limits>
 #include <map>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -41,33 +43,32 @@ void AdiSolver::createGrid(void) {
     }
 }
 
-void AdiSolver::solve(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl::Kernel* pKernel, double* u) {
+void AdiSolver::assemble(std::map<std::pair<int, int>, double>& sparse_map_A,
+                         std::vector<std::vector<double> >& A1_vec,
+                         std::vector<std::vector<double> >& A2_vec,
+                         std::vector<std::vector<double> >& X1,
+                         std::vector<std::vector<double> >& X2,
+                         std::vector<double>& b) {
     unsigned int i, j;
-    unsigned int m1 = AdiSolverParams.m1;
-    unsigned int m2 = AdiSolverParams.m2;
-    unsigned int N = AdiSolverParams.N;
-    unsigned int m = m1 * m2;
+    unsigned int m = AdiSolverParams.m1 * AdiSolverParams.m2;
     double theta = AdiSolverParams.theta;
     double dt = AdiSolverParams.dt;
 
-    std::map<std::pair<int, int>, double> sparse_map_A;
     std::vector<double> tempVec31(3);
-    std::vector<std::vector<double> > A1_vec(m, tempVec31);
+    A1_vec.assign(m, tempVec31);
     std::vector<double> tempVec5(5);
-    std::vector<std::vector<double> > A2_vec(m, tempVec5);
-
-    std::vector<double> b(m);
-    std::vector<double> u0(m);
-
+    A2_vec.assign(m, tempVec5);
     std::vector<double> tempVec32(3);
-    std::vector<std::vector<double> > X1(m, tempVec32);
+    X1.assign(m, tempVec32);
     std::vector<double> tempVec51(5);
-    std::vector<std::vector<double> > X2(m, tempVec51);
+    X2.assign(m, tempVec51);
+    b.assign(m, 0.0);
+    sparse_map_A.clear();
 
     // Set up matrices and boundary conditions
     Matrices matrixGen(sGrid, vGrid, _sDelta, _vDelta, AdiModelParams, AdiSolverParams);
     matrixGen.coeffsInit();
-    matrixGen.createA(sparse_map_A, A1_vec, A2_vec);
+    matrixGen.createA(sparse_map_A, A1_vec, A2_vec, std::thread::hardware_concurrency());
     matrixGen.createB(b);
 
     std::map<std::pair<int, int>, double>::iterator it;
@@ -98,15 +99,30 @@ void AdiSolver::solve(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl
     for (i = 0; i < b.size(); i++) {
         b.at(i) = dt * b.at(i);
     }
+}
 
+void AdiSolver::createPayoff(double K, std::vector<double>& u0) {
+    unsigned int i, j;
+    unsigned int m1 = AdiSolverParams.m1;
+    unsigned int m2 = AdiSolverParams.m2;
+
+    u0.resize(m1 * m2);
     for (i = 0; i < m2; i++) {
         for (j = 0; j < m1; j++) {
-            u0.at((i * m1) + j) = (sGrid.at(j) - AdiModelParams.K) > 0 ? (sGrid.at(j) - AdiModelParams.K) : 0;
+            u0.at((i * m1) + j) = (sGrid.at(j) - K) > 0 ? (sGrid.at(j) - K) : 0;
         }
     }
+}
 
 #ifdef PRINT_CSV
-
+static void printCSV(std::map<std::pair<int, int>, double>& sparse_map_A,
+                     std::vector<std::vector<double> >& A1_vec,
+                     std::vector<std::vector<double> >& A2_vec,
+                     std::vector<std::vector<double> >& X1,
+                     std::vector<std::vector<double> >& X2,
+                     std::vector<double>& b,
+                     std::vector<double>& u0) {
+    unsigned int i;
     std::ofstream myfile;
     myfile.open("cplusplus_A.csv");
     myfile << sparse_map_A.size() << "\n";
@@ -153,6 +169,27 @@ void AdiSolver::solve(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl
         myfile << std::scientific << std::setprecision(18) << u0[i] << "\n";
     }
     myfile.close();
+}
+#endif
+
+void AdiSolver::solve(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl::Kernel* pKernel, double* u) {
+    unsigned int m1 = AdiSolverParams.m1;
+    unsigned int m2 = AdiSolverParams.m2;
+    unsigned int N = AdiSolverParams.N;
+
+    std::map<std::pair<int, int>, double> sparse_map_A;
+    std::vector<std::vector<double> > A1_vec;
+    std::vector<std::vector<double> > A2_vec;
+    std::vector<std::vector<double> > X1;
+    std::vector<std::vector<double> > X2;
+    std::vector<double> b;
+    std::vector<double> u0;
+
+    assemble(sparse_map_A, A1_vec, A2_vec, X1, X2, b);
+    createPayoff(AdiModelParams.K, u0);
+
+#ifdef PRINT_CSV
+    printCSV(sparse_map_A, A1_vec, A2_vec, X1, X2, b, u0);
 #endif
 
     if ((pContext != nullptr) && (pCommandQueue != nullptr) && (pKernel != nullptr)) {
@@ -164,121 +201,96 @@ void AdiSolver::solve(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl
 }
 
 void AdiSolver::solve(double* u) {
-    unsigned int i, j;
-    unsigned int m1 = AdiSolverParams.m1;
-    unsigned int m2 = AdiSolverParams.m2;
-    unsigned int N = AdiSolverParams.N;
-    unsigned int m = m1 * m2;
-    double theta = AdiSolverParams.theta;
+    solve(nullptr, nullptr, nullptr, u);
+}
+
+void AdiSolver::solveBatch(cl::Context* pContext,
+                           cl::CommandQueue* pCommandQueue,
+                           cl::Kernel* pKernel,
+                           std::vector<double>& strikes,
+                           std::vector<double>& maturities,
+                           std::vector<std::vector<double> >& priceGrids) {
+    unsigned int i;
+    unsigned int m = AdiSolverParams.m1 * AdiSolverParams.m2;
     double dt = AdiSolverParams.dt;
 
     std::map<std::pair<int, int>, double> sparse_map_A;
-    std::vector<double> tempVec31(3);
-    std::vector<std::vector<double> > A1_vec(m, tempVec31);
-    std::vector<double> tempVec5(5);
-    std::vector<std::vector<double> > A2_vec(m, tempVec5);
-
-    std::vector<double> b(m);
-    std::vector<double> u0(m);
-
-    std::vector<double> tempVec32(3);
-    std::vector<std::vector<double> > X1(m, tempVec32);
-    std::vector<double> tempVec51(5);
-    std::vector<std::vector<double> > X2(m, tempVec51);
-
-    // Set up matrices and boundary conditions
-    Matrices matrixGen(sGrid, vGrid, _sDelta, _vDelta, AdiModelParams, AdiSolverParams);
-    matrixGen.coeffsInit();
-    matrixGen.createA(sparse_map_A, A1_vec, A2_vec);
-    matrixGen.createB(b);
-
-    std::map<std::pair<int, int>, double>::iterator it;
-    for (it = sparse_map_A.begin(); it != sparse_map_A.end(); it++) {
-        it->second = it->second * dt;
-    }
-
-    for (i = 0; i < A1_vec.size(); i++) {
-        for (j = 0; j < 3; j++) {
-            X1.at(i).at(j) = 0.0 - theta * dt * A1_vec.at(i).at(j);
-            if (j == 1) {
-                X1.at(i).at(j) = X1.at(i).at(j) + 1;
-            }
-            A1_vec.at(i).at(j) = A1_vec.at(i).at(j) * dt * theta;
+    std::vector<std::vector<double> > A1_vec;
+    std::vector<std::vector<double> > A2_vec;
+    std::vector<std::vector<double> > X1;
+    std::vector<std::vector<double> > X2;
+    std::vector<double> b;
+
+    // The operator does not depend on the payoff, so it is assembled and loaded once for the whole batch
+    assemble(sparse_map_A, A1_vec, A2_vec, X1, X2, b);
+
+    KernelSystem system(pContext, pCommandQueue, pKernel);
+    system.load(sparse_map_A, A1_vec, A2_vec, X1, X2, b, AdiSolverParams.m1, AdiSolverParams.m2);
+
+    // Solve in order of strike then maturity. The scheme is time homogeneous, so the price grid after n steps from
+    // the payoff is the initial condition for the steps to a later maturity with the same strike.
+    std::vector<unsigned int> order(strikes.size());
+    for (i = 0; i < order.size(); i++) {
+        order.at(i) = i;
+    }
+    std::sort(order.begin(), order.end(), [&strikes, &maturities](unsigned int a, unsigned int c) {
+        return (strikes.at(a) < strikes.at(c)) ||
+               ((strikes.at(a) == strikes.at(c)) && (maturities.at(a) < maturities.at(c)));
+    });
+
+    priceGrids.resize(strikes.size());
+
+    // The grids after stepsLow and stepsLow + 1 steps, the second one only when haveHigh is set
+    std::vector<double> uLow;
+    std::vector<double> uHigh;
+    int stepsLow = 0;
+    bool haveHigh = false;
+    for (i = 0; i < order.size(); i++) {
+        unsigned int index = order.at(i);
+        double steps = maturities.at(index) / dt;
+        int whole = (int)std::floor(steps + 1e-9);
+        double fraction = steps - whole;
+        if (fraction < 1e-9) {
+            fraction = 0.0;
         }
-    }
 
-    for (i = 0; i < A2_vec.size(); i++) {
-        for (j = 0; j < 5; j++) {
-            X2.at(i).at(j) = 0.0 - theta * dt * A2_vec.at(i).at(j);
-            if (j == 2) {
-                X2.at(i).at(j) = X2.at(i).at(j) + 1;
-            }
-            A2_vec.at(i).at(j) = A2_vec.at(i).at(j) * dt * theta;
+        if ((i == 0) || (strikes.at(index) != strikes.at(order.at(i - 1)))) {
+            createPayoff(strikes.at(index), uLow);
+            stepsLow = 0;
+            haveHigh = false;
         }
-    }
-
-    for (i = 0; i < b.size(); i++) {
-        b.at(i) = dt * b.at(i);
-    }
 
-    for (i = 0; i < m2; i++) {
-        for (j = 0; j < m1; j++) {
-            u0.at((i * m1) + j) = (sGrid.at(j) - AdiModelParams.K) > 0 ? (sGrid.at(j) - AdiModelParams.K) : 0;
+        // Move the grids forward to the whole number of steps below the maturity
+        if (haveHigh && (whole == stepsLow + 1)) {
+            uLow.swap(uHigh);
+            stepsLow = whole;
+            haveHigh = false;
+        } else if (whole > stepsLow) {
+            std::vector<double>& uFrom = haveHigh ? uHigh : uLow;
+            int stepsFrom = haveHigh ? stepsLow + 1 : stepsLow;
+            std::vector<double> u(m);
+            system.run(uFrom, whole - stepsFrom, u.data());
+            uLow.swap(u);
+            stepsLow = whole;
+            haveHigh = false;
         }
-    }
-
-#ifdef PRINT_CSV
-
-    std::ofstream myfile;
-    myfile.open("cplusplus_A.csv");
-    myfile << sparse_map_A.size() << "\n";
-    for (auto elem : sparse_map_A) {
-        myfile << std::setprecision(20) << elem.first.first << "," << elem.first.second << "," << elem.second << "\n";
-    }
-    myfile.close();
-
-    myfile.open("cplusplus_A1.csv");
-    for (i = 0; i < A1_vec.size(); i++) {
-        myfile << std::scientific << std::setprecision(18) << A1_vec[i][0] << "," << A1_vec[i][1] << "," << A1_vec[i][2]
-               << "\n";
-    }
-    myfile.close();
-
-    myfile.open("cplusplus_A2.csv");
-    for (i = 0; i < A2_vec.size(); i++) {
-        myfile << std::scientific << std::setprecision(18) << A2_vec[i][0] << "," << A2_vec[i][1] << "," << A2_vec[i][2]
-               << "," << A2_vec[i][3] << "," << A2_vec[i][4] << "\n";
-    }
-    myfile.close();
-
-    myfile.open("cplusplus_b.csv");
-    for (i = 0; i < b.size(); i++) {
-        myfile << std::scientific << std::setprecision(18) << b[i] << "\n";
-    }
-    myfile.close();
-
-    myfile.open("cplusplus_X1.csv");
-    for (i = 0; i < X1.size(); i++) {
-        myfile << std::scientific << std::setprecision(18) << X1[i][0] << "," << X1[i][1] << "," << X1[i][2] << "\n";
-    }
-    myfile.close();
 
-    myfile.open("cplusplus_X2.csv");
-    for (i = 0; i < X2.size(); i++) {
-        myfile << std::scientific << std::setprecision(18) << X2[i][0] << "," << X2[i][1] << "," << X2[i][2] << ","
-               << X2[i][3] << "," << X2[i][4] << "\n";
-    }
-    myfile.close();
-
-    myfile.open("cplusplus_u0.csv");
-    for (i = 0; i < u0.size(); i++) {
-        myfile << std::scientific << std::setprecision(18) << u0[i] << "\n";
+        if (fraction == 0.0) {
+            priceGrids.at(index) = uLow;
+        } else {
+            // A maturity between two steps is interpolated linearly in time between the grids either side of it.
+            // That leaves an error of order dt^2 rather than the order dt of rounding to the nearest step.
+            if (!haveHigh) {
+                uHigh.resize(m);
+                system.run(uLow, 1, uHigh.data());
+                haveHigh = true;
+            }
+            priceGrids.at(index).resize(m);
+            for (unsigned int j = 0; j < m; j++) {
+                priceGrids.at(index).at(j) = (1.0 - fraction) * uLow.at(j) + fraction * uHigh.at(j);
+            }
+        }
     }
-    myfile.close();
-#endif
-
-    // Kernel call
-    xf::fintech::hestonfd::kernel_call(sparse_map_A, A1_vec, A2_vec, X1, X2, b, u0, m1, m2, N, u);
 }
 
 double AdiSolver::createUniformGrid(void) {
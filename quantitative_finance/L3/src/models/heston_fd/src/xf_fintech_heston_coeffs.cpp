@@ -69,7 +69,7 @@ double Coeffs::vDelta(int i, int pos) {
     return delta(_vDelta, i, pos);
 }
 
-double Coeffs::alpha(std::vector<double> dx, int i, int pos) {
+double Coeffs::alpha(const std::vector<double>& dx, int i, int pos) {
     double coeff = 0;
 
     if (pos == -2) {
@@ -83,7 +83,7 @@ double Coeffs::alpha(std::vector<double> dx, int i, int pos) {
     return coeff;
 }
 
-double Coeffs::beta(std::vector<double> dx, int i, int pos) {
+double Coeffs::beta(const std::vector<double>& dx, int i, int pos) {
     double coeff = 0;
 
     if (pos == -1) {
@@ -97,7 +97,7 @@ double Coeffs::beta(std::vector<double> dx, int i, int pos) {
     return coeff;
 }
 
-double Coeffs::gamma(std::vector<double> dx, int i, int pos) {
+double Coeffs::gamma(const std::vector<double>& dx, int i, int pos) {
     double coeff = 0;
 
     if (pos == 0) {
@@ -111,7 +111,7 @@ double Coeffs::gamma(std::vector<double> dx, int i, int pos) {
     return coeff;
 }
 
-double Coeffs::delta(std::vector<double> dx, int i, int pos) {
+double Coeffs::delta(const std::vector<double>& dx, int i, int pos) {
     double coeff = 0;
 
     if (pos == -1) {
@@ -94,54 +94,69 @@ void kernel_call(cl::Context* pContext,
                  int M2,
                  int N,
                  double* price_grid) {
+    KernelSystem system(pContext, pCommandQueue, pKernel);
+
+    system.load(sparse_map_A, A1_vec, A2_vec, X1_vec, X2_vec, b_vec, M1, M2);
+    system.run(u0_vec, N, price_grid);
+}
+
+KernelSystem::KernelSystem(cl::Context* pContext, cl::CommandQueue* pCommandQueue, cl::Kernel* pKernel)
+    : m_pContext(pContext),
+      m_pCommandQueue(pCommandQueue),
+      m_pKernel(pKernel),
+      m_A(FD_mSize * 10),
+      m_Ar(FD_mSize * 10),
+      m_Ac(FD_mSize * 10),
+      m_A1(FD_mSize * 3),
+      m_X1(FD_mSize * 3),
+      m_A2(FD_mSize * 5),
+      m_X2(FD_mSize * 5),
+      m_b(FD_mSize),
+      m_u0(FD_mSize),
+      m_price(FD_mSize),
+      m_A_nnz(0),
+      m_M1(0),
+      m_M2(0),
+      m_bLoaded(false) {}
+
+void KernelSystem::load(std::map<std::pair<int, int>, double>& sparse_map_A,
+                        std::vector<std::vector<double> >& A1_vec,
+                        std::vector<std::vector<double> >& A2_vec,
+                        std::vector<std::vector<double> >& X1_vec,
+                        std::vector<std::vector<double> >& X2_vec,
+                        std::vector<double>& b_vec,
+                        int M1,
+                        int M2) {
     cl_int err;
 
     // Reference vector/array sizes based on grid size
     const unsigned int M = FD_mSize;
-    const unsigned int a_size = M * 10;
     const unsigned int a1_size = M * 3; // Guaranteed to fit in integer number of DDR words
     const unsigned int a2_size = M * 5; // regardless of data type for any sensible M
 
-    // Vectors for parameter storage.  These use an aligned allocator in order
-    // to avoid an additional copy of the host memory into the device
-    vector<FD_dataType, aligned_allocator<FD_dataType> > A(a_size);
-    vector<unsigned int, aligned_allocator<unsigned int> > Ar(a_size);
-    vector<unsigned int, aligned_allocator<unsigned int> > Ac(a_size);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > A1(a1_size);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > X1(a1_size);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > A2(a2_size);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > X2(a2_size);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > b(M);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > u0(M);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > price(M);
-    vector<FD_dataType, aligned_allocator<FD_dataType> > ref(M);
-
-    // Sparse array non-zero count
-    unsigned int A_nnz;
-
     // Size of data and index vectors padded to fill whole 512-bit DDR word
     unsigned int A_pad;
     unsigned int Arc_pad;
 
     unsigned int i = 0;
     for (auto elem : sparse_map_A) {
-        Ar[i] = (unsigned int)elem.first.first;
-        Ac[i] = (unsigned int)elem.first.second;
-        A[i] = (FD_dataType)elem.second;
+        m_Ar[i] = (unsigned int)elem.first.first;
+        m_Ac[i] = (unsigned int)elem.first.second;
+        m_A[i] = (FD_dataType)elem.second;
         i++;
     }
-    A_nnz = sparse_map_A.size();
+    m_A_nnz = sparse_map_A.size();
 
     // Need to pad the A array and row/column arrays so they fit into DDR word
     // Different amounts of padding needed depending on width of data
-    A_pad = A_nnz;
-    Arc_pad = A_nnz;
+    A_pad = m_A_nnz;
+    Arc_pad = m_A_nnz;
     while (A_pad % (64 / sizeof(FD_dataType)) != 0) {
-        A[A_pad++] = 0;
+        m_A[A_pad++] = 0;
     }
     while (Arc_pad % (64 / sizeof(unsigned int)) != 0) {
-        Ar[Arc_pad] = 0;
-        Ac[Arc_pad] = 0;
+        m_Ar[Arc_pad] = 0;
+        m_Ac[Arc_pad] = 0;
         Arc_pad++;
     }
 
@@ -149,8 +164,8 @@ void kernel_call(cl::Context* pContext,
     i = 0;
     for (row = 0; row < 3; row++) {
         for (col = 0; col < M; col++) {
-            A1[i] = (FD_dataType)A1_vec[col][row];
-            X1[i] = (FD_dataType)X1_vec[col][row];
+            m_A1[i] = (FD_dataType)A1_vec[col][row];
+            m_X1[i] = (FD_dataType)X1_vec[col][row];
             i++;
         }
     }
@@ -158,78 +173,98 @@ void kernel_call(cl::Context* pContext,
     i = 0;
     for (row = 0; row < 5; row++) {
         for (col = 0; col < M; col++) {
-            A2[i] = (FD_dataType)A2_vec[col][row];
-            X2[i] = (FD_dataType)X2_vec[col][row];
+            m_A2[i] = (FD_dataType)A2_vec[col][row];
+            m_X2[i] = (FD_dataType)X2_vec[col][row];
             i++;
         }
     }
 
     for (i = 0; i < M; i++) {
-        u0[i] = (FD_dataType)u0_vec.at(i);
-        b[i] = (FD_dataType)b_vec.at(i);
+        m_b[i] = (FD_dataType)b_vec.at(i);
     }
 
+    m_M1 = M1;
+    m_M2 = M2;
+
     // Allocate Buffer in Global Memory
     // Buffers are allocated using CL_MEM_USE_HOST_PTR for efficient memory and
     // Device-to-host communication
-    OCL_CHECK(err, cl::Buffer buffer_A(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, A_pad * sizeof(FD_dataType),
-                                       A.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_A_row(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
-                                           Arc_pad * sizeof(unsigned int), Ar.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_A_col(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
-                                           Arc_pad * sizeof(unsigned int), Ac.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_A1(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
-                                        a1_size * sizeof(FD_dataType), A1.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_A2(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
-                                        a2_size * sizeof(FD_dataType), A2.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_X1(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
-                                        a1_size * sizeof(FD_dataType), X1.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_X2(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
-                                        a2_size * sizeof(FD_dataType), X2.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_b(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, M * sizeof(FD_dataType),
-                                       b.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_u0(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY, M * sizeof(FD_dataType),
-                                        u0.data(), &err));
-    OCL_CHECK(err, cl::Buffer buffer_price(*pContext, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY, M * sizeof(FD_dataType),
-                                           price.data(), &err));
+    OCL_CHECK(err, m_buffer_A = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                           A_pad * sizeof(FD_dataType), m_A.data(), &err));
+    OCL_CHECK(err, m_buffer_A_row = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                               Arc_pad * sizeof(unsigned int), m_Ar.data(), &err));
+    OCL_CHECK(err, m_buffer_A_col = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                               Arc_pad * sizeof(unsigned int), m_Ac.data(), &err));
+    OCL_CHECK(err, m_buffer_A1 = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                            a1_size * sizeof(FD_dataType), m_A1.data(), &err));
+    OCL_CHECK(err, m_buffer_A2 = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                            a2_size * sizeof(FD_dataType), m_A2.data(), &err));
+    OCL_CHECK(err, m_buffer_X1 = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                            a1_size * sizeof(FD_dataType), m_X1.data(), &err));
+    OCL_CHECK(err, m_buffer_X2 = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                            a2_size * sizeof(FD_dataType), m_X2.data(), &err));
+    OCL_CHECK(err, m_buffer_b = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                           M * sizeof(FD_dataType), m_b.data(), &err));
+    OCL_CHECK(err, m_buffer_u0 = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                            M * sizeof(FD_dataType), m_u0.data(), &err));
+    OCL_CHECK(err, m_buffer_price = cl::Buffer(*m_pContext, CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                                               M * sizeof(FD_dataType), m_price.data(), &err));
+
+    // Copy the system to device global memory, it stays there for every run
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_A}, 0));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_A_row}, 0));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_A_col}, 0));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_A1}, 0));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_X1}, 0));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_A2}, 0));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_X2}, 0));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_b}, 0));
+
+    m_bLoaded = true;
+}
+
+void KernelSystem::run(std::vector<double>& u0_vec, int N, double* price_grid) {
+    cl_int err;
+    unsigned int i;
+    const unsigned int M = FD_mSize;
+
+    if (!m_bLoaded) {
+        printf("%s:%d Error, the system has not been loaded\n", __FILE__, __LINE__);
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < M; i++) {
+        m_u0[i] = (FD_dataType)u0_vec.at(i);
+    }
 
     // Set the arguments
-    OCL_CHECK(err, err = pKernel->setArg(0, buffer_A));
-    OCL_CHECK(err, err = pKernel->setArg(1, buffer_A_row));
-    OCL_CHECK(err, err = pKernel->setArg(2, buffer_A_col));
-    OCL_CHECK(err, err = pKernel->setArg(3, A_nnz));
-    OCL_CHECK(err, err = pKernel->setArg(4, buffer_A1));
-    OCL_CHECK(err, err = pKernel->setArg(5, buffer_A2));
-    OCL_CHECK(err, err = pKernel->setArg(6, buffer_X1));
-    OCL_CHECK(err, err = pKernel->setArg(7, buffer_X2));
-    OCL_CHECK(err, err = pKernel->setArg(8, buffer_b));
-    OCL_CHECK(err, err = pKernel->setArg(9, buffer_u0));
-    OCL_CHECK(err, err = pKernel->setArg(10, M1));
-    OCL_CHECK(err, err = pKernel->setArg(11, M2));
-    OCL_CHECK(err, err = pKernel->setArg(12, N));
-    OCL_CHECK(err, err = pKernel->setArg(13, buffer_price));
-
-    // Copy input data to device global memory
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_A}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_A_row}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_A_col}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_A1}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_X1}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_A2}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_X2}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_b}, 0));
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_u0}, 0));
+    OCL_CHECK(err, err = m_pKernel->setArg(0, m_buffer_A));
+    OCL_CHECK(err, err = m_pKernel->setArg(1, m_buffer_A_row));
+    OCL_CHECK(err, err = m_pKernel->setArg(2, m_buffer_A_col));
+    OCL_CHECK(err, err = m_pKernel->setArg(3, m_A_nnz));
+    OCL_CHECK(err, err = m_pKernel->setArg(4, m_buffer_A1));
+    OCL_CHECK(err, err = m_pKernel->setArg(5, m_buffer_A2));
+    OCL_CHECK(err, err = m_pKernel->setArg(6, m_buffer_X1));
+    OCL_CHECK(err, err = m_pKernel->setArg(7, m_buffer_X2));
+    OCL_CHECK(err, err = m_pKernel->setArg(8, m_buffer_b));
+    OCL_CHECK(err, err = m_pKernel->setArg(9, m_buffer_u0));
+    OCL_CHECK(err, err = m_pKernel->setArg(10, m_M1));
+    OCL_CHECK(err, err = m_pKernel->setArg(11, m_M2));
+    OCL_CHECK(err, err = m_pKernel->setArg(12, N));
+    OCL_CHECK(err, err = m_pKernel->setArg(13, m_buffer_price));
+
+    // Only the initial condition changes between runs
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_u0}, 0));
 
     // Launch the Kernel
-    OCL_CHECK(err, err = pCommandQueue->enqueueTask(*pKernel));
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueTask(*m_pKernel));
 
     // Copy Result from Device Global Memory to Host Local Memory
-    OCL_CHECK(err, err = pCommandQueue->enqueueMigrateMemObjects({buffer_price}, CL_MIGRATE_MEM_OBJECT_HOST));
-    pCommandQueue->finish();
-    // OPENCL HOST CODE AREA END
+    OCL_CHECK(err, err = m_pCommandQueue->enqueueMigrateMemObjects({m_buffer_price}, CL_MIGRATE_MEM_OBJECT_HOST));
+    m_pCommandQueue->finish();
 
     // Return the price grid
-    for (i = 0; i < M; ++i) price_grid[i] = price[i];
+    for (i = 0; i < M; ++i) price_grid[i] = m_price[i];
 }
 
 } // namespace hestonfd
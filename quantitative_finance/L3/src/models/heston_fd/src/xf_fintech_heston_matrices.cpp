@@ -16,7 +16,9 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include "xf_fintech_heston_coeffs.hpp"
@@ -37,24 +39,72 @@ void Matrices::insertOrUpdate(std::map<std::pair<int, int>, double>& sparse_map_
 
 void Matrices::createA(std::map<std::pair<int, int>, double>& sparse_map_A,
                        std::vector<std::vector<double> >& vec_A1,
-                       std::vector<std::vector<double> >& vec_A2) {
+                       std::vector<std::vector<double> >& vec_A2,
+                       unsigned int numThreads) {
     /* Calculates the A0, A1, A2 matrices
      * Returns :
      * A - sparse matrix in S - major order
      * A1_vec - A1 diagonal vectors in S - major order
      * A2_vec - A2 diagonal vectors in v - major order
+     *
+     * Every term for grid row j lands in matrix rows j * m1 .. j * m1 + m1 - 1, so the v - rows are split into
+     * contiguous ranges assembled concurrently into separate maps. The maps hold disjoint rows and are merged
+     * into the output afterwards; each element sees the same additions in the same order as the single threaded
+     * assembly.
      */
+    int m2 = solverParams.m2;
+    int numRanges = (numThreads < 1) ? 1 : (int)numThreads;
+    if (numRanges > m2) {
+        numRanges = m2;
+    }
+
+    if (numRanges == 1) {
+        createARows(sparse_map_A, vec_A1, vec_A2, 0, m2);
+        return;
+    }
+
+    std::vector<std::map<std::pair<int, int>, double> > partial(numRanges);
+    std::vector<std::thread> workers;
+    for (int r = 0; r < numRanges; r++) {
+        int jStart = (r * m2) / numRanges;
+        int jEnd = ((r + 1) * m2) / numRanges;
+        workers.push_back(std::thread(&Matrices::createARows, this, std::ref(partial.at(r)), std::ref(vec_A1),
+                                      std::ref(vec_A2), jStart, jEnd));
+    }
+    for (int r = 0; r < numRanges; r++) {
+        workers.at(r).join();
+    }
+
+    // The ranges hold ascending rows, so each element is placed with a hint just after the previous one
+    std::map<std::pair<int, int>, double>::iterator hint = sparse_map_A.begin();
+    for (int r = 0; r < numRanges; r++) {
+        for (auto elem : partial.at(r)) {
+            hint = sparse_map_A.emplace_hint(hint, elem.first, 0.0);
+            hint->second += elem.second;
+            hint++;
+        }
+    }
+
+    return;
+}
+
+void Matrices::createARows(std::map<std::pair<int, int>, double>& sparse_map_A,
+                           std::vector<std::vector<double> >& vec_A1,
+                           std::vector<std::vector<double> >& vec_A2,
+                           int jStart,
+                           int jEnd) {
     int i, j, k, l, row, col;
     int m1 = solverParams.m1;
     int m2 = solverParams.m2;
     double c, val, a, b;
+    int jLast = (jEnd < m2 - 1) ? jEnd : m2 - 1;
 
     /* A0 contribution to A matrix - this is the mixed derivative term
      * Start both ranges at 1 as mixed term is zeroed by s = 0 and /or v = 0
      * End both terms at end - 1 as the mixed derivative is zero implied by
      * Neumann boundary condition(2.4)
      */
-    for (j = 1; j < m2 - 1; j++) {
+    for (j = (jStart > 1) ? jStart : 1; j < jLast; j++) {
         for (i = 1; i < m1 - 1; i++) {
             c = modelParams.rho * modelParams.sig * sGrid.at(i) * vGrid.at(j);
             for (k = -1; k <= 1; k++) {
@@ -73,7 +123,7 @@ void Matrices::createA(std::map<std::pair<int, int>, double>& sparse_map_A,
      * For s = S i.e.A[m1], boundary condition applies for du / ds
      * At s = 0, u is zero so don't need to worry about the rdU term here
      */
-    for (j = 0; j < m2 - 1; j++) {
+    for (j = jStart; j < jLast; j++) {
         for (i = 1; i < m1 - 1; i++) {
             a = 0.5 * pow(sGrid.at(i), 2) * vGrid.at(j);         // d2u / ds2 term
             b = (modelParams.rd - modelParams.rf) * sGrid.at(i); // du / ds term
@@ -123,7 +173,7 @@ void Matrices::createA(std::map<std::pair<int, int>, double>& sparse_map_A,
      */
     double temp, temp2;
 
-    for (j = 0; j < m2 - 1; j++) {
+    for (j = jStart; j < jLast; j++) {
         for (i = 0; i < m1; i++) {
             temp = modelParams.kappa * (modelParams.eta - vGrid.at(j)); // First order term
             temp2 = 0.5 * pow(modelParams.sig, 2) * vGrid.at(j);        // Second order term
@@ -229,6 +229,7 @@ int FDHeston::run(double stockPrice,
         solver_parameters.Set_m1(m_M1);
         solver_parameters.Set_m2(m_M2);
         solver_parameters.Set_N(numSteps);
+        solver_parameters.Set_dt(timeToMaturity / numSteps);
 
         // Create memory for results
         HestonFDPriceRam price_ram(solver_parameters);
@@ -330,6 +331,7 @@ int FDHeston::run(double stockPrice,
         solver_parameters.Set_m1(m_M1);
         solver_parameters.Set_m2(m_M2);
         solver_parameters.Set_N(numSteps);
+        solver_parameters.Set_dt(timeToMaturity / numSteps);
 
         // Create memory for results
         HestonFDPriceRam price_ram(solver_parameters);
@@ -412,6 +414,7 @@ int FDHeston::run(double stockPrice,
         solver_parameters.Set_m1(m_M1);
         solver_parameters.Set_m2(m_M2);
         solver_parameters.Set_N(numSteps);
+        solver_parameters.Set_dt(timeToMaturity / numSteps);
 
         // Create memory for results
         HestonFDPriceRam price_ram(solver_parameters);
@@ -446,6 +449,106 @@ int FDHeston::run(double stockPrice,
     return retval;
 }
 
+int FDHeston::run(double stockPrice,
+                  double* strikePrice,
+                  double riskFreeRateDomestic,
+                  double volatility,
+                  double* timeToMaturity,
+                  double meanReversionRate,      // kappa
+                  double volatilityOfVolatility, // sigma
+                  double correlationCoefficient, // rho
+                  double longRunAveragePrice,    // eta
+                  unsigned int numOptions,
+                  double* pOptionPrice) {
+    int retval = XLNX_OK;
+
+    // NOTE - run timers are handled by internal function...
+
+    retval = this->run(stockPrice, strikePrice, riskFreeRateDomestic, volatility, timeToMaturity, meanReversionRate,
+                       volatilityOfVolatility, correlationCoefficient, longRunAveragePrice, DEFAULT_N, numOptions,
+                       pOptionPrice);
+
+    return retval;
+}
+
+int FDHeston::run(double stockPrice,
+                  double* strikePrice,
+                  double riskFreeRateDomestic,
+                  double volatility,
+                  double* timeToMaturity,
+                  double meanReversionRate,      // kappa
+                  double volatilityOfVolatility, // sigma
+                  double correlationCoefficient, // rho
+                  double longRunAveragePrice,    // eta
+                  int numSteps,
+                  unsigned int numOptions,
+                  double* pOptionPrice) {
+    int retval = XLNX_OK;
+    HestonFD::HestonFDReturnVal hestonRetVal = HestonFD::HestonFDReturnVal::XLNXOK;
+
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
+    if (!deviceIsPrepared()) {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    } else if (numOptions > 0) {
+        HestonFDOCLObjects oclObjects(m_pContext, m_pCommandQueue, m_pKernel);
+
+        std::vector<double> strikes(strikePrice, strikePrice + numOptions);
+        std::vector<double> maturities(timeToMaturity, timeToMaturity + numOptions);
+
+        // One grid for the batch, concentrated around the mean strike and stepped with the time step of the
+        // longest maturity
+        double referenceStrike = 0.0;
+        double longestMaturity = 0.0;
+        for (unsigned int i = 0; i < numOptions; i++) {
+            referenceStrike += strikes[i] / numOptions;
+            if (maturities[i] > longestMaturity) {
+                longestMaturity = maturities[i];
+            }
+        }
+
+        // Pass in solver and model parameters
+        HestonFDModelParameters model_parameters(referenceStrike, stockPrice, volatility, longestMaturity,
+                                                 meanReversionRate, volatilityOfVolatility, correlationCoefficient,
+                                                 longRunAveragePrice, riskFreeRateDomestic, DEFAULT_RF);
+
+        HestonFDSolverParameters solver_parameters(model_parameters);
+
+        solver_parameters.Set_m1(m_M1);
+        solver_parameters.Set_m2(m_M2);
+        solver_parameters.Set_N(numSteps);
+        solver_parameters.Set_dt(longestMaturity / numSteps);
+
+        HestonFD heston(model_parameters, solver_parameters, oclObjects);
+
+        // Solve
+
+        std::vector<std::vector<double> > priceGrids;
+        std::vector<double> s_grid;
+        std::vector<double> v_grid;
+
+        hestonRetVal = heston.SolveBatch(strikes, maturities, priceGrids, s_grid, v_grid);
+
+        if (hestonRetVal != HestonFD::HestonFDReturnVal::XLNXOK) {
+            retval = XLNX_ERROR_MODEL_INTERNAL_ERROR;
+        }
+
+        for (unsigned int i = 0; retval == XLNX_OK && i < numOptions; i++) {
+            if (!Xilinx_Interpolate(priceGrids[i].data(), s_grid.data(), v_grid.data(), m_M1, m_M2, stockPrice,
+                                    volatility, &pOptionPrice[i])) {
+                Trace::printError("[XLNX] ERROR: failed to calculate the NPV\n");
+                retval = XLNX_ERROR_LINEAR_INTERPOLATION_FAILED;
+            } else {
+                Trace::printInfo("[XLNX] NPV: %f\n", pOptionPrice[i]);
+            }
+        }
+    }
+
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
+    return retval;
+}
+
 long long int FDHeston::getLastRunTime(void) {
     long long int duration = 0;
 
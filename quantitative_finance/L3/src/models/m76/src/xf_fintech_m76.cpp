@@ -184,6 +184,8 @@ int m76::releaseOCLObjects(void) {
 int m76::run(struct m76_input_data* inputData, float* outputData, int numOptions) {
     int retval = XLNX_OK;
 
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
     if (retval == XLNX_OK) {
         if (deviceIsPrepared()) {
             int num_options = numOptions;
@@ -228,5 +230,16 @@ int m76::run(struct m76_input_data* inputData, float* outputData, int numOptions
         }
     }
 
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
     return retval;
 }
+
+long long int m76::getLastRunTime(void) {
+    long long int duration = 0;
+
+    duration =
+        (long long int)std::chrono::duration_cast<std::chrono::microseconds>(m_runEndTime - m_runStartTime).count();
+
+    return duration;
+}
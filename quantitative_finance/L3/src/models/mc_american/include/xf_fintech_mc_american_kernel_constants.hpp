@@ -25,8 +25,10 @@ typedef double KDataType;
 #define Unroll_STEP (2)
 #define UN_K2_PATH (2)
 #define UN_K3 (4)
-#define ITERATION (4)
+#define ITERATION (32)
 #define DEPTH_P (1024 * TIMESTEPS * ITERATION)
+#define DEPTH_F (1024 * ITERATION)
+#define CALIB_SAMPLES_MAX (1024 * UN_K1 * ITERATION)
 #define DEPTH_M (9 * TIMESTEPS)
 #define SZ (8 * sizeof(KDataType))
 #define COEF_DEPTH (1024)
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 
+#include <cmath>
+
 #include "xf_fintech_error_codes.hpp"
 #include "xf_fintech_trace.hpp"
 
@@ -26,10 +28,12 @@ using namespace xf::fintech;
 static const size_t PRICE_ELEMENT_SIZE = sizeof(KDataType) * UN_K1;
 static const size_t MATRIX_ELEMENT_SIZE = sizeof(KDataType);
 static const size_t COEFF_ELEMENT_SIZE = sizeof(KDataType) * COEF;
+static const size_t FLOW_ELEMENT_SIZE = sizeof(KDataType) * UN_K1;
 
 static const size_t PRICE_NUM_ELEMENTS = DEPTH_P;
 static const size_t MATRIX_NUM_ELEMENTS = DEPTH_M;
 static const size_t COEFF_NUM_ELEMENTS = TIMESTEPS - 1;
+static const size_t FLOW_NUM_ELEMENTS = DEPTH_F;
 
 typedef struct _XCLBINLookupElement {
     Device::DeviceType deviceType;
@@ -54,6 +58,7 @@ MCAmerican::MCAmerican() {
     m_hostOutputPricesBuffer = nullptr;
     m_hostOutputMatrixBuffer = nullptr;
     m_hostCoeffBuffer = nullptr;
+    m_hostFlowBuffer = nullptr;
     m_hostOutputBuffer1 = nullptr;
     m_hostOutputBuffer2 = nullptr;
 
@@ -65,8 +70,13 @@ MCAmerican::MCAmerican() {
     m_pHWOutputPriceBuffer = nullptr;
     m_pHWOutputMatrixBuffer = nullptr;
     m_pHWCoeffBuffer = nullptr;
+    m_pHWFlowBuffer = nullptr;
     m_pHWOutputBuffer1 = nullptr;
     m_pHWOutputBuffer2 = nullptr;
+
+    m_calibrationSamples = 4096;
+    m_coefficientReuseTolerance = 0.0;
+    m_bCoefficientsValid = false;
 }
 
 MCAmerican::~MCAmerican() {
@@ -154,7 +164,7 @@ int MCAmerican::createOCLObjects(Device* device) {
     }
 
     if (cl_retval == CL_SUCCESS) {
-        m_pCalibrationKernel = new cl::Kernel(*m_pProgram, "MCAE_k1", &cl_retval);
+        m_pCalibrationKernel = new cl::Kernel(*m_pProgram, "MCAE_k4", &cl_retval);
     }
 
     if (cl_retval == CL_SUCCESS) {
@@ -189,6 +199,13 @@ int MCAmerican::createOCLObjects(Device* device) {
         }
     }
 
+    if (cl_retval == CL_SUCCESS) {
+        m_hostFlowBuffer = u8_allocator.allocate(FLOW_ELEMENT_SIZE * FLOW_NUM_ELEMENTS);
+        if (m_hostFlowBuffer == nullptr) {
+            cl_retval = CL_OUT_OF_HOST_MEMORY;
+        }
+    }
+
     if (cl_retval == CL_SUCCESS) {
         m_hostOutputBuffer1 = kdatatype_allocator.allocate(1);
         if (m_hostOutputBuffer1 == nullptr) {
@@ -210,6 +227,7 @@ int MCAmerican::createOCLObjects(Device* device) {
         m_outputPriceBufferOptions = {XCL_MEM_DDR_BANK0, m_hostOutputPricesBuffer, 0};
         m_outputMatrixBufferOptions = {XCL_MEM_DDR_BANK1, m_hostOutputMatrixBuffer, 0};
         m_coeffBufferOptions = {XCL_MEM_DDR_BANK2, m_hostCoeffBuffer, 0};
+        m_flowBufferOptions = {XCL_MEM_DDR_BANK0, m_hostFlowBuffer, 0};
         m_outputBufferOptions1 = {XCL_MEM_DDR_BANK3, m_hostOutputBuffer1, 0};
         m_outputBufferOptions2 = {XCL_MEM_DDR_BANK3, m_hostOutputBuffer2, 0};
     }
@@ -235,6 +253,12 @@ int MCAmerican::createOCLObjects(Device* device) {
                            (COEFF_ELEMENT_SIZE * COEFF_NUM_ELEMENTS), &m_coeffBufferOptions, &cl_retval);
     }
 
+    if (cl_retval == CL_SUCCESS) {
+        m_pHWFlowBuffer =
+            new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
+                           (FLOW_ELEMENT_SIZE * FLOW_NUM_ELEMENTS), &m_flowBufferOptions, &cl_retval);
+    }
+
     if (cl_retval == CL_SUCCESS) {
         m_pHWOutputBuffer1 =
             new cl::Buffer(*m_pContext, (CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
@@ -247,6 +271,9 @@ int MCAmerican::createOCLObjects(Device* device) {
                            sizeof(KDataType), &m_outputBufferOptions2, &cl_retval);
     }
 
+    // nothing is calibrated on this device yet
+    m_bCoefficientsValid = false;
+
     if (cl_retval != CL_SUCCESS) {
         setCLError(cl_retval);
         Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
@@ -276,6 +303,11 @@ int MCAmerican::releaseOCLObjects(void) {
         m_pHWCoeffBuffer = nullptr;
     }
 
+    if (m_pHWFlowBuffer != nullptr) {
+        delete (m_pHWFlowBuffer);
+        m_pHWFlowBuffer = nullptr;
+    }
+
     if (m_pHWOutputBuffer1 != nullptr) {
         delete (m_pHWOutputBuffer1);
         m_pHWOutputBuffer1 = nullptr;
@@ -301,6 +333,11 @@ int MCAmerican::releaseOCLObjects(void) {
         m_hostCoeffBuffer = nullptr;
     }
 
+    if (m_hostFlowBuffer != nullptr) {
+        u8_allocator.deallocate(m_hostFlowBuffer, FLOW_ELEMENT_SIZE * FLOW_NUM_ELEMENTS);
+        m_hostFlowBuffer = nullptr;
+    }
+
     if (m_hostOutputBuffer1 != nullptr) {
         kdatatype_allocator.deallocate((KDataType*)m_hostOutputBuffer1, 1);
         m_hostOutputBuffer1 = nullptr;
@@ -426,49 +463,20 @@ int MCAmerican::runInternal(OptionType optionType,
 
     unsigned int timeSteps = TIMESTEPS;
 
-    unsigned int calibrateSamples = 4096;
-
     m_runStartTime = std::chrono::high_resolution_clock::now();
 
     if (deviceIsPrepared()) {
-        // --------------------
-        // Run PRESAMPLE kernel
-        // --------------------
-        m_pPreSampleKernel->setArg(0, (KDataType)stockPrice);
-        m_pPreSampleKernel->setArg(1, (KDataType)volatility);
-        m_pPreSampleKernel->setArg(2, (KDataType)riskFreeRate);
-        m_pPreSampleKernel->setArg(3, (KDataType)dividendYield);
-        m_pPreSampleKernel->setArg(4, (KDataType)timeToMaturity);
-        m_pPreSampleKernel->setArg(5, (KDataType)strikePrice);
-        m_pPreSampleKernel->setArg(6, optionType);
-        m_pPreSampleKernel->setArg(7, *m_pHWOutputPriceBuffer);
-        m_pPreSampleKernel->setArg(8, *m_pHWOutputMatrixBuffer);
-        m_pPreSampleKernel->setArg(9, calibrateSamples);
-        m_pPreSampleKernel->setArg(10, timeSteps);
-
-        m_pCommandQueue->enqueueTask(*m_pPreSampleKernel, nullptr, nullptr);
-
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
-
-        // ----------------------
-        // Run CALIBRATION kernel
-        // ----------------------
-        m_pCalibrationKernel->setArg(0, (KDataType)timeToMaturity);
-        m_pCalibrationKernel->setArg(1, (KDataType)riskFreeRate);
-        m_pCalibrationKernel->setArg(2, (KDataType)strikePrice);
-        m_pCalibrationKernel->setArg(3, optionType);
-        m_pCalibrationKernel->setArg(4, *m_pHWOutputPriceBuffer);
-        m_pCalibrationKernel->setArg(5, *m_pHWOutputMatrixBuffer);
-        m_pCalibrationKernel->setArg(6, *m_pHWCoeffBuffer);
-        m_pCalibrationKernel->setArg(7, calibrateSamples);
-        m_pCalibrationKernel->setArg(8, timeSteps);
-
-        m_pCommandQueue->enqueueTask(*m_pCalibrationKernel, nullptr, nullptr);
-
-        m_pCommandQueue->flush();
-        m_pCommandQueue->finish();
+        // ----------------------------------------------------------------------
+        // Calibrate, unless the cached coefficients are close enough to be reused
+        // ----------------------------------------------------------------------
+        if (!coefficientsMatch(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                               timeToMaturity)) {
+            retval = calibrate(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                               timeToMaturity);
+        }
+    }
 
+    if (retval == XLNX_OK && deviceIsPrepared()) {
         // -------------------
         // Run PRICING kernels
         // -------------------
@@ -521,7 +529,7 @@ int MCAmerican::runInternal(OptionType optionType,
         // back to the caller
         // ----------------------------------------------------------------------------------------
         *pOptionPrice = (((KDataType*)m_hostOutputBuffer1)[0] + ((KDataType*)m_hostOutputBuffer2)[0]) / 2.0;
-    } else {
+    } else if (retval == XLNX_OK) {
         retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
     }
 
@@ -530,6 +538,181 @@ int MCAmerican::runInternal(OptionType optionType,
     return retval;
 }
 
+int MCAmerican::calibrate(OptionType optionType,
+                          double stockPrice,
+                          double strikePrice,
+                          double riskFreeRate,
+                          double dividendYield,
+                          double volatility,
+                          double timeToMaturity) {
+    int retval = XLNX_OK;
+    unsigned int timeSteps = TIMESTEPS;
+
+    if (deviceIsPrepared()) {
+        // --------------------
+        // Run PRESAMPLE kernel
+        // --------------------
+
+        m_pPreSampleKernel->setArg(0, (KDataType)stockPrice);
+        m_pPreSampleKernel->setArg(1, (KDataType)volatility);
+        m_pPreSampleKernel->setArg(2, (KDataType)riskFreeRate);
+        m_pPreSampleKernel->setArg(3, (KDataType)dividendYield);
+        m_pPreSampleKernel->setArg(4, (KDataType)timeToMaturity);
+        m_pPreSampleKernel->setArg(5, (KDataType)strikePrice);
+        m_pPreSampleKernel->setArg(6, optionType);
+        m_pPreSampleKernel->setArg(7, *m_pHWOutputPriceBuffer);
+        m_pPreSampleKernel->setArg(8, *m_pHWOutputMatrixBuffer);
+        m_pPreSampleKernel->setArg(9, m_calibrationSamples);
+        m_pPreSampleKernel->setArg(10, timeSteps);
+
+        m_pCommandQueue->enqueueTask(*m_pPreSampleKernel, nullptr, nullptr);
+
+        m_pCommandQueue->flush();
+        m_pCommandQueue->finish();
+
+        // ----------------------
+        // Run CALIBRATION kernel
+        // ----------------------
+        m_pCalibrationKernel->setArg(0, (KDataType)timeToMaturity);
+        m_pCalibrationKernel->setArg(1, (KDataType)riskFreeRate);
+        m_pCalibrationKernel->setArg(2, (KDataType)strikePrice);
+        m_pCalibrationKernel->setArg(3, optionType);
+        m_pCalibrationKernel->setArg(4, *m_pHWOutputPriceBuffer);
+        m_pCalibrationKernel->setArg(5, *m_pHWOutputMatrixBuffer);
+        m_pCalibrationKernel->setArg(6, *m_pHWFlowBuffer);
+        m_pCalibrationKernel->setArg(7, *m_pHWCoeffBuffer);
+        m_pCalibrationKernel->setArg(8, m_calibrationSamples);
+        m_pCalibrationKernel->setArg(9, timeSteps);
+
+        m_pCommandQueue->enqueueTask(*m_pCalibrationKernel, nullptr, nullptr);
+
+        m_pCommandQueue->flush();
+        m_pCommandQueue->finish();
+
+        setCalibrationPoint(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                            timeToMaturity);
+    } else {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    }
+
+    return retval;
+}
+
+int MCAmerican::getCoefficients(std::vector<double>& coefficients) {
+    int retval = XLNX_OK;
+    std::vector<cl::Memory> outputObjects;
+
+    if (!deviceIsPrepared()) {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    } else if (!m_bCoefficientsValid) {
+        retval = XLNX_ERROR_NOT_SUPPORTED;
+    } else {
+        outputObjects.push_back(*m_pHWCoeffBuffer);
+        m_pCommandQueue->enqueueMigrateMemObjects(outputObjects, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+        m_pCommandQueue->flush();
+        m_pCommandQueue->finish();
+
+        KDataType* pCoeff = (KDataType*)m_hostCoeffBuffer;
+        coefficients.assign(pCoeff, pCoeff + COEF * COEFF_NUM_ELEMENTS);
+    }
+
+    return retval;
+}
+
+int MCAmerican::setCoefficients(OptionType optionType,
+                                double stockPrice,
+                                double strikePrice,
+                                double riskFreeRate,
+                                double dividendYield,
+                                double volatility,
+                                double timeToMaturity,
+                                std::vector<double>& coefficients) {
+    int retval = XLNX_OK;
+    std::vector<cl::Memory> inputObjects;
+
+    if (!deviceIsPrepared()) {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    } else if (coefficients.size() != COEF * COEFF_NUM_ELEMENTS) {
+        retval = XLNX_ERROR_NOT_SUPPORTED;
+    } else {
+        KDataType* pCoeff = (KDataType*)m_hostCoeffBuffer;
+        for (unsigned int i = 0; i < coefficients.size(); i++) {
+            pCoeff[i] = (KDataType)coefficients[i];
+        }
+
+        inputObjects.push_back(*m_pHWCoeffBuffer);
+        m_pCommandQueue->enqueueMigrateMemObjects(inputObjects, 0, nullptr, nullptr);
+        m_pCommandQueue->flush();
+        m_pCommandQueue->finish();
+
+        setCalibrationPoint(optionType, stockPrice, strikePrice, riskFreeRate, dividendYield, volatility,
+                            timeToMaturity);
+    }
+
+    return retval;
+}
+
+void MCAmerican::setCoefficientReuseTolerance(double tolerance) {
+    m_coefficientReuseTolerance = tolerance;
+}
+
+int MCAmerican::setCalibrationSamples(unsigned int calibrationSamples) {
+    int retval = XLNX_OK;
+
+    // the calibration kernel consumes whole blocks of 1024 paths per unroll
+    if (calibrationSamples == 0 || calibrationSamples % (1024 * UN_K1) != 0 ||
+        calibrationSamples > CALIB_SAMPLES_MAX) {
+        retval = XLNX_ERROR_NOT_SUPPORTED;
+    } else if (calibrationSamples != m_calibrationSamples) {
+        m_calibrationSamples = calibrationSamples;
+        m_bCoefficientsValid = false;
+    }
+
+    return retval;
+}
+
+bool MCAmerican::coefficientsMatch(OptionType optionType,
+                                   double stockPrice,
+                                   double strikePrice,
+                                   double riskFreeRate,
+                                   double dividendYield,
+                                   double volatility,
+                                   double timeToMaturity) {
+    double tol = m_coefficientReuseTolerance;
+
+    if (!m_bCoefficientsValid || tol < 0.0) {
+        return false;
+    }
+
+    // the exercise boundary is a function of the contract, so those must be identical
+    if (optionType != m_calibOptionType || strikePrice != m_calibStrikePrice ||
+        timeToMaturity != m_calibTimeToMaturity) {
+        return false;
+    }
+
+    return std::fabs(stockPrice - m_calibStockPrice) <= tol * std::fabs(m_calibStockPrice) &&
+           std::fabs(riskFreeRate - m_calibRiskFreeRate) <= tol * std::fabs(m_calibRiskFreeRate) &&
+           std::fabs(dividendYield - m_calibDividendYield) <= tol * std::fabs(m_calibDividendYield) &&
+           std::fabs(volatility - m_calibVolatility) <= tol * std::fabs(m_calibVolatility);
+}
+
+void MCAmerican::setCalibrationPoint(OptionType optionType,
+                                     double stockPrice,
+                                     double strikePrice,
+                                     double riskFreeRate,
+                                     double dividendYield,
+                                     double volatility,
+                                     double timeToMaturity) {
+    m_calibOptionType = optionType;
+    m_calibStockPrice = stockPrice;
+    m_calibStrikePrice = strikePrice;
+    m_calibRiskFreeRate = riskFreeRate;
+    m_calibDividendYield = dividendYield;
+    m_calibVolatility = volatility;
+    m_calibTimeToMaturity = timeToMaturity;
+    m_bCoefficientsValid = true;
+}
+
 long long int MCAmerican::getLastRunTime(void) {
     long long int duration = 0;
 
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_FINTECH_MC_EUROPEAN_BATCH_KERNEL_CONSTANTS_H_
+#define _XF_FINTECH_MC_EUROPEAN_BATCH_KERNEL_CONSTANTS_H_
+
+// MC European Batch
+typedef float KDataType;
+// must match MAX_OPTIONS the kernel has been built with
+#define MAX_OPTIONS (1024)
+// must match MAX_STEPS the kernel has been built with
+#define MAX_STEPS (64)
+
+#endif //_XF_FINTECH_MC_EUROPEAN_BATCH_KERNEL_CONSTANTS_H_
@@ -0,0 +1,390 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <limits.h>
+
+#include "xf_fintech_error_codes.hpp"
+#include "xf_fintech_trace.hpp"
+
+#include "models/xf_fintech_mc_european_batch.hpp"
+
+#include "xf_fintech_mc_european_batch_kernel_constants.hpp"
+
+using namespace xf::fintech;
+
+const char* MC_EURO_BATCH_KERNEL_NAME = "mc_euro_batch_k";
+
+typedef struct _XCLBINLookupElement {
+    Device::DeviceType deviceType;
+    std::string xclbinName;
+} XCLBINLookupElement;
+
+static XCLBINLookupElement XCLBIN_LOOKUP_TABLE[] = {{Device::DeviceType::U50, "mc_euro_batch_k.xclbin"},
+                                                    {Device::DeviceType::U200, "mc_euro_batch_k.xclbin"},
+                                                    {Device::DeviceType::U250, "mc_euro_batch_k.xclbin"},
+                                                    {Device::DeviceType::U280, "mc_euro_batch_k.xclbin"}};
+
+static const unsigned int NUM_XCLBIN_LOOKUP_TABLE_ENTRIES =
+    sizeof(XCLBIN_LOOKUP_TABLE) / sizeof(XCLBIN_LOOKUP_TABLE[0]);
+
+MCEuropeanBatch::MCEuropeanBatch() {
+    m_pContext = nullptr;
+    m_pCommandQueue = nullptr;
+    m_pProgram = nullptr;
+    m_pKernel = nullptr;
+
+    m_hostStrike = nullptr;
+    m_hostTimeLength = nullptr;
+    m_hostOptionType = nullptr;
+    m_hostOutput = nullptr;
+    m_hostSeed = nullptr;
+
+    m_pStrikeBuf = nullptr;
+    m_pTimeLengthBuf = nullptr;
+    m_pOptionTypeBuf = nullptr;
+    m_pOutputBuf = nullptr;
+    m_pSeedBuf = nullptr;
+}
+
+MCEuropeanBatch::~MCEuropeanBatch() {
+    if (deviceIsPrepared()) {
+        releaseDevice();
+    }
+}
+
+std::string MCEuropeanBatch::getXCLBINName(Device* device) {
+    std::string xclbinName = "UNSUPPORTED_DEVICE";
+    Device::DeviceType deviceType;
+    unsigned int i;
+    XCLBINLookupElement* pElement;
+
+    deviceType = device->getDeviceType();
+
+    for (i = 0; i < NUM_XCLBIN_LOOKUP_TABLE_ENTRIES; i++) {
+        pElement = &XCLBIN_LOOKUP_TABLE[i];
+
+        if (pElement->deviceType == deviceType) {
+            xclbinName = pElement->xclbinName;
+            break; // out of loop
+        }
+    }
+
+    return xclbinName;
+}
+
+int MCEuropeanBatch::createOCLObjects(Device* device) {
+    int retval = XLNX_OK;
+    cl_int cl_retval = CL_SUCCESS;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    std::chrono::time_point<std::chrono::high_resolution_clock> end;
+    aligned_allocator<KDataType> allocator;
+    aligned_allocator<unsigned int> allocator_uint;
+    std::string xclbinName;
+    cl_mem_ext_ptr_t hwBufferOptions;
+
+    cl::Device clDevice;
+
+    clDevice = device->getCLDevice();
+
+    m_pContext = new cl::Context(clDevice, nullptr, nullptr, nullptr, &cl_retval);
+
+    ///////////////////////////////
+    // Create COMMAND QUEUE Object
+    ///////////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pCommandQueue = new cl::CommandQueue(*m_pContext, clDevice, CL_QUEUE_PROFILING_ENABLE, &cl_retval);
+    }
+
+    /////////////////
+    // Import XCLBIN
+    /////////////////
+    if (cl_retval == CL_SUCCESS) {
+        start = std::chrono::high_resolution_clock::now();
+
+        xclbinName = getXCLBINName(device);
+
+        m_binaries.clear();
+        m_binaries = xcl::import_binary_file(xclbinName);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Binary Import Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create PROGRAM Object
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        std::vector<cl::Device> devicesToProgram;
+        devicesToProgram.push_back(clDevice);
+
+        start = std::chrono::high_resolution_clock::now();
+
+        m_pProgram = new cl::Program(*m_pContext, devicesToProgram, m_binaries, nullptr, &cl_retval);
+
+        end = std::chrono::high_resolution_clock::now();
+
+        Trace::printInfo("[XLNX] Device Programming Time = %lld microseconds\n",
+                         std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    }
+
+    /////////////////////////
+    // Create KERNEL Objects
+    /////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_pKernel = new cl::Kernel(*m_pProgram, MC_EURO_BATCH_KERNEL_NAME, &cl_retval);
+    }
+
+    //////////////////////////
+    // Allocate HOST BUFFERS
+    //////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        m_hostStrike = allocator.allocate(MAX_OPTIONS);
+        m_hostTimeLength = allocator.allocate(MAX_OPTIONS);
+        m_hostOptionType = allocator_uint.allocate(MAX_OPTIONS);
+        m_hostOutput = allocator.allocate(MAX_OPTIONS);
+        m_hostSeed = allocator_uint.allocate(2);
+
+        if (m_hostStrike == nullptr || m_hostTimeLength == nullptr || m_hostOptionType == nullptr ||
+            m_hostOutput == nullptr || m_hostSeed == nullptr) {
+            cl_retval = CL_OUT_OF_HOST_MEMORY;
+        }
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        m_hostSeed[0] = 1;
+        m_hostSeed[1] = 10001;
+    }
+
+    ////////////////////////////////
+    // Allocate HW BUFFER Objects
+    ////////////////////////////////
+    if (cl_retval == CL_SUCCESS) {
+        hwBufferOptions = {XCL_MEM_DDR_BANK0, m_hostStrike, 0};
+        m_pStrikeBuf = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                      (size_t)(MAX_OPTIONS * sizeof(KDataType)), &hwBufferOptions, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        hwBufferOptions = {XCL_MEM_DDR_BANK0, m_hostTimeLength, 0};
+        m_pTimeLengthBuf = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                          (size_t)(MAX_OPTIONS * sizeof(KDataType)), &hwBufferOptions, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        hwBufferOptions = {XCL_MEM_DDR_BANK0, m_hostOptionType, 0};
+        m_pOptionTypeBuf = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                          (size_t)(MAX_OPTIONS * sizeof(unsigned int)), &hwBufferOptions, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        hwBufferOptions = {XCL_MEM_DDR_BANK0, m_hostOutput, 0};
+        m_pOutputBuf = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY,
+                                      (size_t)(MAX_OPTIONS * sizeof(KDataType)), &hwBufferOptions, &cl_retval);
+    }
+
+    if (cl_retval == CL_SUCCESS) {
+        hwBufferOptions = {XCL_MEM_DDR_BANK0, m_hostSeed, 0};
+        m_pSeedBuf = new cl::Buffer(*m_pContext, CL_MEM_EXT_PTR_XILINX | CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY,
+                                    (size_t)(2 * sizeof(unsigned int)), &hwBufferOptions, &cl_retval);
+    }
+
+    if (cl_retval != CL_SUCCESS) {
+        setCLError(cl_retval);
+        Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
+        retval = XLNX_ERROR_OPENCL_CALL_ERROR;
+    }
+
+    return retval;
+}
+
+int MCEuropeanBatch::releaseOCLObjects(void) {
+    int retval = XLNX_OK;
+    unsigned int i;
+    aligned_allocator<KDataType> allocator;
+    aligned_allocator<unsigned int> allocator_uint;
+
+    if (m_pStrikeBuf != nullptr) {
+        delete (m_pStrikeBuf);
+        m_pStrikeBuf = nullptr;
+    }
+
+    if (m_pTimeLengthBuf != nullptr) {
+        delete (m_pTimeLengthBuf);
+        m_pTimeLengthBuf = nullptr;
+    }
+
+    if (m_pOptionTypeBuf != nullptr) {
+        delete (m_pOptionTypeBuf);
+        m_pOptionTypeBuf = nullptr;
+    }
+
+    if (m_pOutputBuf != nullptr) {
+        delete (m_pOutputBuf);
+        m_pOutputBuf = nullptr;
+    }
+
+    if (m_pSeedBuf != nullptr) {
+        delete (m_pSeedBuf);
+        m_pSeedBuf = nullptr;
+    }
+
+    if (m_hostStrike != nullptr) {
+        allocator.deallocate((KDataType*)(m_hostStrike), MAX_OPTIONS);
+        m_hostStrike = nullptr;
+    }
+
+    if (m_hostTimeLength != nullptr) {
+        allocator.deallocate((KDataType*)(m_hostTimeLength), MAX_OPTIONS);
+        m_hostTimeLength = nullptr;
+    }
+
+    if (m_hostOptionType != nullptr) {
+        allocator_uint.deallocate(m_hostOptionType, MAX_OPTIONS);
+        m_hostOptionType = nullptr;
+    }
+
+    if (m_hostOutput != nullptr) {
+        allocator.deallocate((KDataType*)(m_hostOutput), MAX_OPTIONS);
+        m_hostOutput = nullptr;
+    }
+
+    if (m_hostSeed != nullptr) {
+        allocator_uint.deallocate(m_hostSeed, 2);
+        m_hostSeed = nullptr;
+    }
+
+    if (m_pKernel != nullptr) {
+        delete (m_pKernel);
+        m_pKernel = nullptr;
+    }
+
+    if (m_pProgram != nullptr) {
+        delete (m_pProgram);
+        m_pProgram = nullptr;
+    }
+
+    for (i = 0; i < m_binaries.size(); i++) {
+        std::pair<const void*, cl::size_type> binaryPair = m_binaries[i];
+        delete[](char*)(binaryPair.first);
+    }
+
+    if (m_pCommandQueue != nullptr) {
+        delete (m_pCommandQueue);
+        m_pCommandQueue = nullptr;
+    }
+
+    if (m_pContext != nullptr) {
+        delete (m_pContext);
+        m_pContext = nullptr;
+    }
+
+    return retval;
+}
+
+int MCEuropeanBatch::run(OptionType* optionType,
+                         double stockPrice,
+                         double* strikePrice,
+                         double riskFreeRate,
+                         double dividendYield,
+                         double volatility,
+                         double* timeToMaturity,
+                         unsigned int requiredSamples,
+                         unsigned int timeSteps,
+                         double* outputOptionPrice,
+                         unsigned int numOptions) {
+    int retval = XLNX_OK;
+    unsigned int i, j;
+    unsigned int optNum;
+    KDataType* pStrike = (KDataType*)m_hostStrike;
+    KDataType* pTimeLength = (KDataType*)m_hostTimeLength;
+    KDataType* pOutput = (KDataType*)m_hostOutput;
+    std::vector<cl::Memory> inVector;
+    std::vector<cl::Memory> outVector;
+
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
+    // the kernel records at most MAX_STEPS steps of each path
+    if (numOptions == 0 || timeSteps < 1 || timeSteps > MAX_STEPS) {
+        retval = XLNX_ERROR_NOT_SUPPORTED;
+    } else if (deviceIsPrepared()) {
+        inVector.push_back(*m_pStrikeBuf);
+        inVector.push_back(*m_pTimeLengthBuf);
+        inVector.push_back(*m_pOptionTypeBuf);
+        inVector.push_back(*m_pSeedBuf);
+        outVector.push_back(*m_pOutputBuf);
+
+        // We will process the batch in MAX_OPTIONS sized chunks, all options of a
+        // chunk are priced from the same set of paths...
+        for (i = 0; i < numOptions; i += MAX_OPTIONS) {
+            optNum = numOptions - i;
+
+            if (optNum > MAX_OPTIONS) {
+                optNum = MAX_OPTIONS;
+            }
+
+            for (j = 0; j < optNum; j++) {
+                pStrike[j] = (KDataType)strikePrice[i + j];
+                pTimeLength[j] = (KDataType)timeToMaturity[i + j];
+                m_hostOptionType[j] = (unsigned int)optionType[i + j];
+            }
+
+            m_pKernel->setArg(0, (KDataType)stockPrice);
+            m_pKernel->setArg(1, (KDataType)volatility);
+            m_pKernel->setArg(2, (KDataType)dividendYield);
+            m_pKernel->setArg(3, (KDataType)riskFreeRate);
+            m_pKernel->setArg(4, optNum);
+            m_pKernel->setArg(5, *m_pStrikeBuf);
+            m_pKernel->setArg(6, *m_pTimeLengthBuf);
+            m_pKernel->setArg(7, *m_pOptionTypeBuf);
+            m_pKernel->setArg(8, *m_pSeedBuf);
+            m_pKernel->setArg(9, *m_pOutputBuf);
+            m_pKernel->setArg(10, requiredSamples);
+            m_pKernel->setArg(11, timeSteps);
+
+            // the queue is in-order, so the transfers and the kernel run back to
+            // back without intermediate host synchronisation
+            m_pCommandQueue->enqueueMigrateMemObjects(inVector, 0, nullptr, nullptr);
+            m_pCommandQueue->enqueueTask(*m_pKernel, nullptr, nullptr);
+            m_pCommandQueue->enqueueMigrateMemObjects(outVector, CL_MIGRATE_MEM_OBJECT_HOST, nullptr, nullptr);
+
+            m_pCommandQueue->flush();
+            m_pCommandQueue->finish();
+
+            for (j = 0; j < optNum; j++) {
+                outputOptionPrice[i + j] = (double)pOutput[j];
+            }
+        }
+
+    } else {
+        retval = XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    }
+
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
+    return retval;
+}
+
+long long int MCEuropeanBatch::getLastRunTime(void) {
+    long long int duration = 0;
+
+    duration =
+        (long long int)std::chrono::duration_cast<std::chrono::microseconds>(m_runEndTime - m_runStartTime).count();
+
+    return duration;
+}
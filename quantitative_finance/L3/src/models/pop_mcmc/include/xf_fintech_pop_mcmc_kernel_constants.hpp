@@ -19,4 +19,14 @@
 
 #define KERNEL_DT double
 
+// Multi-dimensional kernel, copied from mcmc_md_kernel.hpp of L2/tests/PopMCMC
+// which the xclbin is built with. MD_STATE_SIZE is McmcMultiDimState<MD_NCHAINS, MD_NDIM_MAX>::SIZE.
+#define MD_NCHAINS 10
+#define MD_NDIM_MAX 64
+#define MD_NSAMPLES_MAX 1024
+#define MD_NPARAMS_MAX (MD_NDIM_MAX + MD_NDIM_MAX * MD_NDIM_MAX)
+#define MD_STATE_SIZE (MD_NCHAINS * MD_NDIM_MAX + MD_NDIM_MAX + MD_NDIM_MAX * MD_NDIM_MAX + 1 + MD_NCHAINS)
+#define MD_ADAPT_INTERVAL 100
+#define MD_SEED 42
+
 #endif //_XF_FINTECH_POP_MCMC_KERNEL_CONSTANTS_H_
@@ -20,6 +20,8 @@
 #include "models/xf_fintech_pop_mcmc.hpp"
 #include "xf_fintech_pop_mcmc_kernel_constants.hpp"
 
+#include <algorithm>
+
 using namespace xf::fintech;
 
 PopMCMC::PopMCMC() {
@@ -27,14 +29,23 @@ PopMCMC::PopMCMC() {
     m_pCommandQueue = nullptr;
     m_pProgram = nullptr;
     m_pPopMCMCKernel = nullptr;
+    m_pPopMCMCMultiDimKernel = nullptr;
 
     m_hostInputBufferInv.clear();
     m_hostInputBufferSigma.clear();
     m_hostOutputBufferSamples.clear();
+    m_hostInputBufferParams.clear();
+    m_hostBufferState.clear();
+    m_hostOutputBufferBlock[0].clear();
+    m_hostOutputBufferBlock[1].clear();
 
     mBufferInputInv = nullptr;
     mBufferInputSigma = nullptr;
     mBufferOutputSamples = nullptr;
+    mBufferInputParams = nullptr;
+    mBufferState = nullptr;
+    mBufferOutputBlock[0] = nullptr;
+    mBufferOutputBlock[1] = nullptr;
 }
 
 PopMCMC::~PopMCMC() {
@@ -98,12 +109,29 @@ int PopMCMC::createOCLObjects(Device* device) {
         m_pPopMCMCKernel = new cl::Kernel(*m_pProgram, "mcmc_kernel", &cl_retval);
     }
 
+    // The multi-dimensional kernel is optional, runMultiDim() is not supported without it
+    if (cl_retval == CL_SUCCESS) {
+        cl_int cl_md_retval = CL_SUCCESS;
+        m_pPopMCMCMultiDimKernel = new cl::Kernel(*m_pProgram, "mcmc_md_kernel", &cl_md_retval);
+        if (cl_md_retval != CL_SUCCESS) {
+            delete (m_pPopMCMCMultiDimKernel);
+            m_pPopMCMCMultiDimKernel = nullptr;
+            Trace::printInfo("[XLNX] Multi-dimensional kernel not found in the xclbin\n");
+        }
+    }
+
     //////////////////////////
     // Allocate HOST BUFFERS
     //////////////////////////
     m_hostInputBufferInv.resize(NUM_CHAINS);
     m_hostInputBufferSigma.resize(NUM_CHAINS);
     m_hostOutputBufferSamples.resize(NUM_SAMPLES_MAX);
+    if (m_pPopMCMCMultiDimKernel != nullptr) {
+        m_hostInputBufferParams.resize(MD_NPARAMS_MAX);
+        m_hostBufferState.resize(MD_STATE_SIZE);
+        m_hostOutputBufferBlock[0].resize(MD_NSAMPLES_MAX * MD_NDIM_MAX);
+        m_hostOutputBufferBlock[1].resize(MD_NSAMPLES_MAX * MD_NDIM_MAX);
+    }
 
     //////////////////////////
     // Allocate HOST BUFFERS
@@ -128,6 +156,21 @@ int PopMCMC::createOCLObjects(Device* device) {
                                               sizeBufferOutputSamples, m_hostOutputBufferSamples.data(), &cl_retval);
     }
 
+    if (cl_retval == CL_SUCCESS && m_pPopMCMCMultiDimKernel != nullptr) {
+        mBufferInputParams = new cl::Buffer(*m_pContext, (CL_MEM_USE_HOST_PTR | CL_MEM_READ_ONLY),
+                                            sizeof(double) * MD_NPARAMS_MAX, m_hostInputBufferParams.data(),
+                                            &cl_retval);
+        if (cl_retval == CL_SUCCESS) {
+            mBufferState = new cl::Buffer(*m_pContext, (CL_MEM_USE_HOST_PTR | CL_MEM_READ_WRITE),
+                                          sizeof(double) * MD_STATE_SIZE, m_hostBufferState.data(), &cl_retval);
+        }
+        for (int i = 0; i < 2 && cl_retval == CL_SUCCESS; i++) {
+            mBufferOutputBlock[i] = new cl::Buffer(*m_pContext, (CL_MEM_USE_HOST_PTR | CL_MEM_WRITE_ONLY),
+                                                   sizeof(double) * MD_NSAMPLES_MAX * MD_NDIM_MAX,
+                                                   m_hostOutputBufferBlock[i].data(), &cl_retval);
+        }
+    }
+
     if (cl_retval != CL_SUCCESS) {
         setCLError(cl_retval);
         Trace::printError("[XLNX] OpenCL Error = %d\n", cl_retval);
@@ -155,11 +198,33 @@ int PopMCMC::releaseOCLObjects(void) {
         mBufferOutputSamples = nullptr;
     }
 
+    if (mBufferInputParams != nullptr) {
+        delete (mBufferInputParams);
+        mBufferInputParams = nullptr;
+    }
+
+    if (mBufferState != nullptr) {
+        delete (mBufferState);
+        mBufferState = nullptr;
+    }
+
+    for (i = 0; i < 2; i++) {
+        if (mBufferOutputBlock[i] != nullptr) {
+            delete (mBufferOutputBlock[i]);
+            mBufferOutputBlock[i] = nullptr;
+        }
+    }
+
     if (m_pPopMCMCKernel != nullptr) {
         delete (m_pPopMCMCKernel);
         m_pPopMCMCKernel = nullptr;
     }
 
+    if (m_pPopMCMCMultiDimKernel != nullptr) {
+        delete (m_pPopMCMCMultiDimKernel);
+        m_pPopMCMCMultiDimKernel = nullptr;
+    }
+
     if (m_pProgram != nullptr) {
         delete (m_pProgram);
         m_pProgram = nullptr;
@@ -231,6 +296,101 @@ int PopMCMC::run(int numSamples, int numBurnInSamples, double sigma, double* out
     return retval;
 }
 
+int PopMCMC::runMultiDim(int numDims,
+                         std::vector<double>& targetParameters,
+                         double* initialPoint,
+                         int numSamples,
+                         int numBurnInSamples,
+                         double sigma,
+                         SampleCallback callback) {
+    int retval = XLNX_OK;
+
+    if (!deviceIsPrepared()) {
+        return XLNX_ERROR_DEVICE_NOT_OWNED_BY_SPECIFIED_OCL_CONTROLLER;
+    }
+
+    if (m_pPopMCMCMultiDimKernel == nullptr || numDims < 1 || numDims > MD_NDIM_MAX ||
+        targetParameters.size() != (size_t)(numDims + numDims * numDims) || numBurnInSamples < 0 ||
+        numSamples <= numBurnInSamples) {
+        return XLNX_ERROR_NOT_SUPPORTED;
+    }
+
+    // start time
+    m_runStartTime = std::chrono::high_resolution_clock::now();
+
+    // prepare the data, all chains start from the initial point with no adaptation history
+    for (unsigned int n = 0; n < NUM_CHAINS; n++) {
+        double temp = pow((double)NUM_CHAINS / (NUM_CHAINS - n), 2);
+        m_hostInputBufferInv[n] = 1 / temp;
+    }
+    std::fill(m_hostInputBufferParams.begin(), m_hostInputBufferParams.end(), 0.0);
+    std::copy(targetParameters.begin(), targetParameters.end(), m_hostInputBufferParams.begin());
+    std::fill(m_hostBufferState.begin(), m_hostBufferState.end(), 0.0);
+    for (unsigned int n = 0; n < NUM_CHAINS; n++) {
+        std::copy(initialPoint, initialPoint + numDims, m_hostBufferState.begin() + n * MD_NDIM_MAX);
+    }
+
+    m_pCommandQueue->enqueueMigrateMemObjects({*mBufferInputInv, *mBufferInputParams, *mBufferState}, 0);
+
+    // The state of the chains stays in global memory between blocks. While the host consumes one block of samples
+    // the kernel generates the next one into the other output buffer.
+    const int numBlocks = (numSamples + MD_NSAMPLES_MAX - 1) / MD_NSAMPLES_MAX;
+    cl::Event blockReady[2];
+    auto enqueueBlock = [&](int block) {
+        int samples = std::min(MD_NSAMPLES_MAX, numSamples - block * MD_NSAMPLES_MAX);
+        m_pPopMCMCMultiDimKernel->setArg(0, *mBufferInputInv);
+        m_pPopMCMCMultiDimKernel->setArg(1, *mBufferInputParams);
+        m_pPopMCMCMultiDimKernel->setArg(2, *mBufferState);
+        m_pPopMCMCMultiDimKernel->setArg(3, *mBufferOutputBlock[block % 2]);
+        m_pPopMCMCMultiDimKernel->setArg(4, (unsigned int)numDims);
+        m_pPopMCMCMultiDimKernel->setArg(5, (unsigned int)samples);
+        m_pPopMCMCMultiDimKernel->setArg(6, sigma);
+        m_pPopMCMCMultiDimKernel->setArg(7, (unsigned int)MD_ADAPT_INTERVAL);
+        m_pPopMCMCMultiDimKernel->setArg(8, (unsigned int)(MD_SEED + block));
+        m_pCommandQueue->enqueueTask(*m_pPopMCMCMultiDimKernel);
+        m_pCommandQueue->enqueueMigrateMemObjects({*mBufferOutputBlock[block % 2]}, CL_MIGRATE_MEM_OBJECT_HOST,
+                                                  nullptr, &blockReady[block % 2]);
+    };
+
+    enqueueBlock(0);
+    if (numBlocks > 1) {
+        enqueueBlock(1);
+    }
+
+    for (int block = 0; block < numBlocks && retval == XLNX_OK; block++) {
+        blockReady[block % 2].wait();
+
+        // --------------------------------
+        // Give the caller back the results
+        // --------------------------------
+        int first = block * MD_NSAMPLES_MAX;
+        int last = std::min(first + MD_NSAMPLES_MAX, numSamples);
+        int skip = std::max(0, std::min(numBurnInSamples, last) - first);
+        if (last - first > skip) {
+            retval = callback(m_hostOutputBufferBlock[block % 2].data() + skip * numDims, last - first - skip);
+        }
+
+        // the buffer is free again once the caller is done with it
+        if (retval == XLNX_OK && block + 2 < numBlocks) {
+            enqueueBlock(block + 2);
+        }
+    }
+    m_pCommandQueue->finish();
+
+    // end time
+    m_runEndTime = std::chrono::high_resolution_clock::now();
+
+    return retval;
+}
+
+int PopMCMC::getMaxDims(void) {
+    return MD_NDIM_MAX;
+}
+
+int PopMCMC::getBlockSize(void) {
+    return MD_NSAMPLES_MAX;
+}
+
 long long int PopMCMC::getLastRunTime(void) {
     long long int duration = 0;
 
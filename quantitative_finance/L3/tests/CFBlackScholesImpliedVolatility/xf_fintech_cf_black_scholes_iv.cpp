@@ -0,0 +1,103 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+static const unsigned int numQuotes = 1000000;
+
+CFBlackScholesImpliedVolatility cfBlackScholesIV(numQuotes);
+
+/// @brief Reference Black-Scholes put premium with q=0
+static double bsPut(double s, double v, double r, double t, double k) {
+    double d1 = (std::log(s / k) + (r + v * v / 2.0) * t) / (v * std::sqrt(t));
+    double d2 = d1 - v * std::sqrt(t);
+    return k * std::exp(-r * t) * 0.5 * std::erfc(d2 / std::sqrt(2.0)) - s * 0.5 * std::erfc(d1 / std::sqrt(2.0));
+}
+
+int main() {
+    int retval = XLNX_OK;
+
+    std::vector<Device*> deviceList;
+    Device* pChosenDevice;
+    std::vector<float> volatility(numQuotes);
+
+    // Get a list of U250s available on the system (just because our current
+    // bitstreams are built for U250s)
+    deviceList = DeviceManager::getDeviceList("u250");
+
+    if (deviceList.size() == 0) {
+        printf("[XLNX] No matching devices found\n");
+        exit(0);
+    }
+
+    printf("[XLNX] Found %zu matching devices\n", deviceList.size());
+
+    // we'll just pick the first device in the...
+    pChosenDevice = deviceList[0];
+
+    retval = cfBlackScholesIV.claimDevice(pChosenDevice);
+
+    if (retval == XLNX_OK) {
+        // Populate the quote data from a volatility smile across strikes...
+        for (unsigned int i = 0; i < numQuotes; i++) {
+            float strike = 80.0f + 40.0f * (float)(i % 1000) / 1000.0f;
+            volatility[i] = 0.2f + 0.1f * std::fabs(strike - 100.0f) / 20.0f;
+
+            cfBlackScholesIV.stockPrice[i] = 100.0f;
+            cfBlackScholesIV.strikePrice[i] = strike;
+            cfBlackScholesIV.riskFreeRate[i] = 0.025f;
+            cfBlackScholesIV.timeToMaturity[i] = 1.0f;
+            cfBlackScholesIV.optionPrice[i] = bsPut(100.0, volatility[i], 0.025, 1.0, strike);
+        }
+
+        ///////////////////
+        // Run the model...
+        ///////////////////
+        retval = cfBlackScholesIV.run(OptionType::Put, numQuotes);
+
+        printf("[XLNX] +-------+----------+----------+----------+\n");
+        printf("[XLNX] | Index |  Strike  |  Premia  |    IV    |\n");
+        printf("[XLNX] +-------+----------+----------+----------+\n");
+
+        float maxDiff = 0.0f;
+        for (unsigned int i = 0; i < numQuotes; i++) {
+            float diff = std::fabs(cfBlackScholesIV.impliedVolatility[i] - volatility[i]);
+            maxDiff = (diff > maxDiff) ? diff : maxDiff;
+            if (i % 100 == 0 && i < 1000) {
+                printf("[XLNX] | %5u | %8.5f | %8.5f | %8.5f |\n", i, cfBlackScholesIV.strikePrice[i],
+                       cfBlackScholesIV.optionPrice[i], cfBlackScholesIV.impliedVolatility[i]);
+            }
+        }
+
+        printf("[XLNX] +-------+----------+----------+----------+\n");
+        printf("[XLNX] Largest volatility difference = %g\n", maxDiff);
+        printf("[XLNX] Processed %u quotes in %lld us\n", numQuotes, cfBlackScholesIV.getLastRunTime());
+    }
+
+    cfBlackScholesIV.releaseDevice();
+
+    return retval;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include <stdio.h>
+
+#include <vector>
+
+#include "xf_fintech_api.hpp"
+#include "xf_fintech_calibration.hpp"
+
+using namespace xf::fintech;
+
+// Heston parameters, in the order used by the calibrator
+enum { V0 = 0, KAPPA, THETA, SIGMA, RHO, NUM_PARAMS };
+
+// the hcf kernel prices at most this many options per run
+static const unsigned int maxOptionsPerRun = 1024;
+
+static const double stockPrice = 100.0;
+static const double riskFreeRate = 0.02;
+
+int main() {
+    int retval = XLNX_OK;
+
+    hcf hcf;
+    std::vector<Device*> deviceList;
+
+    // Get a list of U250s available on the system (just because our current
+    // bitstreams are built for U250s)
+    deviceList = DeviceManager::getDeviceList("u250");
+
+    if (deviceList.size() == 0) {
+        printf("[XLNX] No matching devices found\n");
+        exit(0);
+    }
+
+    retval = hcf.claimDevice(deviceList[0]);
+
+    // the instrument set, calls on a grid of strikes and maturities
+    std::vector<double> strikes;
+    std::vector<double> maturities;
+    for (double T : {0.25, 0.5, 1.0, 2.0}) {
+        for (double K : {80.0, 90.0, 100.0, 110.0, 120.0}) {
+            strikes.push_back(K);
+            maturities.push_back(T);
+        }
+    }
+    unsigned int numInstruments = strikes.size();
+
+    // prices the instrument set for every parameter set in as few runs as the kernel allows
+    Calibrator<NUM_PARAMS>::BatchPricer pricer = [&](std::vector<std::vector<double> >& parameterSets,
+                                                     std::vector<double>& prices) {
+        int ret = XLNX_OK;
+        std::vector<struct hcf::hcf_input_data> inputData;
+        for (unsigned int s = 0; s < parameterSets.size(); s++) {
+            for (unsigned int k = 0; k < numInstruments; k++) {
+                struct hcf::hcf_input_data data;
+                data.s0 = stockPrice;
+                data.v0 = parameterSets[s][V0];
+                data.K = strikes[k];
+                data.rho = parameterSets[s][RHO];
+                data.T = maturities[k];
+                data.r = riskFreeRate;
+                data.kappa = parameterSets[s][KAPPA];
+                data.vvol = parameterSets[s][SIGMA];
+                data.vbar = parameterSets[s][THETA];
+                inputData.push_back(data);
+            }
+        }
+
+        std::vector<float> outputData(inputData.size());
+        for (unsigned int i = 0; ret == XLNX_OK && i < inputData.size(); i += maxOptionsPerRun) {
+            unsigned int n = (inputData.size() - i < maxOptionsPerRun) ? inputData.size() - i : maxOptionsPerRun;
+            ret = hcf.run(&inputData[i], &outputData[i], n);
+        }
+
+        prices.assign(outputData.begin(), outputData.end());
+        return ret;
+    };
+
+    std::vector<double> marketPrices;
+    double trueParameters[NUM_PARAMS] = {0.04, 1.5, 0.05, 0.4, -0.6};
+
+    if (retval == XLNX_OK) {
+        // synthetic market, priced with known parameters
+        std::vector<std::vector<double> > parameterSets(
+            1, std::vector<double>(trueParameters, trueParameters + NUM_PARAMS));
+        retval = pricer(parameterSets, marketPrices);
+    }
+
+    if (retval == XLNX_OK) {
+        Calibrator<NUM_PARAMS> calibrator(pricer);
+
+        double lowerBound[NUM_PARAMS] = {1e-4, 1e-2, 1e-4, 1e-2, -0.99};
+        double upperBound[NUM_PARAMS] = {1.0, 10.0, 1.0, 2.0, 0.99};
+        calibrator.setBounds(lowerBound, upperBound);
+
+        // the kernel prices in single precision, so the bumps are larger than the default
+        calibrator.setBumpSize(1e-3);
+        calibrator.setTolerance(1e-6);
+
+        double parameters[NUM_PARAMS] = {0.09, 1.0, 0.09, 0.6, -0.3};
+
+        retval = calibrator.calibrate(marketPrices, parameters);
+
+        if (retval == XLNX_OK) {
+            printf("[XLNX] +-----------+----------+------------+\n");
+            printf("[XLNX] | Parameter |   True   | Calibrated |\n");
+            printf("[XLNX] +-----------+----------+------------+\n");
+            const char* names[NUM_PARAMS] = {"v0", "kappa", "theta", "sigma", "rho"};
+            for (unsigned int i = 0; i < NUM_PARAMS; i++) {
+                printf("[XLNX] | %9s | %8.5f | %10.5f |\n", names[i], trueParameters[i], parameters[i]);
+            }
+            printf("[XLNX] +-----------+----------+------------+\n");
+            printf("[XLNX] RMSE = %g, iterations = %u, pricer calls = %u, converged = %s\n", calibrator.getLastRMSE(),
+                   calibrator.getLastNumIterations(), calibrator.getLastNumPricerCalls(),
+                   calibrator.hasConverged() ? "yes" : "no");
+            printf("[XLNX] Duration = %lld microseconds\n", calibrator.getLastRunTime());
+        }
+    }
+
+    if (retval != XLNX_OK) {
+        printf("[XLNX] ERROR: calibration failed, error code %d\n", retval);
+    }
+
+    hcf.releaseDevice();
+
+    return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Host only test of the Levenberg-Marquardt calibrator. The batch pricer is the closed form Hull-White price of
+ * caplets on a flat curve, so the calibrated parameters can be checked against the ones that generated the market.
+ */
+
+#include <math.h>
+#include <stdio.h>
+
+#include <vector>
+
+#include "xf_fintech_calibration.hpp"
+
+using namespace xf::fintech;
+
+// Hull-White parameters, in the order used by the calibrator
+enum { A = 0, SIGMA, NUM_PARAMS };
+
+static const double flatRate = 0.03;
+static const double tenor = 0.5;
+
+static double normalCDF(double x) {
+    return 0.5 * erfc(-x / sqrt(2.0));
+}
+
+static double discount(double T) {
+    return exp(-flatRate * T);
+}
+
+// caplet on the rate from T to T + tenor, as (1 + K tenor) puts on the zero coupon bond with strike 1 / (1 + K tenor)
+static double hullWhiteCaplet(double a, double sigma, double T, double K) {
+    double S = T + tenor;
+    double X = 1.0 / (1.0 + K * tenor);
+    double B = (1.0 - exp(-a * tenor)) / a;
+    double sigmaP = sigma * B * sqrt((1.0 - exp(-2.0 * a * T)) / (2.0 * a));
+    double h = log(discount(S) / (discount(T) * X)) / sigmaP + sigmaP / 2.0;
+    double put = X * discount(T) * normalCDF(-h + sigmaP) - discount(S) * normalCDF(-h);
+    return (1.0 + K * tenor) * put;
+}
+
+struct Instruments {
+    std::vector<double> maturities;
+    std::vector<double> strikes;
+
+    Instruments() {
+        for (double T : {1.0, 2.0, 3.0, 5.0, 7.0, 10.0}) {
+            for (double K : {0.02, 0.03, 0.04}) {
+                maturities.push_back(T);
+                strikes.push_back(K);
+            }
+        }
+    }
+};
+
+static Instruments instruments;
+
+// parameter sets outside these bounds are counted when checkBounds is set
+static bool checkBounds = false;
+static double lowerBound[NUM_PARAMS];
+static double upperBound[NUM_PARAMS];
+static unsigned int numOutOfBounds = 0;
+static unsigned int numPricerCalls = 0;
+
+static int pricer(std::vector<std::vector<double> >& parameterSets, std::vector<double>& prices) {
+    numPricerCalls++;
+    prices.clear();
+    for (unsigned int s = 0; s < parameterSets.size(); s++) {
+        for (int i = 0; checkBounds && i < NUM_PARAMS; i++) {
+            if (parameterSets[s][i] < lowerBound[i] || parameterSets[s][i] > upperBound[i]) {
+                numOutOfBounds++;
+            }
+        }
+        for (unsigned int k = 0; k < instruments.maturities.size(); k++) {
+            prices.push_back(hullWhiteCaplet(parameterSets[s][A], parameterSets[s][SIGMA], instruments.maturities[k],
+                                             instruments.strikes[k]));
+        }
+    }
+    return XLNX_OK;
+}
+
+static int failures = 0;
+
+static void check(bool condition, const char* message) {
+    if (!condition) {
+        printf("[XLNX] FAILED: %s\n", message);
+        failures++;
+    }
+}
+
+int main() {
+    const double trueParameters[NUM_PARAMS] = {0.05, 0.01};
+    std::vector<double> marketPrices;
+    std::vector<std::vector<double> > trueSet(1, std::vector<double>(trueParameters, trueParameters + NUM_PARAMS));
+    pricer(trueSet, marketPrices);
+
+    // recovers the parameters of the market, with one pricer call per iteration
+    {
+        Calibrator<NUM_PARAMS> calibrator(pricer);
+        double parameters[NUM_PARAMS] = {0.2, 0.02};
+        numPricerCalls = 0;
+        int retval = calibrator.calibrate(marketPrices, parameters);
+        printf("[XLNX] a = %.8f, sigma = %.8f, RMSE = %g, iterations = %u, pricer calls = %u\n", parameters[A],
+               parameters[SIGMA], calibrator.getLastRMSE(), calibrator.getLastNumIterations(),
+               calibrator.getLastNumPricerCalls());
+        check(retval == XLNX_OK, "calibration returned an error");
+        check(calibrator.hasConverged(), "calibration did not converge");
+        check(fabs(parameters[A] - trueParameters[A]) < 1e-5, "a not recovered");
+        check(fabs(parameters[SIGMA] - trueParameters[SIGMA]) < 1e-7, "sigma not recovered");
+        check(calibrator.getLastNumPricerCalls() == numPricerCalls, "pricer calls miscounted");
+        check(numPricerCalls <= calibrator.getLastNumIterations() + 1, "more than one pricer call per iteration");
+    }
+
+    // the bounds of a are closer together than the bump, the bumps must stay within them
+    {
+        Calibrator<NUM_PARAMS> calibrator(pricer);
+        lowerBound[A] = 0.0501;
+        upperBound[A] = 0.0501 + 5e-5;
+        lowerBound[SIGMA] = 1e-3;
+        upperBound[SIGMA] = 0.1;
+        calibrator.setBounds(lowerBound, upperBound);
+        double parameters[NUM_PARAMS] = {upperBound[A], 0.02};
+        checkBounds = true;
+        numOutOfBounds = 0;
+        int retval = calibrator.calibrate(marketPrices, parameters);
+        checkBounds = false;
+        printf("[XLNX] bounded a = %.8f, sigma = %.8f, parameter sets out of bounds = %u\n", parameters[A],
+               parameters[SIGMA], numOutOfBounds);
+        check(retval == XLNX_OK, "bounded calibration returned an error");
+        check(numOutOfBounds == 0, "pricer called outside the bounds");
+        check(fabs(parameters[A] - lowerBound[A]) < 1e-6, "a not at its lower bound");
+    }
+
+    // a parameter fixed by equal bounds is left unchanged and the others are calibrated
+    {
+        Calibrator<NUM_PARAMS> calibrator(pricer);
+        double lower[NUM_PARAMS] = {trueParameters[A], 1e-3};
+        double upper[NUM_PARAMS] = {trueParameters[A], 0.1};
+        calibrator.setBounds(lower, upper);
+        double parameters[NUM_PARAMS] = {trueParameters[A], 0.03};
+        int retval = calibrator.calibrate(marketPrices, parameters);
+        printf("[XLNX] fixed a = %.8f, sigma = %.8f\n", parameters[A], parameters[SIGMA]);
+        check(retval == XLNX_OK, "calibration with a fixed parameter returned an error");
+        check(parameters[A] == trueParameters[A], "fixed parameter changed");
+        check(fabs(parameters[SIGMA] - trueParameters[SIGMA]) < 1e-7, "sigma not recovered with a fixed");
+    }
+
+    // weights must match the instruments
+    {
+        Calibrator<NUM_PARAMS> calibrator(pricer);
+        std::vector<double> weights(marketPrices.size() - 1, 1.0);
+        calibrator.setWeights(weights);
+        double parameters[NUM_PARAMS] = {0.2, 0.02};
+        check(calibrator.calibrate(marketPrices, parameters) == XLNX_ERROR_NOT_SUPPORTED, "weights not checked");
+    }
+
+    printf("[XLNX] %s\n", (failures == 0) ? "PASSED" : "FAILED");
+
+    return (failures == 0) ? 0 : 1;
+}
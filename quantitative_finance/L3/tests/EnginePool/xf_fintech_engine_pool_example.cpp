@@ -0,0 +1,98 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <stdio.h>
+
+#include <future>
+#include <vector>
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+static const unsigned int numRequests = 64;
+
+int main() {
+    int retval = XLNX_OK;
+
+    std::vector<Device*> deviceList;
+
+    // Get a list of U250s available on the system (just because our current
+    // bitstreams are built for U250s)
+    deviceList = DeviceManager::getDeviceList("u250");
+
+    if (deviceList.size() == 0) {
+        printf("[XLNX] No matching devices found\n");
+        exit(0);
+    }
+
+    printf("[XLNX] Found %zu matching devices\n", deviceList.size());
+
+    // one MCEuropean object per device, each claims its device until the pool
+    // is stopped
+    EnginePool<MCEuropean> pool;
+
+    retval = pool.start(deviceList);
+
+    if (retval == XLNX_OK) {
+        double strikePrice = 40.0;
+        double riskFreeRate = 0.06;
+        double dividendYield = 0.0;
+        double volatility = 0.20;
+        double timeToMaturity = 1.0;
+        double requiredTolerance = 0.02;
+
+        std::vector<double> stockPrice(numRequests);
+        std::vector<double> optionPrice(numRequests);
+        std::vector<std::future<EnginePool<MCEuropean>::Result> > results;
+
+        for (unsigned int i = 0; i < numRequests; i++) {
+            stockPrice[i] = 30.0 + 0.25 * i;
+        }
+
+        ///////////////////////////
+        // Submit the requests...
+        ///////////////////////////
+        for (unsigned int i = 0; i < numRequests; i++) {
+            results.push_back(pool.submit([&, i](MCEuropean& model) {
+                return model.run(Put, stockPrice[i], strikePrice, riskFreeRate, dividendYield, volatility,
+                                 timeToMaturity, requiredTolerance, &optionPrice[i]);
+            }));
+        }
+
+        printf("[XLNX] +-------+----------+----------+--------+-----------+-----------+\n");
+        printf("[XLNX] | Index |  Stock   |  Price   | Device | Queue(us) |  Run(us)  |\n");
+        printf("[XLNX] +-------+----------+----------+--------+-----------+-----------+\n");
+
+        for (unsigned int i = 0; i < numRequests; i++) {
+            EnginePool<MCEuropean>::Result result = results[i].get();
+            if (result.retval != XLNX_OK) {
+                printf("[XLNX] Request %u failed with %d\n", i, result.retval);
+                retval = result.retval;
+                continue;
+            }
+            printf("[XLNX] | %5u | %8.4f | %8.5f | %6u | %9lld | %9lld |\n", i, stockPrice[i], optionPrice[i],
+                   result.deviceIndex, result.queueTime, result.runTime);
+        }
+
+        printf("[XLNX] +-------+----------+----------+--------+-----------+-----------+\n");
+    }
+
+    pool.stop();
+
+    return retval;
+}
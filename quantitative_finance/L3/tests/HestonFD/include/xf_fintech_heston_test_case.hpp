@@ -28,6 +28,7 @@ class HestonFDTestCase {
    public:
     HestonFDTestCase(double delta) { m_delta = delta; };
     int Run(string testCase, string testScheme, std::vector<double> csvTableEntry);
+    int RunBatch(string testCase, std::vector<double> csvTableEntry);
 
    private:
     bool CompareValues(double val1, double val2);
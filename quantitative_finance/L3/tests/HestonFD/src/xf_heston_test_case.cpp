@@ -210,3 +210,75 @@ int HestonFDTestCase::Run(string testcase, string testscheme, std::vector<double
 
     return numberPriceGridMismatches;
 }
+
+int HestonFDTestCase::RunBatch(string testcase, std::vector<double> csvTableEntry) {
+    // Prices a batch of options with the strike of the test case and maturities up to T, most of them between two
+    // time steps of the batch, and compares each with a run of its own with a time step close to the batch one
+    const unsigned int numOptions = 5;
+    const double fractions[numOptions] = {0.25, 0.3137, 0.5, 0.6211, 1.0};
+
+    double kappa = csvTableEntry[0];
+    double eta = csvTableEntry[1];
+    double sigma = csvTableEntry[2];
+    double rho = csvTableEntry[3];
+    double rd = csvTableEntry[4];
+    double T = csvTableEntry[6];
+    double K = csvTableEntry[7];
+    double S = csvTableEntry[8];
+    double V = csvTableEntry[9];
+    int N = (int)csvTableEntry[11];
+    int m1 = (int)csvTableEntry[12] + 1;
+    int m2 = (int)csvTableEntry[13] + 1;
+
+    double strikes[numOptions];
+    double maturities[numOptions];
+    double batchPrices[numOptions];
+    int numberMismatches = 0;
+    unsigned int i;
+    int retval;
+
+    for (i = 0; i < numOptions; i++) {
+        strikes[i] = K;
+        maturities[i] = fractions[i] * T;
+    }
+
+    FDHeston fdHeston(m1, m2);
+
+    std::vector<Device*> deviceList = DeviceManager::getDeviceList();
+    if (deviceList.size() == 0) {
+        printf("No matching devices found\n");
+        exit(0);
+    }
+    fdHeston.claimDevice(deviceList[0]);
+
+    retval = fdHeston.run(S, strikes, rd, V, maturities, kappa, sigma, rho, eta, N, numOptions, batchPrices);
+    std::cout << "Batch duration - " << fdHeston.getLastRunTime() << " us. Result - " << retval << std::endl;
+    if (retval != XLNX_OK) {
+        numberMismatches = numOptions;
+    }
+
+    double dt = T / N;
+    for (i = 0; retval == XLNX_OK && i < numOptions; i++) {
+        int steps = (int)std::lround(maturities[i] / dt);
+        if (steps < 1) {
+            steps = 1;
+        }
+        double price;
+        retval = fdHeston.run(S, K, rd, V, maturities[i], kappa, sigma, rho, eta, steps, &price);
+        if (retval != XLNX_OK || !CompareValues(price, batchPrices[i])) {
+            std::cout << std::setprecision(10) << "Batch result differs for T:" << maturities[i]
+                      << " Single:" << price << " Batch:" << batchPrices[i] << std::endl;
+            numberMismatches++;
+        }
+    }
+
+    if (numberMismatches == 0) {
+        std::cout << testcase << " batch PASSED" << std::endl;
+    } else {
+        std::cout << testcase << " batch FAILED" << std::endl;
+    }
+
+    fdHeston.releaseDevice();
+
+    return numberMismatches;
+}
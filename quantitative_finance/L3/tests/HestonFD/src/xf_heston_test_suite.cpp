@@ -27,6 +27,7 @@ int HestonFDTestSuite::Run(CSV csv, double delta) {
             std::cout << "Running testcase " << csv.showTestCase(i) << std::endl; // results
             HestonFDTestCase* MyTestCase = new HestonFDTestCase(delta);
             int mismatches = MyTestCase->Run(csv.showTestCase(i), csv.showTestScheme(i), csv.showTestParameters(i));
+            mismatches += MyTestCase->RunBatch(csv.showTestCase(i), csv.showTestParameters(i));
             csv.setNumberMismatches(i, mismatches);
             delete MyTestCase;
         }
@@ -40,6 +40,69 @@ static double requiredTolerance;
 /* The following variable will hold our calculated option price... */
 static double optionPrice;
 
+/*
+ * Price the initial option with fresh coefficients, with the cached ones and
+ * with ones exported and loaded back. The kernels use fixed seeds, so the
+ * three prices must be identical.
+ */
+static int MCDemoCheckCoefficientReuse(MCAmerican* pMCAmerican) {
+    int retval = XLNX_OK;
+    double freshPrice = 0.0;
+    double cachedPrice = 0.0;
+    double loadedPrice = 0.0;
+    long long int freshTime = 0;
+    long long int cachedTime = 0;
+    std::vector<double> coefficients;
+
+    /* calibrate on every run... */
+    pMCAmerican->setCoefficientReuseTolerance(-1.0);
+    retval = pMCAmerican->run(optionType, initialStockPrice, initialStrikePrice, initialRiskFreeRate,
+                              initialDividendYield, initialVolatility, initialTimeToMaturity,
+                              initialRequiredTolerance, &freshPrice);
+    freshTime = pMCAmerican->getLastRunTime();
+
+    /* ...then reuse the coefficients for identical parameters */
+    if (retval == XLNX_OK) {
+        pMCAmerican->setCoefficientReuseTolerance(0.0);
+        retval = pMCAmerican->run(optionType, initialStockPrice, initialStrikePrice, initialRiskFreeRate,
+                                  initialDividendYield, initialVolatility, initialTimeToMaturity,
+                                  initialRequiredTolerance, &cachedPrice);
+        cachedTime = pMCAmerican->getLastRunTime();
+    }
+
+    /* export the coefficients, overwrite them with another calibration and load them back */
+    if (retval == XLNX_OK) {
+        retval = pMCAmerican->getCoefficients(coefficients);
+    }
+    if (retval == XLNX_OK) {
+        retval = pMCAmerican->calibrate(optionType, initialStockPrice * 1.1, initialStrikePrice, initialRiskFreeRate,
+                                        initialDividendYield, initialVolatility, initialTimeToMaturity);
+    }
+    if (retval == XLNX_OK) {
+        retval = pMCAmerican->setCoefficients(optionType, initialStockPrice, initialStrikePrice, initialRiskFreeRate,
+                                              initialDividendYield, initialVolatility, initialTimeToMaturity,
+                                              coefficients);
+    }
+    if (retval == XLNX_OK) {
+        retval = pMCAmerican->run(optionType, initialStockPrice, initialStrikePrice, initialRiskFreeRate,
+                                  initialDividendYield, initialVolatility, initialTimeToMaturity,
+                                  initialRequiredTolerance, &loadedPrice);
+    }
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] Coefficient reuse: calibrated %.6f (%lld us), cached %.6f (%lld us), loaded %.6f\n",
+               freshPrice, freshTime, cachedPrice, cachedTime, loadedPrice);
+        if (cachedPrice != freshPrice || loadedPrice != freshPrice) {
+            printf("[XLNX] ERROR - reused coefficients give a different price\n");
+            retval = XLNX_ERROR_MODEL_INTERNAL_ERROR;
+        }
+    } else {
+        printf("[XLNX] ERROR - Failed to check coefficient reuse - error = %d\n", retval);
+    }
+
+    return retval;
+}
+
 int MCDemoRunAmericanSingle(Device* pChosenDevice, MCAmerican* pMCAmerican) {
     int retval = XLNX_OK;
     int i;
@@ -125,6 +188,13 @@ int MCDemoRunAmericanSingle(Device* pChosenDevice, MCAmerican* pMCAmerican) {
             "---------+--------------+----------------+\n");
     }
 
+    //
+    // Check that cached and exported coefficients price like fresh ones...
+    //
+    if (retval == XLNX_OK) {
+        retval = MCDemoCheckCoefficientReuse(pMCAmerican);
+    }
+
     //
     // Release the device so another object can claim it...
     //
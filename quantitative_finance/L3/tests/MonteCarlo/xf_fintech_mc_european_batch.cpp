@@ -0,0 +1,122 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <chrono>
+#include <vector>
+
+#include "xf_fintech_mc_example.hpp"
+
+#include "xf_fintech_api.hpp"
+
+using namespace xf::fintech;
+
+// In this example, a whole strike / maturity surface on the same underlying is
+// priced in ONE call to the MC European Batch model. All options share the same
+// simulated paths, so the surface costs a single simulation.
+
+static const double stockPrice = 100.0;
+static const double riskFreeRate = 0.03;
+static const double dividendYield = 0.01;
+static const double volatility = 0.20;
+
+static const unsigned int requiredSamples = 65536;
+static const unsigned int timeSteps = 12;
+
+static const unsigned int numStrikes = 41;
+static const unsigned int numMaturities = 12;
+
+int MCDemoRunEuropeanBatch(Device* pChosenDevice, MCEuropeanBatch* pMCEuropeanBatch) {
+    int retval = XLNX_OK;
+    unsigned int i, j;
+    std::chrono::time_point<std::chrono::high_resolution_clock> start;
+    std::chrono::time_point<std::chrono::high_resolution_clock> end;
+
+    unsigned int numOptions = 2 * numStrikes * numMaturities;
+    std::vector<OptionType> optionType(numOptions);
+    std::vector<double> strikePrice(numOptions);
+    std::vector<double> timeToMaturity(numOptions);
+    std::vector<double> optionPrice(numOptions);
+
+    printf("\n\n\n");
+
+    printf(
+        "[XLNX] "
+        "***************************************************************\n");
+    printf("[XLNX] Running MC EUROPEAN BATCH...\n");
+    printf(
+        "[XLNX] "
+        "***************************************************************\n");
+
+    // calls and puts with strikes from 80 to 120 and monthly maturities up to one
+    // year, the maturities lie on the time grid of the simulation
+    for (i = 0; i < 2 * numMaturities; i++) {
+        for (j = 0; j < numStrikes; j++) {
+            optionType[i * numStrikes + j] = (i < numMaturities) ? Call : Put;
+            strikePrice[i * numStrikes + j] = 80.0 + j;
+            timeToMaturity[i * numStrikes + j] = (double)(i % numMaturities + 1) / numMaturities;
+        }
+    }
+
+    //
+    // Claim the device for our MCEuropeanBatch object...this will download the
+    // required XCLBIN file (if needed)...
+    //
+    printf("[XLNX] mcEuropeanBatch trying to claim device...\n");
+
+    start = std::chrono::high_resolution_clock::now();
+
+    retval = pMCEuropeanBatch->claimDevice(pChosenDevice);
+
+    end = std::chrono::high_resolution_clock::now();
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] Device setup time = %lld microseconds\n",
+               (long long int)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+    } else {
+        printf("[XLNX] ERROR - Failed to claim device - error = %d\n", retval);
+    }
+
+    if (retval == XLNX_OK) {
+        retval = pMCEuropeanBatch->run(optionType.data(), stockPrice, strikePrice.data(), riskFreeRate, dividendYield,
+                                       volatility, timeToMaturity.data(), requiredSamples, timeSteps,
+                                       optionPrice.data(), numOptions);
+    }
+
+    if (retval == XLNX_OK) {
+        printf("[XLNX] +------+--------------+------------+--------------+\n");
+        printf("[XLNX] | Type | Strike Price |  Maturity  | Option Price |\n");
+        printf("[XLNX] +------+--------------+------------+--------------+\n");
+
+        for (i = 0; i < numOptions; i += numStrikes) {
+            // print the at-the-money option of each maturity
+            j = i + numStrikes / 2;
+            printf("[XLNX] | %4s | %12.4f | %10.4f | %12.4f |\n", (optionType[j] == Call) ? "Call" : "Put",
+                   strikePrice[j], timeToMaturity[j], optionPrice[j]);
+        }
+
+        printf("[XLNX] +------+--------------+------------+--------------+\n");
+        printf("[XLNX] Priced %u options in %lld us\n", numOptions, pMCEuropeanBatch->getLastRunTime());
+    }
+
+    //
+    // Release the device so another object can claim it...
+    //
+    printf("[XLNX] mcEuropeanBatch releasing device...\n");
+    retval = pMCEuropeanBatch->releaseDevice();
+
+    return retval;
+}
@@ -30,6 +30,7 @@ using namespace xf::fintech;
 // Here are our the objects that represent our the Fintech models we will be
 // using...
 MCEuropean mcEuropean;
+MCEuropeanBatch mcEuropeanBatch;
 MCAmerican mcAmerican;
 
 double varianceMultiplier;
@@ -71,6 +72,10 @@ int main() {
         retval = MCDemoRunEuropeanMultiple2(pChosenDevice, &mcEuropean);
     }
 
+    if (retval == XLNX_OK) {
+        retval = MCDemoRunEuropeanBatch(pChosenDevice, &mcEuropeanBatch);
+    }
+
     //////////////////////////////////////////////////////////////////////////////////////////
     // Now switch to MC American...
     //////////////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +95,42 @@ int main() {
 
     fclose(fp);
 
+    // multi-dimensional target: normal distribution with mean i and variance 1 in dimension i, streamed to a file
+    static const int numDims = 4;
+    std::vector<double> targetParameters(numDims + numDims * numDims, 0.0);
+    double initialPoint[numDims] = {0.0};
+    double sampleSum[numDims] = {0.0};
+    long long int numStreamed = 0;
+    for (int i = 0; i < numDims; i++) {
+        targetParameters[i] = i;
+        targetParameters[numDims + i * numDims + i] = 1.0;
+    }
+
+    fp = fopen("pop_mcmc_md_output.csv", "wb");
+    retval = popmcmc.runMultiDim(numDims, targetParameters, initialPoint, 100000, 1000, 0.5,
+                                 [&](const double* samples, int count) {
+                                     for (int k = 0; k < count; k++) {
+                                         for (int i = 0; i < numDims; i++) {
+                                             double x = samples[k * numDims + i];
+                                             sampleSum[i] += x;
+                                             fprintf(fp, (i < numDims - 1) ? "%lf," : "%lf\n", x);
+                                         }
+                                     }
+                                     numStreamed += count;
+                                     return XLNX_OK;
+                                 });
+    fclose(fp);
+
+    if (retval == XLNX_OK) {
+        for (int i = 0; i < numDims; i++) {
+            printf("[XF_FINTECH] Dimension %d: sample mean = %f, target mean = %f\n", i, sampleSum[i] / numStreamed,
+                   targetParameters[i]);
+        }
+        printf("[XF_FINTECH] Multi-dimensional ExecutionTime = %lld microseconds\n", popmcmc.getLastRunTime());
+    } else {
+        printf("[XF_FINTECH] Multi-dimensional run failed - error = %d\n", retval);
+    }
+
     printf("[XF_FINTECH] PopMCMC releasing device...\n");
     retval = popmcmc.releaseDevice();
 
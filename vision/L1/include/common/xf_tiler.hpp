@@ -0,0 +1,169 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_TILER_H_
+#define _XF_TILER_H_
+
+#include <assert.h>
+#include <vector>
+#include "opencv2/core/core.hpp"
+
+namespace xf {
+namespace cv {
+
+/**
+ * Region of the source image read by one tile, and the part of it written to
+ * the output. The output region excludes the halo, except at the image
+ * borders where the kernel applies its own border handling.
+ */
+struct TileRect {
+    // Input region, halo included
+    int x;
+    int y;
+    int width;
+    int height;
+    // Output region, in image coordinates
+    int outX;
+    int outY;
+    int outWidth;
+    int outHeight;
+};
+
+/**
+ * Halo needed around a tile for a window filter of the given size, e.g.
+ * GaussianBlur, filter2D, medianBlur, boxFilter, bilateralFilter, dilate,
+ * erode, Sobel. Functions which do not operate on a fixed window (resize,
+ * pyrDown, remap, warpTransform) can not be tiled this way.
+ */
+inline int tileHalo(int filterSize) {
+    return filterSize >> 1;
+}
+
+/**
+ * Host side splitting of images larger than the compile time ROWS x COLS of a
+ * kernel into tiles of at most maxRows x maxCols, overlapped by the filter
+ * halo so that the stitched output has no seams.
+ *
+ * The output of the kernel inside the halo of an inner tile border is
+ * discarded, which makes each stitched pixel the result of a full filter
+ * window of source pixels. Running several window filters one after the other
+ * in the kernel requires the sum of their halos.
+ *
+ * align is the granularity of tile columns, e.g. the NPC of the kernel; the
+ * image width must be a multiple of it, as for the untiled kernel.
+ */
+class Tiler {
+   public:
+    Tiler(int rows, int cols, int maxRows, int maxCols, int halo, int align = 1)
+        : m_rows(rows), m_cols(cols), m_maxRows(maxRows), m_maxCols(maxCols) {
+        assert((align > 0) && "Alignment must be positive");
+        assert((cols % align == 0) && "Image width must be a multiple of the alignment");
+        assert((maxCols % align == 0) && "Tile width must be a multiple of the alignment");
+
+        // the column halo is rounded up to keep every tile start aligned
+        int haloX = ((halo + align - 1) / align) * align;
+        int stepX = (cols <= maxCols) ? cols : maxCols - 2 * haloX;
+        int stepY = (rows <= maxRows) ? rows : maxRows - 2 * halo;
+        assert((stepX > 0) && (stepY > 0) && "Tile too small for the halo");
+
+        for (int y = 0; y < rows; y += stepY) {
+            int yEnd = (y + stepY < rows) ? y + stepY : rows;
+            int inY = (y - halo > 0) ? y - halo : 0;
+            int inYEnd = (yEnd + halo < rows) ? yEnd + halo : rows;
+            for (int x = 0; x < cols; x += stepX) {
+                int xEnd = (x + stepX < cols) ? x + stepX : cols;
+                int inX = (x - haloX > 0) ? x - haloX : 0;
+                int inXEnd = (xEnd + haloX < cols) ? xEnd + haloX : cols;
+
+                TileRect t;
+                t.x = inX;
+                t.y = inY;
+                t.width = inXEnd - inX;
+                t.height = inYEnd - inY;
+                t.outX = x;
+                t.outY = y;
+                t.outWidth = xEnd - x;
+                t.outHeight = yEnd - y;
+                m_tiles.push_back(t);
+            }
+        }
+    }
+
+    int size() const { return m_tiles.size(); }
+
+    const TileRect& tile(int i) const { return m_tiles[i]; }
+
+    /**
+     * Copies the input region of tile i into a continuous image, ready to be
+     * sent to the kernel.
+     */
+    void extract(const ::cv::Mat& src, int i, ::cv::Mat& tileIn) const {
+        const TileRect& t = m_tiles[i];
+        src(::cv::Rect(t.x, t.y, t.width, t.height)).copyTo(tileIn);
+    }
+
+    /**
+     * Copies the output region of the kernel result for tile i into dst.
+     */
+    void stitch(const ::cv::Mat& tileOut, int i, ::cv::Mat& dst) const {
+        const TileRect& t = m_tiles[i];
+        tileOut(::cv::Rect(t.outX - t.x, t.outY - t.y, t.outWidth, t.outHeight))
+            .copyTo(dst(::cv::Rect(t.outX, t.outY, t.outWidth, t.outHeight)));
+    }
+
+    /**
+     * Streams all tiles of src through a kernel with double buffering: while
+     * the kernel processes one tile, the next one is extracted and submitted
+     * and the previous one is stitched into dst.
+     *
+     * submit(slot, tileIn, t) starts the processing of tileIn in buffer slot 0
+     * or 1 and returns without waiting. wait(slot, tileOut) blocks until that
+     * slot is done and fills tileOut, t.height x t.width pixels.
+     */
+    template <typename SubmitFn, typename WaitFn>
+    void run(const ::cv::Mat& src, ::cv::Mat& dst, SubmitFn submit, WaitFn wait) const {
+        assert((src.rows == m_rows) && (src.cols == m_cols) && "Source size does not match the tiler");
+        assert((dst.rows == m_rows) && (dst.cols == m_cols) && "Destination size does not match the tiler");
+
+        ::cv::Mat tileIn[2];
+        ::cv::Mat tileOut;
+        int n = m_tiles.size();
+
+        extract(src, 0, tileIn[0]);
+        submit(0, tileIn[0], m_tiles[0]);
+        for (int i = 0; i < n; i++) {
+            if (i + 1 < n) {
+                int next = (i + 1) & 1;
+                extract(src, i + 1, tileIn[next]);
+                submit(next, tileIn[next], m_tiles[i + 1]);
+            }
+            wait(i & 1, tileOut);
+            stitch(tileOut, i, dst);
+        }
+    }
+
+   private:
+    int m_rows;
+    int m_cols;
+    int m_maxRows;
+    int m_maxCols;
+    std::vector<TileRect> m_tiles;
+};
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_TILER_H_
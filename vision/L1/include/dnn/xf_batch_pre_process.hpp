@@ -0,0 +1,284 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_BATCH_PRE_PROCESS_
+#define _XF_BATCH_PRE_PROCESS_
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "imgproc/xf_resize.hpp"
+
+namespace xf {
+namespace cv {
+
+// Memory layout of the output tensor
+enum batchLayout { XF_NCHW = 0, XF_NHWC = 1 };
+
+// Fields of the per frame descriptor, XF_BATCH_DESC_SIZE ints per frame
+enum batchDesc {
+    XF_BATCH_DESC_OFFSET = 0, // start of the frame in the input buffer, in INPUT_PTR_WIDTH words
+    XF_BATCH_DESC_ROWS,       // size of the input frame
+    XF_BATCH_DESC_COLS,
+    XF_BATCH_DESC_RS_ROWS, // size of the resized frame inside the letterbox
+    XF_BATCH_DESC_RS_COLS,
+    XF_BATCH_DESC_PAD_TOP, // position of the resized frame inside the letterbox
+    XF_BATCH_DESC_PAD_LEFT,
+    XF_BATCH_DESC_SIZE
+};
+
+/**
+ * Conversion of the normalized value to the tensor element type: round and
+ * saturate for integer types, plain conversion otherwise (e.g. half or float).
+ */
+template <typename OUT_T>
+struct xFBatchConvert {
+    template <typename V>
+    static OUT_T cast(V v) {
+        return (OUT_T)v.to_float();
+    }
+};
+
+template <int W>
+struct xFBatchConvert<ap_int<W> > {
+    template <typename V>
+    static ap_int<W> cast(V v) {
+        ap_fixed<W, W, AP_RND, AP_SAT> s = v;
+        return (ap_int<W>)s.to_int();
+    }
+};
+
+/**
+ * Letterbox, mean/scale and layout stage: places the resized frame at
+ * (pad_top, pad_left) of the OUT_ROWS x OUT_COLS tensor, fills the border
+ * with the pad value, computes (x - mean[c]) * scale[c] per channel and writes
+ * one row at a time, one burst per row in NHWC and one burst per channel plane
+ * row in NCHW.
+ */
+template <int TYPE, int ROWS, int COLS, int NPC, int CH, int LAYOUT, typename OUT_T>
+void xFBatchLetterbox(xf::cv::Mat<TYPE, ROWS, COLS, NPC>& src,
+                      OUT_T* dst,
+                      ap_fixed<18, 10, AP_RND> mean[CH],
+                      ap_fixed<24, 8, AP_RND> scale[CH],
+                      unsigned char pad,
+                      bool swap_rb,
+                      int out_rows,
+                      int out_cols,
+                      int pad_top,
+                      int pad_left) {
+    typedef ap_fixed<42, 18, AP_RND> NORM_T;
+
+    OUT_T lineBuf[CH][COLS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=lineBuf complete dim=1
+    // clang-format on
+
+    int plane = out_rows * out_cols;
+    int rs_rows = src.rows;
+    int rs_cols = src.cols;
+    int idx = 0;
+
+rowLoop:
+    for (int y = 0; y < out_rows; y++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS
+        // clang-format on
+        bool row_in = (y >= pad_top) && (y < pad_top + rs_rows);
+
+    colLoop:
+        for (int x = 0; x < out_cols; x++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            XF_TNAME(TYPE, NPC) pix;
+            if (row_in && (x >= pad_left) && (x < pad_left + rs_cols)) {
+                pix = src.read(idx++);
+            } else {
+                for (int c = 0; c < CH; c++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    pix.range(c * 8 + 7, c * 8) = pad;
+                }
+            }
+
+            for (int c = 0; c < CH; c++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                int sc = (swap_rb && CH == 3) ? (CH - 1 - c) : c;
+                ap_ufixed<8, 8> v = (unsigned char)pix.range(sc * 8 + 7, sc * 8);
+                NORM_T n = (v - mean[c]) * scale[c];
+                lineBuf[c][x] = xFBatchConvert<OUT_T>::cast(n);
+            }
+        }
+
+        if (LAYOUT == XF_NHWC) {
+        nhwcWrite:
+            for (int x = 0; x < out_cols * CH; x++) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS*CH
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                int px = x / CH;
+                int c = x - px * CH;
+                dst[y * out_cols * CH + x] = lineBuf[c][px];
+            }
+        } else {
+            for (int c = 0; c < CH; c++) {
+            nchwWrite:
+                for (int x = 0; x < out_cols; x++) {
+// clang-format off
+                    #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS
+                    #pragma HLS PIPELINE II=1
+                    // clang-format on
+                    dst[c * plane + y * out_cols + x] = lineBuf[c][x];
+                }
+            }
+        }
+    }
+}
+
+template <int INPUT_PTR_WIDTH,
+          int TYPE,
+          int ROWS,
+          int COLS,
+          int OUT_ROWS,
+          int OUT_COLS,
+          int MAXDOWNSCALE,
+          int INTERPOLATION,
+          int LAYOUT,
+          typename OUT_T>
+void xFBatchPreProcessFrame(ap_uint<INPUT_PTR_WIDTH>* src,
+                            OUT_T* dst,
+                            ap_fixed<18, 10, AP_RND> mean[XF_CHANNELS(TYPE, XF_NPPC1)],
+                            ap_fixed<24, 8, AP_RND> scale[XF_CHANNELS(TYPE, XF_NPPC1)],
+                            unsigned char pad,
+                            bool swap_rb,
+                            int rows,
+                            int cols,
+                            int rs_rows,
+                            int rs_cols,
+                            int out_rows,
+                            int out_cols,
+                            int pad_top,
+                            int pad_left) {
+    xf::cv::Mat<TYPE, ROWS, COLS, XF_NPPC1> in_mat(rows, cols);
+// clang-format off
+    #pragma HLS stream variable=in_mat.data depth=2
+    // clang-format on
+    xf::cv::Mat<TYPE, OUT_ROWS, OUT_COLS, XF_NPPC1> rs_mat(rs_rows, rs_cols);
+// clang-format off
+    #pragma HLS stream variable=rs_mat.data depth=2
+    #pragma HLS DATAFLOW
+    // clang-format on
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, TYPE, ROWS, COLS, XF_NPPC1>(src, in_mat);
+    xf::cv::resize<INTERPOLATION, TYPE, ROWS, COLS, OUT_ROWS, OUT_COLS, XF_NPPC1, MAXDOWNSCALE>(in_mat, rs_mat);
+    xFBatchLetterbox<TYPE, OUT_ROWS, OUT_COLS, XF_NPPC1, XF_CHANNELS(TYPE, XF_NPPC1), LAYOUT, OUT_T>(
+        rs_mat, dst, mean, scale, pad, swap_rb, out_rows, out_cols, pad_top, pad_left);
+}
+
+/**
+ * Pre-processing of a batch of frames of different sizes into one
+ * batch x CH x out_rows x out_cols (NCHW) or batch x out_rows x out_cols x CH
+ * (NHWC) tensor in a single launch: each frame is resized to the
+ * rs_rows x rs_cols of its descriptor, letterboxed with the pad value,
+ * normalized as (x - mean[c]) * scale[c] and converted to OUT_T, e.g.
+ * ap_int<8> for int8 tensors with the quantization scale folded into scale,
+ * or half for fp16 tensors.
+ *
+ * desc holds XF_BATCH_DESC_SIZE ints per frame, see batchDesc. params holds
+ * CH means followed by CH scales. Frames are in the channel order of the
+ * input, swap_rb reverses it, e.g. BGR frames into an RGB tensor.
+ */
+template <int INPUT_PTR_WIDTH,
+          int TYPE,
+          int ROWS,
+          int COLS,
+          int OUT_ROWS,
+          int OUT_COLS,
+          int MAX_BATCH,
+          int MAXDOWNSCALE,
+          int INTERPOLATION,
+          int LAYOUT,
+          typename OUT_T>
+void batchPreProcess(ap_uint<INPUT_PTR_WIDTH>* src,
+                     OUT_T* dst,
+                     int* desc,
+                     float* params,
+                     int batch,
+                     int out_rows,
+                     int out_cols,
+                     unsigned char pad,
+                     bool swap_rb) {
+    const int CH = XF_CHANNELS(TYPE, XF_NPPC1);
+
+    ap_fixed<18, 10, AP_RND> mean[CH];
+    ap_fixed<24, 8, AP_RND> scale[CH];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=mean complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=scale complete dim=0
+    // clang-format on
+
+    for (int i = 0; i < 2 * CH; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        float temp = params[i];
+        if (i < CH)
+            mean[i] = temp;
+        else
+            scale[i - CH] = temp;
+    }
+
+    int frame_size = CH * out_rows * out_cols;
+
+batchLoop:
+    for (int n = 0; n < batch; n++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAX_BATCH
+        // clang-format on
+        int d[XF_BATCH_DESC_SIZE];
+// clang-format off
+        #pragma HLS ARRAY_PARTITION variable=d complete dim=0
+        // clang-format on
+        for (int k = 0; k < XF_BATCH_DESC_SIZE; k++) {
+// clang-format off
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            d[k] = desc[n * XF_BATCH_DESC_SIZE + k];
+        }
+
+        assert((d[XF_BATCH_DESC_ROWS] <= ROWS) && (d[XF_BATCH_DESC_COLS] <= COLS) &&
+               "Frame larger than the maximum input size");
+        assert((d[XF_BATCH_DESC_PAD_TOP] + d[XF_BATCH_DESC_RS_ROWS] <= out_rows) &&
+               (d[XF_BATCH_DESC_PAD_LEFT] + d[XF_BATCH_DESC_RS_COLS] <= out_cols) &&
+               "Resized frame does not fit the letterbox");
+
+        xFBatchPreProcessFrame<INPUT_PTR_WIDTH, TYPE, ROWS, COLS, OUT_ROWS, OUT_COLS, MAXDOWNSCALE, INTERPOLATION,
+                               LAYOUT, OUT_T>(
+            src + d[XF_BATCH_DESC_OFFSET], dst + n * frame_size, mean, scale, pad, swap_rb, d[XF_BATCH_DESC_ROWS],
+            d[XF_BATCH_DESC_COLS], d[XF_BATCH_DESC_RS_ROWS], d[XF_BATCH_DESC_RS_COLS], out_rows, out_cols,
+            d[XF_BATCH_DESC_PAD_TOP], d[XF_BATCH_DESC_PAD_LEFT]);
+    }
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif
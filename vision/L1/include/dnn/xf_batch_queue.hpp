@@ -0,0 +1,210 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_BATCH_QUEUE_H_
+#define _XF_BATCH_QUEUE_H_
+
+#include <assert.h>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string.h>
+#include <vector>
+#include "opencv2/core/core.hpp"
+#include "dnn/xf_batch_pre_process.hpp"
+
+namespace xf {
+namespace cv {
+
+/**
+ * Host side queue gathering frames of several camera streams into the input
+ * buffer and descriptors of one batchPreProcess launch.
+ *
+ * push() may be called from one thread per stream. Each stream keeps at most
+ * depth frames, the oldest one is dropped when a camera runs ahead of the
+ * accelerator. pop() takes the frames round robin over the streams, so that a
+ * fast stream does not starve the others. Frames are copied when pushed, so a
+ * camera may reuse its frame buffer.
+ */
+class BatchQueue {
+   public:
+    BatchQueue(
+        int numStreams, int maxBatch, int outRows, int outCols, int maxRows, int maxCols, int ptrWidth, int depth = 2)
+        : m_queues(numStreams),
+          m_maxBatch(maxBatch),
+          m_outRows(outRows),
+          m_outCols(outCols),
+          m_maxRows(maxRows),
+          m_maxCols(maxCols),
+          m_wordBytes(ptrWidth / 8),
+          m_depth(depth),
+          m_next(0),
+          m_count(0),
+          m_closed(false) {
+        assert((numStreams > 0) && (maxBatch > 0) && (depth > 0) && "Invalid queue configuration");
+        assert((ptrWidth % 8 == 0) && "Pointer width must be a multiple of 8 bits");
+    }
+
+    /**
+     * Size and position of a rows x cols frame scaled to fit outRows x outCols
+     * with its aspect ratio kept, centered in the letterbox.
+     */
+    static void letterbox(
+        int rows, int cols, int outRows, int outCols, int& rsRows, int& rsCols, int& padTop, int& padLeft) {
+        double s = ((double)outRows / rows < (double)outCols / cols) ? (double)outRows / rows : (double)outCols / cols;
+        rsRows = (int)(rows * s + 0.5);
+        rsCols = (int)(cols * s + 0.5);
+        if (rsRows < 1) rsRows = 1;
+        if (rsCols < 1) rsCols = 1;
+        if (rsRows > outRows) rsRows = outRows;
+        if (rsCols > outCols) rsCols = outCols;
+        padTop = (outRows - rsRows) / 2;
+        padLeft = (outCols - rsCols) / 2;
+    }
+
+    /**
+     * Queues a copy of a frame of the given stream. Returns false when the
+     * oldest frame of the stream was dropped to make room for it.
+     */
+    bool push(int stream, const ::cv::Mat& frame) {
+        assert((stream >= 0) && (stream < (int)m_queues.size()) && "Invalid stream");
+        assert((frame.rows <= m_maxRows) && (frame.cols <= m_maxCols) && "Frame larger than the kernel maximum");
+
+        bool kept = true;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            std::deque< ::cv::Mat>& q = m_queues[stream];
+            if ((int)q.size() == m_depth) {
+                q.pop_front();
+                m_count--;
+                kept = false;
+            }
+            // a cv::Mat shares its data, the caller may overwrite it after the call
+            q.push_back(frame.clone());
+            m_count++;
+        }
+        m_cond.notify_one();
+        return kept;
+    }
+
+    /**
+     * Waits for a full batch, for at most timeoutMs when not negative, and
+     * packs the queued frames into packed, INPUT_PTR_WIDTH aligned, with their
+     * XF_BATCH_DESC_SIZE ints of descriptor in desc and their stream in
+     * streams. Returns the number of frames, less than a full batch after the
+     * timeout, 0 when the timeout expires with no frame queued or once the
+     * queue is closed and empty, see finished().
+     */
+    int pop(std::vector<unsigned char>& packed, std::vector<int>& desc, std::vector<int>& streams, int timeoutMs = -1) {
+        std::vector< ::cv::Mat> frames;
+        streams.clear();
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            auto ready = [this] { return m_closed || m_count >= m_maxBatch; };
+            if (timeoutMs < 0) {
+                m_cond.wait(lock, ready);
+            } else {
+                m_cond.wait_for(lock, std::chrono::milliseconds(timeoutMs), ready);
+            }
+
+            int numStreams = m_queues.size();
+            for (int empty = 0; ((int)frames.size() < m_maxBatch) && (empty < numStreams);) {
+                std::deque< ::cv::Mat>& q = m_queues[m_next];
+                if (q.empty()) {
+                    empty++;
+                } else {
+                    empty = 0;
+                    frames.push_back(q.front());
+                    streams.push_back(m_next);
+                    q.pop_front();
+                    m_count--;
+                }
+                m_next = (m_next + 1) % numStreams;
+            }
+        }
+
+        int n = frames.size();
+        desc.assign(n * XF_BATCH_DESC_SIZE, 0);
+
+        size_t offset = 0;
+        for (int i = 0; i < n; i++) {
+            int* d = &desc[i * XF_BATCH_DESC_SIZE];
+            d[XF_BATCH_DESC_OFFSET] = offset / m_wordBytes;
+            d[XF_BATCH_DESC_ROWS] = frames[i].rows;
+            d[XF_BATCH_DESC_COLS] = frames[i].cols;
+            letterbox(frames[i].rows, frames[i].cols, m_outRows, m_outCols, d[XF_BATCH_DESC_RS_ROWS],
+                      d[XF_BATCH_DESC_RS_COLS], d[XF_BATCH_DESC_PAD_TOP], d[XF_BATCH_DESC_PAD_LEFT]);
+            size_t bytes = frames[i].total() * frames[i].elemSize();
+            offset += ((bytes + m_wordBytes - 1) / m_wordBytes) * m_wordBytes;
+        }
+
+        packed.resize(offset);
+        for (int i = 0; i < n; i++) {
+            memcpy(&packed[(size_t)desc[i * XF_BATCH_DESC_SIZE + XF_BATCH_DESC_OFFSET] * m_wordBytes], frames[i].data,
+                   frames[i].total() * frames[i].elemSize());
+        }
+        return n;
+    }
+
+    /**
+     * True once the queue is closed and all its frames have been popped.
+     */
+    bool finished() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_closed && (m_count == 0);
+    }
+
+    /**
+     * Wakes up pop() for the remaining frames, e.g. when the cameras stop.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_cond.notify_all();
+    }
+
+    /**
+     * Size of the packed input buffer for a full batch of maximum size frames,
+     * to allocate the device buffer once.
+     */
+    size_t maxInputBytes(int elemSize) const {
+        size_t bytes = (size_t)m_maxRows * m_maxCols * elemSize;
+        return m_maxBatch * ((bytes + m_wordBytes - 1) / m_wordBytes) * m_wordBytes;
+    }
+
+   private:
+    std::vector<std::deque< ::cv::Mat> > m_queues;
+    int m_maxBatch;
+    int m_outRows;
+    int m_outCols;
+    int m_maxRows;
+    int m_maxCols;
+    int m_wordBytes;
+    int m_depth;
+    int m_next;
+    int m_count;
+    bool m_closed;
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+};
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_BATCH_QUEUE_H_
@@ -0,0 +1,506 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_ORB_HPP_
+#define _XF_ORB_HPP_
+
+#include "hls_stream.h"
+#include "hls_math.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+
+// Length of the descriptor in bits
+#define XF_ORB_DESC_BITS 256
+// Radius of the patch used for the orientation
+#define XF_ORB_HALF_PATCH 15
+// Keypoints closer than this to the border are dropped, the rotated pattern stays inside the image
+#define XF_ORB_BORDER 18
+// Marks the end of a row in the keypoint stream of orbKeypoints
+#define XF_ORB_END_OF_ROW 0xFFFFFFFF
+// Marks the end of the keypoint and match lists
+#define XF_ORB_END_OF_LIST 0xFFFFFFFFFFFFFFFFULL
+
+namespace xf {
+namespace cv {
+
+/**
+ * Point pairs (x1, y1, x2, y2) of the binary tests, drawn from an isotropic
+ * Gaussian over the 31x31 patch (BRIEF sampling G II) and bounded to
+ * [-13, 13]. This is not the learned pattern of OpenCV, descriptors are only
+ * comparable with descriptors of this implementation.
+ */
+static const signed char xFOrbPattern[XF_ORB_DESC_BITS][4] = {
+    {-10, 2, -10, 5}, {3, 1, 2, 1}, {-12, -8, 8, 9}, {-5, -5, 1, -6},
+    {3, 6, -4, -10}, {5, -2, 9, -9}, {4, 1, 3, -6}, {-2, -5, 1, -2},
+    {-8, 4, 5, -10}, {8, -8, -9, 0}, {5, 10, 8, 2}, {-1, 5, -6, 5},
+    {-1, -7, 0, -5}, {-2, -3, -3, -6}, {-11, -6, 6, 4}, {-7, 1, 5, -2},
+    {0, 0, -4, -11}, {-2, -11, 3, -3}, {8, -2, 7, -2}, {10, 0, -11, 0},
+    {-1, -4, 1, 10}, {-2, -5, -8, 3}, {2, 1, 0, 5}, {-2, -3, -6, -4},
+    {-4, 5, 1, 4}, {11, -1, -6, -3}, {7, 0, -11, -5}, {8, 0, 9, 2},
+    {-3, 13, -1, 1}, {2, 11, -1, 11}, {0, 6, 4, 4}, {-2, 1, 1, 5},
+    {3, -7, -4, 7}, {1, -3, 3, 4}, {11, 2, -2, -5}, {-8, -2, 3, -1},
+    {-3, 3, -3, -2}, {3, -8, 3, 5}, {-8, -5, -4, -7}, {1, 2, 1, -2},
+    {-6, 1, -1, -1}, {-3, -4, 0, 4}, {7, 2, -8, -5}, {-7, 2, 6, -2},
+    {7, -10, -3, -4}, {-3, 2, -4, 4}, {4, 1, -10, -9}, {3, 8, -9, 6},
+    {-1, -7, 13, 3}, {-9, -8, -12, 0}, {-3, -5, -4, -1}, {9, -11, 3, 4},
+    {-6, -4, -1, -1}, {10, 2, -1, 4}, {-10, 5, -4, -3}, {8, 0, 1, 13},
+    {3, 7, 8, 8}, {0, 0, -1, -3}, {-6, -5, -4, -4}, {10, 3, 2, -5},
+    {1, 3, 5, 8}, {-7, -1, -6, -1}, {-8, 1, 6, 3}, {1, 10, 7, -5},
+    {-9, 11, 2, -6}, {3, 5, -5, -11}, {-10, -7, 8, 0}, {-6, 0, -4, -4},
+    {11, -2, 10, -4}, {2, -3, -1, -1}, {3, -6, 2, -1}, {-8, -10, 9, 9},
+    {1, -5, -6, -3}, {0, 2, 0, -7}, {5, -6, 2, -7}, {-10, -3, 6, 3},
+    {3, 1, -5, 6}, {10, 1, -3, -2}, {-5, 2, 12, -1}, {2, 3, 4, 7},
+    {0, -2, -1, 4}, {3, -2, -1, 7}, {-5, 8, -2, -3}, {-6, -11, 1, 0},
+    {-2, 1, -2, -2}, {3, 0, 7, 4}, {1, -1, -11, 7}, {7, -4, -3, -5},
+    {5, 6, -5, 5}, {8, -3, 12, -6}, {2, 7, -5, -10}, {12, 10, 2, 5},
+    {-8, -6, -2, 10}, {11, 1, 2, 2}, {2, -2, -3, 2}, {7, -7, 0, 8},
+    {3, 7, -6, 6}, {3, 13, 1, -3}, {-8, 0, 3, -3}, {9, 0, 5, 1},
+    {1, -10, 1, -1}, {-5, 8, 8, -2}, {-7, 6, 7, -1}, {-8, 7, 1, -1},
+    {9, -6, 1, -4}, {-3, -3, 0, 6}, {1, -3, 10, 3}, {-11, 0, -1, -4},
+    {1, -13, -3, 5}, {0, -9, 3, -3}, {5, -6, 10, -1}, {6, -3, 7, 9},
+    {0, -3, -9, 10}, {0, 1, 11, 4}, {-1, 2, 3, -9}, {-10, 3, -7, -2},
+    {5, -5, 5, 0}, {-11, -1, 7, -1}, {3, -5, -7, -3}, {7, 9, 1, -3},
+    {7, 12, 1, 5}, {4, 5, -3, 4}, {-7, -8, 11, 0}, {-5, -8, -2, 1},
+    {-10, -11, -6, -1}, {2, 11, -1, -4}, {-2, -13, -9, -7}, {1, 6, -2, 5},
+    {-5, -4, 2, -9}, {7, 5, -6, -6}, {-9, -9, -1, 11}, {-1, -8, 12, 9},
+    {2, 0, -7, -8}, {6, -9, -2, 1}, {-8, -13, 1, -3}, {0, -5, -1, -6},
+    {2, -4, 8, 0}, {-2, 13, 7, 3}, {0, 0, 0, -6}, {9, 3, 0, 8},
+    {3, 6, -8, 0}, {6, 3, -4, 7}, {8, -1, 5, -5}, {7, 3, 10, -1},
+    {2, -8, 1, 0}, {1, -3, -3, 6}, {-1, 10, 2, 10}, {5, 0, -5, 5},
+    {-2, 6, 5, -3}, {5, 1, 0, -3}, {-5, 1, 1, -13}, {11, 8, 13, -2},
+    {12, 2, 0, -1}, {0, -3, 5, 2}, {-6, 1, -13, 7}, {-13, -5, 0, 10},
+    {4, 4, 2, 3}, {1, -2, 1, 2}, {2, -1, 0, 5}, {-5, -4, -2, -3},
+    {3, 6, 9, -6}, {3, -4, 7, 2}, {-8, -2, 5, 1}, {-7, -1, 3, 7},
+    {-9, 8, 6, 8}, {10, -5, -9, 1}, {-4, 9, -7, -12}, {-2, 11, 2, 1},
+    {-8, -1, 1, 6}, {-9, -2, 4, 1}, {6, 10, -4, 3}, {-9, 5, -9, -5},
+    {-3, -3, -12, 13}, {7, 1, 4, -5}, {1, -5, 2, -7}, {-1, 4, 2, 5},
+    {6, -7, 3, -3}, {-3, 0, 6, 6}, {-5, -1, 2, 1}, {3, -8, -7, -1},
+    {5, 0, -1, 4}, {-2, 5, 4, 1}, {-6, -1, -5, -3}, {-3, -7, 13, 2},
+    {2, -5, -8, -7}, {1, -9, -3, -6}, {6, 5, -9, 8}, {-6, 7, 3, 2},
+    {-3, 1, 6, 11}, {-1, 1, 3, 0}, {12, 4, -3, 1}, {4, 12, 0, 10},
+    {-5, -4, 5, 7}, {9, 6, -7, -9}, {4, 1, -1, -6}, {-3, 12, 3, 2},
+    {6, 3, 1, 9}, {-4, -3, 0, -5}, {2, -11, -1, -5}, {-6, -1, -9, 9},
+    {0, 3, 0, 0}, {-3, 4, 0, 2}, {9, 1, 3, -2}, {-2, -5, 5, 4},
+    {10, -5, 0, 3}, {2, 6, -2, 11}, {-1, 4, 9, -5}, {-8, 3, -6, -6},
+    {0, -1, 2, -6}, {-5, 2, -7, 3}, {2, -8, 1, 11}, {-3, 0, -5, 4},
+    {5, -3, 0, -5}, {0, -6, 1, -1}, {6, -5, -8, -1}, {-6, 3, -5, 4},
+    {-2, 12, 3, -5}, {-8, 8, -6, -3}, {-2, 0, -5, 3}, {2, 11, 2, -1},
+    {3, 2, -10, 12}, {1, 1, -1, -7}, {1, -9, 1, -5}, {-2, 9, -8, 0},
+    {-1, -2, 5, -1}, {-1, 4, 6, 1}, {7, 11, 1, 0}, {-3, -2, -13, -1},
+    {8, 2, -11, -1}, {4, 1, -5, 1}, {-5, 3, 4, 2}, {-9, 3, -3, -1},
+    {3, 0, -9, -1}, {-2, 9, -4, -11}, {-2, -2, -7, -9}, {6, -8, 6, -2},
+    {0, 2, 6, -2}, {-6, 2, -13, 0}, {-6, -2, 2, -7}, {0, 3, 3, 6},
+    {-1, -3, 4, -7}, {-2, 6, -1, -6}, {4, -10, 4, -3}, {4, 3, 8, -4},
+    {0, 2, -2, 2}, {-9, 0, -6, 5}, {4, 8, 1, -1}, {-1, 5, 2, 8},
+    {0, 5, 1, -5}, {-7, -4, 5, -3}, {-5, 1, -3, 5}, {-2, -2, -9, 0},
+    {7, 5, -4, -2}, {5, -2, 4, 3}, {8, 0, -1, 0}, {6, 1, 0, -2},
+};
+
+/**
+ * Packs a keypoint: column and row in the image of its pyramid level, level
+ * and orientation in degrees, [0, 360).
+ */
+inline ap_uint<64> orbPackKeypoint(int row, int col, int level, int angle) {
+    ap_uint<64> kp = 0;
+    kp.range(15, 0) = col;
+    kp.range(31, 16) = row;
+    kp.range(39, 32) = level;
+    kp.range(63, 48) = angle;
+    return kp;
+}
+
+/**
+ * Keypoint stream from a corner image, e.g. the output of fast or
+ * cornerHarris: one row << 16 | col word per corner, in raster order, and
+ * XF_ORB_END_OF_ROW at the end of each row so that orbDescriptors never waits
+ * for rows it has not buffered. Corners closer than XF_ORB_BORDER to the
+ * border are dropped. The rest of the image is divided into a GRID_Y x GRID_X
+ * grid of cells and each cell keeps at most max_kp / (GRID_Y * GRID_X)
+ * corners, the first ones of the cell in raster order, so that the keypoints
+ * cover the whole image instead of its first rows.
+ */
+template <int ROWS, int COLS, int GRID_Y, int GRID_X>
+void orbKeypoints(xf::cv::Mat<XF_8UC1, ROWS, COLS, XF_NPPC1>& corners, hls::stream<ap_uint<32> >& kp, int max_kp) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert(((corners.rows <= ROWS) && (corners.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+#endif
+    int rows = corners.rows;
+    int cols = corners.cols;
+    int cell_kp = max_kp / (GRID_Y * GRID_X);
+
+    // Cells over the rows and columns at least XF_ORB_BORDER from the border
+    int cell_h = (rows - 2 * XF_ORB_BORDER + GRID_Y - 1) / GRID_Y;
+    int cell_w = (cols - 2 * XF_ORB_BORDER + GRID_X - 1) / GRID_X;
+
+    // Keypoints of each cell of the current row of cells
+    ap_uint<16> cell_count[GRID_X];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=cell_count complete dim=0
+    // clang-format on
+    int ry = 0;
+
+RowLoop:
+    for (int i = 0; i < rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+        // clang-format on
+        bool inside_row = (i >= XF_ORB_BORDER) && (i < rows - XF_ORB_BORDER);
+        if (inside_row && (ry == 0)) {
+            for (int c = 0; c < GRID_X; c++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                cell_count[c] = 0;
+            }
+        }
+        int cx = 0;
+        int rx = 0;
+
+    ColLoop:
+        for (int j = 0; j < cols; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS max=COLS
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            ap_uint<8> v = corners.read(i * cols + j);
+            bool inside = inside_row && (j >= XF_ORB_BORDER) && (j < cols - XF_ORB_BORDER);
+            if ((v == 255) && inside && (cell_count[cx] < cell_kp)) {
+                ap_uint<32> p;
+                p.range(31, 16) = i;
+                p.range(15, 0) = j;
+                kp.write(p);
+                cell_count[cx]++;
+            }
+            if (inside && (++rx == cell_w)) {
+                rx = 0;
+                cx++;
+            }
+        }
+        kp.write(XF_ORB_END_OF_ROW);
+
+        if (inside_row && (++ry == cell_h)) ry = 0;
+    }
+}
+
+/**
+ * Orientation of the keypoint at column col of the center row of the window:
+ * intensity centroid over a disc of radius XF_ORB_HALF_PATCH, returned as the
+ * cosine and sine of the angle and the angle in degrees.
+ */
+template <int WIN_ROWS, int COLS>
+void xFOrbOrientation(unsigned char buf[WIN_ROWS][COLS],
+                      int bank[WIN_ROWS],
+                      int col,
+                      ap_fixed<18, 2, AP_RND>& a,
+                      ap_fixed<18, 2, AP_RND>& b,
+                      int& angle) {
+    const int HALF = XF_ORB_HALF_PATCH;
+    const int CENTER = WIN_ROWS >> 1;
+    int m10 = 0;
+    int m01 = 0;
+
+MomentLoop:
+    for (int dx = -HALF; dx <= HALF; dx++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        int sum = 0;
+        int wsum = 0;
+        for (int dy = -HALF; dy <= HALF; dy++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            int v = (dx * dx + dy * dy <= HALF * HALF) ? (int)buf[bank[CENTER + dy]][col + dx] : 0;
+            sum += v;
+            wsum += dy * v;
+        }
+        m10 += dx * sum;
+        m01 += wsum;
+    }
+
+    float fx = m10;
+    float fy = m01;
+    float norm = hls::sqrt(fx * fx + fy * fy);
+    if (norm > 0) {
+        a = fx / norm;
+        b = fy / norm;
+    } else {
+        a = 1;
+        b = 0;
+    }
+    float deg = hls::atan2(fy, fx) * 57.29578f;
+    angle = (deg < 0) ? (int)(deg + 360.5f) : (int)(deg + 0.5f);
+    if (angle >= 360) angle -= 360;
+}
+
+/**
+ * Oriented FAST and rotated BRIEF: orientation and 256 bit descriptor of the
+ * keypoints of orbKeypoints, on a smoothed image, e.g. a 7x7 GaussianBlur.
+ *
+ * The image streams through a window of 2 * XF_ORB_BORDER + 1 rows. Once a
+ * row is centered in the window, its keypoints are read from kp_in up to the
+ * XF_ORB_END_OF_ROW word, and each one is written to kp_out (orbPackKeypoint,
+ * with the given pyramid level) and desc_out. Bit i of a descriptor is set
+ * when the first point of test i is darker than the second one, both rotated
+ * by the orientation. kp_out ends with XF_ORB_END_OF_LIST.
+ *
+ * Each keypoint takes about 2 * XF_ORB_HALF_PATCH + XF_ORB_DESC_BITS cycles on
+ * top of the one cycle per pixel of the image.
+ */
+template <int ROWS, int COLS>
+void orbDescriptors(xf::cv::Mat<XF_8UC1, ROWS, COLS, XF_NPPC1>& src,
+                    hls::stream<ap_uint<32> >& kp_in,
+                    hls::stream<ap_uint<64> >& kp_out,
+                    hls::stream<ap_uint<XF_ORB_DESC_BITS> >& desc_out,
+                    int level) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert(((src.rows <= ROWS) && (src.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+#endif
+    const int WIN_ROWS = 2 * XF_ORB_BORDER + 1;
+
+    unsigned char buf[WIN_ROWS][COLS];
+    int bank[WIN_ROWS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=bank complete dim=0
+    // clang-format on
+
+    int rows = src.rows;
+    int cols = src.cols;
+    int rd = 0;
+    int wr_bank = 0;
+
+RowLoop:
+    for (int i = 0; i < rows + XF_ORB_BORDER; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+    // clang-format on
+    ReadLoop:
+        for (int j = 0; j < cols; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS max=COLS
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            buf[wr_bank][j] = (i < rows) ? (unsigned char)src.read(rd++) : (unsigned char)0;
+        }
+
+        // Banks of the rows i - 2 * XF_ORB_BORDER to i, the center row is i - XF_ORB_BORDER
+        for (int k = 0; k < WIN_ROWS; k++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            int b = wr_bank + 1 + k;
+            bank[k] = (b >= WIN_ROWS) ? b - WIN_ROWS : b;
+        }
+        wr_bank = (wr_bank == WIN_ROWS - 1) ? 0 : wr_bank + 1;
+
+        int r = i - XF_ORB_BORDER;
+        if (r < 0) continue;
+
+    KeypointLoop:
+        for (ap_uint<32> p = kp_in.read(); p != XF_ORB_END_OF_ROW; p = kp_in.read()) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=0 max=16
+            // clang-format on
+            int col = p.range(15, 0);
+
+            ap_fixed<18, 2, AP_RND> a, b;
+            int angle;
+            xFOrbOrientation<WIN_ROWS, COLS>(buf, bank, col, a, b, angle);
+
+            ap_uint<XF_ORB_DESC_BITS> desc;
+        TestLoop:
+            for (int t = 0; t < XF_ORB_DESC_BITS; t++) {
+// clang-format off
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                int v[2];
+                for (int q = 0; q < 2; q++) {
+                    ap_int<5> x = xFOrbPattern[t][2 * q];
+                    ap_int<5> y = xFOrbPattern[t][2 * q + 1];
+                    ap_fixed<7, 7, AP_RND> dx = x * a - y * b;
+                    ap_fixed<7, 7, AP_RND> dy = x * b + y * a;
+                    int ix = dx.to_int();
+                    int iy = dy.to_int();
+                    if (ix < -XF_ORB_BORDER) ix = -XF_ORB_BORDER;
+                    if (ix > XF_ORB_BORDER) ix = XF_ORB_BORDER;
+                    if (iy < -XF_ORB_BORDER) iy = -XF_ORB_BORDER;
+                    if (iy > XF_ORB_BORDER) iy = XF_ORB_BORDER;
+                    v[q] = buf[bank[XF_ORB_BORDER + iy]][col + ix];
+                }
+                desc[t] = (v[0] < v[1]) ? 1 : 0;
+            }
+
+            kp_out.write(orbPackKeypoint(r, col, level, angle));
+            desc_out.write(desc);
+        }
+    }
+
+    kp_out.write(XF_ORB_END_OF_LIST);
+}
+
+/**
+ * Number of differing bits of two descriptors.
+ */
+inline ap_uint<9> orbHamming(ap_uint<XF_ORB_DESC_BITS> a, ap_uint<XF_ORB_DESC_BITS> b) {
+    ap_uint<XF_ORB_DESC_BITS> x = a ^ b;
+    ap_uint<9> n = 0;
+    for (int i = 0; i < XF_ORB_DESC_BITS; i++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        n += x[i];
+    }
+    return n;
+}
+
+/**
+ * Brute force Hamming matcher with Lowe's ratio test. The ntrain train
+ * descriptors are buffered first, then each of the nquery query descriptors is
+ * compared with PARALLEL of them per cycle. A query is matched to its nearest
+ * train descriptor when the distance is at most max_dist and lower than ratio
+ * times the distance to the second nearest one.
+ *
+ * matches gets one word per accepted match: query index [15:0], train index
+ * [31:16], distance [47:32] and second distance [63:48], then
+ * XF_ORB_END_OF_LIST.
+ */
+template <int MAX_TRAIN, int PARALLEL>
+void orbMatch(hls::stream<ap_uint<XF_ORB_DESC_BITS> >& query,
+              int nquery,
+              hls::stream<ap_uint<XF_ORB_DESC_BITS> >& train,
+              int ntrain,
+              hls::stream<ap_uint<64> >& matches,
+              int max_dist,
+              float ratio) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert((ntrain <= MAX_TRAIN) && "Too many train descriptors");
+    assert((MAX_TRAIN % PARALLEL == 0) && "MAX_TRAIN must be a multiple of PARALLEL");
+    assert((ratio > 0.0f) && (ratio <= 1.0f) && "ratio must be in (0, 1]");
+#endif
+    const int DEPTH = MAX_TRAIN / PARALLEL;
+
+    ap_uint<XF_ORB_DESC_BITS> tbuf[PARALLEL][DEPTH];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=tbuf complete dim=1
+    // clang-format on
+
+    ap_ufixed<10, 1, AP_RND> r = ratio;
+
+TrainLoop:
+    for (int t = 0; t < ntrain; t++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAX_TRAIN
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        tbuf[t % PARALLEL][t / PARALLEL] = train.read();
+    }
+
+    int steps = (ntrain + PARALLEL - 1) / PARALLEL;
+
+QueryLoop:
+    for (int q = 0; q < nquery; q++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAX_TRAIN
+        // clang-format on
+        ap_uint<XF_ORB_DESC_BITS> d = query.read();
+
+        ap_uint<10> best[PARALLEL];
+        ap_uint<10> second[PARALLEL];
+        ap_uint<16> idx[PARALLEL];
+// clang-format off
+        #pragma HLS ARRAY_PARTITION variable=best complete dim=0
+        #pragma HLS ARRAY_PARTITION variable=second complete dim=0
+        #pragma HLS ARRAY_PARTITION variable=idx complete dim=0
+        // clang-format on
+        for (int l = 0; l < PARALLEL; l++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            best[l] = XF_ORB_DESC_BITS + 1;
+            second[l] = XF_ORB_DESC_BITS + 1;
+            idx[l] = 0;
+        }
+
+    CompareLoop:
+        for (int s = 0; s < steps; s++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=DEPTH
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            for (int l = 0; l < PARALLEL; l++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                if (s * PARALLEL + l < ntrain) {
+                    ap_uint<10> h = orbHamming(d, tbuf[l][s]);
+                    if (h < best[l]) {
+                        second[l] = best[l];
+                        best[l] = h;
+                        idx[l] = s * PARALLEL + l;
+                    } else if (h < second[l]) {
+                        second[l] = h;
+                    }
+                }
+            }
+        }
+
+        // Nearest and second nearest over the lanes
+        ap_uint<10> b1 = best[0];
+        ap_uint<10> b2 = second[0];
+        ap_uint<16> bi = idx[0];
+        for (int l = 1; l < PARALLEL; l++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            if (best[l] < b1) {
+                b2 = (b1 < second[l]) ? b1 : second[l];
+                b1 = best[l];
+                bi = idx[l];
+            } else {
+                b2 = (best[l] < b2) ? best[l] : b2;
+            }
+        }
+
+        if ((b1 <= max_dist) && (b1 < r * b2)) {
+            ap_uint<64> m;
+            m.range(15, 0) = q;
+            m.range(31, 16) = bi;
+            m.range(47, 32) = b1;
+            m.range(63, 48) = b2;
+            matches.write(m);
+        }
+    }
+
+    matches.write(XF_ORB_END_OF_LIST);
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_ORB_HPP_
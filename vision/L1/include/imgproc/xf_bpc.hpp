@@ -54,7 +54,7 @@ namespace cv {
 #define COL_IDX_T uint16_t // Support upto 65,535
 #define ROW_IDX_T uint16_t // Support upto 65,535
 #define SIZE_IDX_T uint32_t
-#define _DST_T XF_8UC1
+#define _DST_T SRC_T // Same depth as the source, e.g. 8 to 16 bit raw images
 
 // Some internal constants
 #define _NPPC (XF_NPIXPERCYCLE(NPPC))       // Number of pixel per clock to be processed
@@ -168,10 +168,10 @@ COL_LOOP:
 #pragma HLS LOOP_TRIPCOUNT min = 1 max = _TC
         //#pragma HLS LOOP_FLATTEN OFF
 
-        // Fetch next row of source image and store in internal RAMs
+        // Fetch next row of source image and store in internal RAMs, zeros below the image
         // .........................................................
-        if ((r < _src.rows) && (c < num_clks_per_row)) {
-            buff.val[row_idx.val[K_ROWS - 1]][c] = _src.read(rd_ptr++);
+        if (c < num_clks_per_row) {
+            buff.val[row_idx.val[K_ROWS - 1]][c] = (r < _src.rows) ? _src.read(rd_ptr++) : (XF_TNAME(SRC_T, NPPC))0;
         }
 
     // Fetch data from RAMs and store in 'src_blk' for processing
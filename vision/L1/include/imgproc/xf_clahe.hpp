@@ -0,0 +1,417 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_CLAHE_HPP_
+#define _XF_CLAHE_HPP_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+
+#define XF_CLAHE_BINS 256
+// Fractional bits of the reciprocals used for the exact divisions of clahe
+#define XF_CLAHE_RECIP_BITS 52
+
+namespace xf {
+namespace cv {
+
+/**
+ * Tile size of the clahe grid, the tile width is a multiple of the NPC so
+ * that all pixels of a clock are in the same tile. The last row and column of
+ * tiles may be smaller.
+ */
+template <int TILES_Y, int TILES_X, int NPC>
+void claheTileSize(int rows, int cols, int& th, int& tw) {
+    th = (rows + TILES_Y - 1) / TILES_Y;
+    tw = (cols + TILES_X - 1) / TILES_X;
+    tw = ((tw + XF_NPIXPERCYCLE(NPC) - 1) / XF_NPIXPERCYCLE(NPC)) * XF_NPIXPERCYCLE(NPC);
+}
+
+/**
+ * ceil(2^XF_CLAHE_RECIP_BITS / d). xFClaheDivide(n, r) is then exactly
+ * floor(n / d) for n * d <= 2^XF_CLAHE_RECIP_BITS.
+ */
+static inline ap_uint<64> xFClaheReciprocal(ap_uint<32> d) {
+    return ((((ap_uint<64>)1) << XF_CLAHE_RECIP_BITS) + d - 1) / d;
+}
+
+static inline ap_uint<16> xFClaheDivide(ap_uint<32> n, ap_uint<64> r) {
+    ap_uint<64> q = n * r;
+    return q >> XF_CLAHE_RECIP_BITS;
+}
+
+/**
+ * Tile LUTs from the TILES_Y x TILES_X histograms of the previous frame, read
+ * from hist_in tile after tile in raster order. As in OpenCV, the bins are
+ * clipped to clip_limit times the mean bin count of the tile, the clipped
+ * counts are spread over all bins and the LUT is the cumulative histogram
+ * scaled to [0, 255]. Tiles with an empty histogram, e.g. for the first
+ * frame, get the identity LUT. The LUTs are copied to every pixel lane and
+ * split in four banks by the parity of the tile row and column.
+ */
+template <int TILES_Y, int TILES_X, int NPPC, int LUT_SIZE>
+void xFClaheLut(hls::stream<unsigned int>& hist_in,
+                ap_uint<8> lut[NPPC][4][LUT_SIZE],
+                int rows,
+                int cols,
+                int th,
+                int tw,
+                float clip_limit) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    const int TXH = (TILES_X + 1) / 2;
+
+    unsigned int clipped[XF_CLAHE_BINS];
+
+    // Tile areas for the inner tiles and the smaller last row and column of tiles
+    unsigned int area[2][2];
+    ap_uint<64> recip[2][2];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=area complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=recip complete dim=0
+    // clang-format on
+    int th_last = rows - (TILES_Y - 1) * th;
+    int tw_last = cols - (TILES_X - 1) * tw;
+    for (int ly = 0; ly < 2; ly++) {
+        for (int lx = 0; lx < 2; lx++) {
+            area[ly][lx] = (ly ? th_last : th) * (lx ? tw_last : tw);
+            recip[ly][lx] = xFClaheReciprocal(2 * area[ly][lx]);
+        }
+    }
+    unsigned int clip_q8 = (clip_limit > 0.0f) ? (unsigned int)(clip_limit * 256.0f + 0.5f) : 0;
+
+TileRowLoop:
+    for (int ty = 0; ty < TILES_Y; ty++) {
+    TileColLoop:
+        for (int tx = 0; tx < TILES_X; tx++) {
+            int ly = (ty == TILES_Y - 1);
+            int lx = (tx == TILES_X - 1);
+            unsigned int a = area[ly][lx];
+            unsigned int limit = clip_q8 ? (unsigned int)(((ap_uint<64>)clip_q8 * a) >> 16) : a;
+            if (limit < 1) limit = 1;
+
+            unsigned int count = 0;
+            unsigned int excess = 0;
+        ClipLoop:
+            for (int b = 0; b < XF_CLAHE_BINS; b++) {
+// clang-format off
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                unsigned int h = hist_in.read();
+                count += h;
+                if (h > limit) {
+                    excess += h - limit;
+                    h = limit;
+                }
+                clipped[b] = h;
+            }
+
+            // The clipped counts go to all bins, the remainder to evenly spaced bins
+            unsigned int batch = excess / XF_CLAHE_BINS;
+            int residual = excess % XF_CLAHE_BINS;
+            int step = residual ? XF_CLAHE_BINS / residual : XF_CLAHE_BINS;
+            int next = 0;
+            unsigned int cdf = 0;
+
+            int bank = ((ty & 1) << 1) | (tx & 1);
+            int base = ((ty >> 1) * TXH + (tx >> 1)) * XF_CLAHE_BINS;
+
+        CdfLoop:
+            for (int b = 0; b < XF_CLAHE_BINS; b++) {
+// clang-format off
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                unsigned int h = clipped[b] + batch;
+                if ((b == next) && (residual > 0)) {
+                    h++;
+                    next += step;
+                    residual--;
+                }
+                cdf += h;
+
+                // round(cdf * 255 / area)
+                ap_uint<16> l = xFClaheDivide(2 * cdf * (XF_CLAHE_BINS - 1) + a, recip[ly][lx]);
+                if (l > XF_CLAHE_BINS - 1) l = XF_CLAHE_BINS - 1;
+                if (count == 0) l = b;
+
+                for (int p = 0; p < NPPC; p++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    lut[p][bank][base + b] = l;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Contrast limited adaptive histogram equalization of an 8 bit gray image in
+ * a single streaming pass, for video.
+ *
+ * Each pixel is mapped with the bilinear interpolation of the LUTs of the four
+ * nearest tiles of a TILES_Y x TILES_X grid, with the tile centers and
+ * weights of OpenCV. The LUTs are built by xFClaheLut from the histograms of
+ * the previous frame, read from hist_in: TILES_Y * TILES_X * XF_CLAHE_BINS
+ * counts, tile after tile in raster order. A stream of zeros, e.g. for the
+ * first frame, leaves the image unchanged. The histograms of the current frame
+ * are written to hist_out in the same layout, a row of tiles being sent while
+ * the next one is processed. clip_limit is relative to the mean bin count of a
+ * tile, 0 disables the clipping.
+ */
+template <int SRC_T, int ROWS, int COLS, int NPC, int TILES_Y, int TILES_X>
+void clahe(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src,
+           xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& dst,
+           hls::stream<unsigned int>& hist_in,
+           hls::stream<unsigned int>& hist_out,
+           float clip_limit) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+    const int NPPC = XF_NPIXPERCYCLE(NPC);
+    const int TXH = (TILES_X + 1) / 2;
+    const int LUT_SIZE = ((TILES_Y + 1) / 2) * TXH * XF_CLAHE_BINS;
+    const int HIST_SIZE = TILES_X * XF_CLAHE_BINS;
+
+    int rows = src.rows;
+    int cols = src.cols;
+    int th, tw;
+    claheTileSize<TILES_Y, TILES_X, NPC>(rows, cols, th, tw);
+
+#ifndef __SYNTHESIS__
+    assert(((src.rows == dst.rows) && (src.cols == dst.cols)) && "Input and output image should be of same size");
+    assert(((rows <= ROWS) && (cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((SRC_T == XF_8UC1) && "Type must be XF_8UC1");
+    assert(((NPC == XF_NPPC1) || (NPC == XF_NPPC2) || (NPC == XF_NPPC4) || (NPC == XF_NPPC8)) &&
+           "NPC must be XF_NPPC1, XF_NPPC2, XF_NPPC4 or XF_NPPC8");
+    assert((cols % NPPC == 0) && "Image width must be a multiple of NPC");
+    assert(((TILES_Y - 1) * th < rows) && ((TILES_X - 1) * tw < cols) && "Image too small for the tile grid");
+    assert((tw >= 2 * NPPC) && "Tiles must be at least 2 NPC wide");
+    assert((th * tw <= (1 << 20)) && "Tiles must be at most 2^20 pixels");
+#endif
+
+    // Tile LUTs, one copy per pixel lane, banked so that the four tiles around a pixel are in different banks
+    ap_uint<8> lut[NPPC][4][LUT_SIZE];
+    // Histograms of a row of tiles, two per lane for the even and odd words, swapped at each row of tiles
+    unsigned int hist0[2 * NPPC][HIST_SIZE];
+    unsigned int hist1[2 * NPPC][HIST_SIZE];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=lut complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=lut complete dim=2
+    #pragma HLS ARRAY_PARTITION variable=hist0 complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=hist1 complete dim=1
+    // clang-format on
+
+    xFClaheLut<TILES_Y, TILES_X, NPPC, LUT_SIZE>(hist_in, lut, rows, cols, th, tw, clip_limit);
+
+InitLoop:
+    for (int a = 0; a < HIST_SIZE; a++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        for (int k = 0; k < 2 * NPPC; k++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            hist0[k][a] = 0;
+            hist1[k][a] = 0;
+        }
+    }
+
+    int width = cols >> XF_BITSHIFT(NPC);
+    int tw_clk = tw >> XF_BITSHIFT(NPC);
+
+    // Interpolation in half pixel units, the weights of a pixel sum to d
+    ap_uint<32> d = 4 * th * tw;
+    ap_uint<64> recip = xFClaheReciprocal(d);
+
+    // Tile above the pixel, -1 above the first tile center, and distance to its center
+    int ty1 = -1;
+    int ny = th;
+
+    bool cur = 0;
+    int drain = HIST_SIZE;
+    int hy_end = th;
+
+RowLoop:
+    for (int i = 0; i < rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+        // clang-format on
+        int ty_lo = (ty1 < 0) ? 0 : ty1;
+        int ty_hi = (ty1 + 1 > TILES_Y - 1) ? TILES_Y - 1 : ty1 + 1;
+        int row_base[2];
+        int tx1[NPPC];
+        int nx[NPPC];
+// clang-format off
+        #pragma HLS ARRAY_PARTITION variable=row_base complete dim=0
+        #pragma HLS ARRAY_PARTITION variable=tx1 complete dim=0
+        #pragma HLS ARRAY_PARTITION variable=nx complete dim=0
+        // clang-format on
+        for (int py = 0; py < 2; py++) {
+            int t = ((ty_lo & 1) == py) ? ty_lo : ty_hi;
+            row_base[py] = (t >> 1) * TXH;
+        }
+        for (int p = 0; p < NPPC; p++) {
+            tx1[p] = -1;
+            nx[p] = 2 * p + tw;
+        }
+        int hx = 0;
+        int cx = 0;
+
+    // Two words per iteration, as in xFHistogramKernel, each one with its own histograms
+    ColLoop:
+        for (int j = 0; j < width; j += 2) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS/NPC/2 max=COLS/NPC/2
+            #pragma HLS PIPELINE II=2
+            // clang-format on
+            for (int w = 0; w < 2; w++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                if ((w == 0) || (j + 1 < width)) {
+                    XF_TNAME(SRC_T, NPC) in = src.read(i * width + j + w);
+                    XF_TNAME(SRC_T, NPC) out;
+
+                    for (int p = 0; p < NPPC; p++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        ap_uint<8> v = in.range(p * 8 + 7, p * 8);
+
+                        // One read per bank for the four tiles around the pixel
+                        int tx_lo = (tx1[p] < 0) ? 0 : tx1[p];
+                        int tx_hi = (tx1[p] + 1 > TILES_X - 1) ? TILES_X - 1 : tx1[p] + 1;
+                        ap_uint<8> val[2][2];
+                        for (int py = 0; py < 2; py++) {
+                            for (int px = 0; px < 2; px++) {
+                                int t = ((tx_lo & 1) == px) ? tx_lo : tx_hi;
+                                val[py][px] = lut[p][2 * py + px][(row_base[py] + (t >> 1)) * XF_CLAHE_BINS + v];
+                            }
+                        }
+                        ap_uint<8> l00 = val[ty_lo & 1][tx_lo & 1];
+                        ap_uint<8> l01 = val[ty_lo & 1][tx_hi & 1];
+                        ap_uint<8> l10 = val[ty_hi & 1][tx_lo & 1];
+                        ap_uint<8> l11 = val[ty_hi & 1][tx_hi & 1];
+
+                        ap_uint<32> top = l00 * (2 * tw - nx[p]) + l01 * nx[p];
+                        ap_uint<32> bottom = l10 * (2 * tw - nx[p]) + l11 * nx[p];
+                        ap_uint<32> n = top * (2 * th - ny) + bottom * ny + (d >> 1);
+                        out.range(p * 8 + 7, p * 8) = xFClaheDivide(n, recip);
+
+                        nx[p] += 2 * NPPC;
+                        if (nx[p] >= 2 * tw) {
+                            nx[p] -= 2 * tw;
+                            tx1[p]++;
+                        }
+
+                        // Histogram of the current frame
+                        int h = 2 * p + w;
+                        int a = hx * XF_CLAHE_BINS + v;
+                        if (cur)
+                            hist1[h][a] = hist1[h][a] + 1;
+                        else
+                            hist0[h][a] = hist0[h][a] + 1;
+                    }
+
+                    dst.write(i * width + j + w, out);
+
+                    if (++cx == tw_clk) {
+                        cx = 0;
+                        hx++;
+                    }
+                }
+            }
+
+            // Sends one bin of the previous row of tiles per iteration
+            if (drain < HIST_SIZE) {
+                unsigned int s = 0;
+                for (int k = 0; k < 2 * NPPC; k++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    if (cur) {
+                        s += hist0[k][drain];
+                        hist0[k][drain] = 0;
+                    } else {
+                        s += hist1[k][drain];
+                        hist1[k][drain] = 0;
+                    }
+                }
+                hist_out.write(s);
+                drain++;
+            }
+        }
+
+        ny += 2;
+        if (ny >= 2 * th) {
+            ny -= 2 * th;
+            ty1++;
+        }
+
+        if ((i == hy_end - 1) || (i == rows - 1)) {
+        // Rest of the previous row of tiles, when the tiles are too small to send it in time
+        FlushLoop:
+            for (; drain < HIST_SIZE; drain++) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=0 max=HIST_SIZE
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                unsigned int s = 0;
+                for (int k = 0; k < 2 * NPPC; k++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    if (cur) {
+                        s += hist0[k][drain];
+                        hist0[k][drain] = 0;
+                    } else {
+                        s += hist1[k][drain];
+                        hist1[k][drain] = 0;
+                    }
+                }
+                hist_out.write(s);
+            }
+            cur = !cur;
+            drain = 0;
+            hy_end += th;
+        }
+    }
+
+// Last row of tiles
+LastLoop:
+    for (int a = 0; a < HIST_SIZE; a++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        unsigned int s = 0;
+        for (int k = 0; k < 2 * NPPC; k++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            s += cur ? hist0[k][a] : hist1[k][a];
+        }
+        hist_out.write(s);
+    }
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_CLAHE_HPP_
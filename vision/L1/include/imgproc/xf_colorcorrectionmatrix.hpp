@@ -0,0 +1,110 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_COLORCORRECTIONMATRIX_HPP_
+#define _XF_COLORCORRECTIONMATRIX_HPP_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+
+namespace xf {
+namespace cv {
+
+/**
+ * Color correction of a 3 channel image: dst[c] = sum_k ccm[3 * c + k] * src[k]
+ * + offset[c], saturated to the range of the output type. The matrix is in the
+ * channel order of the image, e.g. BGR for the output of demosaicing, and its
+ * coefficients must be in [-8, 8).
+ */
+template <int SRC_T, int DST_T, int ROWS, int COLS, int NPC = 1>
+void colorcorrectionmatrix(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src,
+                           xf::cv::Mat<DST_T, ROWS, COLS, NPC>& dst,
+                           float ccm[9],
+                           float offset[3]) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert(((src.rows == dst.rows) && (src.cols == dst.cols)) && "Input and output image should be of same size");
+    assert(((src.rows <= ROWS) && (src.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((XF_CHANNELS(SRC_T, NPC) == 3) && (XF_CHANNELS(DST_T, NPC) == 3) && "Only 3 channel images");
+#endif
+    const int IN_BITS = XF_DTPIXELDEPTH(SRC_T, NPC);
+    const int OUT_BITS = XF_DTPIXELDEPTH(DST_T, NPC);
+    const int OUT_MAX = (1 << OUT_BITS) - 1;
+
+    ap_fixed<20, 4, AP_RND> m[3][3];
+    ap_fixed<OUT_BITS + 9, OUT_BITS + 1, AP_RND> o[3];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=m complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=o complete dim=0
+    // clang-format on
+
+    for (int c = 0; c < 3; c++) {
+        for (int k = 0; k < 3; k++) {
+// clang-format off
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            m[c][k] = ccm[3 * c + k];
+        }
+        o[c] = offset[c];
+    }
+
+    int width = src.cols >> XF_BITSHIFT(NPC);
+
+RowLoop:
+    for (int i = 0; i < src.rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+    // clang-format on
+    ColLoop:
+        for (int j = 0; j < width; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS/NPC max=COLS/NPC
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            XF_TNAME(SRC_T, NPC) in = src.read(i * width + j);
+            XF_TNAME(DST_T, NPC) out;
+
+            for (int p = 0; p < XF_NPIXPERCYCLE(NPC); p++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                ap_uint<IN_BITS> x[3];
+                for (int k = 0; k < 3; k++) {
+                    x[k] = in.range((3 * p + k) * IN_BITS + IN_BITS - 1, (3 * p + k) * IN_BITS);
+                }
+                for (int c = 0; c < 3; c++) {
+                    ap_fixed<IN_BITS + 24, IN_BITS + 8, AP_RND> acc = o[c];
+                    for (int k = 0; k < 3; k++) {
+                        acc += m[c][k] * x[k];
+                    }
+                    int v = (acc < 0) ? 0 : ((acc > OUT_MAX) ? OUT_MAX : (int)(acc + (ap_ufixed<2, 0>)0.5));
+                    out.range((3 * p + c) * OUT_BITS + OUT_BITS - 1, (3 * p + c) * OUT_BITS) = v;
+                }
+            }
+
+            dst.write(i * width + j, out);
+        }
+    }
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_COLORCORRECTIONMATRIX_HPP_
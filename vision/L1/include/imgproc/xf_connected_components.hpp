@@ -0,0 +1,275 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_CONNECTED_COMPONENTS_HPP_
+#define _XF_CONNECTED_COMPONENTS_HPP_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+
+// Runs of a row, and labels alive at once: the components of two rows of runs
+#define XF_CCL_RUNS(COLS) (((COLS) + 1) / 2)
+#define XF_CCL_LABELS(COLS) (2 * XF_CCL_RUNS(COLS))
+
+namespace xf {
+namespace cv {
+
+// Words of a blob in the output list
+enum connectedComponentsBlob {
+    XF_CCL_AREA = 0,     // number of pixels
+    XF_CCL_TOP_LEFT,     // row << 16 | col of the bounding box corners
+    XF_CCL_BOTTOM_RIGHT,
+    XF_CCL_CENTROID_X,   // centroid, unsigned 16.16 fixed point
+    XF_CCL_CENTROID_Y,
+    XF_CCL_BLOB_SIZE
+};
+
+template <int LABELS>
+ap_uint<16> xFCclFind(ap_uint<16> parent[LABELS], ap_uint<16> l) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+FindLoop:
+    while (parent[l] != l) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=2
+        // clang-format on
+        l = parent[l];
+    }
+    return l;
+}
+
+/**
+ * Connected components of the nonzero pixels of a mask, with 8-connectivity
+ * as cv::connectedComponentsWithStats, in a single pass over the stream.
+ *
+ * Each row is cut into runs of nonzero pixels. The runs of the previous row,
+ * kept with their label, play the role of the line buffer: a run takes the
+ * label of the runs it touches above, and the labels of the runs it joins are
+ * merged with union-find, their statistics added. A component that has no run
+ * in a row is complete: it is written to blobs, as XF_CCL_BLOB_SIZE words, see
+ * connectedComponentsBlob, when its area is at least min_area, and its label
+ * is freed. Blobs are listed in the order they complete, at most max_blobs of
+ * them, and num is set to their number.
+ *
+ * A row takes cols clock cycles, plus a few per run of the row and of the
+ * previous row, so the labels and the statistics never need a second pass
+ * over the frame and the mask is never stored.
+ */
+template <int SRC_T, int ROWS, int COLS, int NPC>
+void connectedComponents(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src,
+                         unsigned int* blobs,
+                         int& num,
+                         int max_blobs,
+                         int min_area) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+    const int RUNS = XF_CCL_RUNS(COLS);
+    const int LABELS = XF_CCL_LABELS(COLS);
+
+    int rows = src.rows;
+    int cols = src.cols;
+#ifndef __SYNTHESIS__
+    assert(((rows <= ROWS) && (cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((SRC_T == XF_8UC1) && "Input type must be XF_8UC1");
+    assert((NPC == XF_NPPC1) && "NPC must be XF_NPPC1");
+#endif
+
+    // Runs of the previous and of the current row, ping-pong
+    ap_uint<16> run_start[2][RUNS];
+    ap_uint<16> run_end[2][RUNS];
+    ap_uint<16> run_label[2][RUNS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=run_start complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=run_end complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=run_label complete dim=1
+    // clang-format on
+
+    // Union-find forest and statistics of the roots
+    ap_uint<16> parent[LABELS];
+    ap_int<17> last_row[LABELS];
+    ap_uint<32> area[LABELS];
+    ap_uint<16> min_x[LABELS], max_x[LABELS], min_y[LABELS], max_y[LABELS];
+    ap_uint<48> sum_x[LABELS], sum_y[LABELS];
+
+    // Free labels, and labels to free at the end of the row
+    ap_uint<16> free_list[LABELS];
+    ap_uint<16> release[RUNS];
+
+    int num_free = LABELS;
+    int count = 0;
+    int n_prev = 0;
+
+InitLoop:
+    for (int l = 0; l < LABELS; l++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        free_list[l] = LABELS - 1 - l;
+    }
+
+RowLoop:
+    for (int i = 0; i <= rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        // clang-format on
+        bool pp = i & 1;
+        int n_cur = 0;
+
+        // Runs of the row, none after the last one so that every component completes
+        if (i < rows) {
+            bool in_run = false;
+            int start = 0;
+        ColLoop:
+            for (int j = 0; j <= cols; j++) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=COLS max=COLS
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                bool fg = false;
+                if (j < cols) fg = (src.read(i * cols + j) != 0);
+                if (fg && !in_run) start = j;
+                if (!fg && in_run) {
+                    run_start[pp][n_cur] = start;
+                    run_end[pp][n_cur] = j - 1;
+                    n_cur++;
+                }
+                in_run = fg;
+            }
+        }
+
+        // Labels of the runs, from the runs they touch above
+        int n_release = 0;
+        int p = 0;
+    LabelLoop:
+        for (int k = 0; k < n_cur; k++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=RUNS
+            // clang-format on
+            int s = run_start[pp][k];
+            int e = run_end[pp][k];
+
+            // Runs above ending left of s - 1 touch none of the next runs either
+            while ((p < n_prev) && (run_end[!pp][p] + 1 < s)) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=0 max=1
+                // clang-format on
+                p++;
+            }
+
+            bool labeled = false;
+            ap_uint<16> label = 0;
+            int q = p;
+        MergeLoop:
+            while ((q < n_prev) && (run_start[!pp][q] <= e + 1)) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=0 max=2
+                // clang-format on
+                ap_uint<16> r = xFCclFind<LABELS>(parent, run_label[!pp][q]);
+                if (!labeled) {
+                    label = r;
+                    labeled = true;
+                } else if (r != label) {
+                    parent[r] = label;
+                    area[label] += area[r];
+                    if (min_x[r] < min_x[label]) min_x[label] = min_x[r];
+                    if (max_x[r] > max_x[label]) max_x[label] = max_x[r];
+                    if (min_y[r] < min_y[label]) min_y[label] = min_y[r];
+                    sum_x[label] += sum_x[r];
+                    sum_y[label] += sum_y[r];
+                    release[n_release++] = r;
+                }
+                q++;
+            }
+            // The last run touched may also touch the next run
+            if (q > p) p = q - 1;
+
+            int len = e - s + 1;
+            if (!labeled) {
+                label = free_list[--num_free];
+                parent[label] = label;
+                area[label] = len;
+                min_x[label] = s;
+                max_x[label] = e;
+                min_y[label] = i;
+                sum_x[label] = (ap_uint<48>)(s + e) * len / 2;
+                sum_y[label] = (ap_uint<48>)i * len;
+            } else {
+                area[label] += len;
+                if (s < min_x[label]) min_x[label] = s;
+                if (e > max_x[label]) max_x[label] = e;
+                sum_x[label] += (ap_uint<48>)(s + e) * len / 2;
+                sum_y[label] += (ap_uint<48>)i * len;
+            }
+            max_y[label] = i;
+            last_row[label] = i;
+            run_label[pp][k] = label;
+        }
+
+        // Roots of the runs, before the merged labels are freed
+    RootLoop:
+        for (int k = 0; k < n_cur; k++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=RUNS
+            // clang-format on
+            run_label[pp][k] = xFCclFind<LABELS>(parent, run_label[pp][k]);
+        }
+
+        // Components of the previous row with no run in this row are complete
+    CompleteLoop:
+        for (int k = 0; k < n_prev; k++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=RUNS
+            // clang-format on
+            ap_uint<16> r = xFCclFind<LABELS>(parent, run_label[!pp][k]);
+            if (last_row[r] != i) {
+                // Marked so that the other runs of the component skip it
+                last_row[r] = i;
+                release[n_release++] = r;
+                if ((area[r] >= (unsigned int)min_area) && (count < max_blobs)) {
+                    unsigned int* b = blobs + count * XF_CCL_BLOB_SIZE;
+                    b[XF_CCL_AREA] = area[r];
+                    b[XF_CCL_TOP_LEFT] = ((unsigned int)min_y[r] << 16) | min_x[r];
+                    b[XF_CCL_BOTTOM_RIGHT] = ((unsigned int)max_y[r] << 16) | max_x[r];
+                    // Pixel centers, rounded to the nearest 1/65536
+                    b[XF_CCL_CENTROID_X] = (unsigned int)((((ap_uint<64>)sum_x[r] << 17) + area[r]) / (2 * area[r]));
+                    b[XF_CCL_CENTROID_Y] = (unsigned int)((((ap_uint<64>)sum_y[r] << 17) + area[r]) / (2 * area[r]));
+                    count++;
+                }
+            }
+        }
+
+    ReleaseLoop:
+        for (int k = 0; k < n_release; k++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=RUNS
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            free_list[num_free++] = release[k];
+        }
+
+        n_prev = n_cur;
+    }
+
+    num = count;
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_CONNECTED_COMPONENTS_HPP_
@@ -71,11 +71,11 @@ int rb_kernel(T imgblock[5][buf_size], int loop) {
 // clang-format off
     #pragma HLS inline off
     // clang-format on
-    int16_t t1 = (imgblock[0][2 + loop] + imgblock[2][0 + loop] + imgblock[2][4 + loop] + imgblock[4][2 + loop]);
+    int t1 = (imgblock[0][2 + loop] + imgblock[2][0 + loop] + imgblock[2][4 + loop] + imgblock[4][2 + loop]);
     t1 = (t1 * 3) / 2;
-    int16_t t2 = (imgblock[1][1 + loop] + imgblock[1][3 + loop] + imgblock[3][1 + loop] + imgblock[3][3 + loop]);
+    int t2 = (imgblock[1][1 + loop] + imgblock[1][3 + loop] + imgblock[3][1 + loop] + imgblock[3][3 + loop]);
     t2 = t2 * 2;
-    int16_t t3 = (imgblock[2][2 + loop]) * 6;
+    int t3 = (imgblock[2][2 + loop]) * 6;
     int res = (-t1) + (t2) + (t3);
     res /= 8;
     if (res < 0) return 0;
@@ -87,12 +87,12 @@ int rgr_bgb_kernel(T imgblock[5][buf_size], int loop) {
 // clang-format off
     #pragma HLS inline off
     // clang-format on
-    int16_t t1 = imgblock[0][2 + loop] + imgblock[4][2 + loop];
-    int16_t t2 = imgblock[1][1 + loop] + imgblock[1][3 + loop] + imgblock[2][0 + loop] + imgblock[2][4 + loop] +
+    int t1 = imgblock[0][2 + loop] + imgblock[4][2 + loop];
+    int t2 = imgblock[1][1 + loop] + imgblock[1][3 + loop] + imgblock[2][0 + loop] + imgblock[2][4 + loop] +
                  imgblock[3][1 + loop] + imgblock[3][3 + loop];
-    int16_t t3 = imgblock[2][1 + loop] + imgblock[2][3 + loop];
+    int t3 = imgblock[2][1 + loop] + imgblock[2][3 + loop];
     t3 *= 4;
-    int16_t t4 = (imgblock[2][2 + loop]) * 5;
+    int t4 = (imgblock[2][2 + loop]) * 5;
     int res = ((t1) >> 1) - (t2) + (t3) + (t4);
     res /= 8;
     if (res < 0) return 0;
@@ -104,13 +104,13 @@ int rgb_bgr_kernel(T imgblock[5][buf_size], int loop) {
 // clang-format off
     #pragma HLS inline off
     // clang-format on
-    int16_t t1 = (imgblock[2][0 + loop] + imgblock[2][4 + loop]);
+    int t1 = (imgblock[2][0 + loop] + imgblock[2][4 + loop]);
     t1 /= 2;
-    int16_t t2 = imgblock[0][2 + loop] + imgblock[1][1 + loop] + imgblock[1][3 + loop] + imgblock[3][1 + loop] +
+    int t2 = imgblock[0][2 + loop] + imgblock[1][1 + loop] + imgblock[1][3 + loop] + imgblock[3][1 + loop] +
                  imgblock[3][3 + loop] + imgblock[4][2 + loop];
-    int16_t t3 = imgblock[1][2 + loop] + imgblock[3][2 + loop];
+    int t3 = imgblock[1][2 + loop] + imgblock[3][2 + loop];
     t3 *= 4;
-    int16_t t4 = (imgblock[2][2 + loop]) * 5;
+    int t4 = (imgblock[2][2 + loop]) * 5;
     int res = (t1) - (t2) + (t3) + (t4);
     res /= 8;
     if (res < 0) return 0;
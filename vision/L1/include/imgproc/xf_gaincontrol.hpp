@@ -120,6 +120,86 @@ void gaincontrol(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src1, xf::cv::Mat<SRC_T, R
                       XF_DEPTH(SRC_T, NPC), XF_WORDWIDTH(SRC_T, NPC), XF_WORDWIDTH(SRC_T, NPC),
                       (COLS >> XF_BITSHIFT(NPC))>(src1, dst, src1.rows, width);
 }
+/**
+ * Bayer channel (0: B, 1: G, 2: R) of the pixel at (row, col) for the given
+ * Bayer pattern.
+ */
+template <int BFORMAT>
+int xFBayerChannel(int row, int col) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    bool odd_row = row & 1;
+    bool odd_col = col & 1;
+    bool first = (BFORMAT == XF_BAYER_BG) || (BFORMAT == XF_BAYER_RG); // pattern starts with a B or R pixel
+    bool first_b = (BFORMAT == XF_BAYER_BG) || (BFORMAT == XF_BAYER_GB); // first row holds the B pixels
+    if (odd_row == odd_col) {
+        return first ? ((odd_row == first_b) ? 2 : 0) : 1;
+    } else {
+        return first ? 1 : ((odd_row == first_b) ? 2 : 0);
+    }
+}
+
+/**
+ * Gain control with the red, green and blue gains given at run time, e.g.
+ * white balance gains computed from the statistics of the previous frame.
+ * Works for any bit depth, Bayer pattern and pixel parallelism.
+ */
+template <int BFORMAT, int SRC_T, int ROWS, int COLS, int NPC = 1>
+void gaincontrol(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src1,
+                 xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& dst,
+                 float rgain,
+                 float ggain,
+                 float bgain) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert(((src1.rows == dst.rows) && (src1.cols == dst.cols)) && "Input and output image should be of same size");
+    assert(((src1.rows <= ROWS) && (src1.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((rgain < 16.0f) && (ggain < 16.0f) && (bgain < 16.0f) && "Gains must be lower than 16");
+#endif
+    const int BITS = XF_DTPIXELDEPTH(SRC_T, NPC);
+    const int MAXVAL = (1 << BITS) - 1;
+
+    ap_ufixed<16, 4, AP_RND> gain[3];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=gain complete dim=0
+    // clang-format on
+    gain[0] = bgain;
+    gain[1] = ggain;
+    gain[2] = rgain;
+
+    int width = src1.cols >> XF_BITSHIFT(NPC);
+
+RowLoop:
+    for (int i = 0; i < src1.rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+    // clang-format on
+    ColLoop:
+        for (int j = 0; j < width; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS/NPC max=COLS/NPC
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            XF_TNAME(SRC_T, NPC) in = src1.read(i * width + j);
+            XF_TNAME(SRC_T, NPC) out;
+
+            for (int p = 0; p < XF_NPIXPERCYCLE(NPC); p++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                ap_uint<BITS> v = in.range(p * BITS + BITS - 1, p * BITS);
+                ap_ufixed<BITS + 4, BITS + 4> g = v * gain[xFBayerChannel<BFORMAT>(i, j * XF_NPIXPERCYCLE(NPC) + p)];
+                out.range(p * BITS + BITS - 1, p * BITS) = (g > MAXVAL) ? MAXVAL : (int)g;
+            }
+
+            dst.write(i * width + j, out);
+        }
+    }
+}
 }
 }
 #endif //_XF_GC_HPP_
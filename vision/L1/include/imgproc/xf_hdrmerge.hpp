@@ -0,0 +1,110 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_HDRMERGE_HPP_
+#define _XF_HDRMERGE_HPP_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+
+namespace xf {
+namespace cv {
+
+/**
+ * Merges a long and a short exposure of the same raw frame into one linear
+ * frame of higher bit depth. The short exposure is scaled by the exposure
+ * ratio; the long exposure is used alone below t1, the scaled short exposure
+ * above t2, and the two are blended linearly in between. Both exposures have
+ * the same Bayer pattern, the merge is done per pixel.
+ */
+template <int SRC_T, int DST_T, int ROWS, int COLS, int NPC = 1>
+void hdrmerge(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src_long,
+              xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src_short,
+              xf::cv::Mat<DST_T, ROWS, COLS, NPC>& dst,
+              float ratio,
+              int t1,
+              int t2) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert(((src_long.rows == dst.rows) && (src_long.cols == dst.cols) && (src_short.rows == dst.rows) &&
+            (src_short.cols == dst.cols)) &&
+           "Input and output image should be of same size");
+    assert(((src_long.rows <= ROWS) && (src_long.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((XF_CHANNELS(SRC_T, NPC) == 1) && (XF_CHANNELS(DST_T, NPC) == 1) && "Only raw, single channel images");
+    assert((t1 < t2) && "t1 must be lower than t2");
+    assert((ratio >= 1.0f) && (ratio < 256.0f) && "Exposure ratio must be in [1, 256)");
+#endif
+    const int IN_BITS = XF_DTPIXELDEPTH(SRC_T, NPC);
+    const int OUT_BITS = XF_DTPIXELDEPTH(DST_T, NPC);
+    const int OUT_MAX = (1 << OUT_BITS) - 1;
+
+    ap_ufixed<16, 8, AP_RND> r = ratio;
+    ap_ufixed<24, 1, AP_RND> slope = 1.0f / (t2 - t1);
+
+    int width = src_long.cols >> XF_BITSHIFT(NPC);
+
+RowLoop:
+    for (int i = 0; i < src_long.rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+    // clang-format on
+    ColLoop:
+        for (int j = 0; j < width; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS/NPC max=COLS/NPC
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            XF_TNAME(SRC_T, NPC) lp = src_long.read(i * width + j);
+            XF_TNAME(SRC_T, NPC) sp = src_short.read(i * width + j);
+            XF_TNAME(DST_T, NPC) out;
+
+            for (int p = 0; p < XF_NPIXPERCYCLE(NPC); p++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                ap_uint<IN_BITS> l = lp.range(p * IN_BITS + IN_BITS - 1, p * IN_BITS);
+                ap_uint<IN_BITS> s = sp.range(p * IN_BITS + IN_BITS - 1, p * IN_BITS);
+
+                // Weight of the long exposure
+                ap_ufixed<18, 1> w;
+                if (l <= t1) {
+                    w = 1;
+                } else if (l >= t2) {
+                    w = 0;
+                } else {
+                    w = (ap_ufixed<18, 1>)((t2 - l) * slope);
+                }
+
+                ap_ufixed<IN_BITS + 16, IN_BITS + 8> s_lin = s * r;
+                ap_ufixed<IN_BITS + 26, IN_BITS + 9> v = l * w + s_lin * (ap_ufixed<18, 1>)(1 - w);
+                ap_uint<IN_BITS + 9> vi = (ap_uint<IN_BITS + 9>)(v + (ap_ufixed<2, 0>)0.5);
+
+                out.range(p * OUT_BITS + OUT_BITS - 1, p * OUT_BITS) = (vi > OUT_MAX) ? OUT_MAX : (int)vi;
+            }
+
+            dst.write(i * width + j, out);
+        }
+    }
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_HDRMERGE_HPP_
@@ -0,0 +1,446 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_HOG_DETECTOR_HPP_
+#define _XF_HOG_DETECTOR_HPP_
+
+#ifndef __cplusplus
+#error C++ is needed to include this header
+#endif
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "imgproc/xf_hog_descriptor_kernel.hpp"
+#include "imgproc/xf_pyr_down.hpp"
+#include "imgproc/xf_svm.hpp"
+
+namespace xf {
+namespace cv {
+
+// Fields of a detection, XF_HOG_DET_SIZE ints per detection
+enum hogDetection {
+    XF_HOG_DET_X = 0, // window in the coordinates of the input frame
+    XF_HOG_DET_Y,
+    XF_HOG_DET_WIDTH,
+    XF_HOG_DET_HEIGHT,
+    XF_HOG_DET_SCORE, // SVM score in Q16.16
+    XF_HOG_DET_SIZE
+};
+
+// Fraction bits of the SVM scores, bias and threshold
+#define XF_HOG_SCORE_FRAC 16
+
+// Candidate window: score, block column and block row of its top left block, pyramid level
+#define XF_HOG_CAND_SCORE(c) ((ap_int<32>)(c).range(31, 0))
+#define XF_HOG_CAND_BX(c) ((int)(c).range(43, 32))
+#define XF_HOG_CAND_BY(c) ((int)(c).range(55, 44))
+#define XF_HOG_CAND_LEVEL(c) ((int)(c).range(59, 56))
+
+/**
+ * Copies the frame of a pyramid level to the pyrDown input, and its top left
+ * hog_rows x hog_cols, whole cells, to the HOG input.
+ */
+template <int SRC_T, int ROWS, int COLS>
+void xFHOGDetectSplit(xf::cv::Mat<SRC_T, ROWS, COLS, XF_NPPC1>& _src,
+                      hls::stream<XF_TNAME(SRC_T, XF_NPPC1)>& _hog_strm,
+                      xf::cv::Mat<SRC_T, ROWS, COLS, XF_NPPC1>& _pyr_mat,
+                      uint16_t hog_rows,
+                      uint16_t hog_cols) {
+    int idx = 0;
+rowLoop:
+    for (int i = 0; i < _src.rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS
+    // clang-format on
+    colLoop:
+        for (int j = 0; j < _src.cols; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            XF_TNAME(SRC_T, XF_NPPC1) pix = _src.read(idx);
+            if ((i < hog_rows) && (j < hog_cols)) _hog_strm.write(pix);
+            _pyr_mat.write(idx++, pix);
+        }
+    }
+}
+
+/**
+ * Linear SVM over all the windows of a pyramid level, one window per cell.
+ *
+ * The normalized blocks come once each, in raster order. A block is in the
+ * windows of NOVBPW x NOHBPW positions; it adds its dot product with the
+ * weights of each position to the partial score of that window, one window
+ * row per cycle. The partial scores of the NOVBPW window rows still open are
+ * kept, the row of a window in the row of its top block modulo NOVBPW. The
+ * last block of a window, its bottom right one, completes the score: the
+ * window is a candidate when it is above threshold, and the partial score is
+ * cleared for the window NOVBPW rows below.
+ *
+ * The same partial score is updated again NOVBPW cycles later at the
+ * earliest, more than the latency of the adder for the usual windows.
+ */
+template <int NOVBPW, int NOHBPW, int NODPB, int WFRAC, int MAXCAND, int MAXHB, int TC>
+void xFHOGSVMWindows(hls::stream<XF_SNAME(XF_576UW)>& _block_strm,
+                     ap_int<16> weights[NOVBPW][NOHBPW][NODPB],
+                     ap_int<32> bias,
+                     ap_int<32> threshold,
+                     ap_uint<64> cand[MAXCAND],
+                     int base,
+                     int& num,
+                     int level,
+                     uint16_t novb,
+                     uint16_t nohb) {
+    ap_int<48> acc[NOVBPW][MAXHB];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=acc cyclic factor=NOHBPW dim=2
+    // clang-format on
+
+clearRowLoop:
+    for (int r = 0; r < NOVBPW; r++) {
+    clearColLoop:
+        for (int c = 0; c < nohb; c++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=MAXHB
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            acc[r][c] = 0;
+        }
+    }
+
+    int n = base;
+    int slot = 0;
+    XF_SNAME(XF_576UW) block;
+
+blockRowLoop:
+    for (int by = 0; by < novb; by++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=TC
+    // clang-format on
+    blockColLoop:
+        for (int bx = 0; bx < nohb; bx++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=MAXHB
+        // clang-format on
+        windowRowLoop:
+            for (int wy = 0; wy < NOVBPW; wy++) {
+// clang-format off
+                #pragma HLS PIPELINE II=1
+                #pragma HLS DEPENDENCE variable=acc inter false
+                // clang-format on
+                if (wy == 0) block = _block_strm.read();
+
+                int r = (slot < wy) ? slot - wy + NOVBPW : slot - wy;
+
+            windowColLoop:
+                for (int wx = 0; wx < NOHBPW; wx++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    int c = bx - wx;
+                    if ((by >= wy) && (c >= 0)) {
+                        ap_int<48> s = acc[r][c] + xfSVMDot<NODPB, 16, 16, 48>(block, weights[wy][wx]);
+                        if ((wy == NOVBPW - 1) && (wx == NOHBPW - 1)) {
+                            ap_int<32> score = (ap_int<32>)(s >> WFRAC) + bias;
+                            if ((score > threshold) && (n < MAXCAND)) {
+                                ap_uint<64> cw = 0;
+                                cw.range(31, 0) = score;
+                                cw.range(43, 32) = c;
+                                cw.range(55, 44) = by - wy;
+                                cw.range(59, 56) = level;
+                                cand[n++] = cw;
+                            }
+                            acc[r][c] = 0;
+                        } else {
+                            acc[r][c] = s;
+                        }
+                    }
+                }
+            }
+        }
+        slot = (slot == NOVBPW - 1) ? 0 : slot + 1;
+    }
+
+    num = n;
+}
+
+/**
+ * HOG and window scores of one pyramid level, with the next level computed by
+ * pyrDown in the same pass over the frame.
+ */
+template <int PTR_WIDTH,
+          int WIN_HEIGHT,
+          int WIN_WIDTH,
+          int BLOCK_HEIGHT,
+          int BLOCK_WIDTH,
+          int CELL_HEIGHT,
+          int CELL_WIDTH,
+          int NOB,
+          int NOVBPW,
+          int NOHBPW,
+          int NODPB,
+          int WFRAC,
+          int MAXCAND,
+          int IMG_COLOR,
+          int SRC_T,
+          int ROWS,
+          int COLS,
+          bool USE_URAM>
+void xFHOGDetectLevel(ap_uint<PTR_WIDTH>* src,
+                      ap_uint<PTR_WIDTH>* dst,
+                      ap_int<16> weights[NOVBPW][NOHBPW][NODPB],
+                      ap_int<32> bias,
+                      ap_int<32> threshold,
+                      ap_uint<64> cand[MAXCAND],
+                      int base,
+                      int& num,
+                      int level,
+                      int rows,
+                      int cols) {
+    const int MAXHB = (COLS / CELL_WIDTH) - (BLOCK_WIDTH / CELL_WIDTH) + 1;
+    const int MAXVB = (ROWS / CELL_HEIGHT) - (BLOCK_HEIGHT / CELL_HEIGHT) + 1;
+
+    xf::cv::Mat<SRC_T, ROWS, COLS, XF_NPPC1> in_mat(rows, cols);
+    xf::cv::Mat<SRC_T, ROWS, COLS, XF_NPPC1> pyr_in(rows, cols);
+    xf::cv::Mat<SRC_T, ROWS, COLS, XF_NPPC1> pyr_out((rows + 1) >> 1, (cols + 1) >> 1);
+    hls::stream<XF_TNAME(SRC_T, XF_NPPC1)> hog_strm;
+    hls::stream<XF_CTUNAME(SRC_T, XF_NPPC1)> hog_in[IMG_COLOR];
+    hls::stream<XF_SNAME(XF_576UW)> block_strm;
+// clang-format off
+    #pragma HLS STREAM variable=in_mat.data depth=2
+    #pragma HLS STREAM variable=pyr_out.data depth=2
+    // Room for the rows of the pyrDown input while the HOG fills its line buffers
+    #pragma HLS STREAM variable=pyr_in.data depth=COLS*4
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    // The HOG takes whole cells, the pixels beyond are only in the next level
+    uint16_t hog_rows = (rows / CELL_HEIGHT) * CELL_HEIGHT;
+    uint16_t hog_cols = (cols / CELL_WIDTH) * CELL_WIDTH;
+    uint16_t novb = (rows / CELL_HEIGHT) - (BLOCK_HEIGHT / CELL_HEIGHT) + 1;
+    uint16_t nohb = (cols / CELL_WIDTH) - (BLOCK_WIDTH / CELL_WIDTH) + 1;
+
+    xf::cv::Array2xfMat<PTR_WIDTH, SRC_T, ROWS, COLS, XF_NPPC1>(src, in_mat);
+    xFHOGDetectSplit<SRC_T, ROWS, COLS>(in_mat, hog_strm, pyr_in, hog_rows, hog_cols);
+    xFHOGReadFromStream<ROWS, COLS, IMG_COLOR>(hog_strm, hog_in, hog_rows, hog_cols);
+    xFDHOG<WIN_HEIGHT, WIN_WIDTH, CELL_WIDTH, BLOCK_HEIGHT, BLOCK_WIDTH, CELL_HEIGHT, CELL_WIDTH, NOB, ROWS, COLS,
+           XF_8UP, XF_16UP, XF_NPPC1, XF_8UW, XF_576UW, IMG_COLOR, USE_URAM>(hog_in, block_strm, hog_rows, hog_cols);
+    xFHOGSVMWindows<NOVBPW, NOHBPW, NODPB, WFRAC, MAXCAND, MAXHB, MAXVB>(block_strm, weights, bias, threshold, cand,
+                                                                        base, num, level, novb, nohb);
+    xf::cv::pyrDown<SRC_T, ROWS, COLS, XF_NPPC1, USE_URAM>(pyr_in, pyr_out);
+    xf::cv::xfMat2Array<PTR_WIDTH, SRC_T, ROWS, COLS, XF_NPPC1>(pyr_out, dst);
+}
+
+/**
+ * Greedy non-maximum suppression: takes the best remaining candidate and
+ * drops the candidates whose intersection over union with it is above
+ * overlap, in Q0.16, until max_det detections or no candidate is left.
+ */
+template <int WIN_HEIGHT, int WIN_WIDTH, int CELL_HEIGHT, int CELL_WIDTH, int MAXCAND, int MAXDET>
+void xFHOGNMS(ap_uint<64> cand[MAXCAND], int num, ap_uint<17> overlap, int* detections, int& ndet, int max_det) {
+    bool alive[MAXCAND];
+
+initLoop:
+    for (int i = 0; i < num; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAXCAND
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        alive[i] = true;
+    }
+
+    int d = 0;
+detLoop:
+    for (; d < max_det; d++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAXDET
+        // clang-format on
+        int best = -1;
+        ap_int<32> best_score = 0;
+    searchLoop:
+        for (int i = 0; i < num; i++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=MAXCAND
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            ap_int<32> score = XF_HOG_CAND_SCORE(cand[i]);
+            if (alive[i] && ((best < 0) || (score > best_score))) {
+                best = i;
+                best_score = score;
+            }
+        }
+        if (best < 0) break;
+
+        ap_uint<64> b = cand[best];
+        int bl = XF_HOG_CAND_LEVEL(b);
+        int bx0 = (XF_HOG_CAND_BX(b) * CELL_WIDTH) << bl;
+        int by0 = (XF_HOG_CAND_BY(b) * CELL_HEIGHT) << bl;
+        int bx1 = bx0 + (WIN_WIDTH << bl);
+        int by1 = by0 + (WIN_HEIGHT << bl);
+        int* det = detections + d * XF_HOG_DET_SIZE;
+        det[XF_HOG_DET_X] = bx0;
+        det[XF_HOG_DET_Y] = by0;
+        det[XF_HOG_DET_WIDTH] = WIN_WIDTH << bl;
+        det[XF_HOG_DET_HEIGHT] = WIN_HEIGHT << bl;
+        det[XF_HOG_DET_SCORE] = best_score;
+
+    suppressLoop:
+        for (int i = 0; i < num; i++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=MAXCAND
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            ap_uint<64> c = cand[i];
+            int l = XF_HOG_CAND_LEVEL(c);
+            int x0 = (XF_HOG_CAND_BX(c) * CELL_WIDTH) << l;
+            int y0 = (XF_HOG_CAND_BY(c) * CELL_HEIGHT) << l;
+            int x1 = x0 + (WIN_WIDTH << l);
+            int y1 = y0 + (WIN_HEIGHT << l);
+            int iw = ((x1 < bx1) ? x1 : bx1) - ((x0 > bx0) ? x0 : bx0);
+            int ih = ((y1 < by1) ? y1 : by1) - ((y0 > by0) ? y0 : by0);
+            ap_uint<32> inter = ((iw > 0) && (ih > 0)) ? iw * ih : 0;
+            ap_uint<33> uni = (ap_uint<33>)((WIN_WIDTH * WIN_HEIGHT) << (2 * l)) +
+                              (ap_uint<33>)((WIN_WIDTH * WIN_HEIGHT) << (2 * bl)) - inter;
+            if ((i == best) || (((ap_uint<49>)inter << 16) > (ap_uint<50>)uni * overlap)) alive[i] = false;
+        }
+    }
+
+    ndet = d;
+}
+
+/**
+ * Multi-scale HOG + linear SVM detector, e.g. pedestrians with the 64x128
+ * window of Dalal and Triggs.
+ *
+ * Each pyramid level is read once: the HOG blocks stream into the scores of
+ * all its windows, one window per cell, and pyrDown computes the next level,
+ * half the size, in the same pass. Levels are processed until NUM_LEVELS or
+ * until the frame is smaller than the window. The windows above threshold of
+ * all the levels are kept, up to MAXCAND, and only the detections left after
+ * non-maximum suppression are written, in the coordinates of the input
+ * frame, XF_HOG_DET_SIZE ints each.
+ *
+ * src holds the continuous frame, PTR_WIDTH aligned, followed by room for the
+ * NUM_LEVELS smaller levels, each starting on a PTR_WIDTH word. dst is a
+ * second port to the same buffer, for the writes of the levels.
+ *
+ * weights holds the NOVBPW x NOHBPW blocks of the window in raster order, the
+ * NODPB values of a block in the order of HOGDescriptor, as 16-bit with WFRAC
+ * fraction bits. bias and threshold are added to and compared with the dot
+ * product, overlap is the intersection over union above which the weaker of
+ * two detections is dropped.
+ */
+template <int PTR_WIDTH,
+          int WIN_HEIGHT,
+          int WIN_WIDTH,
+          int BLOCK_HEIGHT,
+          int BLOCK_WIDTH,
+          int CELL_HEIGHT,
+          int CELL_WIDTH,
+          int NOB,
+          int NUM_LEVELS,
+          int WFRAC,
+          int MAXCAND,
+          int MAXDET,
+          int IMG_COLOR,
+          int SRC_T,
+          int ROWS,
+          int COLS,
+          bool USE_URAM = false>
+void HOGDetectMultiScale(ap_uint<PTR_WIDTH>* src,
+                         ap_uint<PTR_WIDTH>* dst,
+                         short* weights,
+                         float bias,
+                         float threshold,
+                         float overlap,
+                         int* detections,
+                         int& num,
+                         int max_det,
+                         int rows,
+                         int cols) {
+    const int NOVCPB = BLOCK_HEIGHT / CELL_HEIGHT;
+    const int NOHCPB = BLOCK_WIDTH / CELL_WIDTH;
+    const int NODPB = NOB * NOVCPB * NOHCPB;
+    const int NOVBPW = (WIN_HEIGHT / CELL_HEIGHT) - NOVCPB + 1;
+    const int NOHBPW = (WIN_WIDTH / CELL_WIDTH) - NOHCPB + 1;
+    const int CH = XF_CHANNELS(SRC_T, XF_NPPC1);
+
+#ifndef __SYNTHESIS__
+    assert((NODPB * 16 == 576) && "Only 16x16 blocks of 8x8 cells with 9 bins are supported");
+    assert(((IMG_COLOR == XF_GRAY) || (IMG_COLOR == XF_RGB)) && "IMG_COLOR must be XF_GRAY or XF_RGB");
+    assert((NUM_LEVELS <= 16) && "At most 16 pyramid levels are supported");
+    assert((rows <= ROWS) && (cols <= COLS) && "ROWS and COLS should be greater than input image");
+    assert((max_det <= MAXDET) && "max_det must not be greater than MAXDET");
+#endif
+
+    ap_int<16> w[NOVBPW][NOHBPW][NODPB];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=w complete dim=2
+    #pragma HLS ARRAY_PARTITION variable=w complete dim=3
+    // clang-format on
+
+weightLoop:
+    for (int i = 0; i < NOVBPW * NOHBPW * NODPB; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        int k = i % NODPB;
+        int b = i / NODPB;
+        w[b / NOHBPW][b % NOHBPW][k] = weights[i];
+    }
+
+    ap_fixed<32, 32 - XF_HOG_SCORE_FRAC, AP_RND, AP_SAT> fbias = bias;
+    ap_fixed<32, 32 - XF_HOG_SCORE_FRAC, AP_RND, AP_SAT> fthresh = threshold;
+    ap_int<32> bias_q = fbias.range(31, 0);
+    ap_int<32> thresh_q = fthresh.range(31, 0);
+    ap_uint<17> overlap_q = (ap_uint<17>)(overlap * (1 << 16));
+
+    ap_uint<64> cand[MAXCAND];
+    int ncand = 0;
+    int offset = 0;
+    int lrows = rows;
+    int lcols = cols;
+
+levelLoop:
+    for (int l = 0; l < NUM_LEVELS; l++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=NUM_LEVELS
+        // clang-format on
+        if ((lrows < WIN_HEIGHT) || (lcols < WIN_WIDTH)) break;
+
+        int next = offset + ((lrows * lcols * CH * 8 + PTR_WIDTH - 1) / PTR_WIDTH);
+        int nlevel;
+        xFHOGDetectLevel<PTR_WIDTH, WIN_HEIGHT, WIN_WIDTH, BLOCK_HEIGHT, BLOCK_WIDTH, CELL_HEIGHT, CELL_WIDTH, NOB,
+                         NOVBPW, NOHBPW, NODPB, WFRAC, MAXCAND, IMG_COLOR, SRC_T, ROWS, COLS, USE_URAM>(
+            src + offset, dst + next, w, bias_q, thresh_q, cand, ncand, nlevel, l, lrows, lcols);
+        ncand = nlevel;
+
+        offset = next;
+        lrows = (lrows + 1) >> 1;
+        lcols = (lcols + 1) >> 1;
+    }
+
+    xFHOGNMS<WIN_HEIGHT, WIN_WIDTH, CELL_HEIGHT, CELL_WIDTH, MAXCAND, MAXDET>(cand, ncand, overlap_q, detections, num,
+                                                                             max_det);
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif // _XF_HOG_DETECTOR_HPP_
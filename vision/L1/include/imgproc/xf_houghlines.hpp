@@ -727,6 +727,360 @@ void HoughLines(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& _src_mat,
                  MINTHETA, MAXTHETA>(_src_mat, outputrho, outputtheta, threshold, _src_mat.rows, _src_mat.cols,
                                      linesmax);
 }
+
+/*****************************************************************
+ * 		      Progressive probabilistic Hough transform
+ *****************************************************************/
+// Fraction bits of the line walk, as cv::HoughLinesP
+#define XF_HOUGHP_SHIFT 16
+
+/**
+ * Cosine and sine of the table angle ang, in 1.15 format.
+ */
+static void xfHoughTrig(ap_uint<10> ang, ap_int<16>& c, ap_int<16>& s) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    c.range(15, 0) = cosval[ang].range(15, 0);
+    s.range(15, 0) = sinval[ang].range(15, 0);
+}
+
+/**
+ * Accumulator index of the line through (x, y) with the cosine c and sine s
+ * of its normal, with the origin at the image center as in xfVoting.
+ */
+template <unsigned int rho, int rhoN>
+ap_uint<13> xfHoughRho(ap_int<14> x, ap_int<14> y, ap_int<16> c, ap_int<16> s) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    const int ONE = rho << 15;
+    ap_int<32> v = x * c + y * s + (ONE >> 1);
+    ap_int<32> r = (v >= 0) ? (ap_int<32>)(v / ONE) : (ap_int<32>)(-((-v + ONE - 1) / ONE));
+    return r + rhoN / 2;
+}
+
+static bool xfHoughBit(ap_uint<64>* bits, ap_uint<32> p) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    return bits[p >> 6][p & 63];
+}
+
+static void xfHoughSetBit(ap_uint<64>* bits, ap_uint<32> p, bool v) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    ap_uint<64> w = bits[p >> 6];
+    w[p & 63] = v;
+    bits[p >> 6] = w;
+}
+
+/**
+ * Line segments of a binary edge image, e.g. the output of Canny and
+ * EdgeTracing, with the progressive probabilistic Hough transform of
+ * cv::HoughLinesP.
+ *
+ * The edge pixels are stored in a bit mask and their coordinates in a list of
+ * up to MAXPOINTS points, then taken from the list in a pseudo-random order.
+ * Each point votes in the accumulator of HoughLines, all the angles in one
+ * clock cycle. When the best line through the point reaches threshold votes,
+ * the mask is followed along the line in both directions, across at most
+ * max_gap missing pixels. The segment is kept if it spans at least min_length
+ * pixels horizontally or vertically. The pixels of a kept segment have their
+ * votes removed, and the pixels walked over are removed from the mask either
+ * way. Unlike OpenCV, only the pixels that have voted are removed from the
+ * accumulator, so that the votes never go below 0.
+ *
+ * lines holds x1, y1, x2, y2 for each segment, in the order they are found,
+ * and num is set to their number, at most linesmax.
+ */
+template <unsigned int theta,
+          unsigned int rho,
+          int linesMax,
+          int DIAG,
+          int MINTHETA,
+          int MAXTHETA,
+          int MAXPOINTS,
+          int SRC_T,
+          int ROWS,
+          int COLS,
+          int NPC>
+void xfHoughLinesP(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& _src_mat,
+                   short lines[linesMax][4],
+                   int& num,
+                   short threshold,
+                   short min_length,
+                   short max_gap,
+                   short linesmax) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+    const int AngleN = (2 * (MAXTHETA - MINTHETA)) / theta;
+    const int WORDS = (ROWS * COLS + 63) / 64;
+
+    ap_uint<12> accum[AngleN][DIAG + 1];
+    ap_int<16> cosvals[AngleN];
+    ap_int<16> sinvals[AngleN];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=accum complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=cosvals complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=sinvals complete dim=0
+    #pragma HLS RESOURCE variable=accum core=RAM_T2P_BRAM
+    // clang-format on
+
+    // Edge pixels not used yet, and edge pixels that have voted
+    ap_uint<64> mask[WORDS];
+    ap_uint<64> voted[WORDS];
+    ap_uint<32> points[MAXPOINTS];
+
+    int height = _src_mat.rows;
+    int width = _src_mat.cols;
+    int hei = height / 2;
+    int wdt = width / 2;
+
+loop_init_r:
+    for (int r = 0; r < DIAG + 1; r++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        for (int n = 0; n < AngleN; n++) {
+            accum[n][r] = 0;
+        }
+    }
+
+loop_init:
+    for (int n = 0; n < AngleN; n++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        xfHoughTrig(MINTHETA * 2 + n * theta, cosvals[n], sinvals[n]);
+    }
+
+    // Mask and point list
+    int npoints = 0;
+    int pix = 0;
+    ap_uint<64> word = 0;
+    ap_uint<64> zero = 0;
+LOOPI:
+    for (int i = 0; i < height; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS
+        // clang-format on
+    LOOPJ:
+        for (int j = 0; j < width; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            bool edge = (_src_mat.read(pix) != 0);
+            word[pix & 63] = edge;
+            if (((pix & 63) == 63) || (pix == height * width - 1)) {
+                mask[pix >> 6] = word;
+                voted[pix >> 6] = zero;
+            }
+            if (edge && (npoints < MAXPOINTS)) {
+                ap_uint<32> p;
+                p.range(31, 16) = i;
+                p.range(15, 0) = j;
+                points[npoints++] = p;
+            }
+            pix++;
+        }
+    }
+
+    int count = 0;
+    ap_uint<32> rnd = 0x12345678;
+
+LOOP_POINTS:
+    for (int remaining = npoints; (remaining > 0) && (count < linesmax); remaining--) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAXPOINTS
+        // clang-format on
+        // xorshift32, then a point among the remaining ones
+        rnd ^= rnd << 13;
+        rnd ^= rnd >> 17;
+        rnd ^= rnd << 5;
+        int idx = ((ap_uint<64>)rnd * remaining) >> 32;
+        ap_uint<32> pt = points[idx];
+        points[idx] = points[remaining - 1];
+
+        int x = pt.range(15, 0);
+        int y = pt.range(31, 16);
+        ap_uint<32> p = y * width + x;
+        if (!xfHoughBit(mask, p)) continue;
+        xfHoughSetBit(voted, p, 1);
+
+        // Vote, and keep the first angle with the most votes
+        ap_uint<12> max_val = threshold - 1;
+        int max_n = 0;
+    LOOPN_VOTE:
+        for (int n = 0; n < AngleN; n++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            ap_uint<13> r = xfHoughRho<rho, DIAG>(x - wdt, y - hei, cosvals[n], sinvals[n]);
+            ap_uint<12> a = accum[n][r];
+            if (a != 4095) a++;
+            accum[n][r] = a;
+            if (a > max_val) {
+                max_val = a;
+                max_n = n;
+            }
+        }
+        if (max_val < threshold) continue;
+
+        // Walk along the line, the fastest moving coordinate stepping by 1
+        ap_int<32> a = -sinvals[max_n];
+        ap_int<32> b = cosvals[max_n];
+        ap_int<32> abs_a = (a < 0) ? (ap_int<32>)-a : a;
+        ap_int<32> abs_b = (b < 0) ? (ap_int<32>)-b : b;
+        bool xflag = abs_a > abs_b;
+        ap_int<32> x0, y0, dx0, dy0;
+        if (xflag) {
+            ap_int<48> t = (ap_int<48>)abs_b << XF_HOUGHP_SHIFT;
+            ap_int<32> q = (t + (abs_a >> 1)) / abs_a;
+            dx0 = (a > 0) ? 1 : -1;
+            dy0 = (b < 0) ? (ap_int<32>)-q : q;
+            x0 = x;
+            y0 = (y << XF_HOUGHP_SHIFT) + (1 << (XF_HOUGHP_SHIFT - 1));
+        } else {
+            ap_int<48> t = (ap_int<48>)abs_a << XF_HOUGHP_SHIFT;
+            ap_int<32> q = (t + (abs_b >> 1)) / abs_b;
+            dy0 = (b > 0) ? 1 : -1;
+            dx0 = (a < 0) ? (ap_int<32>)-q : q;
+            x0 = (x << XF_HOUGHP_SHIFT) + (1 << (XF_HOUGHP_SHIFT - 1));
+            y0 = y;
+        }
+
+        int end_x[2], end_y[2];
+        for (int k = 0; k < 2; k++) {
+            ap_int<32> xw = x0, yw = y0;
+            ap_int<32> dx = (k == 0) ? dx0 : (ap_int<32>)-dx0;
+            ap_int<32> dy = (k == 0) ? dy0 : (ap_int<32>)-dy0;
+            int gap = 0;
+            end_x[k] = x;
+            end_y[k] = y;
+        LOOP_WALK:
+            while (true) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                int j1 = xflag ? (int)xw : (int)(xw >> XF_HOUGHP_SHIFT);
+                int i1 = xflag ? (int)(yw >> XF_HOUGHP_SHIFT) : (int)yw;
+                if ((j1 < 0) || (j1 >= width) || (i1 < 0) || (i1 >= height)) break;
+                if (xfHoughBit(mask, i1 * width + j1)) {
+                    gap = 0;
+                    end_x[k] = j1;
+                    end_y[k] = i1;
+                } else if (++gap > max_gap) {
+                    break;
+                }
+                xw += dx;
+                yw += dy;
+            }
+        }
+
+        int len_x = end_x[1] - end_x[0];
+        int len_y = end_y[1] - end_y[0];
+        bool good_line = (len_x >= min_length) || (-len_x >= min_length) || (len_y >= min_length) ||
+                         (-len_y >= min_length);
+
+        // Walk again to the ends, removing the pixels from the mask and their votes
+        for (int k = 0; k < 2; k++) {
+            ap_int<32> xw = x0, yw = y0;
+            ap_int<32> dx = (k == 0) ? dx0 : (ap_int<32>)-dx0;
+            ap_int<32> dy = (k == 0) ? dy0 : (ap_int<32>)-dy0;
+        LOOP_CLEAR:
+            while (true) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS
+                // clang-format on
+                int j1 = xflag ? (int)xw : (int)(xw >> XF_HOUGHP_SHIFT);
+                int i1 = xflag ? (int)(yw >> XF_HOUGHP_SHIFT) : (int)yw;
+                ap_uint<32> q = i1 * width + j1;
+                if (xfHoughBit(mask, q)) {
+                    if (good_line && xfHoughBit(voted, q)) {
+                    LOOPN_UNVOTE:
+                        for (int n = 0; n < AngleN; n++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            ap_uint<13> r = xfHoughRho<rho, DIAG>(j1 - wdt, i1 - hei, cosvals[n], sinvals[n]);
+                            accum[n][r] = accum[n][r] - 1;
+                        }
+                        xfHoughSetBit(voted, q, 0);
+                    }
+                    xfHoughSetBit(mask, q, 0);
+                }
+                if ((i1 == end_y[k]) && (j1 == end_x[k])) break;
+                xw += dx;
+                yw += dy;
+            }
+        }
+
+        if (good_line) {
+            lines[count][0] = end_x[0];
+            lines[count][1] = end_y[0];
+            lines[count][2] = end_x[1];
+            lines[count][3] = end_y[1];
+            count++;
+        }
+    }
+
+    num = count;
+}
+
+/**************************************************************************
+ * HoughLinesP : Probabilistic Hough transform, line segments of an edge
+ * 				image. RHO, THETA, DIAG, MINTHETA and MAXTHETA are the
+ * 				accumulator parameters of HoughLines.
+ *
+ * 				MAXPOINTS = MAXIMUM NUMBER OF EDGE POINTS, THE OTHERS
+ * 				            NEVER START A SEGMENT
+ *
+ * 				lines: x1, y1, x2, y2 of the segments
+ * 				num: number of segments
+ * 				threshold: minimum votes of the line of a segment
+ * 				min_length: minimum length of a segment
+ * 				max_gap: maximum gap between two pixels of a segment
+ *
+ **************************************************************************/
+template <unsigned int RHO,
+          unsigned int THETA,
+          int MAXLINES,
+          int DIAG,
+          int MINTHETA,
+          int MAXTHETA,
+          int MAXPOINTS,
+          int SRC_T,
+          int ROWS,
+          int COLS,
+          int NPC>
+void HoughLinesP(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& _src_mat,
+                 short lines[MAXLINES][4],
+                 int& num,
+                 short threshold,
+                 short min_length,
+                 short max_gap,
+                 short linesmax) {
+// clang-format off
+    #pragma HLS INLINE OFF
+// clang-format on
+#ifndef __SYNTHESIS__
+    assert(((_src_mat.rows <= ROWS) && (_src_mat.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((NPC == XF_NPPC1) && "NPC must be XF_NPPC1");
+
+    assert((((MAXTHETA - MINTHETA) > 0)) && "MINTHETA must be less than MAXTHETA");
+    assert(((MINTHETA >= 0) && (MINTHETA < 180)) && "MINTHETA must be between 0 to 180");
+    assert(((MAXTHETA > 0) && (MAXTHETA <= 180)) && "MAXTHETA must be between 0 to 180");
+    assert(((threshold > 0) && (threshold < 4096)) && "threshold must be between 1 and 4095");
+    assert((linesmax <= MAXLINES) && "linesmax must be at most MAXLINES");
+#endif
+    xfHoughLinesP<THETA, RHO, MAXLINES, DIAG, MINTHETA, MAXTHETA, MAXPOINTS, SRC_T, ROWS, COLS, NPC>(
+        _src_mat, lines, num, threshold, min_length, max_gap, linesmax);
+}
 } // namespace cv
 } // namespace xf
 #endif //_XF_HOUGHLINES_HPP_
@@ -0,0 +1,203 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_ISP_STATS_HPP_
+#define _XF_ISP_STATS_HPP_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+#include "imgproc/xf_gaincontrol.hpp"
+
+#define XF_ISP_HIST_BINS 256
+
+namespace xf {
+namespace cv {
+
+// Layout of the auto exposure and auto white balance statistics, in 8 bit pixel units
+enum ispStatsFields {
+    XF_ISP_STATS_SUM_B = 0, // sums of the non saturated pixels of each Bayer channel
+    XF_ISP_STATS_SUM_G,
+    XF_ISP_STATS_SUM_R,
+    XF_ISP_STATS_CNT_B, // number of non saturated pixels of each Bayer channel
+    XF_ISP_STATS_CNT_G,
+    XF_ISP_STATS_CNT_R,
+    XF_ISP_STATS_HIST, // XF_ISP_HIST_BINS bins histogram of all pixels
+    XF_ISP_STATS_SIZE = XF_ISP_STATS_HIST + XF_ISP_HIST_BINS
+};
+
+/**
+ * Pass through stage collecting the statistics of a raw frame for auto
+ * exposure and auto white balance: the sums and counts of the non saturated
+ * pixels of each Bayer channel and the histogram of the 8 most significant
+ * bits of all pixels. The XF_ISP_STATS_SIZE values are written to stats once
+ * the frame is done, to control the gains and exposure of the next frame.
+ */
+template <int BFORMAT, int SRC_T, int ROWS, int COLS, int NPC = 1>
+void ispstats(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src,
+              xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& dst,
+              hls::stream<unsigned int>& stats,
+              int sat_thresh) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert(((src.rows == dst.rows) && (src.cols == dst.cols)) && "Input and output image should be of same size");
+    assert(((src.rows <= ROWS) && (src.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((XF_CHANNELS(SRC_T, NPC) == 1) && "Only raw, single channel images");
+#endif
+    const int BITS = XF_DTPIXELDEPTH(SRC_T, NPC);
+    const int NPPC = XF_NPIXPERCYCLE(NPC);
+
+    // Two histograms per pixel lane, one for the even and one for the odd
+    // words, so that each one is updated at most every other cycle
+    unsigned int hist[NPPC][XF_ISP_HIST_BINS];
+    unsigned int hist1[NPPC][XF_ISP_HIST_BINS];
+    ap_uint<32> sum[NPPC][3];
+    ap_uint<32> cnt[NPPC][3];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=hist complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=hist1 complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=sum complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=cnt complete dim=0
+    // clang-format on
+
+InitLoop:
+    for (int b = 0; b < XF_ISP_HIST_BINS; b++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        for (int p = 0; p < NPPC; p++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            hist[p][b] = 0;
+            hist1[p][b] = 0;
+        }
+    }
+    for (int p = 0; p < NPPC; p++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        for (int c = 0; c < 3; c++) {
+            sum[p][c] = 0;
+            cnt[p][c] = 0;
+        }
+    }
+
+    int width = src.cols >> XF_BITSHIFT(NPC);
+
+RowLoop:
+    for (int i = 0; i < src.rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+    // clang-format on
+    // Two words per iteration, as in xFHistogramKernel
+    ColLoop:
+        for (int j = 0; j < width; j += 2) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS/NPC/2 max=COLS/NPC/2
+            #pragma HLS PIPELINE II=2
+            // clang-format on
+            bool odd = (j + 1 < width);
+            XF_TNAME(SRC_T, NPC) in = src.read(i * width + j);
+            XF_TNAME(SRC_T, NPC) in1 = 0;
+            dst.write(i * width + j, in);
+            if (odd) {
+                in1 = src.read(i * width + j + 1);
+                dst.write(i * width + j + 1, in1);
+            }
+
+            for (int p = 0; p < NPPC; p++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                ap_uint<BITS> v = in.range(p * BITS + BITS - 1, p * BITS);
+                ap_uint<BITS> v1 = in1.range(p * BITS + BITS - 1, p * BITS);
+                ap_uint<8> v8 = v >> (BITS - 8);
+                ap_uint<8> v18 = v1 >> (BITS - 8);
+                int c = xFBayerChannel<BFORMAT>(i, j * NPPC + p);
+                int c1 = xFBayerChannel<BFORMAT>(i, (j + 1) * NPPC + p);
+
+                if (v < sat_thresh) {
+                    sum[p][c] += v8;
+                    cnt[p][c]++;
+                }
+                if (odd && (v1 < sat_thresh)) {
+                    sum[p][c1] += v18;
+                    cnt[p][c1]++;
+                }
+
+                unsigned int h = hist[p][v8];
+                unsigned int h1 = hist1[p][v18];
+                hist[p][v8] = h + 1;
+                if (odd) hist1[p][v18] = h1 + 1;
+            }
+        }
+    }
+
+    // Reduce the lanes and send the statistics
+    for (int c = 0; c < 3; c++) {
+        ap_uint<32> s = 0;
+        for (int p = 0; p < NPPC; p++) s += sum[p][c];
+        stats.write(s);
+    }
+    for (int c = 0; c < 3; c++) {
+        ap_uint<32> n = 0;
+        for (int p = 0; p < NPPC; p++) n += cnt[p][c];
+        stats.write(n);
+    }
+HistLoop:
+    for (int b = 0; b < XF_ISP_HIST_BINS; b++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        unsigned int n = 0;
+        for (int p = 0; p < NPPC; p++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            n += hist[p][b] + hist1[p][b];
+        }
+        stats.write(n);
+    }
+}
+
+/**
+ * Gray world white balance gains, relative to green, from the statistics of
+ * the previous frame. Returns unit gains when the statistics are empty, e.g.
+ * for the first frame.
+ */
+inline void awbGains(const unsigned int stats[XF_ISP_STATS_SIZE], float& rgain, float& ggain, float& bgain) {
+    float mean[3];
+    for (int c = 0; c < 3; c++) {
+        unsigned int n = stats[XF_ISP_STATS_CNT_B + c];
+        mean[c] = n ? (float)stats[XF_ISP_STATS_SUM_B + c] / n : 0.0f;
+    }
+    bool valid = (mean[0] > 0.0f) && (mean[1] > 0.0f) && (mean[2] > 0.0f);
+    rgain = valid ? mean[1] / mean[2] : 1.0f;
+    ggain = 1.0f;
+    bgain = valid ? mean[1] / mean[0] : 1.0f;
+    // Limit to the range of gaincontrol
+    if (rgain > 15.0f) rgain = 15.0f;
+    if (bgain > 15.0f) bgain = 15.0f;
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_ISP_STATS_HPP_
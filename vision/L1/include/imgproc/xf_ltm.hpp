@@ -0,0 +1,249 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_LTM_HPP_
+#define _XF_LTM_HPP_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+
+// Block statistics of localtonemapping are in 12 bit luminance units
+#define XF_LTM_BITS 12
+
+namespace xf {
+namespace cv {
+
+/**
+ * Block size of the localtonemapping grid, the block width is a multiple of
+ * the NPC so that all pixels of a clock are in the same block.
+ */
+template <int GRID_ROWS, int GRID_COLS, int NPC>
+void ltmBlockSize(int rows, int cols, int& bh, int& bw) {
+    bh = (rows + GRID_ROWS - 1) / GRID_ROWS;
+    bw = (cols + GRID_COLS - 1) / GRID_COLS;
+    bw = ((bw + XF_NPIXPERCYCLE(NPC) - 1) / XF_NPIXPERCYCLE(NPC)) * XF_NPIXPERCYCLE(NPC);
+}
+
+/**
+ * Mean luminance of each block of the grid from the block sums written by
+ * localtonemapping for the previous frame. Blocks without statistics, e.g.
+ * for the first frame, get a quarter of the luminance range.
+ */
+template <int GRID_ROWS, int GRID_COLS, int NPC>
+void ltmGridMeans(const unsigned int sums[GRID_ROWS * GRID_COLS],
+                  int rows,
+                  int cols,
+                  unsigned short lm[GRID_ROWS][GRID_COLS]) {
+    int bh, bw;
+    ltmBlockSize<GRID_ROWS, GRID_COLS, NPC>(rows, cols, bh, bw);
+
+    for (int by = 0; by < GRID_ROWS; by++) {
+        for (int bx = 0; bx < GRID_COLS; bx++) {
+// clang-format off
+            #pragma HLS PIPELINE
+            // clang-format on
+            int h = rows - by * bh;
+            int w = cols - bx * bw;
+            h = (h > bh) ? bh : h;
+            w = (w > bw) ? bw : w;
+            unsigned int s = sums[by * GRID_COLS + bx];
+            lm[by][bx] = ((h > 0) && (w > 0) && (s > 0)) ? (unsigned short)(s / (unsigned int)(h * w))
+                                                          : (unsigned short)(1 << (XF_LTM_BITS - 2));
+        }
+    }
+}
+
+/**
+ * Local tone mapping of a high dynamic range 3 channel image to the bit depth
+ * of the output type. Each pixel is compressed with the Reinhard operator
+ * relative to the mean luminance around it:
+ *     dst[c] = OUT_MAX * src[c] * key / (Lm + key * Y)
+ * where Y = (B + 2G + R) / 4 and Lm is bilinearly interpolated from the
+ * GRID_ROWS x GRID_COLS block means lm of the previous frame (ltmGridMeans).
+ * The block luminance sums of the current frame are written to blk_sums,
+ * GRID_COLS values at the end of each row of blocks.
+ */
+template <int SRC_T, int DST_T, int ROWS, int COLS, int NPC, int GRID_ROWS, int GRID_COLS>
+void localtonemapping(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src,
+                      xf::cv::Mat<DST_T, ROWS, COLS, NPC>& dst,
+                      unsigned short lm[GRID_ROWS][GRID_COLS],
+                      hls::stream<unsigned int>& blk_sums,
+                      float key) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert(((src.rows == dst.rows) && (src.cols == dst.cols)) && "Input and output image should be of same size");
+    assert(((src.rows <= ROWS) && (src.cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((XF_CHANNELS(SRC_T, NPC) == 3) && (XF_CHANNELS(DST_T, NPC) == 3) && "Only 3 channel images");
+    assert((XF_DTPIXELDEPTH(SRC_T, NPC) >= XF_LTM_BITS) && "Input must be at least 12 bits");
+    assert((key > 0.0f) && (key < 4.0f) && "key must be in (0, 4)");
+#endif
+    const int IN_BITS = XF_DTPIXELDEPTH(SRC_T, NPC);
+    const int OUT_BITS = XF_DTPIXELDEPTH(DST_T, NPC);
+    const int OUT_MAX = (1 << OUT_BITS) - 1;
+    const int SHIFT = IN_BITS - XF_LTM_BITS;
+    const int NPPC = XF_NPIXPERCYCLE(NPC);
+
+    unsigned short grid[GRID_ROWS][GRID_COLS];
+    ap_ufixed<XF_LTM_BITS + 8, XF_LTM_BITS> row_lm[GRID_COLS];
+    ap_uint<32> blk[GRID_COLS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=grid complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=row_lm complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=blk complete dim=0
+    // clang-format on
+
+    for (int by = 0; by < GRID_ROWS; by++) {
+        for (int bx = 0; bx < GRID_COLS; bx++) {
+// clang-format off
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            grid[by][bx] = lm[by][bx];
+        }
+    }
+    for (int bx = 0; bx < GRID_COLS; bx++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        blk[bx] = 0;
+    }
+
+    int rows = src.rows;
+    int width = src.cols >> XF_BITSHIFT(NPC);
+    int bh, bw;
+    ltmBlockSize<GRID_ROWS, GRID_COLS, NPC>(rows, src.cols, bh, bw);
+
+    ap_ufixed<32, 0, AP_RND> inv_bh = 1.0f / bh;
+    ap_ufixed<32, 0, AP_RND> inv_bw = 1.0f / bw;
+    ap_ufixed<16, 2, AP_RND> k = key;
+    ap_ufixed<OUT_BITS + 12, OUT_BITS + 2, AP_RND> num = OUT_MAX * k;
+    int bw_clk = bw >> XF_BITSHIFT(NPC);
+
+    int by_cur = 0;
+    int y_end = bh;
+
+RowLoop:
+    for (int i = 0; i < rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+        // clang-format on
+
+        // Vertical interpolation of the grid for this row
+        ap_fixed<24, 10> fy = (ap_fixed<24, 10>)((i + (ap_ufixed<1, 0>)0.5) * inv_bh) - (ap_ufixed<1, 0>)0.5;
+        int by0 = (fy < 0) ? 0 : (int)fy;
+        ap_ufixed<12, 0> wy = ((fy < 0) || (by0 >= GRID_ROWS - 1)) ? (ap_ufixed<12, 0>)0 : (ap_ufixed<12, 0>)(fy - by0);
+        if (by0 > GRID_ROWS - 1) by0 = GRID_ROWS - 1;
+        int by1 = (by0 + 1 > GRID_ROWS - 1) ? GRID_ROWS - 1 : by0 + 1;
+        for (int bx = 0; bx < GRID_COLS; bx++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            row_lm[bx] = grid[by0][bx] * (ap_ufixed<13, 1>)(1 - wy) + grid[by1][bx] * wy;
+        }
+
+        ap_uint<32> acc = 0;
+        int bx_cur = 0;
+        int clk_in_blk = 0;
+
+    ColLoop:
+        for (int j = 0; j < width; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS/NPC max=COLS/NPC
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            XF_TNAME(SRC_T, NPC) in = src.read(i * width + j);
+            XF_TNAME(DST_T, NPC) out;
+
+            for (int p = 0; p < NPPC; p++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                ap_uint<IN_BITS> b = in.range((3 * p) * IN_BITS + IN_BITS - 1, (3 * p) * IN_BITS);
+                ap_uint<IN_BITS> g = in.range((3 * p + 1) * IN_BITS + IN_BITS - 1, (3 * p + 1) * IN_BITS);
+                ap_uint<IN_BITS> r = in.range((3 * p + 2) * IN_BITS + IN_BITS - 1, (3 * p + 2) * IN_BITS);
+                ap_uint<IN_BITS> y = (b + 2 * g + r) >> 2;
+                acc += (y >> SHIFT);
+
+                // Horizontal interpolation of the local mean
+                int x = j * NPPC + p;
+                ap_fixed<24, 12> fx = (ap_fixed<24, 12>)((x + (ap_ufixed<1, 0>)0.5) * inv_bw) - (ap_ufixed<1, 0>)0.5;
+                int bx0 = (fx < 0) ? 0 : (int)fx;
+                ap_ufixed<12, 0> wx =
+                    ((fx < 0) || (bx0 >= GRID_COLS - 1)) ? (ap_ufixed<12, 0>)0 : (ap_ufixed<12, 0>)(fx - bx0);
+                if (bx0 > GRID_COLS - 1) bx0 = GRID_COLS - 1;
+                int bx1 = (bx0 + 1 > GRID_COLS - 1) ? GRID_COLS - 1 : bx0 + 1;
+                ap_ufixed<XF_LTM_BITS + 8, XF_LTM_BITS> l12 =
+                    row_lm[bx0] * (ap_ufixed<13, 1>)(1 - wx) + row_lm[bx1] * wx;
+                ap_ufixed<IN_BITS + 8, IN_BITS> lmean = l12;
+                lmean <<= SHIFT;
+                if (lmean < 1) lmean = 1;
+
+                // Reinhard operator, one division per pixel
+                ap_ufixed<IN_BITS + 12, IN_BITS + 4> den = lmean + k * y;
+                ap_ufixed<OUT_BITS + 28, OUT_BITS + 2> q = num / den;
+
+                ap_uint<IN_BITS> ch[3] = {b, g, r};
+                for (int c = 0; c < 3; c++) {
+                    ap_ufixed<IN_BITS + OUT_BITS + 2, IN_BITS + OUT_BITS + 2> v = ch[c] * q + (ap_ufixed<2, 0>)0.5;
+                    out.range((3 * p + c) * OUT_BITS + OUT_BITS - 1, (3 * p + c) * OUT_BITS) =
+                        (v > OUT_MAX) ? OUT_MAX : (int)v;
+                }
+            }
+
+            dst.write(i * width + j, out);
+
+            // Block luminance sums of the current frame
+            if ((clk_in_blk == bw_clk - 1) || (j == width - 1)) {
+                blk[bx_cur] += acc;
+                acc = 0;
+                clk_in_blk = 0;
+                bx_cur++;
+            } else {
+                clk_in_blk++;
+            }
+        }
+
+        if ((i == y_end - 1) || (i == rows - 1)) {
+            for (int bx = 0; bx < GRID_COLS; bx++) {
+// clang-format off
+                #pragma HLS PIPELINE II=1
+                // clang-format on
+                blk_sums.write(blk[bx]);
+                blk[bx] = 0;
+            }
+            by_cur++;
+            y_end += bh;
+        }
+    }
+
+    // Rows of blocks beyond the image
+    for (; by_cur < GRID_ROWS; by_cur++) {
+        for (int bx = 0; bx < GRID_COLS; bx++) {
+// clang-format off
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            blk_sums.write(0);
+        }
+    }
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_LTM_HPP_
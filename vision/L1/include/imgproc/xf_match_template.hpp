@@ -0,0 +1,402 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_MATCH_TEMPLATE_HPP_
+#define _XF_MATCH_TEMPLATE_HPP_
+
+#include "hls_stream.h"
+#include "hls_math.h"
+#include "common/xf_common.hpp"
+
+namespace xf {
+namespace cv {
+
+// Comparison methods, with the numbering of OpenCV
+enum matchTemplateMethod {
+    XF_TM_SQDIFF = 0,
+    XF_TM_SQDIFF_NORMED = 1,
+    XF_TM_CCORR = 2,
+    XF_TM_CCORR_NORMED = 3,
+    XF_TM_CCOEFF = 4,
+    XF_TM_CCOEFF_NORMED = 5
+};
+
+/**
+ * Score of a match position from the correlation ccorr of the template with
+ * the window, the sum and squared sum of the window (s1, s2) and of the
+ * template (t1, t2) over n pixels.
+ */
+template <int METHOD>
+float xFMatchScore(ap_uint<32> ccorr,
+                   ap_uint<24> s1,
+                   ap_uint<32> s2,
+                   ap_uint<24> t1,
+                   ap_uint<32> t2,
+                   ap_uint<16> n,
+                   float t2_sqrt,
+                   float tvar_sqrt) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    float score;
+    if ((METHOD == XF_TM_SQDIFF) || (METHOD == XF_TM_SQDIFF_NORMED)) {
+        ap_int<40> sqdiff = (ap_int<40>)s2 - 2 * (ap_int<40>)ccorr + (ap_int<40>)t2;
+        score = (float)sqdiff;
+        if (METHOD == XF_TM_SQDIFF_NORMED) {
+            float den = hls::sqrt((float)s2) * t2_sqrt;
+            score = (den > 0.0f) ? score / den : 1.0f;
+            if (score > 1.0f) score = 1.0f;
+        }
+    } else if ((METHOD == XF_TM_CCORR) || (METHOD == XF_TM_CCORR_NORMED)) {
+        score = (float)ccorr;
+        if (METHOD == XF_TM_CCORR_NORMED) {
+            float den = hls::sqrt((float)s2) * t2_sqrt;
+            score = (den > 0.0f) ? score / den : 0.0f;
+            if (score > 1.0f) score = 1.0f;
+        }
+    } else {
+        // n * (ccorr - s1 * t1 / n), the window and template variances times n^2
+        ap_int<48> num = (ap_int<48>)n * ccorr - (ap_int<48>)s1 * t1;
+        if (METHOD == XF_TM_CCOEFF) {
+            score = (float)num / (float)n;
+        } else {
+            ap_int<48> var = (ap_int<48>)n * s2 - (ap_int<48>)s1 * s1;
+            float den = hls::sqrt((float)var) * tvar_sqrt;
+            score = (den > 0.0f) ? (float)num / den : 0.0f;
+            if (score > 1.0f) score = 1.0f;
+            if (score < -1.0f) score = -1.0f;
+        }
+    }
+    return score;
+}
+
+/**
+ * Template matching of an 8 bit gray image against a template of up to
+ * TMPL_ROWS x TMPL_COLS pixels, with the methods of cv::matchTemplate.
+ *
+ * The template is in the top left tmpl_rows x tmpl_cols pixels of tmpl. dst
+ * is the (rows - tmpl_rows + 1) x (cols - tmpl_cols + 1) score map, the score
+ * of a position being written when the bottom right pixel of the window
+ * arrives.
+ *
+ * The window is kept in registers, fed by a TMPL_ROWS rows line buffer. The
+ * correlation of a window takes TMPL_ROWS * TMPL_COLS / PU clocks, PU
+ * multiplications per clock, so that large templates fit a multiplier budget.
+ * The window sums used for the normalization are running sums, one column
+ * sum per image column updated with the pixel entering and the pixel leaving
+ * the window, as in the integral image.
+ */
+template <int METHOD, int TMPL_ROWS, int TMPL_COLS, int PU, int SRC_T, int DST_T, int ROWS, int COLS, int NPC>
+void matchTemplate(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& src,
+                   unsigned char tmpl[TMPL_ROWS][TMPL_COLS],
+                   xf::cv::Mat<DST_T, ROWS, COLS, NPC>& dst,
+                   int tmpl_rows,
+                   int tmpl_cols) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+    const int STEPS = (TMPL_ROWS * TMPL_COLS) / PU;
+    const int SLICE_ROWS = TMPL_ROWS / STEPS;
+
+    int rows = src.rows;
+    int cols = src.cols;
+#ifndef __SYNTHESIS__
+    assert(((rows <= ROWS) && (cols <= COLS)) && "ROWS and COLS should be greater than input image");
+    assert((SRC_T == XF_8UC1) && "Input type must be XF_8UC1");
+    assert((DST_T == XF_32FC1) && "Output type must be XF_32FC1");
+    assert((NPC == XF_NPPC1) && "NPC must be XF_NPPC1");
+    assert(((METHOD >= XF_TM_SQDIFF) && (METHOD <= XF_TM_CCOEFF_NORMED)) && "Invalid method");
+    assert(((TMPL_ROWS * TMPL_COLS) % PU == 0) && (TMPL_ROWS % STEPS == 0) &&
+           "PU must be a multiple of TMPL_COLS dividing TMPL_ROWS * TMPL_COLS");
+    assert((tmpl_rows >= 1) && (tmpl_rows <= TMPL_ROWS) && (tmpl_cols >= 1) && (tmpl_cols <= TMPL_COLS) &&
+           "Template larger than TMPL_ROWS x TMPL_COLS");
+    assert((tmpl_rows <= rows) && (tmpl_cols <= cols) && "Template larger than the image");
+    assert(((dst.rows == rows - tmpl_rows + 1) && (dst.cols == cols - tmpl_cols + 1)) &&
+           "Output must be (rows - tmpl_rows + 1) x (cols - tmpl_cols + 1)");
+#endif
+
+    // Line buffer, row i - TMPL_ROWS + k in buf[k]
+    ap_uint<8> buf[TMPL_ROWS][COLS];
+    // Window and template, aligned on the bottom right corner
+    ap_uint<8> win[TMPL_ROWS][TMPL_COLS];
+    ap_uint<8> tp[TMPL_ROWS][TMPL_COLS];
+    // Column sums over the template height and the last TMPL_COLS of them
+    ap_uint<16> csum1[COLS];
+    ap_uint<24> csum2[COLS];
+    ap_uint<16> hsum1[TMPL_COLS];
+    ap_uint<24> hsum2[TMPL_COLS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=win complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=tp complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=hsum1 complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=hsum2 complete dim=0
+    // clang-format on
+
+    int row_off = TMPL_ROWS - tmpl_rows;
+    int col_off = TMPL_COLS - tmpl_cols;
+    ap_uint<24> t1 = 0;
+    ap_uint<32> t2 = 0;
+
+TmplLoop:
+    for (int r = 0; r < TMPL_ROWS; r++) {
+        for (int c = 0; c < TMPL_COLS; c++) {
+// clang-format off
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            ap_uint<8> v = 0;
+            if ((r >= row_off) && (c >= col_off)) v = tmpl[r - row_off][c - col_off];
+            tp[r][c] = v;
+            t1 += v;
+            t2 += v * v;
+        }
+    }
+
+    ap_uint<16> n = tmpl_rows * tmpl_cols;
+    float t2_sqrt = hls::sqrt((float)t2);
+    float tvar_sqrt = hls::sqrt((float)((ap_int<48>)n * t2 - (ap_int<48>)t1 * t1));
+
+    int wr_ind = 0;
+
+RowLoop:
+    for (int i = 0; i < rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+        // clang-format on
+        int j = 0;
+        int s = 0;
+        ap_uint<32> ccorr = 0;
+        ap_uint<24> s1 = 0;
+        ap_uint<32> s2 = 0;
+
+    ColLoop:
+        for (int k = 0; k < cols * STEPS; k++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS*STEPS max=COLS*STEPS
+            #pragma HLS PIPELINE II=1
+            #pragma HLS DEPENDENCE variable=buf inter false
+            #pragma HLS DEPENDENCE variable=csum1 inter false
+            #pragma HLS DEPENDENCE variable=csum2 inter false
+            // clang-format on
+            if (s == 0) {
+                ap_uint<8> p = src.read(i * cols + j);
+
+                ap_uint<8> col[TMPL_ROWS];
+// clang-format off
+                #pragma HLS ARRAY_PARTITION variable=col complete dim=0
+                // clang-format on
+                for (int r = 0; r < TMPL_ROWS; r++) {
+                    col[r] = buf[r][j];
+                }
+                for (int r = 0; r < TMPL_ROWS - 1; r++) {
+                    buf[r][j] = col[r + 1];
+                }
+                buf[TMPL_ROWS - 1][j] = p;
+
+                for (int r = 0; r < TMPL_ROWS; r++) {
+                    for (int c = 0; c < TMPL_COLS - 1; c++) {
+                        win[r][c] = win[r][c + 1];
+                    }
+                    win[r][TMPL_COLS - 1] = (r == TMPL_ROWS - 1) ? p : col[r + 1];
+                }
+
+                // Running sums of the window, the pixel tmpl_rows above leaves the column
+                ap_uint<8> old = (i >= tmpl_rows) ? col[row_off] : (ap_uint<8>)0;
+                ap_uint<16> c1 = ((i == 0) ? (ap_uint<16>)0 : csum1[j]) + p - old;
+                ap_uint<24> c2 = ((i == 0) ? (ap_uint<24>)0 : csum2[j]) + p * p - old * old;
+                csum1[j] = c1;
+                csum2[j] = c2;
+
+                s1 = s1 + c1 - ((j >= tmpl_cols) ? hsum1[col_off] : (ap_uint<16>)0);
+                s2 = s2 + c2 - ((j >= tmpl_cols) ? hsum2[col_off] : (ap_uint<24>)0);
+                for (int c = 0; c < TMPL_COLS - 1; c++) {
+                    hsum1[c] = hsum1[c + 1];
+                    hsum2[c] = hsum2[c + 1];
+                }
+                hsum1[TMPL_COLS - 1] = c1;
+                hsum2[TMPL_COLS - 1] = c2;
+            }
+
+            // PU multiplications on a slice of SLICE_ROWS rows
+            ap_uint<32> partial = 0;
+            for (int r = 0; r < SLICE_ROWS; r++) {
+                for (int c = 0; c < TMPL_COLS; c++) {
+                    partial += win[s * SLICE_ROWS + r][c] * tp[s * SLICE_ROWS + r][c];
+                }
+            }
+            ccorr = ((s == 0) ? (ap_uint<32>)0 : ccorr) + partial;
+
+            if (s == STEPS - 1) {
+                if ((i >= tmpl_rows - 1) && (j >= tmpl_cols - 1)) {
+                    float score = xFMatchScore<METHOD>(ccorr, s1, s2, t1, t2, n, t2_sqrt, tvar_sqrt);
+                    dst.write_float(wr_ind++, score);
+                }
+                s = 0;
+                j++;
+            } else {
+                s++;
+            }
+        }
+    }
+}
+
+/**
+ * Best K positions of a matchTemplate score map, among the local extrema of
+ * their 3x3 neighborhood: maxima, or minima for the SQDIFF methods. Plateaus
+ * keep their first pixel in raster order. The positions are sorted best
+ * first, as row << 16 | col words in loc, with their score; num is the
+ * number of positions found, at most K.
+ */
+template <int METHOD, int K, int DST_T, int ROWS, int COLS, int NPC>
+void matchTemplateTopK(xf::cv::Mat<DST_T, ROWS, COLS, NPC>& score,
+                       ap_uint<32> loc[K],
+                       float best[K],
+                       int& num) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+#ifndef __SYNTHESIS__
+    assert((DST_T == XF_32FC1) && "Score type must be XF_32FC1");
+    assert((NPC == XF_NPPC1) && "NPC must be XF_NPPC1");
+#endif
+    const bool MIN = (METHOD == XF_TM_SQDIFF) || (METHOD == XF_TM_SQDIFF_NORMED);
+
+    // Two rows of scores and the 3x3 neighborhood, centered on (i - 1, j - 1)
+    float buf[2][COLS];
+    float win[3][3];
+    ap_uint<32> top_loc[K];
+    float top[K];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=win complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=top_loc complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=top complete dim=0
+    // clang-format on
+
+    for (int t = 0; t < K; t++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        top_loc[t] = 0;
+        top[t] = 0.0f;
+    }
+
+    int rows = score.rows;
+    int cols = score.cols;
+    int count = 0;
+    int rd_ind = 0;
+
+RowLoop:
+    for (int i = 0; i <= rows; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=ROWS max=ROWS
+        #pragma HLS LOOP_FLATTEN OFF
+        // clang-format on
+    ColLoop:
+        for (int j = 0; j <= cols; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=COLS max=COLS
+            #pragma HLS PIPELINE II=1
+            #pragma HLS DEPENDENCE variable=buf inter false
+            // clang-format on
+            float v = 0.0f;
+            if ((i < rows) && (j < cols)) v = score.read_float(rd_ind++);
+
+            // Neighbors outside the map never win
+            float col[3];
+            col[0] = (j < cols) ? buf[0][j] : 0.0f;
+            col[1] = (j < cols) ? buf[1][j] : 0.0f;
+            col[2] = v;
+            bool valid[3] = {(i >= 2) && (j < cols), (i >= 1) && (j < cols), (i < rows) && (j < cols)};
+            if (j < cols) {
+                buf[0][j] = col[1];
+                buf[1][j] = v;
+            }
+
+            float nb[3][3];
+            bool nb_valid[3][3];
+            for (int r = 0; r < 3; r++) {
+                win[r][0] = win[r][1];
+                win[r][1] = win[r][2];
+                win[r][2] = col[r];
+            }
+            // Column validity: j - 2 and j - 1 inside the map, j only if j < cols
+            for (int r = 0; r < 3; r++) {
+                nb_valid[r][0] = (j >= 2) && (r == 0 ? (i >= 2) : (r == 1 ? (i >= 1) : (i < rows)));
+                nb_valid[r][1] = (j >= 1) && (r == 0 ? (i >= 2) : (r == 1 ? (i >= 1) : (i < rows)));
+                nb_valid[r][2] = valid[r];
+                for (int c = 0; c < 3; c++) nb[r][c] = win[r][c];
+            }
+
+            if ((i >= 1) && (j >= 1)) {
+                float center = nb[1][1];
+                bool extremum = true;
+                for (int r = 0; r < 3; r++) {
+                    for (int c = 0; c < 3; c++) {
+                        if ((r == 1) && (c == 1)) continue;
+                        if (!nb_valid[r][c]) continue;
+                        // Earlier neighbors in raster order win the ties
+                        bool before = (r < 1) || ((r == 1) && (c < 1));
+                        float o = nb[r][c];
+                        bool beaten = MIN ? (before ? (o <= center) : (o < center))
+                                          : (before ? (o >= center) : (o > center));
+                        if (beaten) extremum = false;
+                    }
+                }
+
+                if (extremum) {
+                    // Insertion in the sorted list, equal scores keep the raster order
+                    ap_uint<32> l = ((ap_uint<32>)(i - 1) << 16) | (j - 1);
+                    bool worse[K];
+// clang-format off
+                    #pragma HLS ARRAY_PARTITION variable=worse complete dim=0
+                    // clang-format on
+                    for (int t = 0; t < K; t++) {
+                        worse[t] = (t >= count) || (MIN ? (center < top[t]) : (center > top[t]));
+                    }
+                    for (int t = K - 1; t >= 0; t--) {
+                        if (worse[t]) {
+                            if ((t == 0) || !worse[t - 1]) {
+                                top[t] = center;
+                                top_loc[t] = l;
+                            } else {
+                                top[t] = top[t - 1];
+                                top_loc[t] = top_loc[t - 1];
+                            }
+                        }
+                    }
+                    if (count < K) count++;
+                }
+            }
+        }
+    }
+
+    for (int t = 0; t < K; t++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        loc[t] = top_loc[t];
+        best[t] = top[t];
+    }
+    num = count;
+}
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_MATCH_TEMPLATE_HPP_
@@ -0,0 +1,485 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_PIPELINE_HPP_
+#define _XF_PIPELINE_HPP_
+
+#ifndef __cplusplus
+#error C++ is needed to include this header
+#endif
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "core/xf_arithm.hpp"
+#include "core/xf_magnitude.hpp"
+#include "imgproc/xf_cvt_color.hpp"
+#include "imgproc/xf_delay.hpp"
+#include "imgproc/xf_duplicateimage.hpp"
+#include "imgproc/xf_gaussian_filter.hpp"
+#include "imgproc/xf_resize.hpp"
+#include "imgproc/xf_sobel.hpp"
+
+/*
+ * Streaming pipeline builder.
+ *
+ * A stage wraps one library function. Unary stages define the enums IN_T,
+ * OUT_T, IN_ROWS, IN_COLS, OUT_ROWS, OUT_COLS, NPC and LATENCY (words from
+ * first input to first output), the members outRows(rows) and outCols(cols)
+ * giving the output size for an input size, and
+ *     void run(xf::cv::Mat<IN_T, IN_ROWS, IN_COLS, NPC>& src, xf::cv::Mat<OUT_T, OUT_ROWS, OUT_COLS, NPC>& dst);
+ * Join stages (magnitude, add, subtract) define IN_T, OUT_T, ROWS, COLS, NPC
+ * and LATENCY and run(src1, src2, dst). Split stages (Sobel) define the same
+ * and run(src, dst1, dst2).
+ *
+ * PipeChain, PipeFork and PipeSplit connect stages through streamed
+ * xf::cv::Mat objects inside a DATAFLOW region and are stages themselves, so
+ * they nest. Pipeline<S1, ..., S8> chains up to 8 stages. Mismatched pixel
+ * types, NPC or sizes between connected stages fail to compile with an
+ * incomplete type named after the mismatch.
+ */
+
+namespace xf {
+namespace cv {
+
+template <bool OK>
+struct PIPELINE_STAGE_TYPE_MISMATCH;
+template <>
+struct PIPELINE_STAGE_TYPE_MISMATCH<true> {};
+
+template <bool OK>
+struct PIPELINE_STAGE_NPC_MISMATCH;
+template <>
+struct PIPELINE_STAGE_NPC_MISMATCH<true> {};
+
+template <bool OK>
+struct PIPELINE_STAGE_SIZE_MISMATCH;
+template <>
+struct PIPELINE_STAGE_SIZE_MISMATCH<true> {};
+
+// Latency of a KxK window filter, in words of NPC pixels
+template <int K, int COLS, int NPC>
+struct xFWindowLatency {
+    enum { value = (K >> 1) * (COLS >> XF_BITSHIFT(NPC)) + (K >> 1) + 1 };
+};
+
+/* Connects A to B: src -> A -> B -> dst */
+template <class A, class B, int DEPTH = 2>
+class PipeChain {
+   public:
+    enum {
+        IN_T = A::IN_T,
+        OUT_T = B::OUT_T,
+        IN_ROWS = A::IN_ROWS,
+        IN_COLS = A::IN_COLS,
+        OUT_ROWS = B::OUT_ROWS,
+        OUT_COLS = B::OUT_COLS,
+        NPC = A::NPC,
+        LATENCY = A::LATENCY + B::LATENCY
+    };
+    enum {
+        CHECK_TYPE = sizeof(PIPELINE_STAGE_TYPE_MISMATCH<((int)A::OUT_T == (int)B::IN_T)>),
+        CHECK_NPC = sizeof(PIPELINE_STAGE_NPC_MISMATCH<((int)A::NPC == (int)B::NPC)>),
+        CHECK_SIZE = sizeof(
+            PIPELINE_STAGE_SIZE_MISMATCH<((int)A::OUT_ROWS == (int)B::IN_ROWS && (int)A::OUT_COLS == (int)B::IN_COLS)>)
+    };
+
+    PipeChain(const A& a = A(), const B& b = B()) : m_a(a), m_b(b) {}
+
+    int outRows(int rows) const { return m_b.outRows(m_a.outRows(rows)); }
+    int outCols(int cols) const { return m_b.outCols(m_a.outCols(cols)); }
+
+    void run(xf::cv::Mat<IN_T, IN_ROWS, IN_COLS, NPC>& src, xf::cv::Mat<OUT_T, OUT_ROWS, OUT_COLS, NPC>& dst) {
+// clang-format off
+        #pragma HLS INLINE OFF
+        #pragma HLS DATAFLOW
+        // clang-format on
+        xf::cv::Mat<A::OUT_T, A::OUT_ROWS, A::OUT_COLS, NPC> mid(m_a.outRows(src.rows), m_a.outCols(src.cols));
+// clang-format off
+        #pragma HLS STREAM variable=mid.data depth=DEPTH
+        // clang-format on
+        m_a.run(src, mid);
+        m_b.run(mid, dst);
+    }
+
+   private:
+    A m_a;
+    B m_b;
+};
+
+/*
+ * Runs A and B on copies of the input and combines their outputs with the
+ * join stage J. The branch with the lower latency is delayed by delayMat so
+ * that both reach J together.
+ */
+template <class A, class B, class J, int DEPTH = 2>
+class PipeFork {
+   public:
+    enum {
+        IN_T = A::IN_T,
+        OUT_T = J::OUT_T,
+        IN_ROWS = A::IN_ROWS,
+        IN_COLS = A::IN_COLS,
+        OUT_ROWS = J::ROWS,
+        OUT_COLS = J::COLS,
+        NPC = A::NPC,
+        DELAY_A = (B::LATENCY > A::LATENCY) ? B::LATENCY - A::LATENCY + DEPTH : DEPTH,
+        DELAY_B = (A::LATENCY > B::LATENCY) ? A::LATENCY - B::LATENCY + DEPTH : DEPTH,
+        LATENCY = ((A::LATENCY > B::LATENCY) ? A::LATENCY : B::LATENCY) + J::LATENCY
+    };
+    enum {
+        CHECK_TYPE = sizeof(PIPELINE_STAGE_TYPE_MISMATCH<((int)A::IN_T == (int)B::IN_T &&
+                                                          (int)A::OUT_T == (int)J::IN_T &&
+                                                          (int)B::OUT_T == (int)J::IN_T)>),
+        CHECK_NPC = sizeof(PIPELINE_STAGE_NPC_MISMATCH<((int)A::NPC == (int)B::NPC && (int)A::NPC == (int)J::NPC)>),
+        CHECK_SIZE = sizeof(PIPELINE_STAGE_SIZE_MISMATCH<(
+            (int)A::IN_ROWS == (int)B::IN_ROWS && (int)A::IN_COLS == (int)B::IN_COLS &&
+            (int)A::OUT_ROWS == (int)J::ROWS && (int)A::OUT_COLS == (int)J::COLS && (int)B::OUT_ROWS == (int)J::ROWS &&
+            (int)B::OUT_COLS == (int)J::COLS)>)
+    };
+
+    PipeFork(const A& a = A(), const B& b = B(), const J& j = J()) : m_a(a), m_b(b), m_j(j) {}
+
+    int outRows(int rows) const { return m_a.outRows(rows); }
+    int outCols(int cols) const { return m_a.outCols(cols); }
+
+    void run(xf::cv::Mat<IN_T, IN_ROWS, IN_COLS, NPC>& src, xf::cv::Mat<OUT_T, OUT_ROWS, OUT_COLS, NPC>& dst) {
+// clang-format off
+        #pragma HLS INLINE OFF
+        #pragma HLS DATAFLOW
+        // clang-format on
+        int rows = m_a.outRows(src.rows);
+        int cols = m_a.outCols(src.cols);
+        xf::cv::Mat<IN_T, IN_ROWS, IN_COLS, NPC> inA(src.rows, src.cols);
+        xf::cv::Mat<IN_T, IN_ROWS, IN_COLS, NPC> inB(src.rows, src.cols);
+        xf::cv::Mat<J::IN_T, J::ROWS, J::COLS, NPC> outA(rows, cols);
+        xf::cv::Mat<J::IN_T, J::ROWS, J::COLS, NPC> outB(rows, cols);
+        xf::cv::Mat<J::IN_T, J::ROWS, J::COLS, NPC> delayedA(rows, cols);
+        xf::cv::Mat<J::IN_T, J::ROWS, J::COLS, NPC> delayedB(rows, cols);
+// clang-format off
+        #pragma HLS STREAM variable=inA.data depth=DEPTH
+        #pragma HLS STREAM variable=inB.data depth=DEPTH
+        #pragma HLS STREAM variable=outA.data depth=DEPTH
+        #pragma HLS STREAM variable=outB.data depth=DEPTH
+        #pragma HLS STREAM variable=delayedA.data depth=DEPTH
+        #pragma HLS STREAM variable=delayedB.data depth=DEPTH
+        // clang-format on
+        xf::cv::duplicateMat<IN_T, IN_ROWS, IN_COLS, NPC>(src, inA, inB);
+        m_a.run(inA, outA);
+        m_b.run(inB, outB);
+        xf::cv::delayMat<DELAY_A, J::IN_T, J::ROWS, J::COLS, NPC>(outA, delayedA);
+        xf::cv::delayMat<DELAY_B, J::IN_T, J::ROWS, J::COLS, NPC>(outB, delayedB);
+        m_j.run(delayedA, delayedB, dst);
+    }
+
+   private:
+    A m_a;
+    B m_b;
+    J m_j;
+};
+
+/* Runs the split stage S, which has two outputs, and combines them with J */
+template <class S, class J, int DEPTH = 2>
+class PipeSplit {
+   public:
+    enum {
+        IN_T = S::IN_T,
+        OUT_T = J::OUT_T,
+        IN_ROWS = S::ROWS,
+        IN_COLS = S::COLS,
+        OUT_ROWS = J::ROWS,
+        OUT_COLS = J::COLS,
+        NPC = S::NPC,
+        LATENCY = S::LATENCY + J::LATENCY
+    };
+    enum {
+        CHECK_TYPE = sizeof(PIPELINE_STAGE_TYPE_MISMATCH<((int)S::OUT_T == (int)J::IN_T)>),
+        CHECK_NPC = sizeof(PIPELINE_STAGE_NPC_MISMATCH<((int)S::NPC == (int)J::NPC)>),
+        CHECK_SIZE = sizeof(PIPELINE_STAGE_SIZE_MISMATCH<((int)S::ROWS == (int)J::ROWS && (int)S::COLS == (int)J::COLS)>)
+    };
+
+    PipeSplit(const S& s = S(), const J& j = J()) : m_s(s), m_j(j) {}
+
+    int outRows(int rows) const { return rows; }
+    int outCols(int cols) const { return cols; }
+
+    void run(xf::cv::Mat<IN_T, IN_ROWS, IN_COLS, NPC>& src, xf::cv::Mat<OUT_T, OUT_ROWS, OUT_COLS, NPC>& dst) {
+// clang-format off
+        #pragma HLS INLINE OFF
+        #pragma HLS DATAFLOW
+        // clang-format on
+        xf::cv::Mat<S::OUT_T, S::ROWS, S::COLS, NPC> out1(src.rows, src.cols);
+        xf::cv::Mat<S::OUT_T, S::ROWS, S::COLS, NPC> out2(src.rows, src.cols);
+// clang-format off
+        #pragma HLS STREAM variable=out1.data depth=DEPTH
+        #pragma HLS STREAM variable=out2.data depth=DEPTH
+        // clang-format on
+        m_s.run(src, out1, out2);
+        m_j.run(out1, out2, dst);
+    }
+
+   private:
+    S m_s;
+    J m_j;
+};
+
+/* Marks the unused stages of Pipeline */
+struct PipeEnd {};
+
+/* Chains up to 8 stages: src -> S1 -> S2 -> ... -> dst */
+template <class S1,
+          class S2 = PipeEnd,
+          class S3 = PipeEnd,
+          class S4 = PipeEnd,
+          class S5 = PipeEnd,
+          class S6 = PipeEnd,
+          class S7 = PipeEnd,
+          class S8 = PipeEnd>
+class Pipeline : public PipeChain<S1, Pipeline<S2, S3, S4, S5, S6, S7, S8, PipeEnd> > {
+   public:
+    Pipeline(const S1& s1 = S1(),
+             const S2& s2 = S2(),
+             const S3& s3 = S3(),
+             const S4& s4 = S4(),
+             const S5& s5 = S5(),
+             const S6& s6 = S6(),
+             const S7& s7 = S7(),
+             const S8& s8 = S8())
+        : PipeChain<S1, Pipeline<S2, S3, S4, S5, S6, S7, S8, PipeEnd> >(
+              s1, Pipeline<S2, S3, S4, S5, S6, S7, S8, PipeEnd>(s2, s3, s4, s5, s6, s7, s8)) {}
+};
+
+template <class S1>
+class Pipeline<S1, PipeEnd, PipeEnd, PipeEnd, PipeEnd, PipeEnd, PipeEnd, PipeEnd> : public S1 {
+   public:
+    Pipeline(const S1& s1 = S1(),
+             const PipeEnd& = PipeEnd(),
+             const PipeEnd& = PipeEnd(),
+             const PipeEnd& = PipeEnd(),
+             const PipeEnd& = PipeEnd(),
+             const PipeEnd& = PipeEnd(),
+             const PipeEnd& = PipeEnd(),
+             const PipeEnd& = PipeEnd())
+        : S1(s1) {}
+};
+
+/* Stages */
+
+template <int T, int ROWS, int COLS, int NPC_T = XF_NPPC1>
+class IdentityStage {
+   public:
+    enum {
+        IN_T = T,
+        OUT_T = T,
+        IN_ROWS = ROWS,
+        IN_COLS = COLS,
+        OUT_ROWS = ROWS,
+        OUT_COLS = COLS,
+        NPC = NPC_T,
+        LATENCY = 1
+    };
+
+    int outRows(int rows) const { return rows; }
+    int outCols(int cols) const { return cols; }
+
+    void run(xf::cv::Mat<T, ROWS, COLS, NPC_T>& src, xf::cv::Mat<T, ROWS, COLS, NPC_T>& dst) {
+        for (int i = 0; i < src.rows; i++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS
+            // clang-format on
+            for (int j = 0; j < (src.cols >> XF_BITSHIFT(NPC_T)); j++) {
+// clang-format off
+                #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS/NPC_T
+                #pragma HLS PIPELINE
+                #pragma HLS LOOP_FLATTEN off
+                // clang-format on
+                int index = i * (src.cols >> XF_BITSHIFT(NPC_T)) + j;
+                dst.write(index, src.read(index));
+            }
+        }
+    }
+};
+
+template <int SRC_T, int DST_T, int ROWS, int COLS, int NPC_T = XF_NPPC1>
+class Rgb2GrayStage {
+   public:
+    enum {
+        IN_T = SRC_T,
+        OUT_T = DST_T,
+        IN_ROWS = ROWS,
+        IN_COLS = COLS,
+        OUT_ROWS = ROWS,
+        OUT_COLS = COLS,
+        NPC = NPC_T,
+        LATENCY = 1
+    };
+
+    int outRows(int rows) const { return rows; }
+    int outCols(int cols) const { return cols; }
+
+    void run(xf::cv::Mat<SRC_T, ROWS, COLS, NPC_T>& src, xf::cv::Mat<DST_T, ROWS, COLS, NPC_T>& dst) {
+        xf::cv::rgb2gray<SRC_T, DST_T, ROWS, COLS, NPC_T>(src, dst);
+    }
+};
+
+template <int SRC_T, int DST_T, int ROWS, int COLS, int NPC_T = XF_NPPC1>
+class Bgr2GrayStage {
+   public:
+    enum {
+        IN_T = SRC_T,
+        OUT_T = DST_T,
+        IN_ROWS = ROWS,
+        IN_COLS = COLS,
+        OUT_ROWS = ROWS,
+        OUT_COLS = COLS,
+        NPC = NPC_T,
+        LATENCY = 1
+    };
+
+    int outRows(int rows) const { return rows; }
+    int outCols(int cols) const { return cols; }
+
+    void run(xf::cv::Mat<SRC_T, ROWS, COLS, NPC_T>& src, xf::cv::Mat<DST_T, ROWS, COLS, NPC_T>& dst) {
+        xf::cv::bgr2gray<SRC_T, DST_T, ROWS, COLS, NPC_T>(src, dst);
+    }
+};
+
+/* The output size is set at construction, dstRows x dstCols */
+template <int INTERPOLATION_TYPE,
+          int T,
+          int SRC_ROWS,
+          int SRC_COLS,
+          int DST_ROWS,
+          int DST_COLS,
+          int NPC_T = XF_NPPC1,
+          int MAX_DOWN_SCALE = 2>
+class ResizeStage {
+   public:
+    enum {
+        IN_T = T,
+        OUT_T = T,
+        IN_ROWS = SRC_ROWS,
+        IN_COLS = SRC_COLS,
+        OUT_ROWS = DST_ROWS,
+        OUT_COLS = DST_COLS,
+        NPC = NPC_T,
+        LATENCY = xFWindowLatency<2 * MAX_DOWN_SCALE + 1, SRC_COLS, NPC_T>::value
+    };
+
+    ResizeStage(int dstRows = DST_ROWS, int dstCols = DST_COLS) : m_rows(dstRows), m_cols(dstCols) {}
+
+    int outRows(int) const { return m_rows; }
+    int outCols(int) const { return m_cols; }
+
+    void run(xf::cv::Mat<T, SRC_ROWS, SRC_COLS, NPC_T>& src, xf::cv::Mat<T, DST_ROWS, DST_COLS, NPC_T>& dst) {
+        xf::cv::resize<INTERPOLATION_TYPE, T, SRC_ROWS, SRC_COLS, DST_ROWS, DST_COLS, NPC_T, MAX_DOWN_SCALE>(src, dst);
+    }
+
+   private:
+    int m_rows;
+    int m_cols;
+};
+
+template <int FILTER_SIZE, int BORDER_TYPE, int T, int ROWS, int COLS, int NPC_T = XF_NPPC1>
+class GaussianBlurStage {
+   public:
+    enum {
+        IN_T = T,
+        OUT_T = T,
+        IN_ROWS = ROWS,
+        IN_COLS = COLS,
+        OUT_ROWS = ROWS,
+        OUT_COLS = COLS,
+        NPC = NPC_T,
+        LATENCY = xFWindowLatency<FILTER_SIZE, COLS, NPC_T>::value
+    };
+
+    GaussianBlurStage(float sigma = 0.5f) : m_sigma(sigma) {}
+
+    int outRows(int rows) const { return rows; }
+    int outCols(int cols) const { return cols; }
+
+    void run(xf::cv::Mat<T, ROWS, COLS, NPC_T>& src, xf::cv::Mat<T, ROWS, COLS, NPC_T>& dst) {
+        xf::cv::GaussianBlur<FILTER_SIZE, BORDER_TYPE, T, ROWS, COLS, NPC_T>(src, dst, m_sigma);
+    }
+
+   private:
+    float m_sigma;
+};
+
+/* Split stage, the two outputs are the x and y gradients */
+template <int BORDER_TYPE, int FILTER_TYPE, int SRC_T, int DST_T, int ROWS_T, int COLS_T, int NPC_T = XF_NPPC1>
+class SobelStage {
+   public:
+    enum {
+        IN_T = SRC_T,
+        OUT_T = DST_T,
+        ROWS = ROWS_T,
+        COLS = COLS_T,
+        NPC = NPC_T,
+        LATENCY = xFWindowLatency<FILTER_TYPE, COLS_T, NPC_T>::value
+    };
+
+    void run(xf::cv::Mat<SRC_T, ROWS_T, COLS_T, NPC_T>& src,
+             xf::cv::Mat<DST_T, ROWS_T, COLS_T, NPC_T>& dstx,
+             xf::cv::Mat<DST_T, ROWS_T, COLS_T, NPC_T>& dsty) {
+        xf::cv::Sobel<BORDER_TYPE, FILTER_TYPE, SRC_T, DST_T, ROWS_T, COLS_T, NPC_T>(src, dstx, dsty);
+    }
+};
+
+/* Join stages */
+
+template <int NORM_TYPE, int SRC_T, int DST_T, int ROWS_T, int COLS_T, int NPC_T = XF_NPPC1>
+class MagnitudeStage {
+   public:
+    enum { IN_T = SRC_T, OUT_T = DST_T, ROWS = ROWS_T, COLS = COLS_T, NPC = NPC_T, LATENCY = 1 };
+
+    void run(xf::cv::Mat<SRC_T, ROWS_T, COLS_T, NPC_T>& srcx,
+             xf::cv::Mat<SRC_T, ROWS_T, COLS_T, NPC_T>& srcy,
+             xf::cv::Mat<DST_T, ROWS_T, COLS_T, NPC_T>& dst) {
+        xf::cv::magnitude<NORM_TYPE, SRC_T, DST_T, ROWS_T, COLS_T, NPC_T>(srcx, srcy, dst);
+    }
+};
+
+template <int POLICY_TYPE, int T, int ROWS_T, int COLS_T, int NPC_T = XF_NPPC1>
+class AddStage {
+   public:
+    enum { IN_T = T, OUT_T = T, ROWS = ROWS_T, COLS = COLS_T, NPC = NPC_T, LATENCY = 1 };
+
+    void run(xf::cv::Mat<T, ROWS_T, COLS_T, NPC_T>& src1,
+             xf::cv::Mat<T, ROWS_T, COLS_T, NPC_T>& src2,
+             xf::cv::Mat<T, ROWS_T, COLS_T, NPC_T>& dst) {
+        xf::cv::add<POLICY_TYPE, T, ROWS_T, COLS_T, NPC_T>(src1, src2, dst);
+    }
+};
+
+/* dst = src1 - src2, src1 being the first branch of a PipeFork */
+template <int POLICY_TYPE, int T, int ROWS_T, int COLS_T, int NPC_T = XF_NPPC1>
+class SubtractStage {
+   public:
+    enum { IN_T = T, OUT_T = T, ROWS = ROWS_T, COLS = COLS_T, NPC = NPC_T, LATENCY = 1 };
+
+    void run(xf::cv::Mat<T, ROWS_T, COLS_T, NPC_T>& src1,
+             xf::cv::Mat<T, ROWS_T, COLS_T, NPC_T>& src2,
+             xf::cv::Mat<T, ROWS_T, COLS_T, NPC_T>& dst) {
+        xf::cv::subtract<POLICY_TYPE, T, ROWS_T, COLS_T, NPC_T>(src1, src2, dst);
+    }
+};
+
+} // namespace cv
+} // namespace xf
+
+#endif //_XF_PIPELINE_HPP_
@@ -964,6 +964,1031 @@ void SemiGlobalBM(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& _src_mat_l,
         }
     }
 }
+
+#define XF_SGBM_INVALID_DISP 0xFFFF
+
+/**
+ * xFSGBMwindow5x5 : Slides a 5x5 window with a constant border over a stream of NPC pixel words and writes
+ * op.apply(window) for each pixel. Shared by the census transform and the speckle filter of SemiGlobalBMSubpixel.
+ */
+template <int ROWS, int COLS, int NPC, int IN_W, int OUT_W, typename OP>
+void xFSGBMwindow5x5(hls::stream<ap_uint<IN_W * NPC> >& _src,
+                     hls::stream<ap_uint<OUT_W * NPC> >& _dst,
+                     ap_uint<IN_W> border,
+                     const OP& op,
+                     int height,
+                     int width) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+
+    // input words read ahead of the output word, to have the two pixels right of the last center
+    const int LAT = (NPC == XF_NPPC1) ? 2 : 1;
+    const int WIN = 2 + (LAT + 1) * NPC;
+
+    // previous four rows, the oldest first
+    ap_uint<IN_W * NPC> buf[4][COLS >> XF_BITSHIFT(NPC)];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=buf complete dim=1
+    // clang-format on
+
+    ap_uint<IN_W> win[5][WIN];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=win complete dim=0
+    // clang-format on
+
+    ap_uint<IN_W * NPC> border_word;
+    for (int p = 0; p < NPC; p++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        border_word.range(p * IN_W + IN_W - 1, p * IN_W) = border;
+    }
+
+    int nwords = width >> XF_BITSHIFT(NPC);
+
+Clear_Row_Loop:
+    for (int c = 0; c < nwords; c++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS/NPC
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        for (int i = 0; i < 4; i++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            buf[i][c] = border_word;
+        }
+    }
+
+Row_Loop:
+    for (int r = 0; r < height + 2; r++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS+2
+        // clang-format on
+        for (int i = 0; i < 5; i++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            for (int j = 0; j < WIN; j++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                win[i][j] = border;
+            }
+        }
+
+    Col_Loop:
+        for (int c = 0; c < nwords + LAT; c++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS/NPC
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            ap_uint<IN_W * NPC> col[5];
+// clang-format off
+            #pragma HLS ARRAY_PARTITION variable=col complete dim=0
+            // clang-format on
+            if (c < nwords) {
+                for (int i = 0; i < 4; i++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    col[i] = buf[i][c];
+                }
+                col[4] = (r < height) ? _src.read() : border_word;
+                for (int i = 0; i < 4; i++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    buf[i][c] = col[i + 1];
+                }
+            } else {
+                for (int i = 0; i < 5; i++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    col[i] = border_word;
+                }
+            }
+
+            // shift the window left by one word, win[.][2 + p] is the center of lane p of the word c - LAT
+            for (int i = 0; i < 5; i++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                for (int j = 0; j < WIN - NPC; j++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    win[i][j] = win[i][j + NPC];
+                }
+                for (int p = 0; p < NPC; p++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    win[i][WIN - NPC + p] = col[i].range(p * IN_W + IN_W - 1, p * IN_W);
+                }
+            }
+
+            if ((r >= 2) && (c >= LAT)) {
+                ap_uint<OUT_W * NPC> out;
+                for (int p = 0; p < NPC; p++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    ap_uint<IN_W> w[5][5];
+// clang-format off
+                    #pragma HLS ARRAY_PARTITION variable=w complete dim=0
+                    // clang-format on
+                    for (int i = 0; i < 5; i++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        for (int j = 0; j < 5; j++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            w[i][j] = win[i][p + j];
+                        }
+                    }
+                    out.range(p * OUT_W + OUT_W - 1, p * OUT_W) = op.apply(w);
+                }
+                _dst.write(out);
+            }
+        }
+    }
+}
+
+struct xFSGBMcensusOp {
+    ap_uint<24> apply(ap_uint<8> w[5][5]) const {
+// clang-format off
+        #pragma HLS INLINE
+        // clang-format on
+        return (ap_uint<24>)xFComputeTransform5x5<XF_8UP, XF_32UP>(w);
+    }
+};
+
+/**
+ * xFSGBMspeckleOp : Invalidates a disparity which has less than min_support valid neighbours within max_diff
+ * (1/16 pixel) in its 5x5 window, which removes isolated speckles and thin streaks.
+ */
+struct xFSGBMspeckleOp {
+    ap_uint<16> max_diff;
+    ap_uint<5> min_support;
+
+    ap_uint<16> apply(ap_uint<16> w[5][5]) const {
+// clang-format off
+        #pragma HLS INLINE
+        // clang-format on
+        ap_uint<16> center = w[2][2];
+        ap_uint<5> support = 0;
+        for (int i = 0; i < 5; i++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            for (int j = 0; j < 5; j++) {
+// clang-format off
+                #pragma HLS UNROLL
+                // clang-format on
+                ap_uint<16> v = w[i][j];
+                ap_uint<16> diff = (v > center) ? (ap_uint<16>)(v - center) : (ap_uint<16>)(center - v);
+                if (((i != 2) || (j != 2)) && (v != XF_SGBM_INVALID_DISP) && (diff <= max_diff)) support++;
+            }
+        }
+        return ((center == XF_SGBM_INVALID_DISP) || (support < min_support)) ? (ap_uint<16>)XF_SGBM_INVALID_DISP
+                                                                             : center;
+    }
+};
+
+/**
+ * xFSGBMcomputecostNPC : Hamming distance between the left census and the right census NDISP pixels to the left,
+ * for NPC pixels per word and PU disparities per iteration. Lane p of the word gets _cost[p].
+ */
+template <int NDISP, int PU, int NPC, int ROWS, int COLS>
+void xFSGBMcomputecostNPC(hls::stream<ap_uint<24 * NPC> >& _census_l,
+                          hls::stream<ap_uint<24 * NPC> >& _census_r,
+                          hls::stream<ap_uint<8> > _cost[NPC][PU],
+                          int height,
+                          int width) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+
+    const int NB = NDISP / PU;
+    const int W = NDISP + NPC - 1;
+
+    // r_buff[j] holds the right census of the column j pixels left of the last pixel of the word
+    ap_uint<24> r_buff[W];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=r_buff complete dim=1
+    // clang-format on
+    ap_uint<24 * NPC> l_val;
+
+    int nwords = width >> XF_BITSHIFT(NPC);
+
+loop_height:
+    for (int r = 0; r < height; r++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS
+        // clang-format on
+        for (int i = 0; i < W; i++) {
+// clang-format off
+            #pragma HLS UNROLL
+            // clang-format on
+            r_buff[i] = 0;
+        }
+
+    loop_width:
+        for (int c = 0; c < nwords; c++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS/NPC
+            // clang-format on
+        loop_block:
+            for (int b = 0; b < NB; b++) {
+// clang-format off
+                #pragma HLS PIPELINE II=1
+                #pragma HLS LOOP_FLATTEN
+                // clang-format on
+                if (b == 0) {
+                    l_val = _census_l.read();
+                    ap_uint<24 * NPC> r_val = _census_r.read();
+                    for (int i = W - 1; i >= NPC; i--) r_buff[i] = r_buff[i - NPC];
+                    for (int p = 0; p < NPC; p++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        r_buff[NPC - 1 - p] = r_val.range(p * 24 + 23, p * 24);
+                    }
+                }
+
+                for (int p = 0; p < NPC; p++) {
+// clang-format off
+                    #pragma HLS UNROLL
+                    // clang-format on
+                    for (int u = 0; u < PU; u++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        ap_uint<24> xor_val = l_val.range(p * 24 + 23, p * 24) ^ r_buff[NPC - 1 - p + b * PU + u];
+                        ap_uint<8> sum = 0;
+                        for (int k = 0; k < 24; k++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            sum += xor_val[k];
+                        }
+                        _cost[p][u].write(sum);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/**
+ * xFSGBMpathcost : Lr(p,d) = C(p,d) + min(Lr(p-r,d), Lr(p-r,d-1) + p1, Lr(p-r,d+1) + p1, min_k Lr(p-r,k) + p2)
+ * - min_k Lr(p-r,k) for PU disparities. lp[0] and lp[PU + 1] are the neighbours of the block, MAX_UCHAR - p1 outside
+ * the disparity range. Lr(p,d) = C(p,d) when p-r is outside the image.
+ */
+template <int PU>
+static void xFSGBMpathcost(ap_uint<8> cost[PU],
+                           ap_uint<8> lp[PU + 2],
+                           ap_uint<8> lp_min,
+                           bool border,
+                           uint8_t p1,
+                           uint8_t p2,
+                           ap_uint<8> lr[PU],
+                           ap_uint<8>& lr_min) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    ap_uint<8> block_min = MAX_UCHAR;
+    for (int u = 0; u < PU; u++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        ap_uint<9> tmp_arr[4];
+// clang-format off
+        #pragma HLS ARRAY_PARTITION variable=tmp_arr complete dim=1
+        // clang-format on
+        tmp_arr[0] = lp[u + 1];
+        tmp_arr[1] = lp[u] + p1;
+        tmp_arr[2] = lp[u + 2] + p1;
+        tmp_arr[3] = lp_min + p2;
+        ap_uint<2> tmini;
+        ap_uint<9> tminv;
+        xFMinSAD<4>::find(tmp_arr, tmini, tminv);
+
+        ap_uint<8> val = border ? cost[u] : (ap_uint<8>)(cost[u] + tminv - lp_min);
+        lr[u] = val;
+        if (val < block_min) block_min = val;
+    }
+    lr_min = block_min;
+}
+
+/**
+ * xFSGBMhorizontalpath : One pixel step of a horizontal path kept in lr_prev (all the disparities of the previous
+ * pixel along the path), for the disparity block b. lr_last holds the last disparity of block b-1 before its update.
+ */
+template <int NDISP, int PU>
+static void xFSGBMhorizontalpath(ap_uint<8> cost[PU],
+                                 ap_uint<8> lr_prev[NDISP],
+                                 ap_uint<8>& lr_prev_min,
+                                 ap_uint<8>& lr_acc_min,
+                                 ap_uint<8>& lr_last,
+                                 int b,
+                                 bool border,
+                                 uint8_t p1,
+                                 uint8_t p2,
+                                 ap_uint<8> lr[PU]) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    const int NB = NDISP / PU;
+    ap_uint<8> lp[PU + 2];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=lp complete dim=1
+    // clang-format on
+    lp[0] = (b == 0) ? (ap_uint<8>)(MAX_UCHAR - p1) : lr_last;
+    for (int u = 0; u < PU; u++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        lp[u + 1] = lr_prev[b * PU + u];
+    }
+    lp[PU + 1] = (b < NB - 1) ? lr_prev[b * PU + PU] : (ap_uint<8>)(MAX_UCHAR - p1);
+
+    ap_uint<8> block_min;
+    xFSGBMpathcost<PU>(cost, lp, lr_prev_min, border, p1, p2, lr, block_min);
+
+    lr_last = lr_prev[b * PU + PU - 1];
+    for (int u = 0; u < PU; u++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        lr_prev[b * PU + u] = lr[u];
+    }
+    lr_acc_min = ((b == 0) || (block_min < lr_acc_min)) ? block_min : lr_acc_min;
+    if (b == NB - 1) lr_prev_min = lr_acc_min;
+}
+
+/**
+ * xFSGBMoptimizationNPC : Aggregates the cost of NPC pixels per word along R paths: left to right, then the 135, 90
+ * and 45 degree paths from the previous row, and for R = 5 right to left. A row is swept right to left from a row
+ * buffer one row time before it is swept left to right, so the aggregated cost of row y is written while the cost of
+ * row y + 2 is read.
+ */
+template <int NDISP, int PU, int R, int NPC, int ROWS, int COLS>
+void xFSGBMoptimizationNPC(hls::stream<ap_uint<8> > _cost[NPC][PU],
+                           hls::stream<ap_uint<16> > _agg_cost[NPC][PU],
+                           int height,
+                           int width,
+                           uint8_t p1,
+                           uint8_t p2) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+
+    const int NB = NDISP / PU;
+    const int WORDS = COLS >> XF_BITSHIFT(NPC);
+    const int NPATH = 3;
+
+    // cost of the rows being read, swept right to left and swept left to right
+    ap_uint<8 * NPC> cost_buf[3][PU][NB * WORDS];
+// clang-format off
+    #pragma HLS RESOURCE variable=cost_buf core=RAM_T2P_BRAM
+    #pragma HLS ARRAY_PARTITION variable=cost_buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=cost_buf complete dim=2
+    // clang-format on
+
+    // right to left path of the rows swept right to left and left to right
+    ap_uint<8 * NPC> lrl_buf[2][PU][NB * WORDS];
+// clang-format off
+    #pragma HLS RESOURCE variable=lrl_buf core=RAM_T2P_BRAM
+    #pragma HLS ARRAY_PARTITION variable=lrl_buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=lrl_buf complete dim=2
+    // clang-format on
+
+    // 135, 90 and 45 degree paths of the previous row and their minimum, overwritten by the current row
+    ap_uint<8 * NPC> lr_buf[NPATH][PU][NB * WORDS];
+// clang-format off
+    #pragma HLS RESOURCE variable=lr_buf core=RAM_T2P_BRAM
+    #pragma HLS ARRAY_PARTITION variable=lr_buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=lr_buf complete dim=2
+    // clang-format on
+    ap_uint<8 * NPC> lr_min_buf[NPATH][WORDS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=lr_min_buf complete dim=1
+    // clang-format on
+
+    // previous row words k-1, k, k+1 and k+2 (being read) around the word k swept left to right
+    ap_uint<8 * NPC> lr_win[NPATH][4][NB][PU];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=lr_win complete dim=0
+    // clang-format on
+    ap_uint<8 * NPC> min_win[NPATH][4];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=min_win complete dim=0
+    // clang-format on
+    ap_uint<8> acc_min[NPATH][NPC];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=acc_min complete dim=0
+    // clang-format on
+
+    // horizontal paths, all the disparities of the previous pixel along the path
+    ap_uint<8> lh[NDISP], lh_min, lh_acc, lh_last;
+    ap_uint<8> rl[NDISP], rl_min, rl_acc, rl_last;
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=lh complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=rl complete dim=1
+    // clang-format on
+
+    int nwords = width >> XF_BITSHIFT(NPC);
+
+    // banks of cost_buf for the rows t, t-1 and t-2
+    ap_uint<2> in_bank = 0, rl_bank = 2, lr_bank = 1;
+
+loop_row:
+    for (int t = 0; t < height + 2; t++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS+2
+    // clang-format on
+
+    loop_col:
+        for (int j = 0; j < nwords + 2; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS/NPC+2
+        // clang-format on
+
+        loop_block:
+            for (int b = 0; b < NB; b++) {
+// clang-format off
+                #pragma HLS PIPELINE II=2
+                #pragma HLS LOOP_FLATTEN
+                #pragma HLS DEPENDENCE variable=cost_buf inter false
+                #pragma HLS DEPENDENCE variable=lrl_buf inter false
+                #pragma HLS DEPENDENCE variable=lr_buf inter false
+                #pragma HLS DEPENDENCE variable=lr_min_buf inter false
+                // clang-format on
+                bool rd = (j < nwords);
+                int k = j - 2;
+                int kb = nwords - 1 - j;
+
+                // cost of the row t
+                if (rd && (t < height)) {
+                    for (int u = 0; u < PU; u++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        ap_uint<8 * NPC> cw;
+                        for (int p = 0; p < NPC; p++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            cw.range(p * 8 + 7, p * 8) = _cost[p][u].read();
+                        }
+                        cost_buf[in_bank][u][j * NB + b] = cw;
+                    }
+                }
+
+                // previous row paths of the word j
+                if (b == 0) {
+                    for (int r = 0; r < NPATH; r++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        for (int s = 0; s < 3; s++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            min_win[r][s] = min_win[r][s + 1];
+                            for (int bb = 0; bb < NB; bb++) {
+// clang-format off
+                                #pragma HLS UNROLL
+                                // clang-format on
+                                for (int u = 0; u < PU; u++) {
+// clang-format off
+                                    #pragma HLS UNROLL
+                                    // clang-format on
+                                    lr_win[r][s][bb][u] = lr_win[r][s + 1][bb][u];
+                                }
+                            }
+                        }
+                        if (rd) min_win[r][3] = lr_min_buf[r][j];
+                    }
+                }
+                if (rd) {
+                    for (int r = 0; r < NPATH; r++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        for (int u = 0; u < PU; u++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            if (r < R - 1) lr_win[r][3][b][u] = lr_buf[r][u][j * NB + b];
+                        }
+                    }
+                }
+
+                // right to left sweep of the row t-1
+                if ((R > 4) && rd && (t >= 1) && (t <= height)) {
+                    ap_uint<8 * NPC> lw[PU];
+// clang-format off
+                    #pragma HLS ARRAY_PARTITION variable=lw complete dim=1
+                    // clang-format on
+                    for (int p = NPC - 1; p >= 0; p--) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        ap_uint<8> c[PU], l[PU];
+// clang-format off
+                        #pragma HLS ARRAY_PARTITION variable=c complete dim=1
+                        #pragma HLS ARRAY_PARTITION variable=l complete dim=1
+                        // clang-format on
+                        for (int u = 0; u < PU; u++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            c[u] = cost_buf[rl_bank][u][kb * NB + b].range(p * 8 + 7, p * 8);
+                        }
+                        bool border = (kb * NPC + p) == (width - 1);
+                        xFSGBMhorizontalpath<NDISP, PU>(c, rl, rl_min, rl_acc, rl_last, b, border, p1, p2, l);
+                        for (int u = 0; u < PU; u++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            lw[u].range(p * 8 + 7, p * 8) = l[u];
+                        }
+                    }
+                    for (int u = 0; u < PU; u++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        lrl_buf[(t - 1) & 1][u][kb * NB + b] = lw[u];
+                    }
+                }
+
+                // left to right sweep of the row t-2
+                if ((t >= 2) && (j >= 2)) {
+                    int y = t - 2;
+                    ap_uint<8 * NPC> new_w[NPATH][PU];
+// clang-format off
+                    #pragma HLS ARRAY_PARTITION variable=new_w complete dim=0
+                    // clang-format on
+
+                    for (int p = 0; p < NPC; p++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        int x = k * NPC + p;
+                        ap_uint<8> c[PU], l[PU];
+                        ap_uint<16> agg[PU];
+// clang-format off
+                        #pragma HLS ARRAY_PARTITION variable=c complete dim=1
+                        #pragma HLS ARRAY_PARTITION variable=l complete dim=1
+                        #pragma HLS ARRAY_PARTITION variable=agg complete dim=1
+                        // clang-format on
+                        for (int u = 0; u < PU; u++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            c[u] = cost_buf[lr_bank][u][k * NB + b].range(p * 8 + 7, p * 8);
+                        }
+
+                        xFSGBMhorizontalpath<NDISP, PU>(c, lh, lh_min, lh_acc, lh_last, b, x == 0, p1, p2, l);
+                        for (int u = 0; u < PU; u++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            agg[u] = l[u];
+                            if (R > 4) agg[u] += (ap_uint<8>)lrl_buf[t & 1][u][k * NB + b].range(p * 8 + 7, p * 8);
+                        }
+
+                        for (int r = 0; r < NPATH; r++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            if (r < R - 1) {
+                                // previous row pixel x-1, x or x+1, in the word k-1, k or k+1
+                                int lane = p + r - 1;
+                                int s = 1;
+                                if (lane < 0) {
+                                    lane = NPC - 1;
+                                    s = 0;
+                                } else if (lane >= NPC) {
+                                    lane = 0;
+                                    s = 2;
+                                }
+
+                                ap_uint<8> lp[PU + 2];
+// clang-format off
+                                #pragma HLS ARRAY_PARTITION variable=lp complete dim=1
+                                // clang-format on
+                                lp[0] = MAX_UCHAR - p1;
+                                lp[PU + 1] = MAX_UCHAR - p1;
+                                if (b > 0) lp[0] = lr_win[r][s][b - 1][PU - 1].range(lane * 8 + 7, lane * 8);
+                                if (b < NB - 1) lp[PU + 1] = lr_win[r][s][b + 1][0].range(lane * 8 + 7, lane * 8);
+                                for (int u = 0; u < PU; u++) {
+// clang-format off
+                                    #pragma HLS UNROLL
+                                    // clang-format on
+                                    lp[u + 1] = lr_win[r][s][b][u].range(lane * 8 + 7, lane * 8);
+                                }
+                                ap_uint<8> lp_min = min_win[r][s].range(lane * 8 + 7, lane * 8);
+
+                                bool border = (y == 0) || ((r == 0) && (x == 0)) || ((r == 2) && (x == width - 1));
+                                ap_uint<8> block_min;
+                                xFSGBMpathcost<PU>(c, lp, lp_min, border, p1, p2, l, block_min);
+
+                                for (int u = 0; u < PU; u++) {
+// clang-format off
+                                    #pragma HLS UNROLL
+                                    // clang-format on
+                                    new_w[r][u].range(p * 8 + 7, p * 8) = l[u];
+                                    agg[u] += l[u];
+                                }
+                                acc_min[r][p] = ((b == 0) || (block_min < acc_min[r][p])) ? block_min : acc_min[r][p];
+                            }
+                        }
+
+                        for (int u = 0; u < PU; u++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            _agg_cost[p][u].write(agg[u]);
+                        }
+                    }
+
+                    for (int r = 0; r < NPATH; r++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        if (r < R - 1) {
+                            for (int u = 0; u < PU; u++) {
+// clang-format off
+                                #pragma HLS UNROLL
+                                // clang-format on
+                                lr_buf[r][u][k * NB + b] = new_w[r][u];
+                            }
+                            if (b == NB - 1) {
+                                ap_uint<8 * NPC> mw;
+                                for (int p = 0; p < NPC; p++) {
+// clang-format off
+                                    #pragma HLS UNROLL
+                                    // clang-format on
+                                    mw.range(p * 8 + 7, p * 8) = acc_min[r][p];
+                                }
+                                lr_min_buf[r][k] = mw;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        ap_uint<2> tmp_bank = lr_bank;
+        lr_bank = rl_bank;
+        rl_bank = in_bank;
+        in_bank = tmp_bank;
+    }
+}
+
+/**
+ * xFSGBMsubpixel : Quadratic interpolation offset round(8 * num / den) in 1/16 pixel, for num <= den
+ */
+static ap_uint<4> xFSGBMsubpixel(ap_uint<16> num, ap_uint<16> den) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+    ap_uint<22> rem = (ap_uint<22>)num * 16 + den;
+    ap_uint<4> q = 0;
+    for (int i = 3; i >= 0; i--) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        ap_uint<22> sub = (ap_uint<22>)den << (i + 1);
+        if (rem >= sub) {
+            rem -= sub;
+            q[i] = 1;
+        }
+    }
+    return (den == 0) ? (ap_uint<4>)0 : q;
+}
+
+/**
+ * xFSGBMcomputedisparityLR : Winner takes all disparity with quadratic sub-pixel interpolation, in 1/16 pixel. The
+ * disparity of the right image, argmin_d S(x + d, d), is gathered from the same aggregated cost, and a left pixel
+ * whose disparity differs by more than lr_max_diff from the one of its right pixel is set to XF_SGBM_INVALID_DISP.
+ * The check needs the full row of right disparities, so row y is written while the cost of row y + 1 is read.
+ */
+template <int NDISP, int PU, int NPC, int ROWS, int COLS>
+void xFSGBMcomputedisparityLR(hls::stream<ap_uint<16> > _agg_cost[NPC][PU],
+                              hls::stream<ap_uint<16 * NPC> >& _dst,
+                              int height,
+                              int width,
+                              uint8_t lr_max_diff) {
+// clang-format off
+    #pragma HLS INLINE OFF
+    // clang-format on
+
+    const int NB = NDISP / PU;
+    const int WORDS = COLS >> XF_BITSHIFT(NPC);
+    // words of right pixels which may still get a cost from the next left pixels
+    const int RW = (NDISP + 2 * NPC - 2) / NPC;
+    const int W = RW * NPC;
+
+    ap_uint<16 * NPC> dl_buf[2][WORDS];
+    ap_uint<8 * NPC> dint_buf[2][WORDS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=dl_buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=dint_buf complete dim=1
+    // clang-format on
+    // right disparities, one copy per lane for the lookups of the check
+    ap_uint<8 * NPC> dr_buf[2][NPC][WORDS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=dr_buf complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=dr_buf complete dim=2
+    // clang-format on
+
+    // best cost and disparity of the right pixels s pixels left of the last pixel of the word
+    ap_uint<16> r_cost[W];
+    ap_uint<8> r_disp[W];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=r_cost complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=r_disp complete dim=1
+    // clang-format on
+
+    // best cost of the left pixels with the costs of its neighbour disparities
+    ap_uint<16> best[NPC], best_prev[NPC], best_next[NPC], last[NPC];
+    ap_uint<8> best_d[NPC];
+    bool need_next[NPC];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=best complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=best_prev complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=best_next complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=last complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=best_d complete dim=1
+    #pragma HLS ARRAY_PARTITION variable=need_next complete dim=1
+    // clang-format on
+
+    ap_uint<16 * NPC> dl_word;
+    ap_uint<8 * NPC> dint_word;
+
+    int nwords = width >> XF_BITSHIFT(NPC);
+
+loop_row:
+    for (int t = 0; t < height + 1; t++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS+1
+    // clang-format on
+
+    loop_col:
+        for (int j = 0; j < nwords + RW; j++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=COLS/NPC
+        // clang-format on
+
+        loop_block:
+            for (int b = 0; b < NB; b++) {
+// clang-format off
+                #pragma HLS PIPELINE II=1
+                #pragma HLS LOOP_FLATTEN
+                #pragma HLS DEPENDENCE variable=dl_buf inter false
+                #pragma HLS DEPENDENCE variable=dint_buf inter false
+                #pragma HLS DEPENDENCE variable=dr_buf inter false
+                // clang-format on
+                if (t < height) {
+                    if (b == 0) {
+                        // the right pixels leaving the window are final
+                        ap_uint<8 * NPC> evicted;
+                        for (int q = 0; q < NPC; q++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            evicted.range(q * 8 + 7, q * 8) = r_disp[W - 1 - q];
+                        }
+                        if (j >= RW) {
+                            for (int cp = 0; cp < NPC; cp++) {
+// clang-format off
+                                #pragma HLS UNROLL
+                                // clang-format on
+                                dr_buf[t & 1][cp][j - RW] = evicted;
+                            }
+                        }
+                        for (int s = W - 1; s >= NPC; s--) {
+                            r_cost[s] = r_cost[s - NPC];
+                            r_disp[s] = r_disp[s - NPC];
+                        }
+                        for (int s = 0; s < NPC; s++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            r_cost[s] = 0xFFFF;
+                            r_disp[s] = 0;
+                        }
+                    }
+
+                    if (j < nwords) {
+                        ap_uint<16> agg[NPC][PU];
+// clang-format off
+                        #pragma HLS ARRAY_PARTITION variable=agg complete dim=0
+                        // clang-format on
+                        for (int p = 0; p < NPC; p++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            for (int u = 0; u < PU; u++) {
+// clang-format off
+                                #pragma HLS UNROLL
+                                // clang-format on
+                                agg[p][u] = _agg_cost[p][u].read();
+                            }
+                        }
+
+                        // lane p, disparity d is the cost of the right pixel NPC - 1 - p + d
+                        for (int s = 0; s < W; s++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            for (int p = 0; p < NPC; p++) {
+// clang-format off
+                                #pragma HLS UNROLL
+                                // clang-format on
+                                int u = s - (NPC - 1 - p) - b * PU;
+                                if ((u >= 0) && (u < PU) && (agg[p][u] < r_cost[s])) {
+                                    r_cost[s] = agg[p][u];
+                                    r_disp[s] = b * PU + u;
+                                }
+                            }
+                        }
+
+                        for (int p = 0; p < NPC; p++) {
+// clang-format off
+                            #pragma HLS UNROLL
+                            // clang-format on
+                            ap_uint<8> loc;
+                            ap_uint<16> val;
+                            xFMinSAD<PU>::find(agg[p], loc, val);
+
+                            if ((b > 0) && need_next[p]) {
+                                best_next[p] = agg[p][0];
+                                need_next[p] = false;
+                            }
+                            if ((b == 0) || (val < best[p])) {
+                                best[p] = val;
+                                best_d[p] = b * PU + loc;
+                                best_prev[p] = (loc == 0) ? last[p] : agg[p][loc - 1];
+                                need_next[p] = (loc == PU - 1);
+                                if (loc < PU - 1) best_next[p] = agg[p][loc + 1];
+                            }
+                            last[p] = agg[p][PU - 1];
+
+                            if (b == NB - 1) {
+                                ap_uint<8> d = best_d[p];
+                                ap_uint<16> disp = (ap_uint<16>)d << 4;
+                                if ((d > 0) && (d < NDISP - 1)) {
+                                    ap_uint<16> den = best_prev[p] + best_next[p] - 2 * best[p];
+                                    if (best_prev[p] >= best_next[p])
+                                        disp += xFSGBMsubpixel(best_prev[p] - best_next[p], den);
+                                    else
+                                        disp -= xFSGBMsubpixel(best_next[p] - best_prev[p], den);
+                                }
+                                dl_word.range(p * 16 + 15, p * 16) = disp;
+                                dint_word.range(p * 8 + 7, p * 8) = d;
+                            }
+                        }
+                        if (b == NB - 1) {
+                            dl_buf[t & 1][j] = dl_word;
+                            dint_buf[t & 1][j] = dint_word;
+                        }
+                    }
+                }
+
+                // left right consistency check of the row t-1
+                if ((t >= 1) && (b == 0) && (j < nwords)) {
+                    ap_uint<16 * NPC> dl = dl_buf[(t - 1) & 1][j];
+                    ap_uint<8 * NPC> di = dint_buf[(t - 1) & 1][j];
+                    ap_uint<16 * NPC> out;
+                    for (int p = 0; p < NPC; p++) {
+// clang-format off
+                        #pragma HLS UNROLL
+                        // clang-format on
+                        ap_uint<8> d = di.range(p * 8 + 7, p * 8);
+                        ap_uint<16> disp = dl.range(p * 16 + 15, p * 16);
+                        int xr = j * NPC + p - d;
+                        if (xr >= 0) {
+                            int lane = xr & (NPC - 1);
+                            ap_uint<8 * NPC> rw = dr_buf[(t - 1) & 1][p][xr >> XF_BITSHIFT(NPC)];
+                            ap_uint<8> dr = rw.range(lane * 8 + 7, lane * 8);
+                            ap_uint<8> diff = (dr > d) ? (ap_uint<8>)(dr - d) : (ap_uint<8>)(d - dr);
+                            if (diff > lr_max_diff) disp = XF_SGBM_INVALID_DISP;
+                        }
+                        out.range(p * 16 + 15, p * 16) = disp;
+                    }
+                    _dst.write(out);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * SemiGlobalBMSubpixel : Semi global matching for NPC = 1, 2 or 4 pixels per clock, with up to five aggregation
+ * paths (R = 5 adds the right to left path to the four paths of SemiGlobalBM), quadratic sub-pixel interpolation,
+ * a left right consistency check and a speckle filter, in one streamed pipeline. The output is the disparity in 1/16
+ * pixel (XF_16UC1), or XF_SGBM_INVALID_DISP for the pixels rejected by the check or the filter.
+ *
+ * lr_max_diff is the largest difference between the left and the right disparity, in pixels. The speckle filter
+ * keeps a pixel which has at least speckle_min_support valid neighbours within speckle_max_diff pixels in its 5x5
+ * window, 0 disables it.
+ */
+template <int BORDER_TYPE, int WINDOW_SIZE, int NDISP, int PU, int R, int SRC_T, int DST_T, int ROWS, int COLS, int NPC>
+void SemiGlobalBMSubpixel(xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& _src_mat_l,
+                          xf::cv::Mat<SRC_T, ROWS, COLS, NPC>& _src_mat_r,
+                          xf::cv::Mat<DST_T, ROWS, COLS, NPC>& _dst_mat,
+                          uint8_t p1,
+                          uint8_t p2,
+                          uint8_t lr_max_diff,
+                          uint8_t speckle_max_diff,
+                          uint8_t speckle_min_support) {
+#ifndef __SYNTHESIS__
+    assert((BORDER_TYPE == XF_BORDER_CONSTANT) && "Only XF_BORDER_CONSTANT is supported");
+    assert((SRC_T == XF_8UC1) && " WORDWIDTH_SRC must be XF_8UC1 ");
+    assert((DST_T == XF_16UC1) && " WORDWIDTH_DST must be XF_16UC1 ");
+    assert(((NPC == XF_NPPC1) || (NPC == XF_NPPC2) || (NPC == XF_NPPC4)) &&
+           " NPC must be XF_NPPC1, XF_NPPC2 or XF_NPPC4 ");
+    assert((WINDOW_SIZE == 5) && " WSIZE must be set to '5' ");
+    assert(((NDISP > 1) && (NDISP <= 256)) && " NDISP must be greater than '1' and less than or equal to '256' ");
+    assert((NDISP >= PU) && " NDISP must not be lesser than PU (parallel units)");
+    assert((((NDISP / PU) * PU) == NDISP) && " NDISP/PU must be a non-fractional number ");
+    assert(((NPC == XF_NPPC1) || (PU == NDISP)) && " PU must be equal to NDISP for more than one pixel per clock ");
+    assert(((R >= 2) && (R <= 5)) && "Number of directions R must be '2', '3', '4' or '5' ");
+    assert((p1 < p2) && "p1 must be always less than p2");
+    assert((p2 <= 100) && "Maximum value of p2 must be 100 ");
+    assert((speckle_min_support <= 24) && "speckle_min_support must not be greater than 24");
+    assert(((_src_mat_l.rows <= ROWS) && (_src_mat_l.cols <= COLS)) &&
+           "ROWS and COLS should be greater than input image");
+    assert(((_src_mat_l.cols & (NPC - 1)) == 0) && "The image width must be a multiple of NPC");
+#endif
+
+    hls::stream<ap_uint<8 * NPC> > _src_l;
+    hls::stream<ap_uint<8 * NPC> > _src_r;
+    hls::stream<ap_uint<24 * NPC> > _census_l;
+    hls::stream<ap_uint<24 * NPC> > _census_r;
+    hls::stream<ap_uint<8> > _cost[NPC][PU];
+    hls::stream<ap_uint<16> > _agg_cost[NPC][PU];
+    hls::stream<ap_uint<16 * NPC> > _disp;
+    hls::stream<ap_uint<16 * NPC> > _dst;
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=_cost complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=_agg_cost complete dim=0
+    // clang-format on
+
+// clang-format off
+    #pragma HLS INLINE OFF
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    int height = _src_mat_l.rows;
+    int width = _src_mat_l.cols;
+    int nwords = width >> XF_BITSHIFT(NPC);
+
+    xFSGBMcensusOp census_op;
+    xFSGBMspeckleOp speckle_op;
+    speckle_op.max_diff = (ap_uint<16>)speckle_max_diff << 4;
+    speckle_op.min_support = speckle_min_support;
+
+    // Reading data from Mat to stream
+    for (int i = 0; i < height * nwords; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS*COLS/NPC
+        #pragma HLS PIPELINE
+        // clang-format on
+        _src_l.write(_src_mat_l.read(i));
+        _src_r.write(_src_mat_r.read(i));
+    }
+
+    xFSGBMwindow5x5<ROWS, COLS, NPC, 8, 24>(_src_l, _census_l, 0, census_op, height, width);
+    xFSGBMwindow5x5<ROWS, COLS, NPC, 8, 24>(_src_r, _census_r, 0, census_op, height, width);
+
+    xFSGBMcomputecostNPC<NDISP, PU, NPC, ROWS, COLS>(_census_l, _census_r, _cost, height, width);
+
+    xFSGBMoptimizationNPC<NDISP, PU, R, NPC, ROWS, COLS>(_cost, _agg_cost, height, width, p1, p2);
+
+    xFSGBMcomputedisparityLR<NDISP, PU, NPC, ROWS, COLS>(_agg_cost, _disp, height, width, lr_max_diff);
+
+    xFSGBMwindow5x5<ROWS, COLS, NPC, 16, 16>(_disp, _dst, XF_SGBM_INVALID_DISP, speckle_op, height, width);
+
+    // write back from stream to Mat
+    for (int i = 0; i < height * nwords; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=ROWS*COLS/NPC
+        #pragma HLS PIPELINE
+        // clang-format on
+        _dst_mat.write(i, _dst.read());
+    }
+}
 } // namespace cv
 } // namespace xf
 #endif
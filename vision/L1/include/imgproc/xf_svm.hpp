@@ -93,6 +93,30 @@ void SVM(xf::cv::Mat<SRC1_T, ROWS1, COLS1, NPC>& in_1,
 
     *result = svm_res;
 }
+
+/**
+ * Dot product of N packed W-bit unsigned features with N signed weights in
+ * one cycle, for linear SVMs fed one feature vector per clock, e.g. the HOG
+ * blocks of a sliding window detector. The result has the fraction bits of
+ * the features plus those of the weights.
+ */
+template <int N, int W, int WW, int OW>
+ap_int<OW> xfSVMDot(ap_uint<N * W> feat, ap_int<WW> weights[N]) {
+// clang-format off
+    #pragma HLS INLINE
+    // clang-format on
+
+    ap_int<OW> result = 0;
+svmDotLoop:
+    for (int i = 0; i < N; i++) {
+// clang-format off
+        #pragma HLS UNROLL
+        // clang-format on
+        ap_uint<W> f = feat.range(i * W + W - 1, i * W);
+        result += (ap_int<W + WW + 1>)(f * weights[i]);
+    }
+    return result;
+}
 } // namespace cv
 } // namespace xf
 #endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xf_clahe_config.h"
+
+static void histRead(unsigned int* hist_in, hls::stream<unsigned int>& hist) {
+    for (int i = 0; i < HIST_SIZE; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        hist.write(hist_in[i]);
+    }
+}
+
+static void histWrite(hls::stream<unsigned int>& hist, unsigned int* hist_out) {
+    for (int i = 0; i < HIST_SIZE; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        hist_out[i] = hist.read();
+    }
+}
+
+extern "C" {
+
+void clahe_accel(ap_uint<INPUT_PTR_WIDTH>* img_in,
+                 unsigned int* hist_in,
+                 unsigned int* hist_out,
+                 ap_uint<OUTPUT_PTR_WIDTH>* img_out,
+                 float clip_limit,
+                 int rows,
+                 int cols) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=hist_in       offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=hist_out      offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=img_out       offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE s_axilite  port=clip_limit                  bundle=control
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgInput(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgOutput(rows, cols);
+
+    // Tile histograms of the previous frame in, of the current frame out
+    hls::stream<unsigned int> histIn;
+    hls::stream<unsigned int> histOut;
+
+// clang-format off
+    #pragma HLS STREAM variable=imgInput.data depth=2
+    #pragma HLS STREAM variable=imgOutput.data depth=2
+    #pragma HLS STREAM variable=histIn depth=2
+    #pragma HLS STREAM variable=histOut depth=2
+    // clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    histRead(hist_in, histIn);
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(img_in, imgInput);
+    xf::cv::clahe<IN_TYPE, HEIGHT, WIDTH, NPC1, CLAHE_TILES_Y, CLAHE_TILES_X>(imgInput, imgOutput, histIn, histOut,
+                                                                             clip_limit);
+    xf::cv::xfMat2Array<OUTPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgOutput, img_out);
+    histWrite(histOut, hist_out);
+
+    return;
+} // End of kernel
+
+} // End of extern C
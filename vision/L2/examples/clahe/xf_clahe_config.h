@@ -0,0 +1,34 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_CLAHE_CONFIG_H_
+#define _XF_CLAHE_CONFIG_H_
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "imgproc/xf_clahe.hpp"
+#include "xf_config_params.h"
+
+#define IN_TYPE XF_8UC1
+#define NPC1 NPPC
+
+// Tile histograms exchanged between consecutive frames
+#define HIST_SIZE (CLAHE_TILES_Y * CLAHE_TILES_X * XF_CLAHE_BINS)
+
+#endif // _XF_CLAHE_CONFIG_H_
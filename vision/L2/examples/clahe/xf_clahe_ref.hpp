@@ -0,0 +1,108 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_CLAHE_REF_HPP_
+#define _XF_CLAHE_REF_HPP_
+
+#include <vector>
+
+// Model of xf::cv::clahe with the same integer arithmetic, one frame at a time
+
+static int refFloorDiv(int a, int b) {
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+static void refClahe(const unsigned char* src,
+                     unsigned char* dst,
+                     const std::vector<unsigned int>& hist_in,
+                     std::vector<unsigned int>& hist_out,
+                     int rows,
+                     int cols,
+                     int tiles_y,
+                     int tiles_x,
+                     int npc,
+                     float clip_limit) {
+    int th = (rows + tiles_y - 1) / tiles_y;
+    int tw = (cols + tiles_x - 1) / tiles_x;
+    tw = ((tw + npc - 1) / npc) * npc;
+
+    // Tile LUTs from the histograms of the previous frame
+    unsigned int clip_q8 = (clip_limit > 0.0f) ? (unsigned int)(clip_limit * 256.0f + 0.5f) : 0;
+    std::vector<unsigned char> lut(tiles_y * tiles_x * 256);
+    for (int t = 0; t < tiles_y * tiles_x; t++) {
+        int ty = t / tiles_x, tx = t % tiles_x;
+        unsigned long long area = (unsigned long long)((ty == tiles_y - 1) ? rows - ty * th : th) *
+                                  ((tx == tiles_x - 1) ? cols - tx * tw : tw);
+        unsigned long long limit = clip_q8 ? (clip_q8 * area) >> 16 : area;
+        if (limit < 1) limit = 1;
+
+        unsigned long long count = 0, excess = 0;
+        std::vector<unsigned long long> h(256);
+        for (int b = 0; b < 256; b++) {
+            h[b] = hist_in[t * 256 + b];
+            count += h[b];
+            if (h[b] > limit) {
+                excess += h[b] - limit;
+                h[b] = limit;
+            }
+        }
+        int residual = excess % 256;
+        for (int b = 0; b < 256; b++) h[b] += excess / 256;
+        if (residual) {
+            int step = 256 / residual;
+            for (int b = 0; (b < 256) && (residual > 0); b += step, residual--) h[b]++;
+        }
+
+        unsigned long long cdf = 0;
+        for (int b = 0; b < 256; b++) {
+            cdf += h[b];
+            unsigned long long l = (2 * cdf * 255 + area) / (2 * area);
+            lut[t * 256 + b] = (count == 0) ? b : ((l > 255) ? 255 : l);
+        }
+    }
+
+    // Bilinear interpolation of the LUTs, the tile centers are at (t + 0.5) * tile size
+    for (int y = 0; y < rows; y++) {
+        int ty1 = refFloorDiv(2 * y - th, 2 * th);
+        int ny = 2 * y - th - 2 * th * ty1;
+        int ty_lo = (ty1 < 0) ? 0 : ty1;
+        int ty_hi = (ty1 + 1 > tiles_y - 1) ? tiles_y - 1 : ty1 + 1;
+        for (int x = 0; x < cols; x++) {
+            int tx1 = refFloorDiv(2 * x - tw, 2 * tw);
+            int nx = 2 * x - tw - 2 * tw * tx1;
+            int tx_lo = (tx1 < 0) ? 0 : tx1;
+            int tx_hi = (tx1 + 1 > tiles_x - 1) ? tiles_x - 1 : tx1 + 1;
+            int v = src[y * cols + x];
+            unsigned long long top = lut[(ty_lo * tiles_x + tx_lo) * 256 + v] * (unsigned long long)(2 * tw - nx) +
+                                     lut[(ty_lo * tiles_x + tx_hi) * 256 + v] * (unsigned long long)nx;
+            unsigned long long bottom = lut[(ty_hi * tiles_x + tx_lo) * 256 + v] * (unsigned long long)(2 * tw - nx) +
+                                        lut[(ty_hi * tiles_x + tx_hi) * 256 + v] * (unsigned long long)nx;
+            unsigned long long d = 4ULL * th * tw;
+            dst[y * cols + x] = (top * (2 * th - ny) + bottom * ny + d / 2) / d;
+        }
+    }
+
+    // Histograms of the current frame
+    hist_out.assign(tiles_y * tiles_x * 256, 0);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            hist_out[((y / th) * tiles_x + x / tw) * 256 + src[y * cols + x]]++;
+        }
+    }
+}
+
+#endif // _XF_CLAHE_REF_HPP_
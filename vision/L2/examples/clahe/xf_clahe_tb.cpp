@@ -0,0 +1,173 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "common/xf_headers.hpp"
+#include "xf_clahe_config.h"
+#include "xf_clahe_ref.hpp"
+#include "xcl2.hpp"
+
+#define NUM_FRAMES 3
+
+// Brightness of each frame, the last one repeats the previous one
+static const double gains[NUM_FRAMES] = {0.25, 0.375, 0.375};
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <INPUT IMAGE PATH 1>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_img = cv::imread(argv[1], 0);
+    if (!in_img.data) {
+        fprintf(stderr, "ERROR: Cannot open image %s\n ", argv[1]);
+        return EXIT_FAILURE;
+    }
+    int rows = in_img.rows;
+    int cols = in_img.cols;
+    assert((rows <= HEIGHT) && (cols <= WIDTH) && "Image larger than the kernel maximum");
+    assert((cols % XF_NPIXPERCYCLE(NPC1) == 0) && "Image width must be a multiple of NPC");
+
+    float clip_limit = CLIP_LIMIT;
+
+    size_t image_size_bytes = rows * cols * sizeof(unsigned char);
+    size_t hist_size_bytes = HIST_SIZE * sizeof(unsigned int);
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_clahe");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "clahe_accel", &err));
+
+    // Allocate the buffers, the tile histograms ping-pong between the frames:
+    OCL_CHECK(err, cl::Buffer buffer_inImage(context, CL_MEM_READ_ONLY, image_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outImage(context, CL_MEM_WRITE_ONLY, image_size_bytes, NULL, &err));
+    cl::Buffer buffer_hist[2];
+    for (int i = 0; i < 2; i++) {
+        OCL_CHECK(err, buffer_hist[i] = cl::Buffer(context, CL_MEM_READ_WRITE, hist_size_bytes, NULL, &err));
+    }
+
+    // No histograms before the first frame, which is left unchanged
+    std::vector<unsigned int> hist(HIST_SIZE, 0);
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_hist[0], CL_TRUE, 0, hist_size_bytes, hist.data()));
+
+    // Reference state
+    std::vector<unsigned int> ref_hist(HIST_SIZE, 0), ref_next;
+    cv::Mat frame(rows, cols, CV_8UC1), out_img(rows, cols, CV_8UC1), ref_img(rows, cols, CV_8UC1);
+    cv::Mat ocv_img(rows, cols, CV_8UC1);
+    int errors = 0;
+
+    // OpenCV pads the image to a whole number of tiles, the kernel has a smaller last tile instead
+    bool ocv_check = (rows % CLAHE_TILES_Y == 0) && (cols % CLAHE_TILES_X == 0);
+    cv::Ptr<cv::CLAHE> ocv_clahe = cv::createCLAHE(clip_limit, cv::Size(CLAHE_TILES_X, CLAHE_TILES_Y));
+
+    for (int f = 0; f < NUM_FRAMES; f++) {
+        // Low light sequence: the input image darkened
+        in_img.convertTo(frame, CV_8UC1, gains[f]);
+        OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inImage, CL_TRUE, 0, image_size_bytes, frame.data));
+
+        // Set kernel arguments:
+        OCL_CHECK(err, err = kernel.setArg(0, buffer_inImage));
+        OCL_CHECK(err, err = kernel.setArg(1, buffer_hist[f & 1]));
+        OCL_CHECK(err, err = kernel.setArg(2, buffer_hist[(f + 1) & 1]));
+        OCL_CHECK(err, err = kernel.setArg(3, buffer_outImage));
+        OCL_CHECK(err, err = kernel.setArg(4, clip_limit));
+        OCL_CHECK(err, err = kernel.setArg(5, rows));
+        OCL_CHECK(err, err = kernel.setArg(6, cols));
+
+        // Profiling Objects
+        cl_ulong start = 0;
+        cl_ulong end = 0;
+        double diff_prof = 0.0f;
+        cl::Event event;
+
+        // Launch the kernel
+        OCL_CHECK(err, err = q.enqueueTask(kernel, NULL, &event));
+        clWaitForEvents(1, (const cl_event*)&event);
+
+        event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+        event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+        diff_prof = end - start;
+        std::cout << "INFO: Frame " << f << " " << (diff_prof / 1000000) << "ms" << std::endl;
+
+        OCL_CHECK(err, q.enqueueReadBuffer(buffer_outImage, CL_TRUE, 0, image_size_bytes, out_img.data));
+        OCL_CHECK(err, q.enqueueReadBuffer(buffer_hist[(f + 1) & 1], CL_TRUE, 0, hist_size_bytes, hist.data()));
+
+        // Reference model, with the histograms of its own previous frame
+        refClahe(frame.data, ref_img.data, ref_hist, ref_next, rows, cols, CLAHE_TILES_Y, CLAHE_TILES_X,
+                 XF_NPIXPERCYCLE(NPC1), clip_limit);
+        ref_hist = ref_next;
+
+        int pix_errors = 0;
+        for (int i = 0; i < rows * cols; i++) {
+            if (out_img.data[i] != ref_img.data[i]) pix_errors++;
+        }
+        int hist_errors = 0;
+        for (int i = 0; i < HIST_SIZE; i++) {
+            if (hist[i] != ref_hist[i]) hist_errors++;
+        }
+        std::cout << "INFO: Frame " << f << " " << pix_errors << " pixel errors, " << hist_errors
+                  << " histogram errors" << std::endl;
+        if (pix_errors || hist_errors) errors++;
+
+        // With the LUTs of the same frame, OpenCV matches up to the rounding of the interpolation
+        if (ocv_check && (f > 0) && (gains[f] == gains[f - 1])) {
+            ocv_clahe->apply(frame, ocv_img);
+            int ocv_diff = 0, ocv_errors = 0;
+            for (int i = 0; i < rows * cols; i++) {
+                int d = std::abs((int)out_img.data[i] - (int)ocv_img.data[i]);
+                if (d > 0) ocv_diff++;
+                if (d > 1) ocv_errors++;
+            }
+            std::cout << "INFO: Frame " << f << " " << ocv_diff << " pixels differ from OpenCV, " << ocv_errors
+                      << " by more than 1" << std::endl;
+            if (ocv_errors || (ocv_diff > rows * cols / 100)) errors++;
+        }
+
+        if (f == NUM_FRAMES - 1) {
+            cv::imwrite("input.png", frame);
+            cv::imwrite("hls_out.png", out_img);
+            cv::imwrite("ref_out.png", ref_img);
+        }
+    }
+
+    q.finish();
+
+    if (errors) {
+        fprintf(stderr, "ERROR: Test Failed.\n ");
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "xf_connected_components_config.h"
+
+static void blobList(xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1>& mask,
+                     unsigned int* blobs,
+                     int* num_out,
+                     int max_blobs,
+                     int min_area) {
+    int num;
+    xf::cv::connectedComponents<IN_TYPE, HEIGHT, WIDTH, NPC1>(mask, blobs, num, max_blobs, min_area);
+    *num_out = num;
+}
+
+extern "C" {
+
+void connectedcomponents_accel(ap_uint<INPUT_PTR_WIDTH>* img_in,
+                               unsigned int* blobs,
+                               int* num_out,
+                               unsigned char thresh,
+                               int min_area,
+                               int max_blobs,
+                               int rows,
+                               int cols) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=blobs         offset=slave  bundle=gmem1  depth=BLOBS_SIZE
+    #pragma HLS INTERFACE m_axi      port=num_out       offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE s_axilite  port=thresh                      bundle=control
+    #pragma HLS INTERFACE s_axilite  port=min_area                    bundle=control
+    #pragma HLS INTERFACE s_axilite  port=max_blobs                   bundle=control
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgInput(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> mask(rows, cols);
+
+// clang-format off
+    #pragma HLS STREAM variable=imgInput.data depth=2
+    #pragma HLS STREAM variable=mask.data depth=2
+    // clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    // The mask stays on the device, only the blob list is written back
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(img_in, imgInput);
+    xf::cv::Threshold<XF_THRESHOLD_TYPE_BINARY, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgInput, mask, thresh, 255);
+    blobList(mask, blobs, num_out, max_blobs, min_area);
+
+    return;
+} // End of kernel
+
+} // End of extern C
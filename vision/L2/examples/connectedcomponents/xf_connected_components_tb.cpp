@@ -0,0 +1,194 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "common/xf_headers.hpp"
+#include "xf_connected_components_config.h"
+#include "xcl2.hpp"
+
+#define THRESH 128
+#define MIN_AREA 4
+
+struct Blob {
+    int area, left, top, right, bottom;
+    double cx, cy;
+    bool operator<(const Blob& b) const {
+        if (top != b.top) return top < b.top;
+        if (left != b.left) return left < b.left;
+        return area < b.area;
+    }
+};
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <INPUT IMAGE PATH 1>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_img = cv::imread(argv[1], 0);
+    if (!in_img.data) {
+        fprintf(stderr, "ERROR: Cannot open image %s\n ", argv[1]);
+        return EXIT_FAILURE;
+    }
+    if ((in_img.rows > HEIGHT) || (in_img.cols > WIDTH)) {
+        cv::resize(in_img, in_img, cv::Size(WIDTH, HEIGHT));
+    }
+    int rows = in_img.rows;
+    int cols = in_img.cols;
+
+    unsigned char thresh = THRESH;
+    int min_area = MIN_AREA;
+    int max_blobs = MAX_BLOBS;
+
+    size_t image_in_size_bytes = rows * cols * sizeof(unsigned char);
+    size_t blobs_size_bytes = BLOBS_SIZE * sizeof(unsigned int);
+
+    std::vector<unsigned int> blobs(BLOBS_SIZE);
+    int num = 0;
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_connectedcomponents");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "connectedcomponents_accel", &err));
+
+    // Allocate the buffers:
+    OCL_CHECK(err, cl::Buffer buffer_inImage(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outBlobs(context, CL_MEM_WRITE_ONLY, blobs_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outNum(context, CL_MEM_WRITE_ONLY, sizeof(int), NULL, &err));
+
+    // Set kernel arguments:
+    OCL_CHECK(err, err = kernel.setArg(0, buffer_inImage));
+    OCL_CHECK(err, err = kernel.setArg(1, buffer_outBlobs));
+    OCL_CHECK(err, err = kernel.setArg(2, buffer_outNum));
+    OCL_CHECK(err, err = kernel.setArg(3, thresh));
+    OCL_CHECK(err, err = kernel.setArg(4, min_area));
+    OCL_CHECK(err, err = kernel.setArg(5, max_blobs));
+    OCL_CHECK(err, err = kernel.setArg(6, rows));
+    OCL_CHECK(err, err = kernel.setArg(7, cols));
+
+    // Initialize the buffers:
+    cl::Event event;
+
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inImage, CL_TRUE, 0, image_in_size_bytes, in_img.data));
+
+    // Profiling Objects
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    double diff_prof = 0.0f;
+
+    // Launch the kernel
+    OCL_CHECK(err, err = q.enqueueTask(kernel, NULL, &event));
+    clWaitForEvents(1, (const cl_event*)&event);
+
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    diff_prof = end - start;
+    std::cout << (diff_prof / 1000000) << "ms" << std::endl;
+
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outNum, CL_TRUE, 0, sizeof(int), &num));
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outBlobs, CL_TRUE, 0, blobs_size_bytes, blobs.data()));
+
+    q.finish();
+
+    std::vector<Blob> hls_blobs(num);
+    for (int i = 0; i < num; i++) {
+        unsigned int* b = &blobs[i * XF_CCL_BLOB_SIZE];
+        Blob& h = hls_blobs[i];
+        h.area = b[XF_CCL_AREA];
+        h.top = b[XF_CCL_TOP_LEFT] >> 16;
+        h.left = b[XF_CCL_TOP_LEFT] & 0xFFFF;
+        h.bottom = b[XF_CCL_BOTTOM_RIGHT] >> 16;
+        h.right = b[XF_CCL_BOTTOM_RIGHT] & 0xFFFF;
+        h.cx = b[XF_CCL_CENTROID_X] / 65536.0;
+        h.cy = b[XF_CCL_CENTROID_Y] / 65536.0;
+    }
+
+    // Reference:
+    cv::Mat mask, labels, stats, centroids;
+    cv::threshold(in_img, mask, thresh, 255, cv::THRESH_BINARY);
+    int n = cv::connectedComponentsWithStats(mask, labels, stats, centroids, 8, CV_32S);
+    std::vector<Blob> ref_blobs;
+    for (int l = 1; l < n; l++) {
+        Blob r;
+        r.area = stats.at<int>(l, cv::CC_STAT_AREA);
+        if (r.area < min_area) continue;
+        r.left = stats.at<int>(l, cv::CC_STAT_LEFT);
+        r.top = stats.at<int>(l, cv::CC_STAT_TOP);
+        r.right = r.left + stats.at<int>(l, cv::CC_STAT_WIDTH) - 1;
+        r.bottom = r.top + stats.at<int>(l, cv::CC_STAT_HEIGHT) - 1;
+        r.cx = centroids.at<double>(l, 0);
+        r.cy = centroids.at<double>(l, 1);
+        ref_blobs.push_back(r);
+    }
+
+    std::sort(hls_blobs.begin(), hls_blobs.end());
+    std::sort(ref_blobs.begin(), ref_blobs.end());
+
+    std::cout << "INFO: " << num << " blobs, " << ref_blobs.size() << " expected" << std::endl;
+    int errors = 0;
+    if ((int)ref_blobs.size() > max_blobs) {
+        std::cout << "ERROR: More blobs than the list holds" << std::endl;
+        errors++;
+    } else if (hls_blobs.size() != ref_blobs.size()) {
+        errors++;
+    } else {
+        for (int i = 0; i < num; i++) {
+            const Blob& h = hls_blobs[i];
+            const Blob& r = ref_blobs[i];
+            if ((h.area != r.area) || (h.left != r.left) || (h.top != r.top) || (h.right != r.right) ||
+                (h.bottom != r.bottom) || (fabs(h.cx - r.cx) > 1e-4) || (fabs(h.cy - r.cy) > 1e-4)) {
+                std::cout << "ERROR: Blob " << i << " at (" << h.left << ", " << h.top << "), expected (" << r.left
+                          << ", " << r.top << ")" << std::endl;
+                errors++;
+            }
+        }
+    }
+
+    cv::Mat out_img;
+    cv::cvtColor(mask, out_img, cv::COLOR_GRAY2BGR);
+    for (int i = 0; i < num; i++) {
+        const Blob& h = hls_blobs[i];
+        cv::rectangle(out_img, cv::Point(h.left, h.top), cv::Point(h.right, h.bottom), cv::Scalar(0, 0, 255));
+    }
+    cv::imwrite("hls_out.png", out_img);
+
+    if (errors) {
+        fprintf(stderr, "ERROR: Test Failed.\n ");
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
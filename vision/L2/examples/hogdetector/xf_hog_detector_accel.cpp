@@ -0,0 +1,61 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xf_hog_detector_config.h"
+
+extern "C" {
+
+void hog_detector_accel(ap_uint<PTR_WIDTH>* img_in,
+                        ap_uint<PTR_WIDTH>* img_pyr,
+                        short* weights,
+                        float bias,
+                        float threshold,
+                        float overlap,
+                        int* det_out,
+                        int* num_out,
+                        int max_det,
+                        int rows,
+                        int cols) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=img_pyr       offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=weights       offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=det_out       offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE m_axi      port=num_out       offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE s_axilite  port=bias                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=threshold                   bundle=control
+    #pragma HLS INTERFACE s_axilite  port=overlap                     bundle=control
+    #pragma HLS INTERFACE s_axilite  port=max_det                     bundle=control
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    int num;
+
+    // img_in and img_pyr are the same buffer: the frame followed by the smaller pyramid levels
+    xf::cv::HOGDetectMultiScale<PTR_WIDTH, XF_WIN_HEIGHT, XF_WIN_WIDTH, XF_BLOCK_HEIGHT, XF_BLOCK_WIDTH, XF_CELL_HEIGHT,
+                                XF_CELL_WIDTH, XF_NO_OF_BINS, NUM_LEVELS, WFRAC, MAXCAND, MAXDET, XF_INPUT_COLOR, TYPE,
+                                HEIGHT, WIDTH, XF_USE_URAM>(img_in, img_pyr, weights, bias, threshold, overlap,
+                                                            det_out, num, max_det, rows, cols);
+
+    *num_out = num;
+
+    return;
+} // End of kernel
+
+} // End of extern C
@@ -0,0 +1,45 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_HOG_DETECTOR_CONFIG_H_
+#define _XF_HOG_DETECTOR_CONFIG_H_
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "imgproc/xf_hog_detector.hpp"
+#include "xf_config_params.h"
+
+// Window, block and cell sizes of Dalal and Triggs
+#define XF_WIN_HEIGHT 128
+#define XF_WIN_WIDTH 64
+#define XF_BLOCK_HEIGHT 16
+#define XF_BLOCK_WIDTH 16
+#define XF_CELL_HEIGHT 8
+#define XF_CELL_WIDTH 8
+#define XF_NO_OF_BINS 9
+
+#define XF_NOBPB (XF_NO_OF_BINS * (XF_BLOCK_HEIGHT / XF_CELL_HEIGHT) * (XF_BLOCK_WIDTH / XF_CELL_WIDTH))
+#define XF_NOVBPW ((XF_WIN_HEIGHT / XF_CELL_HEIGHT) - 1)
+#define XF_NOHBPW ((XF_WIN_WIDTH / XF_CELL_WIDTH) - 1)
+#define XF_NOWEIGHTS (XF_NOBPB * XF_NOVBPW * XF_NOHBPW)
+
+#define TYPE XF_8UC1
+#define XF_INPUT_COLOR XF_GRAY
+
+#endif // _XF_HOG_DETECTOR_CONFIG_H_
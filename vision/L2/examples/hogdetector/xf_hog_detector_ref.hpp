@@ -0,0 +1,139 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_HOG_DETECTOR_REF_HPP_
+#define _XF_HOG_DETECTOR_REF_HPP_
+
+#include <math.h>
+#include <vector>
+
+// Floating point model of the detector
+
+struct RefDetection {
+    int x, y, width, height;
+    float score;
+};
+
+// HOG of the kernel: [-1 0 1] gradients with a zero border, unsigned orientation interpolated between the two
+// nearest bins only, L2-Hys normalized blocks of 2x2 cells one cell apart, cells in column major order. Only the
+// whole cells of the frame are taken.
+static void refHOGBlocks(const cv::Mat& img, std::vector<float>& blocks, int& novb, int& nohb) {
+    int ncy = img.rows / XF_CELL_HEIGHT, ncx = img.cols / XF_CELL_WIDTH;
+    int rows = ncy * XF_CELL_HEIGHT, cols = ncx * XF_CELL_WIDTH;
+    std::vector<float> hist(ncy * ncx * XF_NO_OF_BINS, 0.0f);
+    auto p = [&](int y, int x) -> int {
+        return (y < 0 || y >= rows || x < 0 || x >= cols) ? 0 : img.at<unsigned char>(y, x);
+    };
+
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int gx = p(y, x + 1) - p(y, x - 1);
+            int gy = p(y + 1, x) - p(y - 1, x);
+            float m = sqrtf((float)(gx * gx + gy * gy));
+            float a = atan2f((float)gy, (float)gx) * 180.0f / (float)M_PI;
+            if (a < 0) a += 180.0f;
+            if (a >= 180.0f) a -= 180.0f;
+            float f = a / 20.0f - 0.5f;
+            int b0 = (int)floorf(f);
+            float w1 = f - b0;
+            int b1 = (b0 + 1) % XF_NO_OF_BINS;
+            if (b0 < 0) b0 += XF_NO_OF_BINS;
+            float* h = &hist[((y / XF_CELL_HEIGHT) * ncx + x / XF_CELL_WIDTH) * XF_NO_OF_BINS];
+            h[b0] += m * (1.0f - w1);
+            h[b1] += m * w1;
+        }
+    }
+
+    novb = ncy - 1;
+    nohb = ncx - 1;
+    blocks.resize(novb * nohb * XF_NOBPB);
+    for (int by = 0; by < novb; by++) {
+        for (int bx = 0; bx < nohb; bx++) {
+            float* v = &blocks[(by * nohb + bx) * XF_NOBPB];
+            for (int cx = 0; cx < 2; cx++)
+                for (int cy = 0; cy < 2; cy++)
+                    for (int b = 0; b < XF_NO_OF_BINS; b++)
+                        v[(cx * 2 + cy) * XF_NO_OF_BINS + b] = hist[((by + cy) * ncx + bx + cx) * XF_NO_OF_BINS + b];
+
+            float s = 0;
+            for (int k = 0; k < XF_NOBPB; k++) s += v[k] * v[k];
+            float n = 1.0f / (sqrtf(s) + 0.1f * XF_NOBPB);
+            s = 0;
+            for (int k = 0; k < XF_NOBPB; k++) {
+                v[k] = (v[k] * n > 0.2f) ? 0.2f : v[k] * n;
+                s += v[k] * v[k];
+            }
+            n = 1.0f / (sqrtf(s) + 1e-3f);
+            for (int k = 0; k < XF_NOBPB; k++) v[k] *= n;
+        }
+    }
+}
+
+static float refIoU(const RefDetection& a, const RefDetection& b) {
+    int iw = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+    int ih = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+    float inter = (iw > 0 && ih > 0) ? (float)iw * ih : 0.0f;
+    return inter / ((float)a.width * a.height + (float)b.width * b.height - inter);
+}
+
+// Windows one cell apart on the levels of a pyrDown pyramid, then greedy non-maximum suppression. weights holds the
+// blocks of the window in raster order.
+static void refHOGDetect(const cv::Mat& img,
+                         const std::vector<float>& weights,
+                         float bias,
+                         float threshold,
+                         float overlap,
+                         int max_det,
+                         std::vector<RefDetection>& dets) {
+    std::vector<RefDetection> cand;
+    cv::Mat level = img;
+    for (int l = 0; l < NUM_LEVELS && level.rows >= XF_WIN_HEIGHT && level.cols >= XF_WIN_WIDTH; l++) {
+        std::vector<float> blocks;
+        int novb, nohb;
+        refHOGBlocks(level, blocks, novb, nohb);
+        for (int wy = 0; wy + XF_NOVBPW <= novb; wy++) {
+            for (int wx = 0; wx + XF_NOHBPW <= nohb; wx++) {
+                double s = bias;
+                for (int y = 0; y < XF_NOVBPW; y++)
+                    for (int x = 0; x < XF_NOHBPW; x++)
+                        for (int k = 0; k < XF_NOBPB; k++)
+                            s += blocks[((wy + y) * nohb + wx + x) * XF_NOBPB + k] *
+                                 weights[(y * XF_NOHBPW + x) * XF_NOBPB + k];
+                if (s > threshold)
+                    cand.push_back({(wx * XF_CELL_WIDTH) << l, (wy * XF_CELL_HEIGHT) << l, XF_WIN_WIDTH << l,
+                                    XF_WIN_HEIGHT << l, (float)s});
+            }
+        }
+        cv::Mat next;
+        cv::pyrDown(level, next, cv::Size((level.cols + 1) >> 1, (level.rows + 1) >> 1), cv::BORDER_REPLICATE);
+        level = next;
+    }
+
+    dets.clear();
+    std::vector<bool> alive(cand.size(), true);
+    while ((int)dets.size() < max_det) {
+        int best = -1;
+        for (size_t i = 0; i < cand.size(); i++)
+            if (alive[i] && (best < 0 || cand[i].score > cand[best].score)) best = i;
+        if (best < 0) break;
+        dets.push_back(cand[best]);
+        for (size_t i = 0; i < cand.size(); i++)
+            if (alive[i] && ((int)i == best || refIoU(cand[i], cand[best]) > overlap)) alive[i] = false;
+    }
+}
+
+#endif // _XF_HOG_DETECTOR_REF_HPP_
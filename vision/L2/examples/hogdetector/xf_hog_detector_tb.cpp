@@ -0,0 +1,181 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "common/xf_headers.hpp"
+#include "opencv2/objdetect/objdetect.hpp"
+#include "xf_hog_detector_config.h"
+#include "xf_hog_detector_ref.hpp"
+#include "xcl2.hpp"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <INPUT IMAGE PATH 1>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_img = cv::imread(argv[1], 0);
+    if (!in_img.data) {
+        fprintf(stderr, "ERROR: Cannot open image %s\n ", argv[1]);
+        return EXIT_FAILURE;
+    }
+    int rows = in_img.rows;
+    int cols = in_img.cols;
+    assert((rows <= HEIGHT) && (cols <= WIDTH) && "Image larger than the kernel maximum");
+
+    // Pedestrian SVM of OpenCV, its blocks in column major order, reordered to raster order and quantized
+    std::vector<float> svm = cv::HOGDescriptor::getDefaultPeopleDetector();
+    assert((svm.size() == XF_NOWEIGHTS + 1) && "Unexpected size of the people detector");
+    std::vector<short> weights(XF_NOWEIGHTS);
+    std::vector<float> ref_weights(XF_NOWEIGHTS);
+    for (int y = 0; y < XF_NOVBPW; y++) {
+        for (int x = 0; x < XF_NOHBPW; x++) {
+            for (int k = 0; k < XF_NOBPB; k++) {
+                int i = (y * XF_NOHBPW + x) * XF_NOBPB + k;
+                float v = roundf(svm[(x * XF_NOVBPW + y) * XF_NOBPB + k] * (1 << WFRAC));
+                weights[i] = (short)std::max(-32768.0f, std::min(32767.0f, v));
+                ref_weights[i] = (float)weights[i] / (1 << WFRAC);
+            }
+        }
+    }
+    float bias = svm[XF_NOWEIGHTS];
+    float threshold = 0.0f;
+    float overlap = 0.5f;
+    int max_det = MAXDET;
+
+    // The frame followed by room for the pyramid levels, each starting on a PTR_WIDTH word
+    size_t word_bytes = PTR_WIDTH / 8;
+    size_t pyr_size_bytes = 0;
+    for (int l = 0, r = rows, c = cols; l <= NUM_LEVELS; l++, r = (r + 1) >> 1, c = (c + 1) >> 1) {
+        pyr_size_bytes += ((r * c + word_bytes - 1) / word_bytes) * word_bytes;
+    }
+    std::vector<unsigned char> pyr(pyr_size_bytes, 0);
+    memcpy(pyr.data(), in_img.data, rows * cols);
+
+    size_t weights_size_bytes = XF_NOWEIGHTS * sizeof(short);
+    size_t det_size_bytes = MAXDET * xf::cv::XF_HOG_DET_SIZE * sizeof(int);
+    std::vector<int> det(MAXDET * xf::cv::XF_HOG_DET_SIZE);
+    int num = 0;
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_hogdetector");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "hog_detector_accel", &err));
+
+    // Allocate the buffers:
+    OCL_CHECK(err, cl::Buffer buffer_pyr(context, CL_MEM_READ_WRITE, pyr_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_weights(context, CL_MEM_READ_ONLY, weights_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_det(context, CL_MEM_WRITE_ONLY, det_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_num(context, CL_MEM_WRITE_ONLY, sizeof(int), NULL, &err));
+
+    // Set kernel arguments, the pyramid buffer on both of its ports:
+    OCL_CHECK(err, err = kernel.setArg(0, buffer_pyr));
+    OCL_CHECK(err, err = kernel.setArg(1, buffer_pyr));
+    OCL_CHECK(err, err = kernel.setArg(2, buffer_weights));
+    OCL_CHECK(err, err = kernel.setArg(3, bias));
+    OCL_CHECK(err, err = kernel.setArg(4, threshold));
+    OCL_CHECK(err, err = kernel.setArg(5, overlap));
+    OCL_CHECK(err, err = kernel.setArg(6, buffer_det));
+    OCL_CHECK(err, err = kernel.setArg(7, buffer_num));
+    OCL_CHECK(err, err = kernel.setArg(8, max_det));
+    OCL_CHECK(err, err = kernel.setArg(9, rows));
+    OCL_CHECK(err, err = kernel.setArg(10, cols));
+
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_pyr, CL_TRUE, 0, pyr_size_bytes, pyr.data()));
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_weights, CL_TRUE, 0, weights_size_bytes, weights.data()));
+
+    // Profiling Objects
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    double diff_prof = 0.0f;
+    cl::Event event;
+
+    // Launch the kernel
+    OCL_CHECK(err, err = q.enqueueTask(kernel, NULL, &event));
+    clWaitForEvents(1, (const cl_event*)&event);
+
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    diff_prof = end - start;
+    std::cout << "INFO: " << (diff_prof / 1000000) << "ms" << std::endl;
+
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_det, CL_TRUE, 0, det_size_bytes, det.data()));
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_num, CL_TRUE, 0, sizeof(int), &num));
+
+    q.finish();
+
+    // Reference model
+    std::vector<RefDetection> ref;
+    refHOGDetect(in_img, ref_weights, bias, threshold, overlap, max_det, ref);
+
+    // The HOG of the kernel is in fixed point and its pyrDown differs at the border, so the windows close to the
+    // threshold may differ: the detections are matched by their overlap
+    std::vector<RefDetection> hw(num);
+    for (int i = 0; i < num; i++) {
+        int* d = &det[i * xf::cv::XF_HOG_DET_SIZE];
+        hw[i] = {d[xf::cv::XF_HOG_DET_X], d[xf::cv::XF_HOG_DET_Y], d[xf::cv::XF_HOG_DET_WIDTH],
+                 d[xf::cv::XF_HOG_DET_HEIGHT], (float)d[xf::cv::XF_HOG_DET_SCORE] / (1 << XF_HOG_SCORE_FRAC)};
+    }
+
+    int matched = 0;
+    float max_diff = 0;
+    for (int i = 0; i < num; i++) {
+        for (size_t j = 0; j < ref.size(); j++) {
+            if (refIoU(hw[i], ref[j]) >= 0.5f) {
+                matched++;
+                max_diff = std::max(max_diff, fabsf(hw[i].score - ref[j].score));
+                break;
+            }
+        }
+    }
+
+    cv::Mat out_img;
+    cv::cvtColor(in_img, out_img, cv::COLOR_GRAY2BGR);
+    for (int i = 0; i < num; i++) {
+        cv::rectangle(out_img, cv::Rect(hw[i].x, hw[i].y, hw[i].width, hw[i].height), cv::Scalar(0, 255, 0), 2);
+    }
+    cv::imwrite("hls_out.jpg", out_img);
+
+    std::cout << "INFO: " << num << " detections, " << ref.size() << " in the reference, " << matched
+              << " matched, max score difference " << max_diff << std::endl;
+
+    int expected = std::max(num, (int)ref.size());
+    if (matched < expected - expected / 10) {
+        fprintf(stderr, "ERROR: Test Failed.\n ");
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+// Maximum frame size
+#define HEIGHT 1080
+#define WIDTH 1920
+
+// Accumulator, as HoughLines: rho step, theta step in 6.1 format and theta range in degrees
+#define RHOSTEP 1
+#define THETASTEP 2
+#define MINTHETA 0
+#define MAXTHETA 180
+
+// cvRound(sqrt(WIDTH * WIDTH + HEIGHT * HEIGHT) / RHOSTEP)
+#define DIAGVAL 2203
+
+// Maximum number of segments and of edge points
+#define LINESMAX 512
+#define MAXPOINTS 65536
+
+// port widths
+#define PTR_WIDTH 256
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "xf_houghlinesp_config.h"
+
+static void segmentsWrite(xf::cv::Mat<TYPE, HEIGHT, WIDTH, NPC1>& edges,
+                          short* lines_out,
+                          int* num_out,
+                          short threshold,
+                          short min_length,
+                          short max_gap,
+                          short maxlines) {
+    short lines[LINESMAX][4];
+    int num;
+
+    xf::cv::HoughLinesP<RHOSTEP, THETASTEP, LINESMAX, DIAGVAL, MINTHETA, MAXTHETA, MAXPOINTS, TYPE, HEIGHT, WIDTH,
+                        NPC1>(edges, lines, num, threshold, min_length, max_gap, maxlines);
+
+    for (int i = 0; i < num; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=LINESMAX
+        #pragma HLS PIPELINE II=4
+        // clang-format on
+        for (int k = 0; k < 4; k++) {
+            lines_out[i * 4 + k] = lines[i][k];
+        }
+    }
+    *num_out = num;
+}
+
+extern "C" {
+
+void houghlinesp_accel(ap_uint<PTR_WIDTH>* img_in,
+                       short* lines_out,
+                       int* num_out,
+                       short threshold,
+                       short min_length,
+                       short max_gap,
+                       short maxlines,
+                       int rows,
+                       int cols) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=lines_out     offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=num_out       offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE s_axilite  port=threshold                   bundle=control
+    #pragma HLS INTERFACE s_axilite  port=min_length                  bundle=control
+    #pragma HLS INTERFACE s_axilite  port=max_gap                     bundle=control
+    #pragma HLS INTERFACE s_axilite  port=maxlines                    bundle=control
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    xf::cv::Mat<TYPE, HEIGHT, WIDTH, NPC1> imgInput(rows, cols);
+
+// clang-format off
+    #pragma HLS STREAM variable=imgInput.data depth=2
+    // clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    xf::cv::Array2xfMat<PTR_WIDTH, TYPE, HEIGHT, WIDTH, NPC1>(img_in, imgInput);
+    segmentsWrite(imgInput, lines_out, num_out, threshold, min_length, max_gap, maxlines);
+
+    return;
+} // End of kernel
+
+} // End of extern C
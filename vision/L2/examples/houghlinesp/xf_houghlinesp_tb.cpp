@@ -0,0 +1,256 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/xf_headers.hpp"
+#include "xf_houghlinesp_config.h"
+#include "xcl2.hpp"
+
+// Size of the synthetic test image
+#define SYN_HEIGHT 480
+#define SYN_WIDTH 640
+
+// Largest distance, in pixels, between a found end point and the drawn one
+#define END_TOLERANCE 3
+
+// Segments drawn in the synthetic image, their angles are on the 1 degree grid of THETASTEP 2
+static const int synSegments[][4] = {{40, 40, 300, 40},    {360, 100, 600, 100}, {40, 100, 40, 440},
+                                     {600, 160, 600, 440}, {100, 120, 300, 320}, {330, 160, 538, 280},
+                                     {180, 440, 280, 267}, {340, 400, 572, 462}, {100, 400, 160, 400}};
+
+static bool nearPoint(int x0, int y0, int x1, int y1) {
+    return (abs(x0 - x1) <= END_TOLERANCE) && (abs(y0 - y1) <= END_TOLERANCE);
+}
+
+// Same end points, in either order
+static bool sameSegment(const cv::Vec4i& a, const cv::Vec4i& b) {
+    return (nearPoint(a[0], a[1], b[0], b[1]) && nearPoint(a[2], a[3], b[2], b[3])) ||
+           (nearPoint(a[0], a[1], b[2], b[3]) && nearPoint(a[2], a[3], b[0], b[1]));
+}
+
+static double distanceToSegment(double x, double y, const cv::Vec4i& s) {
+    double dx = s[2] - s[0], dy = s[3] - s[1];
+    double t = ((x - s[0]) * dx + (y - s[1]) * dy) / (dx * dx + dy * dy);
+    t = (t < 0) ? 0 : ((t > 1) ? 1 : t);
+    double ex = s[0] + t * dx - x, ey = s[1] + t * dy - y;
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+// Part of a drawn segment, as when the walk leaves a few of its pixels behind
+static bool onSegment(const cv::Vec4i& part, const cv::Vec4i& s) {
+    return (distanceToSegment(part[0], part[1], s) <= 2) && (distanceToSegment(part[2], part[3], s) <= 2);
+}
+
+static void runKernel(cl::Context& context,
+                      cl::CommandQueue& q,
+                      cl::Kernel& kernel,
+                      cv::Mat& edges,
+                      short threshold,
+                      short min_length,
+                      short max_gap,
+                      short maxlines,
+                      std::vector<cv::Vec4i>& segments) {
+    cl_int err;
+    int rows = edges.rows;
+    int cols = edges.cols;
+    size_t image_in_size_bytes = rows * cols * sizeof(unsigned char);
+    size_t lines_size_bytes = LINESMAX * 4 * sizeof(short);
+
+    std::vector<short> lines(LINESMAX * 4);
+    int num = 0;
+
+    // Allocate the buffers:
+    OCL_CHECK(err, cl::Buffer buffer_inImage(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outLines(context, CL_MEM_WRITE_ONLY, lines_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outNum(context, CL_MEM_WRITE_ONLY, sizeof(int), NULL, &err));
+
+    // Set kernel arguments:
+    OCL_CHECK(err, err = kernel.setArg(0, buffer_inImage));
+    OCL_CHECK(err, err = kernel.setArg(1, buffer_outLines));
+    OCL_CHECK(err, err = kernel.setArg(2, buffer_outNum));
+    OCL_CHECK(err, err = kernel.setArg(3, threshold));
+    OCL_CHECK(err, err = kernel.setArg(4, min_length));
+    OCL_CHECK(err, err = kernel.setArg(5, max_gap));
+    OCL_CHECK(err, err = kernel.setArg(6, maxlines));
+    OCL_CHECK(err, err = kernel.setArg(7, rows));
+    OCL_CHECK(err, err = kernel.setArg(8, cols));
+
+    // Initialize the buffers:
+    cl::Event event;
+
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inImage, CL_TRUE, 0, image_in_size_bytes, edges.data));
+
+    // Profiling Objects
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    double diff_prof = 0.0f;
+
+    // Launch the kernel
+    OCL_CHECK(err, err = q.enqueueTask(kernel, NULL, &event));
+    clWaitForEvents(1, (const cl_event*)&event);
+
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    diff_prof = end - start;
+    std::cout << (diff_prof / 1000000) << "ms" << std::endl;
+
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outNum, CL_TRUE, 0, sizeof(int), &num));
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outLines, CL_TRUE, 0, lines_size_bytes, lines.data()));
+
+    q.finish();
+
+    segments.clear();
+    for (int i = 0; i < num; i++) {
+        segments.push_back(cv::Vec4i(lines[i * 4], lines[i * 4 + 1], lines[i * 4 + 2], lines[i * 4 + 3]));
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <INPUT IMAGE PATH 1>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_gray = cv::imread(argv[1], 0);
+    if (!in_gray.data) {
+        fprintf(stderr, "ERROR: Cannot open image %s\n ", argv[1]);
+        return EXIT_FAILURE;
+    }
+    if ((in_gray.rows > HEIGHT) || (in_gray.cols > WIDTH)) {
+        cv::resize(in_gray, in_gray, cv::Size(WIDTH, HEIGHT));
+    }
+    if ((SYN_HEIGHT > HEIGHT) || (SYN_WIDTH > WIDTH)) {
+        fprintf(stderr, "ERROR: The synthetic image needs HEIGHT >= %d and WIDTH >= %d\n ", SYN_HEIGHT, SYN_WIDTH);
+        return EXIT_FAILURE;
+    }
+
+    // Edge image, as the output of Canny and EdgeTracing
+    cv::Mat edges;
+    cv::Canny(in_gray, edges, 50, 200, 3);
+
+    short threshold = 50;
+    short min_length = 50;
+    short max_gap = 10;
+    short maxlines = LINESMAX;
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_houghlinesp");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "houghlinesp_accel", &err));
+
+    int errors = 0;
+
+    // Input image: every segment runs between two edge pixels and spans at least min_length
+    std::vector<cv::Vec4i> segments;
+    runKernel(context, q, kernel, edges, threshold, min_length, max_gap, maxlines, segments);
+
+    std::vector<cv::Vec4i> ocv_lines;
+    cv::HoughLinesP(edges, ocv_lines, RHOSTEP, (THETASTEP * CV_PI) / 360, threshold, min_length, max_gap);
+    std::cout << "INFO: " << segments.size() << " segments in the input image, " << ocv_lines.size()
+              << " with OpenCV, which takes the points in another order and has no limit of " << MAXPOINTS
+              << " points" << std::endl;
+
+    for (size_t i = 0; i < segments.size(); i++) {
+        const cv::Vec4i& s = segments[i];
+        bool edge_ends = (edges.at<unsigned char>(s[1], s[0]) != 0) && (edges.at<unsigned char>(s[3], s[2]) != 0);
+        bool long_enough = (abs(s[2] - s[0]) >= min_length) || (abs(s[3] - s[1]) >= min_length);
+        if (!edge_ends || !long_enough) {
+            std::cout << "ERROR: Segment " << s << " of the input image is not a segment of edge pixels" << std::endl;
+            errors++;
+        }
+    }
+
+    cv::Mat out_img;
+    cv::cvtColor(edges, out_img, cv::COLOR_GRAY2BGR);
+    for (size_t i = 0; i < segments.size(); i++) {
+        cv::line(out_img, cv::Point(segments[i][0], segments[i][1]), cv::Point(segments[i][2], segments[i][3]),
+                 cv::Scalar(0, 0, 255), 2);
+    }
+    cv::imwrite("hls_out.png", out_img);
+
+    // Synthetic image: the drawn segments, with gaps shorter than max_gap, must be found and nothing else. The last
+    // segment is just longer than min_length, and a segment of less than threshold pixels must not be found.
+    int num_expected = sizeof(synSegments) / sizeof(synSegments[0]);
+    std::vector<cv::Vec4i> expected;
+    cv::Mat syn = cv::Mat::zeros(SYN_HEIGHT, SYN_WIDTH, CV_8UC1);
+    for (int i = 0; i < num_expected; i++) {
+        const int* s = synSegments[i];
+        expected.push_back(cv::Vec4i(s[0], s[1], s[2], s[3]));
+        cv::line(syn, cv::Point(s[0], s[1]), cv::Point(s[2], s[3]), cv::Scalar(255), 1, cv::LINE_8);
+    }
+    cv::line(syn, cv::Point(500, 180), cv::Point(500, 210), cv::Scalar(255), 1, cv::LINE_8);
+    syn(cv::Rect(420, 100, 5, 1)) = 0;
+    syn(cv::Rect(40, 250, 1, 8)) = 0;
+    syn(cv::Rect(230, 220, 1, 8)) = 0;
+
+    runKernel(context, q, kernel, syn, threshold, min_length, max_gap, maxlines, segments);
+
+    for (int i = 0; i < num_expected; i++) {
+        bool found = false;
+        for (size_t k = 0; k < segments.size(); k++) found |= sameSegment(expected[i], segments[k]);
+        if (!found) {
+            std::cout << "ERROR: Segment " << expected[i] << " of the synthetic image not found" << std::endl;
+            errors++;
+        }
+    }
+    for (size_t k = 0; k < segments.size(); k++) {
+        bool drawn = false;
+        for (int i = 0; i < num_expected; i++) drawn |= onSegment(segments[k], expected[i]);
+        if (!drawn) {
+            std::cout << "ERROR: Segment " << segments[k] << " is not in the synthetic image" << std::endl;
+            errors++;
+        }
+    }
+
+    // The same check holds for OpenCV, which makes sure the synthetic image is a fair test
+    cv::HoughLinesP(syn, ocv_lines, RHOSTEP, (THETASTEP * CV_PI) / 360, threshold, min_length, max_gap);
+    int ocv_found = 0;
+    for (int i = 0; i < num_expected; i++) {
+        for (size_t k = 0; k < ocv_lines.size(); k++) {
+            if (sameSegment(expected[i], ocv_lines[k])) {
+                ocv_found++;
+                break;
+            }
+        }
+    }
+    std::cout << "INFO: " << segments.size() << " segments in the synthetic image, OpenCV finds " << ocv_found
+              << " of the " << num_expected << " drawn ones" << std::endl;
+
+    if (errors) {
+        fprintf(stderr, "ERROR: Test Failed.\n ");
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
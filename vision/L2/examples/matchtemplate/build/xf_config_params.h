@@ -0,0 +1,38 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+// Maximum frame size
+#define HEIGHT 1080
+#define WIDTH 1920
+
+// Maximum template size
+#define TMPL_HEIGHT 64
+#define TMPL_WIDTH 64
+
+// Multiplications per clock, a multiple of TMPL_WIDTH dividing TMPL_HEIGHT * TMPL_WIDTH.
+// A pixel takes TMPL_HEIGHT * TMPL_WIDTH / MATCH_PU clocks.
+#define MATCH_PU 512
+
+// XF_TM_SQDIFF, XF_TM_SQDIFF_NORMED, XF_TM_CCORR, XF_TM_CCORR_NORMED, XF_TM_CCOEFF or XF_TM_CCOEFF_NORMED
+#define MATCH_METHOD XF_TM_CCOEFF_NORMED
+
+// Number of best match positions
+#define TOPK 16
+
+// port widths
+#define INPUT_PTR_WIDTH 256
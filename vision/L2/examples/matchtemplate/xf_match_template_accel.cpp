@@ -0,0 +1,126 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "xf_match_template_config.h"
+
+static void tmplRead(unsigned char* tmpl_in,
+                     unsigned char tmpl[TMPL_HEIGHT][TMPL_WIDTH],
+                     int tmpl_rows,
+                     int tmpl_cols) {
+    for (int r = 0; r < tmpl_rows; r++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=TMPL_HEIGHT
+        // clang-format on
+        for (int c = 0; c < tmpl_cols; c++) {
+// clang-format off
+            #pragma HLS LOOP_TRIPCOUNT min=1 max=TMPL_WIDTH
+            #pragma HLS PIPELINE II=1
+            // clang-format on
+            tmpl[r][c] = tmpl_in[r * tmpl_cols + c];
+        }
+    }
+}
+
+static void scoreWrite(xf::cv::Mat<OUT_TYPE, HEIGHT, WIDTH, NPC1>& score, float* score_out) {
+    for (int i = 0; i < score.rows * score.cols; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=HEIGHT*WIDTH
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        score_out[i] = score.read_float(i);
+    }
+}
+
+static void topKWrite(xf::cv::Mat<OUT_TYPE, HEIGHT, WIDTH, NPC1>& score,
+                      unsigned int* loc_out,
+                      float* best_out,
+                      int* num_out) {
+    ap_uint<32> loc[TOPK];
+    float best[TOPK];
+    int num;
+
+    xf::cv::matchTemplateTopK<MATCH_METHOD, TOPK, OUT_TYPE, HEIGHT, WIDTH, NPC1>(score, loc, best, num);
+
+    for (int i = 0; i < TOPK; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        loc_out[i] = loc[i];
+        best_out[i] = best[i];
+    }
+    *num_out = num;
+}
+
+extern "C" {
+
+void matchtemplate_accel(ap_uint<INPUT_PTR_WIDTH>* img_in,
+                         unsigned char* tmpl_in,
+                         float* score_out,
+                         unsigned int* loc_out,
+                         float* best_out,
+                         int* num_out,
+                         int rows,
+                         int cols,
+                         int tmpl_rows,
+                         int tmpl_cols) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=tmpl_in       offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=score_out     offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=loc_out       offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE m_axi      port=best_out      offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE m_axi      port=num_out       offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=tmpl_rows                   bundle=control
+    #pragma HLS INTERFACE s_axilite  port=tmpl_cols                   bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    int out_rows = rows - tmpl_rows + 1;
+    int out_cols = cols - tmpl_cols + 1;
+
+    unsigned char tmpl[TMPL_HEIGHT][TMPL_WIDTH];
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgInput(rows, cols);
+    xf::cv::Mat<OUT_TYPE, HEIGHT, WIDTH, NPC1> score(out_rows, out_cols);
+    xf::cv::Mat<OUT_TYPE, HEIGHT, WIDTH, NPC1> scoreMap(out_rows, out_cols);
+    xf::cv::Mat<OUT_TYPE, HEIGHT, WIDTH, NPC1> scoreTopK(out_rows, out_cols);
+
+// clang-format off
+    #pragma HLS STREAM variable=imgInput.data depth=2
+    #pragma HLS STREAM variable=score.data depth=2
+    #pragma HLS STREAM variable=scoreMap.data depth=2
+    #pragma HLS STREAM variable=scoreTopK.data depth=2
+    // clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    tmplRead(tmpl_in, tmpl, tmpl_rows, tmpl_cols);
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(img_in, imgInput);
+    xf::cv::matchTemplate<MATCH_METHOD, TMPL_HEIGHT, TMPL_WIDTH, MATCH_PU, IN_TYPE, OUT_TYPE, HEIGHT, WIDTH, NPC1>(
+        imgInput, tmpl, score, tmpl_rows, tmpl_cols);
+    xf::cv::duplicateMat<OUT_TYPE, HEIGHT, WIDTH, NPC1>(score, scoreMap, scoreTopK);
+    scoreWrite(scoreMap, score_out);
+    topKWrite(scoreTopK, loc_out, best_out, num_out);
+
+    return;
+} // End of kernel
+
+} // End of extern C
@@ -0,0 +1,181 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+#include "common/xf_headers.hpp"
+#include "xf_match_template_config.h"
+#include "xcl2.hpp"
+
+static const int cv_methods[6] = {cv::TM_SQDIFF,  cv::TM_SQDIFF_NORMED, cv::TM_CCORR,
+                                  cv::TM_CCORR_NORMED, cv::TM_CCOEFF, cv::TM_CCOEFF_NORMED};
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <INPUT IMAGE PATH 1>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_img = cv::imread(argv[1], 0);
+    if (!in_img.data) {
+        fprintf(stderr, "ERROR: Cannot open image %s\n ", argv[1]);
+        return EXIT_FAILURE;
+    }
+    if ((in_img.rows > HEIGHT) || (in_img.cols > WIDTH)) {
+        cv::resize(in_img, in_img, cv::Size(WIDTH, HEIGHT));
+    }
+    int rows = in_img.rows;
+    int cols = in_img.cols;
+
+    // Template cut from the image, the best match is known
+    int tmpl_rows = TMPL_HEIGHT;
+    int tmpl_cols = TMPL_WIDTH;
+    int tmpl_y = rows / 3;
+    int tmpl_x = cols / 2;
+    cv::Mat tmpl = in_img(cv::Rect(tmpl_x, tmpl_y, tmpl_cols, tmpl_rows)).clone();
+
+    int out_rows = rows - tmpl_rows + 1;
+    int out_cols = cols - tmpl_cols + 1;
+
+    size_t image_in_size_bytes = rows * cols * sizeof(unsigned char);
+    size_t tmpl_size_bytes = tmpl_rows * tmpl_cols * sizeof(unsigned char);
+    size_t score_size_bytes = out_rows * out_cols * sizeof(float);
+
+    cv::Mat score(out_rows, out_cols, CV_32FC1);
+    std::vector<unsigned int> loc(TOPK);
+    std::vector<float> best(TOPK);
+    int num = 0;
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_matchtemplate");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "matchtemplate_accel", &err));
+
+    // Allocate the buffers:
+    OCL_CHECK(err, cl::Buffer buffer_inImage(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_inTmpl(context, CL_MEM_READ_ONLY, tmpl_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outScore(context, CL_MEM_WRITE_ONLY, score_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outLoc(context, CL_MEM_WRITE_ONLY, TOPK * sizeof(unsigned int), NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outBest(context, CL_MEM_WRITE_ONLY, TOPK * sizeof(float), NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outNum(context, CL_MEM_WRITE_ONLY, sizeof(int), NULL, &err));
+
+    // Set kernel arguments:
+    OCL_CHECK(err, err = kernel.setArg(0, buffer_inImage));
+    OCL_CHECK(err, err = kernel.setArg(1, buffer_inTmpl));
+    OCL_CHECK(err, err = kernel.setArg(2, buffer_outScore));
+    OCL_CHECK(err, err = kernel.setArg(3, buffer_outLoc));
+    OCL_CHECK(err, err = kernel.setArg(4, buffer_outBest));
+    OCL_CHECK(err, err = kernel.setArg(5, buffer_outNum));
+    OCL_CHECK(err, err = kernel.setArg(6, rows));
+    OCL_CHECK(err, err = kernel.setArg(7, cols));
+    OCL_CHECK(err, err = kernel.setArg(8, tmpl_rows));
+    OCL_CHECK(err, err = kernel.setArg(9, tmpl_cols));
+
+    // Initialize the buffers:
+    cl::Event event;
+
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inImage, CL_TRUE, 0, image_in_size_bytes, in_img.data));
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inTmpl, CL_TRUE, 0, tmpl_size_bytes, tmpl.data));
+
+    // Profiling Objects
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    double diff_prof = 0.0f;
+
+    // Launch the kernel
+    OCL_CHECK(err, err = q.enqueueTask(kernel, NULL, &event));
+    clWaitForEvents(1, (const cl_event*)&event);
+
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    diff_prof = end - start;
+    std::cout << (diff_prof / 1000000) << "ms" << std::endl;
+
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outScore, CL_TRUE, 0, score_size_bytes, score.data));
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outLoc, CL_TRUE, 0, TOPK * sizeof(unsigned int), loc.data()));
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outBest, CL_TRUE, 0, TOPK * sizeof(float), best.data()));
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_outNum, CL_TRUE, 0, sizeof(int), &num));
+
+    q.finish();
+
+    // Reference:
+    cv::Mat ref_score;
+    cv::matchTemplate(in_img, tmpl, ref_score, cv_methods[MATCH_METHOD]);
+
+    // Score map, relative to the range of the scores for the methods that are not normalized
+    double ref_min, ref_max;
+    cv::minMaxLoc(ref_score, &ref_min, &ref_max);
+    double range = std::max(fabs(ref_min), fabs(ref_max));
+    double tol = (MATCH_METHOD & 1) ? 1e-3 : 1e-4 * range;
+    int errors = 0;
+    double max_diff = 0;
+    for (int y = 0; y < out_rows; y++) {
+        for (int x = 0; x < out_cols; x++) {
+            double d = fabs((double)score.at<float>(y, x) - ref_score.at<float>(y, x));
+            max_diff = (d > max_diff) ? d : max_diff;
+            if (d > tol) errors++;
+        }
+    }
+    std::cout << "INFO: Score map max difference " << max_diff << ", " << errors << " above " << tol << std::endl;
+
+    // Best positions, the template position first
+    std::cout << "INFO: " << num << " positions found" << std::endl;
+    for (int i = 0; i < num; i++) {
+        int y = loc[i] >> 16;
+        int x = loc[i] & 0xFFFF;
+        std::cout << "INFO: (" << x << ", " << y << ") " << best[i] << std::endl;
+        if (best[i] != score.at<float>(y, x)) errors++;
+    }
+    bool found = (num > 0) && ((int)(loc[0] >> 16) == tmpl_y) && ((int)(loc[0] & 0xFFFF) == tmpl_x);
+    if ((MATCH_METHOD != XF_TM_CCORR) && (MATCH_METHOD != XF_TM_CCOEFF) && !found) {
+        std::cout << "ERROR: Template not found at (" << tmpl_x << ", " << tmpl_y << ")" << std::endl;
+        errors++;
+    }
+
+    cv::Mat out_img;
+    cv::cvtColor(in_img, out_img, cv::COLOR_GRAY2BGR);
+    for (int i = 0; i < num; i++) {
+        cv::Point p(loc[i] & 0xFFFF, loc[i] >> 16);
+        cv::rectangle(out_img, p, p + cv::Point(tmpl_cols, tmpl_rows), cv::Scalar(0, i ? 255 : 0, 255));
+    }
+    cv::imwrite("hls_out.png", out_img);
+
+    if (errors) {
+        fprintf(stderr, "ERROR: Test Failed.\n ");
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_SGBM_SUBPIXEL_REF_HPP_
+#define _XF_SGBM_SUBPIXEL_REF_HPP_
+
+#include <stdlib.h>
+#include <vector>
+
+// Reference model of xf::cv::SemiGlobalBMSubpixel on continuous 8 bit images
+
+#define REF_INVALID_DISP 0xFFFF
+
+// 5x5 census transform, zero outside the image
+static void refCensus(const unsigned char* img, int rows, int cols, std::vector<unsigned int>& ct) {
+    ct.resize(rows * cols);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            unsigned int c = 0;
+            for (int dy = -2; dy <= 2; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    if (dy == 0 && dx == 0) continue;
+                    int yy = y + dy, xx = x + dx;
+                    int ref = (yy < 0 || yy >= rows || xx < 0 || xx >= cols) ? 0 : img[yy * cols + xx];
+                    c = (c << 1) | ((ref < img[y * cols + x]) ? 1 : 0);
+                }
+            }
+            ct[y * cols + x] = c;
+        }
+    }
+}
+
+static int refHamming(unsigned int a, unsigned int b) {
+    unsigned int v = a ^ b;
+    int n = 0;
+    for (; v; v >>= 1) n += v & 1;
+    return n;
+}
+
+// Adds the path (dy, dx) to the aggregated cost, rows are scanned right to left for dx > 0 and dy == 0
+static void refPath(const std::vector<unsigned char>& cost,
+                    std::vector<unsigned short>& agg,
+                    int rows,
+                    int cols,
+                    int ndisp,
+                    int dy,
+                    int dx,
+                    int p1,
+                    int p2) {
+    std::vector<int> lr(rows * cols * ndisp), lr_min(rows * cols);
+    bool reverse = (dy == 0) && (dx > 0);
+    for (int y = 0; y < rows; y++) {
+        for (int i = 0; i < cols; i++) {
+            int x = reverse ? cols - 1 - i : i;
+            int py = y + dy, px = x + dx;
+            bool border = (py < 0) || (px < 0) || (px >= cols);
+            const int* lp = border ? NULL : &lr[(py * cols + px) * ndisp];
+            int mn = 255;
+            for (int d = 0; d < ndisp; d++) {
+                int c = cost[(y * cols + x) * ndisp + d];
+                int v = c;
+                if (!border) {
+                    int lp_min = lr_min[py * cols + px];
+                    int best = lp[d];
+                    if (d > 0 && lp[d - 1] + p1 < best) best = lp[d - 1] + p1;
+                    if (d < ndisp - 1 && lp[d + 1] + p1 < best) best = lp[d + 1] + p1;
+                    if (lp_min + p2 < best) best = lp_min + p2;
+                    v = c + best - lp_min;
+                }
+                lr[(y * cols + x) * ndisp + d] = v;
+                agg[(y * cols + x) * ndisp + d] += v;
+                if (v < mn) mn = v;
+            }
+            lr_min[y * cols + x] = mn;
+        }
+    }
+}
+
+static void refSgbmSubpixel(const unsigned char* left,
+                            const unsigned char* right,
+                            std::vector<unsigned short>& disp,
+                            int rows,
+                            int cols,
+                            int ndisp,
+                            int ndir,
+                            int p1,
+                            int p2,
+                            int lr_max_diff,
+                            int speckle_max_diff,
+                            int speckle_min_support) {
+    std::vector<unsigned int> ctl, ctr;
+    refCensus(left, rows, cols, ctl);
+    refCensus(right, rows, cols, ctr);
+
+    // Initial cost, the right census is zero left of the image
+    std::vector<unsigned char> cost(rows * cols * ndisp);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            for (int d = 0; d < ndisp; d++) {
+                unsigned int r = (x - d >= 0) ? ctr[y * cols + x - d] : 0;
+                cost[(y * cols + x) * ndisp + d] = refHamming(ctl[y * cols + x], r);
+            }
+        }
+    }
+
+    // Left to right, 135, 90 and 45 degree, right to left
+    const int dirs[5][2] = {{0, -1}, {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}};
+    std::vector<unsigned short> agg(rows * cols * ndisp, 0);
+    for (int r = 0; r < ndir; r++) refPath(cost, agg, rows, cols, ndisp, dirs[r][0], dirs[r][1], p1, p2);
+
+    // Winner takes all with quadratic interpolation in 1/16 pixel, and the disparity of the right image
+    std::vector<unsigned short> dl(rows * cols);
+    std::vector<int> dint(rows * cols), dr(rows * cols);
+    for (int y = 0; y < rows; y++) {
+        std::vector<int> rcost(cols, 0x10000);
+        for (int x = 0; x < cols; x++) {
+            const unsigned short* s = &agg[(y * cols + x) * ndisp];
+            int d = 0;
+            for (int k = 1; k < ndisp; k++) {
+                if (s[k] < s[d]) d = k;
+            }
+            int v = d * 16;
+            if (d > 0 && d < ndisp - 1) {
+                int num = abs(s[d - 1] - s[d + 1]);
+                int den = s[d - 1] + s[d + 1] - 2 * s[d];
+                int q = (den > 0) ? (16 * num + den) / (2 * den) : 0;
+                v += (s[d - 1] >= s[d + 1]) ? q : -q;
+            }
+            dl[y * cols + x] = v;
+            dint[y * cols + x] = d;
+
+            for (int k = 0; k < ndisp && x - k >= 0; k++) {
+                if (s[k] < rcost[x - k]) {
+                    rcost[x - k] = s[k];
+                    dr[y * cols + x - k] = k;
+                }
+            }
+        }
+    }
+
+    // Left right consistency check
+    std::vector<unsigned short> checked(rows * cols);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int d = dint[y * cols + x];
+            bool valid = (x - d < 0) || (abs(dr[y * cols + x - d] - d) <= lr_max_diff);
+            checked[y * cols + x] = valid ? dl[y * cols + x] : REF_INVALID_DISP;
+        }
+    }
+
+    // Speckle filter on the 5x5 neighbourhood
+    disp.resize(rows * cols);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int c = checked[y * cols + x];
+            int support = 0;
+            for (int dy = -2; dy <= 2; dy++) {
+                for (int dx = -2; dx <= 2; dx++) {
+                    int yy = y + dy, xx = x + dx;
+                    if ((dy == 0 && dx == 0) || yy < 0 || yy >= rows || xx < 0 || xx >= cols) continue;
+                    int v = checked[yy * cols + xx];
+                    if (v != REF_INVALID_DISP && abs(v - c) <= speckle_max_diff * 16) support++;
+                }
+            }
+            disp[y * cols + x] = (c == REF_INVALID_DISP || support < speckle_min_support) ? REF_INVALID_DISP : c;
+        }
+    }
+}
+
+#endif
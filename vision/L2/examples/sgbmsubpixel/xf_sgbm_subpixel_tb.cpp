@@ -0,0 +1,176 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "common/xf_headers.hpp"
+#include "xf_sgbm_subpixel_config.h"
+#include "xf_sgbm_subpixel_ref.hpp"
+#include "xcl2.hpp"
+
+// Disparity map for display, invalid pixels in black
+static void saveDisparityMap(const unsigned short* disp, int rows, int cols, std::string outputFileName) {
+    cv::Mat disparityMap(rows, cols, CV_8UC1);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            unsigned short d = disp[i * cols + j];
+            int v = (d == REF_INVALID_DISP) ? 0 : (d * 255) / (TOTAL_DISPARITY * 16);
+            disparityMap.at<unsigned char>(i, j) = (unsigned char)v;
+        }
+    }
+    cv::imwrite(outputFileName, disparityMap);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cout << "Usage: " << argv[0] << " <INPUT IMAGE PATH 1> <INPUT IMAGE PATH 2>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_imgL, in_imgR, hls_out;
+
+    // Reading in images:
+    in_imgL = cv::imread(argv[1], 0);
+    in_imgR = cv::imread(argv[2], 0);
+
+    if (in_imgL.data == NULL) {
+        std::cout << "ERROR: Cannot open image " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (in_imgR.data == NULL) {
+        std::cout << "ERROR: Cannot open image " << argv[2] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Allocate memory for the output of kernel, disparities in 1/16 pixel:
+    hls_out.create(in_imgL.rows, in_imgL.cols, CV_16UC1);
+
+    // Parameters initialization:
+    unsigned char small_penalty = SMALL_PENALTY;
+    unsigned char large_penalty = LARGE_PENALTY;
+    unsigned char lr_max_diff = LR_MAX_DIFF;
+    unsigned char speckle_max_diff = SPECKLE_MAX_DIFF;
+    unsigned char speckle_min_support = SPECKLE_MIN_SUPPORT;
+
+    // OpenCL section:
+    size_t image_in_size_bytes = in_imgL.rows * in_imgL.cols * sizeof(unsigned char);
+    size_t image_out_size_bytes = in_imgL.rows * in_imgL.cols * sizeof(unsigned short);
+
+    int height = in_imgL.rows;
+    int width = in_imgL.cols;
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue queue(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_sgbm_subpixel");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "sgbm_subpixel_accel", &err));
+
+    // Allocate the buffers:
+    OCL_CHECK(err, cl::Buffer buffer_inImageL(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_inImageR(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outImage(context, CL_MEM_WRITE_ONLY, image_out_size_bytes, NULL, &err));
+
+    // Set kernel arguments:
+    OCL_CHECK(err, err = kernel.setArg(0, buffer_inImageL));
+    OCL_CHECK(err, err = kernel.setArg(1, buffer_inImageR));
+    OCL_CHECK(err, err = kernel.setArg(2, small_penalty));
+    OCL_CHECK(err, err = kernel.setArg(3, large_penalty));
+    OCL_CHECK(err, err = kernel.setArg(4, lr_max_diff));
+    OCL_CHECK(err, err = kernel.setArg(5, speckle_max_diff));
+    OCL_CHECK(err, err = kernel.setArg(6, speckle_min_support));
+    OCL_CHECK(err, err = kernel.setArg(7, buffer_outImage));
+    OCL_CHECK(err, err = kernel.setArg(8, height));
+    OCL_CHECK(err, err = kernel.setArg(9, width));
+
+    // Initialize the buffers:
+    cl::Event event;
+
+    OCL_CHECK(err, queue.enqueueWriteBuffer(buffer_inImageL, CL_TRUE, 0, image_in_size_bytes, in_imgL.data, nullptr,
+                                            &event));
+    OCL_CHECK(err, queue.enqueueWriteBuffer(buffer_inImageR, CL_TRUE, 0, image_in_size_bytes, in_imgR.data, nullptr,
+                                            &event));
+
+    // Execute the kernel:
+    OCL_CHECK(err, err = queue.enqueueTask(kernel, NULL, &event));
+
+    // Profiling:
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    event.wait();
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    std::cout << "INFO: Kernel latency " << (end - start) / 1000000.0 << " ms" << std::endl;
+
+    // Copy Result from Device Global Memory to Host Local Memory:
+    queue.enqueueReadBuffer(buffer_outImage, CL_TRUE, 0, image_out_size_bytes, hls_out.data, nullptr, &event);
+
+    // Clean up:
+    queue.finish();
+
+    // Write down the HLS result:
+    saveDisparityMap((unsigned short*)hls_out.data, height, width, "hls_out.png");
+
+    // Reference code:
+    std::vector<unsigned short> disparity;
+    refSgbmSubpixel(in_imgL.data, in_imgR.data, disparity, height, width, TOTAL_DISPARITY, NUM_DIR, small_penalty,
+                    large_penalty, lr_max_diff, speckle_max_diff, speckle_min_support);
+    saveDisparityMap(disparity.data(), height, width, "disp_map.png");
+
+    // Results verification:
+    cv::Mat diff;
+    diff.create(height, width, CV_8UC1);
+    int cnt = 0, invalid = 0;
+    for (int i = 0; i < height; i++) {
+        for (int j = 0; j < width; j++) {
+            unsigned short ref = disparity[i * width + j];
+            if (hls_out.at<unsigned short>(i, j) != ref) {
+                diff.at<unsigned char>(i, j) = 255;
+                cnt++;
+            } else
+                diff.at<unsigned char>(i, j) = 0;
+            if (ref == REF_INVALID_DISP) invalid++;
+        }
+    }
+
+    cv::imwrite("diff.png", diff);
+    std::cout << "INFO: Invalid pixels after the consistency check and the speckle filter = " << invalid << std::endl;
+    std::cout << "INFO: Number of pixels with errors = " << cnt << std::endl;
+
+    if (cnt > 0) {
+        std::cout << "ERROR: Test Failed" << std::endl;
+        return EXIT_FAILURE;
+    } else {
+        std::cout << "INFO: Test Pass" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/xf_headers.hpp"
+#include "common/xf_tiler.hpp"
+#include "xf_tiler_config.h"
+#include <iostream>
+
+#include <CL/cl.h>
+#include "xcl2.hpp"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printf("Usage: <executable> <input image path> [<scale>]\n");
+        return -1;
+    }
+
+    cv::Mat in_img, out_img, ocv_ref, diff;
+
+#if GRAY
+    in_img = cv::imread(argv[1], 0); // reading in the gray image
+#else
+    in_img = cv::imread(argv[1], 1); // reading in the color image
+#endif
+    if (!in_img.data) {
+        printf("Failed to load the image ... !!!");
+        return -1;
+    }
+
+    // Upscale the image to exercise sizes beyond the kernel, e.g. 2 for 8K from a 4K input
+    if (argc > 2) {
+        int scale = atoi(argv[2]);
+        cv::resize(in_img, in_img, cv::Size(in_img.cols * scale, in_img.rows * scale));
+    }
+
+    out_img.create(in_img.rows, in_img.cols, in_img.type());
+    diff.create(in_img.rows, in_img.cols, in_img.type());
+    ocv_ref.create(in_img.rows, in_img.cols, in_img.type());
+
+#if FILTER_WIDTH == 3
+    float sigma = 0.5f;
+#endif
+#if FILTER_WIDTH == 7
+    float sigma = 1.16666f;
+#endif
+#if FILTER_WIDTH == 5
+    float sigma = 0.8333f;
+#endif
+
+    // OpenCV Gaussian filter function on the full image
+    cv::GaussianBlur(in_img, ocv_ref, cvSize(FILTER_WIDTH, FILTER_WIDTH), FILTER_WIDTH / 6.0, FILTER_WIDTH / 6.0,
+                     cv::BORDER_CONSTANT);
+
+    imwrite("output_ocv.png", ocv_ref);
+
+    xf::cv::Tiler tiler(in_img.rows, in_img.cols, HEIGHT, WIDTH, xf::cv::tileHalo(FILTER_WIDTH), NPC1);
+    std::cout << "INFO: " << in_img.cols << "x" << in_img.rows << " image in " << tiler.size() << " tiles of at most "
+              << WIDTH << "x" << HEIGHT << std::endl;
+
+    /////////////////////////////////////// CL ////////////////////////
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device,
+                                      CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_tiler");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "tiler_accel", &err));
+
+    // Two sets of buffers, one tile is transferred while the other is processed:
+    size_t tile_bytes = HEIGHT * WIDTH * CH_TYPE;
+    cl::Buffer imageToDevice[2];
+    cl::Buffer imageFromDevice[2];
+    std::vector<cl::Event> kernel_event[2];
+    int tile_rows[2];
+    int tile_cols[2];
+    for (int i = 0; i < 2; i++) {
+        OCL_CHECK(err, imageToDevice[i] = cl::Buffer(context, CL_MEM_READ_ONLY, tile_bytes, NULL, &err));
+        OCL_CHECK(err, imageFromDevice[i] = cl::Buffer(context, CL_MEM_WRITE_ONLY, tile_bytes, NULL, &err));
+    }
+
+    // Profiling Objects
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    double diff_prof = 0.0f;
+
+    auto submit = [&](int slot, const cv::Mat& tile, const xf::cv::TileRect& rect) {
+        std::vector<cl::Event> write_event(1);
+        kernel_event[slot].resize(1);
+        tile_rows[slot] = rect.height;
+        tile_cols[slot] = rect.width;
+
+        OCL_CHECK(err, q.enqueueWriteBuffer(imageToDevice[slot], CL_FALSE, 0, rect.height * rect.width * CH_TYPE,
+                                            tile.data, nullptr, &write_event[0]));
+
+        OCL_CHECK(err, err = kernel.setArg(0, imageToDevice[slot]));
+        OCL_CHECK(err, err = kernel.setArg(1, imageFromDevice[slot]));
+        OCL_CHECK(err, err = kernel.setArg(2, rect.height));
+        OCL_CHECK(err, err = kernel.setArg(3, rect.width));
+        OCL_CHECK(err, err = kernel.setArg(4, sigma));
+        OCL_CHECK(err, err = q.enqueueTask(kernel, &write_event, &kernel_event[slot][0]));
+        q.flush();
+    };
+
+    auto wait = [&](int slot, cv::Mat& tile) {
+        tile.create(tile_rows[slot], tile_cols[slot], in_img.type());
+        OCL_CHECK(err, q.enqueueReadBuffer(imageFromDevice[slot], CL_TRUE, 0,
+                                           tile_rows[slot] * tile_cols[slot] * CH_TYPE, tile.data,
+                                           &kernel_event[slot]));
+        kernel_event[slot][0].getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+        kernel_event[slot][0].getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+        diff_prof += end - start;
+    };
+
+    tiler.run(in_img, out_img, submit, wait);
+
+    q.finish();
+    std::cout << (diff_prof / 1000000) << "ms" << std::endl;
+    /////////////////////////////////////// end of CL ////////////////////////
+
+    cv::imwrite("hw_out.jpg", out_img);
+
+    //////////////////  Compute Absolute Difference ////////////////////
+    cv::absdiff(ocv_ref, out_img, diff);
+    cv::imwrite("out_error.jpg", diff);
+
+    float err_per;
+
+    xf::cv::analyzeDiff(diff, 0, err_per);
+
+    if (err_per > 1) {
+        printf("\nTest failed\n");
+        return -1;
+    } else {
+        printf("\nTest Pass\n");
+        return 0;
+    }
+}
@@ -0,0 +1,34 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Maximum frame size
+#define HEIGHT 2160
+#define WIDTH 3840
+
+// Pixels per clock
+#define NPPC XF_NPPC8
+
+// Tile grid
+#define CLAHE_TILES_Y 8
+#define CLAHE_TILES_X 8
+
+// Contrast limit, relative to the mean bin count of a tile
+#define CLIP_LIMIT 2.0f
+
+// port widths
+#define INPUT_PTR_WIDTH 256
+#define OUTPUT_PTR_WIDTH 256
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Maximum frame size
+#define HEIGHT 1080
+#define WIDTH 1920
+
+// Pyramid levels, each half the size of the previous one
+#define NUM_LEVELS 3
+
+// Fraction bits of the SVM weights
+#define WFRAC 12
+
+// Maximum number of windows above threshold, and of detections after non-maximum suppression
+#define MAXCAND 4096
+#define MAXDET 64
+
+#define XF_USE_URAM false
+
+// port widths
+#define PTR_WIDTH 128
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define HEIGHT 1080
+#define WIDTH 1920
+
+/* Pixels per clock, XF_NPPC1, XF_NPPC2 or XF_NPPC4 */
+#define NPPC XF_NPPC4
+
+/* set penalties for SGM */
+#define SMALL_PENALTY 20
+#define LARGE_PENALTY 40
+
+/* Census transform window size */
+#define WINDOW_SIZE 5
+
+/* NO_OF_DISPARITIES must be greater than '0' and less than the image width */
+#define TOTAL_DISPARITY 64
+
+/* NO_OF_DISPARITIES must not be lesser than PARALLEL_UNITS and NO_OF_DISPARITIES/PARALLEL_UNITS must be a
+ * non-fractional number. PARALLEL_UNITS must be NO_OF_DISPARITIES for more than one pixel per clock */
+#define PARALLEL_UNITS 64
+
+/* Number of directions, 5 adds the right to left path */
+#define NUM_DIR 5
+
+/* Largest difference between the left and the right disparity, in pixels */
+#define LR_MAX_DIFF 1
+
+/* Speckle filter: valid neighbours within SPECKLE_MAX_DIFF pixels needed in the 5x5 window, 0 disables it */
+#define SPECKLE_MAX_DIFF 1
+#define SPECKLE_MIN_SUPPORT 8
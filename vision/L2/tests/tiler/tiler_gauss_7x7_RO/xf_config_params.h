@@ -0,0 +1,28 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define FILTER_SIZE_3 0
+#define FILTER_SIZE_5 0
+#define FILTER_SIZE_7 1
+
+#define RO 1
+#define NO 0
+
+#define GRAY 1
+#define RGBA 0
+
+#define INPUT_PTR_WIDTH 256
+#define OUTPUT_PTR_WIDTH 256
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define INPUT_PTR_WIDTH 256
+
+// Number of camera streams and frames per launch
+#define NUM_STREAMS 2
+#define MAX_BATCH 8
+
+// Output tensor layout, NCHW when 1, NHWC otherwise
+#define LAYOUT_NCHW 1
+
+// Output tensor type, fp16 when 1, int8 otherwise
+#define OUT_FP16 0
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xf_batch_pre_process_config.h"
+
+extern "C" {
+
+void batch_pre_process_accel(ap_uint<INPUT_PTR_WIDTH>* img_in,
+                             OUT_T* tensor_out,
+                             int* desc,
+                             float* params,
+                             int batch,
+                             int rows_out,
+                             int cols_out,
+                             int pad,
+                             int swap_rb) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=tensor_out    offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=desc          offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=params        offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE s_axilite  port=batch                       bundle=control
+    #pragma HLS INTERFACE s_axilite  port=rows_out                    bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols_out                    bundle=control
+    #pragma HLS INTERFACE s_axilite  port=pad                         bundle=control
+    #pragma HLS INTERFACE s_axilite  port=swap_rb                     bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    // Resize, letterbox, normalize and transpose every frame of the batch:
+    xf::cv::batchPreProcess<INPUT_PTR_WIDTH, TYPE, HEIGHT, WIDTH, OUT_HEIGHT, OUT_WIDTH, MAX_BATCH, MAXDOWNSCALE,
+                            INTERPOLATION, LAYOUT, OUT_T>(img_in, tensor_out, desc, params, batch, rows_out, cols_out,
+                                                          (unsigned char)pad, swap_rb != 0);
+
+    return;
+} // End of kernel
+
+} // End of extern C
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_BATCH_PRE_PROCESS_CONFIG_H_
+#define _XF_BATCH_PRE_PROCESS_CONFIG_H_
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "dnn/xf_batch_pre_process.hpp"
+#include "xf_config_params.h"
+
+// Maximum input frame size
+#define WIDTH 1920
+#define HEIGHT 1080
+
+// Output tensor size
+#define OUT_WIDTH 416
+#define OUT_HEIGHT 416
+
+#define MAXDOWNSCALE 5
+#define INTERPOLATION XF_INTERPOLATION_BILINEAR
+
+#define TYPE XF_8UC3
+#define CHANNELS 3
+
+#if LAYOUT_NCHW
+#define LAYOUT xf::cv::XF_NCHW
+#else
+#define LAYOUT xf::cv::XF_NHWC
+#endif
+
+#if OUT_FP16
+#include "hls_half.h"
+typedef half OUT_T;
+#else
+typedef ap_int<8> OUT_T;
+#endif
+
+#endif // _XF_BATCH_PRE_PROCESS_CONFIG_H_
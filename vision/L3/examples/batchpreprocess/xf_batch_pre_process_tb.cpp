@@ -0,0 +1,235 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "common/xf_headers.hpp"
+#include "dnn/xf_batch_queue.hpp"
+#include "xf_batch_pre_process_config.h"
+#include "xcl2.hpp"
+
+#include <math.h>
+#include <thread>
+
+// Host view of the tensor elements
+#if OUT_FP16
+typedef unsigned short out_host_t;
+#define OUT_QUANTUM 0.01f
+#else
+typedef signed char out_host_t;
+#define OUT_QUANTUM 1.0f
+#endif
+
+static float toFloat(out_host_t v) {
+#if OUT_FP16
+    int e = (v >> 10) & 0x1f;
+    int m = v & 0x3ff;
+    float f = (e == 0) ? ldexpf(m, -24) : ldexpf(m + 1024, e - 25);
+    return (v & 0x8000) ? -f : f;
+#else
+    return v;
+#endif
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cout << "Usage: " << argv[0] << " <INPUT IMAGE PATH 1> [<INPUT IMAGE PATH 2> ...]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Frames which fit the kernel maximum input size:
+    std::vector<cv::Mat> images;
+    for (int i = 1; i < argc; i++) {
+        cv::Mat img = cv::imread(argv[i], 1);
+        if (!img.data) {
+            std::cout << "ERROR: Cannot open image " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+        double s = std::min(1.0, std::min((double)HEIGHT / img.rows, (double)WIDTH / img.cols));
+        if (s < 1.0) cv::resize(img, img, cv::Size(), s, s, cv::INTER_AREA);
+        images.push_back(img);
+    }
+
+    // Mean and scale per output channel, the int8 quantization scale is folded into the scale:
+    float mean[CHANNELS] = {123.675f, 116.28f, 103.53f};
+    float stdev[CHANNELS] = {58.395f, 57.12f, 57.375f};
+#if OUT_FP16
+    float qscale = 1.0f;
+#else
+    float qscale = 32.0f;
+#endif
+    float params[2 * CHANNELS];
+    for (int c = 0; c < CHANNELS; c++) {
+        params[c] = mean[c];
+        params[CHANNELS + c] = qscale / stdev[c];
+    }
+    int pad = 114;
+    int swap_rb = 1;
+
+    // Camera streams, each one pushes every image at its own size through a
+    // single frame buffer, which it overwrites as soon as push() returns:
+    xf::cv::BatchQueue queue(NUM_STREAMS, MAX_BATCH, OUT_HEIGHT, OUT_WIDTH, HEIGHT, WIDTH, INPUT_PTR_WIDTH, 4);
+    std::vector<std::thread> cameras;
+    for (int s = 0; s < NUM_STREAMS; s++) {
+        cameras.push_back(std::thread([&queue, &images, s] {
+            cv::Mat frame(images[0].rows / (s + 1), images[0].cols / (s + 1), CV_8UC3);
+            for (size_t i = 0; i < images.size(); i++) {
+                cv::resize(images[i], frame, frame.size(), 0, 0, cv::INTER_AREA);
+                queue.push(s, frame);
+            }
+        }));
+    }
+    std::thread closer([&queue, &cameras] {
+        for (size_t s = 0; s < cameras.size(); s++) cameras[s].join();
+        queue.close();
+    });
+
+    // OpenCL section:
+    size_t frame_elems = CHANNELS * OUT_HEIGHT * OUT_WIDTH;
+    size_t image_in_size_bytes = queue.maxInputBytes(CHANNELS);
+    size_t desc_size_bytes = MAX_BATCH * xf::cv::XF_BATCH_DESC_SIZE * sizeof(int);
+    size_t tensor_size_bytes = MAX_BATCH * frame_elems * sizeof(out_host_t);
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_batchpreprocess");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "batch_pre_process_accel", &err));
+
+    // Allocate the buffers once for a full batch of maximum size frames:
+    OCL_CHECK(err, cl::Buffer buffer_inImage(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outTensor(context, CL_MEM_WRITE_ONLY, tensor_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_desc(context, CL_MEM_READ_ONLY, desc_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_params(context, CL_MEM_READ_ONLY, sizeof(params), NULL, &err));
+
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_params, CL_TRUE, 0, sizeof(params), params));
+
+    std::vector<unsigned char> packed;
+    std::vector<int> desc;
+    std::vector<int> streams;
+    std::vector<out_host_t> tensor(MAX_BATCH * frame_elems);
+    int frames = 0;
+    int errors = 0;
+    double total_time = 0;
+
+    while (!queue.finished()) {
+        int batch = queue.pop(packed, desc, streams, 100);
+        if (batch == 0) continue;
+
+        OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inImage, CL_TRUE, 0, packed.size(), packed.data()));
+        OCL_CHECK(err, q.enqueueWriteBuffer(buffer_desc, CL_TRUE, 0, desc.size() * sizeof(int), desc.data()));
+
+        // Set kernel arguments:
+        OCL_CHECK(err, err = kernel.setArg(0, buffer_inImage));
+        OCL_CHECK(err, err = kernel.setArg(1, buffer_outTensor));
+        OCL_CHECK(err, err = kernel.setArg(2, buffer_desc));
+        OCL_CHECK(err, err = kernel.setArg(3, buffer_params));
+        OCL_CHECK(err, err = kernel.setArg(4, batch));
+        OCL_CHECK(err, err = kernel.setArg(5, OUT_HEIGHT));
+        OCL_CHECK(err, err = kernel.setArg(6, OUT_WIDTH));
+        OCL_CHECK(err, err = kernel.setArg(7, pad));
+        OCL_CHECK(err, err = kernel.setArg(8, swap_rb));
+
+        // Execute the kernel:
+        cl::Event event;
+        OCL_CHECK(err, err = q.enqueueTask(kernel, NULL, &event));
+        clWaitForEvents(1, (const cl_event*)&event);
+        cl_ulong start = 0;
+        cl_ulong end = 0;
+        event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+        event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+        total_time += (end - start) / 1000000.0;
+
+        // Copy Result from Device Global Memory to Host Local Memory
+        OCL_CHECK(err, q.enqueueReadBuffer(buffer_outTensor, CL_TRUE, 0, batch * frame_elems * sizeof(out_host_t),
+                                           tensor.data()));
+
+        // OpenCV reference of each frame, rebuilt from the packed input:
+        for (int n = 0; n < batch; n++) {
+            int* d = &desc[n * xf::cv::XF_BATCH_DESC_SIZE];
+            cv::Mat frame(d[xf::cv::XF_BATCH_DESC_ROWS], d[xf::cv::XF_BATCH_DESC_COLS], CV_8UC3,
+                          &packed[(size_t)d[xf::cv::XF_BATCH_DESC_OFFSET] * (INPUT_PTR_WIDTH / 8)]);
+            cv::Mat resized, boxed, rgb;
+            cv::resize(frame, resized, cv::Size(d[xf::cv::XF_BATCH_DESC_RS_COLS], d[xf::cv::XF_BATCH_DESC_RS_ROWS]),
+                       0, 0, cv::INTER_LINEAR);
+            boxed.create(OUT_HEIGHT, OUT_WIDTH, CV_8UC3);
+            boxed.setTo(cv::Scalar(pad, pad, pad));
+            resized.copyTo(boxed(cv::Rect(d[xf::cv::XF_BATCH_DESC_PAD_LEFT], d[xf::cv::XF_BATCH_DESC_PAD_TOP],
+                                          resized.cols, resized.rows)));
+            if (swap_rb)
+                cv::cvtColor(boxed, rgb, cv::COLOR_BGR2RGB);
+            else
+                rgb = boxed;
+
+            out_host_t* t = &tensor[n * frame_elems];
+            for (int y = 0; y < OUT_HEIGHT; y++) {
+                for (int x = 0; x < OUT_WIDTH; x++) {
+                    for (int c = 0; c < CHANNELS; c++) {
+                        float ref = (rgb.at<cv::Vec3b>(y, x)[c] - params[c]) * params[CHANNELS + c];
+#if !OUT_FP16
+                        ref = std::max(-128.0f, std::min(127.0f, ref));
+#endif
+#if LAYOUT_NCHW
+                        float hw = toFloat(t[(c * OUT_HEIGHT + y) * OUT_WIDTH + x]);
+#else
+                        float hw = toFloat(t[(y * OUT_WIDTH + x) * CHANNELS + c]);
+#endif
+                        // Resize rounding differs from OpenCV by one pixel level, plus the output rounding
+                        if (fabs(hw - ref) > 2 * params[CHANNELS + c] + OUT_QUANTUM) errors++;
+                    }
+                }
+            }
+        }
+
+        std::cout << "INFO: Batch of " << batch << " frames from streams";
+        for (int n = 0; n < batch; n++) std::cout << " " << streams[n];
+        std::cout << std::endl;
+        frames += batch;
+    }
+    closer.join();
+
+    // Clean up:
+    q.finish();
+
+    std::cout << frames << " frames in " << total_time << "ms" << std::endl;
+
+    float err_per = frames ? 100.0f * errors / ((float)frames * frame_elems) : 100.0f;
+    std::cout << "INFO: Percentage of elements above error threshold = " << err_per << std::endl;
+
+    if (err_per > 1.0f) {
+        std::cout << "ERROR: Test Failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
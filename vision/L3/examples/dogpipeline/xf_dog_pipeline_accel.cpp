@@ -0,0 +1,61 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "xf_dog_pipeline_config.h"
+
+extern "C" {
+
+void dog_pipeline_accel(
+    ap_uint<INPUT_PTR_WIDTH>* img_in, ap_uint<OUTPUT_PTR_WIDTH>* img_out, int rows, int cols, float sigma) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=img_out       offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=sigma                       bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    xf::cv::Mat<TYPE, HEIGHT, WIDTH, NPC1> imgInput(rows, cols);
+    xf::cv::Mat<TYPE, HEIGHT, WIDTH, NPC1> imgOutput(rows, cols);
+
+// clang-format off
+    #pragma HLS STREAM variable=imgInput.data depth=2
+    #pragma HLS STREAM variable=imgOutput.data depth=2
+// clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    // The fork delays its identity branch by DogFork::DELAY_A words, derived from the latency of BlurStage:
+    BlurStage blur(sigma);
+    DogFork dog(xf::cv::IdentityStage<TYPE, HEIGHT, WIDTH, NPC1>(), blur);
+    DogPipeline pipeline(blur, dog);
+
+    // Retrieve xf::cv::Mat objects from img_in data:
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, TYPE, HEIGHT, WIDTH, NPC1>(img_in, imgInput);
+
+    // Run the blur and both branches of the fork:
+    pipeline.run(imgInput, imgOutput);
+
+    // Convert output xf::cv::Mat object to output array:
+    xf::cv::xfMat2Array<OUTPUT_PTR_WIDTH, TYPE, HEIGHT, WIDTH, NPC1>(imgOutput, img_out);
+
+    return;
+} // End of kernel
+
+} // End of extern C
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_DOG_PIPELINE_CONFIG_H_
+#define _XF_DOG_PIPELINE_CONFIG_H_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "imgproc/xf_pipeline.hpp"
+#include "xf_config_params.h"
+
+#define WIDTH 3840
+#define HEIGHT 2160
+
+#if FILTER_SIZE_3
+#define FILTER_WIDTH 3
+#elif FILTER_SIZE_5
+#define FILTER_WIDTH 5
+#elif FILTER_SIZE_7
+#define FILTER_WIDTH 7
+#endif
+
+// Resolve optimization type
+#if RO
+#define NPC1 XF_NPPC8
+#endif
+#if NO
+#define NPC1 XF_NPPC1
+#endif
+
+#define TYPE XF_8UC1
+
+typedef xf::cv::GaussianBlurStage<FILTER_WIDTH, XF_BORDER_CONSTANT, TYPE, HEIGHT, WIDTH, NPC1> BlurStage;
+
+// blurred - blur(blurred): the identity branch is delayed by the latency of the blur
+typedef xf::cv::PipeFork<xf::cv::IdentityStage<TYPE, HEIGHT, WIDTH, NPC1>,
+                         BlurStage,
+                         xf::cv::SubtractStage<XF_CONVERT_POLICY_SATURATE, TYPE, HEIGHT, WIDTH, NPC1> >
+    DogFork;
+
+// GaussianBlur -> DoG fork, the dataflow of the Difference of Gaussian example
+typedef xf::cv::Pipeline<BlurStage, DogFork> DogPipeline;
+
+#endif //_XF_DOG_PIPELINE_CONFIG_H_
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/xf_headers.hpp"
+#include "xf_dog_pipeline_config.h"
+#include "xcl2.hpp"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cout << "Usage: " << argv[0] << " <INPUT IMAGE PATH 1>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_gray, blurred, blurred2, ocv_ref, out_img, diff;
+
+    // Reading in the image:
+    in_gray = cv::imread(argv[1], 0);
+
+    if (!in_gray.data) {
+        std::cout << "ERROR: Cannot open image " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int rows = in_gray.rows;
+    int cols = in_gray.cols;
+
+#if FILTER_WIDTH == 3
+    float sigma = 0.5f;
+#endif
+#if FILTER_WIDTH == 7
+    float sigma = 1.16666f;
+#endif
+#if FILTER_WIDTH == 5
+    float sigma = 0.8333f;
+#endif
+
+    // The branches of the fork have different latencies, the identity branch is delayed to match the blur:
+    std::cout << "INFO: Fork branch latencies " << (int)xf::cv::IdentityStage<TYPE, HEIGHT, WIDTH, NPC1>::LATENCY
+              << " and " << (int)BlurStage::LATENCY << ", delays " << (int)DogFork::DELAY_A << " and "
+              << (int)DogFork::DELAY_B << std::endl;
+
+    // OpenCV reference, blurred - blur(blurred) saturated to 8 bits:
+    cv::GaussianBlur(in_gray, blurred, cv::Size(FILTER_WIDTH, FILTER_WIDTH), FILTER_WIDTH / 6.0, FILTER_WIDTH / 6.0,
+                     cv::BORDER_CONSTANT);
+    cv::GaussianBlur(blurred, blurred2, cv::Size(FILTER_WIDTH, FILTER_WIDTH), FILTER_WIDTH / 6.0, FILTER_WIDTH / 6.0,
+                     cv::BORDER_CONSTANT);
+    cv::subtract(blurred, blurred2, ocv_ref);
+
+    out_img.create(rows, cols, in_gray.depth());
+
+    // OpenCL section:
+    size_t image_in_size_bytes = rows * cols * sizeof(unsigned char);
+    size_t image_out_size_bytes = image_in_size_bytes;
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue queue(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_dogpipeline");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "dog_pipeline_accel", &err));
+
+    // Allocate the buffers:
+    OCL_CHECK(err, cl::Buffer buffer_inImage(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outImage(context, CL_MEM_WRITE_ONLY, image_out_size_bytes, NULL, &err));
+
+    // Set kernel arguments:
+    OCL_CHECK(err, err = kernel.setArg(0, buffer_inImage));
+    OCL_CHECK(err, err = kernel.setArg(1, buffer_outImage));
+    OCL_CHECK(err, err = kernel.setArg(2, rows));
+    OCL_CHECK(err, err = kernel.setArg(3, cols));
+    OCL_CHECK(err, err = kernel.setArg(4, sigma));
+
+    // Initialize the buffers:
+    cl::Event event;
+
+    OCL_CHECK(err, queue.enqueueWriteBuffer(buffer_inImage,      // buffer on the FPGA
+                                            CL_TRUE,             // blocking call
+                                            0,                   // buffer offset in bytes
+                                            image_in_size_bytes, // Size in bytes
+                                            in_gray.data,        // Pointer to the data to copy
+                                            nullptr, &event));
+
+    // Execute the kernel:
+    OCL_CHECK(err, err = queue.enqueueTask(kernel, NULL, &event));
+
+    clWaitForEvents(1, (const cl_event*)&event);
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    std::cout << ((end - start) / 1000000.0) << "ms" << std::endl;
+
+    // Copy Result from Device Global Memory to Host Local Memory
+    queue.enqueueReadBuffer(buffer_outImage, // This buffers data will be read
+                            CL_TRUE,         // blocking call
+                            0,               // offset
+                            image_out_size_bytes,
+                            out_img.data, // Data will be stored here
+                            nullptr, &event);
+
+    // Clean up:
+    queue.finish();
+
+    // Write the output of kernel:
+    cv::imwrite("output_hls.png", out_img);
+
+    // Results differ by the rounding of the two GaussianBlur
+    cv::absdiff(ocv_ref, out_img, diff);
+
+    float err_per;
+    xf::cv::analyzeDiff(diff, 2, err_per);
+
+    if (err_per > 1.0f) {
+        std::cout << "ERROR: Test Failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
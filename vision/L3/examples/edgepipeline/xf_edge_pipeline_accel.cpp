@@ -0,0 +1,70 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "xf_edge_pipeline_config.h"
+
+extern "C" {
+
+void edge_pipeline_accel(ap_uint<INPUT_PTR_WIDTH>* img_in,
+                         ap_uint<OUTPUT_PTR_WIDTH>* img_out,
+                         int rows,
+                         int cols,
+                         int rows_out,
+                         int cols_out,
+                         float sigma) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=img_out       offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=rows_out                    bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols_out                    bundle=control
+    #pragma HLS INTERFACE s_axilite  port=sigma                       bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgInput(rows, cols);
+    xf::cv::Mat<OUT_TYPE, OUT_HEIGHT, OUT_WIDTH, NPC1> imgOutput(rows_out, cols_out);
+
+// clang-format off
+    #pragma HLS STREAM variable=imgInput.data depth=2
+    #pragma HLS STREAM variable=imgOutput.data depth=2
+// clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    // Stage parameters, in pipeline order:
+    EdgePipeline pipeline(xf::cv::Bgr2GrayStage<IN_TYPE, GRAY_TYPE, HEIGHT, WIDTH, NPC1>(),
+                          xf::cv::ResizeStage<XF_INTERPOLATION_BILINEAR, GRAY_TYPE, HEIGHT, WIDTH, OUT_HEIGHT,
+                                              OUT_WIDTH, NPC1, 2>(rows_out, cols_out),
+                          xf::cv::GaussianBlurStage<FILTER_WIDTH, XF_BORDER_CONSTANT, GRAY_TYPE, OUT_HEIGHT, OUT_WIDTH,
+                                                    NPC1>(sigma));
+
+    // Retrieve xf::cv::Mat objects from img_in data:
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(img_in, imgInput);
+
+    // Run the whole chain, stages are connected by streams:
+    pipeline.run(imgInput, imgOutput);
+
+    // Convert output xf::cv::Mat object to output array:
+    xf::cv::xfMat2Array<OUTPUT_PTR_WIDTH, OUT_TYPE, OUT_HEIGHT, OUT_WIDTH, NPC1>(imgOutput, img_out);
+
+    return;
+} // End of kernel
+
+} // End of extern C
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _XF_EDGE_PIPELINE_CONFIG_H_
+#define _XF_EDGE_PIPELINE_CONFIG_H_
+
+#include "hls_stream.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "imgproc/xf_pipeline.hpp"
+#include "xf_config_params.h"
+
+// Input size
+#define WIDTH 3840
+#define HEIGHT 2160
+
+// Size after resize
+#define OUT_WIDTH 1920
+#define OUT_HEIGHT 1080
+
+#if FILTER_SIZE_3
+#define FILTER_WIDTH 3
+#elif FILTER_SIZE_5
+#define FILTER_WIDTH 5
+#elif FILTER_SIZE_7
+#define FILTER_WIDTH 7
+#endif
+
+// Resolve optimization type
+#if RO
+#define NPC1 XF_NPPC8
+#endif
+#if NO
+#define NPC1 XF_NPPC1
+#endif
+
+#define IN_TYPE XF_8UC3
+#define GRAY_TYPE XF_8UC1
+#define OUT_TYPE XF_16SC1
+
+// bgr2gray -> resize -> GaussianBlur -> Sobel -> magnitude, in one dataflow region
+typedef xf::cv::Pipeline<
+    xf::cv::Bgr2GrayStage<IN_TYPE, GRAY_TYPE, HEIGHT, WIDTH, NPC1>,
+    xf::cv::ResizeStage<XF_INTERPOLATION_BILINEAR, GRAY_TYPE, HEIGHT, WIDTH, OUT_HEIGHT, OUT_WIDTH, NPC1, 2>,
+    xf::cv::GaussianBlurStage<FILTER_WIDTH, XF_BORDER_CONSTANT, GRAY_TYPE, OUT_HEIGHT, OUT_WIDTH, NPC1>,
+    xf::cv::PipeSplit<
+        xf::cv::SobelStage<XF_BORDER_CONSTANT, XF_FILTER_3X3, GRAY_TYPE, OUT_TYPE, OUT_HEIGHT, OUT_WIDTH, NPC1>,
+        xf::cv::MagnitudeStage<XF_L1NORM, OUT_TYPE, OUT_TYPE, OUT_HEIGHT, OUT_WIDTH, NPC1> > >
+    EdgePipeline;
+
+#endif //_XF_EDGE_PIPELINE_CONFIG_H_
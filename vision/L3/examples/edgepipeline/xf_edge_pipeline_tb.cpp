@@ -0,0 +1,152 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/xf_headers.hpp"
+#include "xf_edge_pipeline_config.h"
+#include "xcl2.hpp"
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cout << "Usage: " << argv[0] << " <INPUT IMAGE PATH 1>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_img, gray, resized, blurred, gx, gy, ocv_ref, out_img, diff;
+
+    // Reading in the image:
+    in_img = cv::imread(argv[1], 1);
+
+    if (!in_img.data) {
+        std::cout << "ERROR: Cannot open image " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int rows = in_img.rows;
+    int cols = in_img.cols;
+    int rows_out = rows / 2;
+    int cols_out = cols / 2;
+
+#if FILTER_WIDTH == 3
+    float sigma = 0.5f;
+#endif
+#if FILTER_WIDTH == 7
+    float sigma = 1.16666f;
+#endif
+#if FILTER_WIDTH == 5
+    float sigma = 0.8333f;
+#endif
+
+    // OpenCV reference of the same chain:
+    cv::cvtColor(in_img, gray, cv::COLOR_BGR2GRAY);
+    cv::resize(gray, resized, cv::Size(cols_out, rows_out), 0, 0, cv::INTER_LINEAR);
+    cv::GaussianBlur(resized, blurred, cv::Size(FILTER_WIDTH, FILTER_WIDTH), FILTER_WIDTH / 6.0, FILTER_WIDTH / 6.0,
+                     cv::BORDER_CONSTANT);
+    cv::Sobel(blurred, gx, CV_16S, 1, 0, 3, 1, 0, cv::BORDER_CONSTANT);
+    cv::Sobel(blurred, gy, CV_16S, 0, 1, 3, 1, 0, cv::BORDER_CONSTANT);
+    ocv_ref = cv::abs(gx) + cv::abs(gy);
+
+    out_img.create(rows_out, cols_out, CV_16SC1);
+
+    // OpenCL section:
+    size_t image_in_size_bytes = rows * cols * 3 * sizeof(unsigned char);
+    size_t image_out_size_bytes = rows_out * cols_out * sizeof(short);
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue queue(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_edgepipeline");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "edge_pipeline_accel", &err));
+
+    // Allocate the buffers:
+    OCL_CHECK(err, cl::Buffer buffer_inImage(context, CL_MEM_READ_ONLY, image_in_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outImage(context, CL_MEM_WRITE_ONLY, image_out_size_bytes, NULL, &err));
+
+    // Set kernel arguments:
+    OCL_CHECK(err, err = kernel.setArg(0, buffer_inImage));
+    OCL_CHECK(err, err = kernel.setArg(1, buffer_outImage));
+    OCL_CHECK(err, err = kernel.setArg(2, rows));
+    OCL_CHECK(err, err = kernel.setArg(3, cols));
+    OCL_CHECK(err, err = kernel.setArg(4, rows_out));
+    OCL_CHECK(err, err = kernel.setArg(5, cols_out));
+    OCL_CHECK(err, err = kernel.setArg(6, sigma));
+
+    // Initialize the buffers:
+    cl::Event event;
+
+    OCL_CHECK(err, queue.enqueueWriteBuffer(buffer_inImage,      // buffer on the FPGA
+                                            CL_TRUE,             // blocking call
+                                            0,                   // buffer offset in bytes
+                                            image_in_size_bytes, // Size in bytes
+                                            in_img.data,         // Pointer to the data to copy
+                                            nullptr, &event));
+
+    // Execute the kernel:
+    OCL_CHECK(err, err = queue.enqueueTask(kernel, NULL, &event));
+
+    clWaitForEvents(1, (const cl_event*)&event);
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    std::cout << ((end - start) / 1000000.0) << "ms" << std::endl;
+
+    // Copy Result from Device Global Memory to Host Local Memory
+    queue.enqueueReadBuffer(buffer_outImage, // This buffers data will be read
+                            CL_TRUE,         // blocking call
+                            0,               // offset
+                            image_out_size_bytes,
+                            out_img.data, // Data will be stored here
+                            nullptr, &event);
+
+    // Clean up:
+    queue.finish();
+
+    // Write the output of kernel:
+    cv::Mat out_8u;
+    out_img.convertTo(out_8u, CV_8U);
+    cv::imwrite("output_hls.png", out_8u);
+
+    // Results differ by the rounding of resize and GaussianBlur, amplified by Sobel
+    cv::absdiff(ocv_ref, out_img, diff);
+
+    float err_per;
+    xf::cv::analyzeDiff(diff, 8, err_per);
+
+    if (err_per > 1.0f) {
+        std::cout << "ERROR: Test Failed." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
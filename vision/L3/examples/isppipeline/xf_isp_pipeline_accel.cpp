@@ -0,0 +1,173 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xf_isp_pipeline_config.h"
+
+static void statsWrite(hls::stream<unsigned int>& awb_stats,
+                       hls::stream<unsigned int>& ltm_stats,
+                       unsigned int* stats_out) {
+    for (int i = 0; i < STATS_SIZE; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        stats_out[i] = (i < XF_ISP_STATS_SIZE) ? awb_stats.read() : ltm_stats.read();
+    }
+}
+
+static void isp_pipeline(ap_uint<INPUT_PTR_WIDTH>* img_long,
+                         ap_uint<INPUT_PTR_WIDTH>* img_short,
+                         ap_uint<OUTPUT_PTR_WIDTH>* img_out,
+                         unsigned int* stats_out,
+                         float ccm[9],
+                         float offset[3],
+                         unsigned short lm[LTM_GRID_ROWS][LTM_GRID_COLS],
+                         float ratio,
+                         int t1,
+                         int t2,
+                         int sat_thresh,
+                         float rgain,
+                         float ggain,
+                         float bgain,
+                         float key,
+                         float gamma,
+                         int rows,
+                         int cols) {
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgLong(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgShort(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgMerged(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgBpc(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgStats(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgWb(rows, cols);
+    xf::cv::Mat<RGB_TYPE, HEIGHT, WIDTH, NPC1> imgDemosaic(rows, cols);
+    xf::cv::Mat<RGB_TYPE, HEIGHT, WIDTH, NPC1> imgCcm(rows, cols);
+    xf::cv::Mat<OUT_TYPE, HEIGHT, WIDTH, NPC1> imgLtm(rows, cols);
+    xf::cv::Mat<OUT_TYPE, HEIGHT, WIDTH, NPC1> imgOutput(rows, cols);
+
+    // The statistics are written at the end of the frame, the streams hold all of them
+    hls::stream<unsigned int> awbStats;
+    hls::stream<unsigned int> ltmStats;
+
+// clang-format off
+    #pragma HLS STREAM variable=imgLong.data depth=2
+    #pragma HLS STREAM variable=imgShort.data depth=2
+    #pragma HLS STREAM variable=imgMerged.data depth=2
+    #pragma HLS STREAM variable=imgBpc.data depth=2
+    #pragma HLS STREAM variable=imgStats.data depth=2
+    #pragma HLS STREAM variable=imgWb.data depth=2
+    #pragma HLS STREAM variable=imgDemosaic.data depth=2
+    #pragma HLS STREAM variable=imgCcm.data depth=2
+    #pragma HLS STREAM variable=imgLtm.data depth=2
+    #pragma HLS STREAM variable=imgOutput.data depth=2
+    #pragma HLS STREAM variable=awbStats depth=XF_ISP_STATS_SIZE
+    #pragma HLS STREAM variable=ltmStats depth=LTM_GRID_ROWS*LTM_GRID_COLS
+// clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(img_long, imgLong);
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(img_short, imgShort);
+
+    // Raw domain: exposure merge, defect correction, statistics and white balance
+    xf::cv::hdrmerge<IN_TYPE, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgLong, imgShort, imgMerged, ratio, t1, t2);
+    xf::cv::badpixelcorrection<IN_TYPE, HEIGHT, WIDTH, NPC1, XF_BORDER_CONSTANT, XF_USE_URAM>(imgMerged, imgBpc);
+    xf::cv::ispstats<BPATTERN, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgBpc, imgStats, awbStats, sat_thresh);
+    xf::cv::gaincontrol<BPATTERN, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgStats, imgWb, rgain, ggain, bgain);
+
+    // RGB domain: demosaic, color correction, tone mapping and gamma
+    xf::cv::demosaicing<BPATTERN, IN_TYPE, RGB_TYPE, HEIGHT, WIDTH, NPC1, XF_USE_URAM>(imgWb, imgDemosaic);
+    xf::cv::colorcorrectionmatrix<RGB_TYPE, RGB_TYPE, HEIGHT, WIDTH, NPC1>(imgDemosaic, imgCcm, ccm, offset);
+    xf::cv::localtonemapping<RGB_TYPE, OUT_TYPE, HEIGHT, WIDTH, NPC1, LTM_GRID_ROWS, LTM_GRID_COLS>(imgCcm, imgLtm,
+                                                                                                  lm, ltmStats, key);
+    xf::cv::gammacorrection<OUT_TYPE, OUT_TYPE, HEIGHT, WIDTH, NPC1>(imgLtm, imgOutput, gamma);
+
+    xf::cv::xfMat2Array<OUTPUT_PTR_WIDTH, OUT_TYPE, HEIGHT, WIDTH, NPC1>(imgOutput, img_out);
+    statsWrite(awbStats, ltmStats, stats_out);
+}
+
+extern "C" {
+
+void isp_pipeline_accel(ap_uint<INPUT_PTR_WIDTH>* img_long,
+                        ap_uint<INPUT_PTR_WIDTH>* img_short,
+                        ap_uint<OUTPUT_PTR_WIDTH>* img_out,
+                        unsigned int* stats_in,
+                        unsigned int* stats_out,
+                        float* ccm,
+                        float ratio,
+                        int t1,
+                        int t2,
+                        int sat_thresh,
+                        float key,
+                        float gamma,
+                        int rows,
+                        int cols) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_long      offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=img_short     offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=img_out       offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=stats_in      offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE m_axi      port=stats_out     offset=slave  bundle=gmem4
+    #pragma HLS INTERFACE m_axi      port=ccm           offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE s_axilite  port=ratio                       bundle=control
+    #pragma HLS INTERFACE s_axilite  port=t1                          bundle=control
+    #pragma HLS INTERFACE s_axilite  port=t2                          bundle=control
+    #pragma HLS INTERFACE s_axilite  port=sat_thresh                  bundle=control
+    #pragma HLS INTERFACE s_axilite  port=key                         bundle=control
+    #pragma HLS INTERFACE s_axilite  port=gamma                       bundle=control
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    // Statistics of the previous frame: white balance gains and local tone mapping grid
+    unsigned int stats[STATS_SIZE];
+    float coeffs[9];
+    float offset[3];
+    unsigned short lm[LTM_GRID_ROWS][LTM_GRID_COLS];
+// clang-format off
+    #pragma HLS ARRAY_PARTITION variable=coeffs complete dim=0
+    #pragma HLS ARRAY_PARTITION variable=offset complete dim=0
+    // clang-format on
+
+    for (int i = 0; i < STATS_SIZE; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        stats[i] = stats_in[i];
+    }
+    for (int i = 0; i < CCM_SIZE; i++) {
+// clang-format off
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        if (i < 9)
+            coeffs[i] = ccm[i];
+        else
+            offset[i - 9] = ccm[i];
+    }
+
+    float rgain, ggain, bgain;
+    xf::cv::awbGains(stats, rgain, ggain, bgain);
+    xf::cv::ltmGridMeans<LTM_GRID_ROWS, LTM_GRID_COLS, NPC1>(stats + XF_ISP_STATS_SIZE, rows, cols, lm);
+
+    isp_pipeline(img_long, img_short, img_out, stats_out, coeffs, offset, lm, ratio, t1, t2, sat_thresh, rgain, ggain,
+                 bgain, key, gamma, rows, cols);
+
+    return;
+} // End of kernel
+
+} // End of extern C
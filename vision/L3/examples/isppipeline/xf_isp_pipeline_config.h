@@ -0,0 +1,54 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_ISP_PIPELINE_CONFIG_H_
+#define _XF_ISP_PIPELINE_CONFIG_H_
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "imgproc/xf_hdrmerge.hpp"
+#include "imgproc/xf_bpc.hpp"
+#include "imgproc/xf_isp_stats.hpp"
+#include "imgproc/xf_gaincontrol.hpp"
+#include "imgproc/xf_demosaicing.hpp"
+#include "imgproc/xf_colorcorrectionmatrix.hpp"
+#include "imgproc/xf_ltm.hpp"
+#include "imgproc/xf_gammacorrection.hpp"
+#include "xf_config_params.h"
+
+// Maximum frame size
+#define WIDTH 3840
+#define HEIGHT 2160
+
+#define NPC1 NPPC
+
+// Raw exposures, up to 16 bits, and merged raw frame
+#define IN_TYPE XF_16UC1
+// Demosaiced and color corrected linear frame
+#define RGB_TYPE XF_16UC3
+// Tone mapped output
+#define OUT_TYPE XF_8UC3
+
+// Side channel: auto exposure and white balance statistics, then the local tone mapping block sums
+#define STATS_SIZE (XF_ISP_STATS_SIZE + LTM_GRID_ROWS * LTM_GRID_COLS)
+
+// Color correction matrix, 9 coefficients then 3 offsets
+#define CCM_SIZE 12
+
+#endif // _XF_ISP_PIPELINE_CONFIG_H_
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_ISP_PIPELINE_REF_HPP_
+#define _XF_ISP_PIPELINE_REF_HPP_
+
+#include <math.h>
+#include <algorithm>
+#include <vector>
+
+// Floating point model of the pipeline for an RGGB sensor, on continuous 16 bit raw frames
+
+// 0 B, 1 G, 2 R
+static inline int refBayerChannel(int row, int col) {
+    if ((row & 1) == 0) return (col & 1) ? 1 : 2;
+    return (col & 1) ? 0 : 1;
+}
+
+static inline int refClamp(double v, int maxval) {
+    int i = (int)floor(v + 0.5);
+    return (i < 0) ? 0 : ((i > maxval) ? maxval : i);
+}
+
+static void refHdrMerge(const unsigned short* l,
+                        const unsigned short* s,
+                        std::vector<unsigned short>& out,
+                        int n,
+                        float ratio,
+                        int t1,
+                        int t2) {
+    out.resize(n);
+    for (int i = 0; i < n; i++) {
+        double w = (l[i] <= t1) ? 1.0 : ((l[i] >= t2) ? 0.0 : (double)(t2 - l[i]) / (t2 - t1));
+        out[i] = refClamp(l[i] * w + s[i] * ratio * (1.0 - w), 65535);
+    }
+}
+
+// Clamp to the range of the 8 pixels of the same color, zero outside the image
+static void refBpc(const std::vector<unsigned short>& in, std::vector<unsigned short>& out, int rows, int cols) {
+    out.resize(in.size());
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int mn = 65535, mx = 0;
+            for (int dy = -2; dy <= 2; dy += 2) {
+                for (int dx = -2; dx <= 2; dx += 2) {
+                    if (dy == 0 && dx == 0) continue;
+                    int yy = y + dy, xx = x + dx;
+                    int v = (yy < 0 || yy >= rows || xx < 0 || xx >= cols) ? 0 : in[yy * cols + xx];
+                    mn = (v < mn) ? v : mn;
+                    mx = (v > mx) ? v : mx;
+                }
+            }
+            int c = in[y * cols + x];
+            out[y * cols + x] = (c < mn) ? mn : ((c > mx) ? mx : c);
+        }
+    }
+}
+
+static void refStats(const std::vector<unsigned short>& in, int rows, int cols, int sat_thresh, unsigned int* stats) {
+    for (int i = 0; i < XF_ISP_STATS_SIZE; i++) stats[i] = 0;
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int v = in[y * cols + x];
+            int c = refBayerChannel(y, x);
+            if (v < sat_thresh) {
+                stats[XF_ISP_STATS_SUM_B + c] += v >> 8;
+                stats[XF_ISP_STATS_CNT_B + c]++;
+            }
+            stats[XF_ISP_STATS_HIST + (v >> 8)]++;
+        }
+    }
+}
+
+// Gray world gains relative to green from the statistics of the previous frame, unit gains without statistics
+static void refAwbGains(const unsigned int* stats, float& rgain, float& ggain, float& bgain) {
+    double mean[3];
+    bool valid = true;
+    for (int c = 0; c < 3; c++) {
+        unsigned int n = stats[XF_ISP_STATS_CNT_B + c];
+        mean[c] = n ? (double)stats[XF_ISP_STATS_SUM_B + c] / n : 0.0;
+        valid = valid && (mean[c] > 0.0);
+    }
+    rgain = valid ? (float)std::min(15.0, mean[1] / mean[2]) : 1.0f;
+    ggain = 1.0f;
+    bgain = valid ? (float)std::min(15.0, mean[1] / mean[0]) : 1.0f;
+}
+
+// Blocks of the tone mapping grid, the width a whole number of NPC words
+static void refBlockSize(int rows, int cols, int& bh, int& bw) {
+    const int npc = XF_NPIXPERCYCLE(NPC1);
+    bh = (int)ceil((double)rows / LTM_GRID_ROWS);
+    bw = (int)ceil(ceil((double)cols / LTM_GRID_COLS) / npc) * npc;
+}
+
+// Mean luminance of each block from the block sums of the previous frame, a quarter of the range without statistics
+static void refGridMeans(const unsigned int* blk_sums,
+                         int rows,
+                         int cols,
+                         unsigned short lm[LTM_GRID_ROWS][LTM_GRID_COLS]) {
+    int bh, bw;
+    refBlockSize(rows, cols, bh, bw);
+    for (int by = 0; by < LTM_GRID_ROWS; by++) {
+        for (int bx = 0; bx < LTM_GRID_COLS; bx++) {
+            int h = std::min(bh, rows - by * bh);
+            int w = std::min(bw, cols - bx * bw);
+            unsigned int s = blk_sums[by * LTM_GRID_COLS + bx];
+            lm[by][bx] = (h > 0 && w > 0 && s > 0) ? (unsigned short)(s / (h * w)) : (1 << (XF_LTM_BITS - 2));
+        }
+    }
+}
+
+static void refGain(std::vector<unsigned short>& img, int rows, int cols, float rgain, float ggain, float bgain) {
+    float gain[3] = {bgain, ggain, rgain};
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            double v = img[y * cols + x] * (double)gain[refBayerChannel(y, x)];
+            img[y * cols + x] = (v > 65535) ? 65535 : (int)v;
+        }
+    }
+}
+
+// Malvar-He-Cutler interpolation, zero outside the image, BGR output
+static void refDemosaic(const std::vector<unsigned short>& in, std::vector<int>& bgr, int rows, int cols) {
+    bgr.resize(3 * in.size());
+    auto p = [&](int y, int x) -> int {
+        return (y < 0 || y >= rows || x < 0 || x >= cols) ? 0 : in[y * cols + x];
+    };
+    auto fix = [](int v) { return (v < 0) ? 0 : ((v > 65535) ? 65535 : v); };
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            int c = p(y, x);
+            int cross = p(y - 2, x) + p(y, x - 2) + p(y, x + 2) + p(y + 2, x);
+            int plus = p(y - 1, x) + p(y, x - 1) + p(y, x + 1) + p(y + 1, x);
+            int diag = p(y - 1, x - 1) + p(y - 1, x + 1) + p(y + 1, x - 1) + p(y + 1, x + 1);
+            int g = fix((-cross + 2 * plus + 4 * c) / 8);
+            int rb = fix((-(cross * 3) / 2 + 2 * diag + 6 * c) / 8);
+            // same color along the row, then along the column
+            int hrow = fix((((p(y - 2, x) + p(y + 2, x)) >> 1) - (diag + p(y, x - 2) + p(y, x + 2)) +
+                            4 * (p(y, x - 1) + p(y, x + 1)) + 5 * c) /
+                           8);
+            int hcol = fix(((p(y, x - 2) + p(y, x + 2)) / 2 - (diag + p(y - 2, x) + p(y + 2, x)) +
+                            4 * (p(y - 1, x) + p(y + 1, x)) + 5 * c) /
+                           8);
+            int b, gg, r;
+            switch (refBayerChannel(y, x)) {
+                case 2:
+                    r = c, gg = g, b = rb;
+                    break;
+                case 0:
+                    b = c, gg = g, r = rb;
+                    break;
+                default:
+                    gg = c;
+                    // R rows hold the R pixels left and right of a G pixel
+                    if ((y & 1) == 0)
+                        r = hrow, b = hcol;
+                    else
+                        b = hrow, r = hcol;
+            }
+            int* o = &bgr[3 * (y * cols + x)];
+            o[0] = b, o[1] = gg, o[2] = r;
+        }
+    }
+}
+
+static void refCcm(std::vector<int>& bgr, const float* ccm, const float* offset) {
+    for (size_t i = 0; i < bgr.size(); i += 3) {
+        int o[3];
+        for (int c = 0; c < 3; c++) {
+            double acc = offset[c];
+            for (int k = 0; k < 3; k++) acc += ccm[3 * c + k] * bgr[i + k];
+            o[c] = refClamp(acc, 65535);
+        }
+        for (int c = 0; c < 3; c++) bgr[i + c] = o[c];
+    }
+}
+
+// Grid based Reinhard tone mapping with the block means of the previous frame, then gamma
+static void refToneMap(const std::vector<int>& bgr,
+                       std::vector<unsigned char>& out,
+                       unsigned int* blk_sums,
+                       const unsigned short lm[LTM_GRID_ROWS][LTM_GRID_COLS],
+                       int rows,
+                       int cols,
+                       float key,
+                       float gamma) {
+    int bh, bw;
+    refBlockSize(rows, cols, bh, bw);
+    for (int i = 0; i < LTM_GRID_ROWS * LTM_GRID_COLS; i++) blk_sums[i] = 0;
+
+    unsigned char lut[256];
+    for (int i = 0; i < 256; i++) {
+        int v = (int)(pow(i / 255.0, gamma) * 255.0);
+        lut[i] = (v > 255) ? 255 : v;
+    }
+
+    out.resize(bgr.size());
+    for (int y = 0; y < rows; y++) {
+        double fy = (y + 0.5) / bh - 0.5;
+        int by0 = (fy < 0) ? 0 : ((int)fy > LTM_GRID_ROWS - 1 ? LTM_GRID_ROWS - 1 : (int)fy);
+        double wy = (fy < 0 || by0 >= LTM_GRID_ROWS - 1) ? 0.0 : fy - by0;
+        int by1 = (by0 + 1 > LTM_GRID_ROWS - 1) ? LTM_GRID_ROWS - 1 : by0 + 1;
+        for (int x = 0; x < cols; x++) {
+            double fx = (x + 0.5) / bw - 0.5;
+            int bx0 = (fx < 0) ? 0 : ((int)fx > LTM_GRID_COLS - 1 ? LTM_GRID_COLS - 1 : (int)fx);
+            double wx = (fx < 0 || bx0 >= LTM_GRID_COLS - 1) ? 0.0 : fx - bx0;
+            int bx1 = (bx0 + 1 > LTM_GRID_COLS - 1) ? LTM_GRID_COLS - 1 : bx0 + 1;
+            double l = (lm[by0][bx0] * (1 - wx) + lm[by0][bx1] * wx) * (1 - wy) +
+                       (lm[by1][bx0] * (1 - wx) + lm[by1][bx1] * wx) * wy;
+            l *= 1 << (16 - XF_LTM_BITS);
+            if (l < 1) l = 1;
+
+            const int* p = &bgr[3 * (y * cols + x)];
+            int lum = (p[0] + 2 * p[1] + p[2]) >> 2;
+            blk_sums[(y / bh) * LTM_GRID_COLS + x / bw] += lum >> (16 - XF_LTM_BITS);
+            double q = 255.0 * key / (l + key * lum);
+            for (int c = 0; c < 3; c++) out[3 * (y * cols + x) + c] = lut[refClamp(p[c] * q, 255)];
+        }
+    }
+}
+
+#endif // _XF_ISP_PIPELINE_REF_HPP_
@@ -0,0 +1,221 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "common/xf_headers.hpp"
+#include "xf_isp_pipeline_config.h"
+#include "xf_isp_pipeline_ref.hpp"
+#include "xcl2.hpp"
+
+#define NUM_FRAMES 2
+
+// Sensor model: 12 bit exposures, the long one 16 times the short one
+#define SENSOR_MAX 4095
+#define EXPOSURE_RATIO 16.0f
+
+// Raw exposures of an RGGB sensor from an 8 bit BGR image, with a color cast and hot pixels
+static void makeExposures(const cv::Mat& img, std::vector<unsigned short>& lexp, std::vector<unsigned short>& sexp) {
+    const float cast[3] = {0.6f, 1.0f, 0.8f};
+    lexp.resize(img.rows * img.cols);
+    sexp.resize(img.rows * img.cols);
+    for (int y = 0; y < img.rows; y++) {
+        for (int x = 0; x < img.cols; x++) {
+            int c = refBayerChannel(y, x);
+            float lin = powf(img.at<cv::Vec3b>(y, x)[c] / 255.0f, 2.2f) * cast[c];
+            float radiance = lin * SENSOR_MAX * EXPOSURE_RATIO / 4;
+            int i = y * img.cols + x;
+            lexp[i] = (radiance > SENSOR_MAX) ? SENSOR_MAX : (unsigned short)radiance;
+            sexp[i] = (unsigned short)(radiance / EXPOSURE_RATIO);
+            if (i % 97 == 0) {
+                lexp[i] = SENSOR_MAX;
+                sexp[i] = SENSOR_MAX;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <INPUT IMAGE PATH 1>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_img = cv::imread(argv[1], 1);
+    if (!in_img.data) {
+        fprintf(stderr, "ERROR: Cannot open image %s\n ", argv[1]);
+        return EXIT_FAILURE;
+    }
+    int rows = in_img.rows;
+    int cols = in_img.cols;
+    assert((rows <= HEIGHT) && (cols <= WIDTH) && "Image larger than the kernel maximum");
+    assert((cols % XF_NPIXPERCYCLE(NPC1) == 0) && "Image width must be a multiple of NPC");
+
+    std::vector<unsigned short> lexp, sexp;
+    makeExposures(in_img, lexp, sexp);
+
+    // Tuning, the color correction matrix is in the BGR order of the demosaiced image
+    float ccm[CCM_SIZE] = {1.6f, -0.5f, -0.1f, -0.2f, 1.5f, -0.3f, -0.2f, -0.4f, 1.6f, 0.0f, 0.0f, 0.0f};
+    float ratio = EXPOSURE_RATIO;
+    int t1 = 3000;
+    int t2 = 4000;
+    int sat_thresh = 65000;
+    float key = 0.18f;
+    float gamma = 0.4545f;
+
+    size_t raw_size_bytes = rows * cols * sizeof(unsigned short);
+    size_t image_out_size_bytes = rows * cols * 3 * sizeof(unsigned char);
+    size_t stats_size_bytes = STATS_SIZE * sizeof(unsigned int);
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_isppipeline");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create a kernel:
+    OCL_CHECK(err, cl::Kernel kernel(program, "isp_pipeline_accel", &err));
+
+    // Allocate the buffers, the statistics ping-pong between the frames:
+    OCL_CHECK(err, cl::Buffer buffer_inLong(context, CL_MEM_READ_ONLY, raw_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_inShort(context, CL_MEM_READ_ONLY, raw_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_outImage(context, CL_MEM_WRITE_ONLY, image_out_size_bytes, NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_ccm(context, CL_MEM_READ_ONLY, sizeof(ccm), NULL, &err));
+    cl::Buffer buffer_stats[2];
+    for (int i = 0; i < 2; i++) {
+        OCL_CHECK(err, buffer_stats[i] = cl::Buffer(context, CL_MEM_READ_WRITE, stats_size_bytes, NULL, &err));
+    }
+
+    // No statistics before the first frame
+    std::vector<unsigned int> stats(STATS_SIZE, 0);
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_stats[0], CL_TRUE, 0, stats_size_bytes, stats.data()));
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_ccm, CL_TRUE, 0, sizeof(ccm), ccm));
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inLong, CL_TRUE, 0, raw_size_bytes, lexp.data()));
+    OCL_CHECK(err, q.enqueueWriteBuffer(buffer_inShort, CL_TRUE, 0, raw_size_bytes, sexp.data()));
+
+    // Reference state
+    std::vector<unsigned int> ref_stats(STATS_SIZE, 0);
+    std::vector<unsigned short> merged, bpc;
+    std::vector<int> bgr;
+    std::vector<unsigned char> ref_out;
+    cv::Mat out_img(rows, cols, CV_8UC3);
+    int errors = 0;
+
+    for (int f = 0; f < NUM_FRAMES; f++) {
+        // Set kernel arguments:
+        OCL_CHECK(err, err = kernel.setArg(0, buffer_inLong));
+        OCL_CHECK(err, err = kernel.setArg(1, buffer_inShort));
+        OCL_CHECK(err, err = kernel.setArg(2, buffer_outImage));
+        OCL_CHECK(err, err = kernel.setArg(3, buffer_stats[f & 1]));
+        OCL_CHECK(err, err = kernel.setArg(4, buffer_stats[(f + 1) & 1]));
+        OCL_CHECK(err, err = kernel.setArg(5, buffer_ccm));
+        OCL_CHECK(err, err = kernel.setArg(6, ratio));
+        OCL_CHECK(err, err = kernel.setArg(7, t1));
+        OCL_CHECK(err, err = kernel.setArg(8, t2));
+        OCL_CHECK(err, err = kernel.setArg(9, sat_thresh));
+        OCL_CHECK(err, err = kernel.setArg(10, key));
+        OCL_CHECK(err, err = kernel.setArg(11, gamma));
+        OCL_CHECK(err, err = kernel.setArg(12, rows));
+        OCL_CHECK(err, err = kernel.setArg(13, cols));
+
+        // Profiling Objects
+        cl_ulong start = 0;
+        cl_ulong end = 0;
+        double diff_prof = 0.0f;
+        cl::Event event;
+
+        // Launch the kernel
+        OCL_CHECK(err, err = q.enqueueTask(kernel, NULL, &event));
+        clWaitForEvents(1, (const cl_event*)&event);
+
+        event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+        event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+        diff_prof = end - start;
+        std::cout << "INFO: Frame " << f << " " << (diff_prof / 1000000) << "ms" << std::endl;
+
+        OCL_CHECK(err, q.enqueueReadBuffer(buffer_outImage, CL_TRUE, 0, image_out_size_bytes, out_img.data));
+        OCL_CHECK(err, q.enqueueReadBuffer(buffer_stats[(f + 1) & 1], CL_TRUE, 0, stats_size_bytes, stats.data()));
+
+        // Reference model, with the statistics of its own previous frame
+        float rgain, ggain, bgain;
+        unsigned short lm[LTM_GRID_ROWS][LTM_GRID_COLS];
+        refAwbGains(ref_stats.data(), rgain, ggain, bgain);
+        refGridMeans(ref_stats.data() + XF_ISP_STATS_SIZE, rows, cols, lm);
+
+        refHdrMerge(lexp.data(), sexp.data(), merged, rows * cols, ratio, t1, t2);
+        refBpc(merged, bpc, rows, cols);
+        refStats(bpc, rows, cols, sat_thresh, ref_stats.data());
+        refGain(bpc, rows, cols, rgain, ggain, bgain);
+        refDemosaic(bpc, bgr, rows, cols);
+        refCcm(bgr, ccm, ccm + 9);
+        refToneMap(bgr, ref_out, ref_stats.data() + XF_ISP_STATS_SIZE, lm, rows, cols, key, gamma);
+
+        // Output, the border of the 5x5 windows excluded
+        int pix_errors = 0, checked = 0, max_diff = 0;
+        for (int y = 4; y < rows - 4; y++) {
+            for (int x = 4; x < cols - 4; x++) {
+                for (int c = 0; c < 3; c++) {
+                    int i = 3 * (y * cols + x) + c;
+                    int d = abs((int)out_img.data[i] - (int)ref_out[i]);
+                    max_diff = (d > max_diff) ? d : max_diff;
+                    if (d > 3) pix_errors++;
+                    checked++;
+                }
+            }
+        }
+        float err_per = 100.0f * pix_errors / checked;
+        std::cout << "INFO: Frame " << f << " max difference " << max_diff << ", " << err_per << "% above 3"
+                  << std::endl;
+        if (err_per > 1.0f) errors++;
+
+        // Statistics: white balance sums and counts, histogram and tone mapping block sums
+        for (int i = 0; i < STATS_SIZE; i++) {
+            double r = ref_stats[i];
+            double d = fabs((double)stats[i] - r);
+            if (d > 1 + 0.01 * r) {
+                std::cout << "ERROR: Frame " << f << " statistic " << i << " is " << stats[i] << ", expected "
+                          << ref_stats[i] << std::endl;
+                errors++;
+                break;
+            }
+        }
+
+        cv::imwrite(f ? "hls_out.png" : "hls_out_first.png", out_img);
+    }
+
+    q.finish();
+
+    if (errors) {
+        fprintf(stderr, "ERROR: Test Failed.\n ");
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xf_orb_config.h"
+
+static void orbWrite(hls::stream<ap_uint<64> >& kp,
+                     hls::stream<ap_uint<XF_ORB_DESC_BITS> >& desc,
+                     ap_uint<64>* kp_out,
+                     ap_uint<XF_ORB_DESC_BITS>* desc_out,
+                     int& count) {
+    int n = 0;
+    for (ap_uint<64> k = kp.read(); k != XF_ORB_END_OF_LIST; k = kp.read()) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAX_KEYPOINTS
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        kp_out[n] = k;
+        desc_out[n] = desc.read();
+        n++;
+    }
+    count = n;
+}
+
+static void orb_level(ap_uint<INPUT_PTR_WIDTH>* img_in,
+                      ap_uint<OUTPUT_PTR_WIDTH>* img_next,
+                      ap_uint<64>* kp_out,
+                      ap_uint<XF_ORB_DESC_BITS>* desc_out,
+                      int& count,
+                      int rows,
+                      int cols,
+                      int level,
+                      int threshold,
+                      int max_kp) {
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgInput(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgCopy(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgPyr(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgFast(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgBlurIn(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgCorners(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgBlur(rows, cols);
+    xf::cv::Mat<IN_TYPE, HEIGHT, WIDTH, NPC1> imgNext((rows + 1) >> 1, (cols + 1) >> 1);
+
+    hls::stream<ap_uint<32> > kpStream;
+    hls::stream<ap_uint<64> > kpOut;
+    hls::stream<ap_uint<XF_ORB_DESC_BITS> > descOut;
+
+// clang-format off
+    #pragma HLS STREAM variable=imgInput.data depth=2
+    #pragma HLS STREAM variable=imgCopy.data depth=2
+    #pragma HLS STREAM variable=imgPyr.data depth=2
+    #pragma HLS STREAM variable=imgFast.data depth=2
+    #pragma HLS STREAM variable=imgBlurIn.data depth=2
+    #pragma HLS STREAM variable=imgCorners.data depth=2
+    #pragma HLS STREAM variable=imgBlur.data depth=2
+    #pragma HLS STREAM variable=imgNext.data depth=2
+    #pragma HLS STREAM variable=kpStream depth=KP_STREAM_DEPTH
+    #pragma HLS STREAM variable=kpOut depth=2
+    #pragma HLS STREAM variable=descOut depth=2
+// clang-format on
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    xf::cv::Array2xfMat<INPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(img_in, imgInput);
+    xf::cv::duplicateMat<IN_TYPE, HEIGHT, WIDTH, NPC1>(imgInput, imgCopy, imgPyr);
+    xf::cv::duplicateMat<IN_TYPE, HEIGHT, WIDTH, NPC1>(imgCopy, imgFast, imgBlurIn);
+
+    // Detection
+    xf::cv::fast<1, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgFast, imgCorners, threshold);
+    xf::cv::orbKeypoints<HEIGHT, WIDTH, ORB_GRID_Y, ORB_GRID_X>(imgCorners, kpStream, max_kp);
+
+    // Description, on the smoothed image
+    xf::cv::GaussianBlur<ORB_FILTER_WIDTH, XF_BORDER_CONSTANT, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgBlurIn, imgBlur,
+                                                                                            ORB_SIGMA);
+    xf::cv::orbDescriptors<HEIGHT, WIDTH>(imgBlur, kpStream, kpOut, descOut, level);
+
+    // Next level of the pyramid
+    xf::cv::pyrDown<IN_TYPE, HEIGHT, WIDTH, NPC1>(imgPyr, imgNext);
+    xf::cv::xfMat2Array<OUTPUT_PTR_WIDTH, IN_TYPE, HEIGHT, WIDTH, NPC1>(imgNext, img_next);
+
+    orbWrite(kpOut, descOut, kp_out, desc_out, count);
+}
+
+extern "C" {
+
+void orb_accel(ap_uint<INPUT_PTR_WIDTH>* img_in,
+               ap_uint<OUTPUT_PTR_WIDTH>* img_next,
+               ap_uint<64>* kp_out,
+               ap_uint<XF_ORB_DESC_BITS>* desc_out,
+               int* counts,
+               int rows,
+               int cols,
+               int level,
+               int threshold,
+               int max_kp) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=img_in        offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=img_next      offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=kp_out        offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=desc_out      offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE m_axi      port=counts        offset=slave  bundle=gmem4
+    #pragma HLS INTERFACE s_axilite  port=rows                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=cols                        bundle=control
+    #pragma HLS INTERFACE s_axilite  port=level                       bundle=control
+    #pragma HLS INTERFACE s_axilite  port=threshold                   bundle=control
+    #pragma HLS INTERFACE s_axilite  port=max_kp                      bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    // The keypoints of a level follow the ones of the previous levels, counted on the device
+    int offset = 0;
+    for (int l = 0; l < level; l++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=0 max=NUM_LEVELS
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        offset += counts[l];
+    }
+
+    int count;
+    orb_level(img_in, img_next, kp_out + offset, desc_out + offset, count, rows, cols, level, threshold,
+              (max_kp < MAX_KEYPOINTS) ? max_kp : MAX_KEYPOINTS);
+    counts[level] = count;
+
+    return;
+} // End of kernel
+
+} // End of extern C
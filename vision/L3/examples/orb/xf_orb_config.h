@@ -0,0 +1,53 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef _XF_ORB_CONFIG_H_
+#define _XF_ORB_CONFIG_H_
+
+#include "hls_stream.h"
+#include "ap_int.h"
+#include "common/xf_common.hpp"
+#include "common/xf_utility.hpp"
+#include "features/xf_fast.hpp"
+#include "features/xf_orb.hpp"
+#include "imgproc/xf_duplicateimage.hpp"
+#include "imgproc/xf_gaussian_filter.hpp"
+#include "imgproc/xf_pyr_down.hpp"
+#include "xf_config_params.h"
+
+// Maximum size of the first level
+#define WIDTH 1920
+#define HEIGHT 1080
+
+#define IN_TYPE XF_8UC1
+#define NPC1 XF_NPPC1
+
+// Smoothing of the image the binary tests are done on
+#define ORB_FILTER_WIDTH 7
+#define ORB_SIGMA 2.0f
+
+// Grid of cells sharing the keypoints of a level, about square cells at 16:9
+#define ORB_GRID_Y 6
+#define ORB_GRID_X 8
+
+// Keypoints of the rows between detection and description, see orbKeypoints
+#define KP_STREAM_DEPTH (MAX_KEYPOINTS + 4 * XF_ORB_BORDER)
+
+// Train descriptors buffered by the matcher, all the levels of a frame
+#define MAX_TRAIN (NUM_LEVELS * MAX_KEYPOINTS)
+
+#endif // _XF_ORB_CONFIG_H_
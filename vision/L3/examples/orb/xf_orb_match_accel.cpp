@@ -0,0 +1,111 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "xf_orb_config.h"
+
+static void readDescriptors(ap_uint<XF_ORB_DESC_BITS>* in, hls::stream<ap_uint<XF_ORB_DESC_BITS> >& out, int n) {
+    for (int i = 0; i < n; i++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAX_TRAIN
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        out.write(in[i]);
+    }
+}
+
+static void writeMatches(hls::stream<ap_uint<64> >& in, ap_uint<64>* out, int& count) {
+    int n = 0;
+    for (ap_uint<64> m = in.read(); m != XF_ORB_END_OF_LIST; m = in.read()) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=MAX_TRAIN
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        out[n++] = m;
+    }
+    count = n;
+}
+
+static int sumCounts(int* counts, int levels) {
+    int n = 0;
+    for (int l = 0; l < levels; l++) {
+// clang-format off
+        #pragma HLS LOOP_TRIPCOUNT min=1 max=NUM_LEVELS
+        #pragma HLS PIPELINE II=1
+        // clang-format on
+        n += counts[l];
+    }
+    return n;
+}
+
+static void orb_match(ap_uint<XF_ORB_DESC_BITS>* query,
+                      ap_uint<XF_ORB_DESC_BITS>* train,
+                      ap_uint<64>* matches,
+                      int& count,
+                      int nquery,
+                      int ntrain,
+                      int max_dist,
+                      float ratio) {
+    hls::stream<ap_uint<XF_ORB_DESC_BITS> > queryStream;
+    hls::stream<ap_uint<XF_ORB_DESC_BITS> > trainStream;
+    hls::stream<ap_uint<64> > matchStream;
+
+// clang-format off
+    #pragma HLS DATAFLOW
+    // clang-format on
+
+    readDescriptors(query, queryStream, nquery);
+    readDescriptors(train, trainStream, ntrain);
+    xf::cv::orbMatch<MAX_TRAIN, MATCH_PARALLEL>(queryStream, nquery, trainStream, ntrain, matchStream, max_dist, ratio);
+    writeMatches(matchStream, matches, count);
+}
+
+extern "C" {
+
+void orb_match_accel(ap_uint<XF_ORB_DESC_BITS>* query,
+                     ap_uint<XF_ORB_DESC_BITS>* train,
+                     int* query_counts,
+                     int* train_counts,
+                     ap_uint<64>* matches,
+                     int* num_matches,
+                     int levels,
+                     int max_dist,
+                     float ratio) {
+// clang-format off
+    #pragma HLS INTERFACE m_axi      port=query         offset=slave  bundle=gmem0
+    #pragma HLS INTERFACE m_axi      port=train         offset=slave  bundle=gmem1
+    #pragma HLS INTERFACE m_axi      port=query_counts  offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=train_counts  offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE m_axi      port=matches       offset=slave  bundle=gmem3
+    #pragma HLS INTERFACE m_axi      port=num_matches   offset=slave  bundle=gmem2
+    #pragma HLS INTERFACE s_axilite  port=levels                      bundle=control
+    #pragma HLS INTERFACE s_axilite  port=max_dist                    bundle=control
+    #pragma HLS INTERFACE s_axilite  port=ratio                       bundle=control
+    #pragma HLS INTERFACE s_axilite  port=return                      bundle=control
+    // clang-format on
+
+    // Descriptors of all the levels of the two frames, as left by orb_accel
+    int nquery = sumCounts(query_counts, levels);
+    int ntrain = sumCounts(train_counts, levels);
+
+    int count;
+    orb_match(query, train, matches, count, nquery, ntrain, max_dist, ratio);
+    *num_matches = count;
+
+    return;
+} // End of kernel
+
+} // End of extern C
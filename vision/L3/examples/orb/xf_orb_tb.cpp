@@ -0,0 +1,207 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "common/xf_headers.hpp"
+#include "xf_orb_config.h"
+#include "xcl2.hpp"
+
+#define ROTATION 20.0
+#define FAST_THRESHOLD 20
+#define MAX_DIST 64
+#define RATIO 0.8f
+
+// Buffers of one frame, left on the device between the detection and the matching
+struct OrbFrame {
+    cl::Buffer pyr[NUM_LEVELS + 1];
+    cl::Buffer kp;
+    cl::Buffer desc;
+    cl::Buffer counts;
+};
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <INPUT IMAGE PATH 1>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    cv::Mat in_img = cv::imread(argv[1], 0);
+    if (!in_img.data) {
+        fprintf(stderr, "ERROR: Cannot open image %s\n ", argv[1]);
+        return EXIT_FAILURE;
+    }
+    if (in_img.rows > HEIGHT || in_img.cols > WIDTH) {
+        double s = std::min((double)HEIGHT / in_img.rows, (double)WIDTH / in_img.cols);
+        cv::resize(in_img, in_img, cv::Size(in_img.cols * s, in_img.rows * s), 0, 0, cv::INTER_AREA);
+    }
+
+    // Second frame: the first one rotated around its center
+    cv::Mat rot = cv::getRotationMatrix2D(cv::Point2f(in_img.cols / 2.0f, in_img.rows / 2.0f), ROTATION, 1.0);
+    cv::Mat frames[2];
+    frames[0] = in_img;
+    cv::warpAffine(in_img, frames[1], rot, in_img.size(), cv::INTER_LINEAR, cv::BORDER_REPLICATE);
+
+    int rows[NUM_LEVELS + 1];
+    int cols[NUM_LEVELS + 1];
+    rows[0] = in_img.rows;
+    cols[0] = in_img.cols;
+    for (int l = 1; l <= NUM_LEVELS; l++) {
+        rows[l] = (rows[l - 1] + 1) >> 1;
+        cols[l] = (cols[l - 1] + 1) >> 1;
+    }
+
+    size_t kp_size_bytes = NUM_LEVELS * MAX_KEYPOINTS * sizeof(ap_uint<64>);
+    size_t desc_size_bytes = NUM_LEVELS * MAX_KEYPOINTS * (XF_ORB_DESC_BITS / 8);
+    size_t counts_size_bytes = NUM_LEVELS * sizeof(int);
+
+    cl_int err;
+    std::cout << "INFO: Running OpenCL section." << std::endl;
+
+    // Get the device:
+    std::vector<cl::Device> devices = xcl::get_xil_devices();
+    cl::Device device = devices[0];
+
+    // Context, command queue and device name:
+    OCL_CHECK(err, cl::Context context(device, NULL, NULL, NULL, &err));
+    OCL_CHECK(err, cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE, &err));
+    OCL_CHECK(err, std::string device_name = device.getInfo<CL_DEVICE_NAME>(&err));
+
+    std::cout << "INFO: Device found - " << device_name << std::endl;
+
+    // Load binary:
+    std::string binaryFile = xcl::find_binary_file(device_name, "krnl_orb");
+    cl::Program::Binaries bins = xcl::import_binary_file(binaryFile);
+    devices.resize(1);
+    OCL_CHECK(err, cl::Program program(context, devices, bins, NULL, &err));
+
+    // Create the kernels:
+    OCL_CHECK(err, cl::Kernel orb(program, "orb_accel", &err));
+    OCL_CHECK(err, cl::Kernel match(program, "orb_match_accel", &err));
+
+    OrbFrame dev[2];
+    for (int f = 0; f < 2; f++) {
+        for (int l = 0; l <= NUM_LEVELS; l++) {
+            // whole INPUT_PTR_WIDTH words
+            size_t words = (rows[l] * cols[l] + INPUT_PTR_WIDTH / 8 - 1) / (INPUT_PTR_WIDTH / 8);
+            size_t bytes = words * (INPUT_PTR_WIDTH / 8);
+            OCL_CHECK(err, dev[f].pyr[l] = cl::Buffer(context, CL_MEM_READ_WRITE, bytes, NULL, &err));
+        }
+        OCL_CHECK(err, dev[f].kp = cl::Buffer(context, CL_MEM_READ_WRITE, kp_size_bytes, NULL, &err));
+        OCL_CHECK(err, dev[f].desc = cl::Buffer(context, CL_MEM_READ_WRITE, desc_size_bytes, NULL, &err));
+        OCL_CHECK(err, dev[f].counts = cl::Buffer(context, CL_MEM_READ_WRITE, counts_size_bytes, NULL, &err));
+    }
+    OCL_CHECK(err, cl::Buffer buffer_matches(context, CL_MEM_WRITE_ONLY, MAX_TRAIN * sizeof(ap_uint<64>), NULL, &err));
+    OCL_CHECK(err, cl::Buffer buffer_numMatches(context, CL_MEM_WRITE_ONLY, sizeof(int), NULL, &err));
+
+    // Profiling Objects
+    cl_ulong start = 0;
+    cl_ulong end = 0;
+    double diff_prof = 0.0f;
+    cl::Event event;
+
+    // Detection and description, one launch per level, the keypoints stay on the device
+    for (int f = 0; f < 2; f++) {
+        OCL_CHECK(err, q.enqueueWriteBuffer(dev[f].pyr[0], CL_TRUE, 0, rows[0] * cols[0], frames[f].data));
+
+        for (int l = 0; l < NUM_LEVELS; l++) {
+            OCL_CHECK(err, err = orb.setArg(0, dev[f].pyr[l]));
+            OCL_CHECK(err, err = orb.setArg(1, dev[f].pyr[l + 1]));
+            OCL_CHECK(err, err = orb.setArg(2, dev[f].kp));
+            OCL_CHECK(err, err = orb.setArg(3, dev[f].desc));
+            OCL_CHECK(err, err = orb.setArg(4, dev[f].counts));
+            OCL_CHECK(err, err = orb.setArg(5, rows[l]));
+            OCL_CHECK(err, err = orb.setArg(6, cols[l]));
+            OCL_CHECK(err, err = orb.setArg(7, l));
+            OCL_CHECK(err, err = orb.setArg(8, FAST_THRESHOLD));
+            OCL_CHECK(err, err = orb.setArg(9, MAX_KEYPOINTS));
+
+            OCL_CHECK(err, err = q.enqueueTask(orb, NULL, &event));
+            clWaitForEvents(1, (const cl_event*)&event);
+            event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+            event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+            diff_prof += end - start;
+        }
+    }
+    std::cout << "INFO: Detection and description " << (diff_prof / 2000000) << "ms per frame" << std::endl;
+
+    // Matching of the second frame against the first one
+    int levels = NUM_LEVELS;
+    int max_dist = MAX_DIST;
+    float ratio = RATIO;
+    OCL_CHECK(err, err = match.setArg(0, dev[1].desc));
+    OCL_CHECK(err, err = match.setArg(1, dev[0].desc));
+    OCL_CHECK(err, err = match.setArg(2, dev[1].counts));
+    OCL_CHECK(err, err = match.setArg(3, dev[0].counts));
+    OCL_CHECK(err, err = match.setArg(4, buffer_matches));
+    OCL_CHECK(err, err = match.setArg(5, buffer_numMatches));
+    OCL_CHECK(err, err = match.setArg(6, levels));
+    OCL_CHECK(err, err = match.setArg(7, max_dist));
+    OCL_CHECK(err, err = match.setArg(8, ratio));
+
+    OCL_CHECK(err, err = q.enqueueTask(match, NULL, &event));
+    clWaitForEvents(1, (const cl_event*)&event);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_START, &start);
+    event.getProfilingInfo(CL_PROFILING_COMMAND_END, &end);
+    std::cout << "INFO: Matching " << ((end - start) / 1000000.0) << "ms" << std::endl;
+
+    // Results
+    std::vector<ap_uint<64> > kp[2];
+    std::vector<int> counts[2];
+    for (int f = 0; f < 2; f++) {
+        kp[f].resize(NUM_LEVELS * MAX_KEYPOINTS);
+        counts[f].resize(NUM_LEVELS);
+        OCL_CHECK(err, q.enqueueReadBuffer(dev[f].kp, CL_TRUE, 0, kp_size_bytes, kp[f].data()));
+        OCL_CHECK(err, q.enqueueReadBuffer(dev[f].counts, CL_TRUE, 0, counts_size_bytes, counts[f].data()));
+        for (int l = 0; l < NUM_LEVELS; l++) {
+            std::cout << "INFO: Frame " << f << " level " << l << ": " << counts[f][l] << " keypoints" << std::endl;
+        }
+    }
+    int num_matches;
+    std::vector<ap_uint<64> > matches(MAX_TRAIN);
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_numMatches, CL_TRUE, 0, sizeof(int), &num_matches));
+    OCL_CHECK(err, q.enqueueReadBuffer(buffer_matches, CL_TRUE, 0, num_matches * sizeof(ap_uint<64>), matches.data()));
+    q.finish();
+
+    // A match is right when the train keypoint, rotated, lands on the query keypoint
+    int inliers = 0;
+    cv::Mat out_img;
+    cv::cvtColor(frames[1], out_img, cv::COLOR_GRAY2BGR);
+    for (int i = 0; i < num_matches; i++) {
+        ap_uint<64> kq = kp[1][(int)matches[i].range(15, 0)];
+        ap_uint<64> kt = kp[0][(int)matches[i].range(31, 16)];
+        int lq = kq.range(39, 32);
+        int lt = kt.range(39, 32);
+        cv::Point2d pq((int)kq.range(15, 0) << lq, (int)kq.range(31, 16) << lq);
+        cv::Point2d pt((int)kt.range(15, 0) << lt, (int)kt.range(31, 16) << lt);
+        cv::Point2d proj(rot.at<double>(0, 0) * pt.x + rot.at<double>(0, 1) * pt.y + rot.at<double>(0, 2),
+                         rot.at<double>(1, 0) * pt.x + rot.at<double>(1, 1) * pt.y + rot.at<double>(1, 2));
+        bool ok = cv::norm(proj - pq) < 3 << std::max(lq, lt);
+        inliers += ok;
+        cv::line(out_img, proj, pq, ok ? cv::Scalar(0, 255, 0) : cv::Scalar(0, 0, 255));
+    }
+    cv::imwrite("hls_out.png", out_img);
+
+    float inlier_per = num_matches ? 100.0f * inliers / num_matches : 0.0f;
+    std::cout << "INFO: " << num_matches << " matches, " << inlier_per << "% inliers" << std::endl;
+
+    if ((num_matches < 20) || (inlier_per < 70.0f)) {
+        fprintf(stderr, "ERROR: Test Failed.\n ");
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Test Passed " << std::endl;
+    return 0;
+}
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define INPUT_PTR_WIDTH 128
+#define OUTPUT_PTR_WIDTH 128
+
+// Pixels per clock, XF_NPPC2 for 4K60 at 300 MHz
+#define NPPC XF_NPPC2
+
+// Bayer pattern of the sensor
+#define BPATTERN XF_BAYER_RG
+
+// Local tone mapping grid
+#define LTM_GRID_ROWS 8
+#define LTM_GRID_COLS 8
+
+#define XF_USE_URAM 0
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2019 Xilinx, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#define INPUT_PTR_WIDTH 64
+#define OUTPUT_PTR_WIDTH 64
+
+// Pyramid levels, each one half the size of the previous one
+#define NUM_LEVELS 4
+
+// Maximum number of keypoints per level
+#define MAX_KEYPOINTS 2048
+
+// Descriptors compared per cycle by the matcher
+#define MATCH_PARALLEL 8